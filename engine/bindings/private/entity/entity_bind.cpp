@@ -7,8 +7,10 @@
 #include "audio_listener_component.hpp"
 #include "cheats_component.hpp"
 #include "components/camera_component.hpp"
+#include "components/character_controller_component.hpp"
 #include "components/directional_light_component.hpp"
 #include "components/name_component.hpp"
+#include "components/nav_agent_component.hpp"
 #include "components/point_light_component.hpp"
 #include "components/relationship_component.hpp"
 #include "components/relationship_helpers.hpp"
@@ -307,6 +309,14 @@ void BindEntity(wren::ForeignModule& module)
     entityClass.func<&WrenEntity::AddComponent<RigidbodyComponent>>("AddRigidbodyComponent", "Must pass a Rigidbody to this function");
     entityClass.func<&WrenEntity::RemoveComponent<RigidbodyComponent>>("RemoveRigidBodyComponent");
 
+    entityClass.func<&WrenEntity::GetComponent<CharacterControllerComponent>>("GetCharacterControllerComponent");
+    entityClass.func<&WrenEntity::AddComponent<CharacterControllerComponent>>("AddCharacterControllerComponent", "Must pass a CharacterController to this function");
+    entityClass.func<&WrenEntity::RemoveComponent<CharacterControllerComponent>>("RemoveCharacterControllerComponent");
+
+    entityClass.func<&WrenEntity::GetComponent<NavAgentComponent>>("GetNavAgentComponent");
+    entityClass.func<&WrenEntity::AddDefaultComponent<NavAgentComponent>>("AddNavAgentComponent");
+    entityClass.func<&WrenEntity::RemoveComponent<NavAgentComponent>>("RemoveNavAgentComponent");
+
     entityClass.func<&WrenEntity::GetComponent<PointLightComponent>>("GetPointLightComponent");
     entityClass.func<&WrenEntity::AddDefaultComponent<PointLightComponent>>("AddPointLightComponent");
 
@@ -1,6 +1,9 @@
 #include "pathfinding_bindings.hpp"
 
+#include "components/nav_agent_component.hpp"
+#include "log.hpp"
 #include "pathfinding_module.hpp"
+#include "wren_entity.hpp"
 
 #include <glm/glm.hpp>
 
@@ -16,6 +19,74 @@ ComputedPath FindPath(PathfindingModule& self, const glm::vec3& start_pos, const
     return self.FindPath(start_pos, end_pos);
 }
 
+PathRequestHandle RequestPath(PathfindingModule& self, const glm::vec3& start_pos, const glm::vec3& end_pos)
+{
+    return self.RequestPath(start_pos, end_pos);
+}
+
+PathRequestHandle RequestPathWithCallback(PathfindingModule& self, const glm::vec3& start_pos, const glm::vec3& end_pos, wren::Variable callback)
+{
+    wren::Method method {};
+
+    try
+    {
+        method = callback.func("call(_)");
+    }
+    catch (const wren::Exception& e)
+    {
+        bblog::warn("[WREN WARNING] could not bind wren lambda to path callback: {}", e.what());
+        return self.RequestPath(start_pos, end_pos);
+    }
+
+    return self.RequestPath(start_pos, end_pos, true, [method](PathRequestHandle, PathRequestStatus, const ComputedPath& path) mutable
+        {
+            try
+            {
+                method(path);
+            }
+            catch (wren::Exception& ex)
+            {
+                bblog::error(ex.what());
+            }
+        });
+}
+
+// Also true for requests that were cancelled, for example because the navmesh changed, TakePath then returns an empty path
+bool IsPathReady(PathfindingModule& self, PathRequestHandle& request)
+{
+    return self.GetPathStatus(request) != PathRequestStatus::ePENDING;
+}
+
+ComputedPath TakePath(PathfindingModule& self, PathRequestHandle& request)
+{
+    return self.TakePath(request).value_or(ComputedPath {});
+}
+
+void CancelPath(PathfindingModule& self, PathRequestHandle& request)
+{
+    self.CancelPath(request);
+}
+
+FlowFieldHandle CreateFlowField(PathfindingModule& self, const glm::vec3& target)
+{
+    return self.CreateFlowField(target);
+}
+
+void DestroyFlowField(PathfindingModule& self, FlowFieldHandle& field)
+{
+    self.DestroyFlowField(field);
+}
+
+void SetFlowFieldTarget(PathfindingModule& self, FlowFieldHandle& field, const glm::vec3& target)
+{
+    self.SetFlowFieldTarget(field, target);
+}
+
+glm::vec3 SampleFlowField(PathfindingModule& self, FlowFieldHandle& field, const glm::vec3& position)
+{
+    return self.SampleFlowField(field, position);
+}
+
 glm::vec3 GetCenter(PathNode& node)
 {
     return node.centre;
@@ -72,6 +143,106 @@ bool ShouldGoNextWaypoint(ComputedPath& path, uint32_t current_index, const glm:
     bool shouldGoNext = glm::distance(position, path.waypoints.at(current_index).centre) < bias;
     return shouldGoNext;
 }
+
+void NavAgentSetTarget(WrenComponent<NavAgentComponent>& self, const glm::vec3& target)
+{
+    self.component->SetTarget(target);
+}
+
+void NavAgentStop(WrenComponent<NavAgentComponent>& self)
+{
+    self.component->Stop();
+}
+
+glm::vec3 NavAgentGetDirection(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->GetDirection();
+}
+
+bool NavAgentHasArrived(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->HasArrived();
+}
+
+bool NavAgentHasPath(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->GetState() == NavAgentState::eFOLLOWING || self.component->GetState() == NavAgentState::eARRIVED;
+}
+
+bool NavAgentIsUnreachable(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->GetState() == NavAgentState::eUNREACHABLE;
+}
+
+float NavAgentGetWaypointRadius(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->settings.waypointRadius;
+}
+
+void NavAgentSetWaypointRadius(WrenComponent<NavAgentComponent>& self, float radius)
+{
+    self.component->settings.waypointRadius = radius;
+}
+
+float NavAgentGetArrivalDistance(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->settings.arrivalDistance;
+}
+
+void NavAgentSetArrivalDistance(WrenComponent<NavAgentComponent>& self, float distance)
+{
+    self.component->settings.arrivalDistance = distance;
+}
+
+float NavAgentGetRepathInterval(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->settings.repathInterval;
+}
+
+void NavAgentSetRepathInterval(WrenComponent<NavAgentComponent>& self, float interval)
+{
+    self.component->settings.repathInterval = interval;
+}
+
+float NavAgentGetRepathDistance(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->settings.repathDistance;
+}
+
+void NavAgentSetRepathDistance(WrenComponent<NavAgentComponent>& self, float distance)
+{
+    self.component->settings.repathDistance = distance;
+}
+
+void NavAgentSetPreferredVelocity(WrenComponent<NavAgentComponent>& self, const glm::vec3& velocity)
+{
+    self.component->SetPreferredVelocity(velocity);
+}
+
+glm::vec3 NavAgentGetVelocity(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->GetVelocity();
+}
+
+float NavAgentGetRadius(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->settings.radius;
+}
+
+void NavAgentSetRadius(WrenComponent<NavAgentComponent>& self, float radius)
+{
+    self.component->settings.radius = radius;
+}
+
+float NavAgentGetMaxSpeed(WrenComponent<NavAgentComponent>& self)
+{
+    return self.component->settings.maxSpeed;
+}
+
+void NavAgentSetMaxSpeed(WrenComponent<NavAgentComponent>& self, float speed)
+{
+    self.component->settings.maxSpeed = speed;
+}
 }
 
 void BindPathfindingAPI(wren::ForeignModule& module)
@@ -81,6 +252,19 @@ void BindPathfindingAPI(wren::ForeignModule& module)
 
     wren_class.funcExt<bindings::FindPath>("FindPath");
     wren_class.funcExt<bindings::SetNavigationMesh>("SetNavigationMesh");
+    wren_class.funcExt<bindings::RequestPath>("RequestPath");
+    wren_class.funcExt<bindings::RequestPathWithCallback>("RequestPath");
+    wren_class.funcExt<bindings::IsPathReady>("IsPathReady");
+    wren_class.funcExt<bindings::TakePath>("TakePath");
+    wren_class.funcExt<bindings::CancelPath>("CancelPath");
+
+    wren_class.funcExt<bindings::CreateFlowField>("CreateFlowField");
+    wren_class.funcExt<bindings::DestroyFlowField>("DestroyFlowField");
+    wren_class.funcExt<bindings::SetFlowFieldTarget>("SetFlowFieldTarget");
+    wren_class.funcExt<bindings::SampleFlowField>("SampleFlowField");
+
+    module.klass<PathRequestHandle>("PathRequest");
+    module.klass<FlowFieldHandle>("FlowField");
 
     auto& pathNode = module.klass<PathNode>("PathNode");
     pathNode.propReadonlyExt<bindings::GetCenter>("center");
@@ -93,4 +277,22 @@ void BindPathfindingAPI(wren::ForeignModule& module)
     computedPath.funcExt<bindings::ShouldGoNextWaypoint>("ShouldGoNextWaypoint");
     computedPath.funcExt<bindings::ClearWaypoints>("ClearWaypoints");
     computedPath.funcExt<bindings::GetWaypoint>("GetWaypoint");
+
+    // Nav agents are moved along their paths by the NavAgentSystem, scripts only set the target and read the direction or velocity
+
+    auto& navAgentComponent = module.klass<WrenComponent<NavAgentComponent>>("NavAgentComponent");
+    navAgentComponent.funcExt<bindings::NavAgentSetTarget>("SetTarget", "Searches a path in the background, and again when the target moves or the path gets old");
+    navAgentComponent.funcExt<bindings::NavAgentStop>("Stop", "Drops the target and the path");
+    navAgentComponent.funcExt<bindings::NavAgentGetDirection>("GetDirection", "Normalized horizontal direction to walk in, zero without a path or when arrived");
+    navAgentComponent.funcExt<bindings::NavAgentHasArrived>("HasArrived");
+    navAgentComponent.funcExt<bindings::NavAgentHasPath>("HasPath");
+    navAgentComponent.funcExt<bindings::NavAgentIsUnreachable>("IsUnreachable");
+    navAgentComponent.funcExt<bindings::NavAgentSetPreferredVelocity>("SetPreferredVelocity", "Velocity to steer with while there is no path to follow");
+    navAgentComponent.funcExt<bindings::NavAgentGetVelocity>("GetVelocity", "Horizontal velocity that avoids the other agents");
+    navAgentComponent.propExt<bindings::NavAgentGetWaypointRadius, bindings::NavAgentSetWaypointRadius>("waypointRadius");
+    navAgentComponent.propExt<bindings::NavAgentGetArrivalDistance, bindings::NavAgentSetArrivalDistance>("arrivalDistance");
+    navAgentComponent.propExt<bindings::NavAgentGetRepathInterval, bindings::NavAgentSetRepathInterval>("repathInterval");
+    navAgentComponent.propExt<bindings::NavAgentGetRepathDistance, bindings::NavAgentSetRepathDistance>("repathDistance");
+    navAgentComponent.propExt<bindings::NavAgentGetRadius, bindings::NavAgentSetRadius>("radius");
+    navAgentComponent.propExt<bindings::NavAgentGetMaxSpeed, bindings::NavAgentSetMaxSpeed>("maxSpeed");
 }
@@ -1,4 +1,5 @@
 #include "physics_bindings.hpp"
+#include "components/character_controller_component.hpp"
 #include "components/rigidbody_component.hpp"
 #include "ecs_module.hpp"
 #include "physics/collision.hpp"
@@ -124,7 +125,7 @@ void SetLayer(WrenComponent<RigidbodyComponent>& self, int layer)
 RigidbodyComponent RigidbodyNew(PhysicsModule& physics, JPH::ShapeRefC shape, JPH::ObjectLayer layer, bool allowRotation)
 {
     JPH::EAllowedDOFs dofs = allowRotation ? JPH::EAllowedDOFs::All : JPH::EAllowedDOFs::TranslationX | JPH::EAllowedDOFs::TranslationY | JPH::EAllowedDOFs::TranslationZ;
-    return RigidbodyComponent { physics.GetBodyInterface(), shape, layer, dofs };
+    return RigidbodyComponent { physics, shape, layer, dofs };
 }
 
 void SetOnCollisionEnter(WrenComponent<RigidbodyComponent>& self, wren::Variable callback)
@@ -137,6 +138,52 @@ void SetOnCollisionStay(WrenComponent<RigidbodyComponent>& self, wren::Variable
     self.component->onCollisionStay = { callback };
 }
 
+CharacterControllerComponent CharacterControllerNew(float radius, float cylinderHeight, float maxSlopeAngle, float stepHeight, JPH::ObjectLayer layer)
+{
+    CharacterControllerSettings settings {};
+    settings.radius = radius;
+    settings.cylinderHeight = cylinderHeight;
+    settings.maxSlopeAngle = glm::radians(maxSlopeAngle);
+    settings.stepHeight = stepHeight;
+    settings.layer = layer;
+    return CharacterControllerComponent { settings };
+}
+
+void CharacterSetDesiredVelocity(WrenComponent<CharacterControllerComponent>& self, const glm::vec3& velocity)
+{
+    self.component->desiredVelocity = velocity;
+}
+
+glm::vec3 CharacterGetDesiredVelocity(WrenComponent<CharacterControllerComponent>& self)
+{
+    return self.component->desiredVelocity;
+}
+
+glm::vec3 CharacterGetPosition(WrenComponent<CharacterControllerComponent>& self)
+{
+    return self.component->GetPosition();
+}
+
+glm::vec3 CharacterGetVelocity(WrenComponent<CharacterControllerComponent>& self)
+{
+    return self.component->GetVelocity();
+}
+
+bool CharacterIsGrounded(WrenComponent<CharacterControllerComponent>& self)
+{
+    return self.component->IsGrounded();
+}
+
+void CharacterJump(WrenComponent<CharacterControllerComponent>& self, float speed)
+{
+    self.component->Jump(speed);
+}
+
+void CharacterTeleport(WrenComponent<CharacterControllerComponent>& self, const glm::vec3& position)
+{
+    self.component->Teleport(position);
+}
+
 std::optional<glm::vec3> LocalEnemySteering(
     PhysicsModule& physics,
     const WrenComponent<RigidbodyComponent>& self,
@@ -297,4 +344,18 @@ void BindPhysicsAPI(wren::ForeignModule& module)
     rigidBodyComponent.funcExt<bindings::SetLayer>("SetLayer");
     rigidBodyComponent.funcExt<bindings::SetOnCollisionEnter>("OnCollisionEnter", "void callback(WrenEntity self, WrenEntity other) -> void");
     rigidBodyComponent.funcExt<bindings::SetOnCollisionStay>("OnCollisionStay", "void callback(WrenEntity self, WrenEntity other) -> void");
+
+    // Character controller component, constructed the same way as the rigidbody
+
+    auto& characterController = module.klass<CharacterControllerComponent>("CharacterController");
+    characterController.funcStaticExt<bindings::CharacterControllerNew>("new", "Construct a CharacterController from its radius, cylinder height, max slope angle in degrees, step height and object layer");
+
+    auto& characterControllerComponent = module.klass<WrenComponent<CharacterControllerComponent>>("CharacterControllerComponent", "Must be created by passing a CharacterController to the AddComponent function on an entity");
+    characterControllerComponent.funcExt<bindings::CharacterSetDesiredVelocity>("SetDesiredVelocity", "Velocity the character tries to walk with, the vertical part is ignored");
+    characterControllerComponent.funcExt<bindings::CharacterGetDesiredVelocity>("GetDesiredVelocity");
+    characterControllerComponent.funcExt<bindings::CharacterGetPosition>("GetPosition", "Position of the feet of the character");
+    characterControllerComponent.funcExt<bindings::CharacterGetVelocity>("GetVelocity");
+    characterControllerComponent.funcExt<bindings::CharacterIsGrounded>("IsGrounded");
+    characterControllerComponent.funcExt<bindings::CharacterJump>("Jump", "Jumps with the given upwards speed, only when grounded");
+    characterControllerComponent.funcExt<bindings::CharacterTeleport>("Teleport");
 }
@@ -26,6 +26,7 @@
 #include "steam/steam_bindings.hpp"
 #include "time_module.hpp"
 #include "ui_module.hpp"
+#include "utility/enum_bind.hpp"
 #include "utility/math_bind.hpp"
 #include "utility/random_util.hpp"
 #include "wren_engine.hpp"
@@ -71,7 +72,22 @@ WrenEntity LoadModelCollisions(WrenEngine& engine, const std::string& path)
 void PreloadModel(WrenEngine& engine, const std::string& path)
 {
     auto& sceneCache = engine.instance->GetModule<GameModule>()._modelsLoaded;
-    sceneCache.LoadModel(*engine.instance, path, false);
+    sceneCache.LoadModelAsync(*engine.instance, path, false);
+}
+
+ModelLoadState GetModelLoadState(WrenEngine& engine, const std::string& path)
+{
+    return engine.instance->GetModule<GameModule>()._modelsLoaded.GetLoadState(path);
+}
+
+bool IsModelLoaded(WrenEngine& engine, const std::string& path)
+{
+    return GetModelLoadState(engine, path) == ModelLoadState::eLoaded;
+}
+
+void CancelModelLoad(WrenEngine& engine, const std::string& path)
+{
+    engine.instance->GetModule<GameModule>()._modelsLoaded.CancelLoad(path);
 }
 
 void SetExit(WrenEngine& engine, int code)
@@ -133,6 +149,7 @@ void BindEngineAPI(wren::ForeignModule& module)
 {
     bindings::BindMath(module);
     bindings::BindRandom(module);
+    bindings::BindEnum<ModelLoadState>(module, "ModelLoadState");
 
     // Add modules here to expose them in scripting
     {
@@ -152,6 +169,9 @@ void BindEngineAPI(wren::ForeignModule& module)
         engineAPI.funcExt<bindings::LoadModelScripting>("LoadModel");
         engineAPI.funcExt<bindings::LoadModelCollisions>("LoadCollisions");
         engineAPI.funcExt<bindings::PreloadModel>("PreloadModel");
+        engineAPI.funcExt<bindings::GetModelLoadState>("GetModelLoadState");
+        engineAPI.funcExt<bindings::IsModelLoaded>("IsModelLoaded");
+        engineAPI.funcExt<bindings::CancelModelLoad>("CancelModelLoad");
         engineAPI.funcExt<bindings::TransitionToScript>("TransitionToScript");
         engineAPI.funcExt<bindings::SetExit>("SetExit");
         engineAPI.funcExt<bindings::SpawnDecal>("SpawnDecal");
@@ -259,9 +259,12 @@ void GameModule::ApplySettings(Engine& engine)
     }
 }
 
-void GameModule::Shutdown(MAYBE_UNUSED Engine& engine)
+void GameModule::Shutdown(Engine& engine)
 {
     gameSettings.SaveToFile(GAME_SETTINGS_FILE);
+
+    // The renderer shuts down after the game, so the models can still be destroyed through it
+    _modelsLoaded.Clear(engine);
 }
 
 std::optional<std::shared_ptr<MainMenu>> GameModule::GetMainMenu()
@@ -379,6 +382,9 @@ void GameModule::Tick(Engine& engine)
 
     _nextSceneToExecute.clear();
 
+    // Upload models that finished loading in the background
+    _modelsLoaded.FinalizeLoads(engine);
+
     auto& ECS = engine.GetModule<ECSModule>();
 
     auto& applicationModule = engine.GetModule<ApplicationModule>();
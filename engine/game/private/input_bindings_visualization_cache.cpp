@@ -5,6 +5,7 @@
 InputBindingsVisualizationCache::InputBindingsVisualizationCache(const ActionManager& actionManager, GraphicsContext& graphicsContext)
     : _actionManager(actionManager)
     , _graphicsContext(graphicsContext)
+    , _glyphImages(graphicsContext)
 {
 }
 
@@ -57,7 +58,7 @@ ResourceHandle<GPUImage> InputBindingsVisualizationCache::GetGlyph(const std::st
     commonImageData.isHDR = false;
 
     auto& imageResourceManager = _graphicsContext.Resources()->ImageResourceManager();
-    auto image = imageResourceManager.Create(commonImageData.FromPNG(path));
+    auto image = _glyphImages.Own(imageResourceManager.Create(commonImageData.FromPNG(path)));
     _graphicsContext.UpdateBindlessSet();
 
     _glyphCache.emplace(path, image);
@@ -14,9 +14,13 @@
 #include "components/static_mesh_component.hpp"
 #include "components/transform_component.hpp"
 #include "components/transform_helpers.hpp"
+#include "cooked_model.hpp"
 #include "cpu_resources.hpp"
 #include "ecs_module.hpp"
+#include "file_io.hpp"
+#include "log.hpp"
 #include "model_loading.hpp"
+#include "physics/body_batch.hpp"
 #include "physics/collision.hpp"
 #include "renderer.hpp"
 #include "renderer_module.hpp"
@@ -25,7 +29,9 @@
 #include "systems/physics_system.hpp"
 #include "thread_module.hpp"
 
+#include <chrono>
 #include <entt/entity/entity.hpp>
+#include <stdexcept>
 #include <tracy/Tracy.hpp>
 
 class RecursiveNodeLoader
@@ -78,7 +84,7 @@ public:
                 if (hasPhysics)
                 {
                     auto rb = RigidbodyComponent(
-                        _physics.GetBodyInterface(),
+                        _physics,
                         _cpuModel.colliders.at(index),
                         PhysicsObjectLayer::eSTATIC);
 
@@ -239,8 +245,13 @@ entt::entity LoadModelIntoECSAsHierarchy(ECSModule& ecs, PhysicsModule& physics,
         animationControlEntity = rootEntity;
     }
 
-    RecursiveNodeLoader recursiveNodeLoader { ecs, physics, cpuModel.hierarchy, cpuModel, gpuModel, animationControlEntity, entityLUT, rootEntity };
-    recursiveNodeLoader.Load(rootEntity, cpuModel.hierarchy.root, entt::null, loadWithCollision, withRendering);
+    {
+        // Colliders of the whole hierarchy get added to the broadphase at once, instead of one at a time
+        BodyBatchScope bodyBatch { physics.GetBodyBatch() };
+
+        RecursiveNodeLoader recursiveNodeLoader { ecs, physics, cpuModel.hierarchy, cpuModel, gpuModel, animationControlEntity, entityLUT, rootEntity };
+        recursiveNodeLoader.Load(rootEntity, cpuModel.hierarchy.root, entt::null, loadWithCollision, withRendering);
+    }
 
     entt::entity skeletonEntity = entt::null;
     if (cpuModel.hierarchy.skeletonRoot.has_value())
@@ -273,31 +284,230 @@ entt::entity LoadModelIntoECSAsHierarchy(ECSModule& ecs, PhysicsModule& physics,
     return rootEntity;
 }
 
+namespace
+{
+CPUModel LoadCPUModel(ThreadPool& threadPool, std::string_view path, bool genCollision)
+{
+    ZoneScoped;
+    std::string zone = std::string(path) + " CPU parsing";
+    ZoneName(zone.c_str(), 128);
+
+    // Prefer the model cooked by the ModelCooker, unless the glTF changed since it was cooked.
+    // The game archive is packed from cooked models and doesn't keep the write times of the sources, so they aren't checked there
+    const std::string cookedPath = CookedModel::GetCookedPath(path);
+    std::optional<CPUModel> cookedModel = std::nullopt;
+
+    if (fileIO::Exists(cookedPath))
+    {
+#ifdef DISTRIBUTION
+        cookedModel = CookedModel::Load(cookedPath, std::nullopt);
+#else
+        cookedModel = CookedModel::Load(cookedPath, CookedModel::MakeSourceKey(path));
+#endif
+    }
+
+    if (cookedModel.has_value())
+    {
+        CPUModel cpuData = std::move(cookedModel.value());
+
+        if (genCollision)
+            ModelLoading::GenerateColliders(cpuData);
+
+        return cpuData;
+    }
+
+    return ModelLoading::LoadGLTFFast(threadPool, path, genCollision);
+}
+
+ModelLoader::GPUUploadFunction MakeGPUUpload(Engine& engine)
+{
+    auto& rendererModule = engine.GetModule<RendererModule>();
+
+    return [&rendererModule](const CPUModel& cpuModel)
+    {
+        return rendererModule.LoadModels({ cpuModel }).front();
+    };
+}
+
+ModelLoader::GPUReleaseFunction MakeGPURelease(Engine& engine)
+{
+    auto resources = engine.GetModule<RendererModule>().GetRenderer()->GetContext()->Resources();
+
+    // Entities instantiated from the model may be part of frames that are still in flight
+    return [resources](ResourceHandle<GPUModel> gpuModel)
+    {
+        resources->ModelResourceManager().DestroyDeferred(gpuModel);
+    };
+}
+}
+
+void ModelLoadRequest::Cancel()
+{
+    if (_state != ModelLoadState::eLoading)
+        return;
+
+    _cancelled->store(true);
+    _state = ModelLoadState::eCancelled;
+}
+
+ModelLoader::ModelLoader()
+    : _requestPool(std::make_unique<ThreadPool>(REQUEST_THREAD_COUNT))
+{
+    _requestPool->Start();
+}
+
+ModelLoader::~ModelLoader()
+{
+    CancelPending();
+}
+
 std::shared_ptr<ModelData> ModelLoader::LoadModel(Engine& engine, std::string_view path, bool genCollision)
 {
+    std::shared_ptr<ModelLoadRequest> request = LoadModelAsync(engine, path, genCollision);
+    Wait(*request, MakeGPUUpload(engine));
+
+    if (request->GetState() == ModelLoadState::eCancelled)
+        throw std::runtime_error("Loading model " + std::string(path) + " was cancelled");
+
+    if (request->GetState() == ModelLoadState::eFailed)
+        throw std::runtime_error("Failed to load model " + std::string(path) + ": " + request->GetError());
+
+    return request->GetModel();
+}
+
+std::shared_ptr<ModelLoadRequest> ModelLoader::LoadModelAsync(Engine& engine, std::string_view path, bool genCollision)
+{
+    ThreadPool& threadPool = engine.GetModule<ThreadModule>().GetPool();
+
+    return LoadModelAsync(path, genCollision, [&threadPool](std::string_view modelPath, bool withCollision)
+        { return LoadCPUModel(threadPool, modelPath, withCollision); });
+}
+
+std::shared_ptr<ModelLoadRequest> ModelLoader::LoadModelAsync(std::string_view path, bool genCollision, CPULoadFunction load)
+{
+    // Failed and cancelled requests are tried again
     if (auto it = _models.find(std::string(path)); it != _models.end())
     {
-        return it->second;
+        const ModelLoadState state = it->second->GetState();
+        if (state == ModelLoadState::eLoading || state == ModelLoadState::eLoaded)
+            return it->second;
     }
 
-    auto& threadPool = engine.GetModule<ThreadModule>().GetPool();
-    CPUModel cpuData {};
+    auto request = std::make_shared<ModelLoadRequest>();
+    request->_path = std::string(path);
+
+    request->_cpuModel = _requestPool->QueueWork([path = request->_path, genCollision, cancelled = request->_cancelled, load = std::move(load)]()
+        {
+            if (cancelled->load())
+                return CPUModel {};
+
+            return load(path, genCollision);
+        });
+
+    _models[request->_path] = request;
+    _pending.emplace_back(request);
+
+    return request;
+}
+
+void ModelLoader::FinalizeLoads(Engine& engine)
+{
+    if (_pending.empty())
+        return;
+
+    FinalizeLoads(MakeGPUUpload(engine));
+}
+
+void ModelLoader::FinalizeLoads(const GPUUploadFunction& upload)
+{
+    std::erase_if(_pending, [this, &upload](const std::shared_ptr<ModelLoadRequest>& request)
+        {
+            if (request->IsDone())
+                return true;
+
+            if (request->_cpuModel.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+
+            Finalize(*request, upload);
+            return true;
+        });
+}
+
+void ModelLoader::Wait(ModelLoadRequest& request, const GPUUploadFunction& upload)
+{
+    if (request.IsDone())
+        return;
 
     {
-        ZoneScoped;
-        std::string zone = std::string(path) + " CPU parsing";
-        ZoneName(zone.c_str(), 128);
+        ZoneScopedN("Wait for model");
+        request._cpuModel.wait();
+    }
 
-        cpuData = ModelLoading::LoadGLTFFast(threadPool, path, genCollision);
+    Finalize(request, upload);
+    std::erase_if(_pending, [&request](const std::shared_ptr<ModelLoadRequest>& pending)
+        { return pending.get() == &request; });
+}
+
+ModelLoadState ModelLoader::GetLoadState(std::string_view path) const
+{
+    if (auto it = _models.find(std::string(path)); it != _models.end())
+        return it->second->GetState();
+
+    return ModelLoadState::eNotRequested;
+}
+
+void ModelLoader::CancelLoad(std::string_view path)
+{
+    if (auto it = _models.find(std::string(path)); it != _models.end())
+        it->second->Cancel();
+}
+
+void ModelLoader::Clear(Engine& engine)
+{
+    Clear(MakeGPURelease(engine));
+}
+
+void ModelLoader::Clear(const GPUReleaseFunction& release)
+{
+    CancelPending();
+
+    for (auto& [path, request] : _models)
+    {
+        if (request->GetState() == ModelLoadState::eLoaded)
+            release(request->GetModel()->gpuModel);
     }
 
-    auto& rendererModule = engine.GetModule<RendererModule>();
-    auto gpuHandle = rendererModule.LoadModels({ cpuData }).front();
+    _models.clear();
+}
+
+void ModelLoader::CancelPending()
+{
+    for (auto& request : _pending)
+        request->Cancel();
+
+    _pending.clear();
+}
+
+void ModelLoader::Finalize(ModelLoadRequest& request, const GPUUploadFunction& upload)
+{
+    if (request.IsDone())
+        return;
+
+    try
+    {
+        CPUModel cpuData = request._cpuModel.get();
+        ResourceHandle<GPUModel> gpuHandle = upload(cpuData);
 
-    auto ret = std::make_shared<ModelData>(std::move(cpuData), gpuHandle);
-    _models[std::string(path)] = ret;
+        request._model = std::make_shared<ModelData>(std::move(cpuData), gpuHandle);
+        request._state = ModelLoadState::eLoaded;
+    }
+    catch (const std::exception& e)
+    {
+        request._error = e.what();
+        request._state = ModelLoadState::eFailed;
 
-    return ret;
+        bblog::error("Failed to load model {}: {}", request._path, request._error);
+    }
 }
 
 entt::entity ModelData::Instantiate(Engine& engine, bool loadWithCollision)
@@ -19,7 +19,7 @@ std::shared_ptr<ControlsMenu> ControlsMenu::Create(const glm::uvec2& screenResol
     SamplerCreation samplerCreation;
     samplerCreation.minFilter = vk::Filter::eNearest;
     samplerCreation.magFilter = vk::Filter::eNearest;
-    menu->sampler = graphicsContext.Resources()->SamplerResourceManager().Create(samplerCreation);
+    menu->sampler = menu->resources.Own(graphicsContext.Resources()->SamplerResourceManager().Create(samplerCreation));
 
     {
         // common image data.
@@ -33,7 +33,7 @@ std::shared_ptr<ControlsMenu> ControlsMenu::Create(const glm::uvec2& screenResol
         constexpr std::byte transparent = static_cast<std::byte>(150);
         commonImageData.initialData = { black, black, black, transparent };
 
-        auto backdropImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData);
+        auto backdropImage = menu->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData));
         auto image = menu->AddChild<UIImage>(backdropImage, glm::vec2(), glm::vec2());
         image->anchorPoint = UIElement::AnchorPoint::eFill;
     }
@@ -47,9 +47,9 @@ std::shared_ptr<ControlsMenu> ControlsMenu::Create(const glm::uvec2& screenResol
         commonImageData.SetFlags(vk::ImageUsageFlagBits::eSampled);
         commonImageData.isHDR = false;
 
-        buttonStyle.normalImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), menu->sampler);
-        buttonStyle.hoveredImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), menu->sampler);
-        buttonStyle.pressedImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), menu->sampler);
+        buttonStyle.normalImage = menu->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), menu->sampler));
+        buttonStyle.hoveredImage = menu->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), menu->sampler));
+        buttonStyle.pressedImage = menu->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), menu->sampler));
     }
 
     glm::vec2 buttonPos = { 50.0f, 100.0f };
@@ -71,7 +71,7 @@ std::shared_ptr<ControlsMenu> ControlsMenu::Create(const glm::uvec2& screenResol
         commonImageData.SetFlags(vk::ImageUsageFlagBits::eSampled);
         commonImageData.isHDR = false;
 
-        auto image = popupPanel->AddChild<UIImage>(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/popup_background.png"), menu->sampler), glm::vec2(0.0f), glm::vec2(0.0f));
+        auto image = popupPanel->AddChild<UIImage>(menu->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/popup_background.png"), menu->sampler)), glm::vec2(0.0f), glm::vec2(0.0f));
         image->anchorPoint = UIElement::AnchorPoint::eFill;
     }
 
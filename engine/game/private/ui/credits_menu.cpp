@@ -17,7 +17,7 @@ std::shared_ptr<CreditsMenu> CreditsMenu::Create(
     const glm::uvec2& screenResolution,
     std::shared_ptr<UIFont> font)
 {
-    auto credits = std::make_shared<CreditsMenu>(screenResolution);
+    auto credits = std::make_shared<CreditsMenu>(screenResolution, graphicsContext);
 
     credits->anchorPoint = UIElement::AnchorPoint::eMiddle;
     credits->SetAbsoluteTransform(credits->GetAbsoluteLocation(), screenResolution);
@@ -39,7 +39,7 @@ std::shared_ptr<CreditsMenu> CreditsMenu::Create(
         constexpr std::byte transparent = static_cast<std::byte>(150);
         commonImageData.initialData = { black, black, black, transparent };
 
-        auto backdropImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData);
+        auto backdropImage = credits->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData));
         auto image = credits->AddChild<UIImage>(backdropImage, glm::vec2(), glm::vec2());
         image->anchorPoint = UIElement::AnchorPoint::eFill;
     }
@@ -53,9 +53,9 @@ std::shared_ptr<CreditsMenu> CreditsMenu::Create(
         commonImageData.SetFlags(vk::ImageUsageFlagBits::eSampled);
         commonImageData.isHDR = false;
 
-        buttonStyle.normalImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler);
-        buttonStyle.hoveredImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler);
-        buttonStyle.pressedImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler);
+        buttonStyle.normalImage = credits->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler));
+        buttonStyle.hoveredImage = credits->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler));
+        buttonStyle.pressedImage = credits->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler));
     }
 
     {
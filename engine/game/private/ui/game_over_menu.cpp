@@ -9,7 +9,7 @@
 
 std::shared_ptr<GameOverMenu> GameOverMenu::Create(GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font)
 {
-    auto over = std::make_shared<GameOverMenu>(screenResolution);
+    auto over = std::make_shared<GameOverMenu>(screenResolution, graphicsContext);
     over->anchorPoint = UIElement::AnchorPoint::eMiddle;
     over->SetAbsoluteTransform(over->GetAbsoluteLocation(), screenResolution);
 
@@ -30,7 +30,7 @@ std::shared_ptr<GameOverMenu> GameOverMenu::Create(GraphicsContext& graphicsCont
         constexpr std::byte transparent = static_cast<std::byte>(150);
         commonImageData.initialData = { black, black, black, transparent };
 
-        auto backdropImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData);
+        auto backdropImage = over->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData));
         auto image = over->AddChild<UIImage>(backdropImage, glm::vec2(), glm::vec2());
         image->anchorPoint = UIElement::AnchorPoint::eFill;
     }
@@ -44,9 +44,9 @@ std::shared_ptr<GameOverMenu> GameOverMenu::Create(GraphicsContext& graphicsCont
         commonImageData.SetFlags(vk::ImageUsageFlagBits::eSampled);
         commonImageData.isHDR = false;
 
-        buttonStyle.normalImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler);
-        buttonStyle.hoveredImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler);
-        buttonStyle.pressedImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler);
+        buttonStyle.normalImage = over->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler));
+        buttonStyle.hoveredImage = over->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler));
+        buttonStyle.pressedImage = over->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler));
     }
 
     auto buttonPanel = over->AddChild<Canvas>(glm::vec2 { 0.0f, 0.0f });
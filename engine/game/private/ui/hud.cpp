@@ -10,7 +10,7 @@
 
 #include <resource_management/sampler_resource_manager.hpp>
 
-UIProgressBar::BarStyle LoadHealthBarStyle(GraphicsContext& graphicsContext, auto sampler)
+UIProgressBar::BarStyle LoadHealthBarStyle(GraphicsContext& graphicsContext, ResourceOwner& resources, auto sampler)
 {
     // common image data.
     CPUImage commonImageData;
@@ -21,7 +21,7 @@ UIProgressBar::BarStyle LoadHealthBarStyle(GraphicsContext& graphicsContext, aut
 
     UIProgressBar::BarStyle barStyle;
     barStyle.empty = ResourceHandle<GPUImage>::Null();
-    barStyle.filled = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/health_bar.png"), sampler);
+    barStyle.filled = resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/health_bar.png"), sampler));
     barStyle.fillStyle = UIProgressBar::BarStyle::FillStyle::eMask;
     barStyle.fillDirection = UIProgressBar::BarStyle::FillDirection::eLeftToRight;
     return barStyle;
@@ -30,7 +30,7 @@ UIProgressBar::BarStyle LoadHealthBarStyle(GraphicsContext& graphicsContext, aut
 std::shared_ptr<HUD> HUD::Create(GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font)
 {
 
-    std::shared_ptr<HUD> hud = std::make_shared<HUD>(screenResolution);
+    std::shared_ptr<HUD> hud = std::make_shared<HUD>(screenResolution, graphicsContext);
 
     CPUImage commonImageData {};
     commonImageData.format
@@ -42,26 +42,26 @@ std::shared_ptr<HUD> HUD::Create(GraphicsContext& graphicsContext, const glm::uv
 
     samplerData.minFilter = vk::Filter::eNearest;
     samplerData.magFilter = vk::Filter::eNearest;
-    ResourceHandle<Sampler> HUDSampler = graphicsContext.Resources()->SamplerResourceManager().Create(samplerData);
+    ResourceHandle<Sampler> HUDSampler = hud->resources.Own(graphicsContext.Resources()->SamplerResourceManager().Create(samplerData));
 
     ImageResourceManager& imageManager = graphicsContext.Resources()->ImageResourceManager();
 
     hud->SetAbsoluteTransform(hud->GetAbsoluteLocation(), screenResolution);
 
-    ResourceHandle<GPUImage> crosshairImage = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/cross_hair.png"));
+    ResourceHandle<GPUImage> crosshairImage = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/cross_hair.png")));
     hud->AddChild<UIImage>(crosshairImage, glm::vec2(0, 7), glm::vec2(25, 42) * 2.0f);
 
     // stats bg
-    ResourceHandle<GPUImage> statsBGImage = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/stats_bg.png"), HUDSampler);
+    ResourceHandle<GPUImage> statsBGImage = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/stats_bg.png"), HUDSampler));
     auto statsBG = hud->AddChild<UIImage>(statsBGImage, glm::vec2(0, 0), glm::vec2(113, 39) * 8.0f);
     statsBG->anchorPoint = UIElement::AnchorPoint::eBottomLeft;
 
     // gun
-    ResourceHandle<GPUImage> gunBGImage = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/gun_bg.png"), HUDSampler);
+    ResourceHandle<GPUImage> gunBGImage = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/gun_bg.png"), HUDSampler));
     auto gunBG = hud->AddChild<UIImage>(gunBGImage, glm::vec2(0, 0), glm::vec2(69, 35) * 8.0f);
     gunBG->anchorPoint = UIElement::AnchorPoint::eBottomRight;
 
-    ResourceHandle<GPUImage> gunImage = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/gun.png"), HUDSampler);
+    ResourceHandle<GPUImage> gunImage = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/gun.png"), HUDSampler));
     auto gun = hud->AddChild<UIImage>(gunImage, glm::vec2(16, 12) * 8.0f, glm::vec2(19, 8) * 8.0f);
     gun->anchorPoint = UIElement::AnchorPoint::eBottomRight;
 
@@ -70,8 +70,8 @@ std::shared_ptr<HUD> HUD::Create(GraphicsContext& graphicsContext, const glm::uv
 
     // hitmarker
     auto hitmarkerImage
-        = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/hitmarker.png"));
-    auto hitmarkerCritImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/hitmarker_crit.png"));
+        = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/hitmarker.png")));
+    auto hitmarkerCritImage = hud->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/hitmarker_crit.png")));
 
     hud->hitmarker = hud->AddChild<UIImage>(hitmarkerImage, glm::vec2(0, 7), glm::vec2(25, 42) * 2.0f);
     hud->hitmarker.lock()->visibility = UIElement::VisibilityState::eNotUpdatedAndInvisible;
@@ -82,7 +82,7 @@ std::shared_ptr<HUD> HUD::Create(GraphicsContext& graphicsContext, const glm::uv
     // dashes
     ResourceHandle<GPUImage>
         dashChargeImage
-        = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/dash_charge.png"), HUDSampler);
+        = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/dash_charge.png"), HUDSampler));
 
     for (int32_t i = 0; i < static_cast<int32_t>(hud->dashCharges.size()); i++)
     {
@@ -91,22 +91,22 @@ std::shared_ptr<HUD> HUD::Create(GraphicsContext& graphicsContext, const glm::uv
     }
 
     // healthbar
-    UIProgressBar::BarStyle healthBarStyle = LoadHealthBarStyle(graphicsContext, HUDSampler);
+    UIProgressBar::BarStyle healthBarStyle = LoadHealthBarStyle(graphicsContext, hud->resources, HUDSampler);
     hud->healthBar = hud->AddChild<UIProgressBar>(healthBarStyle, glm::vec2(10, 11) * 8.0f, glm::vec2(94, 5) * 8.0f);
     hud->healthBar.lock()->anchorPoint = UIElement::AnchorPoint::eBottomLeft;
 
     // souls indicator
-    ResourceHandle<GPUImage> soulImage = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/souls_indicator.png"), HUDSampler);
+    ResourceHandle<GPUImage> soulImage = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/souls_indicator.png"), HUDSampler));
     hud->soulIndicator = hud->AddChild<UIImage>(soulImage, glm::vec2(11, 18) * 8.0f, glm::vec2(5, 8) * 8.0f);
     hud->soulIndicator.lock()->anchorPoint = UIElement::AnchorPoint::eBottomLeft;
 
-    ResourceHandle<GPUImage> waveBGImage = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/wave_bg.png"), HUDSampler);
+    ResourceHandle<GPUImage> waveBGImage = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/wave_bg.png"), HUDSampler));
     hud->AddChild<UIImage>(waveBGImage, glm::vec2(0, 0) * 8.0f, glm::vec2(59, 54) * 8.0f)->anchorPoint = UIElement::AnchorPoint::eTopRight;
 
-    ResourceHandle<GPUImage> coinImage = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/coin.png"), HUDSampler);
+    ResourceHandle<GPUImage> coinImage = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/coin.png"), HUDSampler));
     hud->AddChild<UIImage>(coinImage, glm::vec2(49, 20) * 8.0f + glm::vec2(300.f, 0), glm::vec2(4 * 8))->anchorPoint = UIElement::AnchorPoint::eBottomLeft;
 
-    ResourceHandle<GPUImage> directionalImage = imageManager.Create(commonImageData.FromPNG("assets/textures/ui/direction.png"), HUDSampler);
+    ResourceHandle<GPUImage> directionalImage = hud->resources.Own(imageManager.Create(commonImageData.FromPNG("assets/textures/ui/direction.png"), HUDSampler));
     for (auto& i : hud->directionalIndicators)
     {
         i = hud->AddChild<UIImage>(directionalImage, glm::vec2(0, 0), glm::vec2(21, 6) * 8.0f);
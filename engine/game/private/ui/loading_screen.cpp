@@ -8,7 +8,7 @@
 
 std::shared_ptr<LoadingScreen> LoadingScreen::Create(GraphicsContext& graphicsContext, InputBindingsVisualizationCache& inputVisualizationsCache, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font)
 {
-    auto loading = std::make_shared<LoadingScreen>(screenResolution, inputVisualizationsCache);
+    auto loading = std::make_shared<LoadingScreen>(screenResolution, graphicsContext, inputVisualizationsCache);
 
     loading->_font = font;
 
@@ -27,7 +27,7 @@ std::shared_ptr<LoadingScreen> LoadingScreen::Create(GraphicsContext& graphicsCo
         constexpr std::byte white = static_cast<std::byte>(255);
         commonImageData.initialData = { black, black, black, white };
 
-        auto backdropImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData);
+        auto backdropImage = loading->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData));
         auto image = loading->AddChild<UIImage>(backdropImage, glm::vec2(), glm::vec2());
         image->anchorPoint = UIElement::AnchorPoint::eFill;
     }
@@ -12,7 +12,7 @@
 
 std::shared_ptr<MainMenu> MainMenu::Create(GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font)
 {
-    auto main = std::make_shared<MainMenu>(screenResolution);
+    auto main = std::make_shared<MainMenu>(screenResolution, graphicsContext);
 
     main->anchorPoint = UIElement::AnchorPoint::eTopLeft;
     main->SetAbsoluteTransform(main->GetAbsoluteLocation(), screenResolution);
@@ -23,7 +23,7 @@ std::shared_ptr<MainMenu> MainMenu::Create(GraphicsContext& graphicsContext, con
     static ResourceHandle<Sampler> sampler = graphicsContext.Resources()->SamplerResourceManager().Create(samplerCreation);
 
     // resource loading.
-    auto loadButtonStyle = [&graphicsContext]()
+    auto loadButtonStyle = [&graphicsContext, &main]()
     {
         // common image data.
         CPUImage commonImageData;
@@ -32,9 +32,9 @@ std::shared_ptr<MainMenu> MainMenu::Create(GraphicsContext& graphicsContext, con
         commonImageData.isHDR = false;
 
         UIButton::ButtonStyle buttonStyle {
-            .normalImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler),
-            .hoveredImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler),
-            .pressedImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler)
+            .normalImage = main->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler)),
+            .hoveredImage = main->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler)),
+            .pressedImage = main->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler))
         };
         return buttonStyle;
     };
@@ -52,7 +52,7 @@ std::shared_ptr<MainMenu> MainMenu::Create(GraphicsContext& graphicsContext, con
         glm::vec2 pos = glm::vec2(screenResFloat.y * 0.1f);
         glm::vec2 size = glm::vec2((static_cast<float>(commonImageData.width) / static_cast<float>(commonImageData.height)), 1.0f) * (0.5f * screenResFloat.y);
 
-        ResourceHandle<GPUImage> logo = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData, sampler);
+        ResourceHandle<GPUImage> logo = main->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData, sampler));
 
         auto logoElement = main->AddChild<UIImage>(logo, pos, size);
         logoElement->anchorPoint = UIElement::AnchorPoint::eTopLeft;
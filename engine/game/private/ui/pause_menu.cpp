@@ -12,7 +12,7 @@
 
 std::shared_ptr<PauseMenu> PauseMenu::Create(GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font)
 {
-    auto pause = std::make_shared<PauseMenu>(screenResolution);
+    auto pause = std::make_shared<PauseMenu>(screenResolution, graphicsContext);
     pause->anchorPoint = UIElement::AnchorPoint::eMiddle;
     pause->SetAbsoluteTransform(pause->GetAbsoluteLocation(), screenResolution);
 
@@ -33,7 +33,7 @@ std::shared_ptr<PauseMenu> PauseMenu::Create(GraphicsContext& graphicsContext, c
         constexpr std::byte transparent = static_cast<std::byte>(150);
         commonImageData.initialData = { black, black, black, transparent };
 
-        auto backdropImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData);
+        auto backdropImage = pause->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData));
         auto image = pause->AddChild<UIImage>(backdropImage, glm::vec2(), glm::vec2());
         image->anchorPoint = UIElement::AnchorPoint::eFill;
     }
@@ -47,9 +47,9 @@ std::shared_ptr<PauseMenu> PauseMenu::Create(GraphicsContext& graphicsContext, c
         commonImageData.SetFlags(vk::ImageUsageFlagBits::eSampled);
         commonImageData.isHDR = false;
 
-        buttonStyle.normalImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler);
-        buttonStyle.hoveredImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler);
-        buttonStyle.pressedImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler);
+        buttonStyle.normalImage = pause->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler));
+        buttonStyle.hoveredImage = pause->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler));
+        buttonStyle.pressedImage = pause->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler));
     }
 
     auto buttonPanel = pause->AddChild<Canvas>(glm::vec2 { 0.0f, 0.0f });
@@ -19,7 +19,7 @@ std::shared_ptr<SettingsMenu> SettingsMenu::Create(
 {
     auto& gameModule = engine.GetModule<GameModule>();
 
-    auto settings = std::make_shared<SettingsMenu>(screenResolution);
+    auto settings = std::make_shared<SettingsMenu>(screenResolution, graphicsContext);
 
     settings->anchorPoint = UIElement::AnchorPoint::eMiddle;
     settings->SetAbsoluteTransform(settings->GetAbsoluteLocation(), screenResolution);
@@ -41,7 +41,7 @@ std::shared_ptr<SettingsMenu> SettingsMenu::Create(
         constexpr std::byte transparent = static_cast<std::byte>(150);
         commonImageData.initialData = { black, black, black, transparent };
 
-        auto backdropImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData);
+        auto backdropImage = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData));
         auto image = settings->AddChild<UIImage>(backdropImage, glm::vec2(), glm::vec2());
         image->anchorPoint = UIElement::AnchorPoint::eFill;
     }
@@ -55,9 +55,9 @@ std::shared_ptr<SettingsMenu> SettingsMenu::Create(
         commonImageData.SetFlags(vk::ImageUsageFlagBits::eSampled);
         commonImageData.isHDR = false;
 
-        buttonStyle.normalImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler);
-        buttonStyle.hoveredImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler);
-        buttonStyle.pressedImage = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler);
+        buttonStyle.normalImage = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button.png"), sampler));
+        buttonStyle.hoveredImage = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_2.png"), sampler));
+        buttonStyle.pressedImage = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/button_selected.png"), sampler));
     }
 
     UIToggle::ToggleStyle toggleStyle {};
@@ -69,8 +69,8 @@ std::shared_ptr<SettingsMenu> SettingsMenu::Create(
         commonImageData.SetFlags(vk::ImageUsageFlagBits::eSampled);
         commonImageData.isHDR = false;
 
-        toggleStyle.empty = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/toggle_empty.png"), sampler);
-        toggleStyle.filled = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/toggle_full.png"), sampler);
+        toggleStyle.empty = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/toggle_empty.png"), sampler));
+        toggleStyle.filled = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/toggle_full.png"), sampler));
     }
 
     UISlider::SliderStyle sliderStyle {};
@@ -84,9 +84,9 @@ std::shared_ptr<SettingsMenu> SettingsMenu::Create(
 
         sliderStyle.margin = 12.0f;
         sliderStyle.knobSize = glm::vec2 { 8, 8 } * 6.0f;
-        sliderStyle.empty = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/slider_empty.png"), sampler);
-        sliderStyle.filled = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/slider_full.png"), sampler);
-        sliderStyle.knob = graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/slider_knob.png"), sampler);
+        sliderStyle.empty = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/slider_empty.png"), sampler));
+        sliderStyle.filled = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/slider_full.png"), sampler));
+        sliderStyle.knob = settings->resources.Own(graphicsContext.Resources()->ImageResourceManager().Create(commonImageData.FromPNG("assets/textures/ui/slider_knob.png"), sampler));
     }
 
     {
@@ -49,7 +49,7 @@ class GameModule : public ModuleInterface
 {
     ModuleTickOrder Init(Engine& engine) override;
     void Tick(MAYBE_UNUSED Engine& engine) override;
-    void Shutdown(MAYBE_UNUSED Engine& engine) override;
+    void Shutdown(Engine& engine) override;
     std::string_view GetName() override { return "Game Module"; }
 
     glm::ivec2 _lastMousePos {};
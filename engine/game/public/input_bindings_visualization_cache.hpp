@@ -2,6 +2,7 @@
 
 #include "input/action_manager.hpp"
 #include "graphics_context.hpp"
+#include "resource_owner.hpp"
 
 struct GPUImage;
 
@@ -26,4 +27,5 @@ private:
     const ActionManager& _actionManager;
     GraphicsContext& _graphicsContext;
     std::unordered_map<std::string, ResourceHandle<GPUImage>> _glyphCache {};
+    ResourceOwner _glyphImages;
 };
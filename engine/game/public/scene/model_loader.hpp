@@ -1,8 +1,12 @@
 #pragma once
 
 #include "resource_management/model_resource_manager.hpp"
+#include "thread_pool.hpp"
 
+#include <atomic>
 #include <entt/entity/entity.hpp>
+#include <functional>
+#include <future>
 #include <string>
 
 class Engine;
@@ -15,6 +19,12 @@ struct ModelData
     {
     }
 
+    ModelData(CPUModel&& cpu, ResourceHandle<GPUModel> gpu)
+        : cpuModel(std::move(cpu))
+        , gpuModel(gpu)
+    {
+    }
+
     CPUModel cpuModel {};
     ResourceHandle<GPUModel> gpuModel {};
 
@@ -22,17 +32,96 @@ struct ModelData
     entt::entity InstantiateCollisions(Engine& engine);
 };
 
+enum class ModelLoadState
+{
+    eNotRequested,
+    eLoading,
+    eLoaded,
+    eFailed,
+    eCancelled,
+};
+
+// Handle to a model that is being loaded in the background, shared by everyone that requested the same path.
+// Only meant to be used from the main thread, the state changes when the ModelLoader finalizes its loads.
+class ModelLoadRequest
+{
+public:
+    ModelLoadState GetState() const { return _state; }
+    bool IsDone() const { return _state != ModelLoadState::eLoading; }
+    const std::string& GetPath() const { return _path; }
+
+    // Why the load failed, empty unless the state is eFailed
+    const std::string& GetError() const { return _error; }
+
+    // The loaded model, null until the state is eLoaded
+    std::shared_ptr<ModelData> GetModel() const { return _model; }
+
+    // Stops the load for everyone sharing this request, the CPU work is skipped if it did not start yet
+    void Cancel();
+
+private:
+    friend class ModelLoader;
+
+    std::string _path {};
+
+    ModelLoadState _state = ModelLoadState::eLoading;
+    std::string _error {};
+    std::shared_ptr<ModelData> _model {};
+
+    std::future<CPUModel> _cpuModel {};
+    std::shared_ptr<std::atomic<bool>> _cancelled = std::make_shared<std::atomic<bool>>(false);
+};
+
 class ModelLoader
 {
 public:
-    ModelLoader() = default;
+    // Produces the CPU side of a model, runs on a worker thread
+    using CPULoadFunction = std::function<CPUModel(std::string_view path, bool genCollision)>;
+
+    // Uploads a loaded model to the GPU, runs on the main thread
+    using GPUUploadFunction = std::function<ResourceHandle<GPUModel>(const CPUModel& cpuModel)>;
+
+    // Destroys a model that was uploaded to the GPU, runs on the main thread
+    using GPUReleaseFunction = std::function<void(ResourceHandle<GPUModel> gpuModel)>;
+
+    ModelLoader();
+    // Only cancels the loads in flight, the GPU side of loaded models is left to the renderer, which may already be gone
+    ~ModelLoader();
     NON_MOVABLE(ModelLoader);
     NON_COPYABLE(ModelLoader);
 
+    // Blocks until the model is loaded and uploaded, waiting on a request that is already in flight when there is one.
+    // Throws when the model could not be loaded.
     std::shared_ptr<ModelData> LoadModel(Engine& engine, std::string_view path, bool genCollision);
-    void Clear() { _models.clear(); }
+
+    // Starts loading the model in the background, it becomes available after a call to FinalizeLoads() once the CPU work is done.
+    // Requests for a path that is already loading or loaded return the existing request.
+    std::shared_ptr<ModelLoadRequest> LoadModelAsync(Engine& engine, std::string_view path, bool genCollision);
+    std::shared_ptr<ModelLoadRequest> LoadModelAsync(std::string_view path, bool genCollision, CPULoadFunction load);
+
+    // Uploads the models whose CPU work finished and marks failed or cancelled requests, call once per frame from the main thread
+    void FinalizeLoads(Engine& engine);
+    void FinalizeLoads(const GPUUploadFunction& upload);
+
+    // Waits for the CPU work of a request and finalizes only that request
+    void Wait(ModelLoadRequest& request, const GPUUploadFunction& upload);
+
+    ModelLoadState GetLoadState(std::string_view path) const;
+    void CancelLoad(std::string_view path);
+
+    // Cancels all loads that are still in flight and forgets every model, destroying the GPU side of the loaded ones.
+    // Entities instantiated from the models must be gone, the meshes and materials they draw with are destroyed as well.
+    void Clear(Engine& engine);
+    void Clear(const GPUReleaseFunction& release);
 
 private:
-    std::unordered_map<std::string, std::shared_ptr<ModelData>> _models {};
+    void Finalize(ModelLoadRequest& request, const GPUUploadFunction& upload);
+    void CancelPending();
+
+    // Requests run on their own workers, since parsing a model queues and waits on work in the engine's thread pool
+    static constexpr uint32_t REQUEST_THREAD_COUNT = 2;
+    std::unique_ptr<ThreadPool> _requestPool {};
+
+    std::unordered_map<std::string, std::shared_ptr<ModelLoadRequest>> _models {};
+    std::vector<std::shared_ptr<ModelLoadRequest>> _pending {};
 };
-;
@@ -2,6 +2,7 @@
 #include "canvas.hpp"
 #include "fonts.hpp"
 #include "input_bindings_visualization_cache.hpp"
+#include "resource_owner.hpp"
 #include "ui_button.hpp"
 #include "ui_slider.hpp"
 #include "ui_toggle.hpp"
@@ -20,11 +21,15 @@ class HUD : public Canvas
 public:
     static std::shared_ptr<HUD> Create(GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font);
 
-    HUD(const glm::uvec2& screenResolution)
+    HUD(const glm::uvec2& screenResolution, GraphicsContext& graphicsContext)
         : Canvas(screenResolution)
+        , resources(graphicsContext)
     {
     }
 
+    // The images the menu created
+    ResourceOwner resources;
+
     std::weak_ptr<UIProgressBar> healthBar;
     std::weak_ptr<UIProgressBar> ultBar;
     std::weak_ptr<UIProgressBar> sprintBar;
@@ -58,11 +63,15 @@ class MainMenu : public Canvas
 public:
     static std::shared_ptr<MainMenu> Create(GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font);
 
-    MainMenu(const glm::uvec2& screenResolution)
+    MainMenu(const glm::uvec2& screenResolution, GraphicsContext& graphicsContext)
         : Canvas(screenResolution)
+        , resources(graphicsContext)
     {
     }
 
+    // The images the menu created
+    ResourceOwner resources;
+
     std::weak_ptr<UIButton> playButton;
     std::weak_ptr<UIButton> settingsButton;
     std::weak_ptr<UIButton> controlsButton;
@@ -107,12 +116,16 @@ class LoadingScreen : public Canvas
 public:
     static std::shared_ptr<LoadingScreen> Create(GraphicsContext& graphicsContext, InputBindingsVisualizationCache& inputVisualizationsCache, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font);
 
-    LoadingScreen(const glm::uvec2& screenResolution, InputBindingsVisualizationCache& inputVisualizationsCache)
+    LoadingScreen(const glm::uvec2& screenResolution, GraphicsContext& graphicsContext, InputBindingsVisualizationCache& inputVisualizationsCache)
         : Canvas(screenResolution)
+        , resources(graphicsContext)
         , _inputVisualizationsCache(inputVisualizationsCache)
     {
     }
 
+    // The images the menu created
+    ResourceOwner resources;
+
     void SetDisplayText(std::string text);
     void SetDisplayTextColor(glm::vec4 color);
     void ShowContinuePrompt();
@@ -135,11 +148,15 @@ class PauseMenu : public Canvas
 public:
     static std::shared_ptr<PauseMenu> Create(GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font);
 
-    PauseMenu(const glm::uvec2& screenResolution)
+    PauseMenu(const glm::uvec2& screenResolution, GraphicsContext& graphicsContext)
         : Canvas(screenResolution)
+        , resources(graphicsContext)
     {
     }
 
+    // The images the menu created
+    ResourceOwner resources;
+
     std::weak_ptr<UIButton> continueButton;
     std::weak_ptr<UIButton> settingsButton;
     std::weak_ptr<UIButton> controlsButton;
@@ -151,11 +168,15 @@ class GameOverMenu : public Canvas
 public:
     static std::shared_ptr<GameOverMenu> Create(GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font);
 
-    GameOverMenu(const glm::uvec2& screenResolution)
+    GameOverMenu(const glm::uvec2& screenResolution, GraphicsContext& graphicsContext)
         : Canvas(screenResolution)
+        , resources(graphicsContext)
     {
     }
 
+    // The images the menu created
+    ResourceOwner resources;
+
     std::weak_ptr<UIButton> continueButton;
     std::weak_ptr<UIButton> backToMainButton;
 };
@@ -169,6 +190,7 @@ public:
 
     ControlsMenu(const glm::uvec2& screenResolution, const glm::ivec2 canvasResolution, GraphicsContext& graphicsContext, InputBindingsVisualizationCache& inputVisualizationsCache, ActionManager& actionManager, std::shared_ptr<UIFont> font)
         : Canvas(screenResolution)
+        , resources(graphicsContext)
         , _graphicsContext(graphicsContext)
         , _inputVisualizationsCache(inputVisualizationsCache)
         , _actionManager(actionManager)
@@ -206,6 +228,9 @@ public:
     std::vector<ActionSetControls> actionSetControls {};
     ResourceHandle<Sampler> sampler;
 
+    // The images and sampler the menu created
+    ResourceOwner resources;
+
 private:
     GraphicsContext& _graphicsContext;
     InputBindingsVisualizationCache& _inputVisualizationsCache;
@@ -222,11 +247,15 @@ class CreditsMenu : public Canvas
 public:
     static std::shared_ptr<CreditsMenu> Create(Engine& engine, GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font);
 
-    CreditsMenu(const glm::uvec2& screenResolution)
+    CreditsMenu(const glm::uvec2& screenResolution, GraphicsContext& graphicsContext)
         : Canvas(screenResolution)
+        , resources(graphicsContext)
     {
     }
 
+    // The images the menu created
+    ResourceOwner resources;
+
     std::weak_ptr<UIButton> backButton {};
 };
 
@@ -235,11 +264,15 @@ class SettingsMenu : public Canvas
 public:
     static std::shared_ptr<SettingsMenu> Create(Engine& engine, GraphicsContext& graphicsContext, const glm::uvec2& screenResolution, std::shared_ptr<UIFont> font);
 
-    SettingsMenu(const glm::uvec2& screenResolution)
+    SettingsMenu(const glm::uvec2& screenResolution, GraphicsContext& graphicsContext)
         : Canvas(screenResolution)
+        , resources(graphicsContext)
     {
     }
 
+    // The images the menu created
+    ResourceOwner resources;
+
     std::weak_ptr<UIToggle> fpsToggle {};
     std::weak_ptr<UISlider> sensitivitySlider {};
     std::weak_ptr<UISlider> fovSlider {};
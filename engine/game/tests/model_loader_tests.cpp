@@ -0,0 +1,282 @@
+#include "scene/model_loader.hpp"
+
+#include "../../resources/tests/model_test_helpers.hpp"
+#include "file_io.hpp"
+#include "model_loading.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <gtest/gtest.h>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+// Loads an empty model named after its path, once the gate opens
+struct GatedLoad
+{
+    std::shared_future<void> gate;
+    std::shared_ptr<std::atomic<uint32_t>> calls = std::make_shared<std::atomic<uint32_t>>(0);
+
+    CPUModel operator()(std::string_view path, MAYBE_UNUSED bool genCollision) const
+    {
+        ++*calls;
+        gate.wait();
+
+        CPUModel model {};
+        model.name = std::string(path);
+        return model;
+    }
+};
+
+struct CountedUpload
+{
+    std::shared_ptr<uint32_t> calls = std::make_shared<uint32_t>(0);
+
+    ResourceHandle<GPUModel> operator()(MAYBE_UNUSED const CPUModel& cpuModel) const
+    {
+        ++*calls;
+        return ResourceHandle<GPUModel>::Null();
+    }
+};
+
+void FinalizeUntilDone(ModelLoader& loader, const ModelLoadRequest& request, const ModelLoader::GPUUploadFunction& upload)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    while (!request.IsDone() && std::chrono::steady_clock::now() < timeout)
+    {
+        loader.FinalizeLoads(upload);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+}
+
+TEST(ModelLoaderTests, ConcurrentRequestsShareOneLoad)
+{
+    // Arrange
+    ModelLoader loader {};
+    std::promise<void> open {};
+    GatedLoad load { open.get_future().share() };
+    CountedUpload upload {};
+
+    // Act
+    auto first = loader.LoadModelAsync("shared.glb", false, load);
+    auto second = loader.LoadModelAsync("shared.glb", false, load);
+    auto third = loader.LoadModelAsync("shared.glb", true, load);
+
+    open.set_value();
+    loader.Wait(*second, upload);
+
+    // Assert
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first, third);
+    EXPECT_EQ(*load.calls, 1);
+    EXPECT_EQ(*upload.calls, 1);
+
+    ASSERT_EQ(first->GetState(), ModelLoadState::eLoaded);
+    ASSERT_NE(first->GetModel(), nullptr);
+    EXPECT_EQ(first->GetModel()->cpuModel.name, "shared.glb");
+    EXPECT_EQ(loader.LoadModelAsync("shared.glb", false, load), first);
+}
+
+TEST(ModelLoaderTests, FinalizeOnlyUploadsFinishedLoads)
+{
+    // Arrange
+    ModelLoader loader {};
+    std::promise<void> open {};
+    GatedLoad load { open.get_future().share() };
+    CountedUpload upload {};
+
+    auto request = loader.LoadModelAsync("gated.glb", false, load);
+
+    // Act
+    loader.FinalizeLoads(upload);
+    const ModelLoadState whileLoading = request->GetState();
+
+    open.set_value();
+    FinalizeUntilDone(loader, *request, upload);
+
+    // Assert
+    EXPECT_EQ(whileLoading, ModelLoadState::eLoading);
+    EXPECT_EQ(request->GetState(), ModelLoadState::eLoaded);
+    EXPECT_EQ(loader.GetLoadState("gated.glb"), ModelLoadState::eLoaded);
+    EXPECT_EQ(loader.GetLoadState("unknown.glb"), ModelLoadState::eNotRequested);
+    EXPECT_EQ(*upload.calls, 1);
+}
+
+TEST(ModelLoaderTests, CancelledRequestIsSkippedAndCanBeRequestedAgain)
+{
+    // Arrange, keep every request worker busy so the cancelled request is still queued
+    ModelLoader loader {};
+    std::promise<void> open {};
+    GatedLoad blocking { open.get_future().share() };
+    GatedLoad cancelledLoad { blocking.gate };
+    CountedUpload upload {};
+
+    auto first = loader.LoadModelAsync("first.glb", false, blocking);
+    auto second = loader.LoadModelAsync("second.glb", false, blocking);
+    auto cancelled = loader.LoadModelAsync("cancelled.glb", false, cancelledLoad);
+
+    // Act
+    loader.CancelLoad("cancelled.glb");
+    const ModelLoadState stateAfterCancel = loader.GetLoadState("cancelled.glb");
+
+    auto retried = loader.LoadModelAsync("cancelled.glb", false, cancelledLoad);
+
+    open.set_value();
+    loader.Wait(*first, upload);
+    loader.Wait(*second, upload);
+    loader.Wait(*retried, upload);
+
+    // Assert
+    EXPECT_EQ(stateAfterCancel, ModelLoadState::eCancelled);
+    EXPECT_EQ(cancelled->GetState(), ModelLoadState::eCancelled);
+    EXPECT_EQ(cancelled->GetModel(), nullptr);
+
+    EXPECT_NE(retried, cancelled);
+    EXPECT_EQ(retried->GetState(), ModelLoadState::eLoaded);
+    EXPECT_EQ(*cancelledLoad.calls, 1);
+    EXPECT_EQ(*upload.calls, 3);
+}
+
+TEST(ModelLoaderTests, ErrorsAreReportedAndRetried)
+{
+    // Arrange
+    ModelLoader loader {};
+    CountedUpload upload {};
+    bool shouldFail = true;
+
+    ModelLoader::CPULoadFunction load = [&shouldFail](std::string_view path, MAYBE_UNUSED bool genCollision)
+    {
+        if (shouldFail)
+            throw std::runtime_error("Unsupported glTF extension");
+
+        CPUModel model {};
+        model.name = std::string(path);
+        return model;
+    };
+
+    // Act
+    auto failed = loader.LoadModelAsync("broken.glb", false, load);
+    loader.Wait(*failed, upload);
+
+    shouldFail = false;
+    auto retried = loader.LoadModelAsync("broken.glb", false, load);
+    loader.Wait(*retried, upload);
+
+    // Assert
+    EXPECT_EQ(failed->GetState(), ModelLoadState::eFailed);
+    EXPECT_NE(failed->GetError().find("Unsupported glTF extension"), std::string::npos);
+    EXPECT_EQ(failed->GetModel(), nullptr);
+
+    EXPECT_NE(retried, failed);
+    EXPECT_EQ(retried->GetState(), ModelLoadState::eLoaded);
+    EXPECT_EQ(*upload.calls, 1);
+}
+
+TEST(ModelLoaderTests, FailedUploadIsReported)
+{
+    // Arrange
+    ModelLoader loader {};
+    std::promise<void> open {};
+    open.set_value();
+    GatedLoad load { open.get_future().share() };
+
+    ModelLoader::GPUUploadFunction upload = [](MAYBE_UNUSED const CPUModel& cpuModel) -> ResourceHandle<GPUModel>
+    {
+        throw std::runtime_error("Out of device memory");
+    };
+
+    // Act
+    auto request = loader.LoadModelAsync("large.glb", false, load);
+    loader.Wait(*request, upload);
+
+    // Assert
+    EXPECT_EQ(request->GetState(), ModelLoadState::eFailed);
+    EXPECT_EQ(loader.GetLoadState("large.glb"), ModelLoadState::eFailed);
+    EXPECT_NE(request->GetError().find("Out of device memory"), std::string::npos);
+}
+
+TEST(ModelLoaderTests, ClearReleasesLoadedModels)
+{
+    // Arrange
+    ModelLoader loader {};
+    std::promise<void> open {};
+    open.set_value();
+    GatedLoad load { open.get_future().share() };
+    CountedUpload upload {};
+    uint32_t releases = 0;
+
+    ModelLoader::GPUReleaseFunction release = [&releases](MAYBE_UNUSED ResourceHandle<GPUModel> gpuModel)
+    {
+        ++releases;
+    };
+
+    auto first = loader.LoadModelAsync("first.glb", false, load);
+    auto second = loader.LoadModelAsync("second.glb", false, load);
+    loader.Wait(*first, upload);
+    loader.Wait(*second, upload);
+
+    auto cancelled = loader.LoadModelAsync("cancelled.glb", false, load);
+    cancelled->Cancel();
+
+    // Act
+    loader.Clear(release);
+
+    // Assert
+    EXPECT_EQ(releases, 2);
+    EXPECT_EQ(loader.GetLoadState("first.glb"), ModelLoadState::eNotRequested);
+    EXPECT_EQ(loader.GetLoadState("cancelled.glb"), ModelLoadState::eNotRequested);
+}
+
+TEST(ModelLoaderTests, ConcurrentGLTFLoadsParseIndependently)
+{
+    // Arrange
+    const std::filesystem::path directory = "cache/tests/model_loader";
+    const std::string firstPath = (directory / "first.glb").generic_string();
+    const std::string secondPath = (directory / "second.glb").generic_string();
+
+    fileIO::Init(true);
+    std::filesystem::remove_all(directory);
+    TestGLBWriter::Write(firstPath, 24, 3);
+    TestGLBWriter::Write(secondPath, 16, 5);
+
+    ThreadPool threadPool { 2 };
+    threadPool.Start();
+
+    // Both requests start parsing together, on the loader's two request threads
+    std::latch started { 2 };
+    ModelLoader::CPULoadFunction load = [&threadPool, &started](std::string_view path, bool genCollision)
+    {
+        started.arrive_and_wait();
+        return ModelLoading::LoadGLTFFast(threadPool, path, genCollision);
+    };
+
+    ModelLoader loader {};
+    CountedUpload upload {};
+
+    // Act
+    auto first = loader.LoadModelAsync(firstPath, false, load);
+    auto second = loader.LoadModelAsync(secondPath, false, load);
+    loader.Wait(*first, upload);
+    loader.Wait(*second, upload);
+
+    // Assert
+    EXPECT_EQ(first->GetState(), ModelLoadState::eLoaded) << first->GetError();
+    EXPECT_EQ(second->GetState(), ModelLoadState::eLoaded) << second->GetError();
+
+    if (first->GetModel() && second->GetModel())
+    {
+        EXPECT_EQ(first->GetModel()->cpuModel.meshes.size(), 3);
+        EXPECT_EQ(second->GetModel()->cpuModel.meshes.size(), 5);
+        EXPECT_EQ(first->GetModel()->cpuModel.skinnedMeshes.size(), 1);
+        EXPECT_EQ(second->GetModel()->cpuModel.skinnedMeshes.size(), 1);
+    }
+
+    fileIO::Deinit();
+    std::filesystem::remove_all(directory);
+}
@@ -185,6 +185,15 @@ void InspectorModule::Tick(MAYBE_UNUSED Engine& engine)
             ImGui::Checkbox("Paths", &enabled);
             pathfindingModule.SetDebugDrawState(enabled);
 
+            const NavMeshPathCache::Stats& pathCacheStats = pathfindingModule.GetPathCache().GetStats();
+            ImGui::LabelText("Path cache hit rate", "%.1f%%", pathCacheStats.GetHitRate() * 100.0f);
+            ImGui::LabelText("Path cache hits", "%u full, %u partial", pathCacheStats.hits, pathCacheStats.partialHits);
+            ImGui::LabelText("Path cache misses", "%u", pathCacheStats.misses);
+            ImGui::LabelText("Path cache entries", "%u / %u", pathfindingModule.GetPathCache().GetSize(), pathfindingModule.GetPathCache().GetCapacity());
+
+            if (ImGui::Button("Reset path cache stats"))
+                pathfindingModule.GetPathCache().ResetStats();
+
             ImGui::EndMenu();
         }
 
@@ -25,6 +25,14 @@ ModuleTickOrder ParticleModule::Init(Engine& engine)
     return ModuleTickOrder::ePreRender;
 }
 
+void ParticleModule::Shutdown(MAYBE_UNUSED Engine& engine)
+{
+    for (const auto& [fileName, image] : _emitterImages)
+        _context->Resources()->ImageResourceManager().DestroyDeferred(image);
+
+    _emitterImages.clear();
+}
+
 void ParticleModule::Tick(MAYBE_UNUSED Engine& engine)
 {
     const auto emitterView = _ecs->GetRegistry().view<ParticleEmitterComponent, RigidbodyComponent>();
@@ -30,7 +30,7 @@ GENERATE_ENUM_FLAG_OPERATORS(SpawnEmitterFlagBits)
 class ParticleModule final : public ModuleInterface
 {
     ModuleTickOrder Init(Engine& engine) override;
-    void Shutdown(MAYBE_UNUSED Engine& engine) override {};
+    void Shutdown(MAYBE_UNUSED Engine& engine) override;
     void Tick(MAYBE_UNUSED Engine& engine) override;
     std::string_view GetName() override { return "Particle Module"; }
 
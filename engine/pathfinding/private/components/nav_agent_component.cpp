@@ -0,0 +1,43 @@
+#include "components/nav_agent_component.hpp"
+
+#include <entt/entity/registry.hpp>
+
+NavAgentComponent::NavAgentComponent(const NavAgentSettings& settings)
+    : settings(settings)
+{
+}
+
+void NavAgentComponent::SetTarget(const glm::vec3& target)
+{
+    _target = target;
+    _hasTarget = true;
+}
+
+void NavAgentComponent::Stop()
+{
+    // A pending search is cancelled by the system, as the component can't reach the query service
+    _hasTarget = false;
+    _state = NavAgentState::eIDLE;
+    _direction = glm::vec3 { 0.0f };
+    _preferredVelocity = glm::vec3 { 0.0f };
+    _path.clear();
+    _currentWaypoint = 0;
+}
+
+void NavAgentComponent::OnDestroyCallback(PathQueryService& queryService, entt::registry& registry, entt::entity entity)
+{
+    const auto& agent = registry.get<NavAgentComponent>(entity);
+
+    if (agent._request.IsValid())
+        queryService.Cancel(agent._request);
+}
+
+void NavAgentComponent::SetupRegistryCallbacks(entt::registry& registry, PathQueryService& queryService)
+{
+    registry.on_destroy<NavAgentComponent>().connect<OnDestroyCallback>(queryService);
+}
+
+void NavAgentComponent::DisconnectRegistryCallbacks(entt::registry& registry, PathQueryService& queryService)
+{
+    registry.on_destroy<NavAgentComponent>().disconnect<OnDestroyCallback>(queryService);
+}
@@ -0,0 +1,411 @@
+#include "crowd_avoidance.hpp"
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <thread>
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+constexpr float EPSILON = 0.00001f;
+
+// Agents with neighbours turn their preferred velocity slightly to the same side, agents meeting exactly head on
+// would otherwise both slow down to a stop instead of passing each other
+constexpr float SIDE_PREFERENCE_ANGLE = 0.05f;
+
+float Det(const glm::vec2& a, const glm::vec2& b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+float LengthSquared(const glm::vec2& v)
+{
+    return glm::dot(v, v);
+}
+
+glm::vec2 Horizontal(const glm::vec3& v)
+{
+    return glm::vec2 { v.x, v.z };
+}
+
+}
+
+CrowdAvoidance::CrowdAvoidance(const CrowdAvoidanceSettings& settings)
+    : _settings(settings)
+{
+}
+
+void CrowdAvoidance::Clear()
+{
+    _agents.clear();
+    _velocities.clear();
+}
+
+uint32_t CrowdAvoidance::AddAgent(const Agent& agent)
+{
+    _agents.emplace_back(agent);
+    return static_cast<uint32_t>(_agents.size()) - 1;
+}
+
+void CrowdAvoidance::ComputeVelocities(float deltaTime, ThreadPool* threadPool)
+{
+    ZoneScoped;
+
+    const uint32_t agentCount = static_cast<uint32_t>(_agents.size());
+    _velocities.assign(agentCount, glm::vec3 { 0.0f });
+
+    if (agentCount == 0 || deltaTime <= 0.0f)
+        return;
+
+    BuildSpatialHash();
+
+    uint32_t jobCount = (agentCount + MIN_AGENTS_PER_JOB - 1) / MIN_AGENTS_PER_JOB;
+    if (threadPool == nullptr)
+        jobCount = 1;
+    else
+        jobCount = std::min(jobCount, std::max(std::thread::hardware_concurrency(), 1u));
+
+    if (_scratch.size() < jobCount)
+        _scratch.resize(jobCount);
+
+    // The calling thread computes the last batch, instead of waiting idle for the others
+    const uint32_t agentsPerJob = (agentCount + jobCount - 1) / jobCount;
+    std::vector<std::future<void>> jobs {};
+
+    for (uint32_t job = 0; job + 1 < jobCount; ++job)
+    {
+        const uint32_t first = job * agentsPerJob;
+        const uint32_t last = std::min(first + agentsPerJob, agentCount);
+
+        jobs.emplace_back(threadPool->QueueWork([this, first, last, deltaTime, &scratch = _scratch[job]]()
+            { ComputeVelocities(first, last, deltaTime, scratch); }));
+    }
+
+    ComputeVelocities((jobCount - 1) * agentsPerJob, agentCount, deltaTime, _scratch[jobCount - 1]);
+
+    for (auto& job : jobs)
+        job.wait();
+}
+
+void CrowdAvoidance::BuildSpatialHash()
+{
+    ZoneScoped;
+
+    const uint32_t agentCount = static_cast<uint32_t>(_agents.size());
+    const float cellSize = std::max(_settings.neighbourDistance, EPSILON);
+
+    // Twice as many buckets as agents keeps the buckets shared by multiple cells rare
+    uint32_t bucketCount = 1;
+    while (bucketCount < agentCount * 2)
+        bucketCount <<= 1;
+
+    _bucketMask = bucketCount - 1;
+    _bucketStart.assign(bucketCount + 1, 0);
+    _bucketAgents.resize(agentCount);
+    _agentCells.resize(agentCount);
+
+    for (uint32_t i = 0; i < agentCount; ++i)
+    {
+        const glm::vec3& position = _agents[i].position;
+        _agentCells[i] = glm::ivec2 { std::floor(position.x / cellSize), std::floor(position.z / cellSize) };
+        _bucketStart[GetBucket(_agentCells[i].x, _agentCells[i].y)]++;
+    }
+
+    // Counting sort, so the agents of a bucket are next to each other. The running sums end up at the end of every bucket,
+    // filling the buckets back to front moves them to the start.
+    for (uint32_t i = 1; i <= bucketCount; ++i)
+        _bucketStart[i] += _bucketStart[i - 1];
+
+    for (uint32_t i = agentCount; i-- > 0;)
+        _bucketAgents[--_bucketStart[GetBucket(_agentCells[i].x, _agentCells[i].y)]] = i;
+}
+
+uint32_t CrowdAvoidance::GetBucket(int32_t x, int32_t z) const
+{
+    const uint32_t hash = (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(z) * 19349663u);
+    return hash & _bucketMask;
+}
+
+void CrowdAvoidance::FindNeighbours(uint32_t agent, Scratch& scratch) const
+{
+    scratch.neighbours.clear();
+
+    const Agent& self = _agents[agent];
+    const glm::ivec2 cell = _agentCells[agent];
+    const float rangeSquared = _settings.neighbourDistance * _settings.neighbourDistance;
+
+    // Neighbouring cells can share a bucket, which should only be searched once
+    std::array<uint32_t, 9> visited {};
+    uint32_t visitedCount = 0;
+
+    for (int32_t z = cell.y - 1; z <= cell.y + 1; ++z)
+    {
+        for (int32_t x = cell.x - 1; x <= cell.x + 1; ++x)
+        {
+            const uint32_t bucket = GetBucket(x, z);
+            if (std::find(visited.begin(), visited.begin() + visitedCount, bucket) != visited.begin() + visitedCount)
+                continue;
+
+            visited[visitedCount++] = bucket;
+
+            for (uint32_t i = _bucketStart[bucket]; i < _bucketStart[bucket + 1]; ++i)
+            {
+                const uint32_t other = _bucketAgents[i];
+                if (other == agent)
+                    continue;
+
+                const glm::vec3& position = _agents[other].position;
+                if (std::abs(position.y - self.position.y) > _settings.maxHeightDifference)
+                    continue;
+
+                const float distanceSquared = LengthSquared(Horizontal(position - self.position));
+                if (distanceSquared > rangeSquared)
+                    continue;
+
+                // Keeps the closest neighbours sorted by distance
+                if (scratch.neighbours.size() == _settings.maxNeighbours)
+                {
+                    if (_settings.maxNeighbours == 0 || distanceSquared >= scratch.neighbours.back().first)
+                        continue;
+
+                    scratch.neighbours.pop_back();
+                }
+
+                auto it = std::upper_bound(scratch.neighbours.begin(), scratch.neighbours.end(), distanceSquared, [](float distance, const auto& neighbour)
+                    { return distance < neighbour.first; });
+                scratch.neighbours.insert(it, { distanceSquared, other });
+            }
+        }
+    }
+}
+
+void CrowdAvoidance::ComputeVelocities(uint32_t first, uint32_t last, float deltaTime, Scratch& scratch)
+{
+    ZoneScopedN("Crowd Avoidance Batch");
+
+    const float inverseTimeHorizon = 1.0f / std::max(_settings.timeHorizon, EPSILON);
+    const float inverseDeltaTime = 1.0f / deltaTime;
+
+    for (uint32_t agent = first; agent < last; ++agent)
+    {
+        const Agent& self = _agents[agent];
+        const glm::vec2 position = Horizontal(self.position);
+        const glm::vec2 velocity = Horizontal(self.velocity);
+
+        FindNeighbours(agent, scratch);
+        scratch.lines.clear();
+
+        for (const auto& [distanceSquared, neighbour] : scratch.neighbours)
+        {
+            const Agent& other = _agents[neighbour];
+            const glm::vec2 relativePosition = Horizontal(other.position) - position;
+            const glm::vec2 relativeVelocity = velocity - Horizontal(other.velocity);
+            const float combinedRadius = self.radius + other.radius;
+            const float combinedRadiusSquared = combinedRadius * combinedRadius;
+
+            Line line {};
+            glm::vec2 u {};
+
+            if (distanceSquared > combinedRadiusSquared)
+            {
+                // Vector from the cutoff centre of the velocity obstacle to the relative velocity
+                const glm::vec2 w = relativeVelocity - inverseTimeHorizon * relativePosition;
+                const float wLengthSquared = LengthSquared(w);
+                const float dotProduct = glm::dot(w, relativePosition);
+
+                if (dotProduct < 0.0f && dotProduct * dotProduct > combinedRadiusSquared * wLengthSquared)
+                {
+                    // Closest to the cutoff circle
+                    const float wLength = std::sqrt(wLengthSquared);
+                    const glm::vec2 unitW = w / wLength;
+
+                    line.direction = glm::vec2 { unitW.y, -unitW.x };
+                    u = (combinedRadius * inverseTimeHorizon - wLength) * unitW;
+                }
+                else
+                {
+                    // Closest to one of the legs of the cone
+                    const float leg = std::sqrt(distanceSquared - combinedRadiusSquared);
+
+                    if (Det(relativePosition, w) > 0.0f)
+                        line.direction = glm::vec2 { relativePosition.x * leg - relativePosition.y * combinedRadius, relativePosition.x * combinedRadius + relativePosition.y * leg } / distanceSquared;
+                    else
+                        line.direction = -glm::vec2 { relativePosition.x * leg + relativePosition.y * combinedRadius, -relativePosition.x * combinedRadius + relativePosition.y * leg } / distanceSquared;
+
+                    u = glm::dot(relativeVelocity, line.direction) * line.direction - relativeVelocity;
+                }
+            }
+            else
+            {
+                // Already overlapping, move apart within this update
+                glm::vec2 w = relativeVelocity - inverseDeltaTime * relativePosition;
+                float wLength = glm::length(w);
+
+                // Agents on the exact same spot pick opposite directions based on their order
+                if (wLength < EPSILON)
+                {
+                    w = glm::vec2 { agent < neighbour ? -1.0f : 1.0f, 0.0f };
+                    wLength = 1.0f;
+                }
+
+                const glm::vec2 unitW = w / wLength;
+                line.direction = glm::vec2 { unitW.y, -unitW.x };
+                u = (combinedRadius * inverseDeltaTime - wLength) * unitW;
+            }
+
+            // Each agent of the pair takes half of the responsibility
+            line.point = velocity + 0.5f * u;
+            scratch.lines.emplace_back(line);
+        }
+
+        glm::vec2 preferredVelocity = Horizontal(self.preferredVelocity);
+
+        if (!scratch.lines.empty())
+        {
+            const float cos = std::cos(SIDE_PREFERENCE_ANGLE);
+            const float sin = std::sin(SIDE_PREFERENCE_ANGLE);
+            preferredVelocity = glm::vec2 { preferredVelocity.x * cos - preferredVelocity.y * sin, preferredVelocity.x * sin + preferredVelocity.y * cos };
+        }
+
+        glm::vec2 result {};
+        const uint32_t lineFail = LinearProgram2(scratch.lines, self.maxSpeed, preferredVelocity, false, result);
+
+        // No velocity satisfies all constraints, take the one that violates them the least
+        if (lineFail < scratch.lines.size())
+            LinearProgram3(scratch.lines, lineFail, self.maxSpeed, result, scratch.projectedLines);
+
+        _velocities[agent] = glm::vec3 { result.x, 0.0f, result.y };
+    }
+}
+
+bool CrowdAvoidance::LinearProgram1(const std::vector<Line>& lines, uint32_t lineNo, float radius, const glm::vec2& optVelocity, bool directionOpt, glm::vec2& result)
+{
+    const Line& line = lines[lineNo];
+    const float dotProduct = glm::dot(line.point, line.direction);
+    const float discriminant = dotProduct * dotProduct + radius * radius - LengthSquared(line.point);
+
+    // The max speed circle doesn't reach the line
+    if (discriminant < 0.0f)
+        return false;
+
+    const float sqrtDiscriminant = std::sqrt(discriminant);
+    float tLeft = -dotProduct - sqrtDiscriminant;
+    float tRight = -dotProduct + sqrtDiscriminant;
+
+    for (uint32_t i = 0; i < lineNo; ++i)
+    {
+        const float denominator = Det(line.direction, lines[i].direction);
+        const float numerator = Det(lines[i].direction, line.point - lines[i].point);
+
+        // Parallel lines
+        if (std::abs(denominator) <= EPSILON)
+        {
+            if (numerator < 0.0f)
+                return false;
+
+            continue;
+        }
+
+        const float t = numerator / denominator;
+
+        if (denominator >= 0.0f)
+            tRight = std::min(tRight, t);
+        else
+            tLeft = std::max(tLeft, t);
+
+        if (tLeft > tRight)
+            return false;
+    }
+
+    if (directionOpt)
+    {
+        result = line.point + (glm::dot(optVelocity, line.direction) > 0.0f ? tRight : tLeft) * line.direction;
+    }
+    else
+    {
+        const float t = glm::clamp(glm::dot(line.direction, optVelocity - line.point), tLeft, tRight);
+        result = line.point + t * line.direction;
+    }
+
+    return true;
+}
+
+uint32_t CrowdAvoidance::LinearProgram2(const std::vector<Line>& lines, float radius, const glm::vec2& optVelocity, bool directionOpt, glm::vec2& result)
+{
+    if (directionOpt)
+        result = optVelocity * radius;
+    else if (LengthSquared(optVelocity) > radius * radius)
+        result = glm::normalize(optVelocity) * radius;
+    else
+        result = optVelocity;
+
+    for (uint32_t i = 0; i < lines.size(); ++i)
+    {
+        // Only lines the result is on the wrong side of change it
+        if (Det(lines[i].direction, lines[i].point - result) > 0.0f)
+        {
+            const glm::vec2 previousResult = result;
+
+            if (!LinearProgram1(lines, i, radius, optVelocity, directionOpt, result))
+            {
+                result = previousResult;
+                return i;
+            }
+        }
+    }
+
+    return static_cast<uint32_t>(lines.size());
+}
+
+void CrowdAvoidance::LinearProgram3(const std::vector<Line>& lines, uint32_t beginLine, float radius, glm::vec2& result, std::vector<Line>& projectedLines)
+{
+    float distance = 0.0f;
+
+    for (uint32_t i = beginLine; i < lines.size(); ++i)
+    {
+        if (Det(lines[i].direction, lines[i].point - result) <= distance)
+            continue;
+
+        // The result violates this line more than the previous ones, minimize the violation of all lines before it
+        projectedLines.clear();
+
+        for (uint32_t j = 0; j < i; ++j)
+        {
+            Line line {};
+            const float determinant = Det(lines[i].direction, lines[j].direction);
+
+            if (std::abs(determinant) <= EPSILON)
+            {
+                // Parallel lines pointing the same way don't limit the result any further
+                if (glm::dot(lines[i].direction, lines[j].direction) > 0.0f)
+                    continue;
+
+                line.point = 0.5f * (lines[i].point + lines[j].point);
+            }
+            else
+            {
+                line.point = lines[i].point + (Det(lines[j].direction, lines[i].point - lines[j].point) / determinant) * lines[i].direction;
+            }
+
+            line.direction = glm::normalize(lines[j].direction - lines[i].direction);
+            projectedLines.emplace_back(line);
+        }
+
+        const glm::vec2 previousResult = result;
+
+        if (LinearProgram2(projectedLines, radius, glm::vec2 { -lines[i].direction.y, lines[i].direction.x }, true, result) < projectedLines.size())
+        {
+            // Can only fail because of floating point errors, the result is then already the best it can be
+            result = previousResult;
+        }
+
+        distance = Det(lines[i].direction, lines[i].point - result);
+    }
+}
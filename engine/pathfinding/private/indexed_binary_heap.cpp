@@ -0,0 +1,97 @@
+#include "indexed_binary_heap.hpp"
+
+void IndexedBinaryHeap::Reserve(uint32_t capacity)
+{
+    if (capacity == _positions.size())
+        return;
+
+    _heap.clear();
+    _heap.reserve(capacity);
+    _positions.assign(capacity, std::numeric_limits<uint32_t>::max());
+    _keys.assign(capacity, 0.0f);
+}
+
+void IndexedBinaryHeap::Push(uint32_t item, float key)
+{
+    _keys[item] = key;
+    _heap.emplace_back(item);
+    _positions[item] = static_cast<uint32_t>(_heap.size() - 1);
+
+    SiftUp(_positions[item]);
+}
+
+void IndexedBinaryHeap::DecreaseKey(uint32_t item, float key)
+{
+    if (key >= _keys[item])
+        return;
+
+    _keys[item] = key;
+    SiftUp(_positions[item]);
+}
+
+uint32_t IndexedBinaryHeap::Pop()
+{
+    const uint32_t top = _heap.front();
+    const uint32_t last = _heap.back();
+    _heap.pop_back();
+
+    if (!_heap.empty())
+    {
+        Place(0, last);
+        SiftDown(0);
+    }
+
+    // Makes Contains fail for the popped item, even when its old slot gets reused
+    _positions[top] = std::numeric_limits<uint32_t>::max();
+    return top;
+}
+
+void IndexedBinaryHeap::SiftUp(uint32_t position)
+{
+    const uint32_t item = _heap[position];
+    const float key = _keys[item];
+
+    while (position > 0)
+    {
+        const uint32_t parent = (position - 1) / 2;
+
+        if (_keys[_heap[parent]] <= key)
+            break;
+
+        Place(position, _heap[parent]);
+        position = parent;
+    }
+
+    Place(position, item);
+}
+
+void IndexedBinaryHeap::SiftDown(uint32_t position)
+{
+    const uint32_t item = _heap[position];
+    const float key = _keys[item];
+    const uint32_t size = static_cast<uint32_t>(_heap.size());
+
+    while (true)
+    {
+        uint32_t child = position * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && _keys[_heap[child + 1]] < _keys[_heap[child]])
+            child++;
+
+        if (key <= _keys[_heap[child]])
+            break;
+
+        Place(position, _heap[child]);
+        position = child;
+    }
+
+    Place(position, item);
+}
+
+void IndexedBinaryHeap::Place(uint32_t position, uint32_t item)
+{
+    _heap[position] = item;
+    _positions[item] = position;
+}
@@ -0,0 +1,116 @@
+#include "navmesh.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <tracy/Tracy.hpp>
+
+NavMesh::NavMesh(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices)
+    : _vertices(std::move(vertices))
+    , _indices(std::move(indices))
+{
+    ZoneScoped;
+
+    BuildTriangles();
+    _spatialIndex.Build(_vertices, _indices);
+    _hierarchy.Build(*this, _spatialIndex.GetCellSize() * CLUSTER_SIZE_IN_CELLS);
+}
+
+uint32_t NavMesh::FindClosestTriangleBruteForce(const glm::vec3& point) const
+{
+    uint32_t closestTriangle = INVALID_TRIANGLE;
+    float closestDistanceSquared = std::numeric_limits<float>::max();
+
+    for (uint32_t i = 0; i < _triangles.size(); ++i)
+    {
+        const Triangle& triangle = _triangles[i];
+        float distanceSquared = NavMeshSpatialIndex::DistanceSquaredToTriangle(point,
+            _vertices[triangle.indices[0]], _vertices[triangle.indices[1]], _vertices[triangle.indices[2]]);
+
+        if (distanceSquared < closestDistanceSquared)
+        {
+            closestDistanceSquared = distanceSquared;
+            closestTriangle = i;
+        }
+    }
+
+    return closestTriangle;
+}
+
+glm::vec3 NavMesh::ClosestPointOnTriangle(uint32_t triangle, const glm::vec3& point) const
+{
+    const Triangle& info = _triangles[triangle];
+    return NavMeshSpatialIndex::ClosestPointOnTriangle(point, _vertices[info.indices[0]], _vertices[info.indices[1]], _vertices[info.indices[2]]);
+}
+
+bool NavMesh::GetSharedEdge(uint32_t a, uint32_t b, uint32_t& first, uint32_t& second) const
+{
+    const Triangle& from = _triangles[a];
+    const Triangle& to = _triangles[b];
+    uint32_t shared = 0;
+
+    for (uint32_t i = 0; i < 3 && shared < 2; i++)
+    {
+        if (std::find(std::begin(to.indices), std::end(to.indices), from.indices[i]) == std::end(to.indices))
+            continue;
+
+        (shared == 0 ? first : second) = from.indices[i];
+        shared++;
+    }
+
+    return shared == 2;
+}
+
+void NavMesh::BuildTriangles()
+{
+    _triangles.clear();
+    _triangles.reserve(_indices.size() / 3);
+
+    // We store all the triangles with their indices and center points
+    for (size_t i = 0; i + 2 < _indices.size(); i += 3)
+    {
+        Triangle triangle {};
+        triangle.indices[0] = _indices[i];
+        triangle.indices[1] = _indices[i + 1];
+        triangle.indices[2] = _indices[i + 2];
+        triangle.centre = (_vertices[triangle.indices[0]] + _vertices[triangle.indices[1]] + _vertices[triangle.indices[2]]) / 3.0f;
+
+        _triangles.emplace_back(triangle);
+    }
+
+    // Two triangles that share an edge are adjacent, edges are keyed by their sorted vertex indices
+    std::unordered_map<uint64_t, uint32_t> edgeToTriangle;
+    edgeToTriangle.reserve(_indices.size());
+
+    auto link = [this](uint32_t from, uint32_t to)
+    {
+        Triangle& triangle = _triangles[from];
+
+        for (uint32_t k = 0; k < triangle.adjacentTriangleCount; k++)
+        {
+            if (triangle.adjacentTriangleIndices[k] == to)
+                return;
+        }
+
+        if (triangle.adjacentTriangleCount < 3)
+            triangle.adjacentTriangleIndices[triangle.adjacentTriangleCount++] = to;
+    };
+
+    for (uint32_t i = 0; i < _triangles.size(); i++)
+    {
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            uint32_t a = _triangles[i].indices[j];
+            uint32_t b = _triangles[i].indices[(j + 1) % 3];
+            uint64_t edge = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+
+            auto [it, inserted] = edgeToTriangle.try_emplace(edge, i);
+
+            if (!inserted && it->second != i)
+            {
+                link(i, it->second);
+                link(it->second, i);
+            }
+        }
+    }
+}
@@ -0,0 +1,342 @@
+#include "navmesh_bake.hpp"
+
+#include "file_io.hpp"
+#include "hash_util.hpp"
+#include "log.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+constexpr uint32_t NAVMESH_BAKE_MAGIC = 0x4E424242; // "BBBN"
+
+struct NavMeshBakeHeader
+{
+    uint32_t magic = NAVMESH_BAKE_MAGIC;
+    uint32_t version = NavMeshBake::BAKE_VERSION;
+    NavMeshBake::Key sourceKey = 0;
+
+    glm::vec2 indexMin { 0.0f };
+    glm::uvec2 indexCellCount { 0 };
+    float indexCellSize = 1.0f;
+    float clusterSize = 0.0f;
+};
+
+// Arrays are written as their element count followed by their bytes, the file is only ever read back by the same build,
+// so there is no need to care about endianness or the layout of the structs
+class BakeWriter
+{
+public:
+    template <typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        _bytes.insert(_bytes.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    void WriteArray(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(static_cast<uint32_t>(values.size()));
+
+        const auto* bytes = reinterpret_cast<const std::byte*>(values.data());
+        _bytes.insert(_bytes.end(), bytes, bytes + values.size() * sizeof(T));
+    }
+
+    void Reserve(size_t size) { _bytes.reserve(size); }
+    NO_DISCARD std::vector<std::byte> TakeBytes() { return std::move(_bytes); }
+
+private:
+    std::vector<std::byte> _bytes {};
+};
+
+class BakeReader
+{
+public:
+    explicit BakeReader(std::span<const std::byte> bytes)
+        : _bytes(bytes)
+    {
+    }
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (_bytes.size() - _offset < sizeof(T))
+            return false;
+
+        std::memcpy(&value, _bytes.data() + _offset, sizeof(T));
+        _offset += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool ReadArray(std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        uint32_t count = 0;
+        if (!Read(count) || (_bytes.size() - _offset) / sizeof(T) < count)
+            return false;
+
+        values.resize(count);
+        std::memcpy(values.data(), _bytes.data() + _offset, count * sizeof(T));
+        _offset += count * sizeof(T);
+        return true;
+    }
+
+    NO_DISCARD bool IsAtEnd() const { return _offset == _bytes.size(); }
+
+private:
+    std::span<const std::byte> _bytes;
+    size_t _offset = 0;
+};
+
+// Offsets into a flat array, as used by the spatial index and the hierarchy, have to stay within it
+template <typename T>
+bool IsRangeValid(uint32_t first, uint32_t count, const std::vector<T>& values)
+{
+    return first <= values.size() && count <= values.size() - first;
+}
+
+}
+
+std::optional<NavMeshBake::Key> NavMeshBake::MakeSourceKey(std::string_view source)
+{
+    const std::optional<fileIO::FileInfo> info = fileIO::GetFileInfo(std::string { source });
+
+    if (!info.has_value())
+        return std::nullopt;
+
+    Key key = hashing::FNV1a(source.data(), source.size());
+    key = hashing::FNV1aValue(info->size, key);
+    key = hashing::FNV1aValue(info->lastWriteTime, key);
+    return key;
+}
+
+std::filesystem::path NavMeshBake::GetBakedPath(const std::filesystem::path& source, const std::filesystem::path& directory)
+{
+    const std::string path = source.generic_string();
+    return directory / fmt::format("{:016x}.navmesh", hashing::FNV1a(path.data(), path.size()));
+}
+
+std::vector<std::byte> NavMeshBake::Serialize(const NavMesh& navMesh, Key sourceKey)
+{
+    ZoneScoped;
+
+    const NavMeshSpatialIndex& index = navMesh._spatialIndex;
+    const NavMeshHierarchy& hierarchy = navMesh._hierarchy;
+
+    NavMeshBakeHeader header {};
+    header.sourceKey = sourceKey;
+    header.indexMin = index._min;
+    header.indexCellCount = index._cellCount;
+    header.indexCellSize = index._cellSize;
+    header.clusterSize = hierarchy._clusterSize;
+
+    BakeWriter writer {};
+    writer.Reserve(sizeof(header)
+        + navMesh._vertices.size() * sizeof(glm::vec3)
+        + navMesh._indices.size() * sizeof(uint32_t)
+        + navMesh._triangles.size() * (sizeof(NavMesh::Triangle) + sizeof(uint32_t) * 3)
+        + (index._cellStart.size() + index._cellTriangles.size()) * sizeof(uint32_t)
+        + hierarchy._clusters.size() * sizeof(NavMeshHierarchy::Cluster)
+        + hierarchy._nodes.size() * sizeof(NavMeshHierarchy::Node)
+        + hierarchy._edges.size() * sizeof(NavMeshHierarchy::Edge)
+        + sizeof(uint32_t) * 10);
+
+    writer.Write(header);
+
+    writer.WriteArray(navMesh._vertices);
+    writer.WriteArray(navMesh._indices);
+    writer.WriteArray(navMesh._triangles);
+
+    writer.WriteArray(index._cellStart);
+    writer.WriteArray(index._cellTriangles);
+
+    writer.WriteArray(hierarchy._clusters);
+    writer.WriteArray(hierarchy._nodes);
+    writer.WriteArray(hierarchy._edges);
+    writer.WriteArray(hierarchy._triangleClusters);
+    writer.WriteArray(hierarchy._triangleNodes);
+    writer.WriteArray(hierarchy._clusterTriangles);
+
+    return writer.TakeBytes();
+}
+
+std::optional<NavMesh> NavMeshBake::Deserialize(std::span<const std::byte> bytes, Key sourceKey)
+{
+    ZoneScoped;
+
+    BakeReader reader { bytes };
+    NavMeshBakeHeader header {};
+
+    if (!reader.Read(header) || header.magic != NAVMESH_BAKE_MAGIC || header.version != BAKE_VERSION || header.sourceKey != sourceKey)
+        return std::nullopt;
+
+    NavMesh navMesh {};
+    NavMeshSpatialIndex& index = navMesh._spatialIndex;
+    NavMeshHierarchy& hierarchy = navMesh._hierarchy;
+
+    index._min = header.indexMin;
+    index._cellCount = header.indexCellCount;
+    index._cellSize = header.indexCellSize;
+    hierarchy._clusterSize = header.clusterSize;
+
+    const bool complete = reader.ReadArray(navMesh._vertices)
+        && reader.ReadArray(navMesh._indices)
+        && reader.ReadArray(navMesh._triangles)
+        && reader.ReadArray(index._cellStart)
+        && reader.ReadArray(index._cellTriangles)
+        && reader.ReadArray(hierarchy._clusters)
+        && reader.ReadArray(hierarchy._nodes)
+        && reader.ReadArray(hierarchy._edges)
+        && reader.ReadArray(hierarchy._triangleClusters)
+        && reader.ReadArray(hierarchy._triangleNodes)
+        && reader.ReadArray(hierarchy._clusterTriangles)
+        && reader.IsAtEnd();
+
+    if (!complete || !IsValid(navMesh))
+        return std::nullopt;
+
+    // The corners of the spatial index are a copy of the vertices, cheaper to gather again than to store twice
+    index._triangleCount = navMesh.GetTriangleCount();
+    index._corners.resize(navMesh._indices.size());
+
+    for (size_t i = 0; i < navMesh._indices.size(); ++i)
+        index._corners[i] = navMesh._vertices[navMesh._indices[i]];
+
+    return navMesh;
+}
+
+bool NavMeshBake::Save(const NavMesh& navMesh, const std::filesystem::path& path, Key sourceKey)
+{
+    ZoneScoped;
+
+    return fileIO::WriteFileAtomically(path, Serialize(navMesh, sourceKey));
+}
+
+std::optional<NavMesh> NavMeshBake::Load(const std::filesystem::path& path, Key sourceKey)
+{
+    ZoneScoped;
+
+    std::error_code error {};
+    const uintmax_t size = std::filesystem::file_size(path, error);
+
+    if (error)
+        return std::nullopt;
+
+    std::ifstream file { path, std::ios::in | std::ios::binary };
+
+    if (!file)
+        return std::nullopt;
+
+    std::vector<std::byte> bytes(size);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size));
+
+    if (!file)
+        return std::nullopt;
+
+    std::optional<NavMesh> navMesh = Deserialize(bytes, sourceKey);
+
+    if (!navMesh.has_value())
+        bblog::info("[PATHFINDING] Discarding outdated or corrupt navmesh bake {}", path.generic_string());
+
+    return navMesh;
+}
+
+bool NavMeshBake::IsValid(const NavMesh& navMesh)
+{
+    const NavMeshSpatialIndex& index = navMesh._spatialIndex;
+    const NavMeshHierarchy& hierarchy = navMesh._hierarchy;
+
+    const uint32_t vertexCount = static_cast<uint32_t>(navMesh.GetVertices().size());
+    const uint32_t triangleCount = navMesh.GetTriangleCount();
+
+    if (navMesh.GetIndices().size() != static_cast<size_t>(triangleCount) * 3)
+        return false;
+
+    for (const NavMesh::Triangle& triangle : navMesh.GetTriangles())
+    {
+        if (triangle.adjacentTriangleCount > 3)
+            return false;
+
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            if (triangle.indices[i] >= vertexCount)
+                return false;
+        }
+
+        for (uint32_t i = 0; i < triangle.adjacentTriangleCount; ++i)
+        {
+            if (triangle.adjacentTriangleIndices[i] >= triangleCount)
+                return false;
+        }
+    }
+
+    if (triangleCount > 0)
+    {
+        const uint64_t cellCount = static_cast<uint64_t>(index._cellCount.x) * index._cellCount.y;
+
+        if (cellCount == 0 || index._cellStart.size() != cellCount + 1 || index._cellStart.front() != 0 || index._cellStart.back() != index._cellTriangles.size())
+            return false;
+
+        for (size_t i = 1; i < index._cellStart.size(); ++i)
+        {
+            if (index._cellStart[i] < index._cellStart[i - 1])
+                return false;
+        }
+
+        for (uint32_t triangle : index._cellTriangles)
+        {
+            if (triangle >= triangleCount)
+                return false;
+        }
+    }
+
+    if (hierarchy._clusters.empty())
+        return hierarchy._nodes.empty() && hierarchy._triangleClusters.empty();
+
+    if (hierarchy._triangleClusters.size() != triangleCount || hierarchy._triangleNodes.size() != triangleCount || hierarchy._clusterTriangles.size() != triangleCount)
+        return false;
+
+    const uint32_t clusterCount = hierarchy.GetClusterCount();
+    const uint32_t nodeCount = hierarchy.GetNodeCount();
+
+    for (const NavMeshHierarchy::Cluster& cluster : hierarchy._clusters)
+    {
+        if (!IsRangeValid(cluster.firstTriangle, cluster.triangleCount, hierarchy._clusterTriangles) || !IsRangeValid(cluster.firstNode, cluster.nodeCount, hierarchy._nodes))
+            return false;
+    }
+
+    for (const NavMeshHierarchy::Node& node : hierarchy._nodes)
+    {
+        if (node.triangle >= triangleCount || node.cluster >= clusterCount || !IsRangeValid(node.firstEdge, node.edgeCount, hierarchy._edges))
+            return false;
+    }
+
+    for (const NavMeshHierarchy::Edge& edge : hierarchy._edges)
+    {
+        if (edge.node >= nodeCount)
+            return false;
+    }
+
+    for (uint32_t i = 0; i < triangleCount; ++i)
+    {
+        if (hierarchy._triangleClusters[i] >= clusterCount || hierarchy._clusterTriangles[i] >= triangleCount)
+            return false;
+
+        if (hierarchy._triangleNodes[i] != NavMeshHierarchy::INVALID_INDEX && hierarchy._triangleNodes[i] >= nodeCount)
+            return false;
+    }
+
+    return true;
+}
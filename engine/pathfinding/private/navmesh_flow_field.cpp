@@ -0,0 +1,130 @@
+#include "navmesh_flow_field.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <tracy/Tracy.hpp>
+
+bool NavMeshFlowField::Build(const NavMesh& navMesh, const glm::vec3& target)
+{
+    ZoneScoped;
+
+    _timeSinceBuild = DeltaMS { 0.0f };
+    _target = target;
+    _targetTriangle = navMesh.FindClosestTriangle(target);
+
+    if (_targetTriangle == NavMesh::INVALID_TRIANGLE)
+    {
+        Clear();
+        return false;
+    }
+
+    const uint32_t triangleCount = navMesh.GetTriangleCount();
+    const std::vector<NavMesh::Triangle>& triangles = navMesh.GetTriangles();
+    const std::vector<glm::vec3>& vertices = navMesh.GetVertices();
+
+    _distances.assign(triangleCount, UNREACHABLE);
+    _nextTriangles.assign(triangleCount, NavMesh::INVALID_TRIANGLE);
+    _waypoints.resize(triangleCount);
+
+    _openList.Reserve(triangleCount);
+    _openList.Clear();
+
+    _distances[_targetTriangle] = 0.0f;
+    _waypoints[_targetTriangle] = target;
+    _openList.Push(_targetTriangle, 0.0f);
+
+    // Walking between two centres costs the same in both directions, so searching outwards from the target
+    // finds the shortest path from every triangle towards it
+    while (!_openList.Empty())
+    {
+        const uint32_t current = _openList.Pop();
+        const NavMesh::Triangle& triangle = triangles[current];
+
+        for (uint32_t i = 0; i < triangle.adjacentTriangleCount; i++)
+        {
+            const uint32_t neighbour = triangle.adjacentTriangleIndices[i];
+            const float distance = _distances[current] + glm::distance(triangle.centre, triangles[neighbour].centre);
+
+            if (distance >= _distances[neighbour])
+                continue;
+
+            if (_distances[neighbour] == UNREACHABLE)
+                _openList.Push(neighbour, distance);
+            else
+                _openList.DecreaseKey(neighbour, distance);
+
+            _distances[neighbour] = distance;
+            _nextTriangles[neighbour] = current;
+        }
+    }
+
+    for (uint32_t i = 0; i < triangleCount; i++)
+    {
+        uint32_t first, second;
+
+        if (_nextTriangles[i] != NavMesh::INVALID_TRIANGLE && navMesh.GetSharedEdge(i, _nextTriangles[i], first, second))
+            _waypoints[i] = (vertices[first] + vertices[second]) * 0.5f;
+        else if (i != _targetTriangle)
+            _waypoints[i] = triangles[i].centre;
+    }
+
+    _buildCount++;
+    return true;
+}
+
+void NavMeshFlowField::Clear()
+{
+    _targetTriangle = NavMesh::INVALID_TRIANGLE;
+    _distances.clear();
+    _nextTriangles.clear();
+    _waypoints.clear();
+    _openList.Clear();
+}
+
+bool NavMeshFlowField::Update(const NavMesh& navMesh, const glm::vec3& target, DeltaMS deltatime)
+{
+    _timeSinceBuild += deltatime;
+
+    if (navMesh.IsEmpty())
+    {
+        Clear();
+        return false;
+    }
+
+    const bool outdated = !IsValid() || GetTriangleCount() != navMesh.GetTriangleCount() || _timeSinceBuild >= _refreshInterval;
+
+    if (outdated || navMesh.FindClosestTriangle(target) != _targetTriangle)
+        return Build(navMesh, target);
+
+    _target = target;
+    _waypoints[_targetTriangle] = target;
+    return false;
+}
+
+glm::vec3 NavMeshFlowField::SampleDirection(uint32_t triangle, const glm::vec3& position) const
+{
+    if (triangle >= _distances.size() || !IsReachable(triangle))
+        return glm::vec3 { 0.0f };
+
+    auto directionTo = [&](const glm::vec3& waypoint)
+    {
+        glm::vec3 offset = waypoint - position;
+        offset.y = 0.0f;
+
+        const float length = glm::length(offset);
+        return length > 0.0001f ? offset / length : glm::vec3 { 0.0f };
+    };
+
+    const glm::vec3 direction = directionTo(_waypoints[triangle]);
+
+    // Standing on the edge into the next triangle, which the position can still be assigned to, keep going
+    if (direction == glm::vec3 { 0.0f } && _nextTriangles[triangle] != NavMesh::INVALID_TRIANGLE)
+        return directionTo(_waypoints[_nextTriangles[triangle]]);
+
+    return direction;
+}
+
+glm::vec3 NavMeshFlowField::SampleDirection(const NavMesh& navMesh, const glm::vec3& position) const
+{
+    return SampleDirection(navMesh.FindClosestTriangle(position), position);
+}
@@ -0,0 +1,339 @@
+#include "navmesh_hierarchy.hpp"
+
+#include "indexed_binary_heap.hpp"
+#include "navmesh.hpp"
+
+#include <algorithm>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+bool AreAdjacent(const NavMesh::Triangle& triangle, uint32_t other)
+{
+    for (uint32_t i = 0; i < triangle.adjacentTriangleCount; i++)
+    {
+        if (triangle.adjacentTriangleIndices[i] == other)
+            return true;
+    }
+
+    return false;
+}
+
+}
+
+void NavMeshHierarchy::Build(const NavMesh& navMesh, float clusterSize)
+{
+    ZoneScoped;
+
+    Clear();
+
+    if (navMesh.IsEmpty())
+        return;
+
+    _clusterSize = glm::max(clusterSize, 0.0001f);
+
+    BuildClusters(navMesh);
+
+    const std::vector<Portal> portals = FindPortals(navMesh);
+    BuildNodes(portals);
+    BuildEdges(navMesh, portals);
+}
+
+void NavMeshHierarchy::Clear()
+{
+    _clusterSize = 0.0f;
+    _clusters.clear();
+    _nodes.clear();
+    _edges.clear();
+    _triangleClusters.clear();
+    _triangleNodes.clear();
+    _clusterTriangles.clear();
+}
+
+void NavMeshHierarchy::BuildClusters(const NavMesh& navMesh)
+{
+    const std::vector<NavMesh::Triangle>& triangles = navMesh.GetTriangles();
+    const uint32_t triangleCount = navMesh.GetTriangleCount();
+
+    glm::vec2 min { std::numeric_limits<float>::max() };
+    for (const NavMesh::Triangle& triangle : triangles)
+        min = glm::min(min, glm::vec2 { triangle.centre.x, triangle.centre.z });
+
+    // Grid cell of every triangle centre, packed into a single key
+    std::vector<uint64_t> cells(triangleCount);
+
+    for (uint32_t i = 0; i < triangleCount; i++)
+    {
+        const glm::uvec2 cell { glm::floor((glm::vec2 { triangles[i].centre.x, triangles[i].centre.z } - min) / _clusterSize) };
+        cells[i] = (static_cast<uint64_t>(cell.y) << 32) | cell.x;
+    }
+
+    _triangleClusters.assign(triangleCount, INVALID_INDEX);
+    _clusterTriangles.reserve(triangleCount);
+
+    // Flood fill within the cell, so a cell that holds parts of the navmesh that are not connected inside it gets a cluster for each part
+    for (uint32_t i = 0; i < triangleCount; i++)
+    {
+        if (_triangleClusters[i] != INVALID_INDEX)
+            continue;
+
+        const uint32_t cluster = static_cast<uint32_t>(_clusters.size());
+        Cluster& info = _clusters.emplace_back();
+        info.firstTriangle = static_cast<uint32_t>(_clusterTriangles.size());
+
+        _triangleClusters[i] = cluster;
+        _clusterTriangles.emplace_back(i);
+
+        for (size_t next = info.firstTriangle; next < _clusterTriangles.size(); next++)
+        {
+            const NavMesh::Triangle& triangle = triangles[_clusterTriangles[next]];
+
+            for (uint32_t j = 0; j < triangle.adjacentTriangleCount; j++)
+            {
+                const uint32_t neighbour = triangle.adjacentTriangleIndices[j];
+
+                if (_triangleClusters[neighbour] != INVALID_INDEX || cells[neighbour] != cells[i])
+                    continue;
+
+                _triangleClusters[neighbour] = cluster;
+                _clusterTriangles.emplace_back(neighbour);
+            }
+        }
+
+        info.triangleCount = static_cast<uint32_t>(_clusterTriangles.size()) - info.firstTriangle;
+    }
+}
+
+std::vector<NavMeshHierarchy::Portal> NavMeshHierarchy::FindPortals(const NavMesh& navMesh) const
+{
+    const std::vector<NavMesh::Triangle>& triangles = navMesh.GetTriangles();
+    const std::vector<glm::vec3>& vertices = navMesh.GetVertices();
+
+    // Every pair of adjacent triangles in different clusters, ordered so the first is in the cluster with the lowest index
+    std::vector<Portal> crossings {};
+
+    for (uint32_t i = 0; i < triangles.size(); i++)
+    {
+        for (uint32_t j = 0; j < triangles[i].adjacentTriangleCount; j++)
+        {
+            const uint32_t neighbour = triangles[i].adjacentTriangleIndices[j];
+
+            if (_triangleClusters[i] < _triangleClusters[neighbour])
+                crossings.emplace_back(i, neighbour);
+        }
+    }
+
+    std::sort(crossings.begin(), crossings.end(), [this](const Portal& a, const Portal& b)
+        {
+            const auto keyA = std::make_pair(_triangleClusters[a.first], _triangleClusters[a.second]);
+            const auto keyB = std::make_pair(_triangleClusters[b.first], _triangleClusters[b.second]);
+            return keyA != keyB ? keyA < keyB : a < b;
+        });
+
+    auto sameClusters = [this](const Portal& a, const Portal& b)
+    {
+        return _triangleClusters[a.first] == _triangleClusters[b.first] && _triangleClusters[a.second] == _triangleClusters[b.second];
+    };
+
+    // Crossings next to each other form an entrance, either side of them sharing or neighbouring a triangle
+    auto touching = [&](const Portal& a, const Portal& b)
+    {
+        return a.first == b.first || a.second == b.second
+            || AreAdjacent(triangles[a.first], b.first) || AreAdjacent(triangles[a.second], b.second);
+    };
+
+    auto edgeCentre = [&](const Portal& crossing)
+    {
+        uint32_t first, second;
+        navMesh.GetSharedEdge(crossing.first, crossing.second, first, second);
+        return (vertices[first] + vertices[second]) * 0.5f;
+    };
+
+    std::vector<Portal> portals {};
+    std::vector<bool> visited(crossings.size(), false);
+    std::vector<size_t> entrance {};
+
+    for (size_t groupStart = 0; groupStart < crossings.size();)
+    {
+        size_t groupEnd = groupStart + 1;
+        while (groupEnd < crossings.size() && sameClusters(crossings[groupStart], crossings[groupEnd]))
+            groupEnd++;
+
+        for (size_t i = groupStart; i < groupEnd; i++)
+        {
+            if (visited[i])
+                continue;
+
+            entrance.clear();
+            entrance.emplace_back(i);
+            visited[i] = true;
+
+            for (size_t next = 0; next < entrance.size(); next++)
+            {
+                for (size_t j = groupStart; j < groupEnd; j++)
+                {
+                    if (!visited[j] && touching(crossings[entrance[next]], crossings[j]))
+                    {
+                        visited[j] = true;
+                        entrance.emplace_back(j);
+                    }
+                }
+            }
+
+            glm::vec3 middle { 0.0f };
+            for (size_t crossing : entrance)
+                middle += edgeCentre(crossings[crossing]);
+            middle /= static_cast<float>(entrance.size());
+
+            auto findCrossing = [&](const glm::vec3& point, bool furthest)
+            {
+                size_t found = entrance.front();
+                float foundDistance = furthest ? -1.0f : std::numeric_limits<float>::max();
+
+                for (size_t crossing : entrance)
+                {
+                    const float distance = glm::distance(edgeCentre(crossings[crossing]), point);
+                    if (furthest ? distance > foundDistance : distance < foundDistance)
+                    {
+                        foundDistance = distance;
+                        found = crossing;
+                    }
+                }
+
+                return found;
+            };
+
+            // The crossing closest to the middle of the entrance becomes its portal
+            const size_t centre = findCrossing(middle, false);
+            portals.emplace_back(crossings[centre]);
+
+            if (entrance.size() >= LONG_ENTRANCE_CROSSINGS)
+            {
+                const size_t firstEnd = findCrossing(middle, true);
+                const size_t secondEnd = findCrossing(edgeCentre(crossings[firstEnd]), true);
+
+                if (firstEnd != centre)
+                    portals.emplace_back(crossings[firstEnd]);
+                if (secondEnd != centre && secondEnd != firstEnd)
+                    portals.emplace_back(crossings[secondEnd]);
+            }
+        }
+
+        groupStart = groupEnd;
+    }
+
+    return portals;
+}
+
+void NavMeshHierarchy::BuildNodes(const std::vector<Portal>& portals)
+{
+    std::vector<uint32_t> portalTriangles {};
+    portalTriangles.reserve(portals.size() * 2);
+
+    for (const Portal& portal : portals)
+    {
+        portalTriangles.emplace_back(portal.first);
+        portalTriangles.emplace_back(portal.second);
+    }
+
+    // Sorted by cluster, so the nodes of a cluster are stored next to each other
+    std::sort(portalTriangles.begin(), portalTriangles.end(), [this](uint32_t a, uint32_t b)
+        { return std::make_pair(_triangleClusters[a], a) < std::make_pair(_triangleClusters[b], b); });
+    portalTriangles.erase(std::unique(portalTriangles.begin(), portalTriangles.end()), portalTriangles.end());
+
+    _triangleNodes.assign(_triangleClusters.size(), INVALID_INDEX);
+    _nodes.reserve(portalTriangles.size());
+
+    for (uint32_t triangle : portalTriangles)
+    {
+        const uint32_t node = static_cast<uint32_t>(_nodes.size());
+        const uint32_t cluster = _triangleClusters[triangle];
+
+        _nodes.emplace_back(Node { triangle, cluster, 0, 0 });
+        _triangleNodes[triangle] = node;
+
+        if (_clusters[cluster].nodeCount++ == 0)
+            _clusters[cluster].firstNode = node;
+    }
+}
+
+void NavMeshHierarchy::BuildEdges(const NavMesh& navMesh, const std::vector<Portal>& portals)
+{
+    const std::vector<NavMesh::Triangle>& triangles = navMesh.GetTriangles();
+    std::vector<std::vector<Edge>> nodeEdges(_nodes.size());
+
+    for (const Portal& portal : portals)
+    {
+        const float cost = glm::distance(triangles[portal.first].centre, triangles[portal.second].centre);
+        const uint32_t first = _triangleNodes[portal.first];
+        const uint32_t second = _triangleNodes[portal.second];
+
+        nodeEdges[first].push_back({ second, cost });
+        nodeEdges[second].push_back({ first, cost });
+    }
+
+    // Dijkstra from every node to the other nodes of its cluster, without leaving the cluster
+    constexpr float UNREACHABLE = std::numeric_limits<float>::max();
+
+    IndexedBinaryHeap openList {};
+    openList.Reserve(navMesh.GetTriangleCount());
+    std::vector<float> distances(navMesh.GetTriangleCount(), UNREACHABLE);
+
+    for (uint32_t cluster = 0; cluster < _clusters.size(); cluster++)
+    {
+        const Cluster& info = _clusters[cluster];
+
+        for (uint32_t node = info.firstNode; node < info.firstNode + info.nodeCount; node++)
+        {
+            distances[_nodes[node].triangle] = 0.0f;
+            openList.Push(_nodes[node].triangle, 0.0f);
+
+            while (!openList.Empty())
+            {
+                const uint32_t current = openList.Pop();
+                const NavMesh::Triangle& triangle = triangles[current];
+
+                for (uint32_t i = 0; i < triangle.adjacentTriangleCount; i++)
+                {
+                    const uint32_t neighbour = triangle.adjacentTriangleIndices[i];
+                    if (_triangleClusters[neighbour] != cluster)
+                        continue;
+
+                    const float distance = distances[current] + glm::distance(triangle.centre, triangles[neighbour].centre);
+                    if (distance >= distances[neighbour])
+                        continue;
+
+                    if (distances[neighbour] == UNREACHABLE)
+                        openList.Push(neighbour, distance);
+                    else
+                        openList.DecreaseKey(neighbour, distance);
+
+                    distances[neighbour] = distance;
+                }
+            }
+
+            for (uint32_t other = info.firstNode; other < info.firstNode + info.nodeCount; other++)
+            {
+                const float distance = distances[_nodes[other].triangle];
+
+                if (other != node && distance != UNREACHABLE)
+                    nodeEdges[node].push_back({ other, distance });
+            }
+
+            for (uint32_t triangle : GetTrianglesInCluster(cluster))
+                distances[triangle] = UNREACHABLE;
+        }
+    }
+
+    for (uint32_t node = 0; node < _nodes.size(); node++)
+    {
+        _nodes[node].firstEdge = static_cast<uint32_t>(_edges.size());
+        _nodes[node].edgeCount = static_cast<uint32_t>(nodeEdges[node].size());
+        _edges.insert(_edges.end(), nodeEdges[node].begin(), nodeEdges[node].end());
+    }
+}
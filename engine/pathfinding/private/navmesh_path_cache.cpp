@@ -0,0 +1,176 @@
+#include "navmesh_path_cache.hpp"
+
+#include "navmesh.hpp"
+#include "navmesh_query.hpp"
+
+#include <tracy/Tracy.hpp>
+
+NavMeshPathCache::NavMeshPathCache(uint32_t capacity)
+    : _capacity(capacity)
+{
+}
+
+NavMeshPathCache::LookupResult NavMeshPathCache::FindPath(const NavMesh& navMesh, NavMeshQuery& query, uint32_t startTriangle, uint32_t goalTriangle,
+    const glm::vec3& start, const glm::vec3& end, bool smooth, std::vector<glm::vec3>& points)
+{
+    ZoneScoped;
+
+    points.clear();
+
+    auto it = _lookup.find(MakeKey(startTriangle, goalTriangle));
+    if (it == _lookup.end())
+    {
+        _stats.misses++;
+        return LookupResult::eMISS;
+    }
+
+    const uint32_t index = it->second;
+    Unlink(index);
+    PushFront(index);
+
+    Entry& entry = _entries[index];
+
+    if (entry.corridor.empty())
+    {
+        _stats.hits++;
+        return LookupResult::eUNREACHABLE;
+    }
+
+    if (entry.start == start && entry.end == end && entry.smooth == smooth)
+    {
+        _stats.hits++;
+        points = entry.points;
+        return LookupResult::eFOUND;
+    }
+
+    _stats.partialHits++;
+    query.BuildPath(navMesh, entry.corridor, start, end, smooth, points);
+
+    // Agents tend to ask for the same path again, until they moved far enough to end up in another triangle
+    entry.start = start;
+    entry.end = end;
+    entry.smooth = smooth;
+    entry.points = points;
+
+    return LookupResult::eFOUND;
+}
+
+void NavMeshPathCache::Store(uint32_t startTriangle, uint32_t goalTriangle, const std::vector<uint32_t>& corridor,
+    const glm::vec3& start, const glm::vec3& end, bool smooth, const std::vector<glm::vec3>& points)
+{
+    if (_capacity == 0)
+        return;
+
+    const uint64_t key = MakeKey(startTriangle, goalTriangle);
+    uint32_t index = INVALID_ENTRY;
+
+    if (auto it = _lookup.find(key); it != _lookup.end())
+    {
+        index = it->second;
+        Unlink(index);
+    }
+    else
+    {
+        if (_lookup.size() >= _capacity)
+            EvictLeastRecentlyUsed();
+
+        if (!_freeEntries.empty())
+        {
+            index = _freeEntries.back();
+            _freeEntries.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(_entries.size());
+            _entries.emplace_back();
+        }
+
+        _lookup.emplace(key, index);
+    }
+
+    // Assigning keeps the memory of reused entries
+    Entry& entry = _entries[index];
+    entry.key = key;
+    entry.corridor.assign(corridor.begin(), corridor.end());
+    entry.start = start;
+    entry.end = end;
+    entry.smooth = smooth;
+    entry.points.assign(points.begin(), points.end());
+
+    PushFront(index);
+}
+
+void NavMeshPathCache::Invalidate()
+{
+    if (_lookup.empty())
+        return;
+
+    _stats.invalidations++;
+
+    _lookup.clear();
+    _freeEntries.clear();
+
+    for (uint32_t i = 0; i < _entries.size(); ++i)
+        _freeEntries.emplace_back(static_cast<uint32_t>(_entries.size()) - 1 - i);
+
+    _mostRecent = INVALID_ENTRY;
+    _leastRecent = INVALID_ENTRY;
+}
+
+void NavMeshPathCache::SetCapacity(uint32_t capacity)
+{
+    _capacity = capacity;
+
+    while (_lookup.size() > _capacity)
+        EvictLeastRecentlyUsed();
+}
+
+uint64_t NavMeshPathCache::MakeKey(uint32_t startTriangle, uint32_t goalTriangle)
+{
+    return (static_cast<uint64_t>(startTriangle) << 32) | goalTriangle;
+}
+
+void NavMeshPathCache::Unlink(uint32_t entry)
+{
+    Entry& info = _entries[entry];
+
+    if (info.previous != INVALID_ENTRY)
+        _entries[info.previous].next = info.next;
+    else
+        _mostRecent = info.next;
+
+    if (info.next != INVALID_ENTRY)
+        _entries[info.next].previous = info.previous;
+    else
+        _leastRecent = info.previous;
+
+    info.previous = INVALID_ENTRY;
+    info.next = INVALID_ENTRY;
+}
+
+void NavMeshPathCache::PushFront(uint32_t entry)
+{
+    Entry& info = _entries[entry];
+    info.previous = INVALID_ENTRY;
+    info.next = _mostRecent;
+
+    if (_mostRecent != INVALID_ENTRY)
+        _entries[_mostRecent].previous = entry;
+    else
+        _leastRecent = entry;
+
+    _mostRecent = entry;
+}
+
+void NavMeshPathCache::EvictLeastRecentlyUsed()
+{
+    if (_leastRecent == INVALID_ENTRY)
+        return;
+
+    const uint32_t entry = _leastRecent;
+    Unlink(entry);
+
+    _lookup.erase(_entries[entry].key);
+    _freeEntries.emplace_back(entry);
+    _stats.evictions++;
+}
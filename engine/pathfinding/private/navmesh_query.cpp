@@ -0,0 +1,559 @@
+#include "navmesh_query.hpp"
+
+#include "navmesh.hpp"
+
+#include <algorithm>
+#include <glm/geometric.hpp>
+
+#include <tracy/Tracy.hpp>
+
+bool NavMeshQuery::FindCorridor(const NavMesh& navMesh, uint32_t startTriangle, uint32_t goalTriangle, std::vector<uint32_t>& corridor)
+{
+    ZoneScoped;
+
+    BeginSearch(navMesh, startTriangle, goalTriangle);
+    UpdateSearch(std::numeric_limits<uint32_t>::max());
+
+    return FinishSearch(corridor);
+}
+
+NavMeshQuery::SearchStatus NavMeshQuery::BeginSearch(const NavMesh& navMesh, uint32_t startTriangle, uint32_t goalTriangle)
+{
+    _navMesh = &navMesh;
+    _goalTriangle = goalTriangle;
+    _lastCost = 0.0f;
+    _lastExpandedCount = 0;
+
+    const uint32_t triangleCount = navMesh.GetTriangleCount();
+    if (startTriangle >= triangleCount || goalTriangle >= triangleCount)
+        return _status = SearchStatus::eFAILED;
+
+    ResetNodes(_nodes, _openList, _generation, triangleCount);
+
+    _nodes[startTriangle] = Node { 0.0f, NavMesh::INVALID_TRIANGLE, _generation, false };
+    _openList.Push(startTriangle, glm::distance(navMesh.GetTriangle(startTriangle).centre, navMesh.GetTriangle(goalTriangle).centre));
+
+    return _status = SearchStatus::eIN_PROGRESS;
+}
+
+NavMeshQuery::SearchStatus NavMeshQuery::UpdateSearch(uint32_t maxExpansions)
+{
+    if (_status != SearchStatus::eIN_PROGRESS)
+        return _status;
+
+    const std::vector<NavMesh::Triangle>& triangles = _navMesh->GetTriangles();
+    const glm::vec3 goalCentre = triangles[_goalTriangle].centre;
+
+    // Straight line distance to the goal never overestimates the cost of walking between centres,
+    // so the first time the goal is taken from the open list its path is the shortest one
+    auto heuristic = [&](uint32_t triangle)
+    {
+        return glm::distance(triangles[triangle].centre, goalCentre);
+    };
+
+    for (uint32_t expansions = 0; expansions < maxExpansions; expansions++)
+    {
+        if (_openList.Empty())
+            return _status = SearchStatus::eFAILED;
+
+        const uint32_t current = _openList.Pop();
+        Node& currentNode = _nodes[current];
+        currentNode.closed = true;
+        _lastExpandedCount++;
+
+        if (current == _goalTriangle)
+        {
+            _lastCost = currentNode.cost;
+            return _status = SearchStatus::eSUCCEEDED;
+        }
+
+        const NavMesh::Triangle& triangle = triangles[current];
+
+        for (uint32_t i = 0; i < triangle.adjacentTriangleCount; i++)
+        {
+            const uint32_t neighbour = triangle.adjacentTriangleIndices[i];
+            Node& neighbourNode = _nodes[neighbour];
+            const float cost = currentNode.cost + glm::distance(triangle.centre, triangles[neighbour].centre);
+
+            // First time this search reaches the triangle
+            if (neighbourNode.generation != _generation)
+            {
+                neighbourNode = Node { cost, current, _generation, false };
+                _openList.Push(neighbour, cost + heuristic(neighbour));
+                continue;
+            }
+
+            if (neighbourNode.closed || cost >= neighbourNode.cost)
+                continue;
+
+            neighbourNode.cost = cost;
+            neighbourNode.parent = current;
+            _openList.DecreaseKey(neighbour, cost + heuristic(neighbour));
+        }
+    }
+
+    return _status;
+}
+
+bool NavMeshQuery::FinishSearch(std::vector<uint32_t>& corridor)
+{
+    corridor.clear();
+
+    if (_status != SearchStatus::eSUCCEEDED)
+        return false;
+
+    for (uint32_t triangle = _goalTriangle; triangle != NavMesh::INVALID_TRIANGLE; triangle = _nodes[triangle].parent)
+        corridor.emplace_back(triangle);
+
+    std::reverse(corridor.begin(), corridor.end());
+    return true;
+}
+
+bool NavMeshQuery::FindHierarchicalCorridor(const NavMesh& navMesh, uint32_t startTriangle, uint32_t goalTriangle, std::vector<uint32_t>& corridor)
+{
+    ZoneScoped;
+
+    const NavMeshHierarchy& hierarchy = navMesh.GetHierarchy();
+    const uint32_t triangleCount = navMesh.GetTriangleCount();
+
+    if (hierarchy.IsEmpty() || startTriangle >= triangleCount || goalTriangle >= triangleCount)
+        return FindCorridor(navMesh, startTriangle, goalTriangle, corridor);
+
+    corridor.clear();
+    _navMesh = &navMesh;
+    _goalTriangle = goalTriangle;
+    _lastCost = 0.0f;
+    _lastExpandedCount = 0;
+    _status = SearchStatus::eFAILED;
+
+    const uint32_t startCluster = hierarchy.GetTriangleCluster(startTriangle);
+    float maxCost = std::numeric_limits<float>::max();
+    bool found = false;
+
+    corridor.push_back(startTriangle);
+
+    // Within a single cluster the path usually doesn't need the abstract graph, it is only searched
+    // for a shorter path that leaves the cluster, or when the goal can't be reached without leaving it
+    if (startCluster == hierarchy.GetTriangleCluster(goalTriangle) && SearchCluster(navMesh, startCluster, startTriangle, goalTriangle))
+    {
+        maxCost = GetSearchedCost(goalTriangle);
+        AppendSearchedCorridor(startTriangle, goalTriangle, corridor);
+        found = true;
+    }
+
+    if (FindAbstractPath(navMesh, startTriangle, goalTriangle, maxCost))
+    {
+        corridor.resize(1);
+        found = true;
+
+        // Refine every step of the abstract path, portals connect adjacent triangles and the other
+        // steps stay inside a cluster, where the abstract graph only connects nodes that can reach each other
+        for (size_t i = 1; i < _abstractPath.size(); i++)
+        {
+            const uint32_t from = _abstractPath[i - 1];
+            const uint32_t to = _abstractPath[i];
+
+            if (from == to)
+                continue;
+
+            const uint32_t cluster = hierarchy.GetTriangleCluster(from);
+
+            if (cluster != hierarchy.GetTriangleCluster(to))
+            {
+                corridor.push_back(to);
+                continue;
+            }
+
+            SearchCluster(navMesh, cluster, from, to);
+            AppendSearchedCorridor(from, to, corridor);
+        }
+    }
+
+    if (!found)
+    {
+        corridor.clear();
+        return false;
+    }
+
+    for (size_t i = 1; i < corridor.size(); i++)
+        _lastCost += glm::distance(navMesh.GetTriangle(corridor[i - 1]).centre, navMesh.GetTriangle(corridor[i]).centre);
+
+    _status = SearchStatus::eSUCCEEDED;
+    return true;
+}
+
+bool NavMeshQuery::FindPath(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end, bool smooth, std::vector<glm::vec3>& points)
+{
+    ZoneScoped;
+
+    points.clear();
+
+    const uint32_t startTriangle = navMesh.FindClosestTriangle(start);
+    const uint32_t goalTriangle = navMesh.FindClosestTriangle(end);
+
+    const bool found = _hierarchical
+        ? FindHierarchicalCorridor(navMesh, startTriangle, goalTriangle, _corridor)
+        : FindCorridor(navMesh, startTriangle, goalTriangle, _corridor);
+
+    if (!found)
+        return false;
+
+    BuildPath(navMesh, _corridor, start, end, smooth, points);
+    return true;
+}
+
+void NavMeshQuery::BuildPath(const NavMesh& navMesh, const std::vector<uint32_t>& corridor, const glm::vec3& start, const glm::vec3& end, bool smooth, std::vector<glm::vec3>& points)
+{
+    if (smooth)
+        FindStraightPath(navMesh, corridor, start, end, points);
+    else
+        FindEdgeCentrePath(navMesh, corridor, points);
+}
+
+void NavMeshQuery::FindEdgeCentrePath(const NavMesh& navMesh, const std::vector<uint32_t>& corridor, std::vector<glm::vec3>& points)
+{
+    points.clear();
+
+    if (corridor.empty())
+        return;
+
+    points.push_back(navMesh.GetTriangle(corridor.front()).centre);
+
+    // Walk through the middle of the edges shared by consecutive triangles
+    for (size_t i = 1; i < corridor.size(); i++)
+    {
+        uint32_t first, second;
+        if (!navMesh.GetSharedEdge(corridor[i - 1], corridor[i], first, second))
+            continue;
+
+        points.push_back((navMesh.GetVertices()[first] + navMesh.GetVertices()[second]) * 0.5f);
+    }
+
+    points.push_back(navMesh.GetTriangle(corridor.back()).centre);
+}
+
+void NavMeshQuery::FindStraightPath(const NavMesh& navMesh, const std::vector<uint32_t>& corridor, const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& points)
+{
+    ZoneScoped;
+
+    points.clear();
+
+    if (corridor.empty())
+        return;
+
+    const glm::vec3 startPoint = navMesh.ClosestPointOnTriangle(corridor.front(), start);
+    const glm::vec3 endPoint = navMesh.ClosestPointOnTriangle(corridor.back(), end);
+    const std::vector<glm::vec3>& vertices = navMesh.GetVertices();
+
+    // The funnel works on the XZ plane, positive when c lies to the left of the line from a to b
+    auto cross = [](const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+    {
+        return (b.x - a.x) * (c.z - a.z) - (b.z - a.z) * (c.x - a.x);
+    };
+
+    auto equal = [](const glm::vec3& a, const glm::vec3& b)
+    {
+        const glm::vec3 offset = b - a;
+        return glm::dot(offset, offset) < 0.000001f;
+    };
+
+    // Every edge crossed by the corridor becomes a portal, with its vertices sorted left and right as seen when walking through it
+    _portals.clear();
+    _portals.push_back({ startPoint, startPoint });
+
+    for (size_t i = 1; i < corridor.size(); i++)
+    {
+        uint32_t first, second;
+        if (!navMesh.GetSharedEdge(corridor[i - 1], corridor[i], first, second))
+            continue;
+
+        const glm::vec3 from = navMesh.GetTriangle(corridor[i - 1]).centre;
+        const glm::vec3 edgeCentre = (vertices[first] + vertices[second]) * 0.5f;
+
+        if (cross(from, edgeCentre, vertices[first]) > 0.0f)
+            _portals.push_back({ vertices[first], vertices[second] });
+        else
+            _portals.push_back({ vertices[second], vertices[first] });
+    }
+
+    _portals.push_back({ endPoint, endPoint });
+
+    // Reference: https://digestingduck.blogspot.com/2010/03/simple-stupid-funnel-algorithm.html
+    glm::vec3 apex = startPoint;
+    glm::vec3 left = _portals[0].left;
+    glm::vec3 right = _portals[0].right;
+    size_t apexIndex = 0, leftIndex = 0, rightIndex = 0;
+
+    points.push_back(startPoint);
+
+    for (size_t i = 1; i < _portals.size(); i++)
+    {
+        const glm::vec3& portalLeft = _portals[i].left;
+        const glm::vec3& portalRight = _portals[i].right;
+
+        // Narrow the funnel from the right
+        if (cross(apex, right, portalRight) >= 0.0f)
+        {
+            if (equal(apex, right) || cross(apex, left, portalRight) < 0.0f)
+            {
+                right = portalRight;
+                rightIndex = i;
+            }
+            else
+            {
+                // The right side crossed over the left one, so the path bends around the left vertex
+                apex = left;
+                apexIndex = leftIndex;
+
+                if (!equal(points.back(), apex))
+                    points.push_back(apex);
+
+                left = right = apex;
+                leftIndex = rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+
+        // Narrow the funnel from the left
+        if (cross(apex, left, portalLeft) <= 0.0f)
+        {
+            if (equal(apex, left) || cross(apex, right, portalLeft) > 0.0f)
+            {
+                left = portalLeft;
+                leftIndex = i;
+            }
+            else
+            {
+                apex = right;
+                apexIndex = rightIndex;
+
+                if (!equal(points.back(), apex))
+                    points.push_back(apex);
+
+                left = right = apex;
+                leftIndex = rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+
+    if (!equal(points.back(), endPoint) || points.size() == 1)
+        points.push_back(endPoint);
+}
+
+void NavMeshQuery::ResetNodes(std::vector<Node>& nodes, IndexedBinaryHeap& openList, uint32_t& generation, uint32_t count)
+{
+    if (nodes.size() != count)
+    {
+        nodes.assign(count, Node {});
+        generation = 0;
+    }
+
+    openList.Reserve(count);
+    openList.Clear();
+
+    // Generation 0 marks nodes that were never touched, so on wrap around every node has to be reset once
+    if (++generation == 0)
+    {
+        std::fill(nodes.begin(), nodes.end(), Node {});
+        generation = 1;
+    }
+}
+
+bool NavMeshQuery::SearchCluster(const NavMesh& navMesh, uint32_t cluster, uint32_t startTriangle, uint32_t goalTriangle)
+{
+    const NavMeshHierarchy& hierarchy = navMesh.GetHierarchy();
+    const std::vector<NavMesh::Triangle>& triangles = navMesh.GetTriangles();
+
+    const bool hasGoal = goalTriangle != NavMesh::INVALID_TRIANGLE;
+    const glm::vec3 goalCentre = hasGoal ? triangles[goalTriangle].centre : glm::vec3 { 0.0f };
+
+    auto heuristic = [&](uint32_t triangle)
+    {
+        return hasGoal ? glm::distance(triangles[triangle].centre, goalCentre) : 0.0f;
+    };
+
+    ResetNodes(_nodes, _openList, _generation, navMesh.GetTriangleCount());
+
+    _nodes[startTriangle] = Node { 0.0f, NavMesh::INVALID_TRIANGLE, _generation, false };
+    _openList.Push(startTriangle, heuristic(startTriangle));
+
+    while (!_openList.Empty())
+    {
+        const uint32_t current = _openList.Pop();
+        Node& currentNode = _nodes[current];
+        currentNode.closed = true;
+        _lastExpandedCount++;
+
+        if (current == goalTriangle)
+            return true;
+
+        const NavMesh::Triangle& triangle = triangles[current];
+
+        for (uint32_t i = 0; i < triangle.adjacentTriangleCount; i++)
+        {
+            const uint32_t neighbour = triangle.adjacentTriangleIndices[i];
+            if (hierarchy.GetTriangleCluster(neighbour) != cluster)
+                continue;
+
+            Node& neighbourNode = _nodes[neighbour];
+            const float cost = currentNode.cost + glm::distance(triangle.centre, triangles[neighbour].centre);
+
+            if (neighbourNode.generation != _generation)
+            {
+                neighbourNode = Node { cost, current, _generation, false };
+                _openList.Push(neighbour, cost + heuristic(neighbour));
+                continue;
+            }
+
+            if (neighbourNode.closed || cost >= neighbourNode.cost)
+                continue;
+
+            neighbourNode.cost = cost;
+            neighbourNode.parent = current;
+            _openList.DecreaseKey(neighbour, cost + heuristic(neighbour));
+        }
+    }
+
+    return !hasGoal;
+}
+
+float NavMeshQuery::GetSearchedCost(uint32_t triangle) const
+{
+    const Node& node = _nodes[triangle];
+    return node.generation == _generation && node.closed ? node.cost : std::numeric_limits<float>::max();
+}
+
+void NavMeshQuery::AppendSearchedCorridor(uint32_t startTriangle, uint32_t goalTriangle, std::vector<uint32_t>& corridor) const
+{
+    const size_t first = corridor.size();
+
+    for (uint32_t triangle = goalTriangle; triangle != startTriangle; triangle = _nodes[triangle].parent)
+        corridor.push_back(triangle);
+
+    std::reverse(corridor.begin() + static_cast<std::ptrdiff_t>(first), corridor.end());
+}
+
+bool NavMeshQuery::FindAbstractPath(const NavMesh& navMesh, uint32_t startTriangle, uint32_t goalTriangle, float maxCost)
+{
+    constexpr float UNREACHABLE = std::numeric_limits<float>::max();
+
+    const NavMeshHierarchy& hierarchy = navMesh.GetHierarchy();
+    const std::vector<NavMesh::Triangle>& triangles = navMesh.GetTriangles();
+
+    const uint32_t startCluster = hierarchy.GetTriangleCluster(startTriangle);
+    const uint32_t goalCluster = hierarchy.GetTriangleCluster(goalTriangle);
+
+    // Connect the start and goal to the nodes of their clusters, with the cost of walking there without leaving the cluster
+    auto findClusterCosts = [&](uint32_t cluster, uint32_t triangle, std::vector<float>& costs)
+    {
+        SearchCluster(navMesh, cluster, triangle, NavMesh::INVALID_TRIANGLE);
+
+        const NavMeshHierarchy::Cluster& info = hierarchy.GetCluster(cluster);
+        costs.resize(info.nodeCount);
+
+        for (uint32_t i = 0; i < info.nodeCount; i++)
+            costs[i] = GetSearchedCost(hierarchy.GetNode(info.firstNode + i).triangle);
+    };
+
+    findClusterCosts(startCluster, startTriangle, _startCosts);
+    findClusterCosts(goalCluster, goalTriangle, _goalCosts);
+
+    const uint32_t nodeCount = hierarchy.GetNodeCount();
+    const uint32_t startNode = nodeCount;
+    const uint32_t goalNode = nodeCount + 1;
+
+    ResetNodes(_abstractNodes, _abstractOpenList, _abstractGeneration, nodeCount + 2);
+
+    const glm::vec3 goalCentre = triangles[goalTriangle].centre;
+
+    auto triangleOf = [&](uint32_t node)
+    {
+        if (node == startNode)
+            return startTriangle;
+        if (node == goalNode)
+            return goalTriangle;
+
+        return hierarchy.GetNode(node).triangle;
+    };
+
+    auto heuristic = [&](uint32_t node)
+    {
+        return glm::distance(triangles[triangleOf(node)].centre, goalCentre);
+    };
+
+    auto relax = [&](uint32_t from, uint32_t to, float edgeCost)
+    {
+        const float cost = _abstractNodes[from].cost + edgeCost;
+        Node& node = _abstractNodes[to];
+
+        if (node.generation != _abstractGeneration)
+        {
+            node = Node { cost, from, _abstractGeneration, false };
+            _abstractOpenList.Push(to, cost + heuristic(to));
+            return;
+        }
+
+        if (node.closed || cost >= node.cost)
+            return;
+
+        node.cost = cost;
+        node.parent = from;
+        _abstractOpenList.DecreaseKey(to, cost + heuristic(to));
+    };
+
+    const uint32_t startFirstNode = hierarchy.GetCluster(startCluster).firstNode;
+    const uint32_t goalFirstNode = hierarchy.GetCluster(goalCluster).firstNode;
+
+    _abstractNodes[startNode] = Node { 0.0f, NavMesh::INVALID_TRIANGLE, _abstractGeneration, false };
+    _abstractOpenList.Push(startNode, heuristic(startNode));
+
+    bool found = false;
+
+    while (!_abstractOpenList.Empty())
+    {
+        // Every path that is left costs at least as much as the key, since the heuristic never overestimates
+        if (_abstractOpenList.GetKey(_abstractOpenList.Top()) >= maxCost)
+            break;
+
+        const uint32_t current = _abstractOpenList.Pop();
+        _abstractNodes[current].closed = true;
+        _lastExpandedCount++;
+
+        if (current == goalNode)
+        {
+            found = true;
+            break;
+        }
+
+        if (current == startNode)
+        {
+            for (uint32_t i = 0; i < _startCosts.size(); i++)
+            {
+                if (_startCosts[i] != UNREACHABLE)
+                    relax(startNode, startFirstNode + i, _startCosts[i]);
+            }
+
+            continue;
+        }
+
+        for (const NavMeshHierarchy::Edge& edge : hierarchy.GetNodeEdges(current))
+            relax(current, edge.node, edge.cost);
+
+        if (hierarchy.GetNode(current).cluster == goalCluster && _goalCosts[current - goalFirstNode] != UNREACHABLE)
+            relax(current, goalNode, _goalCosts[current - goalFirstNode]);
+    }
+
+    _abstractPath.clear();
+
+    if (!found)
+        return false;
+
+    for (uint32_t node = goalNode; node != NavMesh::INVALID_TRIANGLE; node = _abstractNodes[node].parent)
+        _abstractPath.push_back(triangleOf(node));
+
+    std::reverse(_abstractPath.begin(), _abstractPath.end());
+    return true;
+}
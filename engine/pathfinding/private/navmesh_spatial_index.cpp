@@ -0,0 +1,236 @@
+#include "navmesh_spatial_index.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <tracy/Tracy.hpp>
+
+void NavMeshSpatialIndex::Build(std::span<const glm::vec3> vertices, std::span<const uint32_t> indices)
+{
+    ZoneScoped;
+
+    Clear();
+
+    _triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    if (_triangleCount == 0)
+        return;
+
+    _corners.resize(_triangleCount * 3);
+
+    glm::vec2 min { std::numeric_limits<float>::max() };
+    glm::vec2 max { std::numeric_limits<float>::lowest() };
+    float totalExtent = 0.0f;
+
+    for (uint32_t i = 0; i < _triangleCount; ++i)
+    {
+        glm::vec2 triangleMin { std::numeric_limits<float>::max() };
+        glm::vec2 triangleMax { std::numeric_limits<float>::lowest() };
+
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            const glm::vec3& corner = vertices[indices[i * 3 + j]];
+            _corners[i * 3 + j] = corner;
+
+            triangleMin = glm::min(triangleMin, glm::vec2 { corner.x, corner.z });
+            triangleMax = glm::max(triangleMax, glm::vec2 { corner.x, corner.z });
+        }
+
+        const glm::vec2 extent = triangleMax - triangleMin;
+        totalExtent += glm::max(extent.x, extent.y);
+
+        min = glm::min(min, triangleMin);
+        max = glm::max(max, triangleMax);
+    }
+
+    // Cells about the size of an average triangle keep the amount of triangles per cell low,
+    // without a single triangle having to be stored in many cells
+    const glm::vec2 size = max - min;
+    _cellSize = glm::max(totalExtent / static_cast<float>(_triangleCount), 0.0001f);
+    _cellSize = glm::max(_cellSize, glm::max(size.x, size.y) / static_cast<float>(MAX_CELLS_PER_AXIS));
+
+    _min = min;
+    _cellCount = glm::uvec2 { glm::clamp(glm::ceil(size / _cellSize), glm::vec2 { 1.0f }, glm::vec2 { static_cast<float>(MAX_CELLS_PER_AXIS) }) };
+
+    // Two passes, first counting the triangles per cell, then filling them in
+    _cellStart.assign(_cellCount.x * _cellCount.y + 1, 0);
+
+    auto forEachCell = [&](uint32_t triangle, auto&& function)
+    {
+        const glm::vec3* corners = &_corners[triangle * 3];
+        const glm::vec3 triangleMin = glm::min(glm::min(corners[0], corners[1]), corners[2]);
+        const glm::vec3 triangleMax = glm::max(glm::max(corners[0], corners[1]), corners[2]);
+
+        const glm::ivec2 from = GetCell(triangleMin);
+        const glm::ivec2 to = GetCell(triangleMax);
+
+        for (int32_t z = from.y; z <= to.y; ++z)
+            for (int32_t x = from.x; x <= to.x; ++x)
+                function(static_cast<uint32_t>(z) * _cellCount.x + static_cast<uint32_t>(x));
+    };
+
+    for (uint32_t i = 0; i < _triangleCount; ++i)
+        forEachCell(i, [&](uint32_t cell)
+            { _cellStart[cell + 1]++; });
+
+    for (size_t i = 1; i < _cellStart.size(); ++i)
+        _cellStart[i] += _cellStart[i - 1];
+
+    _cellTriangles.resize(_cellStart.back());
+    std::vector<uint32_t> cursor(_cellStart.begin(), _cellStart.end() - 1);
+
+    for (uint32_t i = 0; i < _triangleCount; ++i)
+        forEachCell(i, [&](uint32_t cell)
+            { _cellTriangles[cursor[cell]++] = i; });
+}
+
+void NavMeshSpatialIndex::Clear()
+{
+    _triangleCount = 0;
+    _min = glm::vec2 { 0.0f };
+    _cellCount = glm::uvec2 { 0 };
+    _cellSize = 1.0f;
+    _corners.clear();
+    _cellStart.clear();
+    _cellTriangles.clear();
+}
+
+uint32_t NavMeshSpatialIndex::FindClosestTriangle(const glm::vec3& point) const
+{
+    if (_triangleCount == 0)
+        return INVALID_TRIANGLE;
+
+    const glm::ivec2 centre = GetCell(point);
+    const glm::ivec2 lastCell = glm::ivec2 { _cellCount } - 1;
+
+    uint32_t closestTriangle = INVALID_TRIANGLE;
+    float closestDistanceSquared = std::numeric_limits<float>::max();
+
+    auto visitCell = [&](int32_t x, int32_t z)
+    {
+        const uint32_t cell = static_cast<uint32_t>(z) * _cellCount.x + static_cast<uint32_t>(x);
+
+        for (uint32_t i = _cellStart[cell]; i < _cellStart[cell + 1]; ++i)
+        {
+            const uint32_t triangle = _cellTriangles[i];
+            const glm::vec3* corners = &_corners[triangle * 3];
+            const float distanceSquared = DistanceSquaredToTriangle(point, corners[0], corners[1], corners[2]);
+
+            // Triangles can be stored in multiple cells, preferring the lowest index keeps results stable
+            if (distanceSquared < closestDistanceSquared || (distanceSquared == closestDistanceSquared && triangle < closestTriangle))
+            {
+                closestDistanceSquared = distanceSquared;
+                closestTriangle = triangle;
+            }
+        }
+    };
+
+    // Search in growing square rings around the cell of the point, until nothing outside
+    // the searched area can be closer than the best triangle found so far
+    const int32_t maxRing = glm::max(glm::max(centre.x, lastCell.x - centre.x), glm::max(centre.y, lastCell.y - centre.y));
+
+    for (int32_t ring = 0; ring <= maxRing; ++ring)
+    {
+        const glm::ivec2 from = centre - ring;
+        const glm::ivec2 to = centre + ring;
+
+        for (int32_t x = glm::max(from.x, 0); x <= glm::min(to.x, lastCell.x); ++x)
+        {
+            if (from.y >= 0)
+                visitCell(x, from.y);
+            if (to.y <= lastCell.y && ring > 0)
+                visitCell(x, to.y);
+        }
+
+        for (int32_t z = glm::max(from.y + 1, 0); z <= glm::min(to.y - 1, lastCell.y); ++z)
+        {
+            if (from.x >= 0)
+                visitCell(from.x, z);
+            if (to.x <= lastCell.x && ring > 0)
+                visitCell(to.x, z);
+        }
+
+        if (closestTriangle == INVALID_TRIANGLE)
+            continue;
+
+        // Horizontal distance from the point to the closest edge of the searched area that still has cells beyond it,
+        // the height difference can only make unsearched triangles further away
+        float bound = std::numeric_limits<float>::max();
+        const glm::vec2 searchedMin = _min + glm::vec2 { from } * _cellSize;
+        const glm::vec2 searchedMax = _min + glm::vec2 { to + 1 } * _cellSize;
+
+        if (from.x > 0)
+            bound = glm::min(bound, point.x - searchedMin.x);
+        if (to.x < lastCell.x)
+            bound = glm::min(bound, searchedMax.x - point.x);
+        if (from.y > 0)
+            bound = glm::min(bound, point.z - searchedMin.y);
+        if (to.y < lastCell.y)
+            bound = glm::min(bound, searchedMax.y - point.z);
+
+        if (closestDistanceSquared <= bound * bound)
+            break;
+    }
+
+    return closestTriangle;
+}
+
+glm::vec3 NavMeshSpatialIndex::ClosestPointOnTriangle(const glm::vec3& point, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+    // Reference: Real-Time Collision Detection, Christer Ericson, 5.1.5
+    const glm::vec3 ab = b - a;
+    const glm::vec3 ac = c - a;
+    const glm::vec3 ap = point - a;
+
+    const float d1 = glm::dot(ab, ap);
+    const float d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+        return a;
+
+    const glm::vec3 bp = point - b;
+    const float d3 = glm::dot(ab, bp);
+    const float d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3)
+        return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return a + ab * (d1 / (d1 - d3));
+
+    const glm::vec3 cp = point - c;
+    const float d5 = glm::dot(ab, cp);
+    const float d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6)
+        return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return a + ac * (d2 / (d2 - d6));
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    const float denominator = va + vb + vc;
+
+    // Degenerate triangles have no inside, the edge cases above already covered them
+    if (denominator == 0.0f)
+        return a;
+
+    const float v = vb / denominator;
+    const float w = vc / denominator;
+    return a + ab * v + ac * w;
+}
+
+float NavMeshSpatialIndex::DistanceSquaredToTriangle(const glm::vec3& point, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+    const glm::vec3 offset = point - ClosestPointOnTriangle(point, a, b, c);
+    return glm::dot(offset, offset);
+}
+
+glm::ivec2 NavMeshSpatialIndex::GetCell(const glm::vec3& point) const
+{
+    const glm::vec2 local = (glm::vec2 { point.x, point.z } - _min) / _cellSize;
+    const glm::ivec2 cell { glm::floor(local) };
+
+    return glm::clamp(cell, glm::ivec2 { 0 }, glm::ivec2 { _cellCount } - 1);
+}
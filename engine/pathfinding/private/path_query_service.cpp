@@ -0,0 +1,343 @@
+#include "path_query_service.hpp"
+
+#include "navmesh.hpp"
+#include "navmesh_path_cache.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <glm/common.hpp>
+
+#include <tracy/Tracy.hpp>
+
+PathQueryService::PathQueryService(PathQueryBudget budget)
+{
+    SetBudget(budget);
+}
+
+PathQueryService::~PathQueryService()
+{
+    WaitForSearches();
+}
+
+PathRequestHandle PathQueryService::Submit(const glm::vec3& start, const glm::vec3& end, bool smooth, Callback callback)
+{
+    const uint32_t id = _nextID++;
+
+    // 0 marks an invalid handle
+    if (_nextID == 0)
+        _nextID = 1;
+
+    Request& request = _requests[id];
+    request.start = start;
+    request.end = end;
+    request.smooth = smooth;
+    request.callback = std::move(callback);
+
+    _pending.emplace_back(id);
+    return PathRequestHandle { id };
+}
+
+void PathQueryService::Cancel(PathRequestHandle handle)
+{
+    // Pending entries and running searches of the request are skipped once they are seen without a request
+    _requests.erase(handle.id);
+}
+
+void PathQueryService::CancelAll()
+{
+    WaitForSearches();
+
+    _requests.clear();
+    _pending.clear();
+
+    for (auto& search : _searches)
+        search->requestID = 0;
+}
+
+PathRequestStatus PathQueryService::GetStatus(PathRequestHandle handle) const
+{
+    auto it = _requests.find(handle.id);
+    return it == _requests.end() ? PathRequestStatus::eINVALID : it->second.status;
+}
+
+std::optional<std::vector<glm::vec3>> PathQueryService::TakeResult(PathRequestHandle handle)
+{
+    auto it = _requests.find(handle.id);
+    if (it == _requests.end() || it->second.status == PathRequestStatus::ePENDING)
+        return std::nullopt;
+
+    std::vector<glm::vec3> points = std::move(it->second.points);
+    _requests.erase(it);
+
+    return points;
+}
+
+void PathQueryService::Update(const NavMesh& navMesh, ThreadPool* threadPool)
+{
+    ZoneScoped;
+
+    _updateCount++;
+
+    CollectSearches();
+    ExpireResults();
+    StartSearches(navMesh);
+
+    for (auto& search : _searches)
+    {
+        if (search->requestID == 0)
+            continue;
+
+        if (threadPool != nullptr)
+            _jobs.emplace_back(threadPool->QueueWork([&job = *search]()
+                { RunSearch(job); }));
+        else
+            RunSearch(*search);
+    }
+}
+
+void PathQueryService::WaitForSearches()
+{
+    for (auto& job : _jobs)
+        job.wait();
+
+    _jobs.clear();
+}
+
+void PathQueryService::SetBudget(const PathQueryBudget& budget)
+{
+    _budget = budget;
+    _budget.maxExpansionsPerUpdate = std::max(_budget.maxExpansionsPerUpdate, 1u);
+    _budget.maxConcurrentSearches = std::max(_budget.maxConcurrentSearches, 1u);
+}
+
+uint32_t PathQueryService::GetRunningCount() const
+{
+    return static_cast<uint32_t>(std::count_if(_searches.begin(), _searches.end(), [](const auto& search)
+        { return search->requestID != 0; }));
+}
+
+void PathQueryService::RunSearch(Search& search)
+{
+    ZoneScopedN("Path Search");
+
+    if (search.hierarchical)
+    {
+        if (search.query.FindHierarchicalCorridor(*search.navMesh, search.startTriangle, search.goalTriangle, search.corridor))
+            search.query.BuildPath(*search.navMesh, search.corridor, search.start, search.end, search.smooth, search.points);
+
+        search.expansions = search.query.GetLastExpandedCount();
+        return;
+    }
+
+    const uint32_t expandedBefore = search.query.GetLastExpandedCount();
+    const NavMeshQuery::SearchStatus status = search.query.UpdateSearch(search.budget);
+    search.expansions = search.query.GetLastExpandedCount() - expandedBefore;
+
+    if (status == NavMeshQuery::SearchStatus::eSUCCEEDED)
+    {
+        search.query.FinishSearch(search.corridor);
+        search.query.BuildPath(*search.navMesh, search.corridor, search.start, search.end, search.smooth, search.points);
+    }
+}
+
+PathQueryService::Search* PathQueryService::FindIdleSearch()
+{
+    uint32_t running = 0;
+    Search* idle = nullptr;
+
+    for (auto& search : _searches)
+    {
+        if (search->requestID != 0)
+            running++;
+        else if (idle == nullptr)
+            idle = search.get();
+    }
+
+    if (running >= _budget.maxConcurrentSearches)
+        return nullptr;
+
+    if (idle == nullptr)
+        idle = _searches.emplace_back(std::make_unique<Search>()).get();
+
+    return idle;
+}
+
+void PathQueryService::CollectSearches()
+{
+    WaitForSearches();
+
+    _expansionsLastUpdate = 0;
+
+    for (auto& search : _searches)
+    {
+        _expansionsLastUpdate += search->expansions;
+
+        if (search->hierarchical && search->expansions > 0)
+        {
+            const float expansions = static_cast<float>(search->expansions);
+            _hierarchicalExpansionEstimate = _hierarchicalExpansionEstimate == 0.0f ? expansions : glm::mix(_hierarchicalExpansionEstimate, expansions, 0.25f);
+        }
+
+        search->expansions = 0;
+
+        if (search->requestID == 0)
+            continue;
+
+        const uint32_t requestID = search->requestID;
+
+        // Cancelled while it was running
+        if (!_requests.contains(requestID))
+        {
+            search->requestID = 0;
+            continue;
+        }
+
+        const NavMeshQuery::SearchStatus status = search->query.GetStatus();
+        if (status == NavMeshQuery::SearchStatus::eIN_PROGRESS)
+            continue;
+
+        search->requestID = 0;
+        const bool succeeded = status == NavMeshQuery::SearchStatus::eSUCCEEDED;
+
+        if (_pathCache != nullptr)
+        {
+            static const std::vector<uint32_t> unreachable {};
+            _pathCache->Store(search->startTriangle, search->goalTriangle, succeeded ? search->corridor : unreachable,
+                search->start, search->end, search->smooth, search->points);
+        }
+
+        if (succeeded)
+            Finish(requestID, PathRequestStatus::eSUCCEEDED, std::move(search->points));
+        else
+            Finish(requestID, PathRequestStatus::eFAILED, {});
+    }
+
+    // Hierarchical searches can't stop halfway, what they spent over the budget is paid back by the next updates
+    const uint32_t spent = _overspentExpansions + _expansionsLastUpdate;
+    _overspentExpansions = spent - std::min(spent, _budget.maxExpansionsPerUpdate);
+}
+
+void PathQueryService::StartSearches(const NavMesh& navMesh)
+{
+    const uint32_t remainingExpansions = _budget.maxExpansionsPerUpdate - std::min(_budget.maxExpansionsPerUpdate, _overspentExpansions);
+    const uint32_t hierarchicalEstimate = std::max(static_cast<uint32_t>(_hierarchicalExpansionEstimate), 1u);
+    uint32_t plannedExpansions = 0;
+
+    while (!_pending.empty())
+    {
+        const uint32_t requestID = _pending.front();
+
+        auto it = _requests.find(requestID);
+        if (it == _requests.end())
+        {
+            _pending.pop_front();
+            continue;
+        }
+
+        const Request& request = it->second;
+
+        // Finding the triangles is cheap enough to do right away, the search itself runs on the thread pool
+        const uint32_t startTriangle = navMesh.FindClosestTriangle(request.start);
+        const uint32_t goalTriangle = navMesh.FindClosestTriangle(request.end);
+
+        const uint32_t triangleCount = navMesh.GetTriangleCount();
+        if (startTriangle >= triangleCount || goalTriangle >= triangleCount)
+        {
+            _pending.pop_front();
+            Finish(requestID, PathRequestStatus::eFAILED, {});
+            continue;
+        }
+
+        // Cached requests don't need a search, so they are not held up by the searches that are still running.
+        // Requests that have to wait for a search are only looked up once there is one, to count a single miss for them.
+        Search* search = FindIdleSearch();
+
+        // Hierarchical searches run to completion, so they only start while their estimated cost fits in what is left of the budget
+        if (search != nullptr && _hierarchical && plannedExpansions >= remainingExpansions)
+            search = nullptr;
+
+        if (search == nullptr && (_pathCache == nullptr || !_pathCache->Contains(startTriangle, goalTriangle)))
+            break;
+
+        if (_pathCache != nullptr && FinishFromCache(navMesh, requestID, request, startTriangle, goalTriangle))
+            continue;
+
+        _pending.pop_front();
+
+        if (!_hierarchical && search->query.BeginSearch(navMesh, startTriangle, goalTriangle) == NavMeshQuery::SearchStatus::eFAILED)
+        {
+            Finish(requestID, PathRequestStatus::eFAILED, {});
+            continue;
+        }
+
+        if (_hierarchical)
+            plannedExpansions += hierarchicalEstimate;
+
+        search->navMesh = &navMesh;
+        search->hierarchical = _hierarchical;
+        search->startTriangle = startTriangle;
+        search->goalTriangle = goalTriangle;
+        search->requestID = requestID;
+        search->start = request.start;
+        search->end = request.end;
+        search->smooth = request.smooth;
+    }
+
+    // The budget is shared evenly between the searches that run this update
+    const uint32_t running = GetRunningCount();
+    const uint32_t budget = running == 0 ? 0 : std::max(_budget.maxExpansionsPerUpdate / running, 1u);
+
+    for (auto& search : _searches)
+        search->budget = budget;
+}
+
+bool PathQueryService::FinishFromCache(const NavMesh& navMesh, uint32_t requestID, const Request& request, uint32_t startTriangle, uint32_t goalTriangle)
+{
+    const NavMeshPathCache::LookupResult result = _pathCache->FindPath(navMesh, _cacheQuery, startTriangle, goalTriangle,
+        request.start, request.end, request.smooth, _cachedPoints);
+
+    if (result == NavMeshPathCache::LookupResult::eMISS)
+        return false;
+
+    // Popped before finishing, the callback might submit new requests
+    _pending.pop_front();
+
+    if (result == NavMeshPathCache::LookupResult::eFOUND)
+        Finish(requestID, PathRequestStatus::eSUCCEEDED, std::vector<glm::vec3> { _cachedPoints });
+    else
+        Finish(requestID, PathRequestStatus::eFAILED, {});
+
+    return true;
+}
+
+void PathQueryService::Finish(uint32_t requestID, PathRequestStatus status, std::vector<glm::vec3>&& points)
+{
+    auto it = _requests.find(requestID);
+    if (it == _requests.end())
+        return;
+
+    Request& request = it->second;
+
+    if (!request.callback)
+    {
+        request.status = status;
+        request.points = std::move(points);
+        request.finishedAtUpdate = _updateCount;
+        return;
+    }
+
+    // The request is gone before calling back, so the callback can safely submit or cancel requests
+    Callback callback = std::move(request.callback);
+    _requests.erase(it);
+
+    callback(PathRequestHandle { requestID }, status, points);
+}
+
+void PathQueryService::ExpireResults()
+{
+    std::erase_if(_requests, [this](const auto& entry)
+        {
+            const Request& request = entry.second;
+            return request.status != PathRequestStatus::ePENDING && _updateCount - request.finishedAtUpdate > _budget.resultLifetime;
+        });
+}
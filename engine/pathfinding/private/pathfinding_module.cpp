@@ -1,9 +1,12 @@
 #include "pathfinding_module.hpp"
 
+#include "ecs_module.hpp"
 #include "engine.hpp"
 #include "model_loading.hpp"
+#include "navmesh_bake.hpp"
 #include "renderer_module.hpp"
 
+#include "components/nav_agent_component.hpp"
 #include "components/static_mesh_component.hpp"
 #include "graphics_context.hpp"
 #include "passes/debug_pass.hpp"
@@ -14,25 +17,37 @@
 #include "scene/model_loader.hpp"
 
 #include "scripting_module.hpp"
+#include "systems/nav_agent_system.hpp"
+#include "thread_module.hpp"
+#include "time_module.hpp"
 
-#include <set>
-
-#define TRIANGLE_EDGE_CENTERS 1
+#include <queue>
 
 ModuleTickOrder PathfindingModule::Init(MAYBE_UNUSED Engine& engine)
 {
+    _threadPool = &engine.GetModule<ThreadModule>().GetPool();
+
+    engine.GetModule<ECSModule>().AddSystem<NavAgentSystem>(*this);
+    NavAgentComponent::SetupRegistryCallbacks(engine.GetModule<ECSModule>().GetRegistry(), _queryService);
+
     return ModuleTickOrder::eTick;
 }
 
 void PathfindingModule::Tick(MAYBE_UNUSED Engine& engine)
 {
-    // Draws any path that was generated through the scripting language
-    if (_debugDraw)
+    _queryService.Update(_navMesh, _threadPool);
+
+    const DeltaMS deltatime = engine.GetModule<TimeModule>().GetDeltatime();
+    for (auto& [id, entry] : _flowFields)
+        entry.field.Update(_navMesh, entry.target, deltatime);
+
+    // Draws the paths that were generated since the last time
+    if (_debugDraw && !_debugPaths.empty())
     {
         _debugLines.clear();
-        for (const auto& path : _computedPaths)
+        for (const auto& path : _debugPaths)
         {
-            for (size_t i = 0; i < path.waypoints.size() - 1; i++)
+            for (size_t i = 0; i + 1 < path.waypoints.size(); i++)
             {
                 glm::vec3 from = path.waypoints[i].centre;
                 glm::vec3 to = path.waypoints[i + 1].centre;
@@ -44,15 +59,21 @@ void PathfindingModule::Tick(MAYBE_UNUSED Engine& engine)
                 _debugLines.push_back(to);
             }
         }
+
+        _debugPaths.clear();
     }
 }
 
-void PathfindingModule::Shutdown(MAYBE_UNUSED Engine& engine)
+void PathfindingModule::Shutdown(Engine& engine)
 {
+    NavAgentComponent::DisconnectRegistryCallbacks(engine.GetModule<ECSModule>().GetRegistry(), _queryService);
+    _queryService.CancelAll();
 }
 
 PathfindingModule::PathfindingModule()
 {
+    _queryService.SetPathCache(&_pathCache);
+    SetHierarchicalSearch(true);
 }
 
 PathfindingModule::~PathfindingModule()
@@ -61,6 +82,19 @@ PathfindingModule::~PathfindingModule()
 
 int32_t PathfindingModule::SetNavigationMesh(std::string_view filePath)
 {
+    // Load the navmesh baked on a previous run, as long as the glTF didn't change since
+    const std::optional<NavMeshBake::Key> sourceKey = NavMeshBake::MakeSourceKey(filePath);
+    const std::filesystem::path bakedPath = NavMeshBake::GetBakedPath(filePath);
+
+    if (sourceKey.has_value())
+    {
+        if (std::optional<NavMesh> baked = NavMeshBake::Load(bakedPath, sourceKey.value()))
+        {
+            SetNavigationMesh(std::move(baked.value()));
+            return 0;
+        }
+    }
+
     CPUModel navmesh = ModelLoading::LoadGLTF(filePath);
     uint32_t meshIndex = std::numeric_limits<uint32_t>::max();
     glm::mat4 transform = glm::mat4(1.0f);
@@ -96,289 +130,177 @@ int32_t PathfindingModule::SetNavigationMesh(std::string_view filePath)
     if (meshIndex == std::numeric_limits<uint32_t>::max())
         return {};
 
-    CPUMesh navmeshMesh = navmesh.meshes[meshIndex]; // GLTF model should consist of only a single mesh
-    _mesh = navmeshMesh;
-    _inverseTransform = glm::inverse(transform);
+    const CPUMesh<Vertex>& navmeshMesh = navmesh.meshes[meshIndex]; // GLTF model should consist of only a single mesh
 
-    _triangles.clear();
+    std::vector<glm::vec3> vertices;
+    vertices.reserve(navmeshMesh.vertices.size());
 
-    std::unordered_map<uint32_t, std::vector<uint32_t>> indicesToTriangles;
+    for (const Vertex& vertex : navmeshMesh.vertices)
+        vertices.emplace_back(transform * glm::vec4(vertex.position, 1.0f));
 
-    // We store all the triangles with their indices and center points
-    //
-    // We also store the triangles that use an index to find adjacent triangles
-    for (size_t i = 0; i < navmeshMesh.indices.size(); i += 3)
-    {
-        TriangleInfo info {};
-        info.indices[0] = navmeshMesh.indices[i];
-        info.indices[1] = navmeshMesh.indices[i + 1];
-        info.indices[2] = navmeshMesh.indices[i + 2];
+    SetNavigationMesh(std::move(vertices), navmeshMesh.indices);
 
-        glm::vec3 p0 = navmeshMesh.vertices[info.indices[0]].position;
-        glm::vec3 p1 = navmeshMesh.vertices[info.indices[1]].position;
-        glm::vec3 p2 = navmeshMesh.vertices[info.indices[2]].position;
+    if (sourceKey.has_value())
+        NavMeshBake::Save(_navMesh, bakedPath, sourceKey.value());
 
-        info.centre = (p0 + p1 + p2) / 3.0f;
-        info.centre = glm::vec3(transform * glm::vec4(info.centre, 1.0f));
+    return 0;
+}
 
-        size_t triangleIdx = _triangles.size();
-        _triangles.push_back(info);
+void PathfindingModule::SetNavigationMesh(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices)
+{
+    SetNavigationMesh(NavMesh { std::move(vertices), std::move(indices) });
+}
 
-        indicesToTriangles[info.indices[0]].push_back(triangleIdx);
-        indicesToTriangles[info.indices[1]].push_back(triangleIdx);
-        indicesToTriangles[info.indices[2]].push_back(triangleIdx);
-    }
+void PathfindingModule::SetNavigationMesh(NavMesh navMesh)
+{
+    // Running searches point into the old navmesh
+    _queryService.CancelAll();
 
-    // Loop over all triangles in the mesh
-    for (size_t i = 0; i < _triangles.size(); i++)
-    {
-        TriangleInfo& triangle = _triangles[i];
+    _navMesh = std::move(navMesh);
+    _pathCache.Invalidate();
+    _debugPaths.clear();
 
-        // We store all triangles that share indices with the current triangle
-        // If a triangle shares two indices with the current triangle, it's adjacent to the current triangle
-        std::unordered_multiset<uint32_t> sharedTriangles;
+    for (auto& [id, entry] : _flowFields)
+        entry.field.Build(_navMesh, entry.target);
+}
 
-        // For each index in the current triangle
-        for (uint32_t j = 0; j < 3; j++)
-        {
-            // Get all triangles that use this index
-            const std::vector<uint32_t>& indexTriangles = indicesToTriangles[triangle.indices[j]];
+ComputedPath PathfindingModule::FindPath(glm::vec3 startPos, glm::vec3 endPos, bool smooth)
+{
+    const uint32_t startTriangle = _navMesh.FindClosestTriangle(startPos);
+    const uint32_t goalTriangle = _navMesh.FindClosestTriangle(endPos);
 
-            // Loop over every triangle that shares this index
-            for (uint32_t triangleIdx : indexTriangles)
-            {
-                // Don't add current triangle to list, obviously
-                if (triangleIdx == i)
-                    continue;
+    if (startTriangle == NavMesh::INVALID_TRIANGLE || goalTriangle == NavMesh::INVALID_TRIANGLE)
+        return {};
 
-                sharedTriangles.insert(triangleIdx);
-            }
-        }
+    const NavMeshPathCache::LookupResult cached = _pathCache.FindPath(_navMesh, _query, startTriangle, goalTriangle, startPos, endPos, smooth, _points);
 
-        // Loop over all triangles that share indices with the current triangle
-        for (const uint32_t& triangleIdx : sharedTriangles)
-        {
-            if (sharedTriangles.count(triangleIdx) > 1)
-            {
-                // We share more than 2 indices now so we're adjacent to the current triangle
-                bool insert = true;
-
-                // Check if the triangle is already inserted as neighbour (limitation of iterating over std::unordered_multiset)
-                for (uint32_t k = 0; k < triangle.adjacentTriangleCount; k++)
-                {
-                    if (triangle.adjacentTriangleIndices[k] == triangleIdx)
-                    {
-                        insert = false;
-                    }
-                }
-                if (insert)
-                {
-                    triangle.adjacentTriangleIndices[triangle.adjacentTriangleCount++] = triangleIdx;
-                }
-            }
-        }
-    }
+    if (cached == NavMeshPathCache::LookupResult::eUNREACHABLE)
+        return {};
 
-    // Now that we have adjacency information about the triangles we can start constructing a node tree
-    for (size_t i = 0; i < _triangles.size(); i++)
+    if (cached == NavMeshPathCache::LookupResult::eMISS)
     {
-        TriangleInfo& info = _triangles[i];
+        const bool found = _query.IsHierarchical()
+            ? _query.FindHierarchicalCorridor(_navMesh, startTriangle, goalTriangle, _corridor)
+            : _query.FindCorridor(_navMesh, startTriangle, goalTriangle, _corridor);
 
-        for (size_t j = 0; j < info.adjacentTriangleCount; j++)
-        {
-            _trianglesToNeighbours[i][j] = info.adjacentTriangleIndices[j];
-        }
-    }
+        if (found)
+            _query.BuildPath(_navMesh, _corridor, startPos, endPos, smooth, _points);
 
-    return 0;
-}
+        _pathCache.Store(startTriangle, goalTriangle, _corridor, startPos, endPos, smooth, _points);
 
-ComputedPath PathfindingModule::FindPath(glm::vec3 startPos, glm::vec3 endPos)
-{
-    _computedPaths.clear();
-    // Reference: https://app.datacamp.com/learn/tutorials/a-star-algorithm?dc_referrer=https%3A%2F%2Fwww.google.com%2F
-    // Legend:
-    // G = totalCost
-    // H = estimateToGoal
-    // F = totalEstimatedCost
-
-    // Heuristic function
-    IterablePriorityQueue<TriangleNode, std::vector<TriangleNode>, std::greater<TriangleNode>> openList;
-    std::unordered_map<uint32_t, TriangleNode> closedList;
-
-    // startPos = glm::vec3(_inverseTransform * glm::vec4(startPos, 1.0f));
-    // endPos = glm::vec3(_inverseTransform * glm::vec4(endPos, 1.0f));
-
-    // Find closest triangle // TODO: More efficient way of finding closes triangle
-    float closestStartTriangleDistance = std::numeric_limits<float>::infinity(),
-          closestDestinationTriangleDistance = std::numeric_limits<float>::infinity();
-    uint32_t closestStartTriangleIndex = std::numeric_limits<uint32_t>::max(),
-             closestDestinationTriangleIndex = std::numeric_limits<uint32_t>::max();
-    for (size_t i = 0; i < _triangles.size(); i++)
-    {
-        float distance_to_start_triangle = glm::distance(startPos, _triangles[i].centre);
-        float distance_to_finish_triangle = glm::distance(endPos, _triangles[i].centre);
-
-        if (distance_to_start_triangle < closestStartTriangleDistance)
-        {
-            closestStartTriangleDistance = distance_to_start_triangle;
-            closestStartTriangleIndex = i;
-        }
-
-        if (distance_to_finish_triangle < closestDestinationTriangleDistance)
-        {
-            closestDestinationTriangleDistance = distance_to_finish_triangle;
-            closestDestinationTriangleIndex = i;
-        }
+        if (!found)
+            return {};
     }
 
-    glm::vec3 closestDestinationTriangleCentre = _triangles[closestDestinationTriangleIndex].centre;
-
-    TriangleNode node {};
-    node.totalCost = 0;
-    node.estimateToGoal = Heuristic(startPos, endPos);
-    node.totalEstimatedCost = node.totalCost + node.estimateToGoal;
-    node.triangleIndex = closestStartTriangleIndex;
-    node.parentTriangleIndex = std::numeric_limits<uint32_t>::max();
+    ComputedPath path = ToComputedPath(_points);
+    AddDebugPath(path);
 
-    openList.push(node);
+    return path;
+}
 
-    while (!openList.empty())
-    {
-        TriangleNode topNode = openList.top();
-        if (topNode.triangleIndex == closestDestinationTriangleIndex) // If we reached our goal
-        {
-            closedList[topNode.triangleIndex] = topNode;
-            ComputedPath path = ReconstructPath(topNode.triangleIndex, closedList);
-            _computedPaths.push_back(path);
-            return path;
-            break;
-        }
+ComputedPath PathfindingModule::FindPath(glm::vec3 startPos, glm::vec3 endPos, bool smooth, NavMeshQuery& query) const
+{
+    std::vector<glm::vec3> points;
+    query.FindPath(_navMesh, startPos, endPos, smooth, points);
 
-        // Move current from open to closed list
-        closedList[topNode.triangleIndex] = topNode;
-        openList.pop();
+    return ToComputedPath(points);
+}
 
-        const TriangleInfo& triangleInfo = _triangles[topNode.triangleIndex];
+PathRequestHandle PathfindingModule::RequestPath(glm::vec3 startPos, glm::vec3 endPos, bool smooth, PathCallback callback)
+{
+    PathQueryService::Callback onFinished {};
 
-        // For all this triangle's neighbours
-        for (uint32_t i = 0; i < triangleInfo.adjacentTriangleCount; i++)
+    if (callback)
+    {
+        onFinished = [this, callback = std::move(callback)](PathRequestHandle handle, PathRequestStatus status, const std::vector<glm::vec3>& points)
         {
-            // Skip already evaluated nodes
-            if (closedList.contains(triangleInfo.adjacentTriangleIndices[i]))
-                continue;
-
-            const TriangleInfo& neighbourTriangleInfo = _triangles[triangleInfo.adjacentTriangleIndices[i]];
+            ComputedPath path = ToComputedPath(points);
+            AddDebugPath(path);
 
-            float tentativeCostFromStart = topNode.totalCost + glm::distance(triangleInfo.centre, neighbourTriangleInfo.centre);
-
-            TriangleNode tempNode {};
-            tempNode.triangleIndex = triangleInfo.adjacentTriangleIndices[i];
-            auto it = openList.find(tempNode);
-            if (it == openList.end())
-            {
-                openList.push(tempNode);
-                it = openList.find(tempNode);
-                it->totalCost = INFINITY;
-            }
-
-            TriangleNode& neighbourNode = *it;
-
-            if (tentativeCostFromStart < neighbourNode.totalCost)
-            {
-                neighbourNode.totalCost = tentativeCostFromStart;
-                neighbourNode.estimateToGoal = DirectedHeuristic(neighbourTriangleInfo.centre, endPos, closestDestinationTriangleCentre);
-                neighbourNode.parentTriangleIndex = topNode.triangleIndex;
-                neighbourNode.totalEstimatedCost = neighbourNode.totalCost + neighbourNode.estimateToGoal;
-            }
-        }
+            callback(handle, status, path);
+        };
     }
 
-    return {};
+    return _queryService.Submit(startPos, endPos, smooth, std::move(onFinished));
 }
 
-float PathfindingModule::Heuristic(glm::vec3 startPos, glm::vec3 endPos)
+std::optional<ComputedPath> PathfindingModule::TakePath(PathRequestHandle handle)
 {
-    glm::vec3 towardsVector = endPos - startPos;
-    float length = glm::length(towardsVector);
-    return length;
-}
-
-float PathfindingModule::DirectedHeuristic(glm::vec3 startPos, glm::vec3 endPos, glm::vec3 finalPosition)
-{
-    glm::vec3 towardsEnd = endPos - startPos;
-    glm::vec3 towardsFinal = finalPosition - startPos;
-
-    float towardsEndLength = glm::length(towardsEnd);
-
-    towardsEnd = glm::normalize(towardsEnd);
-    towardsFinal = glm::normalize(towardsFinal);
+    auto points = _queryService.TakeResult(handle);
+    if (!points.has_value())
+        return std::nullopt;
 
-    float dot = std::max(glm::dot(towardsEnd, towardsFinal), 0.001f);
+    ComputedPath path = ToComputedPath(*points);
+    AddDebugPath(path);
 
-    return powf((1.0f - dot), 3.0f) * towardsEndLength;
+    return path;
 }
 
-
-ComputedPath PathfindingModule::ReconstructPath(const uint32_t finalTriangleIndex, std::unordered_map<uint32_t, TriangleNode>& nodes)
+void PathfindingModule::SetHierarchicalSearch(bool hierarchical)
 {
-    ComputedPath path = {};
-
-    PathNode pathNode {};
+    // Hierarchical corridors can be a bit longer, don't keep handing those out after switching
+    if (hierarchical != _query.IsHierarchical())
+        _pathCache.Invalidate();
 
-    const TriangleNode& finalTriangleNode = nodes[finalTriangleIndex];
+    _query.SetHierarchical(hierarchical);
+    _queryService.SetHierarchical(hierarchical);
+}
 
-    pathNode.centre = _triangles[finalTriangleIndex].centre;
-    path.waypoints.push_back(pathNode);
+FlowFieldHandle PathfindingModule::CreateFlowField(glm::vec3 target)
+{
+    const uint32_t id = _nextFlowFieldID++;
 
-    uint32_t previousTriangleIndex = finalTriangleIndex;
-    uint32_t parentTriangleIndex = finalTriangleNode.parentTriangleIndex;
+    FlowFieldEntry& entry = _flowFields[id];
+    entry.target = target;
+    entry.field.SetRefreshInterval(_flowFieldRefreshInterval);
+    entry.field.Build(_navMesh, target);
 
-    while (true)
-    {
-        if (parentTriangleIndex == std::numeric_limits<uint32_t>::max())
-        {
-            pathNode.centre = _triangles[previousTriangleIndex].centre;
-            path.waypoints.push_back(pathNode);
-            break;
-        }
+    return FlowFieldHandle { id };
+}
 
-        const TriangleNode& node = nodes[parentTriangleIndex];
-        pathNode.centre = _triangles[parentTriangleIndex].centre;
+void PathfindingModule::SetFlowFieldTarget(FlowFieldHandle handle, glm::vec3 target)
+{
+    auto it = _flowFields.find(handle.id);
+    if (it != _flowFields.end())
+        it->second.target = target;
+}
 
-#ifdef TRIANGLE_EDGE_CENTERS
-        std::unordered_map<uint32_t, uint32_t> triangleIndices;
-        for (int32_t i = 0; i < 3; i++)
-        {
-            triangleIndices[_triangles[previousTriangleIndex].indices[i]]++;
-        }
-        for (int32_t i = 0; i < 3; i++)
-        {
-            triangleIndices[_triangles[parentTriangleIndex].indices[i]]++;
-        }
+glm::vec3 PathfindingModule::SampleFlowField(FlowFieldHandle handle, glm::vec3 position) const
+{
+    const NavMeshFlowField* field = GetFlowField(handle);
+    if (field == nullptr || !field->IsValid())
+        return glm::vec3 { 0.0f };
 
-        uint32_t adjacentEdgeIndices[2] = {};
+    return field->SampleDirection(_navMesh, position);
+}
 
-        uint32_t i = 0;
-        for (const auto& [index, count] : triangleIndices)
-        {
-            if (count == 2)
-            {
-                adjacentEdgeIndices[i++] = index;
-            }
-        }
+const NavMeshFlowField* PathfindingModule::GetFlowField(FlowFieldHandle handle) const
+{
+    auto it = _flowFields.find(handle.id);
+    return it == _flowFields.end() ? nullptr : &it->second.field;
+}
 
-        pathNode.centre = (_mesh.vertices[adjacentEdgeIndices[0]].position + _mesh.vertices[adjacentEdgeIndices[1]].position) * 0.5f;
-        pathNode.centre = glm::vec3(glm::inverse(_inverseTransform) * glm::vec4(pathNode.centre, 1.0f));
-#endif
+void PathfindingModule::SetFlowFieldRefreshInterval(DeltaMS interval)
+{
+    _flowFieldRefreshInterval = interval;
 
-        path.waypoints.push_back(pathNode);
+    for (auto& [id, entry] : _flowFields)
+        entry.field.SetRefreshInterval(interval);
+}
 
-        previousTriangleIndex = parentTriangleIndex;
-        parentTriangleIndex = node.parentTriangleIndex;
-    }
+ComputedPath PathfindingModule::ToComputedPath(const std::vector<glm::vec3>& points)
+{
+    ComputedPath path {};
+    path.waypoints.reserve(points.size());
 
-    std::reverse(path.waypoints.begin(), path.waypoints.end());
+    for (const glm::vec3& point : points)
+        path.waypoints.push_back({ point });
 
     return path;
 }
+
+void PathfindingModule::AddDebugPath(const ComputedPath& path)
+{
+    if (_debugDraw)
+        _debugPaths.push_back(path);
+}
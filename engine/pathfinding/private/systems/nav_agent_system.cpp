@@ -0,0 +1,181 @@
+#include "systems/nav_agent_system.hpp"
+
+#include "components/nav_agent_component.hpp"
+#include "components/transform_component.hpp"
+#include "components/transform_helpers.hpp"
+#include "crowd_avoidance.hpp"
+#include "ecs_module.hpp"
+#include "path_query_service.hpp"
+#include "pathfinding_module.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+#include <imgui.h>
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+float HorizontalDistance(const glm::vec3& a, const glm::vec3& b)
+{
+    return glm::length(glm::vec2 { a.x - b.x, a.z - b.z });
+}
+
+}
+
+NavAgentSystem::NavAgentSystem(PathfindingModule& pathfindingModule)
+    : _pathfindingModule(pathfindingModule)
+{
+}
+
+void NavAgentSystem::Update(ECSModule& ecs, float dt)
+{
+    UpdateAgents(ecs.GetRegistry(), _pathfindingModule.GetQueryService(), dt);
+    AvoidAgents(ecs.GetRegistry(), _pathfindingModule.GetCrowdAvoidance(), _pathfindingModule.GetThreadPool(), dt);
+
+    _agentCount = 0;
+    _searchingCount = 0;
+    _followingCount = 0;
+    _arrivedCount = 0;
+    _unreachableCount = 0;
+
+    for (auto [entity, agent] : ecs.GetRegistry().view<NavAgentComponent>().each())
+    {
+        _agentCount++;
+        _searchingCount += agent.GetState() == NavAgentState::eSEARCHING;
+        _followingCount += agent.GetState() == NavAgentState::eFOLLOWING;
+        _arrivedCount += agent.GetState() == NavAgentState::eARRIVED;
+        _unreachableCount += agent.GetState() == NavAgentState::eUNREACHABLE;
+    }
+}
+
+void NavAgentSystem::Inspect()
+{
+    ZoneScoped;
+    ImGui::Begin("Nav Agent System");
+    ImGui::Text("Agents: %u", _agentCount);
+    ImGui::Text("Searching: %u", _searchingCount);
+    ImGui::Text("Following: %u", _followingCount);
+    ImGui::Text("Arrived: %u", _arrivedCount);
+    ImGui::Text("Unreachable: %u", _unreachableCount);
+    ImGui::End();
+}
+
+void NavAgentSystem::UpdateAgents(entt::registry& registry, PathQueryService& queryService, float deltaTime)
+{
+    ZoneScoped;
+
+    for (auto [entity, agent] : registry.view<NavAgentComponent>().each())
+    {
+        if (!agent._hasTarget)
+        {
+            if (agent._request.IsValid())
+            {
+                queryService.Cancel(agent._request);
+                agent._request = {};
+            }
+
+            continue;
+        }
+
+        // Pick up the search that finished since the last update, failed searches leave no path
+        if (agent._request.IsValid() && queryService.GetStatus(agent._request) != PathRequestStatus::ePENDING)
+        {
+            std::optional<std::vector<glm::vec3>> points = queryService.TakeResult(agent._request);
+            agent._request = {};
+
+            if (points.has_value() && !points->empty())
+            {
+                agent._path = std::move(points.value());
+                agent._currentWaypoint = std::min(1u, static_cast<uint32_t>(agent._path.size()) - 1);
+                agent._state = NavAgentState::eFOLLOWING;
+            }
+            else
+            {
+                agent._path.clear();
+                agent._currentWaypoint = 0;
+                agent._state = NavAgentState::eUNREACHABLE;
+            }
+        }
+
+        agent._timeSinceSearch += deltaTime;
+
+        if (!registry.all_of<TransformComponent>(entity))
+            continue;
+
+        const glm::vec3 position = TransformHelpers::GetWorldPosition(registry, entity);
+        const NavAgentSettings& settings = agent.settings;
+
+        // Arrived agents only search again when the target moves, the path they have still leads to it
+        const bool targetMoved = glm::distance(agent._target, agent._searchedTarget) > settings.repathDistance;
+        const bool pathExpired = agent._timeSinceSearch >= settings.repathInterval && agent._state != NavAgentState::eARRIVED;
+
+        if (!agent._request.IsValid() && (agent._state == NavAgentState::eIDLE || targetMoved || pathExpired))
+        {
+            agent._request = queryService.Submit(position, agent._target, settings.smooth);
+            agent._searchedTarget = agent._target;
+            agent._timeSinceSearch = 0.0f;
+
+            if (agent._state == NavAgentState::eIDLE)
+                agent._state = NavAgentState::eSEARCHING;
+        }
+
+        // Keeps following the previous path while a new one is searched
+        if (agent._path.empty())
+        {
+            agent._direction = glm::vec3 { 0.0f };
+            continue;
+        }
+
+        const uint32_t lastWaypoint = static_cast<uint32_t>(agent._path.size()) - 1;
+
+        while (agent._currentWaypoint < lastWaypoint && HorizontalDistance(position, agent._path[agent._currentWaypoint]) <= settings.waypointRadius)
+            agent._currentWaypoint++;
+
+        if (HorizontalDistance(position, agent._path[lastWaypoint]) <= settings.arrivalDistance)
+        {
+            agent._state = NavAgentState::eARRIVED;
+            agent._direction = glm::vec3 { 0.0f };
+            agent._preferredVelocity = glm::vec3 { 0.0f };
+            continue;
+        }
+
+        agent._state = NavAgentState::eFOLLOWING;
+
+        const glm::vec3 toWaypoint = agent._path[agent._currentWaypoint] - position;
+        const glm::vec3 horizontal { toWaypoint.x, 0.0f, toWaypoint.z };
+        const float length = glm::length(horizontal);
+
+        agent._direction = length > 0.0001f ? horizontal / length : glm::vec3 { 0.0f };
+        agent._preferredVelocity = agent._direction * settings.maxSpeed;
+    }
+}
+
+void NavAgentSystem::AvoidAgents(entt::registry& registry, CrowdAvoidance& avoidance, ThreadPool* threadPool, float deltaTime)
+{
+    ZoneScoped;
+
+    avoidance.Clear();
+
+    // Agents are added in view order, so the index of an agent is its position in the view
+    auto view = registry.view<NavAgentComponent, TransformComponent>();
+
+    for (auto [entity, agent, transform] : view.each())
+    {
+        CrowdAvoidance::Agent crowdAgent {};
+        crowdAgent.position = TransformHelpers::GetWorldPosition(registry, entity);
+        crowdAgent.velocity = agent._velocity;
+        crowdAgent.preferredVelocity = agent._preferredVelocity;
+        crowdAgent.radius = agent.settings.radius;
+        crowdAgent.maxSpeed = agent.settings.maxSpeed;
+
+        avoidance.AddAgent(crowdAgent);
+    }
+
+    // ECS delta time is in milliseconds
+    avoidance.ComputeVelocities(deltaTime * 0.001f, threadPool);
+
+    uint32_t index = 0;
+    for (auto [entity, agent, transform] : view.each())
+        agent._velocity = avoidance.GetVelocity(index++);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "common.hpp"
+#include "path_query_service.hpp"
+
+#include <entt/entity/fwd.hpp>
+#include <glm/vec3.hpp>
+#include <vector>
+
+enum class NavAgentState : uint8_t
+{
+    // No target, or stopped
+    eIDLE,
+    // Waiting for the first path towards the target
+    eSEARCHING,
+    eFOLLOWING,
+    // Within the arrival distance of the end of the path, starts following again when pushed away
+    eARRIVED,
+    // No path leads to the target, searched again on the repath interval
+    eUNREACHABLE,
+};
+
+struct NavAgentSettings
+{
+    float waypointRadius = 1.0f; // Horizontal distance at which a waypoint counts as reached
+    float arrivalDistance = 1.0f; // Horizontal distance to the end of the path at which the agent stops
+    float repathInterval = 2000.0f; // In milliseconds, paths get outdated as agents get pushed around
+    float repathDistance = 2.0f; // Searches right away when the target moved further than this from where the path leads
+    bool smooth = true;
+
+    float radius = 0.5f; // Other agents keep at least this far away from the centre of the agent
+    float maxSpeed = 5.0f; // In units per second
+};
+
+// Follows paths over the navmesh, all agents are moved along in a single pass by the NavAgentSystem.
+// Set a target and read back the direction or velocity to walk with, the agent itself is moved by whatever moves the entity.
+// Paths are searched in the background by the query service of the pathfinding module, they are searched again
+// on the repath interval and as soon as the target moved too far.
+// Agents avoid each other: the velocity is the preferred velocity, adjusted to steer clear of the agents around it.
+class NavAgentComponent
+{
+public:
+    explicit NavAgentComponent(const NavAgentSettings& settings = {});
+
+    // Cancels the search of an agent when it is removed or its entity is destroyed, so it doesn't keep using the query budget
+    static void SetupRegistryCallbacks(entt::registry& registry, PathQueryService& queryService);
+    static void DisconnectRegistryCallbacks(entt::registry& registry, PathQueryService& queryService);
+
+    void SetTarget(const glm::vec3& target);
+
+    // Drops the target and the path, the agent becomes idle
+    void Stop();
+
+    // Getters
+    NavAgentState GetState() const { return _state; }
+    bool HasTarget() const { return _hasTarget; }
+    const glm::vec3& GetTarget() const { return _target; }
+    bool HasArrived() const { return _state == NavAgentState::eARRIVED; }
+
+    // Normalized horizontal direction towards the next waypoint, zero when there is no path to follow or the agent arrived
+    const glm::vec3& GetDirection() const { return _direction; }
+
+    // While the agent has a path, the preferred velocity follows it at max speed and setting it has no effect.
+    // Without a path, for example while searching or after Stop, the owner of the agent steers it by setting it.
+    void SetPreferredVelocity(const glm::vec3& velocity) { _preferredVelocity = velocity; }
+    const glm::vec3& GetPreferredVelocity() const { return _preferredVelocity; }
+
+    // Horizontal velocity after avoiding the other agents, updated every frame
+    const glm::vec3& GetVelocity() const { return _velocity; }
+
+    // Points of the path being followed, starting from where the agent was when it was searched
+    const std::vector<glm::vec3>& GetPath() const { return _path; }
+    uint32_t GetCurrentWaypoint() const { return _currentWaypoint; }
+
+    NavAgentSettings settings {};
+
+private:
+    friend class NavAgentSystem;
+
+    static void OnDestroyCallback(PathQueryService& queryService, entt::registry& registry, entt::entity entity);
+
+    glm::vec3 _target { 0.0f };
+    bool _hasTarget = false;
+
+    NavAgentState _state = NavAgentState::eIDLE;
+    glm::vec3 _direction { 0.0f };
+    std::vector<glm::vec3> _path {};
+    uint32_t _currentWaypoint = 0;
+
+    glm::vec3 _preferredVelocity { 0.0f };
+    glm::vec3 _velocity { 0.0f };
+
+    // The target of the last search, the path keeps leading there until the next one finishes
+    PathRequestHandle _request {};
+    glm::vec3 _searchedTarget { 0.0f };
+    float _timeSinceSearch = 0.0f;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <utility>
+#include <vector>
+
+class ThreadPool;
+
+struct CrowdAvoidanceSettings
+{
+    float neighbourDistance = 5.0f; // Agents further away than this are ignored, also the cell size of the spatial hash
+    uint32_t maxNeighbours = 10; // Only the closest neighbours are avoided
+    float maxHeightDifference = 2.0f; // Agents on different floors don't avoid each other
+    float timeHorizon = 1.0f; // In seconds, collisions further ahead in time than this are not avoided yet
+};
+
+// Local avoidance between agents with optimal reciprocal collision avoidance (ORCA). Every agent picks the velocity closest
+// to the one it prefers, outside of the velocities that would make it collide with a neighbour within the time horizon.
+// Both agents of a pair take half of the responsibility, so crowds flow around each other instead of piling up.
+// Works on the horizontal plane, the agents are gathered every update and their velocities read back by index.
+class CrowdAvoidance
+{
+public:
+    struct Agent
+    {
+        glm::vec3 position { 0.0f };
+        glm::vec3 velocity { 0.0f }; // Current velocity, the one computed for the agent last update
+        glm::vec3 preferredVelocity { 0.0f };
+        float radius = 0.5f;
+        float maxSpeed = 5.0f;
+    };
+
+    explicit CrowdAvoidance(const CrowdAvoidanceSettings& settings = {});
+
+    void Clear();
+
+    // Returns the index to read the velocity back with
+    uint32_t AddAgent(const Agent& agent);
+
+    // Delta time is in seconds, agents that already overlap are pushed apart within it.
+    // Without a thread pool all agents are computed on the calling thread.
+    void ComputeVelocities(float deltaTime, ThreadPool* threadPool);
+
+    // Horizontal velocity, the vertical part is always zero
+    NO_DISCARD const glm::vec3& GetVelocity(uint32_t agent) const { return _velocities[agent]; }
+    NO_DISCARD uint32_t GetAgentCount() const { return static_cast<uint32_t>(_agents.size()); }
+
+    void SetSettings(const CrowdAvoidanceSettings& settings) { _settings = settings; }
+    NO_DISCARD const CrowdAvoidanceSettings& GetSettings() const { return _settings; }
+
+private:
+    // Agents are computed in batches of at least this many, smaller crowds are not worth spreading over threads
+    constexpr static uint32_t MIN_AGENTS_PER_JOB = 128;
+
+    // Half plane of allowed velocities, left of the direction through the point
+    struct Line
+    {
+        glm::vec2 point { 0.0f };
+        glm::vec2 direction { 0.0f };
+    };
+
+    // Each job keeps its own, so the batches don't share memory while they run
+    struct Scratch
+    {
+        std::vector<std::pair<float, uint32_t>> neighbours {};
+        std::vector<Line> lines {};
+        std::vector<Line> projectedLines {};
+    };
+
+    void BuildSpatialHash();
+    NO_DISCARD uint32_t GetBucket(int32_t x, int32_t z) const;
+    void FindNeighbours(uint32_t agent, Scratch& scratch) const;
+    void ComputeVelocities(uint32_t first, uint32_t last, float deltaTime, Scratch& scratch);
+
+    static bool LinearProgram1(const std::vector<Line>& lines, uint32_t lineNo, float radius, const glm::vec2& optVelocity, bool directionOpt, glm::vec2& result);
+    static uint32_t LinearProgram2(const std::vector<Line>& lines, float radius, const glm::vec2& optVelocity, bool directionOpt, glm::vec2& result);
+    static void LinearProgram3(const std::vector<Line>& lines, uint32_t beginLine, float radius, glm::vec2& result, std::vector<Line>& projectedLines);
+
+    CrowdAvoidanceSettings _settings {};
+
+    std::vector<Agent> _agents {};
+    std::vector<glm::vec3> _velocities {};
+
+    // Agents sorted by the bucket of their cell, buckets can be shared by multiple cells
+    uint32_t _bucketMask = 0;
+    std::vector<uint32_t> _bucketStart {};
+    std::vector<uint32_t> _bucketAgents {};
+    std::vector<glm::ivec2> _agentCells {};
+
+    std::vector<Scratch> _scratch {};
+};
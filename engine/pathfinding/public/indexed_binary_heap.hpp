@@ -0,0 +1,48 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <limits>
+#include <vector>
+
+// Binary min-heap over the item indices [0, capacity), that tracks where every item is stored in the heap.
+// That makes it possible to lower the key of an item that is already queued, without searching for it or
+// pushing a duplicate. Clearing is O(1), so the same heap can be reused between searches without allocating.
+class IndexedBinaryHeap
+{
+public:
+    IndexedBinaryHeap() = default;
+
+    // Grows the heap to hold the items [0, capacity), clears it when the capacity changed
+    void Reserve(uint32_t capacity);
+    void Clear() { _heap.clear(); }
+
+    NO_DISCARD bool Empty() const { return _heap.empty(); }
+    NO_DISCARD uint32_t Size() const { return static_cast<uint32_t>(_heap.size()); }
+    NO_DISCARD uint32_t GetCapacity() const { return static_cast<uint32_t>(_positions.size()); }
+
+    NO_DISCARD bool Contains(uint32_t item) const
+    {
+        // Positions of items that left the heap are never reset, so check that the slot still holds the item
+        const uint32_t position = _positions[item];
+        return position < _heap.size() && _heap[position] == item;
+    }
+
+    NO_DISCARD float GetKey(uint32_t item) const { return _keys[item]; }
+    NO_DISCARD uint32_t Top() const { return _heap.front(); }
+
+    void Push(uint32_t item, float key);
+    void DecreaseKey(uint32_t item, float key);
+    uint32_t Pop();
+
+private:
+    void SiftUp(uint32_t position);
+    void SiftDown(uint32_t position);
+    void Place(uint32_t position, uint32_t item);
+
+    std::vector<uint32_t> _heap {};
+
+    // Indexed by item
+    std::vector<uint32_t> _positions {};
+    std::vector<float> _keys {};
+};
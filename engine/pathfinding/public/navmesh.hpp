@@ -0,0 +1,74 @@
+#pragma once
+
+#include "common.hpp"
+#include "navmesh_hierarchy.hpp"
+#include "navmesh_spatial_index.hpp"
+
+#include <glm/vec3.hpp>
+#include <limits>
+#include <vector>
+
+// Walkable surface used for pathfinding, a triangle list in world space together with the adjacency between its triangles,
+// a spatial index to find the triangle under a point and the clusters for hierarchical searches.
+class NavMesh
+{
+public:
+    constexpr static uint32_t INVALID_TRIANGLE = NavMeshSpatialIndex::INVALID_TRIANGLE;
+
+    // Side of a cluster, in cells of the spatial index that are about the size of an average triangle
+    constexpr static float CLUSTER_SIZE_IN_CELLS = 8.0f;
+
+    struct Triangle
+    {
+        uint32_t indices[3] = {
+            std::numeric_limits<uint32_t>::max(),
+            std::numeric_limits<uint32_t>::max(),
+            std::numeric_limits<uint32_t>::max()
+        };
+
+        glm::vec3 centre = glm::vec3 { 0.0f };
+
+        uint32_t adjacentTriangleIndices[3] = {
+            std::numeric_limits<uint32_t>::max(),
+            std::numeric_limits<uint32_t>::max(),
+            std::numeric_limits<uint32_t>::max()
+        };
+        uint8_t adjacentTriangleCount = 0;
+    };
+
+    NavMesh() = default;
+    NavMesh(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices);
+
+    // Returns the triangle closest to the point, or INVALID_TRIANGLE when the navmesh is empty
+    NO_DISCARD uint32_t FindClosestTriangle(const glm::vec3& point) const { return _spatialIndex.FindClosestTriangle(point); }
+
+    // Reference implementation of FindClosestTriangle that checks every triangle
+    NO_DISCARD uint32_t FindClosestTriangleBruteForce(const glm::vec3& point) const;
+
+    // Projects the point onto the triangle
+    NO_DISCARD glm::vec3 ClosestPointOnTriangle(uint32_t triangle, const glm::vec3& point) const;
+
+    // Finds the vertex indices of the edge two adjacent triangles share, returns false when they share no edge
+    bool GetSharedEdge(uint32_t a, uint32_t b, uint32_t& first, uint32_t& second) const;
+
+    NO_DISCARD bool IsEmpty() const { return _triangles.empty(); }
+    NO_DISCARD uint32_t GetTriangleCount() const { return static_cast<uint32_t>(_triangles.size()); }
+
+    NO_DISCARD const std::vector<glm::vec3>& GetVertices() const { return _vertices; }
+    NO_DISCARD const std::vector<uint32_t>& GetIndices() const { return _indices; }
+    NO_DISCARD const std::vector<Triangle>& GetTriangles() const { return _triangles; }
+    NO_DISCARD const Triangle& GetTriangle(uint32_t index) const { return _triangles[index]; }
+    NO_DISCARD const NavMeshSpatialIndex& GetSpatialIndex() const { return _spatialIndex; }
+    NO_DISCARD const NavMeshHierarchy& GetHierarchy() const { return _hierarchy; }
+
+private:
+    friend class NavMeshBake;
+
+    void BuildTriangles();
+
+    std::vector<glm::vec3> _vertices {};
+    std::vector<uint32_t> _indices {};
+    std::vector<Triangle> _triangles {};
+    NavMeshSpatialIndex _spatialIndex {};
+    NavMeshHierarchy _hierarchy {};
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "common.hpp"
+#include "navmesh.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Compact binary form of a navmesh with everything that is derived from the triangles already computed:
+// the adjacency and centres of the triangles, the spatial index and the clusters, portals and edges of the hierarchy.
+// Loading it is a single read followed by copying the arrays out, instead of parsing the glTF and building the navmesh again.
+class NavMeshBake
+{
+public:
+    using Key = uint64_t;
+
+    // Bump this whenever the layout of the file or the building of the navmesh changes, all files written with an older version are ignored
+    constexpr static uint32_t BAKE_VERSION = 1;
+    constexpr static std::string_view DEFAULT_DIRECTORY = "cache/navmesh";
+
+    // Identifies the version of a source file by its path, size and last write time, returns nullopt when it doesn't exist.
+    // The path goes through the virtual filesystem, so sources packed in the game archive have a key as well.
+    NO_DISCARD static std::optional<Key> MakeSourceKey(std::string_view source);
+
+    // Location of the baked file for a source file, the name is a hash of the source path
+    NO_DISCARD static std::filesystem::path GetBakedPath(const std::filesystem::path& source, const std::filesystem::path& directory = DEFAULT_DIRECTORY);
+
+    // The key is stored in the bake, deserializing fails when it doesn't match, so a changed source is baked again
+    NO_DISCARD static std::vector<std::byte> Serialize(const NavMesh& navMesh, Key sourceKey);
+    NO_DISCARD static std::optional<NavMesh> Deserialize(std::span<const std::byte> bytes, Key sourceKey);
+
+    static bool Save(const NavMesh& navMesh, const std::filesystem::path& path, Key sourceKey);
+    NO_DISCARD static std::optional<NavMesh> Load(const std::filesystem::path& path, Key sourceKey);
+
+private:
+    // Everything that is used to index another array is checked, so a corrupt bake is rejected instead of reading out of bounds later
+    NO_DISCARD static bool IsValid(const NavMesh& navMesh);
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "common.hpp"
+#include "indexed_binary_heap.hpp"
+#include "navmesh.hpp"
+#include "timers.hpp"
+
+#include <glm/vec3.hpp>
+#include <limits>
+#include <vector>
+
+// Shortest paths from every triangle of a navmesh towards a single target, found with one Dijkstra search outwards from
+// the triangle under the target. Any amount of agents heading to the same target can then look up where to go next in O(1),
+// instead of each running its own A*. Edge costs are the same as the ones NavMeshQuery uses, so following the next
+// triangles gives a corridor exactly as short as the one A* finds.
+class NavMeshFlowField
+{
+public:
+    NavMeshFlowField() = default;
+
+    // Searches the whole navmesh from the triangle closest to the target. Returns false when the navmesh is empty.
+    bool Build(const NavMesh& navMesh, const glm::vec3& target);
+    void Clear();
+
+    // Only rebuilds when the target moved to another triangle, or the field is older than the refresh interval.
+    // Moving the target within its triangle just moves the point agents in that triangle walk to.
+    // Returns true when the field was rebuilt.
+    bool Update(const NavMesh& navMesh, const glm::vec3& target, DeltaMS deltatime);
+
+    void SetRefreshInterval(DeltaMS interval) { _refreshInterval = interval; }
+    NO_DISCARD DeltaMS GetRefreshInterval() const { return _refreshInterval; }
+
+    NO_DISCARD bool IsValid() const { return _targetTriangle != NavMesh::INVALID_TRIANGLE; }
+    NO_DISCARD const glm::vec3& GetTarget() const { return _target; }
+    NO_DISCARD uint32_t GetTargetTriangle() const { return _targetTriangle; }
+    NO_DISCARD uint32_t GetTriangleCount() const { return static_cast<uint32_t>(_nextTriangles.size()); }
+    NO_DISCARD uint32_t GetBuildCount() const { return _buildCount; }
+
+    NO_DISCARD bool IsReachable(uint32_t triangle) const { return _distances[triangle] != UNREACHABLE; }
+
+    // Next triangle on a shortest path to the target, INVALID_TRIANGLE in the target triangle and in unreachable triangles
+    NO_DISCARD uint32_t GetNextTriangle(uint32_t triangle) const { return _nextTriangles[triangle]; }
+
+    // Sum of the distances between the triangle centres on the way to the target triangle
+    NO_DISCARD float GetDistance(uint32_t triangle) const { return _distances[triangle]; }
+
+    // Middle of the edge into the next triangle, or the target itself in the target triangle
+    NO_DISCARD const glm::vec3& GetWaypoint(uint32_t triangle) const { return _waypoints[triangle]; }
+
+    // Normalized horizontal direction from a position in the triangle to its waypoint, or to the waypoint after it when
+    // the position is on the waypoint already. Zero when the triangle can't reach the target, or the position is at the target.
+    NO_DISCARD glm::vec3 SampleDirection(uint32_t triangle, const glm::vec3& position) const;
+
+    // Same as above, finding the triangle under the position first
+    NO_DISCARD glm::vec3 SampleDirection(const NavMesh& navMesh, const glm::vec3& position) const;
+
+private:
+    constexpr static float UNREACHABLE = std::numeric_limits<float>::max();
+
+    glm::vec3 _target { 0.0f };
+    uint32_t _targetTriangle = NavMesh::INVALID_TRIANGLE;
+
+    DeltaMS _refreshInterval { 1000.0f };
+    DeltaMS _timeSinceBuild { 0.0f };
+    uint32_t _buildCount = 0;
+
+    // Indexed by triangle
+    std::vector<float> _distances {};
+    std::vector<uint32_t> _nextTriangles {};
+    std::vector<glm::vec3> _waypoints {};
+
+    IndexedBinaryHeap _openList {};
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+class NavMesh;
+
+// Abstraction of a navmesh for hierarchical pathfinding (HPA*). Triangles are grouped into clusters, connected groups of
+// triangles that have their centre in the same cell of a square grid. Where two clusters touch, the middle crossing of every
+// stretch of shared edges becomes a portal, long stretches also get one at both ends. The triangles on both sides of a portal are the nodes of an abstract graph, that
+// connects them to each other across the portal, and to the other nodes of their cluster with the precomputed cost of walking there.
+// Searching that small graph first, and then only inside the clusters along the way, is much cheaper than searching every triangle,
+// at the price of paths that can be slightly longer, as they have to go through the portals.
+class NavMeshHierarchy
+{
+public:
+    constexpr static uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+    // Entrances with at least this many crossings get a portal at both ends as well, so paths along
+    // the border of a cluster don't have to detour through the middle of a long entrance
+    constexpr static uint32_t LONG_ENTRANCE_CROSSINGS = 6;
+
+    struct Cluster
+    {
+        // Into GetClusterTriangles() and GetNodes()
+        uint32_t firstTriangle = 0;
+        uint32_t triangleCount = 0;
+        uint32_t firstNode = 0;
+        uint32_t nodeCount = 0;
+    };
+
+    struct Node
+    {
+        uint32_t triangle = INVALID_INDEX;
+        uint32_t cluster = INVALID_INDEX;
+
+        // Into GetEdges()
+        uint32_t firstEdge = 0;
+        uint32_t edgeCount = 0;
+    };
+
+    struct Edge
+    {
+        uint32_t node = INVALID_INDEX;
+        float cost = 0.0f;
+    };
+
+    NavMeshHierarchy() = default;
+
+    // The cluster size is the side of a grid cell in world units
+    void Build(const NavMesh& navMesh, float clusterSize);
+    void Clear();
+
+    NO_DISCARD bool IsEmpty() const { return _clusters.empty(); }
+    NO_DISCARD float GetClusterSize() const { return _clusterSize; }
+    NO_DISCARD uint32_t GetClusterCount() const { return static_cast<uint32_t>(_clusters.size()); }
+    NO_DISCARD uint32_t GetNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+
+    NO_DISCARD uint32_t GetTriangleCluster(uint32_t triangle) const { return _triangleClusters[triangle]; }
+
+    // Returns INVALID_INDEX for triangles that are not next to a portal
+    NO_DISCARD uint32_t GetTriangleNode(uint32_t triangle) const { return _triangleNodes[triangle]; }
+
+    NO_DISCARD const Cluster& GetCluster(uint32_t cluster) const { return _clusters[cluster]; }
+    NO_DISCARD const Node& GetNode(uint32_t node) const { return _nodes[node]; }
+
+    NO_DISCARD std::span<const uint32_t> GetTrianglesInCluster(uint32_t cluster) const
+    {
+        const Cluster& info = _clusters[cluster];
+        return { _clusterTriangles.data() + info.firstTriangle, info.triangleCount };
+    }
+
+    NO_DISCARD std::span<const Edge> GetNodeEdges(uint32_t node) const
+    {
+        const Node& info = _nodes[node];
+        return { _edges.data() + info.firstEdge, info.edgeCount };
+    }
+
+    NO_DISCARD const std::vector<Cluster>& GetClusters() const { return _clusters; }
+    NO_DISCARD const std::vector<Node>& GetNodes() const { return _nodes; }
+    NO_DISCARD const std::vector<Edge>& GetEdges() const { return _edges; }
+    NO_DISCARD const std::vector<uint32_t>& GetTriangleClusters() const { return _triangleClusters; }
+    NO_DISCARD const std::vector<uint32_t>& GetClusterTriangles() const { return _clusterTriangles; }
+
+private:
+    friend class NavMeshBake;
+
+    using Portal = std::pair<uint32_t, uint32_t>;
+
+    void BuildClusters(const NavMesh& navMesh);
+    NO_DISCARD std::vector<Portal> FindPortals(const NavMesh& navMesh) const;
+    void BuildNodes(const std::vector<Portal>& portals);
+    void BuildEdges(const NavMesh& navMesh, const std::vector<Portal>& portals);
+
+    float _clusterSize = 0.0f;
+
+    std::vector<Cluster> _clusters {};
+    std::vector<Node> _nodes {};
+    std::vector<Edge> _edges {};
+
+    // Indexed by triangle
+    std::vector<uint32_t> _triangleClusters {};
+    std::vector<uint32_t> _triangleNodes {};
+
+    // Triangles sorted by cluster
+    std::vector<uint32_t> _clusterTriangles {};
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <glm/vec3.hpp>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+class NavMesh;
+class NavMeshQuery;
+
+// Least recently used cache of search results, keyed by the start and goal triangle. Every start and end point within the
+// same two triangles shares the corridor, so only the cheap step of turning it into points has to be redone when the endpoints moved.
+// Failed searches are cached as well, as searching for an unreachable goal is the most expensive search there is.
+// The cached corridors belong to one navmesh, Invalidate has to be called whenever it changes. Not thread safe.
+class NavMeshPathCache
+{
+public:
+    constexpr static uint32_t DEFAULT_CAPACITY = 256;
+
+    enum class LookupResult
+    {
+        eMISS,
+        eFOUND,
+        eUNREACHABLE,
+    };
+
+    struct Stats
+    {
+        // Same endpoints as the cached path, the points are reused as well
+        uint32_t hits = 0;
+        // Endpoints moved within their triangles, the corridor is reused and the points are rebuilt
+        uint32_t partialHits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;
+        // Times entries were dropped because the navmesh changed
+        uint32_t invalidations = 0;
+
+        NO_DISCARD float GetHitRate() const
+        {
+            const uint32_t lookups = hits + partialHits + misses;
+            return lookups == 0 ? 0.0f : static_cast<float>(hits + partialHits) / static_cast<float>(lookups);
+        }
+    };
+
+    explicit NavMeshPathCache(uint32_t capacity = DEFAULT_CAPACITY);
+
+    // Fills the points when the triangles are cached, rebuilding them from the cached corridor with the query when the endpoints moved
+    LookupResult FindPath(const NavMesh& navMesh, NavMeshQuery& query, uint32_t startTriangle, uint32_t goalTriangle,
+        const glm::vec3& start, const glm::vec3& end, bool smooth, std::vector<glm::vec3>& points);
+
+    // An empty corridor marks the goal as unreachable from the start, evicts the least recently used entry when full
+    void Store(uint32_t startTriangle, uint32_t goalTriangle, const std::vector<uint32_t>& corridor,
+        const glm::vec3& start, const glm::vec3& end, bool smooth, const std::vector<glm::vec3>& points);
+
+    // Doesn't count as a lookup, nor makes the entry the most recently used
+    NO_DISCARD bool Contains(uint32_t startTriangle, uint32_t goalTriangle) const { return _lookup.contains(MakeKey(startTriangle, goalTriangle)); }
+
+    // Drops every entry, keeps the statistics
+    void Invalidate();
+
+    // Smaller capacities evict the least recently used entries right away, 0 disables the cache
+    void SetCapacity(uint32_t capacity);
+    NO_DISCARD uint32_t GetCapacity() const { return _capacity; }
+    NO_DISCARD uint32_t GetSize() const { return static_cast<uint32_t>(_lookup.size()); }
+
+    NO_DISCARD const Stats& GetStats() const { return _stats; }
+    void ResetStats() { _stats = {}; }
+
+private:
+    constexpr static uint32_t INVALID_ENTRY = std::numeric_limits<uint32_t>::max();
+
+    // Entries are kept in a flat array and reused, linked from most to least recently used
+    struct Entry
+    {
+        uint64_t key = 0;
+        uint32_t previous = INVALID_ENTRY;
+        uint32_t next = INVALID_ENTRY;
+
+        std::vector<uint32_t> corridor {};
+
+        // Points of the last path built from the corridor
+        glm::vec3 start { 0.0f };
+        glm::vec3 end { 0.0f };
+        bool smooth = true;
+        std::vector<glm::vec3> points {};
+    };
+
+    NO_DISCARD static uint64_t MakeKey(uint32_t startTriangle, uint32_t goalTriangle);
+
+    void Unlink(uint32_t entry);
+    void PushFront(uint32_t entry);
+    void EvictLeastRecentlyUsed();
+
+    uint32_t _capacity = DEFAULT_CAPACITY;
+    Stats _stats {};
+
+    std::vector<Entry> _entries {};
+    std::vector<uint32_t> _freeEntries {};
+    std::unordered_map<uint64_t, uint32_t> _lookup {};
+
+    uint32_t _mostRecent = INVALID_ENTRY;
+    uint32_t _leastRecent = INVALID_ENTRY;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "common.hpp"
+#include "indexed_binary_heap.hpp"
+
+#include <glm/vec3.hpp>
+#include <limits>
+#include <vector>
+
+class NavMesh;
+
+// A* over the triangle graph of a navmesh. All search state lives in flat arrays indexed by triangle,
+// that are kept between searches and invalidated with a generation counter instead of being cleared.
+// After the first search on a navmesh, searching does not allocate.
+// Not thread safe, every thread that searches needs its own query.
+class NavMeshQuery
+{
+public:
+    enum class SearchStatus
+    {
+        eIN_PROGRESS,
+        eSUCCEEDED,
+        eFAILED,
+    };
+
+    NavMeshQuery() = default;
+
+    // Finds the triangles under start and end, searches a corridor between them and turns it into points to walk along.
+    // Smoothed paths only bend around the corners of the navmesh, otherwise the path goes through the middle of every crossed edge.
+    // Returns false, with no points, when there is no path.
+    bool FindPath(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end, bool smooth, std::vector<glm::vec3>& points);
+
+    // Fills the corridor with the triangles from start to goal, both included.
+    // Returns false, with an empty corridor, when the goal can't be reached from the start.
+    bool FindCorridor(const NavMesh& navMesh, uint32_t startTriangle, uint32_t goalTriangle, std::vector<uint32_t>& corridor);
+
+    // Coarse to fine version of FindCorridor using the hierarchy of the navmesh, searching the graph of portals between clusters first,
+    // and then only inside the clusters along the way. Much cheaper on large navmeshes, but the corridor can be a bit longer,
+    // as it has to pass through the middle of every entrance between clusters.
+    bool FindHierarchicalCorridor(const NavMesh& navMesh, uint32_t startTriangle, uint32_t goalTriangle, std::vector<uint32_t>& corridor);
+
+    // Makes FindPath use FindHierarchicalCorridor
+    void SetHierarchical(bool hierarchical) { _hierarchical = hierarchical; }
+    NO_DISCARD bool IsHierarchical() const { return _hierarchical; }
+
+    // Sliced version of FindCorridor, so a search can be spread over multiple frames.
+    // The navmesh has to stay alive and unchanged until the search finished.
+    SearchStatus BeginSearch(const NavMesh& navMesh, uint32_t startTriangle, uint32_t goalTriangle);
+    // Expands at most this amount of triangles
+    SearchStatus UpdateSearch(uint32_t maxExpansions);
+    // Fills the corridor of a succeeded search
+    bool FinishSearch(std::vector<uint32_t>& corridor);
+
+    NO_DISCARD SearchStatus GetStatus() const { return _status; }
+
+    // Turns a corridor into points, using FindStraightPath when smoothing and FindEdgeCentrePath otherwise
+    void BuildPath(const NavMesh& navMesh, const std::vector<uint32_t>& corridor, const glm::vec3& start, const glm::vec3& end, bool smooth, std::vector<glm::vec3>& points);
+
+    // Shortest path from start to end that stays inside the corridor, using the simple stupid funnel algorithm.
+    // The points are the start and end projected onto the navmesh, with the navmesh vertices the path bends around in between.
+    void FindStraightPath(const NavMesh& navMesh, const std::vector<uint32_t>& corridor, const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& points);
+
+    // The centre of the first and last triangle, with the middle of every crossed edge in between
+    static void FindEdgeCentrePath(const NavMesh& navMesh, const std::vector<uint32_t>& corridor, std::vector<glm::vec3>& points);
+
+    // Sum of the distances between the centres of the triangles in the last found corridor
+    NO_DISCARD float GetLastCost() const { return _lastCost; }
+
+    // Amount of triangles taken from the open list during the last search, summed over all its slices.
+    // Hierarchical searches also count the nodes of the abstract graph.
+    NO_DISCARD uint32_t GetLastExpandedCount() const { return _lastExpandedCount; }
+
+private:
+    struct Node
+    {
+        float cost = 0.0f;
+        uint32_t parent = 0;
+        uint32_t generation = 0;
+        bool closed = false;
+    };
+
+    struct Portal
+    {
+        glm::vec3 left { 0.0f };
+        glm::vec3 right { 0.0f };
+    };
+
+    static void ResetNodes(std::vector<Node>& nodes, IndexedBinaryHeap& openList, uint32_t& generation, uint32_t count);
+
+    // A* that doesn't leave the cluster, or Dijkstra over the whole cluster when the goal is INVALID_TRIANGLE.
+    // Returns true when the goal was reached.
+    bool SearchCluster(const NavMesh& navMesh, uint32_t cluster, uint32_t startTriangle, uint32_t goalTriangle);
+    NO_DISCARD float GetSearchedCost(uint32_t triangle) const;
+
+    // Appends the triangles after the start, up to and including the goal, that the last search went through
+    void AppendSearchedCorridor(uint32_t startTriangle, uint32_t goalTriangle, std::vector<uint32_t>& corridor) const;
+
+    // Fills _abstractPath with the start triangle, the portal triangles to go through and the goal triangle.
+    // Returns false when there is no path through the portals that is cheaper than the max cost.
+    bool FindAbstractPath(const NavMesh& navMesh, uint32_t startTriangle, uint32_t goalTriangle, float maxCost);
+
+    const NavMesh* _navMesh = nullptr;
+    uint32_t _goalTriangle = 0;
+    SearchStatus _status = SearchStatus::eFAILED;
+
+    std::vector<Node> _nodes {};
+    IndexedBinaryHeap _openList {};
+    uint32_t _generation = 0;
+
+    // Nodes of the hierarchy, followed by the start and goal
+    std::vector<Node> _abstractNodes {};
+    IndexedBinaryHeap _abstractOpenList {};
+    uint32_t _abstractGeneration = 0;
+    std::vector<uint32_t> _abstractPath {};
+
+    // Cost from the start and goal to the nodes of their clusters
+    std::vector<float> _startCosts {};
+    std::vector<float> _goalCosts {};
+
+    std::vector<Portal> _portals {};
+    std::vector<uint32_t> _corridor {};
+    bool _hierarchical = false;
+
+    float _lastCost = 0.0f;
+    uint32_t _lastExpandedCount = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <limits>
+#include <span>
+#include <vector>
+
+// Uniform 2D grid over the XZ bounds of the navmesh triangles, used to find the triangle closest to a point.
+// Every cell lists the triangles whose bounds overlap it, so a lookup only has to test the triangles around the point.
+class NavMeshSpatialIndex
+{
+public:
+    constexpr static uint32_t INVALID_TRIANGLE = std::numeric_limits<uint32_t>::max();
+
+    // Keeps the grid from growing unbounded on huge or degenerate meshes
+    constexpr static uint32_t MAX_CELLS_PER_AXIS = 1024;
+
+    NavMeshSpatialIndex() = default;
+
+    // Indices are a triangle list into the vertices
+    void Build(std::span<const glm::vec3> vertices, std::span<const uint32_t> indices);
+    void Clear();
+
+    // Returns the triangle with the smallest distance to the point, or INVALID_TRIANGLE when the index is empty
+    NO_DISCARD uint32_t FindClosestTriangle(const glm::vec3& point) const;
+
+    NO_DISCARD bool IsEmpty() const { return _triangleCount == 0; }
+    NO_DISCARD glm::uvec2 GetCellCount() const { return _cellCount; }
+    NO_DISCARD float GetCellSize() const { return _cellSize; }
+
+    NO_DISCARD static glm::vec3 ClosestPointOnTriangle(const glm::vec3& point, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+    NO_DISCARD static float DistanceSquaredToTriangle(const glm::vec3& point, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+
+private:
+    friend class NavMeshBake;
+
+    NO_DISCARD glm::ivec2 GetCell(const glm::vec3& point) const;
+
+    uint32_t _triangleCount = 0;
+    glm::vec2 _min { 0.0f };
+    glm::uvec2 _cellCount { 0 };
+    float _cellSize = 1.0f;
+
+    // Copy of the triangle corners, so lookups don't need to go through the index buffer
+    std::vector<glm::vec3> _corners {};
+
+    // Triangles of cell i are _cellTriangles[_cellStart[i]] up to _cellTriangles[_cellStart[i + 1]]
+    std::vector<uint32_t> _cellStart {};
+    std::vector<uint32_t> _cellTriangles {};
+};
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "common.hpp"
+#include "navmesh_query.hpp"
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <glm/vec3.hpp>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+class NavMesh;
+class NavMeshPathCache;
+class ThreadPool;
+
+struct PathRequestHandle
+{
+    uint32_t id = 0;
+
+    NO_DISCARD bool IsValid() const { return id != 0; }
+    bool operator==(const PathRequestHandle& other) const = default;
+};
+
+enum class PathRequestStatus
+{
+    // Never submitted, cancelled, expired or its result was already taken
+    eINVALID,
+    ePENDING,
+    eSUCCEEDED,
+    eFAILED,
+};
+
+struct PathQueryBudget
+{
+    // Triangles all searches together may expand during a single update, long searches continue next update
+    uint32_t maxExpansionsPerUpdate = 8192;
+
+    // Searches that run at the same time, each of them keeps its own search state
+    uint32_t maxConcurrentSearches = 4;
+
+    // Finished requests that were not taken are dropped after this many updates
+    uint32_t resultLifetime = 300;
+};
+
+// Runs path requests in the background, spread over multiple updates. Requests are submitted from and delivered to
+// the thread calling Update, the searching itself happens on the thread pool.
+// Every update first collects the searches that ran since the previous update, then starts the next batch.
+class PathQueryService
+{
+public:
+    // Called from Update, with an empty path when the request failed
+    using Callback = std::function<void(PathRequestHandle, PathRequestStatus, const std::vector<glm::vec3>&)>;
+
+    explicit PathQueryService(PathQueryBudget budget = {});
+    ~PathQueryService();
+
+    NON_COPYABLE(PathQueryService);
+    NON_MOVABLE(PathQueryService);
+
+    // Requests with a callback get it called once the path is found, instead of keeping the result around to be taken
+    PathRequestHandle Submit(const glm::vec3& start, const glm::vec3& end, bool smooth = true, Callback callback = {});
+
+    // The request is forgotten, its callback won't be called
+    void Cancel(PathRequestHandle handle);
+
+    // Cancels every request, needed before the navmesh is changed or destroyed
+    void CancelAll();
+
+    NO_DISCARD PathRequestStatus GetStatus(PathRequestHandle handle) const;
+
+    // Returns the points of a finished request, after which the handle is no longer valid.
+    // Failed requests return no points, nullopt means the request is still pending or the handle is invalid.
+    std::optional<std::vector<glm::vec3>> TakeResult(PathRequestHandle handle);
+
+    // Without a thread pool the searches run on the calling thread
+    void Update(const NavMesh& navMesh, ThreadPool* threadPool);
+
+    // Blocks until the searches started by the last update are done
+    void WaitForSearches();
+
+    // Hierarchical searches run to completion in a single update, as they only expand a small part of the navmesh.
+    // Their expansions still count towards the budget: searches are only started while their estimated cost fits in what is left of it,
+    // the rest is deferred to the next update, and expansions that went over the budget are taken from the next updates.
+    void SetHierarchical(bool hierarchical) { _hierarchical = hierarchical; }
+    NO_DISCARD bool IsHierarchical() const { return _hierarchical; }
+
+    // Requests between two triangles that are in the cache finish right away during Update, without searching,
+    // and the results of searches are stored in it. The cache has to stay alive while it is set, nullptr disables it.
+    void SetPathCache(NavMeshPathCache* cache) { _pathCache = cache; }
+    NO_DISCARD NavMeshPathCache* GetPathCache() const { return _pathCache; }
+
+    void SetBudget(const PathQueryBudget& budget);
+    NO_DISCARD const PathQueryBudget& GetBudget() const { return _budget; }
+
+    NO_DISCARD uint32_t GetPendingCount() const { return static_cast<uint32_t>(_pending.size()); }
+    NO_DISCARD uint32_t GetRunningCount() const;
+    NO_DISCARD uint32_t GetExpansionsLastUpdate() const { return _expansionsLastUpdate; }
+
+private:
+    struct Request
+    {
+        glm::vec3 start { 0.0f };
+        glm::vec3 end { 0.0f };
+        bool smooth = true;
+        Callback callback {};
+
+        PathRequestStatus status = PathRequestStatus::ePENDING;
+        std::vector<glm::vec3> points {};
+        uint64_t finishedAtUpdate = 0;
+    };
+
+    // Only touched by its job while the search runs
+    struct Search
+    {
+        NavMeshQuery query {};
+        const NavMesh* navMesh = nullptr;
+        uint32_t requestID = 0;
+        glm::vec3 start { 0.0f };
+        glm::vec3 end { 0.0f };
+        bool smooth = true;
+
+        bool hierarchical = false;
+        uint32_t startTriangle = 0;
+        uint32_t goalTriangle = 0;
+
+        uint32_t budget = 0;
+        uint32_t expansions = 0;
+        std::vector<uint32_t> corridor {};
+        std::vector<glm::vec3> points {};
+    };
+
+    static void RunSearch(Search& search);
+    Search* FindIdleSearch();
+
+    void CollectSearches();
+    void StartSearches(const NavMesh& navMesh);
+    bool FinishFromCache(const NavMesh& navMesh, uint32_t requestID, const Request& request, uint32_t startTriangle, uint32_t goalTriangle);
+    void Finish(uint32_t requestID, PathRequestStatus status, std::vector<glm::vec3>&& points);
+    void ExpireResults();
+
+    PathQueryBudget _budget {};
+    bool _hierarchical = false;
+
+    NavMeshPathCache* _pathCache = nullptr;
+    // Only used to build the points of cached corridors, on the thread calling Update
+    NavMeshQuery _cacheQuery {};
+    std::vector<glm::vec3> _cachedPoints {};
+
+    uint32_t _nextID = 1;
+    uint64_t _updateCount = 0;
+    uint32_t _expansionsLastUpdate = 0;
+
+    // Expansions of hierarchical searches that went over the budget, and the average expansions of such a search
+    uint32_t _overspentExpansions = 0;
+    float _hierarchicalExpansionEstimate = 0.0f;
+
+    std::unordered_map<uint32_t, Request> _requests {};
+    std::deque<uint32_t> _pending {};
+
+    std::vector<std::unique_ptr<Search>> _searches {};
+    std::vector<std::future<void>> _jobs {};
+};
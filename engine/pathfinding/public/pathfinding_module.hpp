@@ -1,10 +1,17 @@
 #pragma once
 
 #include "cpu_resources.hpp"
+#include "crowd_avoidance.hpp"
 #include "module_interface.hpp"
+#include "navmesh.hpp"
+#include "navmesh_flow_field.hpp"
+#include "navmesh_path_cache.hpp"
+#include "navmesh_query.hpp"
+#include "path_query_service.hpp"
 #include "renderer.hpp"
+#include <functional>
 #include <glm/glm.hpp>
-#include <queue>
+#include <optional>
 #include <unordered_map>
 
 struct PathNode
@@ -20,62 +27,12 @@ struct ComputedPath
     std::vector<PathNode> waypoints;
 };
 
-struct TriangleNode
+struct FlowFieldHandle
 {
-    float totalCost;
-    float estimateToGoal;
-    float totalEstimatedCost;
-    uint32_t triangleIndex;
-    uint32_t parentTriangleIndex;
+    uint32_t id = 0;
 
-    bool operator<(const TriangleNode& rhs)
-    {
-        return this->totalCost < rhs.totalCost;
-    }
-    bool operator>(const TriangleNode& rhs)
-    {
-        return this->totalCost > rhs.totalCost;
-    }
-
-    bool operator==(const TriangleNode& rhs)
-    {
-        return this->triangleIndex == rhs.triangleIndex;
-    }
-};
-
-inline bool operator<(const TriangleNode& lhs, const TriangleNode& rhs)
-{
-    return lhs.totalCost < rhs.totalCost;
-}
-
-inline bool operator>(const TriangleNode& lhs, const TriangleNode& rhs)
-{
-    return lhs.totalCost > rhs.totalCost;
-}
-
-inline bool operator==(const TriangleNode& lhs, const TriangleNode& rhs)
-{
-    return lhs.triangleIndex == rhs.triangleIndex;
-}
-
-template <class _Ty, class _Container = std::vector<_Ty>, class _Pr = std::less<typename _Container::value_type>>
-struct IterablePriorityQueue : public std::priority_queue<_Ty, _Container, _Pr>
-{
-public:
-    typename std::vector<_Ty>::iterator begin()
-    {
-        return this->c.begin();
-    }
-
-    typename std::vector<_Ty>::iterator end()
-    {
-        return this->c.end();
-    }
-
-    typename _Container::iterator find(const _Ty& item)
-    {
-        return std::find(this->c.begin(), this->c.end(), item);
-    }
+    NO_DISCARD bool IsValid() const { return id != 0; }
+    bool operator==(const FlowFieldHandle& other) const = default;
 };
 
 class PathfindingModule : public ModuleInterface
@@ -92,8 +49,61 @@ public:
     NON_COPYABLE(PathfindingModule)
     NON_MOVABLE(PathfindingModule)
 
+    // Loads the first static mesh of the glTF, the built navmesh is baked to disk so the next load of the same file can skip building it
     int32_t SetNavigationMesh(std::string_view filePath);
-    ComputedPath FindPath(glm::vec3 startPos, glm::vec3 endPos);
+
+    // Vertices in world space, indices form a triangle list
+    void SetNavigationMesh(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices);
+    void SetNavigationMesh(NavMesh navMesh);
+    const NavMesh& GetNavigationMesh() const { return _navMesh; }
+
+    using PathCallback = std::function<void(PathRequestHandle, PathRequestStatus, const ComputedPath&)>;
+
+    // Smoothed paths only bend around the corners of the navmesh, otherwise the path goes through the middle of every crossed edge.
+    // Searches right away on the calling thread, which has to be the main thread.
+    ComputedPath FindPath(glm::vec3 startPos, glm::vec3 endPos, bool smooth = true);
+
+    // Can be called from any thread, as long as every thread passes its own query
+    ComputedPath FindPath(glm::vec3 startPos, glm::vec3 endPos, bool smooth, NavMeshQuery& query) const;
+
+    // Searches in the background, within the budget of the query service. The result can be polled with TakePath,
+    // or is passed to the callback on the main thread, both at the earliest during the next tick.
+    PathRequestHandle RequestPath(glm::vec3 startPos, glm::vec3 endPos, bool smooth = true, PathCallback callback = {});
+    void CancelPath(PathRequestHandle handle) { _queryService.Cancel(handle); }
+    PathRequestStatus GetPathStatus(PathRequestHandle handle) const { return _queryService.GetStatus(handle); }
+
+    // Returns nullopt while the request is pending, and an empty path when no path was found
+    std::optional<ComputedPath> TakePath(PathRequestHandle handle);
+
+    PathQueryService& GetQueryService() { return _queryService; }
+
+    // Used by the NavAgentSystem to keep the nav agents from walking into each other
+    CrowdAvoidance& GetCrowdAvoidance() { return _crowdAvoidance; }
+    ThreadPool* GetThreadPool() const { return _threadPool; }
+
+    // Results of FindPath without a query of its own and of requested paths, cleared whenever the navmesh or the search changes
+    NavMeshPathCache& GetPathCache() { return _pathCache; }
+    const NavMeshPathCache& GetPathCache() const { return _pathCache; }
+
+    // Searches coarse to fine over the clusters of the navmesh, see NavMeshQuery::FindHierarchicalCorridor. On by default.
+    // Only applies to FindPath without a query of its own, and to requested paths.
+    void SetHierarchicalSearch(bool hierarchical);
+    bool GetHierarchicalSearch() const { return _query.IsHierarchical(); }
+
+    // Flow fields lead any amount of agents towards a shared target, like the player, for the cost of a single search.
+    // They are built right away and refreshed during Tick, when their target moves to another triangle or they get too old.
+    FlowFieldHandle CreateFlowField(glm::vec3 target);
+    void DestroyFlowField(FlowFieldHandle handle) { _flowFields.erase(handle.id); }
+    void SetFlowFieldTarget(FlowFieldHandle handle, glm::vec3 target);
+
+    // Normalized horizontal direction to walk in from the position, zero when the target can't be reached or the handle is invalid
+    glm::vec3 SampleFlowField(FlowFieldHandle handle, glm::vec3 position) const;
+
+    // Returns nullptr when the handle is invalid
+    const NavMeshFlowField* GetFlowField(FlowFieldHandle handle) const;
+
+    void SetFlowFieldRefreshInterval(DeltaMS interval);
+    DeltaMS GetFlowFieldRefreshInterval() const { return _flowFieldRefreshInterval; }
 
     bool SetDebugDrawState(bool state) { return _debugDraw = state; }
     bool GetDebugDrawState() const { return _debugDraw; }
@@ -101,35 +111,32 @@ public:
     const std::vector<glm::vec3>& GetDebugLines() const { return _debugLines; }
 
 private:
-    float Heuristic(glm::vec3 startPos, glm::vec3 endPos);
-    float DirectedHeuristic(glm::vec3 startPos, glm::vec3 endPos, glm::vec3 finalPosition);
-    ComputedPath ReconstructPath(const uint32_t finalTriangleIndex, std::unordered_map<uint32_t, TriangleNode>& nodes);
+    static ComputedPath ToComputedPath(const std::vector<glm::vec3>& points);
+    void AddDebugPath(const ComputedPath& path);
 
-    struct TriangleInfo
+    NavMesh _navMesh {};
+    NavMeshQuery _query {};
+    std::vector<uint32_t> _corridor {};
+    std::vector<glm::vec3> _points {};
+    NavMeshPathCache _pathCache {};
+
+    ThreadPool* _threadPool = nullptr;
+    PathQueryService _queryService {};
+    CrowdAvoidance _crowdAvoidance {};
+
+    struct FlowFieldEntry
     {
-        uint32_t indices[3] = {
-            std::numeric_limits<uint32_t>::max(),
-            std::numeric_limits<uint32_t>::max(),
-            std::numeric_limits<uint32_t>::max()
-        };
-
-        glm::vec3 centre = glm::vec3 { 0.0f };
-
-        uint32_t adjacentTriangleIndices[3] = {
-            std::numeric_limits<uint32_t>::max(),
-            std::numeric_limits<uint32_t>::max(),
-            std::numeric_limits<uint32_t>::max()
-        };
-        uint8_t adjacentTriangleCount = 0;
+        NavMeshFlowField field {};
+        glm::vec3 target { 0.0f };
     };
 
-    std::vector<TriangleInfo> _triangles;
-    std::unordered_map<uint32_t, uint32_t[3]> _trianglesToNeighbours;
-    glm::mat4 _inverseTransform = glm::mat4(1.0f);
-
-    CPUMesh<Vertex> _mesh = {};
+    uint32_t _nextFlowFieldID = 1;
+    DeltaMS _flowFieldRefreshInterval { 1000.0f };
+    std::unordered_map<uint32_t, FlowFieldEntry> _flowFields {};
 
     bool _debugDraw = false;
     std::vector<glm::vec3> _debugLines;
-    std::vector<ComputedPath> _computedPaths;
+
+    // Paths found since the debug lines were last rebuilt
+    std::vector<ComputedPath> _debugPaths;
 };
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "common.hpp"
+#include "system_interface.hpp"
+
+#include <entt/entity/fwd.hpp>
+
+class CrowdAvoidance;
+class PathfindingModule;
+class PathQueryService;
+class ThreadPool;
+
+// Moves all nav agents along their paths in a single pass: picks up finished searches, advances waypoints,
+// updates the steering direction and arrival, and submits new searches to the query service when a path is due.
+// A second pass then adjusts the velocities of all agents at once, so they avoid each other.
+class NavAgentSystem final : public SystemInterface
+{
+public:
+    explicit NavAgentSystem(PathfindingModule& pathfindingModule);
+    ~NavAgentSystem() override = default;
+    NON_COPYABLE(NavAgentSystem);
+    NON_MOVABLE(NavAgentSystem);
+
+    void Update(ECSModule& ecs, float dt) override;
+    void Render(MAYBE_UNUSED const ECSModule& ecs) const override { }
+    void Inspect() override;
+
+    std::string_view GetName() override { return "NavAgentSystem"; }
+
+    // Delta time is in milliseconds. Agents are positioned at the world position of their entity,
+    // submitted searches are run by the next updates of the query service.
+    static void UpdateAgents(entt::registry& registry, PathQueryService& queryService, float deltaTime);
+
+    // Delta time is in milliseconds. Turns the preferred velocities of the agents into velocities that avoid each other,
+    // spread over the thread pool when there are enough agents.
+    static void AvoidAgents(entt::registry& registry, CrowdAvoidance& avoidance, ThreadPool* threadPool, float deltaTime);
+
+private:
+    PathfindingModule& _pathfindingModule;
+    uint32_t _agentCount = 0;
+    uint32_t _searchingCount = 0;
+    uint32_t _followingCount = 0;
+    uint32_t _arrivedCount = 0;
+    uint32_t _unreachableCount = 0;
+};
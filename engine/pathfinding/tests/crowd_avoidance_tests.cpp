@@ -0,0 +1,199 @@
+#include "crowd_avoidance.hpp"
+#include "thread_pool.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/trigonometric.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+
+namespace
+{
+
+constexpr float DELTA_TIME = 1.0f / 60.0f;
+constexpr float RADIUS = 0.5f;
+constexpr float MAX_SPEED = 2.0f;
+
+struct SimulatedAgent
+{
+    glm::vec3 position { 0.0f };
+    glm::vec3 goal { 0.0f };
+    glm::vec3 velocity { 0.0f };
+};
+
+struct SimulationResult
+{
+    // Smallest distance between two agents, relative to their combined radius
+    float closestApproach = std::numeric_limits<float>::max();
+    float furthestFromGoal = 0.0f;
+};
+
+// Walks the agents straight to their goal, avoiding each other, and keeps track of how close they got to each other
+SimulationResult Simulate(std::vector<SimulatedAgent>& agents, float seconds, ThreadPool* threadPool = nullptr)
+{
+    CrowdAvoidance avoidance {};
+    SimulationResult result {};
+
+    for (float time = 0.0f; time < seconds; time += DELTA_TIME)
+    {
+        avoidance.Clear();
+
+        for (const SimulatedAgent& agent : agents)
+        {
+            glm::vec3 toGoal = agent.goal - agent.position;
+            float distance = glm::length(toGoal);
+
+            // Slows down right before the goal, instead of overshooting it
+            CrowdAvoidance::Agent crowdAgent {};
+            crowdAgent.position = agent.position;
+            crowdAgent.velocity = agent.velocity;
+            crowdAgent.preferredVelocity = distance > 0.0001f ? toGoal / distance * glm::min(MAX_SPEED, distance / DELTA_TIME) : glm::vec3 { 0.0f };
+            crowdAgent.radius = RADIUS;
+            crowdAgent.maxSpeed = MAX_SPEED;
+
+            avoidance.AddAgent(crowdAgent);
+        }
+
+        avoidance.ComputeVelocities(DELTA_TIME, threadPool);
+
+        for (uint32_t i = 0; i < agents.size(); ++i)
+        {
+            agents[i].velocity = avoidance.GetVelocity(i);
+            agents[i].position += agents[i].velocity * DELTA_TIME;
+        }
+
+        for (uint32_t i = 0; i < agents.size(); ++i)
+            for (uint32_t j = i + 1; j < agents.size(); ++j)
+                result.closestApproach = glm::min(result.closestApproach, glm::distance(agents[i].position, agents[j].position) / (RADIUS * 2.0f));
+    }
+
+    for (const SimulatedAgent& agent : agents)
+        result.furthestFromGoal = glm::max(result.furthestFromGoal, glm::distance(agent.position, agent.goal));
+
+    return result;
+}
+
+std::vector<SimulatedAgent> MakeCircle(uint32_t count, float radius)
+{
+    std::vector<SimulatedAgent> agents {};
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(count);
+        glm::vec3 position { glm::cos(angle) * radius, 0.0f, glm::sin(angle) * radius };
+        agents.push_back({ position, -position });
+    }
+
+    return agents;
+}
+
+}
+
+TEST(CrowdAvoidanceTests, LoneAgentKeepsPreferredVelocity)
+{
+    // Arrange
+    CrowdAvoidance avoidance {};
+    CrowdAvoidance::Agent agent {};
+    agent.preferredVelocity = glm::vec3 { 1.0f, 0.0f, 2.0f };
+    agent.maxSpeed = 5.0f;
+
+    CrowdAvoidance::Agent fast = agent;
+    fast.preferredVelocity = glm::vec3 { 10.0f, 0.0f, 0.0f };
+
+    avoidance.AddAgent(agent);
+    fast.position = glm::vec3 { 100.0f, 0.0f, 0.0f };
+    avoidance.AddAgent(fast);
+
+    // Act
+    avoidance.ComputeVelocities(DELTA_TIME, nullptr);
+
+    // Assert
+    EXPECT_EQ(avoidance.GetVelocity(0), agent.preferredVelocity);
+    EXPECT_FLOAT_EQ(avoidance.GetVelocity(1).x, fast.maxSpeed);
+}
+
+TEST(CrowdAvoidanceTests, HeadOnAgentsPassWithoutOverlap)
+{
+    // Arrange
+    std::vector<SimulatedAgent> agents {
+        { glm::vec3 { -5.0f, 0.0f, 0.0f }, glm::vec3 { 5.0f, 0.0f, 0.0f } },
+        { glm::vec3 { 5.0f, 0.0f, 0.0f }, glm::vec3 { -5.0f, 0.0f, 0.0f } },
+    };
+
+    // Act
+    SimulationResult result = Simulate(agents, 10.0f);
+
+    // Assert
+    EXPECT_GE(result.closestApproach, 0.99f);
+    EXPECT_LT(result.furthestFromGoal, 0.1f);
+}
+
+TEST(CrowdAvoidanceTests, CircleSwapWithoutOverlap)
+{
+    // Arrange
+    std::vector<SimulatedAgent> agents = MakeCircle(24, 8.0f);
+
+    // Act
+    SimulationResult result = Simulate(agents, 40.0f);
+
+    // Assert
+    EXPECT_GE(result.closestApproach, 0.99f);
+    EXPECT_LT(result.furthestFromGoal, 0.1f);
+}
+
+TEST(CrowdAvoidanceTests, GroupsCrossWithoutOverlap)
+{
+    // Arrange, two blocks of 25 agents walking through each other
+    std::vector<SimulatedAgent> agents {};
+
+    for (uint32_t x = 0; x < 5; ++x)
+    {
+        for (uint32_t z = 0; z < 5; ++z)
+        {
+            glm::vec3 offset { static_cast<float>(x) * 1.5f, 0.0f, static_cast<float>(z) * 1.5f - 3.0f };
+            agents.push_back({ glm::vec3 { -12.0f, 0.0f, 0.0f } + offset, glm::vec3 { 6.0f, 0.0f, 0.0f } + offset });
+            agents.push_back({ glm::vec3 { 6.0f, 0.0f, 0.0f } + offset, glm::vec3 { -12.0f, 0.0f, 0.0f } + offset });
+        }
+    }
+
+    // Act
+    SimulationResult result = Simulate(agents, 30.0f);
+
+    // Assert
+    EXPECT_GE(result.closestApproach, 0.99f);
+    EXPECT_LT(result.furthestFromGoal, 0.1f);
+}
+
+TEST(CrowdAvoidanceTests, IgnoresAgentsOnOtherFloors)
+{
+    // Arrange
+    std::vector<SimulatedAgent> agents {
+        { glm::vec3 { -5.0f, 0.0f, 0.0f }, glm::vec3 { 5.0f, 0.0f, 0.0f } },
+        { glm::vec3 { 5.0f, 4.0f, 0.0f }, glm::vec3 { -5.0f, 4.0f, 0.0f } },
+    };
+
+    // Act
+    Simulate(agents, 2.5f);
+
+    // Assert, they walk straight through each other
+    EXPECT_FLOAT_EQ(agents[0].position.z, 0.0f);
+    EXPECT_FLOAT_EQ(agents[1].position.z, 0.0f);
+}
+
+TEST(CrowdAvoidanceTests, ThreadPoolGivesSameVelocities)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    std::vector<SimulatedAgent> singleThreaded = MakeCircle(600, 60.0f);
+    std::vector<SimulatedAgent> multiThreaded = singleThreaded;
+
+    // Act
+    Simulate(singleThreaded, 1.0f);
+    Simulate(multiThreaded, 1.0f, &threadPool);
+
+    // Assert
+    for (uint32_t i = 0; i < singleThreaded.size(); ++i)
+        ASSERT_EQ(singleThreaded[i].position, multiThreaded[i].position);
+}
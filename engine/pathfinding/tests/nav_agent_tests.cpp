@@ -0,0 +1,282 @@
+#include "components/nav_agent_component.hpp"
+#include "components/transform_component.hpp"
+#include "components/transform_helpers.hpp"
+#include "crowd_avoidance.hpp"
+#include "navmesh.hpp"
+#include "navmesh_test_helpers.hpp"
+#include "path_query_service.hpp"
+#include "systems/nav_agent_system.hpp"
+
+#include <entt/entity/registry.hpp>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+// Grid of 20 by 20 with a wall along x = 0 that is open at the top when requested, paths around it have corners
+NavMesh MakeWallNavMesh(bool open)
+{
+    return MakeGridNavMesh(20, 20, 1.0f, 0.0f, [open](uint32_t x, uint32_t z)
+        { return x != 10 || (open && z == 19); });
+}
+
+}
+
+class NavAgentTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        TransformHelpers::SubscribeToEvents(_registry);
+        NavAgentComponent::SetupRegistryCallbacks(_registry, _service);
+    }
+
+    void TearDown() override
+    {
+        NavAgentComponent::DisconnectRegistryCallbacks(_registry, _service);
+        TransformHelpers::UnsubscribeToEvents(_registry);
+    }
+
+    entt::entity SpawnAgent(const glm::vec3& position, const NavAgentSettings& settings = {})
+    {
+        entt::entity entity = _registry.create();
+        _registry.emplace<TransformComponent>(entity);
+        TransformHelpers::SetLocalPosition(_registry, entity, position);
+        _registry.emplace<NavAgentComponent>(entity, settings);
+        return entity;
+    }
+
+    // Updates the agents like the ECS does, then runs the searches they submitted like the pathfinding module does
+    void Step(float deltaTime)
+    {
+        NavAgentSystem::UpdateAgents(_registry, _service, deltaTime);
+
+        do
+        {
+            _service.Update(_navMesh, nullptr);
+        } while (_service.GetPendingCount() > 0 || _service.GetRunningCount() > 0);
+    }
+
+    // Walks the agent in its steering direction
+    void Walk(entt::entity entity, float distance)
+    {
+        glm::vec3 position = TransformHelpers::GetWorldPosition(_registry, entity);
+        TransformHelpers::SetLocalPosition(_registry, entity, position + Get(entity).GetDirection() * distance);
+    }
+
+    NavAgentComponent& Get(entt::entity entity) { return _registry.get<NavAgentComponent>(entity); }
+
+    NavMesh _navMesh = MakeWallNavMesh(true);
+    PathQueryService _service {};
+    entt::registry _registry {};
+};
+
+TEST_F(NavAgentTests, FollowsPathAroundWallUntilArrived)
+{
+    // Arrange
+    NavAgentSettings settings {};
+    settings.repathInterval = 1000000.0f;
+
+    entt::entity entity = SpawnAgent(glm::vec3 { -5.5f, 0.0f, -5.5f }, settings);
+    NavAgentComponent& agent = Get(entity);
+    agent.SetTarget(glm::vec3 { 5.5f, 0.0f, -5.5f });
+
+    Step(16.0f);
+    Step(16.0f);
+    ASSERT_EQ(agent.GetState(), NavAgentState::eFOLLOWING);
+
+    // Act
+    uint32_t previousWaypoint = agent.GetCurrentWaypoint();
+    bool waypointsOnlyAdvance = true;
+    uint32_t steps = 0;
+
+    while (!agent.HasArrived() && steps++ < 1000)
+    {
+        Walk(entity, 0.1f);
+        Step(16.0f);
+
+        waypointsOnlyAdvance &= agent.GetCurrentWaypoint() >= previousWaypoint;
+        previousWaypoint = agent.GetCurrentWaypoint();
+    }
+
+    // Assert
+    const glm::vec3 position = TransformHelpers::GetWorldPosition(_registry, entity);
+
+    EXPECT_TRUE(agent.HasArrived());
+    EXPECT_TRUE(waypointsOnlyAdvance);
+    EXPECT_EQ(agent.GetCurrentWaypoint(), agent.GetPath().size() - 1);
+    EXPECT_EQ(agent.GetDirection(), glm::vec3 { 0.0f });
+    EXPECT_LE(glm::distance(position, agent.GetTarget()), agent.settings.arrivalDistance + 0.1f);
+
+    // The wall is only open at the top, so the agent had to walk around it
+    EXPECT_GT(agent.GetPath().size(), 2u);
+}
+
+TEST_F(NavAgentTests, AdvancesWaypointWithinRadius)
+{
+    // Arrange
+    NavAgentSettings settings {};
+    settings.waypointRadius = 0.5f;
+
+    entt::entity entity = SpawnAgent(glm::vec3 { -5.5f, 0.0f, -5.5f }, settings);
+    NavAgentComponent& agent = Get(entity);
+    agent.SetTarget(glm::vec3 { 5.5f, 0.0f, -5.5f });
+
+    Step(16.0f);
+    Step(16.0f);
+    ASSERT_GT(agent.GetPath().size(), 2u);
+    ASSERT_EQ(agent.GetCurrentWaypoint(), 1u);
+
+    // Act
+    TransformHelpers::SetLocalPosition(_registry, entity, agent.GetPath()[1] + glm::vec3 { 0.6f, 0.0f, 0.0f });
+    Step(16.0f);
+    uint32_t outsideRadius = agent.GetCurrentWaypoint();
+
+    TransformHelpers::SetLocalPosition(_registry, entity, agent.GetPath()[1] + glm::vec3 { 0.4f, 0.0f, 0.0f });
+    Step(16.0f);
+    uint32_t withinRadius = agent.GetCurrentWaypoint();
+
+    // Assert
+    EXPECT_EQ(outsideRadius, 1u);
+    EXPECT_EQ(withinRadius, 2u);
+    EXPECT_EQ(agent.GetState(), NavAgentState::eFOLLOWING);
+}
+
+TEST_F(NavAgentTests, RepathsOnInterval)
+{
+    // Arrange
+    NavAgentSettings settings {};
+    settings.repathInterval = 1000.0f;
+
+    entt::entity entity = SpawnAgent(glm::vec3 { -5.5f, 0.0f, -5.5f }, settings);
+    NavAgentComponent& agent = Get(entity);
+    agent.SetTarget(glm::vec3 { 5.5f, 0.0f, -5.5f });
+    Step(16.0f);
+
+    // Act
+    NavAgentSystem::UpdateAgents(_registry, _service, 500.0f);
+    uint32_t pendingBeforeInterval = _service.GetPendingCount();
+
+    NavAgentSystem::UpdateAgents(_registry, _service, 500.0f);
+    uint32_t pendingAfterInterval = _service.GetPendingCount();
+
+    // Assert
+    EXPECT_EQ(pendingBeforeInterval, 0u);
+    EXPECT_EQ(pendingAfterInterval, 1u);
+
+    // Keeps following the previous path while the new one is searched
+    EXPECT_EQ(agent.GetState(), NavAgentState::eFOLLOWING);
+    EXPECT_NE(agent.GetDirection(), glm::vec3 { 0.0f });
+}
+
+TEST_F(NavAgentTests, RepathsWhenTargetMoves)
+{
+    // Arrange
+    NavAgentSettings settings {};
+    settings.repathDistance = 2.0f;
+
+    entt::entity entity = SpawnAgent(glm::vec3 { -5.5f, 0.0f, -5.5f }, settings);
+    NavAgentComponent& agent = Get(entity);
+    agent.SetTarget(glm::vec3 { 5.5f, 0.0f, -5.5f });
+    Step(16.0f);
+    Step(16.0f);
+
+    // Act
+    agent.SetTarget(glm::vec3 { 5.5f, 0.0f, -4.5f });
+    NavAgentSystem::UpdateAgents(_registry, _service, 16.0f);
+    uint32_t pendingAfterSmallMove = _service.GetPendingCount();
+
+    agent.SetTarget(glm::vec3 { 5.5f, 0.0f, 5.5f });
+    NavAgentSystem::UpdateAgents(_registry, _service, 16.0f);
+    uint32_t pendingAfterLargeMove = _service.GetPendingCount();
+
+    Step(16.0f);
+    Step(16.0f);
+
+    // Assert
+    EXPECT_EQ(pendingAfterSmallMove, 0u);
+    EXPECT_EQ(pendingAfterLargeMove, 1u);
+    EXPECT_LE(glm::distance(agent.GetPath().back(), agent.GetTarget()), 0.01f);
+}
+
+TEST_F(NavAgentTests, UnreachableTarget)
+{
+    // Arrange
+    _navMesh = MakeWallNavMesh(false);
+
+    entt::entity entity = SpawnAgent(glm::vec3 { -5.5f, 0.0f, -5.5f });
+    NavAgentComponent& agent = Get(entity);
+    agent.SetTarget(glm::vec3 { 5.5f, 0.0f, -5.5f });
+
+    // Act
+    Step(16.0f);
+    Step(16.0f);
+
+    // Assert
+    EXPECT_EQ(agent.GetState(), NavAgentState::eUNREACHABLE);
+    EXPECT_TRUE(agent.GetPath().empty());
+    EXPECT_EQ(agent.GetDirection(), glm::vec3 { 0.0f });
+}
+
+TEST_F(NavAgentTests, StopCancelsSearch)
+{
+    // Arrange
+    entt::entity entity = SpawnAgent(glm::vec3 { -5.5f, 0.0f, -5.5f });
+    NavAgentComponent& agent = Get(entity);
+    agent.SetTarget(glm::vec3 { 5.5f, 0.0f, -5.5f });
+    NavAgentSystem::UpdateAgents(_registry, _service, 16.0f);
+    ASSERT_EQ(_service.GetPendingCount(), 1u);
+
+    // Act
+    agent.Stop();
+    Step(16.0f);
+
+    // Assert
+    EXPECT_EQ(_service.GetExpansionsLastUpdate(), 0u);
+    EXPECT_EQ(agent.GetState(), NavAgentState::eIDLE);
+    EXPECT_TRUE(agent.GetPath().empty());
+    EXPECT_EQ(agent.GetDirection(), glm::vec3 { 0.0f });
+}
+
+TEST_F(NavAgentTests, DestroyingAgentCancelsSearch)
+{
+    // Arrange
+    entt::entity removed = SpawnAgent(glm::vec3 { -5.5f, 0.0f, -5.5f });
+    entt::entity destroyed = SpawnAgent(glm::vec3 { -5.5f, 0.0f, 5.5f });
+    Get(removed).SetTarget(glm::vec3 { 5.5f, 0.0f, -5.5f });
+    Get(destroyed).SetTarget(glm::vec3 { 5.5f, 0.0f, 5.5f });
+    NavAgentSystem::UpdateAgents(_registry, _service, 16.0f);
+    ASSERT_EQ(_service.GetPendingCount(), 2u);
+
+    // Act
+    _registry.remove<NavAgentComponent>(removed);
+    _registry.destroy(destroyed);
+    _service.Update(_navMesh, nullptr);
+
+    // Assert
+    EXPECT_EQ(_service.GetPendingCount(), 0u);
+    EXPECT_EQ(_service.GetRunningCount(), 0u);
+    EXPECT_EQ(_service.GetExpansionsLastUpdate(), 0u);
+}
+
+TEST_F(NavAgentTests, AvoidsOtherAgents)
+{
+    // Arrange, two agents walking straight at each other
+    NavAgentComponent& left = Get(SpawnAgent(glm::vec3 { -1.5f, 0.0f, 0.0f }));
+    NavAgentComponent& right = Get(SpawnAgent(glm::vec3 { 1.5f, 0.0f, 0.0f }));
+    NavAgentComponent& alone = Get(SpawnAgent(glm::vec3 { 0.0f, 0.0f, 50.0f }));
+    left.SetPreferredVelocity(glm::vec3 { 5.0f, 0.0f, 0.0f });
+    right.SetPreferredVelocity(glm::vec3 { -5.0f, 0.0f, 0.0f });
+    alone.SetPreferredVelocity(glm::vec3 { 5.0f, 0.0f, 0.0f });
+
+    CrowdAvoidance avoidance {};
+
+    // Act
+    NavAgentSystem::AvoidAgents(_registry, avoidance, nullptr, 16.0f);
+
+    // Assert
+    EXPECT_LT(left.GetVelocity().x, 5.0f);
+    EXPECT_GT(right.GetVelocity().x, -5.0f);
+    EXPECT_NE(left.GetVelocity().z, 0.0f);
+    EXPECT_EQ(alone.GetVelocity(), alone.GetPreferredVelocity());
+}
@@ -0,0 +1,241 @@
+#include "file_io.hpp"
+#include "navmesh.hpp"
+#include "navmesh_bake.hpp"
+#include "navmesh_query.hpp"
+#include "navmesh_test_helpers.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace
+{
+
+constexpr NavMeshBake::Key SOURCE_KEY = 0x1234;
+
+void ExpectSameNavMesh(const NavMesh& expected, const NavMesh& actual)
+{
+    EXPECT_EQ(expected.GetVertices(), actual.GetVertices());
+    EXPECT_EQ(expected.GetIndices(), actual.GetIndices());
+    ASSERT_EQ(expected.GetTriangleCount(), actual.GetTriangleCount());
+
+    for (uint32_t i = 0; i < expected.GetTriangleCount(); ++i)
+    {
+        const NavMesh::Triangle& a = expected.GetTriangle(i);
+        const NavMesh::Triangle& b = actual.GetTriangle(i);
+
+        EXPECT_EQ(a.centre, b.centre);
+        ASSERT_EQ(a.adjacentTriangleCount, b.adjacentTriangleCount);
+
+        for (uint32_t j = 0; j < 3; ++j)
+            EXPECT_EQ(a.indices[j], b.indices[j]);
+
+        for (uint32_t j = 0; j < a.adjacentTriangleCount; ++j)
+            EXPECT_EQ(a.adjacentTriangleIndices[j], b.adjacentTriangleIndices[j]);
+    }
+
+    EXPECT_EQ(expected.GetSpatialIndex().GetCellCount(), actual.GetSpatialIndex().GetCellCount());
+    EXPECT_EQ(expected.GetSpatialIndex().GetCellSize(), actual.GetSpatialIndex().GetCellSize());
+
+    const NavMeshHierarchy& expectedHierarchy = expected.GetHierarchy();
+    const NavMeshHierarchy& actualHierarchy = actual.GetHierarchy();
+
+    EXPECT_EQ(expectedHierarchy.GetClusterSize(), actualHierarchy.GetClusterSize());
+    EXPECT_EQ(expectedHierarchy.GetTriangleClusters(), actualHierarchy.GetTriangleClusters());
+    EXPECT_EQ(expectedHierarchy.GetClusterTriangles(), actualHierarchy.GetClusterTriangles());
+    ASSERT_EQ(expectedHierarchy.GetClusterCount(), actualHierarchy.GetClusterCount());
+    ASSERT_EQ(expectedHierarchy.GetNodeCount(), actualHierarchy.GetNodeCount());
+    ASSERT_EQ(expectedHierarchy.GetEdges().size(), actualHierarchy.GetEdges().size());
+
+    for (uint32_t i = 0; i < expectedHierarchy.GetClusterCount(); ++i)
+    {
+        EXPECT_EQ(expectedHierarchy.GetCluster(i).firstTriangle, actualHierarchy.GetCluster(i).firstTriangle);
+        EXPECT_EQ(expectedHierarchy.GetCluster(i).triangleCount, actualHierarchy.GetCluster(i).triangleCount);
+        EXPECT_EQ(expectedHierarchy.GetCluster(i).firstNode, actualHierarchy.GetCluster(i).firstNode);
+        EXPECT_EQ(expectedHierarchy.GetCluster(i).nodeCount, actualHierarchy.GetCluster(i).nodeCount);
+    }
+
+    for (uint32_t i = 0; i < expectedHierarchy.GetNodeCount(); ++i)
+    {
+        EXPECT_EQ(expectedHierarchy.GetNode(i).triangle, actualHierarchy.GetNode(i).triangle);
+        EXPECT_EQ(expectedHierarchy.GetNode(i).cluster, actualHierarchy.GetNode(i).cluster);
+        EXPECT_EQ(expectedHierarchy.GetNode(i).firstEdge, actualHierarchy.GetNode(i).firstEdge);
+        EXPECT_EQ(expectedHierarchy.GetNode(i).edgeCount, actualHierarchy.GetNode(i).edgeCount);
+    }
+
+    for (size_t i = 0; i < expectedHierarchy.GetEdges().size(); ++i)
+    {
+        EXPECT_EQ(expectedHierarchy.GetEdges()[i].node, actualHierarchy.GetEdges()[i].node);
+        EXPECT_EQ(expectedHierarchy.GetEdges()[i].cost, actualHierarchy.GetEdges()[i].cost);
+    }
+
+    for (uint32_t i = 0; i < expected.GetTriangleCount(); ++i)
+        EXPECT_EQ(expectedHierarchy.GetTriangleNode(i), actualHierarchy.GetTriangleNode(i));
+}
+
+}
+
+class NavMeshBakeTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _directory = std::filesystem::temp_directory_path() / "bb_navmesh_bake_tests";
+        std::filesystem::remove_all(_directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(_directory);
+    }
+
+    std::filesystem::path _directory;
+};
+
+TEST_F(NavMeshBakeTests, RoundTripMatchesBuiltNavMesh)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(40, 40, 0.25f, 5);
+
+    // Act
+    std::vector<std::byte> bytes = NavMeshBake::Serialize(navMesh, SOURCE_KEY);
+    std::optional<NavMesh> baked = NavMeshBake::Deserialize(bytes, SOURCE_KEY);
+
+    // Assert
+    ASSERT_TRUE(baked.has_value());
+    ExpectSameNavMesh(navMesh, baked.value());
+}
+
+TEST_F(NavMeshBakeTests, RoundTripEmptyNavMesh)
+{
+    // Arrange
+    NavMesh navMesh {};
+
+    // Act
+    std::optional<NavMesh> baked = NavMeshBake::Deserialize(NavMeshBake::Serialize(navMesh, SOURCE_KEY), SOURCE_KEY);
+
+    // Assert
+    ASSERT_TRUE(baked.has_value());
+    EXPECT_TRUE(baked->IsEmpty());
+    EXPECT_TRUE(baked->GetHierarchy().IsEmpty());
+    EXPECT_EQ(baked->FindClosestTriangle(glm::vec3 { 0.0f }), NavMesh::INVALID_TRIANGLE);
+}
+
+TEST_F(NavMeshBakeTests, BakedNavMeshAnswersQueriesTheSame)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(40, 40, 0.25f, 6);
+    NavMesh baked = NavMeshBake::Deserialize(NavMeshBake::Serialize(navMesh, SOURCE_KEY), SOURCE_KEY).value();
+
+    NavMeshQuery query {};
+    std::vector<uint32_t> expectedCorridor {};
+    std::vector<uint32_t> actualCorridor {};
+
+    std::mt19937 random { 6 };
+    std::uniform_real_distribution<float> position { -22.0f, 22.0f };
+
+    // Act & Assert
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        glm::vec3 start { position(random), 0.5f, position(random) };
+        glm::vec3 goal { position(random), 0.5f, position(random) };
+
+        uint32_t startTriangle = navMesh.FindClosestTriangle(start);
+        uint32_t goalTriangle = navMesh.FindClosestTriangle(goal);
+        ASSERT_EQ(startTriangle, baked.FindClosestTriangle(start));
+        ASSERT_EQ(goalTriangle, baked.FindClosestTriangle(goal));
+
+        bool expectedFound = query.FindHierarchicalCorridor(navMesh, startTriangle, goalTriangle, expectedCorridor);
+        bool actualFound = query.FindHierarchicalCorridor(baked, startTriangle, goalTriangle, actualCorridor);
+
+        ASSERT_EQ(expectedFound, actualFound);
+        EXPECT_EQ(expectedCorridor, actualCorridor);
+    }
+}
+
+TEST_F(NavMeshBakeTests, RejectsOtherSourceKey)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(4, 4);
+    std::vector<std::byte> bytes = NavMeshBake::Serialize(navMesh, SOURCE_KEY);
+
+    // Act & Assert
+    EXPECT_FALSE(NavMeshBake::Deserialize(bytes, SOURCE_KEY + 1).has_value());
+}
+
+TEST_F(NavMeshBakeTests, RejectsCorruptBake)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(8, 8);
+    std::vector<std::byte> bytes = NavMeshBake::Serialize(navMesh, SOURCE_KEY);
+
+    std::vector<std::byte> truncated { bytes.begin(), bytes.end() - 1 };
+    std::vector<std::byte> overlong = bytes;
+    overlong.push_back(std::byte { 0 });
+
+    // The bake ends with the triangles sorted by cluster, point the last one outside of the navmesh
+    std::vector<std::byte> badTriangle = bytes;
+    uint32_t outOfRange = navMesh.GetTriangleCount();
+    std::memcpy(badTriangle.data() + badTriangle.size() - sizeof(outOfRange), &outOfRange, sizeof(outOfRange));
+
+    // Act & Assert
+    EXPECT_FALSE(NavMeshBake::Deserialize(truncated, SOURCE_KEY).has_value());
+    EXPECT_FALSE(NavMeshBake::Deserialize(overlong, SOURCE_KEY).has_value());
+    EXPECT_FALSE(NavMeshBake::Deserialize(badTriangle, SOURCE_KEY).has_value());
+    EXPECT_FALSE(NavMeshBake::Deserialize({}, SOURCE_KEY).has_value());
+}
+
+TEST_F(NavMeshBakeTests, SaveThenLoad)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(20, 20, 0.2f, 7);
+    std::filesystem::path path = NavMeshBake::GetBakedPath("assets/models/navmesh.glb", _directory);
+
+    // Act
+    bool saved = NavMeshBake::Save(navMesh, path, SOURCE_KEY);
+    std::optional<NavMesh> loaded = NavMeshBake::Load(path, SOURCE_KEY);
+
+    // Assert
+    ASSERT_TRUE(saved);
+    ASSERT_TRUE(loaded.has_value());
+    ExpectSameNavMesh(navMesh, loaded.value());
+    EXPECT_FALSE(NavMeshBake::Load(_directory / "missing.navmesh", SOURCE_KEY).has_value());
+}
+
+TEST_F(NavMeshBakeTests, SourceKeyFollowsFileChanges)
+{
+    // Arrange, sources are found through the virtual filesystem, like the assets of the game
+    const std::filesystem::path directory = "cache/tests/navmesh_bake";
+    const std::string source = (directory / "navmesh.glb").generic_string();
+
+    fileIO::Init(true);
+    std::filesystem::create_directories(directory);
+
+    {
+        std::ofstream file { source, std::ios::binary };
+        file << "navmesh";
+    }
+
+    // Act
+    std::optional<NavMeshBake::Key> first = NavMeshBake::MakeSourceKey(source);
+    std::optional<NavMeshBake::Key> unchanged = NavMeshBake::MakeSourceKey(source);
+
+    {
+        std::ofstream file { source, std::ios::binary | std::ios::app };
+        file << " with more triangles";
+    }
+
+    std::optional<NavMeshBake::Key> changed = NavMeshBake::MakeSourceKey(source);
+    std::optional<NavMeshBake::Key> missing = NavMeshBake::MakeSourceKey((directory / "missing.glb").generic_string());
+
+    std::filesystem::remove_all(directory);
+    fileIO::Deinit();
+
+    // Assert
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first, unchanged);
+    EXPECT_NE(first, changed);
+    EXPECT_FALSE(missing.has_value());
+}
@@ -0,0 +1,506 @@
+#include "components/nav_agent_component.hpp"
+#include "components/transform_component.hpp"
+#include "components/transform_helpers.hpp"
+#include "crowd_avoidance.hpp"
+#include "log.hpp"
+#include "navmesh.hpp"
+#include "navmesh_bake.hpp"
+#include "navmesh_flow_field.hpp"
+#include "navmesh_path_cache.hpp"
+#include "navmesh_query.hpp"
+#include "navmesh_test_helpers.hpp"
+#include "path_query_service.hpp"
+#include "systems/nav_agent_system.hpp"
+#include "thread_pool.hpp"
+#include "timers.hpp"
+
+#include <cmath>
+#include <entt/entity/registry.hpp>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+
+// Cost of the navmesh queries used for pathfinding, on navmeshes of different sizes.
+// They are disabled so they don't slow down every test run, run only these with --gtest_also_run_disabled_tests --gtest_filter=PathfindingBenchmarks.*
+
+namespace
+{
+
+struct LookupReport
+{
+    float buildTime = 0.0f;
+    float indexedTime = 0.0f;
+    float bruteForceTime = 0.0f;
+};
+
+LookupReport BenchmarkLookups(uint32_t gridSize, uint32_t queryCount, uint32_t bruteForceQueryCount)
+{
+    LookupReport report {};
+
+    Stopwatch buildStopwatch {};
+    NavMesh navMesh = MakeGridNavMesh(gridSize, gridSize, 1.0f, 1.0f);
+    report.buildTime = buildStopwatch.GetElapsed().count();
+
+    std::mt19937 random { gridSize };
+    float extent = static_cast<float>(gridSize) * 0.5f;
+    std::uniform_real_distribution<float> horizontal { -extent, extent };
+    std::uniform_real_distribution<float> vertical { -1.0f, 2.0f };
+
+    std::vector<glm::vec3> points {};
+    for (uint32_t i = 0; i < queryCount; ++i)
+        points.emplace_back(horizontal(random), vertical(random), horizontal(random));
+
+    uint32_t checksum = 0;
+
+    Stopwatch indexedStopwatch {};
+    for (const auto& point : points)
+        checksum += navMesh.FindClosestTriangle(point);
+    report.indexedTime = indexedStopwatch.GetElapsed().count() / static_cast<float>(queryCount);
+
+    Stopwatch bruteForceStopwatch {};
+    for (uint32_t i = 0; i < bruteForceQueryCount; ++i)
+        checksum -= navMesh.FindClosestTriangleBruteForce(points[i]);
+    report.bruteForceTime = bruteForceStopwatch.GetElapsed().count() / static_cast<float>(bruteForceQueryCount);
+
+    bblog::info("[PathfindingBenchmarks] {} triangles: build {:.2f}ms, indexed lookup {:.5f}ms, brute force lookup {:.5f}ms, {:.0f}x faster (checksum {})",
+        navMesh.GetTriangleCount(), report.buildTime, report.indexedTime, report.bruteForceTime, report.bruteForceTime / report.indexedTime, checksum);
+
+    return report;
+}
+
+}
+
+TEST(PathfindingBenchmarks, DISABLED_ClosestTriangleLookup)
+{
+    // From 1k up to 100k triangles, every grid cell holds two triangles
+    constexpr uint32_t GRID_SIZES[] = { 23, 71, 224 };
+    constexpr uint32_t QUERY_COUNT = 100000;
+    constexpr uint32_t BRUTE_FORCE_QUERY_COUNT = 200;
+
+    for (uint32_t gridSize : GRID_SIZES)
+    {
+        LookupReport report = BenchmarkLookups(gridSize, QUERY_COUNT, BRUTE_FORCE_QUERY_COUNT);
+        std::string suffix = std::to_string(gridSize * gridSize * 2);
+
+        RecordProperty("buildMs" + suffix, std::to_string(report.buildTime));
+        RecordProperty("indexedLookupMs" + suffix, std::to_string(report.indexedTime));
+        RecordProperty("bruteForceLookupMs" + suffix, std::to_string(report.bruteForceTime));
+
+        EXPECT_LT(report.indexedTime, report.bruteForceTime);
+    }
+}
+
+TEST(PathfindingBenchmarks, DISABLED_CorridorSearch)
+{
+    // About 100k triangles with a fifth of the quads blocked
+    constexpr uint32_t GRID_SIZE = 224;
+    constexpr uint32_t QUERY_COUNT = 2000;
+
+    NavMesh navMesh = MakeObstacleNavMesh(GRID_SIZE, GRID_SIZE, 0.2f, 3);
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+
+    std::mt19937 random { 11 };
+    std::uniform_int_distribution<uint32_t> triangles { 0, navMesh.GetTriangleCount() - 1 };
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs {};
+    for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+        pairs.emplace_back(triangles(random), triangles(random));
+
+    uint32_t found = 0;
+    uint64_t expanded = 0;
+
+    Stopwatch stopwatch {};
+    for (const auto& [start, goal] : pairs)
+    {
+        found += query.FindCorridor(navMesh, start, goal, corridor);
+        expanded += query.GetLastExpandedCount();
+    }
+    float elapsed = stopwatch.GetElapsed().count();
+
+    float queriesPerSecond = static_cast<float>(QUERY_COUNT) / (elapsed / 1000.0f);
+    bblog::info("[PathfindingBenchmarks] Corridor search: {} queries on {} triangles in {:.2f}ms, {:.0f} queries/s, {} found, {} triangles expanded on average",
+        QUERY_COUNT, navMesh.GetTriangleCount(), elapsed, queriesPerSecond, found, expanded / QUERY_COUNT);
+    RecordProperty("queriesPerSecond", std::to_string(queriesPerSecond));
+
+    EXPECT_GT(found, 0u);
+}
+
+TEST(PathfindingBenchmarks, DISABLED_FlowFieldAgents)
+{
+    // A horde all heading for the player, on about 100k triangles
+    constexpr uint32_t GRID_SIZE = 224;
+    constexpr uint32_t AGENT_COUNT = 1000;
+    constexpr uint32_t FRAME_COUNT = 60;
+
+    NavMesh navMesh = MakeObstacleNavMesh(GRID_SIZE, GRID_SIZE, 0.2f, 3);
+
+    std::mt19937 random { 13 };
+    float extent = static_cast<float>(GRID_SIZE) * 0.5f;
+    std::uniform_real_distribution<float> spread { -extent, extent };
+
+    glm::vec3 target { 0.5f, 0.0f, 0.5f };
+    std::vector<glm::vec3> agents {};
+    for (uint32_t i = 0; i < AGENT_COUNT; ++i)
+        agents.emplace_back(spread(random), 0.0f, spread(random));
+
+    // Every agent running its own search
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+    uint32_t targetTriangle = navMesh.FindClosestTriangle(target);
+    uint32_t found = 0;
+
+    Stopwatch searchStopwatch {};
+    for (const auto& agent : agents)
+        found += query.FindCorridor(navMesh, navMesh.FindClosestTriangle(agent), targetTriangle, corridor);
+    float searchTime = searchStopwatch.GetElapsed().count();
+
+    // One shared field, every agent sampling it each frame
+    NavMeshFlowField field {};
+
+    Stopwatch buildStopwatch {};
+    field.Build(navMesh, target);
+    float buildTime = buildStopwatch.GetElapsed().count();
+
+    uint32_t reachable = 0;
+    for (const auto& agent : agents)
+        reachable += field.IsReachable(navMesh.FindClosestTriangle(agent));
+
+    Stopwatch sampleStopwatch {};
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        for (auto& agent : agents)
+            agent += field.SampleDirection(navMesh, agent) * 0.1f;
+    }
+    float sampleTime = sampleStopwatch.GetElapsed().count() / static_cast<float>(FRAME_COUNT);
+
+    bblog::info("[PathfindingBenchmarks] Flow field: {} agents on {} triangles, individual searches {:.2f}ms, field build {:.2f}ms, sampling {:.3f}ms per frame, {:.1f}x faster for the first frame",
+        AGENT_COUNT, navMesh.GetTriangleCount(), searchTime, buildTime, sampleTime, searchTime / (buildTime + sampleTime));
+    RecordProperty("individualSearchMs", std::to_string(searchTime));
+    RecordProperty("flowFieldBuildMs", std::to_string(buildTime));
+    RecordProperty("flowFieldSampleMs", std::to_string(sampleTime));
+
+    EXPECT_EQ(found, reachable);
+    EXPECT_LT(buildTime + sampleTime, searchTime);
+}
+
+TEST(PathfindingBenchmarks, DISABLED_HierarchicalSearch)
+{
+    // From 100k up to 400k triangles, with a fifth of the quads blocked
+    constexpr uint32_t GRID_SIZES[] = { 224, 448 };
+    constexpr uint32_t QUERY_COUNT = 1000;
+
+    for (uint32_t gridSize : GRID_SIZES)
+    {
+        Stopwatch buildStopwatch {};
+        NavMesh navMesh = MakeObstacleNavMesh(gridSize, gridSize, 0.2f, 3);
+        float buildTime = buildStopwatch.GetElapsed().count();
+
+        const NavMeshHierarchy& hierarchy = navMesh.GetHierarchy();
+        NavMeshQuery query {};
+        std::vector<uint32_t> corridor {};
+
+        std::mt19937 random { gridSize };
+        std::uniform_int_distribution<uint32_t> triangles { 0, navMesh.GetTriangleCount() - 1 };
+
+        std::vector<std::pair<uint32_t, uint32_t>> pairs {};
+        for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+            pairs.emplace_back(triangles(random), triangles(random));
+
+        std::vector<float> flatCosts(QUERY_COUNT, 0.0f);
+        uint64_t flatExpanded = 0;
+
+        Stopwatch flatStopwatch {};
+        for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+        {
+            if (query.FindCorridor(navMesh, pairs[i].first, pairs[i].second, corridor))
+                flatCosts[i] = query.GetLastCost();
+
+            flatExpanded += query.GetLastExpandedCount();
+        }
+        float flatTime = flatStopwatch.GetElapsed().count();
+
+        std::vector<float> hierarchicalCosts(QUERY_COUNT, 0.0f);
+        uint64_t hierarchicalExpanded = 0;
+
+        Stopwatch hierarchicalStopwatch {};
+        for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+        {
+            if (query.FindHierarchicalCorridor(navMesh, pairs[i].first, pairs[i].second, corridor))
+                hierarchicalCosts[i] = query.GetLastCost();
+
+            hierarchicalExpanded += query.GetLastExpandedCount();
+        }
+        float hierarchicalTime = hierarchicalStopwatch.GetElapsed().count();
+
+        float totalError = 0.0f;
+        uint32_t found = 0;
+
+        for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+        {
+            if (flatCosts[i] <= 0.0f)
+                continue;
+
+            totalError += (hierarchicalCosts[i] - flatCosts[i]) / flatCosts[i];
+            found++;
+        }
+
+        float averageError = found > 0 ? totalError / static_cast<float>(found) : 0.0f;
+
+        bblog::info("[PathfindingBenchmarks] Hierarchical search: {} triangles in {} clusters with {} nodes, navmesh build {:.2f}ms, "
+                    "flat {:.3f}ms per query expanding {}, hierarchical {:.3f}ms per query expanding {}, {:.1f}x faster, {:.2f}% longer on average",
+            navMesh.GetTriangleCount(), hierarchy.GetClusterCount(), hierarchy.GetNodeCount(), buildTime,
+            flatTime / QUERY_COUNT, flatExpanded / QUERY_COUNT, hierarchicalTime / QUERY_COUNT, hierarchicalExpanded / QUERY_COUNT,
+            flatTime / hierarchicalTime, averageError * 100.0f);
+
+        std::string suffix = std::to_string(navMesh.GetTriangleCount());
+        RecordProperty("navMeshBuildMs" + suffix, std::to_string(buildTime));
+        RecordProperty("flatQueryMs" + suffix, std::to_string(flatTime / QUERY_COUNT));
+        RecordProperty("hierarchicalQueryMs" + suffix, std::to_string(hierarchicalTime / QUERY_COUNT));
+        RecordProperty("hierarchicalError" + suffix, std::to_string(averageError));
+
+        EXPECT_LT(hierarchicalTime, flatTime);
+        EXPECT_LT(averageError, 0.05f);
+    }
+}
+
+TEST(PathfindingBenchmarks, DISABLED_BakedNavMeshLoad)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "bb_navmesh_bake_benchmark";
+
+    for (uint32_t gridSize : { 224u, 448u })
+    {
+        NavMesh source = MakeObstacleNavMesh(gridSize, gridSize, 0.2f, 3);
+        std::vector<glm::vec3> vertices = source.GetVertices();
+        std::vector<uint32_t> indices = source.GetIndices();
+
+        const std::filesystem::path path = directory / (std::to_string(gridSize) + ".navmesh");
+        ASSERT_TRUE(NavMeshBake::Save(source, path, 0));
+
+        // What loading a level did before, building everything from the triangle list
+        Stopwatch buildStopwatch {};
+        NavMesh built { std::move(vertices), std::move(indices) };
+        float buildTime = buildStopwatch.GetElapsed().count();
+
+        Stopwatch loadStopwatch {};
+        std::optional<NavMesh> loaded = NavMeshBake::Load(path, 0);
+        float loadTime = loadStopwatch.GetElapsed().count();
+
+        ASSERT_TRUE(loaded.has_value());
+        EXPECT_EQ(loaded->GetTriangleCount(), built.GetTriangleCount());
+
+        bblog::info("[PathfindingBenchmarks] Baked navmesh: {} triangles, {:.1f}KB on disk, build {:.2f}ms, load {:.2f}ms, {:.1f}x faster",
+            built.GetTriangleCount(), static_cast<float>(std::filesystem::file_size(path)) / 1024.0f, buildTime, loadTime, buildTime / loadTime);
+
+        std::string suffix = std::to_string(built.GetTriangleCount());
+        RecordProperty("navMeshBuildMs" + suffix, std::to_string(buildTime));
+        RecordProperty("bakedNavMeshLoadMs" + suffix, std::to_string(loadTime));
+
+        EXPECT_LT(loadTime, buildTime);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PathfindingBenchmarks, DISABLED_PathCache)
+{
+    // A group of enemies in the same area asking for a path to the player every frame, while shuffling around a bit
+    constexpr uint32_t GRID_SIZE = 224;
+    constexpr uint32_t AGENT_COUNT = 64;
+    constexpr uint32_t FRAME_COUNT = 60;
+
+    NavMesh navMesh = MakeObstacleNavMesh(GRID_SIZE, GRID_SIZE, 0.2f, 3);
+
+    std::mt19937 random { 17 };
+    std::uniform_real_distribution<float> spread { -50.0f, -40.0f };
+    std::uniform_real_distribution<float> shuffle { -0.05f, 0.05f };
+
+    std::vector<glm::vec3> agents {};
+    for (uint32_t i = 0; i < AGENT_COUNT; ++i)
+        agents.emplace_back(spread(random), 0.0f, spread(random));
+
+    std::vector<std::vector<glm::vec3>> frames(FRAME_COUNT, agents);
+    for (uint32_t frame = 1; frame < FRAME_COUNT; ++frame)
+    {
+        for (uint32_t i = 0; i < AGENT_COUNT; ++i)
+            frames[frame][i] = frames[frame - 1][i] + glm::vec3 { shuffle(random), 0.0f, shuffle(random) };
+    }
+
+    const glm::vec3 target { 45.5f, 0.0f, 45.5f };
+
+    NavMeshQuery query {};
+    query.SetHierarchical(true);
+    std::vector<uint32_t> corridor {};
+    std::vector<glm::vec3> points {};
+
+    // Same as the pathfinding module, searching on a miss
+    auto findPath = [&](NavMeshPathCache* cache, const glm::vec3& start)
+    {
+        uint32_t startTriangle = navMesh.FindClosestTriangle(start);
+        uint32_t goalTriangle = navMesh.FindClosestTriangle(target);
+
+        if (cache != nullptr && cache->FindPath(navMesh, query, startTriangle, goalTriangle, start, target, true, points) != NavMeshPathCache::LookupResult::eMISS)
+            return;
+
+        if (query.FindHierarchicalCorridor(navMesh, startTriangle, goalTriangle, corridor))
+            query.BuildPath(navMesh, corridor, start, target, true, points);
+
+        if (cache != nullptr)
+            cache->Store(startTriangle, goalTriangle, corridor, start, target, true, points);
+    };
+
+    Stopwatch uncachedStopwatch {};
+    for (const auto& frame : frames)
+        for (const auto& agent : frame)
+            findPath(nullptr, agent);
+    float uncachedTime = uncachedStopwatch.GetElapsed().count() / static_cast<float>(FRAME_COUNT);
+
+    NavMeshPathCache cache {};
+
+    Stopwatch cachedStopwatch {};
+    for (const auto& frame : frames)
+        for (const auto& agent : frame)
+            findPath(&cache, agent);
+    float cachedTime = cachedStopwatch.GetElapsed().count() / static_cast<float>(FRAME_COUNT);
+
+    const NavMeshPathCache::Stats& stats = cache.GetStats();
+
+    bblog::info("[PathfindingBenchmarks] Path cache: {} agents on {} triangles, without cache {:.3f}ms per frame, with cache {:.3f}ms per frame, {:.1f}x faster, "
+                "{:.1f}% hit rate ({} full, {} partial, {} misses)",
+        AGENT_COUNT, navMesh.GetTriangleCount(), uncachedTime, cachedTime, uncachedTime / cachedTime,
+        stats.GetHitRate() * 100.0f, stats.hits, stats.partialHits, stats.misses);
+    RecordProperty("uncachedFrameMs", std::to_string(uncachedTime));
+    RecordProperty("cachedFrameMs", std::to_string(cachedTime));
+    RecordProperty("pathCacheHitRate", std::to_string(stats.GetHitRate()));
+
+    EXPECT_LT(cachedTime, uncachedTime);
+}
+
+TEST(PathfindingBenchmarks, DISABLED_NavAgents)
+{
+    // Agents spread over the navmesh walking towards a target that moves every second, like enemies chasing the player
+    constexpr uint32_t GRID_SIZE = 224;
+    constexpr uint32_t AGENT_COUNT = 500;
+    constexpr uint32_t FRAME_COUNT = 300;
+    constexpr float FRAME_TIME = 16.0f;
+    constexpr float SPEED = 0.1f;
+
+    NavMesh navMesh = MakeObstacleNavMesh(GRID_SIZE, GRID_SIZE, 0.2f, 11);
+
+    PathQueryService service {};
+    NavMeshPathCache cache {};
+    service.SetHierarchical(true);
+    service.SetPathCache(&cache);
+
+    entt::registry registry {};
+    TransformHelpers::SubscribeToEvents(registry);
+
+    std::mt19937 random { 23 };
+    std::uniform_real_distribution<float> spread { -100.0f, 100.0f };
+
+    for (uint32_t i = 0; i < AGENT_COUNT; ++i)
+    {
+        entt::entity entity = registry.create();
+        registry.emplace<TransformComponent>(entity);
+        TransformHelpers::SetLocalPosition(registry, entity, glm::vec3 { spread(random), 0.0f, spread(random) });
+        registry.emplace<NavAgentComponent>(entity);
+    }
+
+    glm::vec3 target { 0.5f, 0.0f, 0.5f };
+    float agentTime = 0.0f;
+    float serviceTime = 0.0f;
+
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        if (frame % 60 == 0)
+            target = navMesh.GetTriangle(navMesh.FindClosestTriangle(glm::vec3 { spread(random), 0.0f, spread(random) })).centre;
+
+        for (auto [entity, agent] : registry.view<NavAgentComponent>().each())
+        {
+            agent.SetTarget(target);
+
+            const glm::vec3 position = TransformHelpers::GetWorldPosition(registry, entity);
+            TransformHelpers::SetLocalPosition(registry, entity, position + agent.GetDirection() * SPEED);
+        }
+
+        Stopwatch agentStopwatch {};
+        NavAgentSystem::UpdateAgents(registry, service, FRAME_TIME);
+        agentTime += agentStopwatch.GetElapsed().count();
+
+        Stopwatch serviceStopwatch {};
+        service.Update(navMesh, nullptr);
+        serviceTime += serviceStopwatch.GetElapsed().count();
+    }
+
+    uint32_t followingCount = 0;
+    for (auto [entity, agent] : registry.view<NavAgentComponent>().each())
+        followingCount += agent.GetState() == NavAgentState::eFOLLOWING || agent.GetState() == NavAgentState::eARRIVED;
+
+    TransformHelpers::UnsubscribeToEvents(registry);
+
+    const float agentFrameTime = agentTime / static_cast<float>(FRAME_COUNT);
+    const float serviceFrameTime = serviceTime / static_cast<float>(FRAME_COUNT);
+
+    bblog::info("[PathfindingBenchmarks] Nav agents: {} agents on {} triangles, agent pass {:.3f}ms per frame, query service {:.3f}ms per frame, "
+                "{} agents with a path, {:.1f}% path cache hit rate",
+        AGENT_COUNT, navMesh.GetTriangleCount(), agentFrameTime, serviceFrameTime, followingCount, cache.GetStats().GetHitRate() * 100.0f);
+    RecordProperty("navAgentFrameMs", std::to_string(agentFrameTime));
+    RecordProperty("navAgentServiceFrameMs", std::to_string(serviceFrameTime));
+
+    EXPECT_GT(followingCount, AGENT_COUNT / 2);
+}
+
+TEST(PathfindingBenchmarks, DISABLED_CrowdAvoidance)
+{
+    // Dense groups of agents running into each other, with and without spreading the avoidance over a thread pool
+    constexpr uint32_t AGENT_COUNTS[] = { 250, 500, 1000, 2000, 4000 };
+    constexpr uint32_t FRAME_COUNT = 60;
+    constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+    const uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    ThreadPool threadPool { threadCount };
+    threadPool.Start();
+
+    for (uint32_t agentCount : AGENT_COUNTS)
+    {
+        // Agents are spaced 1.5 units apart, so every agent has a full set of neighbours
+        const float extent = std::sqrt(static_cast<float>(agentCount)) * 1.5f;
+
+        std::mt19937 random { 29 };
+        std::uniform_real_distribution<float> spread { -extent * 0.5f, extent * 0.5f };
+
+        std::vector<CrowdAvoidance::Agent> agents(agentCount);
+        for (CrowdAvoidance::Agent& agent : agents)
+        {
+            agent.position = glm::vec3 { spread(random), 0.0f, spread(random) };
+            agent.preferredVelocity = glm::normalize(-agent.position) * agent.maxSpeed;
+        }
+
+        float times[2] {};
+
+        for (uint32_t pooled = 0; pooled < 2; ++pooled)
+        {
+            CrowdAvoidance avoidance {};
+
+            for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame)
+            {
+                avoidance.Clear();
+                for (const CrowdAvoidance::Agent& agent : agents)
+                    avoidance.AddAgent(agent);
+
+                Stopwatch stopwatch {};
+                avoidance.ComputeVelocities(FRAME_TIME, pooled ? &threadPool : nullptr);
+                times[pooled] += stopwatch.GetElapsed().count();
+            }
+        }
+
+        const float singleFrameTime = times[0] / static_cast<float>(FRAME_COUNT);
+        const float pooledFrameTime = times[1] / static_cast<float>(FRAME_COUNT);
+
+        bblog::info("[PathfindingBenchmarks] Crowd avoidance: {} agents, {:.3f}ms per frame single threaded, {:.3f}ms per frame on {} threads",
+            agentCount, singleFrameTime, pooledFrameTime, threadCount);
+        RecordProperty("crowdAvoidance" + std::to_string(agentCount) + "FrameMs", std::to_string(singleFrameTime));
+        RecordProperty("crowdAvoidance" + std::to_string(agentCount) + "PooledFrameMs", std::to_string(pooledFrameTime));
+    }
+}
@@ -0,0 +1,211 @@
+#include "navmesh.hpp"
+#include "navmesh_flow_field.hpp"
+#include "navmesh_query.hpp"
+#include "navmesh_test_helpers.hpp"
+
+#include <algorithm>
+#include <glm/geometric.hpp>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+// Rows joined at alternating ends, so there is only a single way through the navmesh
+NavMesh MakeSerpentineNavMesh(uint32_t width, uint32_t depth)
+{
+    return MakeGridNavMesh(width, depth, 1.0f, 0.0f, [width](uint32_t x, uint32_t z)
+        {
+            if (z % 2 == 0)
+                return true;
+
+            return x == (z % 4 == 1 ? width - 1 : 0);
+        });
+}
+
+// Follows the next triangles from the start up to the target, both included
+std::vector<uint32_t> FollowField(const NavMeshFlowField& field, uint32_t start)
+{
+    std::vector<uint32_t> triangles { start };
+
+    while (triangles.back() != field.GetTargetTriangle() && triangles.size() <= field.GetTriangleCount())
+        triangles.emplace_back(field.GetNextTriangle(triangles.back()));
+
+    return triangles;
+}
+
+}
+
+TEST(NavMeshFlowFieldTests, EmptyNavMesh)
+{
+    // Arrange
+    NavMesh navMesh {};
+    NavMeshFlowField field {};
+
+    // Act & Assert
+    EXPECT_FALSE(field.Build(navMesh, glm::vec3 { 0.0f }));
+    EXPECT_FALSE(field.IsValid());
+    EXPECT_EQ(field.SampleDirection(navMesh, glm::vec3 { 1.0f }), glm::vec3 { 0.0f });
+}
+
+TEST(NavMeshFlowFieldTests, DistancesMatchAStar)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(30, 30, 0.25f, 5);
+    NavMeshFlowField field {};
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+
+    // Act
+    ASSERT_TRUE(field.Build(navMesh, glm::vec3 { 3.2f, 0.0f, -4.7f }));
+
+    // Assert
+    for (uint32_t triangle = 0; triangle < navMesh.GetTriangleCount(); ++triangle)
+    {
+        bool found = query.FindCorridor(navMesh, triangle, field.GetTargetTriangle(), corridor);
+        ASSERT_EQ(found, field.IsReachable(triangle)) << "triangle " << triangle;
+
+        if (found)
+            EXPECT_NEAR(field.GetDistance(triangle), query.GetLastCost(), 0.001f * (1.0f + query.GetLastCost())) << "triangle " << triangle;
+    }
+}
+
+TEST(NavMeshFlowFieldTests, NextTriangleIsOnShortestPath)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(30, 30, 0.25f, 9);
+    NavMeshFlowField field {};
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+
+    // Act
+    ASSERT_TRUE(field.Build(navMesh, glm::vec3 { -8.5f, 0.0f, 10.5f }));
+
+    // Assert, open grids have many equally short paths, so the field doesn't have to pick the same one as A*,
+    // but walking along it has to cost as much as the corridor A* finds
+    for (uint32_t triangle = 0; triangle < navMesh.GetTriangleCount(); ++triangle)
+    {
+        if (!query.FindCorridor(navMesh, triangle, field.GetTargetTriangle(), corridor))
+            continue;
+
+        std::vector<uint32_t> followed = FollowField(field, triangle);
+        ASSERT_EQ(followed.back(), field.GetTargetTriangle());
+
+        float cost = 0.0f;
+        for (size_t i = 1; i < followed.size(); ++i)
+            cost += glm::distance(navMesh.GetTriangle(followed[i - 1]).centre, navMesh.GetTriangle(followed[i]).centre);
+
+        EXPECT_NEAR(cost, query.GetLastCost(), 0.001f * (1.0f + cost)) << "triangle " << triangle;
+    }
+}
+
+TEST(NavMeshFlowFieldTests, MatchesCorridorWhenPathIsUnique)
+{
+    // Arrange
+    NavMesh navMesh = MakeSerpentineNavMesh(6, 9);
+    NavMeshFlowField field {};
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+
+    // Act
+    ASSERT_TRUE(field.Build(navMesh, glm::vec3 { 2.5f, 0.0f, 4.0f }));
+
+    // Assert
+    for (uint32_t triangle = 0; triangle < navMesh.GetTriangleCount(); ++triangle)
+    {
+        ASSERT_TRUE(query.FindCorridor(navMesh, triangle, field.GetTargetTriangle(), corridor));
+        EXPECT_EQ(FollowField(field, triangle), corridor) << "triangle " << triangle;
+    }
+}
+
+TEST(NavMeshFlowFieldTests, UnreachableTriangles)
+{
+    // Arrange, two islands separated by a column of removed quads
+    NavMesh navMesh = MakeGridNavMesh(5, 3, 1.0f, 0.0f, [](uint32_t x, uint32_t)
+        { return x != 2; });
+    NavMeshFlowField field {};
+
+    // Act
+    ASSERT_TRUE(field.Build(navMesh, glm::vec3 { -2.0f, 0.0f, 0.0f }));
+
+    // Assert
+    glm::vec3 otherIsland { 2.0f, 0.0f, 0.0f };
+    uint32_t triangle = navMesh.FindClosestTriangle(otherIsland);
+
+    EXPECT_FALSE(field.IsReachable(triangle));
+    EXPECT_EQ(field.GetNextTriangle(triangle), NavMesh::INVALID_TRIANGLE);
+    EXPECT_EQ(field.SampleDirection(navMesh, otherIsland), glm::vec3 { 0.0f });
+    EXPECT_NE(field.SampleDirection(navMesh, glm::vec3 { -1.2f, 0.0f, 1.0f }), glm::vec3 { 0.0f });
+}
+
+TEST(NavMeshFlowFieldTests, AgentsReachTarget)
+{
+    // Arrange
+    constexpr uint32_t AGENT_COUNT = 50;
+    constexpr uint32_t MAX_STEPS = 1000;
+    constexpr float STEP_SIZE = 0.25f;
+
+    NavMesh navMesh = MakeObstacleNavMesh(30, 30, 0.2f, 17);
+    NavMeshFlowField field {};
+    glm::vec3 target { 0.5f, 0.0f, 0.5f };
+    ASSERT_TRUE(field.Build(navMesh, target));
+
+    std::mt19937 random { 3 };
+    std::uniform_real_distribution<float> spread { -14.5f, 14.5f };
+
+    // Act & Assert
+    for (uint32_t agent = 0; agent < AGENT_COUNT; ++agent)
+    {
+        glm::vec3 position { spread(random), 0.0f, spread(random) };
+        uint32_t triangle = navMesh.FindClosestTriangle(position);
+
+        if (!field.IsReachable(triangle))
+            continue;
+
+        position = navMesh.ClosestPointOnTriangle(triangle, position);
+
+        for (uint32_t step = 0; step < MAX_STEPS && glm::distance(position, target) > 0.01f; ++step)
+        {
+            triangle = navMesh.FindClosestTriangle(position);
+            glm::vec3 direction = field.SampleDirection(triangle, position);
+            ASSERT_NE(direction, glm::vec3 { 0.0f });
+
+            // Don't overshoot the waypoint, walking straight between waypoints keeps the agent on the navmesh
+            glm::vec3 waypoint = field.GetWaypoint(triangle);
+            if (glm::distance(position, waypoint) < 0.0001f)
+                waypoint = field.GetWaypoint(field.GetNextTriangle(triangle));
+
+            position += direction * std::min(STEP_SIZE, glm::distance(position, waypoint));
+        }
+
+        EXPECT_NEAR(glm::distance(position, target), 0.0f, 0.01f) << "agent " << agent;
+    }
+}
+
+TEST(NavMeshFlowFieldTests, RefreshesOnlyWhenNeeded)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(10, 10);
+    NavMeshFlowField field {};
+    field.SetRefreshInterval(DeltaMS { 100.0f });
+
+    glm::vec3 target { -4.8f, 0.0f, -4.8f };
+    glm::vec3 sameTriangle { -4.7f, 0.0f, -4.9f };
+    glm::vec3 otherTriangle { 4.5f, 0.0f, 4.5f };
+    ASSERT_EQ(navMesh.FindClosestTriangle(target), navMesh.FindClosestTriangle(sameTriangle));
+
+    // Act & Assert
+    EXPECT_TRUE(field.Update(navMesh, target, DeltaMS { 0.0f }));
+    EXPECT_EQ(field.GetBuildCount(), 1u);
+
+    // Moving inside the target triangle only moves its waypoint
+    EXPECT_FALSE(field.Update(navMesh, sameTriangle, DeltaMS { 10.0f }));
+    EXPECT_EQ(field.GetWaypoint(field.GetTargetTriangle()), sameTriangle);
+
+    EXPECT_TRUE(field.Update(navMesh, otherTriangle, DeltaMS { 10.0f }));
+    EXPECT_EQ(field.GetTargetTriangle(), navMesh.FindClosestTriangle(otherTriangle));
+
+    // Rebuilt once it gets older than the interval
+    EXPECT_FALSE(field.Update(navMesh, otherTriangle, DeltaMS { 60.0f }));
+    EXPECT_TRUE(field.Update(navMesh, otherTriangle, DeltaMS { 60.0f }));
+    EXPECT_EQ(field.GetBuildCount(), 3u);
+}
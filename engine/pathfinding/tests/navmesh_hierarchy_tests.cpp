@@ -0,0 +1,264 @@
+#include "navmesh.hpp"
+#include "navmesh_hierarchy.hpp"
+#include "navmesh_query.hpp"
+#include "navmesh_test_helpers.hpp"
+
+#include <algorithm>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <gtest/gtest.h>
+#include <set>
+
+namespace
+{
+
+bool AreAdjacent(const NavMesh& navMesh, uint32_t a, uint32_t b)
+{
+    const NavMesh::Triangle& triangle = navMesh.GetTriangle(a);
+    return std::find(triangle.adjacentTriangleIndices, triangle.adjacentTriangleIndices + triangle.adjacentTriangleCount, b) != triangle.adjacentTriangleIndices + triangle.adjacentTriangleCount;
+}
+
+void ExpectValidCorridor(const NavMesh& navMesh, const std::vector<uint32_t>& corridor, uint32_t start, uint32_t goal)
+{
+    ASSERT_FALSE(corridor.empty());
+    EXPECT_EQ(corridor.front(), start);
+    EXPECT_EQ(corridor.back(), goal);
+
+    for (size_t i = 1; i < corridor.size(); ++i)
+        EXPECT_TRUE(AreAdjacent(navMesh, corridor[i - 1], corridor[i]));
+}
+
+}
+
+TEST(NavMeshHierarchyTests, EmptyNavMesh)
+{
+    // Arrange
+    NavMesh navMesh {};
+
+    // Assert
+    EXPECT_TRUE(navMesh.GetHierarchy().IsEmpty());
+    EXPECT_EQ(navMesh.GetHierarchy().GetNodeCount(), 0u);
+}
+
+TEST(NavMeshHierarchyTests, ClustersPartitionTriangles)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(40, 40, 0.3f, 4);
+    const NavMeshHierarchy& hierarchy = navMesh.GetHierarchy();
+
+    // Act & Assert
+    ASSERT_GT(hierarchy.GetClusterCount(), 1u);
+    EXPECT_EQ(hierarchy.GetClusterTriangles().size(), navMesh.GetTriangleCount());
+
+    std::vector<uint32_t> seen(navMesh.GetTriangleCount(), 0);
+
+    for (uint32_t cluster = 0; cluster < hierarchy.GetClusterCount(); ++cluster)
+    {
+        auto triangles = hierarchy.GetTrianglesInCluster(cluster);
+        ASSERT_FALSE(triangles.empty());
+
+        glm::vec3 min { std::numeric_limits<float>::max() };
+        glm::vec3 max { std::numeric_limits<float>::lowest() };
+
+        for (uint32_t triangle : triangles)
+        {
+            seen[triangle]++;
+            EXPECT_EQ(hierarchy.GetTriangleCluster(triangle), cluster);
+
+            min = glm::min(min, navMesh.GetTriangle(triangle).centre);
+            max = glm::max(max, navMesh.GetTriangle(triangle).centre);
+        }
+
+        // All centres fit in a single grid cell
+        EXPECT_LE(max.x - min.x, hierarchy.GetClusterSize());
+        EXPECT_LE(max.z - min.z, hierarchy.GetClusterSize());
+
+        // Every triangle can be reached from the first one without leaving the cluster
+        std::vector<uint32_t> reached { triangles.front() };
+        std::set<uint32_t> visited { triangles.front() };
+
+        for (size_t i = 0; i < reached.size(); ++i)
+        {
+            const NavMesh::Triangle& triangle = navMesh.GetTriangle(reached[i]);
+
+            for (uint32_t j = 0; j < triangle.adjacentTriangleCount; ++j)
+            {
+                uint32_t neighbour = triangle.adjacentTriangleIndices[j];
+                if (hierarchy.GetTriangleCluster(neighbour) == cluster && visited.insert(neighbour).second)
+                    reached.emplace_back(neighbour);
+            }
+        }
+
+        EXPECT_EQ(reached.size(), triangles.size()) << "cluster " << cluster;
+    }
+
+    for (uint32_t count : seen)
+        EXPECT_EQ(count, 1u);
+}
+
+TEST(NavMeshHierarchyTests, PortalsConnectEveryPairOfNeighbouringClusters)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(40, 40, 0.3f, 6);
+    const NavMeshHierarchy& hierarchy = navMesh.GetHierarchy();
+
+    std::set<std::pair<uint32_t, uint32_t>> touching {};
+    std::set<std::pair<uint32_t, uint32_t>> connected {};
+
+    // Act
+    for (uint32_t i = 0; i < navMesh.GetTriangleCount(); ++i)
+    {
+        const NavMesh::Triangle& triangle = navMesh.GetTriangle(i);
+
+        for (uint32_t j = 0; j < triangle.adjacentTriangleCount; ++j)
+        {
+            uint32_t a = hierarchy.GetTriangleCluster(i);
+            uint32_t b = hierarchy.GetTriangleCluster(triangle.adjacentTriangleIndices[j]);
+
+            if (a != b)
+                touching.emplace(std::min(a, b), std::max(a, b));
+        }
+    }
+
+    for (uint32_t node = 0; node < hierarchy.GetNodeCount(); ++node)
+    {
+        const NavMeshHierarchy::Node& from = hierarchy.GetNode(node);
+        EXPECT_EQ(hierarchy.GetTriangleNode(from.triangle), node);
+
+        for (const NavMeshHierarchy::Edge& edge : hierarchy.GetNodeEdges(node))
+        {
+            const NavMeshHierarchy::Node& to = hierarchy.GetNode(edge.node);
+            float straightLine = glm::distance(navMesh.GetTriangle(from.triangle).centre, navMesh.GetTriangle(to.triangle).centre);
+
+            // Edges within a cluster can't be shorter than a straight line, edges through a portal are exactly that long
+            EXPECT_GE(edge.cost, straightLine - 0.0001f);
+
+            if (from.cluster != to.cluster)
+            {
+                EXPECT_TRUE(AreAdjacent(navMesh, from.triangle, to.triangle));
+                EXPECT_NEAR(edge.cost, straightLine, 0.0001f);
+                connected.emplace(std::min(from.cluster, to.cluster), std::max(from.cluster, to.cluster));
+            }
+        }
+    }
+
+    // Assert
+    EXPECT_EQ(connected, touching);
+}
+
+TEST(NavMeshHierarchyTests, SingleClusterMatchesFlatSearch)
+{
+    // Arrange, small enough to fit in a single cluster
+    NavMesh navMesh = MakeGridNavMesh(4, 4, 1.0f, 0.0f, [](uint32_t x, uint32_t z)
+        { return x == 0 || z == 3; });
+    ASSERT_EQ(navMesh.GetHierarchy().GetClusterCount(), 1u);
+
+    NavMeshQuery query {};
+    std::vector<uint32_t> flat {};
+    std::vector<uint32_t> hierarchical {};
+
+    // Act
+    ASSERT_TRUE(query.FindCorridor(navMesh, 0, navMesh.GetTriangleCount() - 1, flat));
+    float flatCost = query.GetLastCost();
+    ASSERT_TRUE(query.FindHierarchicalCorridor(navMesh, 0, navMesh.GetTriangleCount() - 1, hierarchical));
+
+    // Assert
+    EXPECT_NEAR(query.GetLastCost(), flatCost, 0.0001f);
+    ExpectValidCorridor(navMesh, hierarchical, 0, navMesh.GetTriangleCount() - 1);
+}
+
+TEST(NavMeshHierarchyTests, UnreachableGoal)
+{
+    // Arrange, two islands separated by a column of removed quads, wider than a cluster
+    NavMesh navMesh = MakeGridNavMesh(41, 20, 1.0f, 0.0f, [](uint32_t x, uint32_t)
+        { return x != 20; });
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+
+    // Act
+    bool found = query.FindHierarchicalCorridor(navMesh, navMesh.FindClosestTriangle(glm::vec3 { -15.0f, 0.0f, 0.0f }),
+        navMesh.FindClosestTriangle(glm::vec3 { 15.0f, 0.0f, 0.0f }), corridor);
+
+    // Assert
+    EXPECT_FALSE(found);
+    EXPECT_TRUE(corridor.empty());
+    EXPECT_EQ(query.GetStatus(), NavMeshQuery::SearchStatus::eFAILED);
+}
+
+TEST(NavMeshHierarchyTests, CostWithinBoundOfFlatSearch)
+{
+    // Arrange
+    constexpr uint32_t QUERY_COUNT = 300;
+
+    for (uint32_t seed : { 1u, 2u, 3u })
+    {
+        NavMesh navMesh = MakeObstacleNavMesh(50, 50, 0.25f, seed);
+        const float clusterSize = navMesh.GetHierarchy().GetClusterSize();
+        ASSERT_GT(navMesh.GetHierarchy().GetClusterCount(), 1u);
+
+        NavMeshQuery query {};
+        std::vector<uint32_t> flat {};
+        std::vector<uint32_t> hierarchical {};
+
+        std::mt19937 random { seed };
+        std::uniform_int_distribution<uint32_t> triangles { 0, navMesh.GetTriangleCount() - 1 };
+
+        float totalError = 0.0f;
+        uint32_t found = 0;
+
+        // Act & Assert
+        for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+        {
+            uint32_t start = triangles(random);
+            uint32_t goal = triangles(random);
+
+            bool flatFound = query.FindCorridor(navMesh, start, goal, flat);
+            float flatCost = query.GetLastCost();
+            bool hierarchicalFound = query.FindHierarchicalCorridor(navMesh, start, goal, hierarchical);
+            float hierarchicalCost = query.GetLastCost();
+
+            ASSERT_EQ(flatFound, hierarchicalFound) << start << " to " << goal;
+            if (!flatFound)
+                continue;
+
+            ExpectValidCorridor(navMesh, hierarchical, start, goal);
+
+            // Passing through the portals can only add a detour of about a cluster, on top of a small relative error
+            EXPECT_GE(hierarchicalCost, flatCost * 0.9999f - 0.001f);
+            EXPECT_LE(hierarchicalCost, flatCost * 1.1f + clusterSize) << start << " to " << goal;
+
+            totalError += flatCost > 0.0f ? (hierarchicalCost - flatCost) / flatCost : 0.0f;
+            found++;
+        }
+
+        ASSERT_GT(found, 0u);
+        EXPECT_LT(totalError / static_cast<float>(found), 0.03f);
+    }
+}
+
+TEST(NavMeshHierarchyTests, QueryFindsHierarchicalPath)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(50, 50, 0.2f, 12);
+    NavMeshQuery query {};
+    query.SetHierarchical(true);
+
+    std::vector<glm::vec3> points {};
+    glm::vec3 start { -24.5f, 0.0f, -24.5f };
+    glm::vec3 end { 24.5f, 0.0f, 24.5f };
+
+    // Act
+    bool found = query.FindPath(navMesh, start, end, true, points);
+
+    // Assert
+    NavMeshQuery flatQuery {};
+    std::vector<glm::vec3> flatPoints {};
+    ASSERT_EQ(found, flatQuery.FindPath(navMesh, start, end, true, flatPoints));
+
+    if (found)
+    {
+        EXPECT_GE(points.size(), 2u);
+        EXPECT_EQ(points.front(), flatPoints.front());
+        EXPECT_EQ(points.back(), flatPoints.back());
+    }
+}
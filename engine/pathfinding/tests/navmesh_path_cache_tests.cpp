@@ -0,0 +1,235 @@
+#include "navmesh.hpp"
+#include "navmesh_path_cache.hpp"
+#include "navmesh_query.hpp"
+#include "navmesh_test_helpers.hpp"
+#include "path_query_service.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+// Searches like the pathfinding module does on a miss, and stores the result
+NavMeshPathCache::LookupResult FindPathCached(NavMeshPathCache& cache, NavMeshQuery& query, const NavMesh& navMesh,
+    const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& points)
+{
+    const uint32_t startTriangle = navMesh.FindClosestTriangle(start);
+    const uint32_t goalTriangle = navMesh.FindClosestTriangle(end);
+
+    NavMeshPathCache::LookupResult result = cache.FindPath(navMesh, query, startTriangle, goalTriangle, start, end, true, points);
+    if (result != NavMeshPathCache::LookupResult::eMISS)
+        return result;
+
+    std::vector<uint32_t> corridor {};
+    if (query.FindCorridor(navMesh, startTriangle, goalTriangle, corridor))
+        query.BuildPath(navMesh, corridor, start, end, true, points);
+
+    cache.Store(startTriangle, goalTriangle, corridor, start, end, true, points);
+    return result;
+}
+
+std::vector<glm::vec3> FindPathDirectly(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end)
+{
+    NavMeshQuery query {};
+    std::vector<glm::vec3> points {};
+    query.FindPath(navMesh, start, end, true, points);
+
+    return points;
+}
+
+void UpdateUntilIdle(PathQueryService& service, const NavMesh& navMesh)
+{
+    do
+    {
+        service.Update(navMesh, nullptr);
+    } while (service.GetPendingCount() > 0 || service.GetRunningCount() > 0);
+
+    service.Update(navMesh, nullptr);
+}
+
+// Grid of 20 by 20 with a wall along x = 0 that is open at the top when requested
+NavMesh MakeWallNavMesh(bool open)
+{
+    return MakeGridNavMesh(20, 20, 1.0f, 0.0f, [open](uint32_t x, uint32_t z)
+        { return x != 10 || (open && z == 19); });
+}
+
+}
+
+TEST(NavMeshPathCacheTests, MissThenHit)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(20, 20, 0.2f, 3);
+    NavMeshPathCache cache {};
+    NavMeshQuery query {};
+    std::vector<glm::vec3> first {};
+    std::vector<glm::vec3> second {};
+    glm::vec3 start { -9.8f, 0.0f, -9.8f };
+    glm::vec3 end { 9.2f, 0.0f, 9.2f };
+
+    // Act
+    NavMeshPathCache::LookupResult missed = FindPathCached(cache, query, navMesh, start, end, first);
+    NavMeshPathCache::LookupResult hit = FindPathCached(cache, query, navMesh, start, end, second);
+
+    // Assert
+    EXPECT_EQ(missed, NavMeshPathCache::LookupResult::eMISS);
+    EXPECT_NE(hit, NavMeshPathCache::LookupResult::eMISS);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first, FindPathDirectly(navMesh, start, end));
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+    EXPECT_EQ(cache.GetStats().hits, 1u);
+    EXPECT_FLOAT_EQ(cache.GetStats().GetHitRate(), 0.5f);
+}
+
+TEST(NavMeshPathCacheTests, PartialHitWhenEndpointsMoveWithinTheirTriangles)
+{
+    // Arrange
+    NavMesh navMesh = MakeWallNavMesh(true);
+    NavMeshPathCache cache {};
+    NavMeshQuery query {};
+    std::vector<glm::vec3> points {};
+
+    glm::vec3 start { -9.8f, 0.0f, -9.8f };
+    glm::vec3 end { 9.2f, 0.0f, -9.8f };
+    glm::vec3 movedStart { -9.7f, 0.0f, -9.75f };
+    glm::vec3 movedEnd { 9.25f, 0.0f, -9.7f };
+
+    ASSERT_EQ(navMesh.FindClosestTriangle(start), navMesh.FindClosestTriangle(movedStart));
+    ASSERT_EQ(navMesh.FindClosestTriangle(end), navMesh.FindClosestTriangle(movedEnd));
+
+    FindPathCached(cache, query, navMesh, start, end, points);
+
+    // Act
+    NavMeshPathCache::LookupResult result = FindPathCached(cache, query, navMesh, movedStart, movedEnd, points);
+
+    // Assert
+    EXPECT_EQ(result, NavMeshPathCache::LookupResult::eFOUND);
+    EXPECT_EQ(cache.GetStats().partialHits, 1u);
+    EXPECT_EQ(cache.GetStats().hits, 0u);
+    EXPECT_EQ(points, FindPathDirectly(navMesh, movedStart, movedEnd));
+}
+
+TEST(NavMeshPathCacheTests, CachesUnreachableGoals)
+{
+    // Arrange
+    NavMesh navMesh = MakeWallNavMesh(false);
+    NavMeshPathCache cache {};
+    NavMeshQuery query {};
+    std::vector<glm::vec3> points {};
+    glm::vec3 start { -9.8f, 0.0f, -9.8f };
+    glm::vec3 end { 9.2f, 0.0f, 9.2f };
+
+    // Act
+    FindPathCached(cache, query, navMesh, start, end, points);
+    NavMeshPathCache::LookupResult result = FindPathCached(cache, query, navMesh, start, end, points);
+
+    // Assert
+    EXPECT_EQ(result, NavMeshPathCache::LookupResult::eUNREACHABLE);
+    EXPECT_TRUE(points.empty());
+    EXPECT_EQ(cache.GetStats().hits, 1u);
+}
+
+TEST(NavMeshPathCacheTests, EvictsLeastRecentlyUsed)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(4, 4);
+    NavMeshPathCache cache { 2 };
+    NavMeshQuery query {};
+    std::vector<glm::vec3> points {};
+    const std::vector<uint32_t> unreachable {};
+
+    cache.Store(0, 1, unreachable, glm::vec3 { 0.0f }, glm::vec3 { 0.0f }, true, points);
+    cache.Store(0, 2, unreachable, glm::vec3 { 0.0f }, glm::vec3 { 0.0f }, true, points);
+
+    // Act
+    EXPECT_NE(cache.FindPath(navMesh, query, 0, 1, glm::vec3 { 0.0f }, glm::vec3 { 0.0f }, true, points), NavMeshPathCache::LookupResult::eMISS);
+    cache.Store(0, 3, unreachable, glm::vec3 { 0.0f }, glm::vec3 { 0.0f }, true, points);
+
+    // Assert
+    EXPECT_EQ(cache.GetSize(), 2u);
+    EXPECT_TRUE(cache.Contains(0, 1));
+    EXPECT_FALSE(cache.Contains(0, 2));
+    EXPECT_TRUE(cache.Contains(0, 3));
+    EXPECT_EQ(cache.GetStats().evictions, 1u);
+
+    cache.SetCapacity(1);
+    EXPECT_TRUE(cache.Contains(0, 3));
+    EXPECT_EQ(cache.GetSize(), 1u);
+}
+
+TEST(NavMeshPathCacheTests, InvalidateDropsEveryEntry)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(10, 10);
+    NavMeshPathCache cache {};
+    NavMeshQuery query {};
+    std::vector<glm::vec3> points {};
+    glm::vec3 start { -4.8f, 0.0f, -4.8f };
+    glm::vec3 end { 4.2f, 0.0f, 4.2f };
+
+    FindPathCached(cache, query, navMesh, start, end, points);
+
+    // Act
+    cache.Invalidate();
+    NavMeshPathCache::LookupResult result = FindPathCached(cache, query, navMesh, start, end, points);
+
+    // Assert
+    EXPECT_EQ(result, NavMeshPathCache::LookupResult::eMISS);
+    EXPECT_EQ(cache.GetStats().misses, 2u);
+    EXPECT_EQ(cache.GetStats().invalidations, 1u);
+    EXPECT_EQ(cache.GetSize(), 1u);
+}
+
+TEST(NavMeshPathCacheTests, ServiceFinishesCachedRequestsWithoutSearching)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(30, 30, 0.2f, 8);
+    NavMeshPathCache cache {};
+    PathQueryService service {};
+    service.SetPathCache(&cache);
+    glm::vec3 start { -14.5f, 0.0f, -14.5f };
+    glm::vec3 end { 14.5f, 0.0f, 14.5f };
+
+    PathRequestHandle first = service.Submit(start, end);
+    UpdateUntilIdle(service, navMesh);
+
+    // Act
+    PathRequestHandle second = service.Submit(start, end);
+    service.Update(navMesh, nullptr);
+
+    // Assert
+    EXPECT_NE(service.GetStatus(second), PathRequestStatus::ePENDING);
+    EXPECT_EQ(service.GetRunningCount(), 0u);
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+    EXPECT_EQ(cache.GetStats().hits, 1u);
+    EXPECT_EQ(service.TakeResult(first), service.TakeResult(second));
+}
+
+TEST(NavMeshPathCacheTests, ServiceSearchesAgainAfterNavMeshChange)
+{
+    // Arrange
+    NavMesh open = MakeWallNavMesh(true);
+    NavMesh closed = MakeWallNavMesh(false);
+    NavMeshPathCache cache {};
+    PathQueryService service {};
+    service.SetPathCache(&cache);
+    glm::vec3 start { -9.8f, 0.0f, -9.8f };
+    glm::vec3 end { 9.2f, 0.0f, -9.8f };
+
+    PathRequestHandle before = service.Submit(start, end);
+    UpdateUntilIdle(service, open);
+    PathRequestStatus statusBefore = service.GetStatus(before);
+
+    // Act
+    service.CancelAll();
+    cache.Invalidate();
+
+    PathRequestHandle after = service.Submit(start, end);
+    UpdateUntilIdle(service, closed);
+
+    // Assert
+    EXPECT_EQ(statusBefore, PathRequestStatus::eSUCCEEDED);
+    EXPECT_EQ(service.GetStatus(after), PathRequestStatus::eFAILED);
+    EXPECT_EQ(cache.GetStats().misses, 2u);
+    EXPECT_EQ(cache.GetStats().invalidations, 1u);
+}
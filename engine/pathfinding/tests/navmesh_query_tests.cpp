@@ -0,0 +1,200 @@
+#include "indexed_binary_heap.hpp"
+#include "navmesh.hpp"
+#include "navmesh_query.hpp"
+#include "navmesh_test_helpers.hpp"
+
+#include <glm/geometric.hpp>
+#include <gtest/gtest.h>
+#include <queue>
+
+namespace
+{
+
+// Plain Dijkstra with lazy deletion, the reference for the shortest distance between two triangle centres
+float ReferenceDijkstra(const NavMesh& navMesh, uint32_t start, uint32_t goal)
+{
+    using Entry = std::pair<float, uint32_t>;
+
+    std::vector<float> distances(navMesh.GetTriangleCount(), std::numeric_limits<float>::infinity());
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    distances[start] = 0.0f;
+    queue.emplace(0.0f, start);
+
+    while (!queue.empty())
+    {
+        auto [distance, current] = queue.top();
+        queue.pop();
+
+        if (distance > distances[current])
+            continue;
+
+        if (current == goal)
+            return distance;
+
+        const NavMesh::Triangle& triangle = navMesh.GetTriangle(current);
+        for (uint32_t i = 0; i < triangle.adjacentTriangleCount; ++i)
+        {
+            uint32_t neighbour = triangle.adjacentTriangleIndices[i];
+            float candidate = distance + glm::distance(triangle.centre, navMesh.GetTriangle(neighbour).centre);
+
+            if (candidate < distances[neighbour])
+            {
+                distances[neighbour] = candidate;
+                queue.emplace(candidate, neighbour);
+            }
+        }
+    }
+
+    return std::numeric_limits<float>::infinity();
+}
+
+bool AreAdjacent(const NavMesh& navMesh, uint32_t a, uint32_t b)
+{
+    const NavMesh::Triangle& triangle = navMesh.GetTriangle(a);
+    return std::find(triangle.adjacentTriangleIndices, triangle.adjacentTriangleIndices + triangle.adjacentTriangleCount, b) != triangle.adjacentTriangleIndices + triangle.adjacentTriangleCount;
+}
+
+}
+
+TEST(IndexedBinaryHeapTests, PopsInKeyOrder)
+{
+    // Arrange
+    IndexedBinaryHeap heap {};
+    heap.Reserve(8);
+
+    // Act
+    heap.Push(3, 5.0f);
+    heap.Push(1, 2.0f);
+    heap.Push(6, 9.0f);
+    heap.Push(0, 7.0f);
+    heap.DecreaseKey(6, 1.0f);
+    heap.DecreaseKey(1, 4.0f);
+
+    // Assert, decreasing to a higher key is ignored
+    EXPECT_TRUE(heap.Contains(6));
+    EXPECT_FALSE(heap.Contains(2));
+    EXPECT_EQ(heap.Pop(), 6u);
+    EXPECT_EQ(heap.Pop(), 1u);
+    EXPECT_EQ(heap.Pop(), 3u);
+    EXPECT_EQ(heap.Pop(), 0u);
+    EXPECT_TRUE(heap.Empty());
+    EXPECT_FALSE(heap.Contains(6));
+}
+
+TEST(IndexedBinaryHeapTests, ClearForgetsItems)
+{
+    // Arrange
+    IndexedBinaryHeap heap {};
+    heap.Reserve(4);
+    heap.Push(2, 1.0f);
+    heap.Push(3, 2.0f);
+
+    // Act
+    heap.Clear();
+    heap.Push(3, 5.0f);
+
+    // Assert
+    EXPECT_FALSE(heap.Contains(2));
+    EXPECT_TRUE(heap.Contains(3));
+    EXPECT_EQ(heap.Size(), 1u);
+}
+
+TEST(NavMeshQueryTests, StartIsGoal)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(4, 4);
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+
+    // Act
+    bool found = query.FindCorridor(navMesh, 5, 5, corridor);
+
+    // Assert
+    EXPECT_TRUE(found);
+    EXPECT_EQ(corridor, std::vector<uint32_t> { 5 });
+    EXPECT_FLOAT_EQ(query.GetLastCost(), 0.0f);
+}
+
+TEST(NavMeshQueryTests, UnreachableGoal)
+{
+    // Arrange, two islands separated by a column of removed quads
+    NavMesh navMesh = MakeGridNavMesh(5, 3, 1.0f, 0.0f, [](uint32_t x, uint32_t)
+        { return x != 2; });
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor { 1, 2, 3 };
+
+    // Act
+    bool found = query.FindCorridor(navMesh, 0, navMesh.GetTriangleCount() - 1, corridor);
+
+    // Assert
+    EXPECT_FALSE(found);
+    EXPECT_TRUE(corridor.empty());
+}
+
+TEST(NavMeshQueryTests, InvalidTriangles)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(2, 2);
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+
+    // Act & Assert
+    EXPECT_FALSE(query.FindCorridor(navMesh, 0, NavMesh::INVALID_TRIANGLE, corridor));
+    EXPECT_FALSE(query.FindCorridor(NavMesh {}, 0, 0, corridor));
+}
+
+TEST(NavMeshQueryTests, MatchesReferenceDijkstra)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(40, 40, 0.3f, 99);
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+    std::mt19937 random { 5 };
+    std::uniform_int_distribution<uint32_t> triangles { 0, navMesh.GetTriangleCount() - 1 };
+    uint32_t reachable = 0;
+
+    // Act & Assert, the same query object is reused to also cover the generation counter
+    for (uint32_t i = 0; i < 300; ++i)
+    {
+        uint32_t start = triangles(random);
+        uint32_t goal = triangles(random);
+        float reference = ReferenceDijkstra(navMesh, start, goal);
+
+        bool found = query.FindCorridor(navMesh, start, goal, corridor);
+        ASSERT_EQ(found, reference != std::numeric_limits<float>::infinity());
+
+        if (!found)
+            continue;
+
+        reachable++;
+        EXPECT_NEAR(query.GetLastCost(), reference, 0.001f);
+        EXPECT_EQ(corridor.front(), start);
+        EXPECT_EQ(corridor.back(), goal);
+
+        float corridorCost = 0.0f;
+        for (size_t j = 1; j < corridor.size(); ++j)
+        {
+            ASSERT_TRUE(AreAdjacent(navMesh, corridor[j - 1], corridor[j]));
+            corridorCost += glm::distance(navMesh.GetTriangle(corridor[j - 1]).centre, navMesh.GetTriangle(corridor[j]).centre);
+        }
+
+        EXPECT_NEAR(corridorCost, query.GetLastCost(), 0.001f);
+    }
+
+    EXPECT_GT(reachable, 0u);
+}
+
+TEST(NavMeshQueryTests, HeuristicLimitsExpansion)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(50, 50);
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+
+    // Act, neighbouring quads along the bottom row
+    query.FindCorridor(navMesh, 0, 10, corridor);
+
+    // Assert, a straight corridor should not flood the whole grid
+    EXPECT_LT(query.GetLastExpandedCount(), navMesh.GetTriangleCount() / 10);
+}
@@ -0,0 +1,146 @@
+#include "navmesh.hpp"
+#include "navmesh_test_helpers.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+
+namespace
+{
+
+float DistanceSquaredTo(const NavMesh& navMesh, uint32_t triangleIndex, const glm::vec3& point)
+{
+    const NavMesh::Triangle& triangle = navMesh.GetTriangle(triangleIndex);
+    const auto& vertices = navMesh.GetVertices();
+
+    return NavMeshSpatialIndex::DistanceSquaredToTriangle(point, vertices[triangle.indices[0]], vertices[triangle.indices[1]], vertices[triangle.indices[2]]);
+}
+
+// Mix of tiny slivers and huge triangles at different heights, the worst case for a uniform grid
+NavMesh MakeTriangleSoup(uint32_t triangleCount, std::mt19937& random)
+{
+    std::uniform_real_distribution<float> positions { -50.0f, 50.0f };
+    std::uniform_real_distribution<float> heights { -5.0f, 5.0f };
+    std::uniform_real_distribution<float> sizes { 0.05f, 1.0f };
+    std::uniform_int_distribution<uint32_t> large { 0, 20 };
+
+    std::vector<glm::vec3> vertices {};
+    std::vector<uint32_t> indices {};
+
+    for (uint32_t i = 0; i < triangleCount; ++i)
+    {
+        float size = sizes(random) * (large(random) == 0 ? 30.0f : 3.0f);
+        glm::vec3 origin { positions(random), heights(random), positions(random) };
+
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            indices.emplace_back(static_cast<uint32_t>(vertices.size()));
+            vertices.emplace_back(origin + glm::vec3 { positions(random), heights(random) * 0.1f, positions(random) } * (size / 50.0f));
+        }
+    }
+
+    return NavMesh { std::move(vertices), std::move(indices) };
+}
+
+void ExpectMatchesBruteForce(const NavMesh& navMesh, const glm::vec3& point)
+{
+    uint32_t indexed = navMesh.FindClosestTriangle(point);
+    uint32_t bruteForce = navMesh.FindClosestTriangleBruteForce(point);
+
+    ASSERT_NE(indexed, NavMesh::INVALID_TRIANGLE);
+    ASSERT_NE(bruteForce, NavMesh::INVALID_TRIANGLE);
+
+    // Points on a shared edge are equally close to multiple triangles, so compare the distances
+    EXPECT_FLOAT_EQ(DistanceSquaredTo(navMesh, indexed, point), DistanceSquaredTo(navMesh, bruteForce, point));
+}
+
+}
+
+TEST(NavMeshSpatialIndexTests, ClosestPointOnTriangle)
+{
+    // Arrange
+    glm::vec3 a { 0.0f, 0.0f, 0.0f };
+    glm::vec3 b { 2.0f, 0.0f, 0.0f };
+    glm::vec3 c { 0.0f, 0.0f, 2.0f };
+
+    // Act & Assert
+    EXPECT_EQ(NavMeshSpatialIndex::ClosestPointOnTriangle(glm::vec3 { 0.5f, 3.0f, 0.5f }, a, b, c), (glm::vec3 { 0.5f, 0.0f, 0.5f }));
+    EXPECT_EQ(NavMeshSpatialIndex::ClosestPointOnTriangle(glm::vec3 { -1.0f, 0.0f, -1.0f }, a, b, c), a);
+    EXPECT_EQ(NavMeshSpatialIndex::ClosestPointOnTriangle(glm::vec3 { 1.0f, 0.0f, -4.0f }, a, b, c), (glm::vec3 { 1.0f, 0.0f, 0.0f }));
+    EXPECT_EQ(NavMeshSpatialIndex::ClosestPointOnTriangle(glm::vec3 { 2.0f, 0.0f, 2.0f }, a, b, c), (glm::vec3 { 1.0f, 0.0f, 1.0f }));
+    EXPECT_FLOAT_EQ(NavMeshSpatialIndex::DistanceSquaredToTriangle(glm::vec3 { 0.5f, 3.0f, 0.5f }, a, b, c), 9.0f);
+}
+
+TEST(NavMeshSpatialIndexTests, EmptyNavMesh)
+{
+    // Arrange
+    NavMesh navMesh {};
+
+    // Act & Assert
+    EXPECT_TRUE(navMesh.GetSpatialIndex().IsEmpty());
+    EXPECT_EQ(navMesh.FindClosestTriangle(glm::vec3 { 0.0f }), NavMesh::INVALID_TRIANGLE);
+}
+
+TEST(NavMeshSpatialIndexTests, FindsTriangleUnderPoint)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(10, 10);
+
+    // Act
+    uint32_t triangle = navMesh.FindClosestTriangle(glm::vec3 { -4.8f, 0.5f, -4.9f });
+
+    // Assert, the first quad lies at the min corner and its first triangle contains the point
+    EXPECT_EQ(triangle, 0u);
+    EXPECT_FLOAT_EQ(DistanceSquaredTo(navMesh, triangle, glm::vec3 { -4.8f, 0.5f, -4.9f }), 0.25f);
+}
+
+TEST(NavMeshSpatialIndexTests, BuildsAdjacency)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(3, 3);
+
+    // Act
+    uint32_t edgeCount = 0;
+    for (const auto& triangle : navMesh.GetTriangles())
+        edgeCount += triangle.adjacentTriangleCount;
+
+    // Assert, every interior edge of a 3x3 quad grid is shared by two triangles: 9 diagonals and 12 grid edges
+    EXPECT_EQ(edgeCount, (9u + 12u) * 2u);
+    EXPECT_EQ(navMesh.GetTriangle(0).adjacentTriangleCount, 1u);
+    EXPECT_EQ(navMesh.GetTriangle(0).adjacentTriangleIndices[0], 1u);
+}
+
+TEST(NavMeshSpatialIndexTests, MatchesBruteForceOnGrid)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(64, 48, 1.5f, 2.0f);
+    std::mt19937 random { 31 };
+    std::uniform_real_distribution<float> horizontal { -60.0f, 60.0f };
+    std::uniform_real_distribution<float> vertical { -10.0f, 10.0f };
+
+    // Act & Assert, includes points outside of the navmesh bounds
+    for (uint32_t i = 0; i < 2000; ++i)
+        ExpectMatchesBruteForce(navMesh, glm::vec3 { horizontal(random), vertical(random), horizontal(random) });
+}
+
+TEST(NavMeshSpatialIndexTests, MatchesBruteForceOnTriangleSoup)
+{
+    // Arrange
+    std::mt19937 random { 1234 };
+    NavMesh navMesh = MakeTriangleSoup(3000, random);
+    std::uniform_real_distribution<float> horizontal { -80.0f, 80.0f };
+    std::uniform_real_distribution<float> vertical { -20.0f, 20.0f };
+
+    // Act & Assert
+    for (uint32_t i = 0; i < 2000; ++i)
+        ExpectMatchesBruteForce(navMesh, glm::vec3 { horizontal(random), vertical(random), horizontal(random) });
+}
+
+TEST(NavMeshSpatialIndexTests, SingleTriangle)
+{
+    // Arrange
+    NavMesh navMesh { { glm::vec3 { 0.0f }, glm::vec3 { 1.0f, 0.0f, 0.0f }, glm::vec3 { 0.0f, 0.0f, 1.0f } }, { 0, 1, 2 } };
+
+    // Act & Assert
+    EXPECT_EQ(navMesh.FindClosestTriangle(glm::vec3 { 500.0f, -20.0f, -300.0f }), 0u);
+    EXPECT_EQ(navMesh.FindClosestTriangle(glm::vec3 { 0.2f, 0.0f, 0.2f }), 0u);
+}
@@ -0,0 +1,167 @@
+#include "navmesh.hpp"
+#include "navmesh_query.hpp"
+#include "navmesh_test_helpers.hpp"
+#include "pathfinding_module.hpp"
+
+#include <glm/geometric.hpp>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::vector<glm::vec3> FindStraightPath(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end)
+{
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+    std::vector<glm::vec3> points {};
+
+    EXPECT_TRUE(query.FindCorridor(navMesh, navMesh.FindClosestTriangle(start), navMesh.FindClosestTriangle(end), corridor));
+    query.FindStraightPath(navMesh, corridor, start, end, points);
+
+    return points;
+}
+
+float PathLength(const std::vector<glm::vec3>& points)
+{
+    float length = 0.0f;
+    for (size_t i = 1; i < points.size(); ++i)
+        length += glm::distance(points[i - 1], points[i]);
+
+    return length;
+}
+
+void ExpectNear(const glm::vec3& a, const glm::vec3& b)
+{
+    EXPECT_NEAR(a.x, b.x, 0.0001f);
+    EXPECT_NEAR(a.y, b.y, 0.0001f);
+    EXPECT_NEAR(a.z, b.z, 0.0001f);
+}
+
+}
+
+TEST(NavMeshStraightPathTests, StraightLineWithoutCorners)
+{
+    // Arrange, walking along the bottom row of quads
+    NavMesh navMesh = MakeGridNavMesh(10, 10);
+
+    // Act
+    auto points = FindStraightPath(navMesh, glm::vec3 { -4.5f, 0.0f, -4.5f }, glm::vec3 { 4.5f, 0.0f, -4.5f });
+
+    // Assert
+    ASSERT_EQ(points.size(), 2u);
+    ExpectNear(points[0], glm::vec3 { -4.5f, 0.0f, -4.5f });
+    ExpectNear(points[1], glm::vec3 { 4.5f, 0.0f, -4.5f });
+}
+
+TEST(NavMeshStraightPathTests, BendsAroundInnerCorner)
+{
+    // Arrange, L shaped corridor along the left column and top row of a 4x4 grid
+    NavMesh navMesh = MakeGridNavMesh(4, 4, 1.0f, 0.0f, [](uint32_t x, uint32_t z)
+        { return x == 0 || z == 3; });
+
+    // Act
+    auto points = FindStraightPath(navMesh, glm::vec3 { -1.5f, 0.0f, -1.5f }, glm::vec3 { 1.5f, 0.0f, 1.5f });
+
+    // Assert, the shortest path touches the corner of the L and nothing else
+    ASSERT_EQ(points.size(), 3u);
+    ExpectNear(points[1], glm::vec3 { -1.0f, 0.0f, 1.0f });
+    EXPECT_NEAR(PathLength(points), 2.0f * glm::sqrt(6.5f), 0.0001f);
+}
+
+TEST(NavMeshStraightPathTests, BendsAroundBothCornersOfObstacle)
+{
+    // Arrange, U shaped corridor around a 3x2 block of removed quads
+    NavMesh navMesh = MakeGridNavMesh(5, 3, 1.0f, 0.0f, [](uint32_t x, uint32_t z)
+        { return x == 0 || x == 4 || z == 2; });
+
+    // Act
+    auto points = FindStraightPath(navMesh, glm::vec3 { -2.0f, 0.0f, -1.0f }, glm::vec3 { 2.0f, 0.0f, -1.0f });
+
+    // Assert
+    ASSERT_EQ(points.size(), 4u);
+    ExpectNear(points[1], glm::vec3 { -1.5f, 0.0f, 0.5f });
+    ExpectNear(points[2], glm::vec3 { 1.5f, 0.0f, 0.5f });
+    EXPECT_NEAR(PathLength(points), 2.0f * glm::sqrt(2.5f) + 3.0f, 0.0001f);
+}
+
+TEST(NavMeshStraightPathTests, ProjectsEndpointsOntoNavMesh)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(4, 4);
+
+    // Act
+    auto points = FindStraightPath(navMesh, glm::vec3 { -1.5f, 2.0f, -1.5f }, glm::vec3 { -1.2f, 3.0f, -1.6f });
+
+    // Assert, start and end in the same quad still give a path of two points
+    ASSERT_EQ(points.size(), 2u);
+    ExpectNear(points[0], glm::vec3 { -1.5f, 0.0f, -1.5f });
+    ExpectNear(points[1], glm::vec3 { -1.2f, 0.0f, -1.6f });
+}
+
+TEST(NavMeshStraightPathTests, ShortestPathInsideCorridor)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(30, 30, 0.3f, 3);
+    NavMeshQuery query {};
+    std::vector<uint32_t> corridor {};
+    std::vector<glm::vec3> points {};
+    std::mt19937 random { 17 };
+    std::uniform_int_distribution<uint32_t> triangles { 0, navMesh.GetTriangleCount() - 1 };
+
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+        uint32_t start = triangles(random);
+        uint32_t goal = triangles(random);
+
+        if (!query.FindCorridor(navMesh, start, goal, corridor))
+            continue;
+
+        // Act
+        glm::vec3 startPoint = navMesh.GetTriangle(start).centre;
+        glm::vec3 endPoint = navMesh.GetTriangle(goal).centre;
+        query.FindStraightPath(navMesh, corridor, startPoint, endPoint, points);
+
+        // Assert, never longer than walking from centre to centre
+        std::vector<glm::vec3> centres {};
+        for (uint32_t triangle : corridor)
+            centres.emplace_back(navMesh.GetTriangle(triangle).centre);
+
+        EXPECT_LE(PathLength(points), PathLength(centres) + 0.0001f);
+
+        // Every bend is a navmesh vertex
+        for (size_t j = 1; j + 1 < points.size(); ++j)
+        {
+            const auto& vertices = navMesh.GetVertices();
+            EXPECT_NE(std::find(vertices.begin(), vertices.end(), points[j]), vertices.end());
+        }
+
+        // And no segment leaves the navmesh
+        for (size_t j = 1; j < points.size(); ++j)
+        {
+            for (float t = 0.05f; t < 1.0f; t += 0.1f)
+            {
+                glm::vec3 sample = glm::mix(points[j - 1], points[j], t);
+                uint32_t triangle = navMesh.FindClosestTriangle(sample);
+                EXPECT_NEAR(glm::distance(navMesh.ClosestPointOnTriangle(triangle, sample), sample), 0.0f, 0.0001f);
+            }
+        }
+    }
+}
+
+TEST(NavMeshStraightPathTests, ModuleSmoothsPaths)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(4, 4, 1.0f, 0.0f, [](uint32_t x, uint32_t z)
+        { return x == 0 || z == 3; });
+
+    PathfindingModule module {};
+    module.SetNavigationMesh(navMesh.GetVertices(), navMesh.GetIndices());
+
+    // Act
+    ComputedPath smoothed = module.FindPath(glm::vec3 { -1.5f, 0.0f, -1.5f }, glm::vec3 { 1.5f, 0.0f, 1.5f });
+    ComputedPath unsmoothed = module.FindPath(glm::vec3 { -1.5f, 0.0f, -1.5f }, glm::vec3 { 1.5f, 0.0f, 1.5f }, false);
+
+    // Assert
+    EXPECT_EQ(smoothed.waypoints.size(), 3u);
+    EXPECT_GT(unsmoothed.waypoints.size(), smoothed.waypoints.size());
+}
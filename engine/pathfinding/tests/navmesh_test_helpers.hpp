@@ -0,0 +1,63 @@
+#pragma once
+
+#include "navmesh.hpp"
+
+#include <cmath>
+#include <glm/vec3.hpp>
+#include <random>
+#include <vector>
+
+// Grid of quads split into two triangles each, centred on the origin, with cells of cellSize by cellSize.
+// The predicate is called with the x and z of every quad and decides if it is part of the navmesh.
+template <typename Predicate>
+NavMesh MakeGridNavMesh(uint32_t width, uint32_t depth, float cellSize, float heightVariation, Predicate&& isWalkable)
+{
+    std::vector<glm::vec3> vertices {};
+    std::vector<uint32_t> indices {};
+
+    const glm::vec3 offset { static_cast<float>(width) * cellSize * 0.5f, 0.0f, static_cast<float>(depth) * cellSize * 0.5f };
+
+    for (uint32_t z = 0; z <= depth; ++z)
+    {
+        for (uint32_t x = 0; x <= width; ++x)
+        {
+            float height = std::sin(static_cast<float>(x) * 0.3f) * std::cos(static_cast<float>(z) * 0.3f) * heightVariation;
+            vertices.emplace_back(glm::vec3 { static_cast<float>(x) * cellSize, height, static_cast<float>(z) * cellSize } - offset);
+        }
+    }
+
+    for (uint32_t z = 0; z < depth; ++z)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            if (!isWalkable(x, z))
+                continue;
+
+            uint32_t i = z * (width + 1) + x;
+            indices.insert(indices.end(), { i, i + width + 1, i + 1, i + 1, i + width + 1, i + width + 2 });
+        }
+    }
+
+    return NavMesh { std::move(vertices), std::move(indices) };
+}
+
+// Makes width * depth * 2 triangles
+inline NavMesh MakeGridNavMesh(uint32_t width, uint32_t depth, float cellSize = 1.0f, float heightVariation = 0.0f)
+{
+    return MakeGridNavMesh(width, depth, cellSize, heightVariation, [](uint32_t, uint32_t)
+        { return true; });
+}
+
+// Grid with randomly removed quads acting as obstacles, so paths have to go around them
+inline NavMesh MakeObstacleNavMesh(uint32_t width, uint32_t depth, float blockedFraction, uint32_t seed)
+{
+    std::mt19937 random { seed };
+    std::bernoulli_distribution blocked { blockedFraction };
+
+    std::vector<bool> walkable(width * depth);
+    for (uint32_t i = 0; i < walkable.size(); ++i)
+        walkable[i] = !blocked(random);
+
+    return MakeGridNavMesh(width, depth, 1.0f, 0.0f, [&](uint32_t x, uint32_t z)
+        { return walkable[z * width + x]; });
+}
@@ -0,0 +1,313 @@
+#include "navmesh.hpp"
+#include "navmesh_query.hpp"
+#include "navmesh_test_helpers.hpp"
+#include "path_query_service.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace
+{
+
+constexpr uint32_t MAX_UPDATES = 10000;
+
+// Keeps updating until nothing is pending or running, returns the amount of updates it took
+uint32_t UpdateUntilIdle(PathQueryService& service, const NavMesh& navMesh, ThreadPool* threadPool = nullptr)
+{
+    uint32_t updates = 0;
+
+    // One more update after the searches stopped running, to collect their results
+    do
+    {
+        service.Update(navMesh, threadPool);
+        updates++;
+    } while ((service.GetPendingCount() > 0 || service.GetRunningCount() > 0) && updates < MAX_UPDATES);
+
+    service.WaitForSearches();
+    service.Update(navMesh, threadPool);
+
+    return updates;
+}
+
+std::vector<glm::vec3> FindPathDirectly(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end)
+{
+    NavMeshQuery query {};
+    std::vector<glm::vec3> points {};
+    query.FindPath(navMesh, start, end, true, points);
+
+    return points;
+}
+
+glm::vec3 RandomPoint(std::mt19937& random, float extent)
+{
+    std::uniform_real_distribution<float> distribution { -extent, extent };
+    return glm::vec3 { distribution(random), 0.0f, distribution(random) };
+}
+
+}
+
+TEST(PathQueryServiceTests, PolledResultMatchesDirectSearch)
+{
+    // Arrange
+    NavMesh navMesh = MakeObstacleNavMesh(30, 30, 0.2f, 8);
+    PathQueryService service {};
+    glm::vec3 start { -14.5f, 0.0f, -14.5f };
+    glm::vec3 end { 14.5f, 0.0f, 14.5f };
+
+    // Act
+    PathRequestHandle handle = service.Submit(start, end);
+    EXPECT_EQ(service.GetStatus(handle), PathRequestStatus::ePENDING);
+    EXPECT_FALSE(service.TakeResult(handle).has_value());
+
+    UpdateUntilIdle(service, navMesh);
+
+    // Assert
+    auto expected = FindPathDirectly(navMesh, start, end);
+    EXPECT_EQ(service.GetStatus(handle), expected.empty() ? PathRequestStatus::eFAILED : PathRequestStatus::eSUCCEEDED);
+
+    auto result = service.TakeResult(handle);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, expected);
+    EXPECT_EQ(service.GetStatus(handle), PathRequestStatus::eINVALID);
+}
+
+TEST(PathQueryServiceTests, ConcurrentRequestsOnThreadPool)
+{
+    // Arrange
+    constexpr uint32_t REQUEST_COUNT = 200;
+
+    NavMesh navMesh = MakeObstacleNavMesh(60, 60, 0.25f, 21);
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    PathQueryService service { PathQueryBudget { 2048, 4, 1000 } };
+    std::mt19937 random { 4 };
+
+    std::vector<std::pair<glm::vec3, glm::vec3>> endpoints {};
+    std::vector<PathRequestHandle> handles {};
+
+    for (uint32_t i = 0; i < REQUEST_COUNT; ++i)
+    {
+        endpoints.emplace_back(RandomPoint(random, 29.0f), RandomPoint(random, 29.0f));
+        handles.emplace_back(service.Submit(endpoints.back().first, endpoints.back().second));
+    }
+
+    // Act
+    UpdateUntilIdle(service, navMesh, &threadPool);
+
+    // Assert, every search ran on its own query, so the results are the same as searching one by one
+    for (uint32_t i = 0; i < REQUEST_COUNT; ++i)
+    {
+        auto result = service.TakeResult(handles[i]);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(*result, FindPathDirectly(navMesh, endpoints[i].first, endpoints[i].second));
+    }
+}
+
+TEST(PathQueryServiceTests, CallbackOnUpdatingThread)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(20, 20);
+    ThreadPool threadPool { 2 };
+    threadPool.Start();
+
+    PathQueryService service {};
+    glm::vec3 start { -9.5f, 0.0f, -9.5f };
+    glm::vec3 end { 9.5f, 0.0f, 9.5f };
+    uint32_t calls = 0;
+    std::thread::id callingThread {};
+    std::vector<glm::vec3> points {};
+
+    // Act
+    PathRequestHandle handle = service.Submit(start, end, true,
+        [&](PathRequestHandle, PathRequestStatus status, const std::vector<glm::vec3>& path)
+        {
+            calls++;
+            callingThread = std::this_thread::get_id();
+            points = path;
+            EXPECT_EQ(status, PathRequestStatus::eSUCCEEDED);
+        });
+
+    UpdateUntilIdle(service, navMesh, &threadPool);
+
+    // Assert, results passed to a callback are not kept around
+    EXPECT_EQ(calls, 1u);
+    EXPECT_EQ(callingThread, std::this_thread::get_id());
+    EXPECT_EQ(points, FindPathDirectly(navMesh, start, end));
+    EXPECT_EQ(service.GetStatus(handle), PathRequestStatus::eINVALID);
+}
+
+TEST(PathQueryServiceTests, CancelPendingAndRunning)
+{
+    // Arrange, a budget this low keeps the search running for many updates
+    NavMesh navMesh = MakeObstacleNavMesh(40, 40, 0.2f, 2);
+    PathQueryService service { PathQueryBudget { 4, 1, 100 } };
+    uint32_t calls = 0;
+    auto callback = [&](PathRequestHandle, PathRequestStatus, const std::vector<glm::vec3>&)
+    { calls++; };
+
+    PathRequestHandle running = service.Submit(glm::vec3 { -19.5f, 0.0f, -19.5f }, glm::vec3 { 19.5f, 0.0f, 19.5f }, true, callback);
+    PathRequestHandle pending = service.Submit(glm::vec3 { -19.5f, 0.0f, 19.5f }, glm::vec3 { 19.5f, 0.0f, -19.5f }, true, callback);
+
+    service.Update(navMesh, nullptr);
+    ASSERT_EQ(service.GetRunningCount(), 1u);
+    ASSERT_EQ(service.GetPendingCount(), 1u);
+
+    // Act
+    service.Cancel(running);
+    service.Cancel(pending);
+    UpdateUntilIdle(service, navMesh);
+
+    // Assert
+    EXPECT_EQ(calls, 0u);
+    EXPECT_EQ(service.GetStatus(running), PathRequestStatus::eINVALID);
+    EXPECT_EQ(service.GetStatus(pending), PathRequestStatus::eINVALID);
+    EXPECT_EQ(service.GetRunningCount(), 0u);
+    EXPECT_EQ(service.GetPendingCount(), 0u);
+}
+
+TEST(PathQueryServiceTests, CancelAll)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(20, 20);
+    ThreadPool threadPool { 2 };
+    threadPool.Start();
+
+    PathQueryService service { PathQueryBudget { 8, 2, 100 } };
+    std::vector<PathRequestHandle> handles {};
+
+    for (uint32_t i = 0; i < 5; ++i)
+        handles.emplace_back(service.Submit(glm::vec3 { -9.5f, 0.0f, -9.5f }, glm::vec3 { 9.5f, 0.0f, 9.5f }));
+
+    service.Update(navMesh, &threadPool);
+
+    // Act
+    service.CancelAll();
+
+    // Assert
+    for (auto handle : handles)
+        EXPECT_EQ(service.GetStatus(handle), PathRequestStatus::eINVALID);
+
+    EXPECT_EQ(service.GetRunningCount(), 0u);
+    EXPECT_EQ(service.GetPendingCount(), 0u);
+}
+
+TEST(PathQueryServiceTests, StaysWithinBudget)
+{
+    // Arrange
+    constexpr uint32_t EXPANSION_BUDGET = 16;
+    constexpr uint32_t CONCURRENT_SEARCHES = 2;
+
+    NavMesh navMesh = MakeObstacleNavMesh(40, 40, 0.2f, 6);
+    PathQueryService service { PathQueryBudget { EXPANSION_BUDGET, CONCURRENT_SEARCHES, 1000 } };
+    std::mt19937 random { 12 };
+    std::vector<PathRequestHandle> handles {};
+
+    for (uint32_t i = 0; i < 10; ++i)
+        handles.emplace_back(service.Submit(RandomPoint(random, 19.0f), RandomPoint(random, 19.0f)));
+
+    // Act & Assert
+    uint32_t updates = 0;
+    uint32_t totalExpansions = 0;
+
+    while ((service.GetPendingCount() > 0 || service.GetRunningCount() > 0) && updates < MAX_UPDATES)
+    {
+        service.Update(navMesh, nullptr);
+        updates++;
+
+        EXPECT_LE(service.GetRunningCount(), CONCURRENT_SEARCHES);
+        EXPECT_LE(service.GetExpansionsLastUpdate(), EXPANSION_BUDGET);
+        totalExpansions += service.GetExpansionsLastUpdate();
+    }
+
+    service.Update(navMesh, nullptr);
+
+    // The work got spread over multiple updates, but every request finished
+    EXPECT_GE(updates, totalExpansions / EXPANSION_BUDGET);
+    EXPECT_GT(updates, 10u);
+
+    for (auto handle : handles)
+        EXPECT_NE(service.GetStatus(handle), PathRequestStatus::ePENDING);
+}
+
+TEST(PathQueryServiceTests, HierarchicalSearchesStayWithinBudget)
+{
+    // Arrange
+    constexpr uint32_t EXPANSION_BUDGET = 64;
+    constexpr uint32_t CONCURRENT_SEARCHES = 4;
+    constexpr uint32_t REQUEST_COUNT = 20;
+
+    NavMesh navMesh = MakeObstacleNavMesh(40, 40, 0.2f, 6);
+    PathQueryService service { PathQueryBudget { EXPANSION_BUDGET, CONCURRENT_SEARCHES, 1000 } };
+    service.SetHierarchical(true);
+
+    std::mt19937 random { 12 };
+    std::vector<PathRequestHandle> handles {};
+
+    for (uint32_t i = 0; i < REQUEST_COUNT; ++i)
+        handles.emplace_back(service.Submit(RandomPoint(random, 19.0f), RandomPoint(random, 19.0f)));
+
+    // Act
+    uint32_t updates = 0;
+    uint32_t totalExpansions = 0;
+    uint32_t largestUpdate = 0;
+
+    while ((service.GetPendingCount() > 0 || service.GetRunningCount() > 0) && updates < MAX_UPDATES)
+    {
+        service.Update(navMesh, nullptr);
+        updates++;
+
+        EXPECT_LE(service.GetRunningCount(), CONCURRENT_SEARCHES);
+        totalExpansions += service.GetExpansionsLastUpdate();
+        largestUpdate = std::max(largestUpdate, service.GetExpansionsLastUpdate());
+    }
+
+    service.Update(navMesh, nullptr);
+    totalExpansions += service.GetExpansionsLastUpdate();
+
+    // Assert, searches can go over the budget of their own update, but that holds back the searches of the next updates
+    EXPECT_GT(updates, REQUEST_COUNT / CONCURRENT_SEARCHES);
+    EXPECT_LE(totalExpansions, updates * EXPANSION_BUDGET + largestUpdate);
+
+    for (auto handle : handles)
+        EXPECT_NE(service.GetStatus(handle), PathRequestStatus::ePENDING);
+}
+
+TEST(PathQueryServiceTests, UnreachableGoalFails)
+{
+    // Arrange, two islands separated by a column of removed quads
+    NavMesh navMesh = MakeGridNavMesh(5, 3, 1.0f, 0.0f, [](uint32_t x, uint32_t)
+        { return x != 2; });
+    PathQueryService service {};
+
+    // Act
+    PathRequestHandle handle = service.Submit(glm::vec3 { -2.0f, 0.0f, 0.0f }, glm::vec3 { 2.0f, 0.0f, 0.0f });
+    UpdateUntilIdle(service, navMesh);
+
+    // Assert
+    EXPECT_EQ(service.GetStatus(handle), PathRequestStatus::eFAILED);
+
+    auto result = service.TakeResult(handle);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->empty());
+}
+
+TEST(PathQueryServiceTests, UntakenResultsExpire)
+{
+    // Arrange
+    NavMesh navMesh = MakeGridNavMesh(4, 4);
+    PathQueryService service { PathQueryBudget { 1024, 1, 2 } };
+
+    PathRequestHandle handle = service.Submit(glm::vec3 { -1.5f, 0.0f, -1.5f }, glm::vec3 { 1.5f, 0.0f, 1.5f });
+    UpdateUntilIdle(service, navMesh);
+    ASSERT_EQ(service.GetStatus(handle), PathRequestStatus::eSUCCEEDED);
+
+    // Act
+    for (uint32_t i = 0; i < 3; ++i)
+        service.Update(navMesh, nullptr);
+
+    // Assert
+    EXPECT_EQ(service.GetStatus(handle), PathRequestStatus::eINVALID);
+}
@@ -0,0 +1,70 @@
+#include "components/character_controller_component.hpp"
+
+#include "components/transform_component.hpp"
+#include "components/transform_helpers.hpp"
+
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h>
+
+CharacterControllerComponent::CharacterControllerComponent(const CharacterControllerSettings& settings)
+    : settings(settings)
+{
+}
+
+void CharacterControllerComponent::Teleport(const glm::vec3& position)
+{
+    character->SetPosition(ToJoltVec3(position));
+    character->SetLinearVelocity(JPH::Vec3::sZero());
+}
+
+void CharacterControllerComponent::OnConstructCallback(JPH::PhysicsSystem& physicsSystem, entt::registry& registry, entt::entity entity)
+{
+    auto& controller = registry.get<CharacterControllerComponent>(entity);
+    const auto& settings = controller.settings;
+
+    // Offset the capsule upwards, so the position of the character is at its feet
+    const float halfHeight = 0.5f * settings.cylinderHeight;
+    JPH::RotatedTranslatedShapeSettings shapeSettings { JPH::Vec3(0.0f, halfHeight + settings.radius, 0.0f), JPH::Quat::sIdentity(), new JPH::CapsuleShape(halfHeight, settings.radius) };
+    JPH::ShapeRefC shape = shapeSettings.Create().Get();
+
+    JPH::CharacterVirtualSettings characterSettings {};
+    characterSettings.mShape = shape;
+    characterSettings.mMaxSlopeAngle = settings.maxSlopeAngle;
+    characterSettings.mMass = settings.mass;
+    characterSettings.mMaxStrength = settings.maxStrength;
+    characterSettings.mUp = JPH::Vec3::sAxisY();
+
+    // Only accept contacts that touch the bottom sphere of the capsule as supporting
+    characterSettings.mSupportingVolume = JPH::Plane(JPH::Vec3::sAxisY(), -settings.radius);
+
+    // The inner body makes the character visible to ray casts and to the other characters
+    characterSettings.mInnerBodyShape = shape;
+    characterSettings.mInnerBodyLayer = settings.layer;
+
+    glm::vec3 position { 0.0f };
+    glm::quat rotation { 1.0f, 0.0f, 0.0f, 0.0f };
+
+    if (registry.all_of<TransformComponent>(entity))
+    {
+        position = TransformHelpers::GetWorldPosition(registry, entity);
+        rotation = TransformHelpers::GetWorldRotation(registry, entity);
+    }
+
+    controller.character = new JPH::CharacterVirtual(&characterSettings, ToJoltVec3(position), ToJoltQuat(rotation), static_cast<uint64_t>(entity), &physicsSystem);
+}
+
+void CharacterControllerComponent::SetupRegistryCallbacks(entt::registry& registry, JPH::PhysicsSystem& physicsSystem)
+{
+    registry.on_construct<CharacterControllerComponent>().connect<OnConstructCallback>(physicsSystem);
+    registry.on_update<CharacterControllerComponent>().connect<OnConstructCallback>(physicsSystem);
+}
+
+void CharacterControllerComponent::DisconnectRegistryCallbacks(entt::registry& registry, JPH::PhysicsSystem& physicsSystem)
+{
+    registry.on_construct<CharacterControllerComponent>().disconnect<OnConstructCallback>(physicsSystem);
+    registry.on_update<CharacterControllerComponent>().disconnect<OnConstructCallback>(physicsSystem);
+
+    // Characters remove their inner body from the physics system when released, which has to happen while it still exists
+    for (auto [entity, controller] : registry.view<CharacterControllerComponent>().each())
+        controller.character = nullptr;
+}
@@ -2,23 +2,38 @@
 
 #include "components/transform_component.hpp"
 #include "components/transform_helpers.hpp"
+#include "physics/body_batch.hpp"
 #include "physics/collision.hpp"
+#include "physics/physics_interpolation.hpp"
+#include "physics_module.hpp"
 
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 
-RigidbodyComponent::RigidbodyComponent(JPH::BodyInterface& bodyInterface,
+RigidbodyComponent::RigidbodyComponent(PhysicsModule& physics,
     JPH::ShapeRefC shape,
     JPH::ObjectLayer layer,
     JPH::EAllowedDOFs freedom)
     : shape(shape)
     , layer(layer)
     , dofs(freedom)
-    , bodyInterface(&bodyInterface)
+    , bodyInterface(&physics.GetBodyInterface())
+    , interpolation(&physics.GetInterpolation())
 {
 }
 
-void RigidbodyComponent::OnConstructCallback(entt::registry& registry, entt::entity entity)
+void RigidbodyComponent::SetTranslation(const glm::vec3& translation)
+{
+    bodyInterface->SetPosition(bodyID, ToJoltVec3(translation), JPH::EActivation::Activate);
+    interpolation->Snap(bodyID);
+}
+
+void RigidbodyComponent::SetRotation(const glm::quat& rotation)
+{
+    bodyInterface->SetRotation(bodyID, ToJoltQuat(glm::normalize(rotation)), JPH::EActivation::Activate);
+}
+
+void RigidbodyComponent::OnConstructCallback(BodyBatch& batch, entt::registry& registry, entt::entity entity)
 {
     auto& rb = registry.get<RigidbodyComponent>(entity);
 
@@ -43,29 +58,30 @@ void RigidbodyComponent::OnConstructCallback(entt::registry& registry, entt::ent
 
     JPH::EActivation activation = motionType == JPH::EMotionType::Dynamic ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
 
-    rb.bodyID = rb.bodyInterface->CreateAndAddBody(creation, activation);
-    rb.bodyInterface->SetUserData(rb.bodyID, static_cast<uint64_t>(entity));
+    rb.bodyID = batch.CreateBody(creation, activation);
+
+    if (!rb.bodyID.IsInvalid())
+        rb.bodyInterface->SetUserData(rb.bodyID, static_cast<uint64_t>(entity));
 }
 
-void RigidbodyComponent::OnDestroyCallback(entt::registry& registry, entt::entity entity)
+void RigidbodyComponent::OnDestroyCallback(BodyBatch& batch, entt::registry& registry, entt::entity entity)
 {
     auto& rb = registry.get<RigidbodyComponent>(entity);
 
     if (!rb.bodyID.IsInvalid())
     {
-        rb.bodyInterface->RemoveBody(rb.bodyID);
-        rb.bodyInterface->DestroyBody(rb.bodyID);
+        batch.DestroyBody(rb.bodyID);
     }
 }
 
-void RigidbodyComponent::SetupRegistryCallbacks(entt::registry& registry)
+void RigidbodyComponent::SetupRegistryCallbacks(entt::registry& registry, BodyBatch& batch)
 {
-    registry.on_construct<RigidbodyComponent>().connect<OnConstructCallback>();
-    registry.on_destroy<RigidbodyComponent>().connect<OnDestroyCallback>();
+    registry.on_construct<RigidbodyComponent>().connect<OnConstructCallback>(batch);
+    registry.on_destroy<RigidbodyComponent>().connect<OnDestroyCallback>(batch);
 }
 
-void RigidbodyComponent::DisconnectRegistryCallbacks(entt::registry& registry)
+void RigidbodyComponent::DisconnectRegistryCallbacks(entt::registry& registry, BodyBatch& batch)
 {
-    registry.on_construct<RigidbodyComponent>().disconnect<OnConstructCallback>();
-    registry.on_destroy<RigidbodyComponent>().disconnect<OnDestroyCallback>();
+    registry.on_construct<RigidbodyComponent>().disconnect<OnConstructCallback>(batch);
+    registry.on_destroy<RigidbodyComponent>().disconnect<OnDestroyCallback>(batch);
 }
\ No newline at end of file
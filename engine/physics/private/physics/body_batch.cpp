@@ -0,0 +1,101 @@
+#include "physics/body_batch.hpp"
+
+#include "log.hpp"
+#include "physics/constants.hpp"
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include <algorithm>
+#include <cassert>
+#include <tracy/Tracy.hpp>
+
+BodyBatch::BodyBatch(JPH::PhysicsSystem& physicsSystem)
+    : _physicsSystem(physicsSystem)
+{
+}
+
+void BodyBatch::Begin()
+{
+    _depth++;
+}
+
+uint32_t BodyBatch::End()
+{
+    assert(_depth > 0 && "Ending a body batch that was never started!");
+
+    if (--_depth > 0)
+        return 0;
+
+    ZoneScopedN("Flush Body Batch");
+
+    const uint32_t count = GetQueuedCount();
+
+    Flush(_activated, JPH::EActivation::Activate);
+    Flush(_notActivated, JPH::EActivation::DontActivate);
+
+    // Rebuilding the tree is not free, so only do it when enough bodies were inserted to have degraded it
+    if (count >= PHYSICS_BATCH_OPTIMIZE_BROADPHASE_THRESHOLD)
+    {
+        ZoneScopedN("Optimize Broadphase");
+        _physicsSystem.OptimizeBroadPhase();
+    }
+
+    return count;
+}
+
+JPH::BodyID BodyBatch::CreateBody(const JPH::BodyCreationSettings& creation, JPH::EActivation activation)
+{
+    auto& bodyInterface = _physicsSystem.GetBodyInterface();
+
+    if (!IsOpen())
+        return bodyInterface.CreateAndAddBody(creation, activation);
+
+    JPH::Body* body = bodyInterface.CreateBody(creation);
+
+    if (body == nullptr)
+    {
+        bblog::error("[PHYSICS] Ran out of bodies, the maximum is {}", PHYSICS_MAX_BODIES);
+        return {};
+    }
+
+    auto& queue = activation == JPH::EActivation::Activate ? _activated : _notActivated;
+    queue.emplace_back(body->GetID());
+
+    return body->GetID();
+}
+
+void BodyBatch::DestroyBody(JPH::BodyID bodyID)
+{
+    auto& bodyInterface = _physicsSystem.GetBodyInterface();
+
+    if (bodyInterface.IsAdded(bodyID))
+    {
+        bodyInterface.RemoveBody(bodyID);
+    }
+    else
+    {
+        // Never added, so it should still be waiting in one of the queues
+        for (auto* queue : { &_activated, &_notActivated })
+        {
+            if (auto it = std::find(queue->begin(), queue->end(), bodyID); it != queue->end())
+                queue->erase(it);
+        }
+    }
+
+    bodyInterface.DestroyBody(bodyID);
+}
+
+void BodyBatch::Flush(JPH::BodyIDVector& bodies, JPH::EActivation activation)
+{
+    if (bodies.empty())
+        return;
+
+    auto& bodyInterface = _physicsSystem.GetBodyInterface();
+    const int count = static_cast<int>(bodies.size());
+
+    JPH::BodyInterface::AddState state = bodyInterface.AddBodiesPrepare(bodies.data(), count);
+    bodyInterface.AddBodiesFinalize(bodies.data(), count, state, activation);
+
+    bodies.clear();
+}
@@ -23,9 +23,17 @@ constexpr JPH::uint PHYSICS_MAX_CONTACT_CONSTRAINTS = 10240; // Old: 8192
 // Memory pool used for Physics Update
 constexpr JPH::uint PHYSICS_TEMP_ALLOCATOR_SIZE = 10 * 1024 * 1024;
 
-// If you take larger steps than 1 / 60th of a second you need to do multiple collision steps in order to keep the simulation stable.
-// Do 1 collision step per 1 / 60th of a second (round up).
+// Default fixed time step of the simulation. Taking larger steps than 1 / 60th of a second makes the simulation less stable.
+// The step can be changed at runtime through PhysicsModule::SetFixedTimeStep.
 constexpr float PHYSICS_STEPS_PER_SECOND = 1.0f / 60.0f;
 
 // If the game runs at 1 FPS then physics is the least of our concerns
 constexpr int PHYSICS_MAX_STEPS_PER_FRAME = 10;
+
+// Bodies created in a batch (when loading a level or model hierarchy) rebuild the broadphase tree once added,
+// but only when enough of them were inserted at once to make the rebuild worth its cost.
+constexpr JPH::uint PHYSICS_BATCH_OPTIMIZE_BROADPHASE_THRESHOLD = 64;
+
+// Bodies that move further than this during a single fixed step are considered teleported,
+// their rendered transform jumps to the new location instead of blending towards it.
+constexpr float PHYSICS_INTERPOLATION_SNAP_DISTANCE = 5.0f;
@@ -23,11 +23,11 @@ void PhysicsContactListener::OnContactAdded(
     auto e1 = static_cast<entt::entity>(inBody1.GetUserData());
     auto e2 = static_cast<entt::entity>(inBody2.GetUserData());
 
-    auto rb1 = registry.get<RigidbodyComponent>(e1);
-    auto rb2 = registry.get<RigidbodyComponent>(e2);
-
-    rb1.onCollisionEnter(WrenEntity { e1, &registry }, WrenEntity { e2, &registry });
-    rb2.onCollisionEnter(WrenEntity { e2, &registry }, WrenEntity { e1, &registry });
+    // Character controller bodies have no rigidbody component and no callbacks
+    if (auto* rb1 = registry.try_get<RigidbodyComponent>(e1))
+        rb1->onCollisionEnter(WrenEntity { e1, &registry }, WrenEntity { e2, &registry });
+    if (auto* rb2 = registry.try_get<RigidbodyComponent>(e2))
+        rb2->onCollisionEnter(WrenEntity { e2, &registry }, WrenEntity { e1, &registry });
 }
 
 void PhysicsContactListener::OnContactPersisted(
@@ -41,11 +41,11 @@ void PhysicsContactListener::OnContactPersisted(
     auto e1 = static_cast<entt::entity>(inBody1.GetUserData());
     auto e2 = static_cast<entt::entity>(inBody2.GetUserData());
 
-    auto rb1 = registry.get<RigidbodyComponent>(e1);
-    auto rb2 = registry.get<RigidbodyComponent>(e2);
-
-    rb1.onCollisionStay(WrenEntity { e1, &registry }, WrenEntity { e2, &registry });
-    rb2.onCollisionStay(WrenEntity { e2, &registry }, WrenEntity { e1, &registry });
+    // Character controller bodies have no rigidbody component and no callbacks
+    if (auto* rb1 = registry.try_get<RigidbodyComponent>(e1))
+        rb1->onCollisionStay(WrenEntity { e1, &registry }, WrenEntity { e2, &registry });
+    if (auto* rb2 = registry.try_get<RigidbodyComponent>(e2))
+        rb2->onCollisionStay(WrenEntity { e2, &registry }, WrenEntity { e1, &registry });
 }
 
 void PhysicsContactListener::OnContactRemoved(MAYBE_UNUSED const JPH::SubShapeIDPair& inSubShapePair)
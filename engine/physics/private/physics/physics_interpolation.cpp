@@ -0,0 +1,149 @@
+#include "physics/physics_interpolation.hpp"
+
+#include "physics/constants.hpp"
+#include "physics/jolt_to_glm.hpp"
+
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include <glm/common.hpp>
+
+#include <tracy/Tracy.hpp>
+
+void PhysicsInterpolation::RecordActiveBodies(JPH::PhysicsSystem& physicsSystem)
+{
+    ZoneScoped;
+
+    BeginStep();
+
+    JPH::BodyIDVector activeBodies;
+    physicsSystem.GetActiveBodies(JPH::EBodyType::RigidBody, activeBodies);
+
+    // Nothing else touches the bodies in between steps, so we can skip the locking
+    const JPH::BodyInterface& bodyInterface = physicsSystem.GetBodyInterfaceNoLock();
+
+    for (JPH::BodyID bodyID : activeBodies)
+    {
+        JPH::RVec3 position;
+        JPH::Quat rotation;
+        bodyInterface.GetPositionAndRotation(bodyID, position, rotation);
+
+        Record(bodyID, bodyInterface.GetUserData(bodyID), ToGLMVec3(position), ToGLMQuat(rotation));
+    }
+}
+
+void PhysicsInterpolation::BeginFrame()
+{
+    for (uint32_t index : _stopped)
+        _entries[index].stopped = false;
+
+    _stopped.clear();
+}
+
+void PhysicsInterpolation::BeginStep()
+{
+    _step++;
+
+    // Bodies that moved last step, but are not recorded again, stopped moving and need their final transform once more.
+    // A frame can take multiple steps, so they are kept until the next frame, otherwise a later step would drop them unvisited.
+    for (uint32_t index : _moving)
+    {
+        Entry& entry = _entries[index];
+
+        if (!entry.stopped)
+        {
+            entry.stopped = true;
+            _stopped.emplace_back(index);
+        }
+    }
+
+    _moving.clear();
+}
+
+void PhysicsInterpolation::Record(JPH::BodyID bodyID, uint64_t userData, const glm::vec3& position, const glm::quat& rotation)
+{
+    const uint32_t index = bodyID.GetIndex();
+
+    if (index >= _entries.size())
+        _entries.resize(index + 1);
+
+    Entry& entry = _entries[index];
+
+    // Blending only makes sense when we know where this body was at the end of the previous step
+    const bool continuous = entry.bodyID == bodyID && entry.step + 1 == _step;
+
+    entry.bodyID = bodyID;
+    entry.userData = userData;
+    entry.step = _step;
+    entry.previousPosition = entry.currentPosition;
+    entry.previousRotation = entry.currentRotation;
+    entry.currentPosition = position;
+    entry.currentRotation = rotation;
+
+    // Moving further than this in a single step means the body was teleported, so it should not slide across the level
+    const float snapDistance = PHYSICS_INTERPOLATION_SNAP_DISTANCE;
+    const glm::vec3 offset = entry.currentPosition - entry.previousPosition;
+
+    if (!continuous || glm::dot(offset, offset) > snapDistance * snapDistance)
+    {
+        entry.previousPosition = position;
+        entry.previousRotation = rotation;
+    }
+
+    _moving.emplace_back(index);
+}
+
+void PhysicsInterpolation::Snap(JPH::BodyID bodyID)
+{
+    const uint32_t index = bodyID.GetIndex();
+
+    if (index >= _entries.size() || _entries[index].bodyID != bodyID)
+        return;
+
+    Entry& entry = _entries[index];
+    entry.previousPosition = entry.currentPosition;
+    entry.previousRotation = entry.currentRotation;
+
+    // Forgetting the step it was recorded in stops the blending right away, and makes the next recorded step discontinuous
+    entry.step = 0;
+}
+
+std::optional<PhysicsInterpolation::InterpolatedTransform> PhysicsInterpolation::GetInterpolated(JPH::BodyID bodyID, float alpha) const
+{
+    const Entry* entry = FindEntry(bodyID);
+
+    if (entry == nullptr)
+        return std::nullopt;
+
+    return Interpolate(*entry, alpha);
+}
+
+void PhysicsInterpolation::Clear()
+{
+    _entries.clear();
+    _moving.clear();
+    _stopped.clear();
+}
+
+const PhysicsInterpolation::Entry* PhysicsInterpolation::FindEntry(JPH::BodyID bodyID) const
+{
+    const uint32_t index = bodyID.GetIndex();
+
+    if (index >= _entries.size() || _entries[index].bodyID != bodyID)
+        return nullptr;
+
+    return &_entries[index];
+}
+
+PhysicsInterpolation::InterpolatedTransform PhysicsInterpolation::Interpolate(const Entry& entry, float alpha) const
+{
+    // Bodies that did not move during the last step are at rest at their current transform
+    if (entry.step != _step)
+        return { entry.currentPosition, entry.currentRotation };
+
+    alpha = glm::clamp(alpha, 0.0f, 1.0f);
+
+    return {
+        glm::mix(entry.previousPosition, entry.currentPosition, alpha),
+        glm::slerp(entry.previousRotation, entry.currentRotation, alpha)
+    };
+}
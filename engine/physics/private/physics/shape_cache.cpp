@@ -0,0 +1,130 @@
+#include "physics/shape_cache.hpp"
+
+#include "hash_util.hpp"
+#include "log.hpp"
+
+#include <Jolt/Core/StreamWrapper.h>
+
+#include <sstream>
+
+ShapeCache::ShapeCache(const std::filesystem::path& directory)
+    : _derivedData(directory)
+{
+}
+
+ShapeCache::Key ShapeCache::MakeKey(PhysicsShapes type, std::span<const glm::vec3> vertices, std::span<const uint32_t> indices, const glm::vec3& scale)
+{
+    Key key = hashing::FNV1aValue(type);
+    key = hashing::FNV1aValue(static_cast<uint64_t>(vertices.size()), key);
+    key = hashing::FNV1a(vertices.data(), vertices.size_bytes(), key);
+    key = hashing::FNV1aValue(static_cast<uint64_t>(indices.size()), key);
+    key = hashing::FNV1a(indices.data(), indices.size_bytes(), key);
+    key = hashing::FNV1aValue(scale, key);
+    return key;
+}
+
+JPH::ShapeRefC ShapeCache::Find(Key key)
+{
+    {
+        std::scoped_lock lock { _mutex };
+
+        if (auto it = _shapes.find(key); it != _shapes.end())
+        {
+            _stats.memoryHits++;
+            return it->second;
+        }
+    }
+
+    JPH::ShapeRefC shape = _diskEnabled ? LoadFromDisk(key) : nullptr;
+
+    std::scoped_lock lock { _mutex };
+
+    if (shape == nullptr)
+    {
+        _stats.misses++;
+        return nullptr;
+    }
+
+    _stats.diskHits++;
+
+    // Another thread might have restored the same shape in the meantime, make sure everyone shares one instance
+    auto [it, inserted] = _shapes.emplace(key, shape);
+    return it->second;
+}
+
+void ShapeCache::Store(Key key, const JPH::ShapeRefC& shape)
+{
+    {
+        std::scoped_lock lock { _mutex };
+        _shapes[key] = shape;
+    }
+
+    if (_diskEnabled)
+        SaveToDisk(key, shape);
+}
+
+void ShapeCache::ClearMemory()
+{
+    std::scoped_lock lock { _mutex };
+    _shapes.clear();
+}
+
+std::filesystem::path ShapeCache::GetFilePath(Key key) const
+{
+    return _derivedData.GetFilePath(MakeDerivedDataKey(key));
+}
+
+ShapeCache::Stats ShapeCache::GetStats() const
+{
+    std::scoped_lock lock { _mutex };
+    return _stats;
+}
+
+void ShapeCache::ResetStats()
+{
+    std::scoped_lock lock { _mutex };
+    _stats = {};
+}
+
+DerivedDataCache::Key ShapeCache::MakeDerivedDataKey(Key key)
+{
+    return DerivedDataCache::Key { std::string { PROCESSOR_NAME }, CACHE_VERSION, key, 0 };
+}
+
+JPH::ShapeRefC ShapeCache::LoadFromDisk(Key key)
+{
+    const std::optional<std::vector<std::byte>> bytes = _derivedData.Load(MakeDerivedDataKey(key));
+
+    if (!bytes.has_value())
+        return nullptr;
+
+    std::istringstream file { std::string { reinterpret_cast<const char*>(bytes->data()), bytes->size() } };
+    JPH::StreamInWrapper stream { file };
+    JPH::Shape::IDToShapeMap shapeMap {};
+    JPH::Shape::IDToMaterialMap materialMap {};
+
+    JPH::Shape::ShapeResult result = JPH::Shape::sRestoreWithChildren(stream, shapeMap, materialMap);
+
+    if (result.HasError() || stream.IsFailed())
+    {
+        bblog::warn("[PHYSICS] Discarding corrupt cached shape {}", GetFilePath(key).generic_string());
+        return nullptr;
+    }
+
+    return result.Get();
+}
+
+void ShapeCache::SaveToDisk(Key key, const JPH::ShapeRefC& shape)
+{
+    std::ostringstream file {};
+    JPH::StreamOutWrapper stream { file };
+    JPH::Shape::ShapeToIDMap shapeMap {};
+    JPH::Shape::MaterialToIDMap materialMap {};
+    shape->SaveWithChildren(stream, shapeMap, materialMap);
+
+    if (stream.IsFailed())
+        return;
+
+    const std::string bytes = std::move(file).str();
+    _derivedData.Store(MakeDerivedDataKey(key), std::as_bytes(std::span { bytes }));
+}
@@ -26,21 +26,26 @@ JPH::ShapeRefC ShapeFactory::MakeCapsuleShape(float cylinderHeight, float radius
 
 JPH::ShapeRefC ShapeFactory::MakeConvexHullShape(const std::vector<glm::vec3>& vertices)
 {
-    JPH::Array<JPH::Vec3> joltVertices;
-    joltVertices.reserve(vertices.size());
+    const auto key = ShapeCache::MakeKey(PhysicsShapes::eCONVEXHULL, vertices, {});
 
-    for (auto& v : vertices)
-        joltVertices.emplace_back(ToJoltVec3(v));
+    return GetCache().FindOrCreate(key, [&vertices]() -> JPH::ShapeRefC
+        {
+            JPH::Array<JPH::Vec3> joltVertices;
+            joltVertices.reserve(vertices.size());
 
-    JPH::ConvexHullShapeSettings creation { std::move(joltVertices) };
+            for (auto& v : vertices)
+                joltVertices.emplace_back(ToJoltVec3(v));
 
-    JPH::Shape::ShapeResult result {};
-    JPH::ShapeRefC shape = new JPH::ConvexHullShape(creation, result);
+            JPH::ConvexHullShapeSettings creation { std::move(joltVertices) };
 
-    if (result.HasError())
-        return nullptr;
+            JPH::Shape::ShapeResult result {};
+            JPH::ShapeRefC shape = new JPH::ConvexHullShape(creation, result);
 
-    return shape;
+            if (result.HasError())
+                return nullptr;
+
+            return shape;
+        });
 }
 
 bool IsTriangleDegenerate(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2)
@@ -58,30 +63,41 @@ bool IsTriangleDegenerate(const glm::vec3& v0, const glm::vec3& v1, const glm::v
 
 JPH::ShapeRefC ShapeFactory::MakeMeshHullShape(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& indices)
 {
-    JPH::Array<JPH::Float3> joltVertices;
-    joltVertices.reserve(vertices.size());
+    const auto key = ShapeCache::MakeKey(PhysicsShapes::eMESH, vertices, indices);
 
-    for (auto& v : vertices)
-        joltVertices.emplace_back(v.x, v.y, v.z);
+    return GetCache().FindOrCreate(key, [&vertices, &indices]() -> JPH::ShapeRefC
+        {
+            JPH::Array<JPH::Float3> joltVertices;
+            joltVertices.reserve(vertices.size());
 
-    auto triangleCount = indices.size() / 3;
-    JPH::Array<JPH::IndexedTriangle> joltTriangles;
-    joltTriangles.reserve(triangleCount);
+            for (auto& v : vertices)
+                joltVertices.emplace_back(v.x, v.y, v.z);
 
-    for (size_t i = 0; i < triangleCount; ++i)
-    {
-        // We do have a couple degenerate triangles left, but Jolt can clean those up
-        // assert(IsTriangleDegenerate(vertices[indices[3 * i]], vertices[indices[3 * i + 1]], vertices[indices[3 * i + 2]]) == false);
-        joltTriangles.emplace_back(JPH::IndexedTriangle(indices[3 * i], indices[3 * i + 1], indices[3 * i + 2]));
-    }
+            auto triangleCount = indices.size() / 3;
+            JPH::Array<JPH::IndexedTriangle> joltTriangles;
+            joltTriangles.reserve(triangleCount);
+
+            for (size_t i = 0; i < triangleCount; ++i)
+            {
+                // We do have a couple degenerate triangles left, but Jolt can clean those up
+                // assert(IsTriangleDegenerate(vertices[indices[3 * i]], vertices[indices[3 * i + 1]], vertices[indices[3 * i + 2]]) == false);
+                joltTriangles.emplace_back(JPH::IndexedTriangle(indices[3 * i], indices[3 * i + 1], indices[3 * i + 2]));
+            }
 
-    JPH::MeshShapeSettings creation { std::move(joltVertices), std::move(joltTriangles) };
+            JPH::MeshShapeSettings creation { std::move(joltVertices), std::move(joltTriangles) };
 
-    JPH::Shape::ShapeResult result {};
-    JPH::ShapeRefC shape = new JPH::MeshShape(creation, result);
+            JPH::Shape::ShapeResult result {};
+            JPH::ShapeRefC shape = new JPH::MeshShape(creation, result);
 
-    if (result.HasError())
-        return nullptr;
+            if (result.HasError())
+                return nullptr;
 
-    return shape;
-}
\ No newline at end of file
+            return shape;
+        });
+}
+
+ShapeCache& ShapeFactory::GetCache()
+{
+    static ShapeCache cache {};
+    return cache;
+}
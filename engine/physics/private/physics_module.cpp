@@ -6,16 +6,20 @@
 #include <Jolt/Physics/Collision/RayCast.h>
 #include <Jolt/RegisterTypes.h>
 
+#include "physics/body_batch.hpp"
 #include "physics/collision.hpp"
 #include "physics/constants.hpp"
 #include "physics/contact_listener.hpp"
 #include "physics/debug_renderer.hpp"
+#include "physics/physics_interpolation.hpp"
 
+#include "components/character_controller_component.hpp"
 #include "components/rigidbody_component.hpp"
 #include "ecs_module.hpp"
 #include "passes/debug_pass.hpp"
 #include "renderer.hpp"
 #include "renderer_module.hpp"
+#include "systems/character_controller_system.hpp"
 #include "systems/physics_system.hpp"
 #include "time_module.hpp"
 
@@ -59,20 +63,26 @@ ModuleTickOrder PhysicsModule::Init(MAYBE_UNUSED Engine& engine)
 
     auto& ecs = engine.GetModule<ECSModule>();
     ecs.AddSystem<PhysicsSystem>(engine, ecs, *this);
+    ecs.AddSystem<CharacterControllerSystem>(*this);
 
     // A contact listener gets notified when bodies (are about to) collide, and when they separate again.
     // Note that this is called from a job so whatever you do here needs to be thread safe.
     _contactListener = std::make_unique<PhysicsContactListener>(ecs.GetRegistry());
     _physicsSystem->SetContactListener(_contactListener.get());
 
-    RigidbodyComponent::SetupRegistryCallbacks(engine.GetModule<ECSModule>().GetRegistry());
+    _bodyBatch = std::make_unique<BodyBatch>(*_physicsSystem);
+    _interpolation = std::make_unique<PhysicsInterpolation>();
+    _fixedTimeStep = PHYSICS_STEPS_PER_SECOND;
+    RigidbodyComponent::SetupRegistryCallbacks(engine.GetModule<ECSModule>().GetRegistry(), *_bodyBatch);
+    CharacterControllerComponent::SetupRegistryCallbacks(engine.GetModule<ECSModule>().GetRegistry(), *_physicsSystem);
 
     return ModuleTickOrder::ePreTick;
 }
 
 void PhysicsModule::Shutdown(MAYBE_UNUSED Engine& engine)
 {
-    RigidbodyComponent::DisconnectRegistryCallbacks(engine.GetModule<ECSModule>().GetRegistry());
+    RigidbodyComponent::DisconnectRegistryCallbacks(engine.GetModule<ECSModule>().GetRegistry(), *_bodyBatch);
+    CharacterControllerComponent::DisconnectRegistryCallbacks(engine.GetModule<ECSModule>().GetRegistry(), *_physicsSystem);
     JPH::UnregisterTypes();
 
     delete JPH::Factory::sInstance;
@@ -82,22 +92,32 @@ void PhysicsModule::Shutdown(MAYBE_UNUSED Engine& engine)
 void PhysicsModule::Tick(MAYBE_UNUSED Engine& engine)
 {
     float deltatimeSeconds = glm::min(engine.GetModule<TimeModule>().GetDeltatime().count(), PHYSICS_MAX_DT) * 0.001f;
+    _accumulatedTime += deltatimeSeconds;
 
-    // This is being optimistic: we always do one collision step no matter how small the dt
-    const int updatesNeeded = std::min(static_cast<int>(glm::ceil(deltatimeSeconds / PHYSICS_STEPS_PER_SECOND)), PHYSICS_MAX_STEPS_PER_FRAME);
+    // Step the world with a fixed time step, as many times as the passed time allows
+    int stepsTaken = 0;
+    _interpolation->BeginFrame();
 
-    // Step the world
-
-    if (updatesNeeded > 0)
+    while (_accumulatedTime >= _fixedTimeStep && stepsTaken < PHYSICS_MAX_STEPS_PER_FRAME)
     {
-        auto error = _physicsSystem->Update(deltatimeSeconds, updatesNeeded, _tempAllocator.get(), _jobSystem.get());
+        auto error = _physicsSystem->Update(_fixedTimeStep, 1, _tempAllocator.get(), _jobSystem.get());
 
         if (error != JPH::EPhysicsUpdateError::None)
         {
             bblog::error("[PHYSICS] Simulation step error has occurred");
         }
+
+        _interpolation->RecordActiveBodies(*_physicsSystem);
+        _accumulatedTime -= _fixedTimeStep;
+        stepsTaken++;
     }
 
+    // If the game runs at 1 FPS then physics is the least of our concerns, drop the time we could not simulate
+    if (stepsTaken == PHYSICS_MAX_STEPS_PER_FRAME)
+        _accumulatedTime = glm::min(_accumulatedTime, _fixedTimeStep);
+
+    _interpolationAlpha = _accumulatedTime / _fixedTimeStep;
+
     if (!_debugLayersToRender.empty())
     {
         LayerBodyDrawFilter drawFilter {};
@@ -212,6 +232,12 @@ std::vector<RayHitInfo> PhysicsModule::ShootMultipleRays(const glm::vec3& origin
     return results;
 }
 
+void PhysicsModule::SetFixedTimeStep(float seconds)
+{
+    _fixedTimeStep = glm::max(seconds, 0.001f);
+    _accumulatedTime = glm::min(_accumulatedTime, _fixedTimeStep);
+}
+
 void PhysicsModule::SetDebugCameraPosition(const glm::vec3& cameraPos) const
 {
     _debugRenderer->SetCameraPos(ToJoltVec3(cameraPos));
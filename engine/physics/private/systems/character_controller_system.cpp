@@ -0,0 +1,109 @@
+#include "systems/character_controller_system.hpp"
+
+#include "components/character_controller_component.hpp"
+#include "components/transform_component.hpp"
+#include "components/transform_helpers.hpp"
+#include "ecs_module.hpp"
+#include "physics/constants.hpp"
+#include "physics_module.hpp"
+
+#include <Jolt/Physics/Body/BodyFilter.h>
+#include <Jolt/Physics/Collision/ShapeFilter.h>
+
+#include <imgui.h>
+#include <tracy/Tracy.hpp>
+
+CharacterControllerSystem::CharacterControllerSystem(PhysicsModule& physicsModule)
+    : _physicsModule(physicsModule)
+{
+}
+
+void CharacterControllerSystem::Update(ECSModule& ecs, float dt)
+{
+    // ECS delta time is in milliseconds
+    const float deltaTimeSeconds = glm::min(dt, PHYSICS_MAX_DT) * 0.001f;
+
+    UpdateCharacters(ecs.GetRegistry(), *_physicsModule._physicsSystem, _physicsModule.GetTempAllocator(), deltaTimeSeconds);
+
+    _characterCount = 0;
+    _groundedCount = 0;
+
+    for (auto [entity, controller] : ecs.GetRegistry().view<CharacterControllerComponent>().each())
+    {
+        _characterCount++;
+        _groundedCount += controller.character != nullptr && controller.IsGrounded();
+    }
+}
+
+void CharacterControllerSystem::Inspect()
+{
+    ZoneScoped;
+    ImGui::Begin("Character Controller System");
+    ImGui::Text("Characters: %u", _characterCount);
+    ImGui::Text("Grounded: %u", _groundedCount);
+    ImGui::End();
+}
+
+void CharacterControllerSystem::UpdateCharacters(entt::registry& registry, JPH::PhysicsSystem& physicsSystem, JPH::TempAllocator& allocator, float deltaTime)
+{
+    ZoneScoped;
+
+    if (deltaTime <= 0.0f)
+        return;
+
+    const JPH::Vec3 up = JPH::Vec3::sAxisY();
+    const JPH::ShapeFilter shapeFilter {};
+
+    for (auto [entity, controller] : registry.view<CharacterControllerComponent>().each())
+    {
+        if (controller.character == nullptr)
+            continue;
+
+        JPH::CharacterVirtual& character = *controller.character;
+        const CharacterControllerSettings& settings = controller.settings;
+        const JPH::Vec3 gravity = physicsSystem.GetGravity() * settings.gravityFactor;
+
+        // Keep falling or standing on what we stand on, the desired velocity only steers horizontally
+        const JPH::Vec3 currentVerticalVelocity = up.Dot(character.GetLinearVelocity()) * up;
+        const JPH::Vec3 groundVelocity = character.GetGroundVelocity();
+        JPH::Vec3 velocity {};
+
+        if (character.GetGroundState() == JPH::CharacterBase::EGroundState::OnGround && (currentVerticalVelocity.GetY() - groundVelocity.GetY()) < 0.1f)
+        {
+            velocity = groundVelocity;
+
+            if (controller._jumpSpeed > 0.0f)
+                velocity += controller._jumpSpeed * up;
+        }
+        else
+        {
+            velocity = currentVerticalVelocity;
+        }
+
+        controller._jumpSpeed = 0.0f;
+
+        velocity += gravity * deltaTime;
+        velocity += ToJoltVec3(controller.desiredVelocity) - up.Dot(ToJoltVec3(controller.desiredVelocity)) * up;
+        character.SetLinearVelocity(velocity);
+
+        JPH::CharacterVirtual::ExtendedUpdateSettings updateSettings {};
+        updateSettings.mStickToFloorStepDown = -up * settings.stepHeight;
+        updateSettings.mWalkStairsStepUp = up * settings.stepHeight;
+
+        // Characters should not collide with their own inner body
+        const JPH::IgnoreSingleBodyFilter bodyFilter { character.GetInnerBodyID() };
+
+        character.ExtendedUpdate(deltaTime, gravity, updateSettings,
+            physicsSystem.GetDefaultBroadPhaseLayerFilter(settings.layer),
+            physicsSystem.GetDefaultLayerFilter(settings.layer),
+            bodyFilter, shapeFilter, allocator);
+
+        if (registry.all_of<TransformComponent>(entity))
+        {
+            TransformHelpers::SetWorldTransform(registry, entity,
+                ToGLMVec3(character.GetPosition()),
+                TransformHelpers::GetWorldRotation(registry, entity),
+                TransformHelpers::GetWorldScale(registry, entity));
+        }
+    }
+}
@@ -15,6 +15,7 @@
 #include "model_loading.hpp"
 #include "physics/collision.hpp"
 #include "physics/constants.hpp"
+#include "physics/physics_interpolation.hpp"
 #include "renderer.hpp"
 #include "renderer_module.hpp"
 #include "resource_management/mesh_resource_manager.hpp"
@@ -41,41 +42,37 @@ PhysicsSystem::PhysicsSystem(Engine& engine, ECSModule& ecs, PhysicsModule& phys
 
 void PhysicsSystem::Update(MAYBE_UNUSED ECSModule& ecs, MAYBE_UNUSED float deltaTime)
 {
-    // This part should be fast because it returns a vector of just ids not whole rigidbodies
-    JPH::BodyIDVector activeBodies;
-    _physicsModule._physicsSystem->GetActiveBodies(JPH::EBodyType::RigidBody, activeBodies);
+    auto& registry = ecs.GetRegistry();
 
-    // Update transform for all active bodies
-    for (auto active_body : activeBodies)
-    {
-        if (_physicsModule.GetBodyInterface().GetMotionType(active_body) == JPH::EMotionType::Static)
+    // Only bodies that moved during the last fixed step are visited, blended between their last two step transforms
+    _physicsModule.GetInterpolation().ForEachInterpolated(_physicsModule.GetInterpolationAlpha(),
+        [&](JPH::BodyID bodyID, uint64_t userData, const PhysicsInterpolation::InterpolatedTransform& transform)
         {
-            bblog::trace("Skipping static body");
-            return;
-        }
+            const entt::entity entity = static_cast<entt::entity>(userData);
 
-        const entt::entity entity = static_cast<entt::entity>(_physicsModule.GetBodyInterface().GetUserData(active_body));
-        const RigidbodyComponent& rb = ecs.GetRegistry().get<RigidbodyComponent>(entity);
+            if (!registry.valid(entity))
+                return;
 
-        auto joltMatrix = _physicsModule.GetBodyInterface().GetWorldTransform(rb.bodyID);
+            // Character controllers sync their own transforms, and destroyed bodies might have given their entity to someone else
+            const RigidbodyComponent* rb = registry.try_get<RigidbodyComponent>(entity);
 
-        // We cant support objects simulated by jolt and our hierarchy system at the same time
-        RelationshipComponent* relationship = _ecs.GetRegistry().try_get<RelationshipComponent>(entity);
+            if (rb == nullptr || rb->bodyID != bodyID)
+                return;
 
-        if (relationship && relationship->parent != entt::null)
-            RelationshipHelpers::DetachChild(_ecs.GetRegistry(), relationship->parent, entity);
+            // We cant support objects simulated by jolt and our hierarchy system at the same time
+            RelationshipComponent* relationship = registry.try_get<RelationshipComponent>(entity);
 
-        auto shape = _physicsModule._physicsSystem->GetBodyInterface().GetShape(active_body);
+            if (relationship && relationship->parent != entt::null)
+                RelationshipHelpers::DetachChild(registry, relationship->parent, entity);
 
-        if (auto scaled_shape = dynamic_cast<const JPH::ScaledShape*>(shape.GetPtr()))
-        {
-            const auto joltScale = scaled_shape->GetScale();
-            joltMatrix = joltMatrix.PreScaled(joltScale);
-        }
+            glm::vec3 scale { 1.0f };
+            auto shape = _physicsModule.GetBodyInterface().GetShape(bodyID);
 
-        const auto joltToGlm = ToGLMMat4(joltMatrix);
-        TransformHelpers::SetWorldTransform(ecs.GetRegistry(), entity, joltToGlm);
-    }
+            if (auto scaledShape = dynamic_cast<const JPH::ScaledShape*>(shape.GetPtr()))
+                scale = ToGLMVec3(scaledShape->GetScale());
+
+            TransformHelpers::SetWorldTransform(registry, entity, transform.position, transform.rotation, scale);
+        });
 }
 
 void PhysicsSystem::Render(MAYBE_UNUSED const ECSModule& ecs) const
@@ -92,6 +89,13 @@ void PhysicsSystem::Inspect()
     static PhysicsShapes currentShape = PhysicsShapes::eSPHERE;
     ImGui::Text("Physics Entities: %u", static_cast<unsigned int>(view.size()));
     ImGui::Text("Active bodies: %u", _physicsModule._physicsSystem->GetNumActiveBodies(JPH::EBodyType::RigidBody));
+    ImGui::Text("Interpolated bodies: %u", _physicsModule.GetInterpolation().GetMovingCount());
+
+    int physicsRate = static_cast<int>(glm::round(1.0f / _physicsModule.GetFixedTimeStep()));
+    if (ImGui::SliderInt("Physics rate (Hz)", &physicsRate, 10, 240))
+    {
+        _physicsModule.SetFixedTimeStep(1.0f / static_cast<float>(physicsRate));
+    }
 
     ImGui::DragInt("Amount", &amount, 1, 1, 100);
     const char* shapeNames[] = { "Sphere", "Box", "Convex Hull" };
@@ -124,7 +128,7 @@ void PhysicsSystem::InspectRigidBody(RigidbodyComponent& rb)
     float pos[3] = { position.GetX(), position.GetY(), position.GetZ() };
     if (ImGui::DragFloat3("Position", pos, 0.1f))
     {
-        _physicsModule.GetBodyInterface().SetPosition(rb.bodyID, JPH::Vec3(pos[0], pos[1], pos[2]), JPH::EActivation::Activate);
+        rb.SetTranslation(glm::vec3 { pos[0], pos[1], pos[2] });
     }
 
     const auto joltRotation = _physicsModule.GetBodyInterface().GetRotation(rb.bodyID).GetEulerAngles();
@@ -132,7 +136,7 @@ void PhysicsSystem::InspectRigidBody(RigidbodyComponent& rb)
     if (ImGui::DragFloat3("Rotation", euler))
     {
         JPH::Quat newRotation = JPH::Quat::sEulerAngles(JPH::Vec3(euler[0], euler[1], euler[2]));
-        _physicsModule.GetBodyInterface().SetRotation(rb.bodyID, newRotation, JPH::EActivation::Activate);
+        rb.SetRotation(ToGLMQuat(newRotation));
     }
 
     // NOTE: Disabled because of the new layer system
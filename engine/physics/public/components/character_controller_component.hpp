@@ -0,0 +1,64 @@
+#pragma once
+
+#include "physics/collision.hpp"
+#include "physics/jolt_to_glm.hpp"
+
+#include <entt/entity/registry.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Physics/Character/CharacterVirtual.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+struct CharacterControllerSettings
+{
+    float radius = 0.5f;
+    float cylinderHeight = 1.0f; // Height of the straight part of the capsule, total height is cylinderHeight + 2 * radius
+    float maxSlopeAngle = glm::radians(45.0f); // Anything steeper than this is treated as a wall
+    float stepHeight = 0.4f; // Ledges up to this height are walked up, and walked down without leaving the ground
+    float mass = 70.0f;
+    float maxStrength = 100.0f; // Max force with which the character pushes dynamic bodies
+    float gravityFactor = 1.0f;
+    JPH::ObjectLayer layer = eENEMY;
+};
+
+// Kinematic character that is moved by the CharacterControllerSystem, instead of being simulated as a dynamic body.
+// The position of the component is at the feet of the character, the capsule is placed above it.
+class CharacterControllerComponent
+{
+public:
+    explicit CharacterControllerComponent(const CharacterControllerSettings& settings = {});
+
+    // Characters are created when the component is added, so they start at the world position of the entity
+    static void SetupRegistryCallbacks(entt::registry& registry, JPH::PhysicsSystem& physicsSystem);
+    static void DisconnectRegistryCallbacks(entt::registry& registry, JPH::PhysicsSystem& physicsSystem);
+
+    // Getters
+    glm::vec3 GetPosition() const { return ToGLMVec3(character->GetPosition()); }
+    glm::vec3 GetVelocity() const { return ToGLMVec3(character->GetLinearVelocity()); }
+    glm::vec3 GetGroundNormal() const { return ToGLMVec3(character->GetGroundNormal()); }
+    bool IsGrounded() const { return character->GetGroundState() == JPH::CharacterBase::EGroundState::OnGround; }
+    bool IsOnSteepSlope() const { return character->GetGroundState() == JPH::CharacterBase::EGroundState::OnSteepGround; }
+    JPH::BodyID GetInnerBodyID() const { return character->GetInnerBodyID(); }
+    const CharacterControllerSettings& GetSettings() const { return settings; }
+
+    // Moves the character without sweeping, use for spawning and respawning
+    void Teleport(const glm::vec3& position);
+
+    // Only applied when the character is standing on the ground
+    void Jump(float speed) { _jumpSpeed = speed; }
+
+    // Velocity the character tries to move with, the vertical part is ignored while grounded.
+    glm::vec3 desiredVelocity { 0.0f };
+
+    JPH::Ref<JPH::CharacterVirtual> character;
+
+private:
+    friend class CharacterControllerSystem;
+
+    CharacterControllerSettings settings {};
+    float _jumpSpeed = 0.0f;
+
+    static void OnConstructCallback(JPH::PhysicsSystem& physicsSystem, entt::registry& registry, entt::entity entity);
+};
@@ -10,13 +10,18 @@
 #include <Jolt/Physics/Body/BodyInterface.h>
 #include <Jolt/Physics/Collision/Shape/Shape.h>
 
+class BodyBatch;
+class PhysicsInterpolation;
+class PhysicsModule;
+
 class RigidbodyComponent
 {
 public:
-    RigidbodyComponent(JPH::BodyInterface& bodyInterface, JPH::ShapeRefC shape, JPH::ObjectLayer layer, JPH::EAllowedDOFs freedom = JPH::EAllowedDOFs::All);
+    RigidbodyComponent(PhysicsModule& physics, JPH::ShapeRefC shape, JPH::ObjectLayer layer, JPH::EAllowedDOFs freedom = JPH::EAllowedDOFs::All);
 
-    static void SetupRegistryCallbacks(entt::registry& registry);
-    static void DisconnectRegistryCallbacks(entt::registry& registry);
+    // Bodies are created through the batch, so they can be added to the broadphase together while it is open
+    static void SetupRegistryCallbacks(entt::registry& registry, BodyBatch& batch);
+    static void DisconnectRegistryCallbacks(entt::registry& registry, BodyBatch& batch);
 
     // Getters
     glm::vec3 GetPosition() const { return ToGLMVec3(bodyInterface->GetPosition(bodyID)); }
@@ -30,8 +35,10 @@ public:
     void SetAngularVelocity(const glm::vec3& velocity) { bodyInterface->SetAngularVelocity(bodyID, ToJoltVec3(velocity)); };
     void SetGravityFactor(float factor) { bodyInterface->SetGravityFactor(bodyID, factor); }
     void SetFriction(float friction) { bodyInterface->SetFriction(bodyID, friction); }
-    void SetTranslation(const glm::vec3& translation) { bodyInterface->SetPosition(bodyID, ToJoltVec3(translation), JPH::EActivation::Activate); }
-    void SetRotation(const glm::quat& rotation) { bodyInterface->SetRotation(bodyID, ToJoltQuat(glm::normalize(rotation)), JPH::EActivation::Activate); }
+    // Set translations are not blended from the previous physics step, so teleported bodies don't slide across the level.
+    // Rotations still blend, scripts turn enemies a little every frame and would otherwise lose their smooth movement.
+    void SetTranslation(const glm::vec3& translation);
+    void SetRotation(const glm::quat& rotation);
     void SetDynamic() { bodyInterface->SetMotionType(bodyID, JPH::EMotionType::Dynamic, JPH::EActivation::Activate); }
     void Setkinematic() { bodyInterface->SetMotionType(bodyID, JPH::EMotionType::Kinematic, JPH::EActivation::Activate); }
     void SetStatic() { bodyInterface->SetMotionType(bodyID, JPH::EMotionType::Static, JPH::EActivation::Activate); }
@@ -55,7 +62,8 @@ private:
     JPH::ObjectLayer layer {};
     JPH::EAllowedDOFs dofs {};
     JPH::BodyInterface* bodyInterface;
+    PhysicsInterpolation* interpolation;
 
-    static void OnDestroyCallback(entt::registry& registry, entt::entity entity);
-    static void OnConstructCallback(entt::registry& registry, entt::entity entity);
+    static void OnDestroyCallback(BodyBatch& batch, entt::registry& registry, entt::entity entity);
+    static void OnConstructCallback(BodyBatch& batch, entt::registry& registry, entt::entity entity);
 };
\ No newline at end of file
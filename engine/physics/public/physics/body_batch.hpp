@@ -0,0 +1,69 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/EActivation.h>
+
+namespace JPH
+{
+class BodyCreationSettings;
+class PhysicsSystem;
+}
+
+// Collects the bodies created while instantiating a level or model hierarchy and adds them to the broadphase together.
+// Adding bodies one at a time degrades the broadphase tree, so large batches also rebuild it when they are flushed.
+class BodyBatch
+{
+public:
+    explicit BodyBatch(JPH::PhysicsSystem& physicsSystem);
+    ~BodyBatch() = default;
+    NON_COPYABLE(BodyBatch);
+    NON_MOVABLE(BodyBatch);
+
+    // Batches can be nested, bodies are only added once the outermost batch ends.
+    void Begin();
+
+    // Returns the amount of bodies that were added to the broadphase.
+    uint32_t End();
+
+    NO_DISCARD bool IsOpen() const { return _depth > 0; }
+    NO_DISCARD uint32_t GetQueuedCount() const { return static_cast<uint32_t>(_activated.size() + _notActivated.size()); }
+
+    // Creates the body and either adds it directly, or queues it when a batch is open.
+    // Returns an invalid ID if the physics system ran out of bodies.
+    JPH::BodyID CreateBody(const JPH::BodyCreationSettings& creation, JPH::EActivation activation);
+
+    // Removes and destroys the body, regardless of it still being queued or not.
+    void DestroyBody(JPH::BodyID bodyID);
+
+private:
+    void Flush(JPH::BodyIDVector& bodies, JPH::EActivation activation);
+
+    JPH::PhysicsSystem& _physicsSystem;
+    uint32_t _depth = 0;
+
+    JPH::BodyIDVector _activated {};
+    JPH::BodyIDVector _notActivated {};
+};
+
+// Keeps a batch open for as long as it lives, so the batch also ends when instantiation throws halfway through.
+class BodyBatchScope
+{
+public:
+    explicit BodyBatchScope(BodyBatch& batch)
+        : _batch(batch)
+    {
+        _batch.Begin();
+    }
+
+    ~BodyBatchScope() { _batch.End(); }
+
+    NON_COPYABLE(BodyBatchScope);
+    NON_MOVABLE(BodyBatchScope);
+
+private:
+    BodyBatch& _batch;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/vec3.hpp>
+#include <optional>
+#include <vector>
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Physics/Body/BodyID.h>
+
+namespace JPH
+{
+class PhysicsSystem;
+}
+
+// Keeps the transforms of the last two fixed physics steps for every moving body,
+// so rendering can blend between them when it runs at a different rate than physics.
+class PhysicsInterpolation
+{
+public:
+    struct InterpolatedTransform
+    {
+        glm::vec3 position { 0.0f };
+        glm::quat rotation { 1.0f, 0.0f, 0.0f, 0.0f };
+    };
+
+    PhysicsInterpolation() = default;
+    ~PhysicsInterpolation() = default;
+    NON_COPYABLE(PhysicsInterpolation);
+    NON_MOVABLE(PhysicsInterpolation);
+
+    // Call once after every fixed step, records the transforms of all active bodies.
+    void RecordActiveBodies(JPH::PhysicsSystem& physicsSystem);
+
+    // Call once per frame before stepping, forgets the stopped bodies the previous frame already visited.
+    void BeginFrame();
+
+    // Starts a new step, followed by a Record call for every body that moved during it.
+    void BeginStep();
+    void Record(JPH::BodyID bodyID, uint64_t userData, const glm::vec3& position, const glm::quat& rotation);
+
+    // Makes the body jump to its current transform, and its next step start from there, instead of blending from where it was.
+    // Call this after teleporting a body.
+    void Snap(JPH::BodyID bodyID);
+
+    // Alpha is the fraction of a fixed step that passed since the last step, 0 is the previous and 1 the current transform.
+    // Returns nullopt for bodies that were never recorded.
+    NO_DISCARD std::optional<InterpolatedTransform> GetInterpolated(JPH::BodyID bodyID, float alpha) const;
+
+    // Visits the bodies that moved during the last step, and the ones that stopped moving in any step since BeginFrame.
+    template <typename Function>
+    void ForEachInterpolated(float alpha, Function&& function) const
+    {
+        for (uint32_t index : _moving)
+        {
+            const Entry& entry = _entries[index];
+            function(entry.bodyID, entry.userData, Interpolate(entry, alpha));
+        }
+
+        for (uint32_t index : _stopped)
+        {
+            const Entry& entry = _entries[index];
+
+            if (entry.step == _step)
+                continue;
+
+            function(entry.bodyID, entry.userData, InterpolatedTransform { entry.currentPosition, entry.currentRotation });
+        }
+    }
+
+    void Clear();
+
+    NO_DISCARD uint32_t GetMovingCount() const { return static_cast<uint32_t>(_moving.size()); }
+
+private:
+    struct Entry
+    {
+        JPH::BodyID bodyID {};
+        uint64_t userData = 0;
+        uint64_t step = 0;
+        bool stopped = false;
+
+        glm::vec3 previousPosition { 0.0f };
+        glm::vec3 currentPosition { 0.0f };
+        glm::quat previousRotation { 1.0f, 0.0f, 0.0f, 0.0f };
+        glm::quat currentRotation { 1.0f, 0.0f, 0.0f, 0.0f };
+    };
+
+    const Entry* FindEntry(JPH::BodyID bodyID) const;
+    InterpolatedTransform Interpolate(const Entry& entry, float alpha) const;
+
+    // Indexed by the index part of the body ID, the sequence number tells if a slot belongs to a reused ID
+    std::vector<Entry> _entries {};
+    std::vector<uint32_t> _moving {};
+    std::vector<uint32_t> _stopped {};
+    uint64_t _step = 0;
+};
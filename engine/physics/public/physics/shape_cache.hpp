@@ -0,0 +1,83 @@
+#pragma once
+
+#include "common.hpp"
+#include "derived_data_cache.hpp"
+#include "physics/collision.hpp"
+
+#include <filesystem>
+#include <glm/vec3.hpp>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+// Cache for cooked convex hull and mesh shapes, keyed by a hash of their source data.
+// Shapes are kept in memory so instances share them, and stored in the derived data cache with Jolt's binary serialization
+// so later runs can restore them instead of cooking them again.
+class ShapeCache
+{
+public:
+    using Key = uint64_t;
+
+    // Bump this whenever the cooking of shapes changes, all shapes stored with an older version are ignored
+    constexpr static uint32_t CACHE_VERSION = 1;
+    constexpr static std::string_view PROCESSOR_NAME = "shapes";
+
+    struct Stats
+    {
+        uint32_t memoryHits = 0;
+        uint32_t diskHits = 0;
+        uint32_t misses = 0;
+    };
+
+    // The directory of the derived data cache, the shapes are stored in a directory of their own inside it
+    explicit ShapeCache(const std::filesystem::path& directory = DerivedDataCache::DEFAULT_DIRECTORY);
+
+    // Hashes the source data of a shape, the scale is included for callers that bake it into the vertices.
+    NO_DISCARD static Key MakeKey(PhysicsShapes type, std::span<const glm::vec3> vertices, std::span<const uint32_t> indices, const glm::vec3& scale = glm::vec3 { 1.0f });
+
+    // Looks up the shape in memory first and on disk second, returns nullptr when neither has it.
+    NO_DISCARD JPH::ShapeRefC Find(Key key);
+    void Store(Key key, const JPH::ShapeRefC& shape);
+
+    // Returns the cached shape, or cooks and stores it when it is not cached yet.
+    // Cooking happens outside of the lock, so multiple threads can cook different shapes at the same time.
+    template <typename CookFunction>
+    JPH::ShapeRefC FindOrCreate(Key key, CookFunction&& cook)
+    {
+        if (JPH::ShapeRefC shape = Find(key))
+            return shape;
+
+        JPH::ShapeRefC shape = cook();
+
+        if (shape != nullptr)
+            Store(key, shape);
+
+        return shape;
+    }
+
+    // Only releases the in memory shapes, the files on disk are kept.
+    void ClearMemory();
+
+    void SetDiskCacheEnabled(bool enabled) { _diskEnabled = enabled; }
+    NO_DISCARD bool IsDiskCacheEnabled() const { return _diskEnabled; }
+
+    NO_DISCARD std::filesystem::path GetFilePath(Key key) const;
+    NO_DISCARD Stats GetStats() const;
+    void ResetStats();
+
+private:
+    NO_DISCARD static DerivedDataCache::Key MakeDerivedDataKey(Key key);
+
+    JPH::ShapeRefC LoadFromDisk(Key key);
+    void SaveToDisk(Key key, const JPH::ShapeRefC& shape);
+
+    DerivedDataCache _derivedData;
+    bool _diskEnabled = true;
+
+    mutable std::mutex _mutex;
+    std::unordered_map<Key, JPH::ShapeRefC> _shapes {};
+    Stats _stats {};
+};
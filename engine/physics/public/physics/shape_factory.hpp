@@ -1,6 +1,7 @@
 #pragma once
 
 #include "physics/jolt_to_glm.hpp"
+#include "physics/shape_cache.hpp"
 
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Collision/Shape/Shape.h>
@@ -16,4 +17,7 @@ struct ShapeFactory
     static JPH::ShapeRefC MakeCapsuleShape(float cylinderHeight, float radius);
     static JPH::ShapeRefC MakeConvexHullShape(const std::vector<glm::vec3>& vertices);
     static JPH::ShapeRefC MakeMeshHullShape(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& indices);
+
+    // Convex hull and mesh shapes are cooked through this cache, since building them is expensive
+    static ShapeCache& GetCache();
 };
\ No newline at end of file
@@ -14,6 +14,8 @@
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 
+class BodyBatch;
+class PhysicsInterpolation;
 class PhysicsDebugRenderer;
 
 struct RayHitInfo
@@ -41,6 +43,19 @@ public:
 
     JPH::BodyInterface& GetBodyInterface() { return _physicsSystem->GetBodyInterface(); }
     const JPH::BodyInterface& GetBodyInterface() const { return _physicsSystem->GetBodyInterface(); }
+    JPH::TempAllocator& GetTempAllocator() { return *_tempAllocator; }
+
+    // Rigidbodies created while a BodyBatchScope on this batch is alive are added to the broadphase together, once the outermost scope ends.
+    // Use this around level and model hierarchy instantiation.
+    BodyBatch& GetBodyBatch() { return *_bodyBatch; }
+
+    // Physics is stepped at a fixed rate, independent of the frame rate.
+    // Rendered transforms of moving bodies are blended between the last two steps, using the interpolation alpha.
+    void SetFixedTimeStep(float seconds);
+    NO_DISCARD float GetFixedTimeStep() const { return _fixedTimeStep; }
+    NO_DISCARD float GetInterpolationAlpha() const { return _interpolationAlpha; }
+    NO_DISCARD const PhysicsInterpolation& GetInterpolation() const { return *_interpolation; }
+    NO_DISCARD PhysicsInterpolation& GetInterpolation() { return *_interpolation; }
 
     void SetDebugCameraPosition(const glm::vec3& cameraPos) const;
     void ResetPersistentDebugLines();
@@ -54,6 +69,12 @@ public:
 private:
     std::unique_ptr<JPH::ContactListener> _contactListener {};
     std::unique_ptr<PhysicsDebugRenderer> _debugRenderer {};
+    std::unique_ptr<BodyBatch> _bodyBatch {};
+    std::unique_ptr<PhysicsInterpolation> _interpolation {};
+
+    float _fixedTimeStep = 0.0f;
+    float _accumulatedTime = 0.0f;
+    float _interpolationAlpha = 0.0f;
 
     std::unique_ptr<JPH::ObjectLayerPairFilter> _objectVsObjectLayerFilter {};
     std::unique_ptr<JPH::BroadPhaseLayerInterface> _broadphaseLayerInterface {};
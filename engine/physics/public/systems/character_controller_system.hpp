@@ -0,0 +1,38 @@
+#pragma once
+
+#include "common.hpp"
+#include "system_interface.hpp"
+
+#include <entt/entity/fwd.hpp>
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+class PhysicsModule;
+
+// Moves all characters in a single pass, resolving ground, slopes and stairs against the physics world.
+// Characters are updated one after another in registry order, so the same inputs always give the same result.
+class CharacterControllerSystem final : public SystemInterface
+{
+public:
+    explicit CharacterControllerSystem(PhysicsModule& physicsModule);
+    ~CharacterControllerSystem() override = default;
+    NON_COPYABLE(CharacterControllerSystem);
+    NON_MOVABLE(CharacterControllerSystem);
+
+    void Update(ECSModule& ecs, float dt) override;
+    void Render(MAYBE_UNUSED const ECSModule& ecs) const override { }
+    void Inspect() override;
+
+    std::string_view GetName() override { return "CharacterControllerSystem"; }
+
+    // Delta time is in seconds. Also copies the new character positions into their transforms.
+    static void UpdateCharacters(entt::registry& registry, JPH::PhysicsSystem& physicsSystem, JPH::TempAllocator& allocator, float deltaTime);
+
+private:
+    PhysicsModule& _physicsModule;
+    uint32_t _characterCount = 0;
+    uint32_t _groundedCount = 0;
+};
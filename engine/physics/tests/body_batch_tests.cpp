@@ -0,0 +1,189 @@
+#include "log.hpp"
+#include "physics/body_batch.hpp"
+#include "physics_test_helpers.hpp"
+#include "timers.hpp"
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+
+JPH::BodyCreationSettings MakeStaticBox(const JPH::Vec3& position)
+{
+    static JPH::ShapeRefC box = new JPH::BoxShape(JPH::Vec3::sReplicate(0.5f));
+    return JPH::BodyCreationSettings { box, position, JPH::Quat::sIdentity(), JPH::EMotionType::Static, eSTATIC };
+}
+
+std::vector<JPH::Vec3> MakeLevelLayout(uint32_t count)
+{
+    std::mt19937 random { 1337 };
+    std::uniform_real_distribution<float> distribution { -200.0f, 200.0f };
+
+    std::vector<JPH::Vec3> positions {};
+    for (uint32_t i = 0; i < count; ++i)
+        positions.emplace_back(distribution(random), distribution(random) * 0.1f, distribution(random));
+
+    return positions;
+}
+
+float CastRays(JPH::PhysicsSystem& system, uint32_t count)
+{
+    std::mt19937 random { 42 };
+    std::uniform_real_distribution<float> distribution { -200.0f, 200.0f };
+
+    Stopwatch stopwatch {};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        JPH::RRayCast ray { JPH::Vec3(distribution(random), 50.0f, distribution(random)), JPH::Vec3(0.0f, -100.0f, 0.0f) };
+        JPH::RayCastResult hit {};
+        system.GetNarrowPhaseQuery().CastRay(ray, hit);
+    }
+
+    return stopwatch.GetElapsed().count();
+}
+
+}
+
+TEST(BodyBatchTests, BodiesAddedOnEnd)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    BodyBatch batch { *world.system };
+    std::vector<JPH::BodyID> bodies {};
+
+    // Act
+    batch.Begin();
+    for (const auto& position : MakeLevelLayout(16))
+        bodies.emplace_back(batch.CreateBody(MakeStaticBox(position), JPH::EActivation::DontActivate));
+
+    // Assert
+    for (auto id : bodies)
+    {
+        ASSERT_FALSE(id.IsInvalid());
+        EXPECT_FALSE(world.GetBodyInterface().IsAdded(id));
+    }
+
+    EXPECT_EQ(batch.End(), 16u);
+
+    for (auto id : bodies)
+        EXPECT_TRUE(world.GetBodyInterface().IsAdded(id));
+}
+
+TEST(BodyBatchTests, AddedDirectlyWithoutBatch)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    BodyBatch batch { *world.system };
+
+    // Act
+    auto id = batch.CreateBody(MakeStaticBox(JPH::Vec3::sZero()), JPH::EActivation::DontActivate);
+
+    // Assert
+    EXPECT_TRUE(world.GetBodyInterface().IsAdded(id));
+    EXPECT_EQ(batch.GetQueuedCount(), 0u);
+}
+
+TEST(BodyBatchTests, NestedBatches)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    BodyBatch batch { *world.system };
+
+    // Act
+    batch.Begin();
+    batch.Begin();
+    auto id = batch.CreateBody(MakeStaticBox(JPH::Vec3::sZero()), JPH::EActivation::DontActivate);
+    auto innerCount = batch.End();
+    bool addedAfterInner = world.GetBodyInterface().IsAdded(id);
+    auto outerCount = batch.End();
+
+    // Assert
+    EXPECT_EQ(innerCount, 0u);
+    EXPECT_FALSE(addedAfterInner);
+    EXPECT_EQ(outerCount, 1u);
+    EXPECT_TRUE(world.GetBodyInterface().IsAdded(id));
+    EXPECT_FALSE(batch.IsOpen());
+}
+
+TEST(BodyBatchTests, DestroyWhileQueued)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    BodyBatch batch { *world.system };
+
+    // Act
+    batch.Begin();
+    auto destroyed = batch.CreateBody(MakeStaticBox(JPH::Vec3::sZero()), JPH::EActivation::DontActivate);
+    auto kept = batch.CreateBody(MakeStaticBox(JPH::Vec3(5.0f, 0.0f, 0.0f)), JPH::EActivation::DontActivate);
+    batch.DestroyBody(destroyed);
+
+    // Assert
+    EXPECT_EQ(batch.End(), 1u);
+    EXPECT_TRUE(world.GetBodyInterface().IsAdded(kept));
+    EXPECT_EQ(world.system->GetNumBodies(), 1u);
+}
+
+TEST(BodyBatchTests, ScopeEndsWhenThrowing)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    BodyBatch batch { *world.system };
+    JPH::BodyID id {};
+
+    // Act
+    try
+    {
+        BodyBatchScope scope { batch };
+        id = batch.CreateBody(MakeStaticBox(JPH::Vec3::sZero()), JPH::EActivation::DontActivate);
+        throw std::runtime_error("Mesh type not supported!");
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    auto afterwards = batch.CreateBody(MakeStaticBox(JPH::Vec3(5.0f, 0.0f, 0.0f)), JPH::EActivation::DontActivate);
+
+    // Assert
+    EXPECT_FALSE(batch.IsOpen());
+    EXPECT_TRUE(world.GetBodyInterface().IsAdded(id));
+    EXPECT_TRUE(world.GetBodyInterface().IsAdded(afterwards));
+}
+
+// Not a correctness test, reports level load and first frame query timings for both insertion strategies.
+// Disabled so it does not slow down every test run, run it with --gtest_also_run_disabled_tests
+TEST(BodyBatchTests, DISABLED_LevelLoadTimings)
+{
+    constexpr uint32_t BODY_COUNT = 20000;
+    constexpr uint32_t RAY_COUNT = 10000;
+
+    auto layout = MakeLevelLayout(BODY_COUNT);
+
+    TestPhysicsWorld individualWorld {};
+    Stopwatch individualLoad {};
+    for (const auto& position : layout)
+        individualWorld.GetBodyInterface().CreateAndAddBody(MakeStaticBox(position), JPH::EActivation::DontActivate);
+    float individualLoadTime = individualLoad.GetElapsed().count();
+    float individualQueryTime = CastRays(*individualWorld.system, RAY_COUNT);
+
+    TestPhysicsWorld batchedWorld {};
+    BodyBatch batch { *batchedWorld.system };
+    Stopwatch batchedLoad {};
+    batch.Begin();
+    for (const auto& position : layout)
+        batch.CreateBody(MakeStaticBox(position), JPH::EActivation::DontActivate);
+    batch.End();
+    float batchedLoadTime = batchedLoad.GetElapsed().count();
+    float batchedQueryTime = CastRays(*batchedWorld.system, RAY_COUNT);
+
+    bblog::info("[BodyBatch] {} bodies, one at a time: load {:.2f}ms, {} rays {:.2f}ms", BODY_COUNT, individualLoadTime, RAY_COUNT, individualQueryTime);
+    bblog::info("[BodyBatch] {} bodies, batched: load {:.2f}ms, {} rays {:.2f}ms", BODY_COUNT, batchedLoadTime, RAY_COUNT, batchedQueryTime);
+
+    EXPECT_EQ(individualWorld.system->GetNumBodies(), batchedWorld.system->GetNumBodies());
+}
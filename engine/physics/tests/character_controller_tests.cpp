@@ -0,0 +1,262 @@
+#include "components/character_controller_component.hpp"
+#include "components/transform_component.hpp"
+#include "components/transform_helpers.hpp"
+#include "log.hpp"
+#include "physics_test_helpers.hpp"
+#include "systems/character_controller_system.hpp"
+#include "timers.hpp"
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+
+#include <gtest/gtest.h>
+#include <random>
+
+namespace
+{
+
+void AddStaticBox(TestPhysicsWorld& world, const JPH::Vec3& halfExtents, const JPH::Vec3& position, const JPH::Quat& rotation = JPH::Quat::sIdentity())
+{
+    JPH::BodyCreationSettings settings { new JPH::BoxShape(halfExtents), position, rotation, JPH::EMotionType::Static, eSTATIC };
+    world.GetBodyInterface().CreateAndAddBody(settings, JPH::EActivation::DontActivate);
+}
+
+// Floor with its top at y = 0
+void AddFloor(TestPhysicsWorld& world)
+{
+    AddStaticBox(world, JPH::Vec3(100.0f, 0.5f, 100.0f), JPH::Vec3(0.0f, -0.5f, 0.0f));
+}
+
+// Ramp going up along +x, with the bottom edge of its surface at x = 2
+void AddRamp(TestPhysicsWorld& world, float angle)
+{
+    constexpr float HALF_LENGTH = 5.0f;
+    constexpr float HALF_THICKNESS = 0.5f;
+
+    const JPH::Vec3 along { glm::cos(angle), glm::sin(angle), 0.0f };
+    const JPH::Vec3 normal { -glm::sin(angle), glm::cos(angle), 0.0f };
+    const JPH::Vec3 center = JPH::Vec3(2.0f, 0.0f, 0.0f) + along * HALF_LENGTH - normal * HALF_THICKNESS;
+
+    AddStaticBox(world, JPH::Vec3(HALF_LENGTH, HALF_THICKNESS, 3.0f), center, JPH::Quat::sRotation(JPH::Vec3::sAxisZ(), angle));
+}
+
+}
+
+class CharacterControllerTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        TransformHelpers::SubscribeToEvents(_registry);
+        CharacterControllerComponent::SetupRegistryCallbacks(_registry, *_world.system);
+    }
+
+    void TearDown() override
+    {
+        CharacterControllerComponent::DisconnectRegistryCallbacks(_registry, *_world.system);
+    }
+
+    entt::entity SpawnCharacter(const glm::vec3& position, const CharacterControllerSettings& settings = {})
+    {
+        entt::entity entity = _registry.create();
+        _registry.emplace<TransformComponent>(entity);
+        TransformHelpers::SetLocalPosition(_registry, entity, position);
+        _registry.emplace<CharacterControllerComponent>(entity, settings);
+        return entity;
+    }
+
+    void Simulate(float seconds)
+    {
+        for (float time = 0.0f; time < seconds; time += PHYSICS_STEPS_PER_SECOND)
+        {
+            _world.Step();
+            CharacterControllerSystem::UpdateCharacters(_registry, *_world.system, *_world.tempAllocator, PHYSICS_STEPS_PER_SECOND);
+        }
+    }
+
+    CharacterControllerComponent& Get(entt::entity entity) { return _registry.get<CharacterControllerComponent>(entity); }
+
+    TestPhysicsWorld _world {};
+    entt::registry _registry {};
+};
+
+TEST_F(CharacterControllerTests, FallsOntoGround)
+{
+    // Arrange
+    AddFloor(_world);
+    auto entity = SpawnCharacter(glm::vec3 { 0.0f, 2.0f, 0.0f });
+
+    // Act
+    Simulate(2.0f);
+
+    // Assert
+    EXPECT_TRUE(Get(entity).IsGrounded());
+    EXPECT_NEAR(Get(entity).GetPosition().y, 0.0f, 0.05f);
+    EXPECT_NEAR(TransformHelpers::GetWorldPosition(_registry, entity).y, Get(entity).GetPosition().y, 0.0001f);
+}
+
+TEST_F(CharacterControllerTests, WalksUpLowStep)
+{
+    // Arrange
+    AddFloor(_world);
+    AddStaticBox(_world, JPH::Vec3(1.0f, 0.15f, 5.0f), JPH::Vec3(3.0f, 0.15f, 0.0f));
+    auto entity = SpawnCharacter(glm::vec3 { 0.0f });
+    Get(entity).desiredVelocity = glm::vec3 { 2.0f, 0.0f, 0.0f };
+
+    // Act
+    Simulate(2.0f);
+
+    // Assert
+    EXPECT_GT(Get(entity).GetPosition().x, 2.5f);
+    EXPECT_NEAR(Get(entity).GetPosition().y, 0.3f, 0.05f);
+    EXPECT_TRUE(Get(entity).IsGrounded());
+}
+
+TEST_F(CharacterControllerTests, BlockedByHighStep)
+{
+    // Arrange
+    AddFloor(_world);
+    AddStaticBox(_world, JPH::Vec3(1.0f, 0.4f, 5.0f), JPH::Vec3(3.0f, 0.4f, 0.0f));
+    auto entity = SpawnCharacter(glm::vec3 { 0.0f });
+    Get(entity).desiredVelocity = glm::vec3 { 2.0f, 0.0f, 0.0f };
+
+    // Act
+    Simulate(2.0f);
+
+    // Assert
+    EXPECT_LT(Get(entity).GetPosition().x, 2.0f);
+    EXPECT_NEAR(Get(entity).GetPosition().y, 0.0f, 0.05f);
+}
+
+TEST_F(CharacterControllerTests, ClimbsWalkableSlope)
+{
+    // Arrange
+    AddFloor(_world);
+    AddRamp(_world, glm::radians(30.0f));
+    auto entity = SpawnCharacter(glm::vec3 { 0.0f });
+    Get(entity).desiredVelocity = glm::vec3 { 3.0f, 0.0f, 0.0f };
+
+    // Act
+    Simulate(2.0f);
+
+    // Assert
+    EXPECT_GT(Get(entity).GetPosition().y, 1.0f);
+    EXPECT_TRUE(Get(entity).IsGrounded());
+}
+
+TEST_F(CharacterControllerTests, SlidesOffSteepSlope)
+{
+    // Arrange
+    AddFloor(_world);
+    AddRamp(_world, glm::radians(60.0f));
+    auto entity = SpawnCharacter(glm::vec3 { 0.0f });
+    Get(entity).desiredVelocity = glm::vec3 { 3.0f, 0.0f, 0.0f };
+
+    // Act
+    Simulate(2.0f);
+
+    // Assert
+    EXPECT_LT(Get(entity).GetPosition().y, 1.0f);
+    EXPECT_LT(Get(entity).GetPosition().x, 3.0f);
+}
+
+TEST_F(CharacterControllerTests, Deterministic)
+{
+    // Arrange
+    auto run = []()
+    {
+        TestPhysicsWorld world {};
+        entt::registry registry {};
+        TransformHelpers::SubscribeToEvents(registry);
+        CharacterControllerComponent::SetupRegistryCallbacks(registry, *world.system);
+
+        AddFloor(world);
+        AddRamp(world, glm::radians(30.0f));
+        AddStaticBox(world, JPH::Vec3(1.0f, 0.15f, 5.0f), JPH::Vec3(-3.0f, 0.15f, 0.0f));
+
+        std::mt19937 random { 7 };
+        std::uniform_real_distribution<float> distribution { -3.0f, 3.0f };
+
+        for (uint32_t i = 0; i < 32; ++i)
+        {
+            entt::entity entity = registry.create();
+            registry.emplace<TransformComponent>(entity);
+            TransformHelpers::SetLocalPosition(registry, entity, glm::vec3 { distribution(random), 0.5f, distribution(random) });
+            registry.emplace<CharacterControllerComponent>(entity).desiredVelocity = glm::vec3 { distribution(random), 0.0f, distribution(random) };
+        }
+
+        for (uint32_t step = 0; step < 180; ++step)
+        {
+            world.Step();
+            CharacterControllerSystem::UpdateCharacters(registry, *world.system, *world.tempAllocator, PHYSICS_STEPS_PER_SECOND);
+        }
+
+        std::vector<glm::vec3> positions {};
+        for (auto [entity, controller] : registry.view<CharacterControllerComponent>().each())
+            positions.emplace_back(controller.GetPosition());
+
+        CharacterControllerComponent::DisconnectRegistryCallbacks(registry, *world.system);
+        return positions;
+    };
+
+    // Act
+    auto first = run();
+    auto second = run();
+
+    // Assert
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        EXPECT_EQ(first[i].x, second[i].x);
+        EXPECT_EQ(first[i].y, second[i].y);
+        EXPECT_EQ(first[i].z, second[i].z);
+    }
+}
+
+// Not a correctness test, reports the cost of updating a large wave of characters.
+// Disabled so it does not slow down every test run, run it with --gtest_also_run_disabled_tests
+TEST_F(CharacterControllerTests, DISABLED_FiveHundredCharacters)
+{
+    constexpr uint32_t CHARACTER_COUNT = 500;
+    constexpr uint32_t FRAME_COUNT = 120;
+
+    AddFloor(_world);
+
+    // Some obstacles to walk around and over
+    for (int32_t i = -5; i <= 5; ++i)
+        AddStaticBox(_world, JPH::Vec3(0.5f, 0.15f + 0.1f * static_cast<float>(i + 5), 0.5f), JPH::Vec3(static_cast<float>(i) * 4.0f, 0.0f, 0.0f));
+
+    _world.system->OptimizeBroadPhase();
+
+    for (uint32_t i = 0; i < CHARACTER_COUNT; ++i)
+    {
+        glm::vec3 position { static_cast<float>(i % 25) * 2.0f - 25.0f, 0.0f, static_cast<float>(i / 25) * 2.0f - 20.0f };
+        auto entity = SpawnCharacter(position);
+
+        // Everyone walks to the center, like a wave chasing the player
+        Get(entity).desiredVelocity = -glm::normalize(position) * 4.0f;
+    }
+
+    float characterTime = 0.0f;
+    float stepTime = 0.0f;
+
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        Stopwatch step {};
+        _world.Step();
+        stepTime += step.GetElapsed().count();
+
+        Stopwatch characters {};
+        CharacterControllerSystem::UpdateCharacters(_registry, *_world.system, *_world.tempAllocator, PHYSICS_STEPS_PER_SECOND);
+        characterTime += characters.GetElapsed().count();
+    }
+
+    bblog::info("[CharacterController] {} characters: {:.3f}ms characters, {:.3f}ms physics step per frame",
+        CHARACTER_COUNT, characterTime / FRAME_COUNT, stepTime / FRAME_COUNT);
+
+    uint32_t grounded = 0;
+    for (auto [entity, controller] : _registry.view<CharacterControllerComponent>().each())
+        grounded += controller.IsGrounded();
+
+    EXPECT_GT(grounded, CHARACTER_COUNT / 2);
+}
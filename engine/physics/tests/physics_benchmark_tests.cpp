@@ -0,0 +1,276 @@
+#include "log.hpp"
+#include "physics/shape_factory.hpp"
+#include "physics_test_helpers.hpp"
+#include "timers.hpp"
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+
+#include <atomic>
+#include <glm/gtc/constants.hpp>
+#include <glm/trigonometric.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+
+// Stress scenes that report the cost of stepping and querying the physics world.
+// They run headless on the same layers and limits as the PhysicsModule. They are disabled so they don't slow down every test run,
+// run only these with --gtest_also_run_disabled_tests --gtest_filter=PhysicsBenchmarks.*
+// The numbers are also recorded as test properties, so --gtest_output=xml can be used to track them over time.
+
+namespace
+{
+
+class CountingContactListener final : public JPH::ContactListener
+{
+public:
+    void OnContactAdded(MAYBE_UNUSED const JPH::Body& inBody1, MAYBE_UNUSED const JPH::Body& inBody2, MAYBE_UNUSED const JPH::ContactManifold& inManifold, MAYBE_UNUSED JPH::ContactSettings& ioSettings) override
+    {
+        contacts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnContactPersisted(MAYBE_UNUSED const JPH::Body& inBody1, MAYBE_UNUSED const JPH::Body& inBody2, MAYBE_UNUSED const JPH::ContactManifold& inManifold, MAYBE_UNUSED JPH::ContactSettings& ioSettings) override
+    {
+        contacts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32_t> contacts = 0;
+};
+
+struct StepReport
+{
+    float averageStepTime = 0.0f;
+    float maxStepTime = 0.0f;
+    uint32_t averageContacts = 0;
+    uint32_t maxContacts = 0;
+    uint32_t activeBodies = 0;
+};
+
+uint32_t BenchmarkThreadCount()
+{
+    // Same amount of worker threads as the PhysicsModule uses
+    return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+}
+
+JPH::BodyID AddBody(TestPhysicsWorld& world, const JPH::ShapeRefC& shape, const glm::vec3& position, PhysicsObjectLayer layer, const glm::quat& rotation = glm::quat { 1.0f, 0.0f, 0.0f, 0.0f })
+{
+    const bool isStatic = layer == eSTATIC;
+    JPH::BodyCreationSettings settings { shape, ToJoltVec3(position), ToJoltQuat(rotation), isStatic ? JPH::EMotionType::Static : JPH::EMotionType::Dynamic, layer };
+    return world.GetBodyInterface().CreateAndAddBody(settings, isStatic ? JPH::EActivation::DontActivate : JPH::EActivation::Activate);
+}
+
+void AddFloor(TestPhysicsWorld& world, float size)
+{
+    AddBody(world, ShapeFactory::MakeBoxShape(glm::vec3 { size, 1.0f, size }), glm::vec3 { 0.0f, -0.5f, 0.0f }, eSTATIC);
+}
+
+StepReport Simulate(TestPhysicsWorld& world, CountingContactListener& listener, uint32_t steps)
+{
+    StepReport report {};
+    uint64_t totalContacts = 0;
+    float totalTime = 0.0f;
+
+    for (uint32_t i = 0; i < steps; ++i)
+    {
+        listener.contacts = 0;
+
+        Stopwatch stopwatch {};
+        world.Step();
+        float elapsed = stopwatch.GetElapsed().count();
+
+        totalTime += elapsed;
+        totalContacts += listener.contacts;
+        report.maxStepTime = std::max(report.maxStepTime, elapsed);
+        report.maxContacts = std::max(report.maxContacts, listener.contacts.load());
+    }
+
+    report.averageStepTime = totalTime / static_cast<float>(steps);
+    report.averageContacts = static_cast<uint32_t>(totalContacts / steps);
+    report.activeBodies = world.system->GetNumActiveBodies(JPH::EBodyType::RigidBody);
+    return report;
+}
+
+void Report(std::string_view scene, uint32_t bodyCount, const StepReport& report)
+{
+    bblog::info("[PhysicsBenchmarks] {}: {} bodies, step {:.3f}ms avg {:.3f}ms max, contacts {} avg {} max, {} active at the end",
+        scene, bodyCount, report.averageStepTime, report.maxStepTime, report.averageContacts, report.maxContacts, report.activeBodies);
+
+    ::testing::Test::RecordProperty("averageStepMs", std::to_string(report.averageStepTime));
+    ::testing::Test::RecordProperty("maxStepMs", std::to_string(report.maxStepTime));
+    ::testing::Test::RecordProperty("averageContacts", static_cast<int>(report.averageContacts));
+    ::testing::Test::RecordProperty("maxContacts", static_cast<int>(report.maxContacts));
+}
+
+std::vector<glm::vec3> MakeRockPoints(std::mt19937& random)
+{
+    std::uniform_real_distribution<float> distribution { -0.5f, 0.5f };
+    std::vector<glm::vec3> points {};
+
+    for (uint32_t i = 0; i < 24; ++i)
+        points.emplace_back(distribution(random), distribution(random), distribution(random));
+
+    return points;
+}
+
+}
+
+class PhysicsBenchmarks : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Benchmarks should measure the simulation, not cooking or reading the shape cache
+        ShapeFactory::GetCache().SetDiskCacheEnabled(false);
+
+        _world.system->SetContactListener(&_contactListener);
+    }
+
+    void TearDown() override
+    {
+        ShapeFactory::GetCache().SetDiskCacheEnabled(true);
+    }
+
+    TestPhysicsWorld _world { BenchmarkThreadCount() };
+    CountingContactListener _contactListener {};
+};
+
+TEST_F(PhysicsBenchmarks, DISABLED_StackedBoxes)
+{
+    constexpr uint32_t TOWER_COUNT = 16;
+    constexpr uint32_t TOWER_HEIGHT = 20;
+    constexpr uint32_t STEP_COUNT = 300;
+
+    AddFloor(_world, 200.0f);
+    auto box = ShapeFactory::MakeBoxShape(glm::vec3 { 1.0f });
+
+    for (uint32_t tower = 0; tower < TOWER_COUNT; ++tower)
+    {
+        glm::vec3 base { static_cast<float>(tower % 4) * 4.0f, 0.5f, static_cast<float>(tower / 4) * 4.0f };
+
+        for (uint32_t level = 0; level < TOWER_HEIGHT; ++level)
+            AddBody(_world, box, base + glm::vec3 { 0.0f, static_cast<float>(level) * 1.0f, 0.0f }, eENEMY);
+    }
+
+    _world.system->OptimizeBroadPhase();
+
+    auto report = Simulate(_world, _contactListener, STEP_COUNT);
+    Report("Stacked boxes", TOWER_COUNT * TOWER_HEIGHT, report);
+
+    EXPECT_GT(report.averageContacts, 0u);
+}
+
+TEST_F(PhysicsBenchmarks, DISABLED_ConvexHullPile)
+{
+    constexpr uint32_t HULL_COUNT = 1000;
+    constexpr uint32_t VARIATIONS = 8;
+    constexpr uint32_t STEP_COUNT = 300;
+
+    AddFloor(_world, 200.0f);
+
+    std::mt19937 random { 1337 };
+    std::vector<JPH::ShapeRefC> rocks {};
+
+    for (uint32_t i = 0; i < VARIATIONS; ++i)
+        rocks.emplace_back(ShapeFactory::MakeConvexHullShape(MakeRockPoints(random)));
+
+    // Dropped in a narrow column, so they pile up on top of each other
+    std::uniform_real_distribution<float> spread { -4.0f, 4.0f };
+
+    for (uint32_t i = 0; i < HULL_COUNT; ++i)
+    {
+        glm::vec3 position { spread(random), 1.0f + static_cast<float>(i) * 0.2f, spread(random) };
+        AddBody(_world, rocks[i % VARIATIONS], position, eCOINS);
+    }
+
+    _world.system->OptimizeBroadPhase();
+
+    auto report = Simulate(_world, _contactListener, STEP_COUNT);
+    Report("Convex hull pile", HULL_COUNT, report);
+
+    EXPECT_GT(report.averageContacts, 0u);
+}
+
+TEST_F(PhysicsBenchmarks, DISABLED_CapsulesOnMeshFloor)
+{
+    constexpr uint32_t GRID_SIZE = 64;
+    constexpr uint32_t CAPSULE_COUNT = 2000;
+    constexpr uint32_t STEP_COUNT = 300;
+
+    // Bumpy terrain, like a level mesh collider
+    std::vector<glm::vec3> vertices {};
+    std::vector<uint32_t> indices {};
+
+    for (uint32_t z = 0; z <= GRID_SIZE; ++z)
+        for (uint32_t x = 0; x <= GRID_SIZE; ++x)
+            vertices.emplace_back(static_cast<float>(x) - GRID_SIZE * 0.5f, glm::sin(static_cast<float>(x) * 0.5f) * glm::cos(static_cast<float>(z) * 0.5f) * 0.5f, static_cast<float>(z) - GRID_SIZE * 0.5f);
+
+    for (uint32_t z = 0; z < GRID_SIZE; ++z)
+    {
+        for (uint32_t x = 0; x < GRID_SIZE; ++x)
+        {
+            uint32_t i = z * (GRID_SIZE + 1) + x;
+            indices.insert(indices.end(), { i, i + GRID_SIZE + 1, i + 1, i + 1, i + GRID_SIZE + 1, i + GRID_SIZE + 2 });
+        }
+    }
+
+    AddBody(_world, ShapeFactory::MakeMeshHullShape(vertices, indices), glm::vec3 { 0.0f }, eSTATIC);
+
+    std::mt19937 random { 42 };
+    std::uniform_real_distribution<float> spread { -GRID_SIZE * 0.45f, GRID_SIZE * 0.45f };
+    auto capsule = ShapeFactory::MakeCapsuleShape(1.0f, 0.4f);
+
+    for (uint32_t i = 0; i < CAPSULE_COUNT; ++i)
+        AddBody(_world, capsule, glm::vec3 { spread(random), 2.0f + static_cast<float>(i % 10) * 2.0f, spread(random) }, eENEMY);
+
+    _world.system->OptimizeBroadPhase();
+
+    auto report = Simulate(_world, _contactListener, STEP_COUNT);
+    Report("Capsules on mesh floor", CAPSULE_COUNT, report);
+
+    EXPECT_GT(report.averageContacts, 0u);
+}
+
+TEST_F(PhysicsBenchmarks, DISABLED_RayStorm)
+{
+    constexpr uint32_t OBSTACLE_COUNT = 5000;
+    constexpr uint32_t RAY_COUNT = 100000;
+
+    AddFloor(_world, 400.0f);
+
+    std::mt19937 random { 7 };
+    std::uniform_real_distribution<float> spread { -190.0f, 190.0f };
+    std::uniform_real_distribution<float> sizes { 0.5f, 4.0f };
+
+    for (uint32_t i = 0; i < OBSTACLE_COUNT; ++i)
+    {
+        glm::vec3 size { sizes(random), sizes(random) * 2.0f, sizes(random) };
+        AddBody(_world, ShapeFactory::MakeBoxShape(size), glm::vec3 { spread(random), size.y * 0.5f, spread(random) }, eSTATIC);
+    }
+
+    _world.system->OptimizeBroadPhase();
+
+    // Mix of short horizontal rays like enemy steering and long ones like weapons
+    std::uniform_real_distribution<float> angles { 0.0f, glm::two_pi<float>() };
+    std::uniform_real_distribution<float> lengths { 3.0f, 100.0f };
+    uint32_t hits = 0;
+
+    Stopwatch stopwatch {};
+    for (uint32_t i = 0; i < RAY_COUNT; ++i)
+    {
+        float angle = angles(random);
+        JPH::Vec3 origin { spread(random), 1.0f, spread(random) };
+        JPH::Vec3 direction = JPH::Vec3(glm::cos(angle), 0.0f, glm::sin(angle)) * lengths(random);
+
+        JPH::RayCastResult hit {};
+        hits += _world.system->GetNarrowPhaseQuery().CastRay(JPH::RRayCast { origin, direction }, hit);
+    }
+    float elapsed = stopwatch.GetElapsed().count();
+
+    float raysPerMs = static_cast<float>(RAY_COUNT) / elapsed;
+    bblog::info("[PhysicsBenchmarks] Ray storm: {} rays against {} bodies in {:.2f}ms, {:.0f} rays/ms, {} hits", RAY_COUNT, OBSTACLE_COUNT, elapsed, raysPerMs, hits);
+    RecordProperty("raysPerMs", std::to_string(raysPerMs));
+
+    EXPECT_GT(hits, 0u);
+}
@@ -0,0 +1,257 @@
+#include "physics/jolt_to_glm.hpp"
+#include "physics/physics_interpolation.hpp"
+#include "physics_test_helpers.hpp"
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+
+#include <glm/common.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+
+JPH::BodyID AddMovingSphere(TestPhysicsWorld& world, const JPH::Vec3& velocity)
+{
+    JPH::BodyCreationSettings settings { new JPH::SphereShape(0.5f), JPH::Vec3::sZero(), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, eENEMY };
+    settings.mGravityFactor = 0.0f;
+    settings.mLinearDamping = 0.0f;
+    settings.mLinearVelocity = velocity;
+    settings.mUserData = 7;
+
+    return world.GetBodyInterface().CreateAndAddBody(settings, JPH::EActivation::Activate);
+}
+
+glm::vec3 GetPosition(TestPhysicsWorld& world, JPH::BodyID bodyID)
+{
+    return ToGLMVec3(world.GetBodyInterface().GetPosition(bodyID));
+}
+
+void ExpectNear(const glm::vec3& a, const glm::vec3& b)
+{
+    EXPECT_NEAR(a.x, b.x, 0.0001f);
+    EXPECT_NEAR(a.y, b.y, 0.0001f);
+    EXPECT_NEAR(a.z, b.z, 0.0001f);
+}
+
+}
+
+TEST(PhysicsInterpolationTests, BlendsBetweenSteps)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    PhysicsInterpolation interpolation {};
+    auto body = AddMovingSphere(world, JPH::Vec3(6.0f, 0.0f, 0.0f));
+
+    world.Step();
+    interpolation.RecordActiveBodies(*world.system);
+    glm::vec3 previous = GetPosition(world, body);
+
+    // Act
+    world.Step();
+    interpolation.RecordActiveBodies(*world.system);
+    glm::vec3 current = GetPosition(world, body);
+
+    // Assert
+    ASSERT_GT(current.x, previous.x);
+    ExpectNear(interpolation.GetInterpolated(body, 0.0f)->position, previous);
+    ExpectNear(interpolation.GetInterpolated(body, 0.25f)->position, glm::mix(previous, current, 0.25f));
+    ExpectNear(interpolation.GetInterpolated(body, 0.5f)->position, glm::mix(previous, current, 0.5f));
+    ExpectNear(interpolation.GetInterpolated(body, 1.0f)->position, current);
+    ExpectNear(interpolation.GetInterpolated(body, 3.0f)->position, current);
+}
+
+TEST(PhysicsInterpolationTests, BlendsRotations)
+{
+    // Arrange
+    PhysicsInterpolation interpolation {};
+    JPH::BodyID body { 3, 1 };
+    glm::quat from = glm::angleAxis(0.0f, glm::vec3 { 0.0f, 1.0f, 0.0f });
+    glm::quat to = glm::angleAxis(glm::radians(90.0f), glm::vec3 { 0.0f, 1.0f, 0.0f });
+
+    interpolation.BeginStep();
+    interpolation.Record(body, 0, glm::vec3 { 0.0f }, from);
+
+    // Act
+    interpolation.BeginStep();
+    interpolation.Record(body, 0, glm::vec3 { 0.0f }, to);
+    auto halfway = interpolation.GetInterpolated(body, 0.5f);
+
+    // Assert
+    ASSERT_TRUE(halfway.has_value());
+    glm::quat expected = glm::angleAxis(glm::radians(45.0f), glm::vec3 { 0.0f, 1.0f, 0.0f });
+    EXPECT_NEAR(glm::abs(glm::dot(halfway->rotation, expected)), 1.0f, 0.0001f);
+}
+
+TEST(PhysicsInterpolationTests, NewBodyStartsAtCurrent)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    PhysicsInterpolation interpolation {};
+    auto body = AddMovingSphere(world, JPH::Vec3(6.0f, 0.0f, 0.0f));
+
+    // Act
+    world.Step();
+    interpolation.RecordActiveBodies(*world.system);
+
+    // Assert
+    ExpectNear(interpolation.GetInterpolated(body, 0.0f)->position, GetPosition(world, body));
+    EXPECT_FALSE(interpolation.GetInterpolated(JPH::BodyID { 1234, 0 }, 0.5f).has_value());
+}
+
+TEST(PhysicsInterpolationTests, TeleportedBodySnaps)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    PhysicsInterpolation interpolation {};
+    auto body = AddMovingSphere(world, JPH::Vec3(6.0f, 0.0f, 0.0f));
+
+    world.Step();
+    interpolation.RecordActiveBodies(*world.system);
+
+    // Act
+    world.GetBodyInterface().SetPosition(body, JPH::Vec3(100.0f, 0.0f, 0.0f), JPH::EActivation::Activate);
+    world.Step();
+    interpolation.RecordActiveBodies(*world.system);
+
+    // Assert
+    glm::vec3 current = GetPosition(world, body);
+    ExpectNear(interpolation.GetInterpolated(body, 0.0f)->position, current);
+    ExpectNear(interpolation.GetInterpolated(body, 0.5f)->position, current);
+}
+
+TEST(PhysicsInterpolationTests, ExplicitSnap)
+{
+    // Arrange
+    TestPhysicsWorld world {};
+    PhysicsInterpolation interpolation {};
+    auto body = AddMovingSphere(world, JPH::Vec3(6.0f, 0.0f, 0.0f));
+
+    world.Step();
+    interpolation.RecordActiveBodies(*world.system);
+    world.Step();
+    interpolation.RecordActiveBodies(*world.system);
+
+    // Act
+    interpolation.Snap(body);
+
+    // Assert
+    ExpectNear(interpolation.GetInterpolated(body, 0.0f)->position, GetPosition(world, body));
+}
+
+TEST(PhysicsInterpolationTests, StoppedBodyVisitedOnce)
+{
+    // Arrange
+    PhysicsInterpolation interpolation {};
+    JPH::BodyID body { 5, 0 };
+    uint32_t visits = 0;
+    glm::vec3 visitedPosition { 0.0f };
+    auto visit = [&](JPH::BodyID, uint64_t, const PhysicsInterpolation::InterpolatedTransform& transform)
+    {
+        visits++;
+        visitedPosition = transform.position;
+    };
+
+    interpolation.BeginFrame();
+    interpolation.BeginStep();
+    interpolation.Record(body, 0, glm::vec3 { 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+    interpolation.BeginFrame();
+    interpolation.BeginStep();
+    interpolation.Record(body, 0, glm::vec3 { 1.0f, 0.0f, 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+
+    // Act
+    interpolation.BeginFrame();
+    interpolation.BeginStep();
+    interpolation.ForEachInterpolated(0.5f, visit);
+    uint32_t visitsAfterStopping = visits;
+
+    interpolation.BeginFrame();
+    interpolation.BeginStep();
+    interpolation.ForEachInterpolated(0.5f, visit);
+
+    // Assert
+    EXPECT_EQ(visitsAfterStopping, 1u);
+    EXPECT_EQ(visits, 1u);
+    ExpectNear(visitedPosition, glm::vec3 { 1.0f, 0.0f, 0.0f });
+    ExpectNear(interpolation.GetInterpolated(body, 0.0f)->position, glm::vec3 { 1.0f, 0.0f, 0.0f });
+}
+
+TEST(PhysicsInterpolationTests, StoppedBodyVisitedWithMultipleStepsPerFrame)
+{
+    // Arrange
+    PhysicsInterpolation interpolation {};
+    JPH::BodyID stopping { 5, 0 };
+    JPH::BodyID moving { 6, 0 };
+    std::vector<glm::vec3> visitedPositions {};
+    auto visit = [&](JPH::BodyID bodyID, uint64_t, const PhysicsInterpolation::InterpolatedTransform& transform)
+    {
+        if (bodyID == stopping)
+            visitedPositions.emplace_back(transform.position);
+    };
+
+    interpolation.BeginFrame();
+    interpolation.BeginStep();
+    interpolation.Record(stopping, 0, glm::vec3 { 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+    interpolation.Record(moving, 0, glm::vec3 { 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+    interpolation.BeginStep();
+    interpolation.Record(stopping, 0, glm::vec3 { 1.0f, 0.0f, 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+    interpolation.Record(moving, 0, glm::vec3 { 1.0f, 0.0f, 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+    interpolation.ForEachInterpolated(0.5f, visit);
+
+    // Act, the body stops in the first of two steps in a frame
+    interpolation.BeginFrame();
+    interpolation.BeginStep();
+    interpolation.Record(moving, 0, glm::vec3 { 2.0f, 0.0f, 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+    interpolation.BeginStep();
+    interpolation.Record(moving, 0, glm::vec3 { 3.0f, 0.0f, 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+    interpolation.ForEachInterpolated(0.5f, visit);
+
+    interpolation.BeginFrame();
+    interpolation.BeginStep();
+    interpolation.ForEachInterpolated(0.5f, visit);
+
+    // Assert, it is moved to its final transform once, then left alone
+    ASSERT_EQ(visitedPositions.size(), 2u);
+    ExpectNear(visitedPositions[0], glm::vec3 { 0.5f, 0.0f, 0.0f });
+    ExpectNear(visitedPositions[1], glm::vec3 { 1.0f, 0.0f, 0.0f });
+}
+
+TEST(PhysicsInterpolationTests, SnapAppliesToNextStep)
+{
+    // Arrange
+    PhysicsInterpolation interpolation {};
+    JPH::BodyID body { 4, 0 };
+
+    interpolation.BeginStep();
+    interpolation.Record(body, 0, glm::vec3 { 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+    interpolation.BeginStep();
+    interpolation.Record(body, 0, glm::vec3 { 0.1f, 0.0f, 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+
+    // Act, teleported a short distance, which the snap distance would not catch
+    interpolation.Snap(body);
+    interpolation.BeginStep();
+    interpolation.Record(body, 0, glm::vec3 { 0.5f, 0.0f, 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+
+    // Assert
+    ExpectNear(interpolation.GetInterpolated(body, 0.0f)->position, glm::vec3 { 0.5f, 0.0f, 0.0f });
+}
+
+TEST(PhysicsInterpolationTests, ReusedBodyIDDoesNotBlend)
+{
+    // Arrange
+    PhysicsInterpolation interpolation {};
+    JPH::BodyID destroyed { 9, 0 };
+    JPH::BodyID reused { 9, 1 };
+
+    interpolation.BeginStep();
+    interpolation.Record(destroyed, 0, glm::vec3 { 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+
+    // Act
+    interpolation.BeginStep();
+    interpolation.Record(reused, 0, glm::vec3 { 1.0f, 0.0f, 0.0f }, glm::quat { 1.0f, 0.0f, 0.0f, 0.0f });
+
+    // Assert
+    EXPECT_FALSE(interpolation.GetInterpolated(destroyed, 0.5f).has_value());
+    ExpectNear(interpolation.GetInterpolated(reused, 0.0f)->position, glm::vec3 { 1.0f, 0.0f, 0.0f });
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "physics/collision.hpp"
+#include "physics/constants.hpp"
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Core/Factory.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/RegisterTypes.h>
+
+#include <memory>
+
+// Jolt needs its allocator, factory and types registered once before shapes can be created or restored
+inline void EnsureJoltInitialized()
+{
+    if (JPH::Factory::sInstance != nullptr)
+        return;
+
+    JPH::RegisterDefaultAllocator();
+    JPH::Factory::sInstance = new JPH::Factory();
+    JPH::RegisterTypes();
+}
+
+// Headless physics world with the same layers and limits as the PhysicsModule, without needing an engine
+struct TestPhysicsWorld
+{
+    explicit TestPhysicsWorld(uint32_t threadCount = 1)
+    {
+        EnsureJoltInitialized();
+
+        broadphaseLayerInterface = MakeBroadPhaseLayerImpl();
+        objectVsBroadphaseLayerFilter = MakeObjectVsBroadPhaseLayerFilterImpl();
+        objectVsObjectLayerFilter = MakeObjectPairFilterImpl();
+
+        tempAllocator = std::make_unique<JPH::TempAllocatorImpl>(PHYSICS_TEMP_ALLOCATOR_SIZE);
+        jobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, threadCount);
+
+        system = std::make_unique<JPH::PhysicsSystem>();
+        system->Init(
+            PHYSICS_MAX_BODIES, PHYSICS_MUTEX_COUNT,
+            PHYSICS_MAX_BODY_PAIRS, PHYSICS_MAX_CONTACT_CONSTRAINTS,
+            *broadphaseLayerInterface, *objectVsBroadphaseLayerFilter, *objectVsObjectLayerFilter);
+        system->SetGravity(JPH::Vec3(0, -PHYSICS_GRAVITATIONAL_CONSTANT, 0));
+    }
+
+    JPH::EPhysicsUpdateError Step(float deltaTime = PHYSICS_STEPS_PER_SECOND, int collisionSteps = 1)
+    {
+        return system->Update(deltaTime, collisionSteps, tempAllocator.get(), jobSystem.get());
+    }
+
+    JPH::BodyInterface& GetBodyInterface() { return system->GetBodyInterface(); }
+
+    std::unique_ptr<JPH::BroadPhaseLayerInterface> broadphaseLayerInterface;
+    std::unique_ptr<JPH::ObjectVsBroadPhaseLayerFilter> objectVsBroadphaseLayerFilter;
+    std::unique_ptr<JPH::ObjectLayerPairFilter> objectVsObjectLayerFilter;
+
+    std::unique_ptr<JPH::TempAllocator> tempAllocator;
+    std::unique_ptr<JPH::JobSystem> jobSystem;
+    std::unique_ptr<JPH::PhysicsSystem> system;
+};
@@ -0,0 +1,232 @@
+#include "physics/shape_cache.hpp"
+#include "physics_test_helpers.hpp"
+
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/Shape/ConvexHullShape.h>
+#include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#include <Jolt/Physics/Collision/Shape/SubShapeID.h>
+
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct TestMesh
+{
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+};
+
+// Slightly bumpy grid, so ray hits depend on the actual triangles
+TestMesh MakeGrid(uint32_t size)
+{
+    TestMesh mesh {};
+
+    for (uint32_t z = 0; z <= size; ++z)
+        for (uint32_t x = 0; x <= size; ++x)
+            mesh.vertices.emplace_back(static_cast<float>(x), static_cast<float>((x * 7 + z * 3) % 5) * 0.1f, static_cast<float>(z));
+
+    for (uint32_t z = 0; z < size; ++z)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            uint32_t i = z * (size + 1) + x;
+            mesh.indices.insert(mesh.indices.end(), { i, i + size + 1, i + 1, i + 1, i + size + 1, i + size + 2 });
+        }
+    }
+
+    return mesh;
+}
+
+JPH::ShapeRefC CookMesh(const TestMesh& mesh)
+{
+    JPH::VertexList vertices;
+    for (auto& v : mesh.vertices)
+        vertices.emplace_back(v.x, v.y, v.z);
+
+    JPH::IndexedTriangleList triangles;
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+        triangles.emplace_back(mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]);
+
+    JPH::MeshShapeSettings settings { std::move(vertices), std::move(triangles) };
+    return settings.Create().Get();
+}
+
+float CastDown(const JPH::ShapeRefC& shape, float x, float z)
+{
+    JPH::RayCastResult hit {};
+    shape->CastRay(JPH::RayCast { JPH::Vec3(x, 10.0f, z), JPH::Vec3(0.0f, -20.0f, 0.0f) }, JPH::SubShapeIDCreator(), hit);
+    return hit.mFraction;
+}
+
+}
+
+class ShapeCacheTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        EnsureJoltInitialized();
+
+        _directory = std::filesystem::temp_directory_path() / "bb_shape_cache_tests";
+        std::filesystem::remove_all(_directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(_directory);
+    }
+
+    std::filesystem::path _directory;
+};
+
+TEST_F(ShapeCacheTests, MissThenMemoryHit)
+{
+    // Arrange
+    ShapeCache cache { _directory };
+    TestMesh mesh = MakeGrid(4);
+    auto key = ShapeCache::MakeKey(PhysicsShapes::eMESH, mesh.vertices, mesh.indices);
+    uint32_t cookCount = 0;
+    auto cook = [&]()
+    {
+        cookCount++;
+        return CookMesh(mesh);
+    };
+
+    // Act
+    auto first = cache.FindOrCreate(key, cook);
+    auto second = cache.FindOrCreate(key, cook);
+
+    // Assert
+    EXPECT_EQ(cookCount, 1u);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+    EXPECT_EQ(cache.GetStats().memoryHits, 1u);
+    EXPECT_TRUE(std::filesystem::exists(cache.GetFilePath(key)));
+}
+
+TEST_F(ShapeCacheTests, RestoredFromDisk)
+{
+    // Arrange
+    TestMesh mesh = MakeGrid(4);
+    auto key = ShapeCache::MakeKey(PhysicsShapes::eMESH, mesh.vertices, mesh.indices);
+
+    {
+        ShapeCache previousRun { _directory };
+        previousRun.Store(key, CookMesh(mesh));
+    }
+
+    // Act
+    ShapeCache cache { _directory };
+    auto shape = cache.Find(key);
+
+    // Assert
+    ASSERT_NE(shape, nullptr);
+    EXPECT_EQ(shape->GetSubType(), JPH::EShapeSubType::Mesh);
+    EXPECT_EQ(cache.GetStats().diskHits, 1u);
+    EXPECT_EQ(cache.GetStats().misses, 0u);
+}
+
+TEST_F(ShapeCacheTests, SourceChangeInvalidates)
+{
+    // Arrange
+    ShapeCache cache { _directory };
+    TestMesh mesh = MakeGrid(4);
+    auto key = ShapeCache::MakeKey(PhysicsShapes::eMESH, mesh.vertices, mesh.indices);
+    cache.Store(key, CookMesh(mesh));
+
+    // Act
+    TestMesh changed = mesh;
+    changed.vertices[3].y += 0.5f;
+    auto changedKey = ShapeCache::MakeKey(PhysicsShapes::eMESH, changed.vertices, changed.indices);
+    auto scaledKey = ShapeCache::MakeKey(PhysicsShapes::eMESH, mesh.vertices, mesh.indices, glm::vec3 { 2.0f });
+    auto hullKey = ShapeCache::MakeKey(PhysicsShapes::eCONVEXHULL, mesh.vertices, {});
+
+    // Assert
+    EXPECT_NE(key, changedKey);
+    EXPECT_NE(key, scaledKey);
+    EXPECT_NE(key, hullKey);
+    EXPECT_EQ(cache.Find(changedKey), nullptr);
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+}
+
+TEST_F(ShapeCacheTests, CorruptFileIsIgnored)
+{
+    // Arrange
+    TestMesh mesh = MakeGrid(2);
+    auto key = ShapeCache::MakeKey(PhysicsShapes::eMESH, mesh.vertices, mesh.indices);
+
+    {
+        ShapeCache previousRun { _directory };
+        previousRun.Store(key, CookMesh(mesh));
+    }
+
+    auto path = ShapeCache { _directory }.GetFilePath(key);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+    // Act
+    ShapeCache cache { _directory };
+    auto shape = cache.Find(key);
+
+    // Assert
+    EXPECT_EQ(shape, nullptr);
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+}
+
+TEST_F(ShapeCacheTests, IdenticalCollisionResults)
+{
+    // Arrange
+    TestMesh mesh = MakeGrid(8);
+    auto key = ShapeCache::MakeKey(PhysicsShapes::eMESH, mesh.vertices, mesh.indices);
+    auto cooked = CookMesh(mesh);
+
+    {
+        ShapeCache previousRun { _directory };
+        previousRun.Store(key, cooked);
+    }
+
+    // Act
+    ShapeCache cache { _directory };
+    auto restored = cache.Find(key);
+    ASSERT_NE(restored, nullptr);
+
+    // Assert
+    for (float x = 0.25f; x < 8.0f; x += 0.5f)
+    {
+        for (float z = 0.25f; z < 8.0f; z += 0.5f)
+        {
+            EXPECT_FLOAT_EQ(CastDown(cooked, x, z), CastDown(restored, x, z));
+        }
+    }
+
+    EXPECT_TRUE(cooked->GetLocalBounds().mMin == restored->GetLocalBounds().mMin);
+    EXPECT_TRUE(cooked->GetLocalBounds().mMax == restored->GetLocalBounds().mMax);
+}
+
+TEST_F(ShapeCacheTests, ConvexHullRoundTrip)
+{
+    // Arrange
+    std::vector<glm::vec3> points { { -1, -1, -1 }, { 1, -1, -1 }, { -1, 1, -1 }, { 1, 1, -1 }, { -1, -1, 1 }, { 1, -1, 1 }, { -1, 1, 1 }, { 1, 1, 1 }, { 0, 1.5f, 0 } };
+    auto key = ShapeCache::MakeKey(PhysicsShapes::eCONVEXHULL, points, {});
+
+    JPH::Array<JPH::Vec3> joltPoints;
+    for (auto& p : points)
+        joltPoints.emplace_back(p.x, p.y, p.z);
+    JPH::ShapeRefC cooked = JPH::ConvexHullShapeSettings { joltPoints }.Create().Get();
+
+    {
+        ShapeCache previousRun { _directory };
+        previousRun.Store(key, cooked);
+    }
+
+    // Act
+    ShapeCache cache { _directory };
+    auto restored = cache.Find(key);
+
+    // Assert
+    ASSERT_NE(restored, nullptr);
+    EXPECT_FLOAT_EQ(cooked->GetVolume(), restored->GetVolume());
+    EXPECT_FLOAT_EQ(CastDown(cooked, 0.0f, 0.0f), CastDown(restored, 0.0f, 0.0f));
+}
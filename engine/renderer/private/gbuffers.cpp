@@ -94,6 +94,16 @@ void GBuffers::CreateDepthResources()
 
 void GBuffers::CleanUp()
 {
+    auto resources { _context->Resources() };
+
+    // Frames that are still in flight can be drawing to the old targets
+    for (const auto& attachment : _attachments)
+    {
+        resources->ImageResourceManager().DestroyDeferred(attachment);
+    }
+
+    resources->ImageResourceManager().DestroyDeferred(_depthImage);
+    resources->SamplerResourceManager().DestroyDeferred(_depthSampler);
 }
 
 void GBuffers::CreateViewportAndScissor()
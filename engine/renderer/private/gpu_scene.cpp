@@ -20,6 +20,8 @@
 #include "ecs_module.hpp"
 #include "graphics_context.hpp"
 #include "graphics_resources.hpp"
+#include "lod_selection.hpp"
+#include "mesh_simplification.hpp"
 #include "pipeline_builder.hpp"
 #include "resource_management/buffer_resource_manager.hpp"
 #include "resource_management/image_resource_manager.hpp"
@@ -101,6 +103,9 @@ GPUScene::~GPUScene()
 {
     auto vkContext { _context->VulkanContext() };
 
+    for (const auto& [fileName, image] : _decalImages)
+        _context->Resources()->ImageResourceManager().Destroy(image);
+
     vkContext->Device().destroy(_drawBufferDSL);
     vkContext->Device().destroy(_sceneDescriptorSetLayout);
     vkContext->Device().destroy(_objectInstancesDSL);
@@ -195,6 +200,8 @@ void GPUScene::UpdateObjectInstancesData(uint32_t frameIndex)
         assert(resources->MaterialResourceManager().IsValid(mesh->material) && "There should always be a material available");
 
         instance.model = TransformHelpers::GetWorldMatrix(transformComponent);
+        instance.positionOffset = mesh->positionOffset;
+        instance.positionScale = mesh->positionScale;
         instance.materialIndex = mesh->material.Index();
         instance.boundingRadius = mesh->boundingRadius;
 
@@ -216,12 +223,13 @@ void GPUScene::UpdateObjectInstancesData(uint32_t frameIndex)
         const auto& meshComponent = staticMeshView.get<StaticMeshComponent>(entity);
         auto resources { _context->Resources() };
         auto mesh = resources->MeshResourceManager().Access(meshComponent.mesh);
+        const GPUMeshLOD lod = SelectMeshLOD(*mesh, staticInstances[count].model);
 
         _staticDrawCommands.emplace_back(DrawIndexedIndirectCommand {
             .command = {
-                .indexCount = mesh->count,
+                .indexCount = lod.count,
                 .instanceCount = 0,
-                .firstIndex = mesh->indexOffset,
+                .firstIndex = lod.indexOffset,
                 .vertexOffset = static_cast<int32_t>(mesh->vertexOffset),
                 .firstInstance = 0,
             },
@@ -274,6 +282,8 @@ void GPUScene::UpdateObjectInstancesData(uint32_t frameIndex)
         assert(resources->MaterialResourceManager().IsValid(mesh->material) && "There should always be a material available");
 
         instance.model = TransformHelpers::GetWorldMatrix(transformComponent);
+        instance.positionOffset = mesh->positionOffset;
+        instance.positionScale = mesh->positionScale;
         instance.materialIndex = mesh->material.Index();
         instance.boundingRadius = mesh->boundingRadius;
         instance.boneOffset = _skeletonBoneOffset[skinnedMeshComponent.skeletonEntity];
@@ -290,12 +300,13 @@ void GPUScene::UpdateObjectInstancesData(uint32_t frameIndex)
         SkinnedMeshComponent skinnedMeshComponent = skinnedMeshView.get<SkinnedMeshComponent>(entity);
         auto resources { _context->Resources() };
         auto mesh = resources->MeshResourceManager().Access(skinnedMeshComponent.mesh);
+        const GPUMeshLOD lod = SelectMeshLOD(*mesh, skinnedInstances[count].model);
 
         _skinnedDrawCommands.emplace_back(DrawIndexedIndirectCommand {
             .command = {
-                .indexCount = mesh->count,
+                .indexCount = lod.count,
                 .instanceCount = 0,
-                .firstIndex = mesh->indexOffset,
+                .firstIndex = lod.indexOffset,
                 .vertexOffset = static_cast<int32_t>(mesh->vertexOffset),
                 .firstInstance = 0,
             },
@@ -444,6 +455,9 @@ void GPUScene::UpdateCameraData(uint32_t frameIndex)
 
         auto position = TransformHelpers::GetWorldPosition(_ecs.GetRegistry(), entity);
 
+        _lodCameraPosition = position;
+        _lodCameraFov = cameraComponent.projection == CameraComponent::Projection::ePerspective ? cameraComponent.fov : 0.0f;
+
         _mainCamera.Update(frameIndex, cameraComponent, view, proj, position);
         _foregroundCamera.Update(frameIndex, cameraComponent, view, foregroundProj, position);
 
@@ -452,6 +466,29 @@ void GPUScene::UpdateCameraData(uint32_t frameIndex)
     }
 }
 
+GPUMeshLOD GPUScene::SelectMeshLOD(const GPUMesh& mesh, const glm::mat4& world) const
+{
+    const GPUMeshLOD fullDetail { mesh.count, mesh.indexOffset, 0.0f };
+
+    if (mesh.lods.empty() || _lodCameraFov <= 0.0f)
+        return fullDetail;
+
+    // The bounding radius is around the origin of the mesh, scaled by the largest axis of the transform
+    const float scale = glm::max(glm::length(glm::vec3 { world[0] }), glm::max(glm::length(glm::vec3 { world[1] }), glm::length(glm::vec3 { world[2] })));
+    const float radius = mesh.boundingRadius * scale;
+    const float projectedSize = LODSelection::ProjectedSize(radius, glm::distance(glm::vec3 { world[3] }, _lodCameraPosition), _lodCameraFov);
+
+    std::array<float, MeshSimplification::MAX_LODS> errors {};
+    const uint32_t lodCount = std::min(static_cast<uint32_t>(mesh.lods.size()), MeshSimplification::MAX_LODS);
+
+    for (uint32_t i = 0; i < lodCount; ++i)
+        errors[i] = mesh.lods[i].error;
+
+    // The errors and the bounding radius are both in the space of the mesh, so the scale of the instance doesn't matter here
+    const uint32_t selected = LODSelection::SelectLOD(std::span { errors.data(), lodCount }, mesh.boundingRadius, projectedSize);
+    return selected == 0 ? fullDetail : mesh.lods[selected - 1];
+}
+
 void GPUScene::UpdateSkinBuffers(uint32_t frameIndex)
 {
     auto jointView = _ecs.GetRegistry().view<JointSkinDataComponent, JointWorldTransformComponent>();
@@ -21,6 +21,8 @@ GraphicsResources::GraphicsResources(const std::shared_ptr<VulkanContext>& vulka
 
 void GraphicsResources::Clean()
 {
+    // Models first, they destroy the meshes, materials and images they own right away
+    _modelResourceManager->Clean();
     _meshResourceManager->Clean();
     _materialResourceManager->Clean();
     _imageResourceManager->Clean();
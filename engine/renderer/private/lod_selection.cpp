@@ -0,0 +1,34 @@
+#include "lod_selection.hpp"
+
+#include <cmath>
+#include <limits>
+
+float LODSelection::ProjectedSize(float radius, float distance, float fov)
+{
+    if (distance <= radius)
+        return std::numeric_limits<float>::infinity();
+
+    // The sphere touches the view cone at the tangent, which is closer than its center
+    const float tangentDistance = std::sqrt(distance * distance - radius * radius);
+    return radius / (tangentDistance * std::tan(fov * 0.5f));
+}
+
+uint32_t LODSelection::SelectLOD(std::span<const float> lodErrors, float boundingRadius, float projectedSize, float maxScreenError)
+{
+    if (boundingRadius <= 0.0f || std::isinf(projectedSize))
+        return 0;
+
+    // The projected size covers the diameter, the error is measured in the same units as the radius
+    const float screenPerUnit = projectedSize / (2.0f * boundingRadius);
+
+    uint32_t selected = 0;
+    for (uint32_t i = 0; i < lodErrors.size(); ++i)
+    {
+        if (lodErrors[i] * screenPerUnit > maxScreenError)
+            break;
+
+        selected = i + 1;
+    }
+
+    return selected;
+}
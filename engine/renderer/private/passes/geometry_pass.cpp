@@ -13,6 +13,7 @@
 #include "resource_management/buffer_resource_manager.hpp"
 #include "resource_management/image_resource_manager.hpp"
 #include "shaders/shader_loader.hpp"
+#include "vertex.hpp"
 #include "vulkan_context.hpp"
 
 GeometryPass::GeometryPass(const std::shared_ptr<GraphicsContext>& context, const GBuffers& gBuffers, const CameraBatch& cameraBatch)
@@ -79,6 +80,7 @@ void GeometryPass::CreateStaticPipeline()
                       .SetDepthStencilState(depthStencilStateCreateInfo)
                       .SetColorAttachmentFormats(formats)
                       .SetDepthAttachmentFormat(_gBuffers.DepthFormat())
+                      .SetVertexInput<GPUVertex>()
                       .BuildPipeline();
 
     _staticPipelineLayout = std::get<0>(result);
@@ -127,6 +129,7 @@ void GeometryPass::CreateSkinnedPipeline()
                       .SetDepthStencilState(depthStencilStateCreateInfo)
                       .SetColorAttachmentFormats(formats)
                       .SetDepthAttachmentFormat(_gBuffers.DepthFormat())
+                      .SetVertexInput<GPUSkinnedVertex>()
                       .BuildPipeline();
 
     _skinnedPipelineLayout = std::get<0>(result);
@@ -9,6 +9,7 @@
 #include "resource_management/buffer_resource_manager.hpp"
 #include "resource_management/image_resource_manager.hpp"
 #include "shaders/shader_loader.hpp"
+#include "vertex.hpp"
 #include "vulkan_context.hpp"
 
 #include <vector>
@@ -66,6 +67,7 @@ void ShadowPass::CreateStaticPipeline(const GPUScene& gpuScene)
                       .SetRasterizationState(rasterizationStateCreateInfo)
                       .SetColorAttachmentFormats({})
                       .SetDepthAttachmentFormat(_context->Resources()->ImageResourceManager().Access(gpuScene.StaticShadow())->format)
+                      .SetVertexInput<GPUVertex>()
                       .BuildPipeline();
 
     _staticPipelineLayout = std::get<0>(result);
@@ -100,6 +102,7 @@ void ShadowPass::CreateSkinnedPipeline(const GPUScene& gpuScene)
                       .SetRasterizationState(rasterizationStateCreateInfo)
                       .SetColorAttachmentFormats({})
                       .SetDepthAttachmentFormat(_context->Resources()->ImageResourceManager().Access(gpuScene.StaticShadow())->format)
+                      .SetVertexInput<GPUSkinnedVertex>()
                       .BuildPipeline();
 
     _skinnedPipelineLayout = std::get<0>(result);
@@ -10,6 +10,7 @@
 #include "resource_management/image_resource_manager.hpp"
 #include "resource_management/mesh_resource_manager.hpp"
 #include "shaders/shader_loader.hpp"
+#include "vertex.hpp"
 #include "vulkan_context.hpp"
 #include "vulkan_helper.hpp"
 
@@ -25,6 +26,9 @@ SkydomePass::SkydomePass(const std::shared_ptr<GraphicsContext>& context, Resour
 {
     CreatePipeline();
 
+    const GPUMesh* sphereMesh = _context->Resources()->MeshResourceManager().Access(_sphere);
+    _pushConstants.positionOffset = sphereMesh->positionOffset;
+    _pushConstants.positionScale = sphereMesh->positionScale;
     _pushConstants.hdriIndex = environmentMap.Index();
 }
 
@@ -76,7 +80,7 @@ void SkydomePass::RecordCommands(vk::CommandBuffer commandBuffer, uint32_t curre
 
     commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, _pipeline);
 
-    commandBuffer.pushConstants(_pipelineLayout, vk::ShaderStageFlagBits::eFragment, 0, sizeof(_pushConstants), &_pushConstants);
+    commandBuffer.pushConstants(_pipelineLayout, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 0, sizeof(_pushConstants), &_pushConstants);
 
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, _pipelineLayout, 0, { _context->BindlessSet() }, {});
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, _pipelineLayout, 1, { scene.gpuScene->MainCamera().DescriptorSet(currentFrame) }, {});
@@ -135,6 +139,7 @@ void SkydomePass::CreatePipeline()
                       .SetDepthStencilState(depthStencilStateCreateInfo)
                       .SetColorAttachmentFormats(formats)
                       .SetDepthAttachmentFormat(_gBuffers.DepthFormat())
+                      .SetVertexInput<GPUVertex>()
                       .BuildPipeline();
 
     _pipelineLayout = std::get<0>(result);
@@ -278,7 +278,7 @@ std::tuple<vk::PipelineLayout, vk::Pipeline> GraphicsPipelineBuilder::BuildPipel
 
 void GraphicsPipelineBuilder::ReflectShader(const ShaderStage& shaderStage)
 {
-    if (shaderStage.stage & vk::ShaderStageFlagBits::eVertex)
+    if (shaderStage.stage & vk::ShaderStageFlagBits::eVertex && !_hasVertexInput)
     {
         ReflectVertexInput(shaderStage);
     }
@@ -636,6 +636,9 @@ void Renderer::Render(float deltaTime)
         util::VK_ASSERT(_context->VulkanContext()->Device().resetFences(1, &_inFlightFences[_currentFrame]), "Failed resetting fences!");
     }
 
+    // Only once the frame is sure to be submitted, so every call counts a frame that finished on the GPU
+    _context->Resources()->Clean();
+
     {
         ZoneNamedN(zz, "Reset Command Buffer", true);
         _commandBuffers[_currentFrame].reset();
@@ -696,7 +699,5 @@ void Renderer::Render(float deltaTime)
         util::VK_ASSERT(result, "Failed acquiring next image from swap chain!");
     }
 
-    _context->Resources()->Clean();
-
     _currentFrame = (_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
@@ -0,0 +1,36 @@
+#include "resource_owner.hpp"
+
+#include "graphics_context.hpp"
+#include "graphics_resources.hpp"
+#include "resource_management/image_resource_manager.hpp"
+#include "resource_management/sampler_resource_manager.hpp"
+
+ResourceOwner::ResourceOwner(GraphicsContext& context)
+    : _resources(context.Resources())
+{
+}
+
+ResourceOwner::~ResourceOwner()
+{
+    for (const auto& image : _images)
+    {
+        _resources->ImageResourceManager().DestroyDeferred(image);
+    }
+
+    for (const auto& sampler : _samplers)
+    {
+        _resources->SamplerResourceManager().DestroyDeferred(sampler);
+    }
+}
+
+ResourceHandle<GPUImage> ResourceOwner::Own(ResourceHandle<GPUImage> image)
+{
+    _images.emplace_back(image);
+    return image;
+}
+
+ResourceHandle<Sampler> ResourceOwner::Own(ResourceHandle<Sampler> sampler)
+{
+    _samplers.emplace_back(sampler);
+    return sampler;
+}
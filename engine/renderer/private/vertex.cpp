@@ -81,3 +81,85 @@ std::array<vk::VertexInputAttributeDescription, 6> SkinnedVertex::GetAttributeDe
 
     return attributeDescriptions;
 }
+
+vk::VertexInputBindingDescription PackedVertex::GetBindingDescription()
+{
+    vk::VertexInputBindingDescription bindingDesc;
+    bindingDesc.binding = 0;
+    bindingDesc.stride = sizeof(PackedVertex);
+    bindingDesc.inputRate = vk::VertexInputRate::eVertex;
+
+    return bindingDesc;
+}
+
+std::array<vk::VertexInputAttributeDescription, 4> PackedVertex::GetAttributeDescriptions()
+{
+    std::array<vk::VertexInputAttributeDescription, 4> attributeDescriptions {};
+    attributeDescriptions[ePOSITION].binding = 0;
+    attributeDescriptions[ePOSITION].location = 0;
+    attributeDescriptions[ePOSITION].format = vk::Format::eR16G16B16A16Unorm;
+    attributeDescriptions[ePOSITION].offset = offsetof(PackedVertex, position);
+
+    attributeDescriptions[eNORMAL].binding = 0;
+    attributeDescriptions[eNORMAL].location = 1;
+    attributeDescriptions[eNORMAL].format = vk::Format::eR16G16Unorm;
+    attributeDescriptions[eNORMAL].offset = offsetof(PackedVertex, normal);
+
+    attributeDescriptions[eTANGENT].binding = 0;
+    attributeDescriptions[eTANGENT].location = 2;
+    attributeDescriptions[eTANGENT].format = vk::Format::eR16G16Unorm;
+    attributeDescriptions[eTANGENT].offset = offsetof(PackedVertex, tangent);
+
+    attributeDescriptions[eTEX_COORD].binding = 0;
+    attributeDescriptions[eTEX_COORD].location = 3;
+    attributeDescriptions[eTEX_COORD].format = vk::Format::eR16G16Sfloat;
+    attributeDescriptions[eTEX_COORD].offset = offsetof(PackedVertex, texCoord);
+
+    return attributeDescriptions;
+}
+
+vk::VertexInputBindingDescription PackedSkinnedVertex::GetBindingDescription()
+{
+    vk::VertexInputBindingDescription bindingDesc;
+    bindingDesc.binding = 0;
+    bindingDesc.stride = sizeof(PackedSkinnedVertex);
+    bindingDesc.inputRate = vk::VertexInputRate::eVertex;
+
+    return bindingDesc;
+}
+
+std::array<vk::VertexInputAttributeDescription, 6> PackedSkinnedVertex::GetAttributeDescriptions()
+{
+    std::array<vk::VertexInputAttributeDescription, 6> attributeDescriptions {};
+    attributeDescriptions[ePOSITION].binding = 0;
+    attributeDescriptions[ePOSITION].location = 0;
+    attributeDescriptions[ePOSITION].format = vk::Format::eR16G16B16A16Unorm;
+    attributeDescriptions[ePOSITION].offset = offsetof(PackedSkinnedVertex, position);
+
+    attributeDescriptions[eNORMAL].binding = 0;
+    attributeDescriptions[eNORMAL].location = 1;
+    attributeDescriptions[eNORMAL].format = vk::Format::eR16G16Unorm;
+    attributeDescriptions[eNORMAL].offset = offsetof(PackedSkinnedVertex, normal);
+
+    attributeDescriptions[eTANGENT].binding = 0;
+    attributeDescriptions[eTANGENT].location = 2;
+    attributeDescriptions[eTANGENT].format = vk::Format::eR16G16Unorm;
+    attributeDescriptions[eTANGENT].offset = offsetof(PackedSkinnedVertex, tangent);
+
+    attributeDescriptions[eTEX_COORD].binding = 0;
+    attributeDescriptions[eTEX_COORD].location = 3;
+    attributeDescriptions[eTEX_COORD].format = vk::Format::eR16G16Sfloat;
+    attributeDescriptions[eTEX_COORD].offset = offsetof(PackedSkinnedVertex, texCoord);
+
+    attributeDescriptions[eJOINTS].binding = 0;
+    attributeDescriptions[eJOINTS].location = 4;
+    attributeDescriptions[eJOINTS].format = vk::Format::eR8G8B8A8Uint;
+    attributeDescriptions[eJOINTS].offset = offsetof(PackedSkinnedVertex, joints);
+
+    attributeDescriptions[eWEIGHTS].binding = 0;
+    attributeDescriptions[eWEIGHTS].location = 5;
+    attributeDescriptions[eWEIGHTS].format = vk::Format::eR16G16B16A16Unorm;
+    attributeDescriptions[eWEIGHTS].offset = offsetof(PackedSkinnedVertex, weights);
+
+    return attributeDescriptions;
+}
@@ -0,0 +1,229 @@
+#include "vertex_quantization.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <glm/geometric.hpp>
+#include <stdexcept>
+#include <string>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+constexpr float UNORM16_MAX = 65535.0f;
+
+glm::vec3 DecodePosition(const std::array<uint16_t, 4>& position, const VertexQuantization::PositionBounds& bounds)
+{
+    const glm::vec3 normalized {
+        VertexQuantization::DecodeUnorm16(position[0]),
+        VertexQuantization::DecodeUnorm16(position[1]),
+        VertexQuantization::DecodeUnorm16(position[2]),
+    };
+
+    return bounds.offset + normalized * bounds.scale;
+}
+
+template <typename TPacked, typename TVertex>
+void QuantizeShared(TPacked& packed, const TVertex& vertex, const VertexQuantization::PositionBounds& bounds)
+{
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+        // A flat mesh has no extent along one of the axes, every position is at the offset
+        const float normalized = bounds.scale[axis] > 0.0f ? (vertex.position[axis] - bounds.offset[axis]) / bounds.scale[axis] : 0.0f;
+        packed.position[axis] = VertexQuantization::EncodeUnorm16(normalized);
+    }
+
+    packed.position[3] = vertex.tangent.w < 0.0f ? 0 : UINT16_MAX;
+    packed.normal = VertexQuantization::EncodeOctahedral(vertex.normal);
+    packed.tangent = VertexQuantization::EncodeOctahedral(glm::vec3 { vertex.tangent });
+    packed.texCoord = { VertexQuantization::EncodeHalf(vertex.texCoord.x), VertexQuantization::EncodeHalf(vertex.texCoord.y) };
+}
+
+template <typename TVertex, typename TPacked>
+void DequantizeShared(TVertex& vertex, const TPacked& packed, const VertexQuantization::PositionBounds& bounds)
+{
+    vertex.position = DecodePosition(packed.position, bounds);
+    vertex.normal = VertexQuantization::DecodeOctahedral(packed.normal);
+    vertex.tangent = glm::vec4 { VertexQuantization::DecodeOctahedral(packed.tangent), packed.position[3] == 0 ? -1.0f : 1.0f };
+    vertex.texCoord = glm::vec2 { VertexQuantization::DecodeHalf(packed.texCoord[0]), VertexQuantization::DecodeHalf(packed.texCoord[1]) };
+}
+
+}
+
+VertexQuantization::PositionBounds VertexQuantization::MakePositionBounds(const math::Vec3Range& boundingBox)
+{
+    // An empty mesh keeps the bounds it was initialized with, min above max
+    if (boundingBox.min.x > boundingBox.max.x || boundingBox.min.y > boundingBox.max.y || boundingBox.min.z > boundingBox.max.z)
+        return PositionBounds {};
+
+    return PositionBounds { boundingBox.min, boundingBox.max - boundingBox.min };
+}
+
+uint16_t VertexQuantization::EncodeUnorm16(float value)
+{
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * UNORM16_MAX));
+}
+
+float VertexQuantization::DecodeUnorm16(uint16_t value)
+{
+    return static_cast<float>(value) / UNORM16_MAX;
+}
+
+uint16_t VertexQuantization::EncodeHalf(float value)
+{
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const uint32_t absolute = bits & 0x7FFFFFFF;
+
+    // Too large for a half becomes infinity, NaN stays NaN
+    if (absolute >= 0x47800000)
+        return static_cast<uint16_t>(sign | (absolute > 0x7F800000 ? 0x7E00 : 0x7C00));
+
+    // Below the smallest normal half the value is stored as a multiple of 2^-24
+    if (absolute < 0x38800000)
+        return static_cast<uint16_t>(sign | static_cast<uint32_t>(std::nearbyint(std::bit_cast<float>(absolute) * 16777216.0f)));
+
+    // Rebias the exponent from 127 to 15 and round the mantissa from 23 to 10 bits, ties to even
+    const uint32_t rounded = absolute + 0x0FFF + ((absolute >> 13) & 1);
+    return static_cast<uint16_t>(sign | ((rounded - 0x38000000) >> 13));
+}
+
+float VertexQuantization::DecodeHalf(uint16_t value)
+{
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x3FF;
+
+    if (exponent == 0)
+    {
+        const float magnitude = static_cast<float>(mantissa) / 16777216.0f;
+        return sign != 0 ? -magnitude : magnitude;
+    }
+
+    if (exponent == 0x1F)
+        return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13));
+
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+std::array<uint16_t, 2> VertexQuantization::EncodeOctahedral(glm::vec3 direction)
+{
+    const float length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    if (length == 0.0f)
+        return { EncodeUnorm16(0.5f), EncodeUnorm16(0.5f) };
+
+    direction /= length;
+
+    glm::vec2 encoded { direction.x, direction.y };
+
+    // The lower half is folded over the diagonals onto the corners of the square
+    if (direction.z < 0.0f)
+    {
+        encoded = glm::vec2 {
+            (1.0f - std::abs(direction.y)) * (direction.x < 0.0f ? -1.0f : 1.0f),
+            (1.0f - std::abs(direction.x)) * (direction.y < 0.0f ? -1.0f : 1.0f),
+        };
+    }
+
+    return { EncodeUnorm16(encoded.x * 0.5f + 0.5f), EncodeUnorm16(encoded.y * 0.5f + 0.5f) };
+}
+
+glm::vec3 VertexQuantization::DecodeOctahedral(const std::array<uint16_t, 2>& encoded)
+{
+    const glm::vec2 unfolded = glm::vec2 { DecodeUnorm16(encoded[0]), DecodeUnorm16(encoded[1]) } * 2.0f - 1.0f;
+
+    glm::vec3 direction { unfolded.x, unfolded.y, 1.0f - std::abs(unfolded.x) - std::abs(unfolded.y) };
+    const float fold = std::max(-direction.z, 0.0f);
+    direction.x += direction.x >= 0.0f ? -fold : fold;
+    direction.y += direction.y >= 0.0f ? -fold : fold;
+
+    return glm::normalize(direction);
+}
+
+PackedVertex VertexQuantization::Quantize(const Vertex& vertex, const PositionBounds& bounds)
+{
+    PackedVertex packed {};
+    QuantizeShared(packed, vertex, bounds);
+    return packed;
+}
+
+Vertex VertexQuantization::Dequantize(const PackedVertex& vertex, const PositionBounds& bounds)
+{
+    Vertex dequantized {};
+    DequantizeShared(dequantized, vertex, bounds);
+    return dequantized;
+}
+
+PackedSkinnedVertex VertexQuantization::Quantize(const SkinnedVertex& vertex, const PositionBounds& bounds)
+{
+    PackedSkinnedVertex packed {};
+    QuantizeShared(packed, vertex, bounds);
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (vertex.joints[i] < 0.0f || vertex.joints[i] > static_cast<float>(MAX_JOINT_INDEX))
+            throw std::runtime_error("Joint index " + std::to_string(vertex.joints[i]) + " does not fit in a packed vertex");
+
+        packed.joints[i] = static_cast<uint8_t>(vertex.joints[i]);
+    }
+
+    // Rounding every weight on its own can make them add up to slightly more or less than one,
+    // the difference is given to the largest weight where it matters least
+    const float weightSum = vertex.weights.x + vertex.weights.y + vertex.weights.z + vertex.weights.w;
+    if (weightSum > 0.0f)
+    {
+        int32_t quantizedSum = 0;
+        uint32_t largest = 0;
+
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            packed.weights[i] = EncodeUnorm16(vertex.weights[i] / weightSum);
+            quantizedSum += packed.weights[i];
+
+            if (vertex.weights[i] > vertex.weights[largest])
+                largest = i;
+        }
+
+        packed.weights[largest] = static_cast<uint16_t>(packed.weights[largest] + (UINT16_MAX - quantizedSum));
+    }
+
+    return packed;
+}
+
+SkinnedVertex VertexQuantization::Dequantize(const PackedSkinnedVertex& vertex, const PositionBounds& bounds)
+{
+    SkinnedVertex dequantized {};
+    DequantizeShared(dequantized, vertex, bounds);
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        dequantized.joints[i] = static_cast<float>(vertex.joints[i]);
+        dequantized.weights[i] = DecodeUnorm16(vertex.weights[i]);
+    }
+
+    return dequantized;
+}
+
+std::vector<PackedVertex> VertexQuantization::Quantize(const std::vector<Vertex>& vertices, const PositionBounds& bounds)
+{
+    ZoneScoped;
+
+    std::vector<PackedVertex> packed(vertices.size());
+    std::transform(vertices.begin(), vertices.end(), packed.begin(), [&bounds](const Vertex& vertex)
+        { return Quantize(vertex, bounds); });
+
+    return packed;
+}
+
+std::vector<PackedSkinnedVertex> VertexQuantization::Quantize(const std::vector<SkinnedVertex>& vertices, const PositionBounds& bounds)
+{
+    ZoneScoped;
+
+    std::vector<PackedSkinnedVertex> packed(vertices.size());
+    std::transform(vertices.begin(), vertices.end(), packed.begin(), [&bounds](const SkinnedVertex& vertex)
+        { return Quantize(vertex, bounds); });
+
+    return packed;
+}
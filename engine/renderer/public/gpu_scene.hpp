@@ -16,6 +16,8 @@ class BatchBuffer;
 class ECSModule;
 class GraphicsContext;
 class CameraBatch;
+struct GPUMesh;
+struct GPUMeshLOD;
 
 struct GPUSceneCreation
 {
@@ -190,12 +192,16 @@ private:
     {
         glm::mat4 model {};
 
+        // Decodes the positions of packed vertices, see VertexQuantization
+        glm::vec3 positionOffset { 0.0f };
         uint32_t materialIndex {};
+        glm::vec3 positionScale { 1.0f };
         float boundingRadius {};
+
         uint32_t boneOffset {};
         bool isStaticDraw {};
         float transparency = 1.0f;
-        uint32_t padding[3];
+        uint32_t padding;
     };
 
     struct alignas(16) DecalData
@@ -292,6 +298,10 @@ private:
 
     std::unordered_map<entt::entity, uint32_t> _skeletonBoneOffset {};
 
+    // The main camera, which the LODs of the meshes are selected for. Without a perspective camera the fov is 0 and everything is drawn at full detail.
+    glm::vec3 _lodCameraPosition { 0.0f };
+    float _lodCameraFov { 0.0f };
+
     void UpdateSceneData(uint32_t frameIndex);
     void UpdatePointLightArray(uint32_t frameIndex);
     void UpdateObjectInstancesData(uint32_t frameIndex);
@@ -301,6 +311,8 @@ private:
     void UpdateSkinBuffers(uint32_t frameIndex);
     void UpdateDecalBuffer(uint32_t frameIndex);
 
+    GPUMeshLOD SelectMeshLOD(const GPUMesh& mesh, const glm::mat4& world) const;
+
     void InitializeSceneBuffers();
     void InitializePointLightBuffer();
     void InitializeClusterBuffer();
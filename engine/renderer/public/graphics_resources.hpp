@@ -21,6 +21,7 @@ public:
     class SamplerResourceManager& SamplerResourceManager() { return *_samplerResourceManager; }
     class ModelResourceManager& ModelResourceManager() { return *_modelResourceManager; }
 
+    // Runs the deferred destroys of every manager, once per submitted frame
     void Clean();
 
 private:
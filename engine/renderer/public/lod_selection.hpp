@@ -0,0 +1,22 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <cstdint>
+#include <span>
+
+// Picks which LOD of a mesh to draw from how large it appears on screen. The error of a LOD is scaled by the projected size of the mesh,
+// the least detailed LOD whose error stays below the limit is drawn.
+namespace LODSelection
+{
+// Largest error a LOD may show, as a fraction of the screen height, about a pixel at 1080p
+constexpr float DEFAULT_MAX_SCREEN_ERROR = 1.0f / 1080.0f;
+
+// Fraction of the screen height covered by a sphere of the given radius, fov is the vertical field of view in radians.
+// Infinite when the camera is inside the sphere.
+NO_DISCARD float ProjectedSize(float radius, float distance, float fov);
+
+// Returns 0 for the full detail mesh and i + 1 for lodErrors[i], which are ordered from more to less detailed.
+// The errors are in the same space as the bounding radius.
+NO_DISCARD uint32_t SelectLOD(std::span<const float> lodErrors, float boundingRadius, float projectedSize, float maxScreenError = DEFAULT_MAX_SCREEN_ERROR);
+}
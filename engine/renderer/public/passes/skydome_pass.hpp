@@ -27,7 +27,9 @@ public:
 private:
     struct PushConstants
     {
+        glm::vec3 positionOffset { 0.0f };
         uint32_t hdriIndex;
+        glm::vec3 positionScale { 1.0f };
     } _pushConstants;
 
     std::shared_ptr<GraphicsContext> _context;
@@ -121,6 +121,18 @@ public:
         return *this;
     }
 
+    // Takes the vertex input from the layout of TVertex instead of reflecting it from the vertex shader,
+    // reflection only sees the types in the shader and can't tell normalized or integer formats apart
+    template <typename TVertex>
+    GraphicsPipelineBuilder& SetVertexInput()
+    {
+        const auto attributeDescriptions = TVertex::GetAttributeDescriptions();
+        _attributeDescriptions.assign(attributeDescriptions.begin(), attributeDescriptions.end());
+        _bindingDescriptions = { TVertex::GetBindingDescription() };
+        _hasVertexInput = true;
+        return *this;
+    }
+
     const std::vector<vk::VertexInputAttributeDescription>& GetVertexAttributeDescriptions() const { return _attributeDescriptions; }
     const std::vector<vk::VertexInputBindingDescription>& GetVertexBindingDescriptions() const { return _bindingDescriptions; }
 
@@ -143,6 +155,8 @@ private:
     std::vector<vk::Format> _colorAttachmentFormats;
     vk::Format _depthFormat { vk::Format::eUndefined };
 
+    bool _hasVertexInput { false };
+
     void ReflectVertexInput(const ShaderStage& shaderStage);
 };
 
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "common.hpp"
+#include "resource_manager.hpp"
+
+#include <memory>
+#include <vector>
+
+struct GPUImage;
+class GraphicsContext;
+class GraphicsResources;
+struct Sampler;
+
+// Owns the images and samplers an object creates at runtime, like the textures of a menu or the atlas of a font, and destroys
+// them when the object is destroyed. Destroying is deferred until the frames in flight are done with them.
+class ResourceOwner
+{
+public:
+    explicit ResourceOwner(GraphicsContext& context);
+    ~ResourceOwner();
+
+    NON_COPYABLE(ResourceOwner);
+    NON_MOVABLE(ResourceOwner);
+
+    // Returns the handle, so a resource can be owned where it is created
+    ResourceHandle<GPUImage> Own(ResourceHandle<GPUImage> image);
+    ResourceHandle<Sampler> Own(ResourceHandle<Sampler> sampler);
+
+private:
+    // Shared, so owners don't have to be destroyed before the renderer
+    std::shared_ptr<GraphicsResources> _resources;
+
+    std::vector<ResourceHandle<GPUImage>> _images;
+    std::vector<ResourceHandle<Sampler>> _samplers;
+};
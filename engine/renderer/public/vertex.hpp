@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <type_traits>
 #include <vulkan_include.hpp>
 
 #include <glm/vec2.hpp>
@@ -93,3 +95,60 @@ struct SkinnedVertex
     static vk::VertexInputBindingDescription GetBindingDescription();
     static std::array<vk::VertexInputAttributeDescription, 6> GetAttributeDescriptions();
 };
+
+// Compact layout of Vertex, 20 instead of 48 bytes, see VertexQuantization for how every attribute is encoded
+struct PackedVertex
+{
+    enum Enumeration
+    {
+        ePOSITION,
+        eNORMAL,
+        eTANGENT,
+        eTEX_COORD,
+    };
+
+    std::array<uint16_t, 4> position {}; // Unorm16 within the bounds of the mesh, w holds the sign of the bitangent
+    std::array<uint16_t, 2> normal {}; // Octahedral, unorm16
+    std::array<uint16_t, 2> tangent {}; // Octahedral, unorm16
+    std::array<uint16_t, 2> texCoord {}; // Half float
+
+    static vk::VertexInputBindingDescription GetBindingDescription();
+    static std::array<vk::VertexInputAttributeDescription, 4> GetAttributeDescriptions();
+};
+
+// Compact layout of SkinnedVertex, 32 instead of 80 bytes
+struct PackedSkinnedVertex
+{
+    enum Enumeration
+    {
+        ePOSITION,
+        eNORMAL,
+        eTANGENT,
+        eTEX_COORD,
+        eJOINTS,
+        eWEIGHTS,
+    };
+
+    std::array<uint16_t, 4> position {};
+    std::array<uint16_t, 2> normal {};
+    std::array<uint16_t, 2> tangent {};
+    std::array<uint16_t, 2> texCoord {};
+    std::array<uint8_t, 4> joints {};
+    std::array<uint16_t, 4> weights {}; // Unorm16, adding up to exactly 1
+
+    static vk::VertexInputBindingDescription GetBindingDescription();
+    static std::array<vk::VertexInputAttributeDescription, 6> GetAttributeDescriptions();
+};
+
+static_assert(sizeof(PackedVertex) == 20);
+static_assert(sizeof(PackedSkinnedVertex) == 32);
+
+#ifdef PACKED_VERTICES
+constexpr bool USE_PACKED_VERTICES = true;
+#else
+constexpr bool USE_PACKED_VERTICES = false;
+#endif
+
+// The layouts meshes are stored in on the GPU, set with the PACKED_VERTICES build option
+using GPUVertex = std::conditional_t<USE_PACKED_VERTICES, PackedVertex, Vertex>;
+using GPUSkinnedVertex = std::conditional_t<USE_PACKED_VERTICES, PackedSkinnedVertex, SkinnedVertex>;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "common.hpp"
+#include "math_util.hpp"
+#include "vertex.hpp"
+
+#include <array>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <vector>
+
+// Converts vertices to PackedVertex and PackedSkinnedVertex and back, the shaders decode them the same way as the functions here.
+// Positions are stored relative to the bounds of their mesh, the offset and scale are passed along in the instance data.
+namespace VertexQuantization
+{
+// Largest joint index PackedSkinnedVertex can hold
+constexpr uint32_t MAX_JOINT_INDEX = 255;
+
+struct PositionBounds
+{
+    glm::vec3 offset { 0.0f };
+    glm::vec3 scale { 1.0f };
+};
+
+NO_DISCARD PositionBounds MakePositionBounds(const math::Vec3Range& boundingBox);
+
+// Rounds to the nearest value, values outside of [0, 1] are clamped
+NO_DISCARD uint16_t EncodeUnorm16(float value);
+NO_DISCARD float DecodeUnorm16(uint16_t value);
+
+// IEEE 754 half float, rounds to the nearest even value
+NO_DISCARD uint16_t EncodeHalf(float value);
+NO_DISCARD float DecodeHalf(uint16_t value);
+
+// Maps a direction onto an octahedron unfolded into a square, in the same way as octahedron.glsl
+NO_DISCARD std::array<uint16_t, 2> EncodeOctahedral(glm::vec3 direction);
+NO_DISCARD glm::vec3 DecodeOctahedral(const std::array<uint16_t, 2>& encoded);
+
+NO_DISCARD PackedVertex Quantize(const Vertex& vertex, const PositionBounds& bounds);
+NO_DISCARD Vertex Dequantize(const PackedVertex& vertex, const PositionBounds& bounds);
+
+// Throws when a joint index does not fit in PackedSkinnedVertex
+NO_DISCARD PackedSkinnedVertex Quantize(const SkinnedVertex& vertex, const PositionBounds& bounds);
+NO_DISCARD SkinnedVertex Dequantize(const PackedSkinnedVertex& vertex, const PositionBounds& bounds);
+
+NO_DISCARD std::vector<PackedVertex> Quantize(const std::vector<Vertex>& vertices, const PositionBounds& bounds);
+NO_DISCARD std::vector<PackedSkinnedVertex> Quantize(const std::vector<SkinnedVertex>& vertices, const PositionBounds& bounds);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "lod_selection.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+TEST(LODSelectionTests, ProjectedSizeOfKnownSpheres)
+{
+    // Arrange
+    const float fov = std::numbers::pi_v<float> / 2.0f;
+
+    // Act & Assert, at this distance the tangent is one unit away and the edge of a 90 degree view is one unit to the side
+    EXPECT_NEAR(LODSelection::ProjectedSize(1.0f, std::sqrt(2.0f), fov), 1.0f, 1e-5f);
+
+    // Far away the size falls off with the distance
+    EXPECT_NEAR(LODSelection::ProjectedSize(1.0f, 1000.0f, fov), 0.001f, 1e-6f);
+    EXPECT_NEAR(LODSelection::ProjectedSize(2.0f, 2000.0f, fov), LODSelection::ProjectedSize(1.0f, 1000.0f, fov), 1e-6f);
+
+    EXPECT_TRUE(std::isinf(LODSelection::ProjectedSize(1.0f, 0.5f, fov)));
+}
+
+TEST(LODSelectionTests, ThresholdsFollowTheScreenError)
+{
+    // Arrange, with a radius of one a LOD is allowed once its error times half the projected size is at most the screen error
+    const std::array<float, 3> errors { 0.01f, 0.02f, 0.04f };
+    const float maxScreenError = 0.001f;
+
+    // Act & Assert
+    EXPECT_EQ(LODSelection::SelectLOD(errors, 1.0f, 0.21f, maxScreenError), 0);
+    EXPECT_EQ(LODSelection::SelectLOD(errors, 1.0f, 0.19f, maxScreenError), 1);
+    EXPECT_EQ(LODSelection::SelectLOD(errors, 1.0f, 0.11f, maxScreenError), 1);
+    EXPECT_EQ(LODSelection::SelectLOD(errors, 1.0f, 0.09f, maxScreenError), 2);
+    EXPECT_EQ(LODSelection::SelectLOD(errors, 1.0f, 0.049f, maxScreenError), 3);
+    EXPECT_EQ(LODSelection::SelectLOD(errors, 1.0f, 0.0001f, maxScreenError), 3);
+
+    // The same mesh twice as large has errors twice as large, which is made up for by the radius
+    const std::array<float, 3> scaledErrors { 0.02f, 0.04f, 0.08f };
+    EXPECT_EQ(LODSelection::SelectLOD(scaledErrors, 2.0f, 0.09f, maxScreenError), 2);
+}
+
+TEST(LODSelectionTests, FurtherAwayNeverDrawsMoreDetail)
+{
+    // Arrange
+    const std::array<float, 4> errors { 0.002f, 0.01f, 0.03f, 0.05f };
+    const float fov = std::numbers::pi_v<float> / 3.0f;
+    uint32_t previous = 0;
+
+    // Act & Assert
+    for (float distance = 0.5f; distance < 2000.0f; distance *= 1.1f)
+    {
+        const uint32_t lod = LODSelection::SelectLOD(errors, 1.0f, LODSelection::ProjectedSize(1.0f, distance, fov));
+        EXPECT_GE(lod, previous) << distance;
+        previous = lod;
+    }
+
+    EXPECT_EQ(previous, errors.size());
+}
+
+TEST(LODSelectionTests, FullDetailWithoutLODsOrUpClose)
+{
+    // Arrange
+    const std::vector<float> noErrors {};
+    const std::array<float, 2> errors { 0.0f, 0.0f };
+
+    // Act & Assert
+    EXPECT_EQ(LODSelection::SelectLOD(noErrors, 1.0f, 0.0001f), 0);
+    EXPECT_EQ(LODSelection::SelectLOD(errors, 1.0f, LODSelection::ProjectedSize(1.0f, 0.5f, 1.0f)), 0);
+    EXPECT_EQ(LODSelection::SelectLOD(errors, 0.0f, 0.5f), 0);
+}
@@ -4,6 +4,8 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 TEST(ResourceManagerTests, Creating)
 {
@@ -51,6 +53,52 @@ TEST(ResourceManagerTests, Destroying)
     EXPECT_EQ(rm->Access(handle), nullptr);
 }
 
+TEST(ResourceManagerTests, DeferredDestroyWaitsForFramesInFlight)
+{
+    // Arrange
+    ResourceManager<std::string> rm {};
+    auto handle = rm.Create("my_resource");
+
+    // Act
+    rm.DestroyDeferred(handle);
+
+    std::vector<bool> validAfterClean {};
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        rm.Clean();
+        validAfterClean.emplace_back(rm.IsValid(handle));
+    }
+
+    // Assert
+    for (uint32_t i = 0; i + 1 < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        EXPECT_TRUE(validAfterClean[i]);
+    }
+
+    EXPECT_FALSE(validAfterClean.back());
+    EXPECT_EQ(rm.Access(handle), nullptr);
+}
+
+TEST(ResourceManagerTests, DeferredDestroyOfDestroyedHandleIsIgnored)
+{
+    // Arrange
+    ResourceManager<std::string> rm {};
+    auto stale = rm.Create("first");
+    rm.Destroy(stale);
+    auto current = rm.Create("second");
+
+    // Act
+    rm.DestroyDeferred(stale);
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        rm.Clean();
+    }
+
+    // Assert
+    ASSERT_NE(rm.Access(current), nullptr);
+    EXPECT_EQ(*rm.Access(current), "second");
+}
+
 TEST(ResourceManagerTests, Versioning)
 {
     // Arrange
@@ -71,3 +119,104 @@ TEST(ResourceManagerTests, Versioning)
     EXPECT_EQ(*rm->Access(handle2), original2);
     EXPECT_EQ(rm->Resources().size(), 1);
 }
+
+TEST(ResourceManagerTests, HandlesAreTriviallyCopyable)
+{
+    static_assert(std::is_trivially_copyable_v<ResourceHandle<std::string>>);
+    EXPECT_EQ(sizeof(ResourceHandle<std::string>), 2 * sizeof(uint32_t));
+}
+
+TEST(ResourceManagerTests, NullHandle)
+{
+    // Arrange
+    ResourceManager<std::string> rm {};
+    auto handle = rm.Create("my_resource");
+
+    // Act
+    ResourceHandle<std::string> nulled = handle;
+    nulled = nullptr;
+
+    // Assert
+    EXPECT_TRUE(ResourceHandle<std::string> {}.IsNull());
+    EXPECT_TRUE(nulled.IsNull());
+    EXPECT_EQ(nulled, ResourceHandle<std::string>::Null());
+    EXPECT_FALSE(handle.IsNull());
+    EXPECT_EQ(rm.Access(nulled), nullptr);
+    EXPECT_FALSE(rm.IsValid(nulled));
+}
+
+TEST(ResourceManagerTests, StaleHandleIsRejectedAfterManyReuses)
+{
+    // Arrange, more reuses than an 8 bit generation could tell apart
+    constexpr uint32_t REUSES = 300;
+
+    ResourceManager<std::string> rm {};
+    auto stale = rm.Create("first");
+    rm.Destroy(stale);
+
+    ResourceHandle<std::string> current {};
+    std::vector<ResourceHandle<std::string>> destroyed { stale };
+
+    // Act
+    for (uint32_t i = 0; i < REUSES; ++i)
+    {
+        current = rm.Create(std::to_string(i));
+
+        if (i + 1 < REUSES)
+        {
+            rm.Destroy(current);
+            destroyed.emplace_back(current);
+        }
+    }
+
+    // Assert
+    EXPECT_EQ(rm.Resources().size(), 1);
+    EXPECT_EQ(current.Index(), stale.Index());
+    EXPECT_EQ(current.Generation(), REUSES);
+    ASSERT_NE(rm.Access(current), nullptr);
+    EXPECT_EQ(*rm.Access(current), std::to_string(REUSES - 1));
+
+    for (const auto& handle : destroyed)
+    {
+        EXPECT_FALSE(rm.IsValid(handle));
+        EXPECT_EQ(rm.Access(handle), nullptr);
+    }
+}
+
+TEST(ResourceManagerTests, DestroyingStaleHandleKeepsNewResource)
+{
+    // Arrange
+    ResourceManager<std::string> rm {};
+    auto stale = rm.Create("old");
+    rm.Destroy(stale);
+    auto current = rm.Create("new");
+
+    // Act
+    rm.Destroy(stale);
+
+    // Assert
+    ASSERT_NE(rm.Access(current), nullptr);
+    EXPECT_EQ(*rm.Access(current), "new");
+}
+
+TEST(ResourceManagerTests, IndicesBeyond16Bits)
+{
+    // Arrange
+    constexpr uint32_t COUNT = 0x10000 + 16;
+    ResourceManager<uint32_t> rm {};
+    std::vector<ResourceHandle<uint32_t>> handles {};
+    handles.reserve(COUNT);
+
+    // Act
+    for (uint32_t i = 0; i < COUNT; ++i)
+        handles.emplace_back(rm.Create(uint32_t { i }));
+
+    // Assert
+    EXPECT_EQ(handles.back().Index(), COUNT - 1);
+
+    for (uint32_t i = 0; i < COUNT; ++i)
+    {
+        ASSERT_NE(rm.Access(handles[i]), nullptr);
+        EXPECT_EQ(*rm.Access(handles[i]), i);
+    }
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include "vertex_quantization.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+glm::vec3 RandomDirection(std::mt19937& random)
+{
+    std::normal_distribution<float> distribution {};
+
+    glm::vec3 direction {};
+    do
+    {
+        direction = glm::vec3 { distribution(random), distribution(random), distribution(random) };
+    } while (glm::length(direction) < 0.001f);
+
+    return glm::normalize(direction);
+}
+
+// The arc cosine of the dot product loses too much precision for nearly equal directions
+float AngleBetween(glm::vec3 a, glm::vec3 b)
+{
+    return std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b));
+}
+
+}
+
+TEST(VertexQuantizationTests, Unorm16ErrorIsHalfAStep)
+{
+    // Arrange
+    std::mt19937 random { 3 };
+    std::uniform_real_distribution<float> distribution { 0.0f, 1.0f };
+
+    // Act & Assert
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        const float value = distribution(random);
+        EXPECT_LE(std::abs(VertexQuantization::DecodeUnorm16(VertexQuantization::EncodeUnorm16(value)) - value), 0.5f / 65535.0f + 1e-7f);
+    }
+
+    EXPECT_EQ(VertexQuantization::EncodeUnorm16(0.0f), 0);
+    EXPECT_EQ(VertexQuantization::EncodeUnorm16(1.0f), 65535);
+    EXPECT_EQ(VertexQuantization::EncodeUnorm16(-0.5f), 0);
+    EXPECT_EQ(VertexQuantization::EncodeUnorm16(2.0f), 65535);
+}
+
+TEST(VertexQuantizationTests, HalfMatchesIEEE)
+{
+    // Arrange, values that a half holds exactly, and their bits
+    const std::vector<std::pair<float, uint16_t>> exact {
+        { 0.0f, 0x0000 }, { -0.0f, 0x8000 }, { 1.0f, 0x3C00 }, { -2.0f, 0xC000 }, { 0.5f, 0x3800 },
+        { 65504.0f, 0x7BFF }, { std::ldexp(1.0f, -14), 0x0400 }, { std::ldexp(1.0f, -24), 0x0001 },
+    };
+
+    // Act & Assert
+    for (const auto& [value, bits] : exact)
+    {
+        EXPECT_EQ(VertexQuantization::EncodeHalf(value), bits) << value;
+        EXPECT_EQ(VertexQuantization::DecodeHalf(bits), value) << value;
+    }
+
+    // Halfway between 1 and the next half rounds to the even one, which is 1
+    EXPECT_EQ(VertexQuantization::EncodeHalf(1.0f + std::ldexp(1.0f, -11)), 0x3C00);
+    EXPECT_EQ(VertexQuantization::EncodeHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)), 0x3C02);
+
+    EXPECT_EQ(VertexQuantization::EncodeHalf(100000.0f), 0x7C00);
+    EXPECT_EQ(VertexQuantization::EncodeHalf(-std::numeric_limits<float>::infinity()), 0xFC00);
+    EXPECT_TRUE(std::isnan(VertexQuantization::DecodeHalf(VertexQuantization::EncodeHalf(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(VertexQuantizationTests, HalfTexCoordErrorIsBounded)
+{
+    // Arrange, texture coordinates of tiling textures go past 1
+    std::mt19937 random { 5 };
+    std::uniform_real_distribution<float> distribution { -8.0f, 8.0f };
+
+    // Act & Assert, a half has 11 significant bits, so rounding is off by at most 2^-11 of the value
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        const float value = distribution(random);
+        const float decoded = VertexQuantization::DecodeHalf(VertexQuantization::EncodeHalf(value));
+        EXPECT_LE(std::abs(decoded - value), std::abs(value) * std::ldexp(1.0f, -11) + std::ldexp(1.0f, -25)) << value;
+    }
+}
+
+TEST(VertexQuantizationTests, OctahedralErrorIsBounded)
+{
+    // Arrange
+    std::mt19937 random { 7 };
+    float largestError = 0.0f;
+
+    // Act
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        const glm::vec3 direction = RandomDirection(random);
+        largestError = std::max(largestError, AngleBetween(direction, VertexQuantization::DecodeOctahedral(VertexQuantization::EncodeOctahedral(direction))));
+    }
+
+    // The axes and the directions on the fold are where the encoding is most likely to go wrong
+    for (const glm::vec3 direction : { glm::vec3 { 1, 0, 0 }, glm::vec3 { -1, 0, 0 }, glm::vec3 { 0, 1, 0 }, glm::vec3 { 0, -1, 0 },
+             glm::vec3 { 0, 0, 1 }, glm::vec3 { 0, 0, -1 }, glm::normalize(glm::vec3 { 1, -1, 0 }), glm::normalize(glm::vec3 { -1, -1, -1 }) })
+    {
+        largestError = std::max(largestError, AngleBetween(direction, VertexQuantization::DecodeOctahedral(VertexQuantization::EncodeOctahedral(direction))));
+    }
+
+    // Assert, well below what shading can show
+    EXPECT_LT(largestError, glm::radians(0.01f));
+}
+
+TEST(VertexQuantizationTests, VertexErrorIsBounded)
+{
+    // Arrange
+    std::mt19937 random { 11 };
+    std::uniform_real_distribution<float> distribution { 0.0f, 1.0f };
+
+    const math::Vec3Range boundingBox { glm::vec3 { -20.0f, 0.0f, -3.0f }, glm::vec3 { 40.0f, 5.0f, 3.0f } };
+    const VertexQuantization::PositionBounds bounds = VertexQuantization::MakePositionBounds(boundingBox);
+
+    // Half a step of the bounds on every axis
+    const glm::vec3 positionTolerance = bounds.scale / (2.0f * 65535.0f) + 1e-5f;
+
+    // Act & Assert
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        const glm::vec3 position = boundingBox.min + glm::vec3 { distribution(random), distribution(random), distribution(random) } * bounds.scale;
+        const Vertex vertex { position, RandomDirection(random), glm::vec4 { RandomDirection(random), i % 2 == 0 ? 1.0f : -1.0f },
+            glm::vec2 { distribution(random), distribution(random) } };
+
+        const Vertex decoded = VertexQuantization::Dequantize(VertexQuantization::Quantize(vertex, bounds), bounds);
+
+        for (uint32_t axis = 0; axis < 3; ++axis)
+            EXPECT_LE(std::abs(decoded.position[axis] - vertex.position[axis]), positionTolerance[axis]);
+
+        EXPECT_LT(AngleBetween(decoded.normal, vertex.normal), glm::radians(0.01f));
+        EXPECT_LT(AngleBetween(glm::vec3 { decoded.tangent }, glm::vec3 { vertex.tangent }), glm::radians(0.01f));
+        EXPECT_EQ(decoded.tangent.w, vertex.tangent.w);
+        EXPECT_LE(std::abs(decoded.texCoord.x - vertex.texCoord.x), std::ldexp(1.0f, -12));
+        EXPECT_LE(std::abs(decoded.texCoord.y - vertex.texCoord.y), std::ldexp(1.0f, -12));
+    }
+}
+
+TEST(VertexQuantizationTests, FlatMeshKeepsItsPlane)
+{
+    // Arrange, a floor has no height, so one of the axes of its bounds is empty
+    const VertexQuantization::PositionBounds bounds = VertexQuantization::MakePositionBounds(math::Vec3Range { glm::vec3 { -1.0f, 2.5f, -1.0f }, glm::vec3 { 1.0f, 2.5f, 1.0f } });
+    const Vertex vertex { glm::vec3 { 0.25f, 2.5f, -0.75f }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f } };
+
+    // Act
+    const Vertex decoded = VertexQuantization::Dequantize(VertexQuantization::Quantize(vertex, bounds), bounds);
+
+    // Assert
+    EXPECT_EQ(decoded.position.y, 2.5f);
+    EXPECT_NEAR(decoded.position.x, 0.25f, 2.0f / 65535.0f);
+    EXPECT_NEAR(decoded.position.z, -0.75f, 2.0f / 65535.0f);
+}
+
+TEST(VertexQuantizationTests, SkinnedVertexKeepsJointsAndWeights)
+{
+    // Arrange
+    const VertexQuantization::PositionBounds bounds = VertexQuantization::MakePositionBounds(math::Vec3Range { glm::vec3 { -1.0f }, glm::vec3 { 1.0f } });
+    const SkinnedVertex vertex { glm::vec3 { 0.5f }, glm::vec3 { 0.0f, 0.0f, 1.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, -1.0f }, glm::vec2 { 0.5f },
+        glm::vec4 { 0.0f, 17.0f, 254.0f, 255.0f }, glm::vec4 { 0.1f, 0.2f, 0.3f, 0.4f } };
+
+    // Act
+    const PackedSkinnedVertex packed = VertexQuantization::Quantize(vertex, bounds);
+    const SkinnedVertex decoded = VertexQuantization::Dequantize(packed, bounds);
+
+    // Assert
+    EXPECT_EQ(decoded.joints, vertex.joints);
+    EXPECT_EQ(packed.weights[0] + packed.weights[1] + packed.weights[2] + packed.weights[3], 65535);
+
+    for (uint32_t i = 0; i < 4; ++i)
+        EXPECT_LE(std::abs(decoded.weights[i] - vertex.weights[i]), 2.0f / 65535.0f);
+
+    EXPECT_EQ(decoded.tangent.w, -1.0f);
+}
+
+TEST(VertexQuantizationTests, JointsThatDoNotFitThrow)
+{
+    // Arrange
+    SkinnedVertex vertex {};
+    vertex.joints = glm::vec4 { 0.0f, 1.0f, 256.0f, 2.0f };
+    vertex.weights = glm::vec4 { 1.0f, 0.0f, 0.0f, 0.0f };
+
+    // Act & Assert
+    EXPECT_THROW(static_cast<void>(VertexQuantization::Quantize(vertex, VertexQuantization::PositionBounds {})), std::runtime_error);
+}
+
+TEST(VertexQuantizationTests, PackedVerticesAreSmaller)
+{
+    // Arrange
+    const std::vector<Vertex> vertices(1000);
+    const std::vector<SkinnedVertex> skinnedVertices(1000);
+
+    // Act
+    const std::vector<PackedVertex> packed = VertexQuantization::Quantize(vertices, VertexQuantization::PositionBounds {});
+    const std::vector<PackedSkinnedVertex> packedSkinned = VertexQuantization::Quantize(skinnedVertices, VertexQuantization::PositionBounds {});
+
+    // Assert
+    ASSERT_EQ(packed.size(), vertices.size());
+    ASSERT_EQ(packedSkinned.size(), skinnedVertices.size());
+    EXPECT_LE(packed.size() * sizeof(PackedVertex) * 2, vertices.size() * sizeof(Vertex));
+    EXPECT_LE(packedSkinned.size() * sizeof(PackedSkinnedVertex) * 2, skinnedVertices.size() * sizeof(SkinnedVertex));
+}
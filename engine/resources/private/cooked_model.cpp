@@ -0,0 +1,701 @@
+#include "cooked_model.hpp"
+
+#include "file_io.hpp"
+#include "hash_util.hpp"
+#include "ktx2.hpp"
+#include "log.hpp"
+#include "texture_compression.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+constexpr uint32_t COOKED_MODEL_MAGIC = 0x4D434242; // "BBCM"
+
+// Arrays start at a multiple of this from the start of the file, enough for any vertex attribute
+constexpr size_t ARRAY_ALIGNMENT = 16;
+
+struct CookedModelHeader
+{
+    uint32_t magic = COOKED_MODEL_MAGIC;
+    uint32_t version = CookedModel::COOK_VERSION;
+    CookedModel::Key sourceKey = 0;
+
+    // Vertices are stored as they are in memory, a changed layout makes the file unreadable
+    uint32_t vertexSize = sizeof(Vertex);
+    uint32_t skinnedVertexSize = sizeof(SkinnedVertex);
+};
+
+// Arrays are written as their element count followed by their bytes, the file is only ever read back by the same build,
+// so there is no need to care about endianness. Structs with padding are written field by field, so cooking the same model
+// always gives the same bytes.
+class CookWriter
+{
+public:
+    template <typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        _bytes.insert(_bytes.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    void WriteArray(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(static_cast<uint32_t>(values.size()));
+        Align();
+
+        const auto* bytes = reinterpret_cast<const std::byte*>(values.data());
+        _bytes.insert(_bytes.end(), bytes, bytes + values.size() * sizeof(T));
+    }
+
+    void WriteString(std::string_view value)
+    {
+        Write(static_cast<uint32_t>(value.size()));
+
+        const auto* bytes = reinterpret_cast<const std::byte*>(value.data());
+        _bytes.insert(_bytes.end(), bytes, bytes + value.size());
+    }
+
+    void WriteIndex(const std::optional<uint32_t>& index)
+    {
+        Write(static_cast<uint8_t>(index.has_value()));
+        Write(index.value_or(0));
+    }
+
+    void Align() { _bytes.resize((_bytes.size() + ARRAY_ALIGNMENT - 1) / ARRAY_ALIGNMENT * ARRAY_ALIGNMENT); }
+
+    void Reserve(size_t size) { _bytes.reserve(size); }
+    NO_DISCARD std::vector<std::byte> TakeBytes() { return std::move(_bytes); }
+
+private:
+    std::vector<std::byte> _bytes {};
+};
+
+class CookReader
+{
+public:
+    explicit CookReader(std::span<const std::byte> bytes)
+        : _bytes(bytes)
+    {
+    }
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (_bytes.size() - _offset < sizeof(T))
+            return false;
+
+        std::memcpy(&value, _bytes.data() + _offset, sizeof(T));
+        _offset += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool ReadArray(std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        uint32_t count = 0;
+        if (!Read(count) || !Align() || (_bytes.size() - _offset) / sizeof(T) < count)
+            return false;
+
+        values.resize(count);
+        std::memcpy(values.data(), _bytes.data() + _offset, count * sizeof(T));
+        _offset += count * sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string& value)
+    {
+        uint32_t size = 0;
+        if (!Read(size) || _bytes.size() - _offset < size)
+            return false;
+
+        value.assign(reinterpret_cast<const char*>(_bytes.data() + _offset), size);
+        _offset += size;
+        return true;
+    }
+
+    bool ReadIndex(std::optional<uint32_t>& index)
+    {
+        uint8_t hasValue = 0;
+        uint32_t value = 0;
+
+        if (!Read(hasValue) || !Read(value) || hasValue > 1)
+            return false;
+
+        index = hasValue ? std::optional<uint32_t> { value } : std::nullopt;
+        return true;
+    }
+
+    bool Align()
+    {
+        const size_t aligned = (_offset + ARRAY_ALIGNMENT - 1) / ARRAY_ALIGNMENT * ARRAY_ALIGNMENT;
+
+        if (aligned > _bytes.size())
+            return false;
+
+        _offset = aligned;
+        return true;
+    }
+
+    NO_DISCARD bool IsAtEnd() const { return _offset == _bytes.size(); }
+
+private:
+    std::span<const std::byte> _bytes;
+    size_t _offset = 0;
+};
+
+// Reads a count followed by that many elements, the count is checked against the bytes left so a corrupt count can't allocate the world
+template <typename T, typename ReadFunction>
+bool ReadElements(CookReader& reader, std::vector<T>& values, size_t remainingBytes, ReadFunction&& read)
+{
+    uint32_t count = 0;
+    if (!reader.Read(count) || count > remainingBytes)
+        return false;
+
+    values.resize(count);
+
+    for (T& value : values)
+    {
+        if (!read(reader, value))
+            return false;
+    }
+
+    return true;
+}
+
+template <typename T>
+void WriteMesh(CookWriter& writer, const CPUMesh<T>& mesh)
+{
+    writer.WriteArray(mesh.vertices);
+    writer.WriteArray(mesh.indices);
+    writer.Write(mesh.materialIndex);
+    writer.Write(mesh.boundingBox);
+    writer.Write(mesh.boundingRadius);
+
+    writer.Write(static_cast<uint32_t>(mesh.lods.size()));
+    for (const auto& lod : mesh.lods)
+    {
+        writer.WriteArray(lod.indices);
+        writer.Write(lod.error);
+    }
+}
+
+bool ReadLOD(CookReader& reader, MeshLOD& lod)
+{
+    return reader.ReadArray(lod.indices)
+        && reader.Read(lod.error);
+}
+
+template <typename T>
+bool ReadMesh(CookReader& reader, CPUMesh<T>& mesh, size_t remainingBytes)
+{
+    return reader.ReadArray(mesh.vertices)
+        && reader.ReadArray(mesh.indices)
+        && reader.Read(mesh.materialIndex)
+        && reader.Read(mesh.boundingBox)
+        && reader.Read(mesh.boundingRadius)
+        && ReadElements(reader, mesh.lods, remainingBytes, ReadLOD);
+}
+
+// The pixels are stored as a KTX2 container, the rest of the image is written around it
+void WriteImage(CookWriter& writer, const CPUImage& image)
+{
+    const std::optional<std::vector<std::byte>> container = KTX2::Serialize(image);
+    if (!container.has_value())
+        throw std::runtime_error("Texture " + image.name + " can't be stored in a KTX2 container");
+
+    writer.WriteString(image.name);
+    writer.Write(image.mips);
+    writer.Write(static_cast<VkImageUsageFlags>(image.flags));
+    writer.WriteArray(container.value());
+}
+
+bool ReadImage(CookReader& reader, CPUImage& image)
+{
+    std::string name {};
+    uint8_t mips = 0;
+    VkImageUsageFlags flags = 0;
+    std::vector<std::byte> container {};
+
+    if (!reader.ReadString(name) || !reader.Read(mips) || !reader.Read(flags) || !reader.ReadArray(container))
+        return false;
+
+    std::optional<CPUImage> decoded = KTX2::Deserialize(container);
+    if (!decoded.has_value())
+        return false;
+
+    // Images without their mips generate as many as they asked for when uploaded, compressed images can't and always have them
+    image = std::move(decoded.value());
+    image.name = std::move(name);
+    image.mips = mips;
+    image.flags = static_cast<vk::ImageUsageFlags>(flags);
+
+    return image.HasMipChain() || TextureCompression::GetBlockDimension(image.format) == 1;
+}
+
+void WriteMaterial(CookWriter& writer, const CPUMaterial& material)
+{
+    writer.WriteIndex(material.albedoMap);
+    writer.Write(material.albedoFactor);
+    writer.Write(material.albedoUVChannel);
+
+    writer.WriteIndex(material.metallicRoughnessMap);
+    writer.Write(material.metallicFactor);
+    writer.Write(material.roughnessFactor);
+    writer.WriteIndex(material.metallicRoughnessUVChannel);
+
+    writer.WriteIndex(material.normalMap);
+    writer.Write(material.normalScale);
+    writer.Write(material.normalUVChannel);
+
+    writer.WriteIndex(material.occlusionMap);
+    writer.Write(material.occlusionStrength);
+    writer.Write(material.occlusionUVChannel);
+
+    writer.WriteIndex(material.emissiveMap);
+    writer.Write(material.emissiveFactor);
+    writer.Write(material.emissiveUVChannel);
+}
+
+bool ReadMaterial(CookReader& reader, CPUMaterial& material)
+{
+    return reader.ReadIndex(material.albedoMap)
+        && reader.Read(material.albedoFactor)
+        && reader.Read(material.albedoUVChannel)
+        && reader.ReadIndex(material.metallicRoughnessMap)
+        && reader.Read(material.metallicFactor)
+        && reader.Read(material.roughnessFactor)
+        && reader.ReadIndex(material.metallicRoughnessUVChannel)
+        && reader.ReadIndex(material.normalMap)
+        && reader.Read(material.normalScale)
+        && reader.Read(material.normalUVChannel)
+        && reader.ReadIndex(material.occlusionMap)
+        && reader.Read(material.occlusionStrength)
+        && reader.Read(material.occlusionUVChannel)
+        && reader.ReadIndex(material.emissiveMap)
+        && reader.Read(material.emissiveFactor)
+        && reader.Read(material.emissiveUVChannel);
+}
+
+template <typename T>
+void WriteSpline(CookWriter& writer, const std::optional<AnimationSpline<T>>& spline)
+{
+    writer.Write(static_cast<uint8_t>(spline.has_value()));
+
+    if (spline.has_value())
+    {
+        writer.WriteArray(spline->timestamps);
+        writer.WriteArray(spline->values);
+    }
+}
+
+template <typename T>
+bool ReadSpline(CookReader& reader, std::optional<AnimationSpline<T>>& spline)
+{
+    uint8_t hasValue = 0;
+    if (!reader.Read(hasValue) || hasValue > 1)
+        return false;
+
+    if (!hasValue)
+    {
+        spline = std::nullopt;
+        return true;
+    }
+
+    spline = AnimationSpline<T> {};
+    return reader.ReadArray(spline->timestamps)
+        && reader.ReadArray(spline->values)
+        && spline->timestamps.size() == spline->values.size()
+        && !spline->timestamps.empty();
+}
+
+void WriteNode(CookWriter& writer, const Node& node)
+{
+    writer.WriteString(node.name);
+    writer.Write(node.transform);
+    writer.WriteArray(node.childrenIndices);
+
+    writer.Write(static_cast<uint8_t>(node.mesh.has_value()));
+    if (node.mesh.has_value())
+    {
+        writer.Write(node.mesh->type);
+        writer.Write(node.mesh->index);
+    }
+
+    writer.Write(static_cast<uint8_t>(node.light.has_value()));
+    if (node.light.has_value())
+    {
+        writer.Write(node.light->color);
+        writer.Write(static_cast<uint32_t>(node.light->type));
+        writer.Write(node.light->range);
+        writer.Write(node.light->intensity);
+    }
+
+    writer.Write(static_cast<uint8_t>(node.joint.has_value()));
+    if (node.joint.has_value())
+    {
+        writer.Write(node.joint->index);
+        writer.Write(node.joint->inverseBind);
+    }
+
+    writer.WriteIndex(node.physics.has_value() ? std::optional<uint32_t> { node.physics->colliderIndex } : std::nullopt);
+    writer.WriteIndex(node.skeletonNode);
+
+    // Sorted by animation, so the same model always cooks to the same bytes
+    std::vector<uint32_t> animations {};
+    for (const auto& [animation, spline] : node.animationSplines)
+        animations.emplace_back(animation);
+
+    std::sort(animations.begin(), animations.end());
+    writer.Write(static_cast<uint32_t>(animations.size()));
+
+    for (uint32_t animation : animations)
+    {
+        const TransformAnimationSpline& spline = node.animationSplines.at(animation);
+
+        writer.Write(animation);
+        WriteSpline(writer, spline.translation);
+        WriteSpline(writer, spline.rotation);
+        WriteSpline(writer, spline.scaling);
+    }
+}
+
+bool ReadNode(CookReader& reader, Node& node)
+{
+    if (!reader.ReadString(node.name) || !reader.Read(node.transform) || !reader.ReadArray(node.childrenIndices))
+        return false;
+
+    uint8_t hasMesh = 0;
+    if (!reader.Read(hasMesh) || hasMesh > 1)
+        return false;
+
+    if (hasMesh)
+    {
+        NodeMeshData mesh {};
+        if (!reader.Read(mesh.type) || !reader.Read(mesh.index) || mesh.type > MeshType::eSKINNED)
+            return false;
+
+        node.mesh = mesh;
+    }
+
+    uint8_t hasLight = 0;
+    if (!reader.Read(hasLight) || hasLight > 1)
+        return false;
+
+    if (hasLight)
+    {
+        NodeLightData light {};
+        uint32_t type = 0;
+
+        if (!reader.Read(light.color) || !reader.Read(type) || !reader.Read(light.range) || !reader.Read(light.intensity) || type > static_cast<uint32_t>(NodeLightType::Spot))
+            return false;
+
+        light.type = static_cast<NodeLightType>(type);
+        node.light = light;
+    }
+
+    uint8_t hasJoint = 0;
+    if (!reader.Read(hasJoint) || hasJoint > 1)
+        return false;
+
+    if (hasJoint)
+    {
+        NodeJointData joint {};
+        if (!reader.Read(joint.index) || !reader.Read(joint.inverseBind))
+            return false;
+
+        node.joint = joint;
+    }
+
+    std::optional<uint32_t> colliderIndex {};
+    if (!reader.ReadIndex(colliderIndex) || !reader.ReadIndex(node.skeletonNode))
+        return false;
+
+    if (colliderIndex.has_value())
+        node.physics = NodePhysicsData { colliderIndex.value() };
+
+    uint32_t splineCount = 0;
+    if (!reader.Read(splineCount))
+        return false;
+
+    for (uint32_t i = 0; i < splineCount; ++i)
+    {
+        uint32_t animation = 0;
+        TransformAnimationSpline spline {};
+
+        if (!reader.Read(animation) || !ReadSpline(reader, spline.translation) || !ReadSpline(reader, spline.rotation) || !ReadSpline(reader, spline.scaling))
+            return false;
+
+        node.animationSplines[animation] = std::move(spline);
+    }
+
+    return true;
+}
+
+void WriteAnimation(CookWriter& writer, const Animation& animation)
+{
+    writer.WriteString(animation.name);
+    writer.Write(animation.duration);
+    writer.Write(animation.time);
+    writer.Write(animation.speed);
+    writer.Write(static_cast<uint32_t>(animation.playbackOption));
+    writer.Write(static_cast<uint8_t>(animation.looping));
+}
+
+bool ReadAnimation(CookReader& reader, Animation& animation)
+{
+    uint32_t playbackOption = 0;
+    uint8_t looping = 0;
+
+    const bool complete = reader.ReadString(animation.name)
+        && reader.Read(animation.duration)
+        && reader.Read(animation.time)
+        && reader.Read(animation.speed)
+        && reader.Read(playbackOption)
+        && reader.Read(looping);
+
+    animation.playbackOption = static_cast<Animation::PlaybackOptions>(playbackOption);
+    animation.looping = looping != 0;
+
+    return complete && playbackOption <= static_cast<uint32_t>(Animation::PlaybackOptions::eStopped);
+}
+
+template <typename T>
+bool IsMeshValid(const CPUMesh<T>& mesh, size_t materialCount)
+{
+    if (materialCount > 0 && mesh.materialIndex >= materialCount)
+        return false;
+
+    auto isIndexValid = [&mesh](uint32_t index)
+    { return index < mesh.vertices.size(); };
+
+    return std::all_of(mesh.indices.begin(), mesh.indices.end(), isIndexValid)
+        && std::all_of(mesh.lods.begin(), mesh.lods.end(), [&isIndexValid](const MeshLOD& lod)
+            { return std::all_of(lod.indices.begin(), lod.indices.end(), isIndexValid); });
+}
+
+bool IsTextureIndexValid(const std::optional<uint32_t>& index, size_t textureCount)
+{
+    return !index.has_value() || index.value() < textureCount;
+}
+
+}
+
+std::optional<CookedModel::Key> CookedModel::MakeSourceKey(std::string_view source)
+{
+    const std::optional<fileIO::FileInfo> info = fileIO::GetFileInfo(std::string { source });
+
+    if (!info.has_value())
+        return std::nullopt;
+
+    Key key = hashing::FNV1aValue(info->size);
+    key = hashing::FNV1aValue(info->lastWriteTime, key);
+    return key;
+}
+
+std::string CookedModel::GetCookedPath(std::string_view source)
+{
+    const size_t directoryEnd = source.find_last_of('/');
+    const size_t extensionStart = source.find_last_of('.');
+
+    if (extensionStart == std::string_view::npos || (directoryEnd != std::string_view::npos && extensionStart < directoryEnd))
+        return std::string { source } + std::string { EXTENSION };
+
+    return std::string { source.substr(0, extensionStart) } + std::string { EXTENSION };
+}
+
+std::vector<std::byte> CookedModel::Serialize(const CPUModel& model, Key sourceKey)
+{
+    ZoneScoped;
+
+    CookedModelHeader header {};
+    header.sourceKey = sourceKey;
+
+    size_t dataSize = sizeof(header);
+
+    auto lodSize = [](const auto& mesh)
+    {
+        size_t size = 0;
+        for (const auto& lod : mesh.lods)
+            size += lod.indices.size() * sizeof(uint32_t) + ARRAY_ALIGNMENT;
+
+        return size;
+    };
+
+    for (const auto& mesh : model.meshes)
+        dataSize += mesh.vertices.size() * sizeof(Vertex) + mesh.indices.size() * sizeof(uint32_t) + ARRAY_ALIGNMENT * 2 + lodSize(mesh);
+
+    for (const auto& mesh : model.skinnedMeshes)
+        dataSize += mesh.vertices.size() * sizeof(SkinnedVertex) + mesh.indices.size() * sizeof(uint32_t) + ARRAY_ALIGNMENT * 2 + lodSize(mesh);
+
+    for (const auto& texture : model.textures)
+        dataSize += texture.initialData.size() + ARRAY_ALIGNMENT;
+
+    CookWriter writer {};
+    writer.Reserve(dataSize + model.hierarchy.nodes.size() * sizeof(Node));
+
+    writer.Write(header);
+    writer.WriteString(model.name);
+
+    // Bulk data first, the vertices and indices of all meshes end up close together at the start of the file
+    writer.Write(static_cast<uint32_t>(model.meshes.size()));
+    for (const auto& mesh : model.meshes)
+        WriteMesh(writer, mesh);
+
+    writer.Write(static_cast<uint32_t>(model.skinnedMeshes.size()));
+    for (const auto& mesh : model.skinnedMeshes)
+        WriteMesh(writer, mesh);
+
+    writer.Write(static_cast<uint32_t>(model.textures.size()));
+    for (const auto& texture : model.textures)
+        WriteImage(writer, texture);
+
+    writer.Write(static_cast<uint32_t>(model.materials.size()));
+    for (const auto& material : model.materials)
+        WriteMaterial(writer, material);
+
+    writer.Write(static_cast<uint32_t>(model.animations.size()));
+    for (const auto& animation : model.animations)
+        WriteAnimation(writer, animation);
+
+    writer.Write(model.hierarchy.root);
+    writer.WriteIndex(model.hierarchy.skeletonRoot);
+    writer.Write(static_cast<uint32_t>(model.hierarchy.nodes.size()));
+    for (const auto& node : model.hierarchy.nodes)
+        WriteNode(writer, node);
+
+    return writer.TakeBytes();
+}
+
+std::optional<CPUModel> CookedModel::Deserialize(std::span<const std::byte> bytes, std::optional<Key> sourceKey)
+{
+    ZoneScoped;
+
+    CookReader reader { bytes };
+    CookedModelHeader header {};
+
+    if (!reader.Read(header) || header.magic != COOKED_MODEL_MAGIC || header.version != COOK_VERSION)
+        return std::nullopt;
+
+    if (header.vertexSize != sizeof(Vertex) || header.skinnedVertexSize != sizeof(SkinnedVertex))
+        return std::nullopt;
+
+    if (sourceKey.has_value() && header.sourceKey != sourceKey.value())
+        return std::nullopt;
+
+    CPUModel model {};
+
+    const bool complete = reader.ReadString(model.name)
+        && ReadElements(reader, model.meshes, bytes.size(), [&bytes](CookReader& meshReader, CPUMesh<Vertex>& mesh)
+            { return ReadMesh(meshReader, mesh, bytes.size()); })
+        && ReadElements(reader, model.skinnedMeshes, bytes.size(), [&bytes](CookReader& meshReader, CPUMesh<SkinnedVertex>& mesh)
+            { return ReadMesh(meshReader, mesh, bytes.size()); })
+        && ReadElements(reader, model.textures, bytes.size(), ReadImage)
+        && ReadElements(reader, model.materials, bytes.size(), ReadMaterial)
+        && ReadElements(reader, model.animations, bytes.size(), ReadAnimation)
+        && reader.Read(model.hierarchy.root)
+        && reader.ReadIndex(model.hierarchy.skeletonRoot)
+        && ReadElements(reader, model.hierarchy.nodes, bytes.size(), ReadNode)
+        && reader.IsAtEnd();
+
+    if (!complete || !IsValid(model))
+        return std::nullopt;
+
+    return model;
+}
+
+bool CookedModel::Save(const CPUModel& model, const std::filesystem::path& path, Key sourceKey)
+{
+    ZoneScoped;
+
+    return fileIO::WriteFileAtomically(path, Serialize(model, sourceKey));
+}
+
+std::optional<CPUModel> CookedModel::Load(std::string_view path, std::optional<Key> sourceKey)
+{
+    ZoneScoped;
+
+    const std::optional<std::vector<std::byte>> bytes = fileIO::ReadFileBytes(std::string { path });
+
+    if (!bytes.has_value())
+        return std::nullopt;
+
+    std::optional<CPUModel> model = Deserialize(bytes.value(), sourceKey);
+
+    if (!model.has_value())
+        bblog::warn("[RESOURCES] Discarding outdated or corrupt cooked model {}, run the ModelCooker again", path);
+
+    return model;
+}
+
+bool CookedModel::IsValid(const CPUModel& model)
+{
+    const Hierarchy& hierarchy = model.hierarchy;
+    const size_t nodeCount = hierarchy.nodes.size();
+
+    if (hierarchy.root >= nodeCount || (hierarchy.skeletonRoot.has_value() && hierarchy.skeletonRoot.value() >= nodeCount))
+        return false;
+
+    for (const auto& mesh : model.meshes)
+    {
+        if (!IsMeshValid(mesh, model.materials.size()))
+            return false;
+    }
+
+    for (const auto& mesh : model.skinnedMeshes)
+    {
+        if (!IsMeshValid(mesh, model.materials.size()))
+            return false;
+    }
+
+    const size_t textureCount = model.textures.size();
+
+    for (const auto& material : model.materials)
+    {
+        if (!IsTextureIndexValid(material.albedoMap, textureCount) || !IsTextureIndexValid(material.metallicRoughnessMap, textureCount)
+            || !IsTextureIndexValid(material.normalMap, textureCount) || !IsTextureIndexValid(material.occlusionMap, textureCount)
+            || !IsTextureIndexValid(material.emissiveMap, textureCount))
+            return false;
+    }
+
+    for (const auto& node : hierarchy.nodes)
+    {
+        for (uint32_t child : node.childrenIndices)
+        {
+            if (child >= nodeCount)
+                return false;
+        }
+
+        if (node.mesh.has_value())
+        {
+            const size_t meshCount = node.mesh->type == MeshType::eSTATIC ? model.meshes.size() : model.skinnedMeshes.size();
+
+            if (node.mesh->index >= meshCount)
+                return false;
+        }
+
+        if (node.skeletonNode.has_value() && node.skeletonNode.value() >= nodeCount)
+            return false;
+
+        for (const auto& [animation, spline] : node.animationSplines)
+        {
+            if (animation >= model.animations.size())
+                return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,229 @@
+#include "derived_data_cache.hpp"
+
+#include "file_io.hpp"
+#include "hash_util.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+constexpr uint32_t DERIVED_DATA_MAGIC = 0x43444242; // "BBDC"
+constexpr uint32_t DERIVED_DATA_FORMAT_VERSION = 1;
+constexpr std::string_view DERIVED_DATA_EXTENSION = ".ddc";
+
+struct DerivedDataFileHeader
+{
+    uint32_t magic = DERIVED_DATA_MAGIC;
+    uint32_t formatVersion = DERIVED_DATA_FORMAT_VERSION;
+    uint32_t processorVersion = 0;
+    uint32_t padding = 0;
+    DerivedDataCache::Hash key = 0;
+    DerivedDataCache::Hash source = 0;
+    DerivedDataCache::Hash parameters = 0;
+    uint64_t dataSize = 0;
+    DerivedDataCache::Hash dataHash = 0;
+};
+
+struct CachedBlob
+{
+    std::filesystem::path path;
+    uint64_t size;
+    std::filesystem::file_time_type lastUsed;
+};
+
+}
+
+DerivedDataCache::DerivedDataCache(const std::filesystem::path& directory, uint64_t maxSize)
+    : _directory(directory)
+    , _maxSize(maxSize)
+{
+}
+
+std::optional<DerivedDataCache::Hash> DerivedDataCache::HashSourceFile(std::string_view path)
+{
+    ZoneScoped;
+
+    const std::optional<std::vector<std::byte>> bytes = fileIO::ReadFileBytes(std::string { path });
+
+    if (!bytes.has_value())
+        return std::nullopt;
+
+    return hashing::FNV1a(bytes->data(), bytes->size());
+}
+
+std::optional<std::vector<std::byte>> DerivedDataCache::Load(const Key& key)
+{
+    ZoneScoped;
+
+    const std::filesystem::path path = GetFilePath(key);
+    std::ifstream file { path, std::ios::in | std::ios::binary };
+
+    if (!file)
+    {
+        std::scoped_lock lock { _mutex };
+        _stats.misses++;
+        return std::nullopt;
+    }
+
+    std::error_code error {};
+    const uint64_t fileSize = std::filesystem::file_size(path, error);
+
+    DerivedDataFileHeader header {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    // The key is checked in full, so a hash collision on the file name is treated like a miss instead of returning the wrong blob
+    const bool isCurrent = file && !error && header.magic == DERIVED_DATA_MAGIC && header.formatVersion == DERIVED_DATA_FORMAT_VERSION
+        && header.processorVersion == key.version && header.key == HashKey(key) && header.source == key.source && header.parameters == key.parameters;
+
+    std::vector<std::byte> data {};
+    bool isValid = isCurrent && header.dataSize == fileSize - sizeof(header);
+
+    if (isValid)
+    {
+        data.resize(header.dataSize);
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        isValid = file && hashing::FNV1a(data.data(), data.size()) == header.dataHash;
+    }
+
+    file.close();
+
+    if (!isValid)
+    {
+        bblog::warn("[RESOURCES] Discarding corrupt derived data {}", path.generic_string());
+        std::filesystem::remove(path, error);
+
+        std::scoped_lock lock { _mutex };
+        _stats.corrupt++;
+        _stats.misses++;
+
+        if (_size.has_value() && !error)
+            _size = _size.value() - std::min(_size.value(), fileSize);
+
+        return std::nullopt;
+    }
+
+    // Eviction goes by the write time, touching the file keeps blobs that are still in use around
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+
+    std::scoped_lock lock { _mutex };
+    _stats.hits++;
+
+    return data;
+}
+
+bool DerivedDataCache::Store(const Key& key, std::span<const std::byte> data)
+{
+    ZoneScoped;
+
+    const std::filesystem::path path = GetFilePath(key);
+
+    DerivedDataFileHeader header {};
+    header.processorVersion = key.version;
+    header.key = HashKey(key);
+    header.source = key.source;
+    header.parameters = key.parameters;
+    header.dataSize = data.size();
+    header.dataHash = hashing::FNV1a(data.data(), data.size());
+
+    std::vector<std::byte> blob(sizeof(header) + data.size());
+    std::memcpy(blob.data(), &header, sizeof(header));
+    std::memcpy(blob.data() + sizeof(header), data.data(), data.size());
+
+    std::error_code error {};
+    const uint64_t replacedSize = std::filesystem::exists(path, error) ? std::filesystem::file_size(path, error) : 0;
+
+    // Goes through a temporary file, so a crash or another writer never leaves a half written blob behind
+    if (!fileIO::WriteFileAtomically(path, blob))
+        return false;
+
+    std::scoped_lock lock { _mutex };
+    _stats.writes++;
+
+    if (_size.has_value())
+        _size = _size.value() + blob.size() - std::min(_size.value(), replacedSize);
+
+    if (!_size.has_value() || _size.value() > _maxSize)
+        Evict(path);
+
+    return true;
+}
+
+std::filesystem::path DerivedDataCache::GetFilePath(const Key& key) const
+{
+    return _directory / key.processor / fmt::format("{:016x}{}", HashKey(key), DERIVED_DATA_EXTENSION);
+}
+
+DerivedDataCache::Stats DerivedDataCache::GetStats() const
+{
+    std::scoped_lock lock { _mutex };
+    return _stats;
+}
+
+void DerivedDataCache::ResetStats()
+{
+    std::scoped_lock lock { _mutex };
+    _stats = {};
+}
+
+DerivedDataCache::Hash DerivedDataCache::HashKey(const Key& key)
+{
+    Hash hash = hashing::FNV1a(key.processor.data(), key.processor.size());
+    hash = hashing::FNV1aValue(key.version, hash);
+    hash = hashing::FNV1aValue(key.source, hash);
+    hash = hashing::FNV1aValue(key.parameters, hash);
+    return hash;
+}
+
+void DerivedDataCache::Evict(const std::filesystem::path& keep)
+{
+    ZoneScoped;
+
+    std::vector<CachedBlob> blobs {};
+    uint64_t totalSize = 0;
+    std::error_code error {};
+
+    for (auto it = std::filesystem::recursive_directory_iterator(_directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+    {
+        if (!it->is_regular_file(error) || it->path().extension() != DERIVED_DATA_EXTENSION)
+            continue;
+
+        CachedBlob blob { it->path(), it->file_size(error), it->last_write_time(error) };
+
+        // Another process might have evicted the blob while iterating
+        if (error)
+        {
+            error.clear();
+            continue;
+        }
+
+        totalSize += blob.size;
+        blobs.emplace_back(std::move(blob));
+    }
+
+    std::sort(blobs.begin(), blobs.end(), [](const CachedBlob& lhs, const CachedBlob& rhs)
+        { return lhs.lastUsed < rhs.lastUsed; });
+
+    for (const CachedBlob& blob : blobs)
+    {
+        if (totalSize <= _maxSize)
+            break;
+
+        if (blob.path == keep)
+            continue;
+
+        if (std::filesystem::remove(blob.path, error))
+        {
+            totalSize -= blob.size;
+            _stats.evictions++;
+        }
+    }
+
+    _size = totalSize;
+}
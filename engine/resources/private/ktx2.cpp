@@ -0,0 +1,255 @@
+#include "ktx2.hpp"
+
+#include "texture_compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace
+{
+
+constexpr std::array<uint8_t, 12> IDENTIFIER = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+struct Header
+{
+    uint32_t vkFormat = 0;
+    uint32_t typeSize = 1;
+    uint32_t pixelWidth = 0;
+    uint32_t pixelHeight = 0;
+    uint32_t pixelDepth = 0;
+    uint32_t layerCount = 0;
+    uint32_t faceCount = 1;
+    uint32_t levelCount = 0;
+    uint32_t supercompressionScheme = 0;
+
+    uint32_t dfdByteOffset = 0;
+    uint32_t dfdByteLength = 0;
+    uint32_t kvdByteOffset = 0;
+    uint32_t kvdByteLength = 0;
+};
+
+// Supercompression global data is never used, its offset and length follow the header as two 64 bit zeroes
+constexpr size_t SUPERCOMPRESSION_INDEX_SIZE = 2 * sizeof(uint64_t);
+
+struct LevelIndex
+{
+    uint64_t byteOffset = 0;
+    uint64_t byteLength = 0;
+    uint64_t uncompressedByteLength = 0;
+};
+
+static_assert(sizeof(Header) == 52 && sizeof(LevelIndex) == 24, "Matches the layout of the file, so it can be copied straight in and out");
+
+constexpr size_t LEVEL_INDEX_OFFSET = IDENTIFIER.size() + sizeof(Header) + SUPERCOMPRESSION_INDEX_SIZE;
+
+// Color models of the data format descriptor
+constexpr uint8_t MODEL_RGBSDA = 1;
+constexpr uint8_t MODEL_BC4 = 131;
+constexpr uint8_t MODEL_BC5 = 132;
+constexpr uint8_t MODEL_BC7 = 134;
+
+constexpr uint8_t PRIMARIES_BT709 = 1;
+constexpr uint8_t TRANSFER_LINEAR = 1;
+constexpr uint8_t CHANNEL_ALPHA = 15;
+
+bool IsSupportedFormat(vk::Format format)
+{
+    return format == vk::Format::eR8G8B8A8Unorm || format == vk::Format::eBc4UnormBlock
+        || format == vk::Format::eBc5UnormBlock || format == vk::Format::eBc7UnormBlock;
+}
+
+void Append(std::vector<std::byte>& bytes, const void* data, size_t size)
+{
+    const auto* begin = static_cast<const std::byte*>(data);
+    bytes.insert(bytes.end(), begin, begin + size);
+}
+
+template <typename T>
+void Append(std::vector<std::byte>& bytes, const T& value)
+{
+    Append(bytes, &value, sizeof(T));
+}
+
+// Basic data format descriptor, describes how the channels are laid out in a texel block
+std::vector<std::byte> MakeDataFormatDescriptor(vk::Format format)
+{
+    struct Sample
+    {
+        uint16_t bitOffset;
+        uint8_t bitLength;
+        uint8_t channelType;
+    };
+
+    uint8_t model = MODEL_RGBSDA;
+    std::vector<Sample> samples {};
+
+    switch (format)
+    {
+    case vk::Format::eBc4UnormBlock:
+        model = MODEL_BC4;
+        samples = { { 0, 63, 0 } };
+        break;
+    case vk::Format::eBc5UnormBlock:
+        model = MODEL_BC5;
+        samples = { { 0, 63, 0 }, { 64, 63, 1 } };
+        break;
+    case vk::Format::eBc7UnormBlock:
+        model = MODEL_BC7;
+        samples = { { 0, 127, 0 } };
+        break;
+    default:
+        samples = { { 0, 7, 0 }, { 8, 7, 1 }, { 16, 7, 2 }, { 24, 7, CHANNEL_ALPHA } };
+        break;
+    }
+
+    const uint32_t blockDimension = TextureCompression::GetBlockDimension(format) - 1;
+    const auto blockSize = static_cast<uint32_t>(24 + samples.size() * 16);
+
+    std::vector<std::byte> descriptor {};
+    Append(descriptor, blockSize + static_cast<uint32_t>(sizeof(uint32_t)));
+    Append(descriptor, uint32_t { 0 }); // Khronos vendor, basic descriptor type
+    Append(descriptor, 2u | (blockSize << 16)); // Version 2
+    Append(descriptor, std::array<uint8_t, 4> { model, PRIMARIES_BT709, TRANSFER_LINEAR, 0 });
+    Append(descriptor, std::array<uint8_t, 4> { static_cast<uint8_t>(blockDimension), static_cast<uint8_t>(blockDimension), 0, 0 });
+
+    std::array<uint8_t, 8> bytesPlane {};
+    bytesPlane[0] = static_cast<uint8_t>(TextureCompression::GetBlockByteSize(format));
+    Append(descriptor, bytesPlane);
+
+    for (const Sample& sample : samples)
+    {
+        const uint32_t upper = model == MODEL_RGBSDA ? 255 : UINT32_MAX;
+
+        Append(descriptor, sample.bitOffset);
+        Append(descriptor, sample.bitLength);
+        Append(descriptor, sample.channelType);
+        Append(descriptor, uint32_t { 0 }); // Sample position
+        Append(descriptor, uint32_t { 0 });
+        Append(descriptor, upper);
+    }
+
+    return descriptor;
+}
+
+}
+
+std::optional<std::vector<std::byte>> KTX2::Serialize(const CPUImage& image)
+{
+    if (!IsSupportedFormat(image.format) || image.type != ImageType::e2D || image.depth != 1 || image.layers != 1 || image.isHDR)
+        return std::nullopt;
+
+    // An image without its mips only stores the first level, the level count of zero tells the reader to generate the rest
+    uint32_t storedLevels = image.mips;
+    uint32_t levelCount = image.mips;
+
+    if (!image.HasMipChain())
+    {
+        if (image.initialData.size() != TextureCompression::GetMipSize(image.format, image.width, image.height, 0))
+            return std::nullopt;
+
+        storedLevels = 1;
+        levelCount = 0;
+    }
+
+    const std::vector<std::byte> descriptor = MakeDataFormatDescriptor(image.format);
+
+    Header header {};
+    header.vkFormat = static_cast<uint32_t>(image.format);
+    header.pixelWidth = image.width;
+    header.pixelHeight = image.height;
+    header.levelCount = levelCount;
+    header.dfdByteOffset = static_cast<uint32_t>(LEVEL_INDEX_OFFSET + storedLevels * sizeof(LevelIndex));
+    header.dfdByteLength = static_cast<uint32_t>(descriptor.size());
+
+    // Level data is stored from the smallest mip to the largest, each level aligned to the size of a block
+    const size_t alignment = TextureCompression::GetBlockByteSize(image.format);
+
+    std::vector<LevelIndex> levels(storedLevels);
+    size_t offset = header.dfdByteOffset + header.dfdByteLength;
+
+    for (uint32_t level = storedLevels; level-- > 0;)
+    {
+        offset = (offset + alignment - 1) / alignment * alignment;
+
+        levels[level].byteOffset = offset;
+        levels[level].byteLength = TextureCompression::GetMipSize(image.format, image.width, image.height, level);
+        levels[level].uncompressedByteLength = levels[level].byteLength;
+
+        offset += levels[level].byteLength;
+    }
+
+    std::vector<std::byte> bytes {};
+    bytes.reserve(offset);
+
+    Append(bytes, IDENTIFIER);
+    Append(bytes, header);
+    Append(bytes, std::array<uint64_t, 2> {});
+    Append(bytes, levels.data(), levels.size() * sizeof(LevelIndex));
+    Append(bytes, descriptor.data(), descriptor.size());
+
+    bytes.resize(offset);
+
+    size_t sourceOffset = 0;
+    for (const LevelIndex& level : levels)
+    {
+        std::memcpy(bytes.data() + level.byteOffset, image.initialData.data() + sourceOffset, level.byteLength);
+        sourceOffset += level.byteLength;
+    }
+
+    return bytes;
+}
+
+std::optional<CPUImage> KTX2::Deserialize(std::span<const std::byte> bytes)
+{
+    if (bytes.size() < LEVEL_INDEX_OFFSET || std::memcmp(bytes.data(), IDENTIFIER.data(), IDENTIFIER.size()) != 0)
+        return std::nullopt;
+
+    Header header {};
+    std::memcpy(&header, bytes.data() + IDENTIFIER.size(), sizeof(Header));
+
+    const auto format = static_cast<vk::Format>(header.vkFormat);
+
+    if (!IsSupportedFormat(format) || header.typeSize != 1 || header.supercompressionScheme != 0
+        || header.pixelWidth == 0 || header.pixelWidth > UINT16_MAX || header.pixelHeight == 0 || header.pixelHeight > UINT16_MAX
+        || header.pixelDepth != 0 || header.layerCount != 0 || header.faceCount != 1)
+        return std::nullopt;
+
+    const uint32_t fullMipCount = TextureCompression::GetFullMipCount(header.pixelWidth, header.pixelHeight);
+    const uint32_t storedLevels = std::max(header.levelCount, 1u);
+
+    if (header.levelCount > fullMipCount || (bytes.size() - LEVEL_INDEX_OFFSET) / sizeof(LevelIndex) < storedLevels)
+        return std::nullopt;
+
+    std::vector<LevelIndex> levels(storedLevels);
+    std::memcpy(levels.data(), bytes.data() + LEVEL_INDEX_OFFSET, levels.size() * sizeof(LevelIndex));
+
+    size_t dataSize = 0;
+    for (uint32_t level = 0; level < storedLevels; ++level)
+    {
+        const LevelIndex& index = levels[level];
+        const size_t expectedSize = TextureCompression::GetMipSize(format, header.pixelWidth, header.pixelHeight, level);
+
+        if (index.byteLength != expectedSize || index.uncompressedByteLength != expectedSize
+            || index.byteOffset > bytes.size() || bytes.size() - index.byteOffset < index.byteLength)
+            return std::nullopt;
+
+        dataSize += expectedSize;
+    }
+
+    CPUImage image {};
+    image
+        .SetFormat(format)
+        .SetSize(static_cast<uint16_t>(header.pixelWidth), static_cast<uint16_t>(header.pixelHeight))
+        .SetMips(static_cast<uint8_t>(header.levelCount == 0 ? fullMipCount : header.levelCount))
+        .SetFlags(vk::ImageUsageFlagBits::eSampled);
+
+    image.initialData.reserve(dataSize);
+    for (const LevelIndex& level : levels)
+    {
+        const auto* begin = bytes.data() + level.byteOffset;
+        image.initialData.insert(image.initialData.end(), begin, begin + level.byteLength);
+    }
+
+    return image;
+}
@@ -0,0 +1,302 @@
+#include "mesh_optimization.hpp"
+
+#include "hash_util.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+// Scoring from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation", the cache here is only used to score vertices
+// and is larger than the hardware one, so vertices that just fell out still count a little
+constexpr uint32_t SCORING_CACHE_SIZE = 32;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+constexpr int32_t NOT_IN_CACHE = -1;
+
+float ScoreVertex(int32_t cachePosition, uint32_t remainingTriangles)
+{
+    if (remainingTriangles == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+
+    if (cachePosition != NOT_IN_CACHE)
+    {
+        // The vertices of the last triangle get a fixed score, so the next triangle doesn't prefer one of them over the others
+        if (cachePosition < 3)
+        {
+            score = LAST_TRIANGLE_SCORE;
+        }
+        else
+        {
+            const float scale = 1.0f / (SCORING_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scale, CACHE_DECAY_POWER);
+        }
+    }
+
+    // Vertices with few triangles left are finished first, so they don't end up as lone triangles at the end
+    score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+    return score;
+}
+
+template <typename T>
+struct VertexBytesHash
+{
+    const std::vector<T>* vertices;
+
+    size_t operator()(uint32_t index) const
+    {
+        return static_cast<size_t>(hashing::FNV1aValue((*vertices)[index]));
+    }
+};
+
+template <typename T>
+struct VertexBytesEqual
+{
+    const std::vector<T>* vertices;
+
+    bool operator()(uint32_t lhs, uint32_t rhs) const
+    {
+        return std::memcmp(&(*vertices)[lhs], &(*vertices)[rhs], sizeof(T)) == 0;
+    }
+};
+
+}
+
+MeshOptimization::VertexCacheStatistics MeshOptimization::AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize)
+{
+    VertexCacheStatistics statistics {};
+
+    // A vertex is still in the FIFO when fewer than cacheSize vertices were transformed after it
+    std::vector<uint32_t> transformedAt(vertexCount, 0);
+
+    for (uint32_t index : indices)
+    {
+        if (transformedAt[index] == 0 || statistics.transformedVertices + 1 - transformedAt[index] > cacheSize)
+        {
+            ++statistics.transformedVertices;
+            transformedAt[index] = statistics.transformedVertices;
+        }
+    }
+
+    const size_t triangleCount = indices.size() / 3;
+    statistics.acmr = triangleCount > 0 ? static_cast<float>(statistics.transformedVertices) / triangleCount : 0.0f;
+    statistics.atvr = vertexCount > 0 ? static_cast<float>(statistics.transformedVertices) / vertexCount : 0.0f;
+
+    return statistics;
+}
+
+template <typename T>
+void MeshOptimization::DeduplicateVertices(CPUMesh<T>& mesh)
+{
+    ZoneScoped;
+
+    static_assert(std::is_trivially_copyable_v<T>, "Vertices are compared by their bytes");
+
+    std::unordered_map<uint32_t, uint32_t, VertexBytesHash<T>, VertexBytesEqual<T>> firstVertex {
+        mesh.vertices.size(), VertexBytesHash<T> { &mesh.vertices }, VertexBytesEqual<T> { &mesh.vertices }
+    };
+
+    std::vector<uint32_t> remap(mesh.vertices.size());
+    std::vector<T> vertices {};
+    vertices.reserve(mesh.vertices.size());
+
+    for (uint32_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+        const auto [it, inserted] = firstVertex.try_emplace(i, static_cast<uint32_t>(vertices.size()));
+        if (inserted)
+            vertices.emplace_back(mesh.vertices[i]);
+
+        remap[i] = it->second;
+    }
+
+    if (vertices.size() == mesh.vertices.size())
+        return;
+
+    for (uint32_t& index : mesh.indices)
+        index = remap[index];
+
+    mesh.vertices = std::move(vertices);
+}
+
+void MeshOptimization::OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount)
+{
+    ZoneScoped;
+
+    const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triangleCount == 0)
+        return;
+
+    // Triangles of every vertex, stored after each other with an offset per vertex
+    std::vector<uint32_t> remainingTriangles(vertexCount, 0);
+    for (uint32_t index : indices)
+        ++remainingTriangles[index];
+
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + remainingTriangles[vertex];
+
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> filled(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+        {
+            for (uint32_t corner = 0; corner < 3; ++corner)
+                adjacency[filled[indices[triangle * 3 + corner]]++] = triangle;
+        }
+    }
+
+    std::vector<float> vertexScores(vertexCount);
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        vertexScores[vertex] = ScoreVertex(NOT_IN_CACHE, remainingTriangles[vertex]);
+
+    std::vector<float> triangleScores(triangleCount);
+    for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        triangleScores[triangle] = vertexScores[indices[triangle * 3]]
+            + vertexScores[indices[triangle * 3 + 1]]
+            + vertexScores[indices[triangle * 3 + 2]];
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> output {};
+    output.reserve(indices.size());
+
+    // The cache holds the extra three vertices of a new triangle before the oldest ones are pushed out
+    std::vector<uint32_t> cache {};
+    std::vector<uint32_t> nextCache {};
+    cache.reserve(SCORING_CACHE_SIZE + 3);
+    nextCache.reserve(SCORING_CACHE_SIZE + 3);
+
+    uint32_t searchStart = 0;
+
+    auto findBestTriangle = [&]() -> uint32_t
+    {
+        uint32_t best = triangleCount;
+        float bestScore = -1.0f;
+
+        // Only triangles touching the cache change score, so those are the only ones that need looking at
+        for (uint32_t vertex : cache)
+        {
+            for (uint32_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex] + remainingTriangles[vertex]; ++i)
+            {
+                const uint32_t triangle = adjacency[i];
+                if (triangleScores[triangle] > bestScore)
+                {
+                    bestScore = triangleScores[triangle];
+                    best = triangle;
+                }
+            }
+        }
+
+        if (best != triangleCount)
+            return best;
+
+        // Nothing left around the cache, continue with the first triangle that is not emitted yet
+        while (searchStart < triangleCount && emitted[searchStart])
+            ++searchStart;
+
+        return searchStart;
+    };
+
+    auto updateScore = [&](uint32_t vertex, int32_t cachePosition)
+    {
+        const float score = ScoreVertex(cachePosition, remainingTriangles[vertex]);
+        const float difference = score - vertexScores[vertex];
+        vertexScores[vertex] = score;
+
+        for (uint32_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex] + remainingTriangles[vertex]; ++i)
+            triangleScores[adjacency[i]] += difference;
+    };
+
+    for (uint32_t triangle = findBestTriangle(); triangle < triangleCount; triangle = findBestTriangle())
+    {
+        emitted[triangle] = true;
+
+        nextCache.clear();
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+            const uint32_t vertex = indices[triangle * 3 + corner];
+            output.emplace_back(vertex);
+
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+                nextCache.emplace_back(vertex);
+
+            // Remove the triangle from the ones the vertex still has to emit
+            const uint32_t begin = adjacencyOffsets[vertex];
+            const uint32_t end = begin + remainingTriangles[vertex];
+            std::iter_swap(std::find(adjacency.begin() + begin, adjacency.begin() + end, triangle), adjacency.begin() + end - 1);
+            --remainingTriangles[vertex];
+        }
+
+        for (uint32_t vertex : cache)
+        {
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+                nextCache.emplace_back(vertex);
+        }
+
+        for (size_t i = SCORING_CACHE_SIZE; i < nextCache.size(); ++i)
+            updateScore(nextCache[i], NOT_IN_CACHE);
+
+        nextCache.resize(std::min<size_t>(nextCache.size(), SCORING_CACHE_SIZE));
+        std::swap(cache, nextCache);
+
+        for (uint32_t position = 0; position < cache.size(); ++position)
+            updateScore(cache[position], static_cast<int32_t>(position));
+    }
+
+    indices = std::move(output);
+}
+
+template <typename T>
+void MeshOptimization::OptimizeVertexFetch(CPUMesh<T>& mesh)
+{
+    ZoneScoped;
+
+    constexpr uint32_t UNUSED = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> remap(mesh.vertices.size(), UNUSED);
+    std::vector<T> vertices {};
+    vertices.reserve(mesh.vertices.size());
+
+    for (uint32_t& index : mesh.indices)
+    {
+        if (remap[index] == UNUSED)
+        {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.emplace_back(mesh.vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    mesh.vertices = std::move(vertices);
+}
+
+template <typename T>
+void MeshOptimization::Optimize(CPUMesh<T>& mesh)
+{
+    ZoneScoped;
+
+    DeduplicateVertices(mesh);
+    OptimizeVertexCache(mesh.indices, static_cast<uint32_t>(mesh.vertices.size()));
+    OptimizeVertexFetch(mesh);
+}
+
+template void MeshOptimization::DeduplicateVertices(CPUMesh<Vertex>& mesh);
+template void MeshOptimization::DeduplicateVertices(CPUMesh<SkinnedVertex>& mesh);
+template void MeshOptimization::OptimizeVertexFetch(CPUMesh<Vertex>& mesh);
+template void MeshOptimization::OptimizeVertexFetch(CPUMesh<SkinnedVertex>& mesh);
+template void MeshOptimization::Optimize(CPUMesh<Vertex>& mesh);
+template void MeshOptimization::Optimize(CPUMesh<SkinnedVertex>& mesh);
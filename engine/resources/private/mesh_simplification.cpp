@@ -0,0 +1,481 @@
+#include "mesh_simplification.hpp"
+
+#include "hash_util.hpp"
+#include "mesh_optimization.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <glm/geometric.hpp>
+#include <limits>
+#include <unordered_map>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+// A level has to remove at least this fraction of the triangles of the level before it to be kept
+constexpr float MIN_LOD_REDUCTION = 0.2f;
+// Cosine of the largest angle the normal of a triangle may turn in a single collapse
+constexpr float MIN_NORMAL_COSINE = 0.25f;
+
+// Sum of squared distances to a set of planes, as the upper triangle of a symmetric 4x4 matrix.
+// Kept in doubles, the terms of many planes cancel out and floats lose the small distances.
+struct Quadric
+{
+    double xx = 0.0, xy = 0.0, xz = 0.0, xw = 0.0;
+    double yy = 0.0, yz = 0.0, yw = 0.0;
+    double zz = 0.0, zw = 0.0;
+    double ww = 0.0;
+
+    static Quadric FromPlane(glm::dvec3 normal, double distance)
+    {
+        return Quadric {
+            normal.x * normal.x, normal.x * normal.y, normal.x * normal.z, normal.x * distance,
+            normal.y * normal.y, normal.y * normal.z, normal.y * distance,
+            normal.z * normal.z, normal.z * distance,
+            distance * distance
+        };
+    }
+
+    Quadric& operator+=(const Quadric& other)
+    {
+        xx += other.xx, xy += other.xy, xz += other.xz, xw += other.xw;
+        yy += other.yy, yz += other.yz, yw += other.yw;
+        zz += other.zz, zw += other.zw;
+        ww += other.ww;
+        return *this;
+    }
+
+    double Evaluate(glm::vec3 point) const
+    {
+        const double x = point.x, y = point.y, z = point.z;
+
+        const double error = xx * x * x + 2.0 * xy * x * y + 2.0 * xz * x * z + 2.0 * xw * x
+            + yy * y * y + 2.0 * yz * y * z + 2.0 * yw * y
+            + zz * z * z + 2.0 * zw * z
+            + ww;
+
+        // Rounding can take a sum of squares slightly below zero
+        return std::max(error, 0.0);
+    }
+};
+
+struct Collapse
+{
+    double cost;
+    uint32_t from;
+    uint32_t to;
+};
+
+// Positions are compared by their bits, vertices that only differ in their other attributes end up on the same point
+struct PositionKey
+{
+    std::array<uint32_t, 3> bits;
+
+    bool operator==(const PositionKey& other) const = default;
+};
+
+struct PositionKeyHash
+{
+    size_t operator()(const PositionKey& key) const { return static_cast<size_t>(hashing::FNV1aValue(key)); }
+};
+
+uint64_t EdgeKey(uint32_t a, uint32_t b)
+{
+    return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+}
+
+class Simplifier
+{
+public:
+    Simplifier(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices)
+        : _positions(positions)
+        , _pointOfVertex(positions.size())
+    {
+        FindPoints();
+
+        _indices.reserve(indices.size());
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            if (!IsDegenerate(indices[i], indices[i + 1], indices[i + 2]))
+                _indices.insert(_indices.end(), { indices[i], indices[i + 1], indices[i + 2] });
+        }
+
+        LockBorders();
+        ComputeQuadrics();
+    }
+
+    MeshSimplification::Result Run(size_t targetIndexCount, float targetError)
+    {
+        const double targetCost = static_cast<double>(targetError) * static_cast<double>(targetError);
+        double largestCost = 0.0;
+
+        std::vector<uint32_t> vertexRemap(_positions.size());
+        for (uint32_t i = 0; i < vertexRemap.size(); ++i)
+            vertexRemap[i] = i;
+
+        // Every pass collapses the cheapest edges that don't touch each other, then the index buffer is rebuilt for the next pass
+        while (_indices.size() > targetIndexCount)
+        {
+            BuildFans();
+            const std::vector<Collapse> collapses = FindCollapses();
+
+            std::vector<bool> touched(_points.size(), false);
+            size_t remainingIndices = _indices.size();
+            bool collapsed = false;
+
+            for (const Collapse& collapse : collapses)
+            {
+                if (remainingIndices <= targetIndexCount || collapse.cost > targetCost)
+                    break;
+
+                if (touched[collapse.from] || touched[collapse.to])
+                    continue;
+
+                uint32_t fromVertex = 0;
+                uint32_t toVertex = 0;
+                uint32_t removedTriangles = 0;
+
+                if (!CanCollapse(collapse.from, collapse.to, fromVertex, toVertex, removedTriangles))
+                    continue;
+
+                vertexRemap[fromVertex] = toVertex;
+                _quadrics[collapse.to] += _quadrics[collapse.from];
+
+                // The triangles around the collapsed point changed, so nothing else may be collapsed onto or from their corners this pass
+                for (uint32_t fan = _fanOffsets[collapse.from]; fan < _fanOffsets[collapse.from + 1]; ++fan)
+                {
+                    const uint32_t triangle = _fanTriangles[fan];
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                        touched[_pointOfVertex[_indices[triangle * 3 + corner]]] = true;
+                }
+
+                remainingIndices -= removedTriangles * 3;
+                largestCost = std::max(largestCost, collapse.cost);
+                collapsed = true;
+            }
+
+            if (!collapsed)
+                break;
+
+            std::vector<uint32_t> remapped {};
+            remapped.reserve(remainingIndices);
+
+            for (size_t i = 0; i < _indices.size(); i += 3)
+            {
+                const uint32_t a = vertexRemap[_indices[i]];
+                const uint32_t b = vertexRemap[_indices[i + 1]];
+                const uint32_t c = vertexRemap[_indices[i + 2]];
+
+                if (!IsDegenerate(a, b, c))
+                    remapped.insert(remapped.end(), { a, b, c });
+            }
+
+            _indices = std::move(remapped);
+        }
+
+        return MeshSimplification::Result { std::move(_indices), static_cast<float>(std::sqrt(largestCost)) };
+    }
+
+private:
+    const std::vector<glm::vec3>& _positions;
+
+    std::vector<uint32_t> _pointOfVertex;
+    std::vector<uint32_t> _points; // The first vertex of every point
+    std::vector<bool> _locked;
+    std::vector<Quadric> _quadrics;
+
+    std::vector<uint32_t> _indices;
+
+    // The triangles around every point, _fanTriangles[_fanOffsets[point]] up to _fanTriangles[_fanOffsets[point + 1]]
+    std::vector<uint32_t> _fanOffsets;
+    std::vector<uint32_t> _fanTriangles;
+
+    std::vector<uint32_t> _fromNeighbours;
+    std::vector<uint32_t> _toNeighbours;
+
+    glm::vec3 PointPosition(uint32_t point) const { return _positions[_points[point]]; }
+
+    bool IsDegenerate(uint32_t a, uint32_t b, uint32_t c) const
+    {
+        const uint32_t pa = _pointOfVertex[a], pb = _pointOfVertex[b], pc = _pointOfVertex[c];
+        return pa == pb || pb == pc || pa == pc;
+    }
+
+    void FindPoints()
+    {
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> pointOfPosition {};
+        pointOfPosition.reserve(_positions.size());
+
+        std::vector<uint32_t> verticesAtPoint {};
+
+        for (uint32_t vertex = 0; vertex < _positions.size(); ++vertex)
+        {
+            const PositionKey key { std::bit_cast<std::array<uint32_t, 3>>(_positions[vertex]) };
+            const auto [it, inserted] = pointOfPosition.try_emplace(key, static_cast<uint32_t>(_points.size()));
+
+            if (inserted)
+            {
+                _points.emplace_back(vertex);
+                verticesAtPoint.emplace_back(0);
+            }
+
+            _pointOfVertex[vertex] = it->second;
+            ++verticesAtPoint[it->second];
+        }
+
+        // A point with several vertices is on a seam, moving it would tear the attributes on either side apart
+        _locked.resize(_points.size());
+        for (uint32_t point = 0; point < _points.size(); ++point)
+            _locked[point] = verticesAtPoint[point] > 1;
+    }
+
+    void LockBorders()
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeUses {};
+        edgeUses.reserve(_indices.size());
+
+        for (size_t i = 0; i < _indices.size(); i += 3)
+        {
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t a = _pointOfVertex[_indices[i + corner]];
+                const uint32_t b = _pointOfVertex[_indices[i + (corner + 1) % 3]];
+                ++edgeUses[EdgeKey(a, b)];
+            }
+        }
+
+        // Edges with one triangle are on the border, edges with more than two are not manifold, either way the shape changes if they move
+        for (const auto& [edge, uses] : edgeUses)
+        {
+            if (uses != 2)
+            {
+                _locked[static_cast<uint32_t>(edge >> 32)] = true;
+                _locked[static_cast<uint32_t>(edge & 0xFFFFFFFF)] = true;
+            }
+        }
+    }
+
+    void ComputeQuadrics()
+    {
+        _quadrics.resize(_points.size());
+
+        for (size_t i = 0; i < _indices.size(); i += 3)
+        {
+            const glm::dvec3 a = _positions[_indices[i]];
+            const glm::dvec3 b = _positions[_indices[i + 1]];
+            const glm::dvec3 c = _positions[_indices[i + 2]];
+
+            const glm::dvec3 normal = glm::cross(b - a, c - a);
+            const double length = glm::length(normal);
+
+            if (length == 0.0)
+                continue;
+
+            const glm::dvec3 unitNormal = normal / length;
+            const Quadric quadric = Quadric::FromPlane(unitNormal, -glm::dot(unitNormal, a));
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+                _quadrics[_pointOfVertex[_indices[i + corner]]] += quadric;
+        }
+    }
+
+    void BuildFans()
+    {
+        _fanOffsets.assign(_points.size() + 1, 0);
+
+        for (uint32_t vertex : _indices)
+            ++_fanOffsets[_pointOfVertex[vertex] + 1];
+
+        for (size_t point = 0; point < _points.size(); ++point)
+            _fanOffsets[point + 1] += _fanOffsets[point];
+
+        std::vector<uint32_t> fill { _fanOffsets.begin(), _fanOffsets.end() - 1 };
+        _fanTriangles.resize(_indices.size());
+
+        for (size_t i = 0; i < _indices.size(); ++i)
+            _fanTriangles[fill[_pointOfVertex[_indices[i]]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<Collapse> FindCollapses() const
+    {
+        std::vector<uint64_t> edges {};
+        edges.reserve(_indices.size());
+
+        for (size_t i = 0; i < _indices.size(); i += 3)
+        {
+            for (uint32_t corner = 0; corner < 3; ++corner)
+                edges.emplace_back(EdgeKey(_pointOfVertex[_indices[i + corner]], _pointOfVertex[_indices[i + (corner + 1) % 3]]));
+        }
+
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        std::vector<Collapse> collapses {};
+        collapses.reserve(edges.size());
+
+        // Collapsing onto one of the two points keeps the vertices, only the direction with the lower error is considered
+        for (uint64_t edge : edges)
+        {
+            const uint32_t a = static_cast<uint32_t>(edge >> 32);
+            const uint32_t b = static_cast<uint32_t>(edge & 0xFFFFFFFF);
+
+            if (_locked[a] && _locked[b])
+                continue;
+
+            Quadric combined = _quadrics[a];
+            combined += _quadrics[b];
+
+            const double costOntoB = _locked[a] ? std::numeric_limits<double>::max() : combined.Evaluate(PointPosition(b));
+            const double costOntoA = _locked[b] ? std::numeric_limits<double>::max() : combined.Evaluate(PointPosition(a));
+
+            if (costOntoB <= costOntoA)
+                collapses.emplace_back(Collapse { costOntoB, a, b });
+            else
+                collapses.emplace_back(Collapse { costOntoA, b, a });
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs)
+            { return lhs.cost < rhs.cost || (lhs.cost == rhs.cost && EdgeKey(lhs.from, lhs.to) < EdgeKey(rhs.from, rhs.to)); });
+
+        return collapses;
+    }
+
+    void CollectNeighbours(uint32_t point, std::vector<uint32_t>& neighbours) const
+    {
+        neighbours.clear();
+
+        for (uint32_t fan = _fanOffsets[point]; fan < _fanOffsets[point + 1]; ++fan)
+        {
+            const uint32_t triangle = _fanTriangles[fan];
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t neighbour = _pointOfVertex[_indices[triangle * 3 + corner]];
+                if (neighbour != point)
+                    neighbours.emplace_back(neighbour);
+            }
+        }
+
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    }
+
+    bool CanCollapse(uint32_t from, uint32_t to, uint32_t& fromVertex, uint32_t& toVertex, uint32_t& removedTriangles)
+    {
+        const glm::vec3 target = PointPosition(to);
+        removedTriangles = 0;
+
+        for (uint32_t fan = _fanOffsets[from]; fan < _fanOffsets[from + 1]; ++fan)
+        {
+            const uint32_t triangle = _fanTriangles[fan];
+
+            std::array<glm::vec3, 3> corners {};
+            std::array<glm::vec3, 3> moved {};
+            bool containsTo = false;
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex = _indices[triangle * 3 + corner];
+                const uint32_t point = _pointOfVertex[vertex];
+
+                corners[corner] = _positions[vertex];
+                moved[corner] = point == from ? target : corners[corner];
+
+                if (point == from)
+                    fromVertex = vertex;
+
+                if (point == to)
+                {
+                    // Seams are locked, so the triangles around an unlocked point all use the same vertex of their other points
+                    toVertex = vertex;
+                    containsTo = true;
+                }
+            }
+
+            if (containsTo)
+            {
+                ++removedTriangles;
+                continue;
+            }
+
+            // The triangles that stay may not fold over or turn far enough to become slivers standing on their side
+            const glm::vec3 before = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            const glm::vec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+
+            if (glm::dot(before, after) <= MIN_NORMAL_COSINE * glm::length(before) * glm::length(after))
+                return false;
+        }
+
+        if (removedTriangles == 0)
+            return false;
+
+        // Points next to both ends of the edge have to be the tips of the removed triangles, otherwise the collapse pinches the surface
+        CollectNeighbours(from, _fromNeighbours);
+        CollectNeighbours(to, _toNeighbours);
+
+        uint32_t sharedNeighbours = 0;
+        auto fromIt = _fromNeighbours.begin();
+        auto toIt = _toNeighbours.begin();
+
+        while (fromIt != _fromNeighbours.end() && toIt != _toNeighbours.end())
+        {
+            if (*fromIt < *toIt)
+                ++fromIt;
+            else if (*toIt < *fromIt)
+                ++toIt;
+            else
+                ++sharedNeighbours, ++fromIt, ++toIt;
+        }
+
+        return sharedNeighbours == removedTriangles;
+    }
+};
+
+}
+
+template <typename T>
+MeshSimplification::Result MeshSimplification::Simplify(const CPUMesh<T>& mesh, size_t targetIndexCount, float targetError)
+{
+    ZoneScoped;
+
+    std::vector<glm::vec3> positions(mesh.vertices.size());
+    std::transform(mesh.vertices.begin(), mesh.vertices.end(), positions.begin(), [](const T& vertex)
+        { return vertex.position; });
+
+    Simplifier simplifier { positions, mesh.indices };
+    return simplifier.Run(targetIndexCount, targetError);
+}
+
+template <typename T>
+void MeshSimplification::GenerateLODs(CPUMesh<T>& mesh)
+{
+    ZoneScoped;
+
+    mesh.lods.clear();
+
+    const float maxError = MAX_LOD_ERROR * mesh.boundingRadius;
+    size_t previousIndexCount = mesh.indices.size();
+
+    while (mesh.lods.size() < MAX_LODS)
+    {
+        const size_t targetIndexCount = static_cast<size_t>(static_cast<float>(previousIndexCount / 3) * LOD_TRIANGLE_RATIO) * 3;
+        Result result = Simplify(mesh, targetIndexCount, maxError);
+
+        // A level that keeps most of the triangles costs memory without drawing much less
+        if (result.indices.empty() || static_cast<float>(result.indices.size()) > static_cast<float>(previousIndexCount) * (1.0f - MIN_LOD_REDUCTION))
+            break;
+
+        MeshOptimization::OptimizeVertexCache(result.indices, static_cast<uint32_t>(mesh.vertices.size()));
+
+        previousIndexCount = result.indices.size();
+        mesh.lods.emplace_back(MeshLOD { std::move(result.indices), result.error });
+    }
+}
+
+template MeshSimplification::Result MeshSimplification::Simplify(const CPUMesh<Vertex>& mesh, size_t targetIndexCount, float targetError);
+template MeshSimplification::Result MeshSimplification::Simplify(const CPUMesh<SkinnedVertex>& mesh, size_t targetIndexCount, float targetError);
+template void MeshSimplification::GenerateLODs(CPUMesh<Vertex>& mesh);
+template void MeshSimplification::GenerateLODs(CPUMesh<SkinnedVertex>& mesh);
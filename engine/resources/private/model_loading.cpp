@@ -7,18 +7,24 @@
 #include "lib/include_fastgltf.hpp"
 #include "log.hpp"
 #include "math_util.hpp"
+#include "mesh_optimization.hpp"
+#include "mesh_simplification.hpp"
 #include "physics/shape_factory.hpp"
 #include "profile_macros.hpp"
 #include "resource_management/image_resource_manager.hpp"
 #include "resource_management/mesh_resource_manager.hpp"
 
+#include <cstring>
+#include <future>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/norm.hpp>
 #include <stb_image.h>
 
-constexpr static auto DEFAULT_LOAD_FLAGS = fastgltf::Options::DecomposeNodeMatrices | fastgltf::Options::LoadExternalBuffers | fastgltf::Options::LoadExternalImages;
-static fastgltf::Parser parser = fastgltf::Parser(fastgltf::Extensions::KHR_lights_punctual | fastgltf::Extensions::KHR_texture_transform);
+// External buffers and images are not loaded by fastgltf, which reads them from the native filesystem, see LoadExternalData
+constexpr static auto DEFAULT_LOAD_FLAGS = fastgltf::Options::DecomposeNodeMatrices;
+// The parser keeps its JSON state between loads and isn't thread safe, models are loaded on several threads at once
+static thread_local fastgltf::Parser parser = fastgltf::Parser(fastgltf::Extensions::KHR_lights_punctual | fastgltf::Extensions::KHR_texture_transform);
 
 namespace detail
 {
@@ -45,45 +51,44 @@ fastgltf::math::fmat4x4 ToFastGLTFMat4(const glm::mat4& glm_mat)
     return out;
 }
 
-class IfstreamDataGetter : public fastgltf::GltfDataGetter
+// Serves fastgltf from the whole file in memory, read with a single call through the virtual filesystem.
+// The bytes are followed by the padding fastgltf asks for, so reads point straight into the buffer instead of copying.
+class MemoryDataGetter : public fastgltf::GltfDataGetter
 {
 public:
-    explicit IfstreamDataGetter(const std::filesystem::path& path)
-        : stream(fileIO::OpenReadStream(path.generic_string()))
-        , position(0)
+    explicit MemoryDataGetter(std::vector<std::byte> bytes, std::size_t size)
+        : bytes(std::move(bytes))
+        , size(size)
     {
-        if (stream)
-        {
-            stream.value().seekg(0, std::ios::end);
-            size = static_cast<std::size_t>(stream.value().tellg());
-            stream.value().seekg(0, std::ios::beg);
-        }
     }
 
     void read(void* ptr, std::size_t count) override
     {
-        stream.value().seekg(static_cast<std::streamoff>(position), std::ios::beg);
-        stream.value().read(reinterpret_cast<char*>(ptr), static_cast<std::streamsize>(count));
-        position += static_cast<std::size_t>(stream.value().gcount());
+        count = std::min(count, size - position);
+        std::memcpy(ptr, bytes.data() + position, count);
+        position += count;
     }
 
     [[nodiscard]] fastgltf::span<std::byte> read(std::size_t count, std::size_t padding) override
     {
-        tempBuffer.resize(count + padding);
-        stream.value().seekg(static_cast<std::streamoff>(position), std::ios::beg);
-        stream.value().read(reinterpret_cast<char*>(tempBuffer.data()), static_cast<std::streamsize>(count));
-        std::size_t bytesRead = static_cast<std::size_t>(stream.value().gcount());
-        position += bytesRead;
-        // Padding can be uninitialized, but we'll zero it for safety
-        std::memset(tempBuffer.data() + bytesRead, 0, padding);
+        count = std::min(count, size - position);
+        const std::size_t start = position;
+        position += count;
+
+        if (start + count + padding <= bytes.size())
+        {
+            return fastgltf::span<std::byte>(bytes.data() + start, count + padding);
+        }
+
+        // Only when fastgltf asks for more padding than the file was read with
+        tempBuffer.assign(count + padding, std::byte { 0 });
+        std::memcpy(tempBuffer.data(), bytes.data() + start, count);
         return fastgltf::span<std::byte>(tempBuffer.data(), count + padding);
     }
 
     void reset() override
     {
         position = 0;
-        stream.value().clear(); // clear EOF or fail bits
-        stream.value().seekg(0, std::ios::beg);
     }
 
     [[nodiscard]] std::size_t bytesRead() override
@@ -97,42 +102,128 @@ public:
     }
 
 private:
-    std::optional<PhysFS::ifstream> stream;
+    std::vector<std::byte> bytes;
     std::size_t position = 0;
     std::size_t size = 0;
-    mutable std::vector<std::byte> tempBuffer;
+    std::vector<std::byte> tempBuffer;
 };
 
+// Reads the buffers and images stored in files of their own through the virtual filesystem, relative to the directory of the glTF,
+// so they load from the game archive as well. They end up in memory, like fastgltf would have loaded them.
+void LoadExternalData(fastgltf::Asset& asset, std::string_view directory)
+{
+    ZoneScoped;
+
+    const auto load = [directory](fastgltf::DataSource& source)
+    {
+        const auto* uri = std::get_if<fastgltf::sources::URI>(&source);
+
+        if (uri == nullptr || !uri->uri.isLocalPath())
+            return;
+
+        std::string path(uri->uri.path().begin(), uri->uri.path().end());
+
+        if (!directory.empty())
+            path = std::string { directory } + "/" + path;
+
+        std::optional<std::vector<std::byte>> bytes = fileIO::ReadFileBytes(path);
+
+        if (!bytes.has_value() || uri->fileByteOffset > bytes->size())
+            throw std::runtime_error("Failed reading glTF data from " + path);
+
+        fastgltf::StaticVector<std::byte> data(bytes->size() - uri->fileByteOffset);
+        std::memcpy(data.data(), bytes->data() + uri->fileByteOffset, data.size());
+
+        source = fastgltf::sources::Array { std::move(data), uri->mimeType };
+    };
+
+    for (auto& buffer : asset.buffers)
+        load(buffer.data);
+
+    for (auto& image : asset.images)
+        load(image.data);
+}
+
 fastgltf::Asset LoadFastGLTFAsset(std::string_view path)
 {
     ZoneScoped;
     std::string zone = std::string(path) + " fastgltf parse";
     ZoneName(zone.c_str(), 128);
 
-    IfstreamDataGetter fileStream { path };
+    const size_t directoryEnd = path.find_last_of('/');
+    const std::string_view directory = directoryEnd == std::string_view::npos ? std::string_view {} : path.substr(0, directoryEnd);
 
-    // if (!fileStream.isOpen())
-    //   throw std::runtime_error("Path not found!");
+    const auto parse = [](fastgltf::GltfDataGetter& data)
+    {
+        // fastgltf doesn't read anything from the directory, as external data is loaded afterwards, but it has to exist on disk
+        auto loadedGltf = parser.loadGltf(data, ".", DEFAULT_LOAD_FLAGS);
+        if (!loadedGltf)
+        {
+            bblog::error("error in gltf");
+            throw std::runtime_error(getErrorMessage(loadedGltf.error()).data());
+        }
+
+        return std::move(loadedGltf.get());
+    };
+
+    std::optional<fastgltf::Asset> gltf {};
 
-#ifdef DISTRIBUTION
-    std::string_view directory = "./";
-#else
-    std::string_view directory = path.substr(0, path.find_last_of('/'));
+#if FASTGLTF_HAS_MEMORY_MAPPED_FILE
+    // Files on disk are mapped, so the parser reads them without copying them first
+    if (auto nativePath = fileIO::GetNativePath(std::string { path }))
+    {
+        auto mappedFile = fastgltf::MappedGltfFile::FromPath(nativePath.value());
+
+        if (mappedFile)
+            gltf = parse(mappedFile.get());
+    }
 #endif
 
-    auto loadedGltf = parser.loadGltf(fileStream, directory, DEFAULT_LOAD_FLAGS);
-    if (!loadedGltf)
+    // Files in the game archive are read with a single call, instead of seeking and reading for every request of the parser
+    if (!gltf.has_value())
     {
-        bblog::error("error in gltf");
-        throw std::runtime_error(getErrorMessage(loadedGltf.error()).data());
+        std::optional<std::vector<std::byte>> bytes = fileIO::ReadFileBytes(std::string { path }, fastgltf::getGltfBufferPadding());
+
+        if (!bytes.has_value())
+            throw std::runtime_error("Path not found: " + std::string { path });
+
+        const std::size_t size = bytes->size() - fastgltf::getGltfBufferPadding();
+        MemoryDataGetter data { std::move(bytes.value()), size };
+        gltf = parse(data);
     }
 
-    auto gltf = std::move(loadedGltf.get());
+    LoadExternalData(gltf.value(), directory);
 
-    if (gltf.scenes.size() > 1)
+    if (gltf->scenes.size() > 1)
         bblog::warn("GLTF contains more than one scene, but we only load one scene!");
 
-    return gltf;
+    return std::move(gltf.value());
+}
+
+void DecodeImage(CPUImage& out, const std::byte* encoded, size_t size)
+{
+    int32_t width, height, nrChannels;
+    stbi_uc* stbiData = nullptr;
+    {
+        ZoneScopedN("STB Image step");
+        stbiData = stbi_load_from_memory(
+            reinterpret_cast<const stbi_uc*>(encoded),
+            static_cast<int32_t>(size), &width, &height, &nrChannels,
+            4);
+    }
+
+    {
+        ZoneScopedN("Copy data step");
+        std::vector<std::byte> data = std::vector<std::byte>(width * height * 4);
+        std::memcpy(data.data(), std::bit_cast<std::byte*>(stbiData), data.size());
+
+        out
+            .SetSize(width, height)
+            .SetData(std::move(data))
+            .SetMips(std::floor(std::log2(std::max(width, height))));
+    }
+
+    stbi_image_free(stbiData);
 }
 
 CPUImage ProcessImage(const fastgltf::Asset& asset, const fastgltf::Image& gltfImage)
@@ -152,34 +243,18 @@ CPUImage ProcessImage(const fastgltf::Asset& asset, const fastgltf::Image& gltfI
 
         if (auto* imageData = std::get_if<fastgltf::sources::Array>(&buffer.data))
         {
-            int32_t width, height, nrChannels;
-            stbi_uc* stbiData = nullptr;
-            {
-                ZoneScopedN("STB Image step");
-                stbiData = stbi_load_from_memory(
-                    reinterpret_cast<const stbi_uc*>(imageData->bytes.data() + bufferView.byteOffset),
-                    static_cast<int32_t>(bufferView.byteLength), &width, &height, &nrChannels,
-                    4);
-            }
-
-            {
-                ZoneScopedN("Copy data step");
-                std::vector<std::byte> data = std::vector<std::byte>(width * height * 4);
-                std::memcpy(data.data(), std::bit_cast<std::byte*>(stbiData), data.size());
-
-                out
-                    .SetSize(width, height)
-                    .SetData(std::move(data))
-                    .SetMips(std::floor(std::log2(std::max(width, height))));
-            }
-
-            stbi_image_free(stbiData);
+            DecodeImage(out, imageData->bytes.data() + bufferView.byteOffset, bufferView.byteLength);
         }
         else
         {
             throw std::runtime_error("Unhandled image gltf type");
         }
     }
+    else if (auto* imageData = std::get_if<fastgltf::sources::Array>(&gltfImage.data))
+    {
+        // External image, read by LoadExternalData
+        DecodeImage(out, imageData->bytes.data(), imageData->bytes.size());
+    }
     else
     {
         throw std::runtime_error("Unhandled image gltf type");
@@ -211,32 +286,11 @@ CPUModel ModelLoading::LoadGLTF(std::string_view path)
     std::string zone = std::string(path) + " Model Extraction";
     ZoneName(zone.c_str(), 128);
 
-    detail::IfstreamDataGetter fileStream { path };
-
-    // if (!fileStream.isOpen())
-    //   throw std::runtime_error("Path not found!");
-
-#ifdef DISTRIBUTION
-    std::string_view directory = "./";
-#else
-    std::string_view directory = path.substr(0, path.find_last_of('/'));
-#endif
-
-    auto loadedGltf = parser.loadGltf(fileStream, directory, DEFAULT_LOAD_FLAGS);
-    if (!loadedGltf)
-    {
-        bblog::error("error in gltf");
-        throw std::runtime_error(getErrorMessage(loadedGltf.error()).data());
-    }
-
-    auto gltf = std::move(loadedGltf.get());
+    auto gltf = detail::LoadFastGLTFAsset(path);
 
     size_t offset = path.find_last_of('/') + 1;
     std::string_view name = path.substr(offset, path.find_last_of('.') - offset);
 
-    if (gltf.scenes.size() > 1)
-        bblog::warn("GLTF contains more than one scene, but we only load one scene!");
-
     return ProcessModel(gltf, name);
 }
 
@@ -522,6 +576,9 @@ CPUMesh<T> ProcessPrimitive(const fastgltf::Primitive& gltfPrimitive, const fast
         CalculateTangents<T>(mesh);
     }
 
+    // Only after the normals and tangents are complete, so vertices that only differ in those are not merged
+    MeshOptimization::Optimize(mesh);
+
     return mesh;
 }
 
@@ -585,8 +642,8 @@ CPUImage ProcessImage(const fastgltf::Image& gltfImage, const fastgltf::Asset& g
                        auto& buffer = gltf.buffers[bufferView.bufferIndex];
 
                        std::visit(
-                           fastgltf::visitor { // We only care about VectorWithMime here, because we specify LoadExternalBuffers, meaning
-                               // all buffers are already loaded into a vector.
+                           fastgltf::visitor { // We only care about arrays here, because LoadExternalData loads
+                               // all buffers into memory.
                                [](MAYBE_UNUSED auto& arg) {},
                                [&](const fastgltf::sources::Array& vector)
                                {
@@ -1040,6 +1097,28 @@ CPUModel ProcessModel(const fastgltf::Asset& gltf, const std::string_view name)
     return model;
 }
 
+// Static primitives are processed together with their collider, so a collider doesn't wait for the other primitives
+struct StaticPrimitiveResult
+{
+    CPUMesh<Vertex> mesh {};
+    JPH::ShapeRefC collider {};
+};
+
+StaticPrimitiveResult ProcessStaticPrimitive(const fastgltf::Primitive& gltfPrimitive, const fastgltf::Asset& gltf, bool genCollision)
+{
+    ZoneScoped;
+
+    StaticPrimitiveResult result {};
+    result.mesh = ProcessPrimitive<Vertex>(gltfPrimitive, gltf);
+
+    if (genCollision)
+    {
+        result.collider = detail::ProcessMeshIntoCollider(result.mesh);
+    }
+
+    return result;
+}
+
 CPUModel ModelLoading::LoadGLTFFast(ThreadPool& scheduler, std::string_view path, bool genCollision)
 {
     size_t offset = path.find_last_of('/') + 1;
@@ -1070,7 +1149,11 @@ CPUModel ModelLoading::LoadGLTFFast(ThreadPool& scheduler, std::string_view path
     // Tracks gltf mesh index to our engine mesh index.
     std::unordered_multimap<uint32_t, std::pair<MeshType, uint32_t>> meshLUT {};
 
-    // Extract mesh data
+    std::vector<std::future<StaticPrimitiveResult>> staticMeshResults {};
+    std::vector<std::future<CPUMesh<SkinnedVertex>>> skinnedMeshResults {};
+
+    // Queue the mesh data extraction, the index of every mesh is decided here in glTF order,
+    // so the result is the same no matter in which order the primitives finish
     {
         ZoneScopedN("Mesh Loading");
 
@@ -1081,22 +1164,19 @@ CPUModel ModelLoading::LoadGLTFFast(ThreadPool& scheduler, std::string_view path
             {
                 if (gltf.skins.size() > 0 && gltfPrimitive.findAttribute("WEIGHTS_0") != gltfPrimitive.attributes.cend() && gltfPrimitive.findAttribute("JOINTS_0") != gltfPrimitive.attributes.cend())
                 {
-                    CPUMesh<SkinnedVertex> primitive = ProcessPrimitive<SkinnedVertex>(gltfPrimitive, gltf);
-                    model.skinnedMeshes.emplace_back(primitive);
+                    auto future = scheduler.QueueWork([&gltf, &gltfPrimitive]()
+                        { return ProcessPrimitive<SkinnedVertex>(gltfPrimitive, gltf); });
 
-                    meshLUT.insert({ counter, std::pair(MeshType::eSKINNED, model.skinnedMeshes.size() - 1) });
+                    skinnedMeshResults.emplace_back(std::move(future));
+                    meshLUT.insert({ counter, std::pair(MeshType::eSKINNED, skinnedMeshResults.size() - 1) });
                 }
                 else
                 {
-                    CPUMesh<Vertex> primitive = ProcessPrimitive<Vertex>(gltfPrimitive, gltf);
-
-                    if (genCollision)
-                    {
-                        model.colliders.emplace_back(detail::ProcessMeshIntoCollider(primitive));
-                    }
+                    auto future = scheduler.QueueWork([&gltf, &gltfPrimitive, genCollision]()
+                        { return ProcessStaticPrimitive(gltfPrimitive, gltf, genCollision); });
 
-                    model.meshes.emplace_back(primitive);
-                    meshLUT.insert({ counter, std::pair(MeshType::eSTATIC, model.meshes.size() - 1) });
+                    staticMeshResults.emplace_back(std::move(future));
+                    meshLUT.insert({ counter, std::pair(MeshType::eSTATIC, staticMeshResults.size() - 1) });
                 }
             }
             ++counter;
@@ -1189,11 +1269,6 @@ CPUModel ModelLoading::LoadGLTFFast(ThreadPool& scheduler, std::string_view path
         }
     }
 
-    for (auto& image : imageLoadResults)
-    {
-        model.textures.emplace_back(image.get());
-    }
-
     // Moves the animation from the model root to the skeleton root
     if (model.hierarchy.skeletonRoot.has_value())
     {
@@ -1206,5 +1281,75 @@ CPUModel ModelLoading::LoadGLTFFast(ThreadPool& scheduler, std::string_view path
         }
     }
 
+    {
+        ZoneScopedN("Wait For Workers");
+
+        // Everything has to finish before collecting, since a failed task throws on get() while the others still read from the asset
+        for (auto& result : staticMeshResults)
+            result.wait();
+        for (auto& result : skinnedMeshResults)
+            result.wait();
+        for (auto& result : imageLoadResults)
+            result.wait();
+    }
+
+    model.meshes.reserve(staticMeshResults.size());
+    for (auto& result : staticMeshResults)
+    {
+        StaticPrimitiveResult primitive = result.get();
+
+        if (genCollision)
+        {
+            model.colliders.emplace_back(std::move(primitive.collider));
+        }
+
+        model.meshes.emplace_back(std::move(primitive.mesh));
+    }
+
+    model.skinnedMeshes.reserve(skinnedMeshResults.size());
+    for (auto& result : skinnedMeshResults)
+    {
+        model.skinnedMeshes.emplace_back(result.get());
+    }
+
+    for (auto& image : imageLoadResults)
+    {
+        model.textures.emplace_back(image.get());
+    }
+
     return model;
-}
\ No newline at end of file
+}
+
+void ModelLoading::GenerateColliders(CPUModel& model)
+{
+    ZoneScoped;
+
+    model.colliders.clear();
+    model.colliders.reserve(model.meshes.size());
+
+    for (const auto& mesh : model.meshes)
+    {
+        model.colliders.emplace_back(detail::ProcessMeshIntoCollider(mesh));
+    }
+}
+
+void ModelLoading::GenerateLODs(ThreadPool& scheduler, CPUModel& model)
+{
+    ZoneScoped;
+
+    std::vector<std::future<void>> results {};
+    results.reserve(model.meshes.size() + model.skinnedMeshes.size());
+
+    for (auto& mesh : model.meshes)
+        results.emplace_back(scheduler.QueueWork([&mesh]()
+            { MeshSimplification::GenerateLODs(mesh); }));
+    for (auto& mesh : model.skinnedMeshes)
+        results.emplace_back(scheduler.QueueWork([&mesh]()
+            { MeshSimplification::GenerateLODs(mesh); }));
+
+    // Same as loading, everything has to finish before a failure is rethrown, since the others still write to the model
+    for (auto& result : results)
+        result.wait();
+    for (auto& result : results)
+        result.get();
+}
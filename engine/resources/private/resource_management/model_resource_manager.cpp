@@ -81,3 +81,25 @@ ResourceHandle<GPUModel> ModelResourceManager::Create(const CPUModel& data, Batc
 
     return ResourceManager::Create(std::move(model));
 }
+
+void ModelResourceManager::Destroy(const ResourceHandle<GPUModel>& handle)
+{
+    const GPUModel* model = Access(handle);
+
+    if (model == nullptr)
+        return;
+
+    for (const auto& mesh : model->staticMeshes)
+        _meshResourceManager->Destroy(mesh);
+
+    for (const auto& mesh : model->skinnedMeshes)
+        _meshResourceManager->Destroy(mesh);
+
+    for (const auto& material : model->materials)
+        _materialResourceManager->Destroy(material);
+
+    for (const auto& texture : model->textures)
+        _imageResourceManager->Destroy(texture);
+
+    ResourceManager::Destroy(handle);
+}
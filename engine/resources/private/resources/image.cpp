@@ -1,5 +1,6 @@
 #include "resources/image.hpp"
 #include "profile_macros.hpp"
+#include "texture_compression.hpp"
 #include "vulkan_helper.hpp"
 
 #include <file_io.hpp>
@@ -90,6 +91,17 @@ CPUImage& CPUImage::SetType(ImageType type)
     return *this;
 }
 
+bool CPUImage::HasMipChain() const
+{
+    if (type != ImageType::e2D || depth != 1 || layers != 1 || isHDR || mips == 0)
+    {
+        return false;
+    }
+
+    const size_t chainSize = TextureCompression::GetMipChainSize(format, width, height, mips);
+    return chainSize != 0 && initialData.size() == chainSize;
+}
+
 vk::ImageType ImageTypeConversion(ImageType type)
 {
     switch (type)
@@ -120,6 +132,74 @@ vk::ImageViewType ImageViewTypeConversion(ImageType type)
     }
 }
 
+// Images with their mips in the data get every level copied as it is, otherwise the first level is copied and the others are blitted from it
+void RecordImageUpload(vk::CommandBuffer commandBuffer, const CPUImage& creation, vk::Image image, vk::Buffer stagingBuffer, uint8_t mips)
+{
+    if (creation.HasMipChain())
+    {
+        util::TransitionImageLayout(commandBuffer, image, creation.format, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, 1, 0, creation.mips);
+
+        std::vector<vk::BufferImageCopy> regions(creation.mips);
+        vk::DeviceSize offset = 0;
+
+        for (uint32_t i = 0; i < creation.mips; ++i)
+        {
+            regions[i].bufferOffset = offset;
+            regions[i].imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+            regions[i].imageSubresource.mipLevel = i;
+            regions[i].imageSubresource.baseArrayLayer = 0;
+            regions[i].imageSubresource.layerCount = 1;
+            regions[i].imageExtent = vk::Extent3D { std::max<uint32_t>(creation.width >> i, 1), std::max<uint32_t>(creation.height >> i, 1), 1 };
+
+            offset += TextureCompression::GetMipSize(creation.format, creation.width, creation.height, i);
+        }
+
+        commandBuffer.copyBufferToImage(stagingBuffer, image, vk::ImageLayout::eTransferDstOptimal, regions);
+
+        util::TransitionImageLayout(commandBuffer, image, creation.format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, 1, 0, creation.mips);
+        return;
+    }
+
+    vk::ImageLayout oldLayout = vk::ImageLayout::eTransferDstOptimal;
+
+    util::TransitionImageLayout(commandBuffer, image, creation.format, vk::ImageLayout::eUndefined, oldLayout);
+
+    util::CopyBufferToImage(commandBuffer, stagingBuffer, image, creation.width, creation.height);
+
+    if (creation.mips > 1)
+    {
+        ZoneScopedN("Mip creation dispatch");
+        util::TransitionImageLayout(commandBuffer, image, creation.format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, 1, 0, 1);
+
+        for (uint32_t i = 1; i < creation.mips; ++i)
+        {
+            vk::ImageBlit blit {};
+            blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+            blit.srcSubresource.layerCount = 1;
+            blit.srcSubresource.mipLevel = i - 1;
+            blit.srcOffsets[1].x = creation.width >> (i - 1);
+            blit.srcOffsets[1].y = creation.height >> (i - 1);
+            blit.srcOffsets[1].z = 1;
+
+            blit.dstSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+            blit.dstSubresource.layerCount = 1;
+            blit.dstSubresource.mipLevel = i;
+            blit.dstOffsets[1].x = creation.width >> i;
+            blit.dstOffsets[1].y = creation.height >> i;
+            blit.dstOffsets[1].z = 1;
+
+            util::TransitionImageLayout(commandBuffer, image, creation.format, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, 1, i);
+
+            commandBuffer.blitImage(image, vk::ImageLayout::eTransferSrcOptimal, image, vk::ImageLayout::eTransferDstOptimal, 1, &blit, vk::Filter::eLinear);
+
+            util::TransitionImageLayout(commandBuffer, image, creation.format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, 1, i);
+        }
+        oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+    }
+
+    util::TransitionImageLayout(commandBuffer, image, creation.format, oldLayout, vk::ImageLayout::eShaderReadOnlyOptimal, 1, 0, mips);
+}
+
 GPUImage::GPUImage(const CPUImage& creation, ResourceHandle<Sampler> textureSampler, const std::shared_ptr<VulkanContext>& context, SingleTimeCommands* const commands)
     : _context(context)
 {
@@ -217,13 +297,24 @@ GPUImage::GPUImage(const CPUImage& creation, ResourceHandle<Sampler> textureSamp
         ZoneScopedN("Image data Upload");
         vk::DeviceSize imageSize = width * height * depth * 4;
 
-        if (format == vk::Format::eR8Unorm)
+        if (creation.HasMipChain())
+        {
+            imageSize = creation.initialData.size();
+        }
+        else if (TextureCompression::GetBlockDimension(format) > 1)
         {
-            imageSize = width * height * depth;
+            throw std::runtime_error("Compressed images need to be created with their full mip chain!");
         }
-        if (isHDR)
+        else
         {
-            imageSize *= sizeof(float);
+            if (format == vk::Format::eR8Unorm)
+            {
+                imageSize = width * height * depth;
+            }
+            if (isHDR)
+            {
+                imageSize *= sizeof(float);
+            }
         }
 
         vk::Buffer stagingBuffer;
@@ -235,49 +326,10 @@ GPUImage::GPUImage(const CPUImage& creation, ResourceHandle<Sampler> textureSamp
             vmaCopyMemoryToAllocation(_context->MemoryAllocator(), creation.initialData.data(), stagingBufferAllocation, 0, imageSize);
         }
 
-        vk::ImageLayout oldLayout = vk::ImageLayout::eTransferDstOptimal;
-
         if (commands)
         {
             ZoneScopedN("Command upload dispatch");
-            const vk::CommandBuffer& commandBuffer = commands->CommandBuffer();
-
-            util::TransitionImageLayout(commandBuffer, image, format, vk::ImageLayout::eUndefined, oldLayout);
-
-            util::CopyBufferToImage(commandBuffer, stagingBuffer, image, width, height);
-
-            if (creation.mips > 1)
-            {
-                ZoneScopedN("Mip creation dispatch");
-                util::TransitionImageLayout(commandBuffer, image, format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, 1, 0, 1);
-
-                for (uint32_t i = 1; i < creation.mips; ++i)
-                {
-                    vk::ImageBlit blit {};
-                    blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-                    blit.srcSubresource.layerCount = 1;
-                    blit.srcSubresource.mipLevel = i - 1;
-                    blit.srcOffsets[1].x = width >> (i - 1);
-                    blit.srcOffsets[1].y = height >> (i - 1);
-                    blit.srcOffsets[1].z = 1;
-
-                    blit.dstSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-                    blit.dstSubresource.layerCount = 1;
-                    blit.dstSubresource.mipLevel = i;
-                    blit.dstOffsets[1].x = width >> i;
-                    blit.dstOffsets[1].y = height >> i;
-                    blit.dstOffsets[1].z = 1;
-
-                    util::TransitionImageLayout(commandBuffer, image, format, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, 1, i);
-
-                    commandBuffer.blitImage(image, vk::ImageLayout::eTransferSrcOptimal, image, vk::ImageLayout::eTransferDstOptimal, 1, &blit, vk::Filter::eLinear);
-
-                    util::TransitionImageLayout(commandBuffer, image, format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, 1, i);
-                }
-                oldLayout = vk::ImageLayout::eTransferSrcOptimal;
-            }
-
-            util::TransitionImageLayout(commandBuffer, image, format, oldLayout, vk::ImageLayout::eShaderReadOnlyOptimal, 1, 0, mips);
+            RecordImageUpload(commands->CommandBuffer(), creation, image, stagingBuffer, mips);
 
             commands->TrackAllocation(stagingBufferAllocation, stagingBuffer);
         }
@@ -286,42 +338,7 @@ GPUImage::GPUImage(const CPUImage& creation, ResourceHandle<Sampler> textureSamp
             ZoneScopedN("Command upload dispatch");
             vk::CommandBuffer commandBuffer = util::BeginSingleTimeCommands(_context);
 
-            util::TransitionImageLayout(commandBuffer, image, format, vk::ImageLayout::eUndefined, oldLayout);
-
-            util::CopyBufferToImage(commandBuffer, stagingBuffer, image, width, height);
-
-            if (creation.mips > 1)
-            {
-                ZoneScopedN("Mip creation dispatch");
-                util::TransitionImageLayout(commandBuffer, image, format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, 1, 0, 1);
-
-                for (uint32_t i = 1; i < creation.mips; ++i)
-                {
-                    vk::ImageBlit blit {};
-                    blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-                    blit.srcSubresource.layerCount = 1;
-                    blit.srcSubresource.mipLevel = i - 1;
-                    blit.srcOffsets[1].x = width >> (i - 1);
-                    blit.srcOffsets[1].y = height >> (i - 1);
-                    blit.srcOffsets[1].z = 1;
-
-                    blit.dstSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-                    blit.dstSubresource.layerCount = 1;
-                    blit.dstSubresource.mipLevel = i;
-                    blit.dstOffsets[1].x = width >> i;
-                    blit.dstOffsets[1].y = height >> i;
-                    blit.dstOffsets[1].z = 1;
-
-                    util::TransitionImageLayout(commandBuffer, image, format, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, 1, i);
-
-                    commandBuffer.blitImage(image, vk::ImageLayout::eTransferSrcOptimal, image, vk::ImageLayout::eTransferDstOptimal, 1, &blit, vk::Filter::eLinear);
-
-                    util::TransitionImageLayout(commandBuffer, image, format, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal, 1, i);
-                }
-                oldLayout = vk::ImageLayout::eTransferSrcOptimal;
-            }
-
-            util::TransitionImageLayout(commandBuffer, image, format, oldLayout, vk::ImageLayout::eShaderReadOnlyOptimal, 1, 0, mips);
+            RecordImageUpload(commandBuffer, creation, image, stagingBuffer, mips);
 
             {
                 ZoneScopedN("Waiting Image upload");
@@ -0,0 +1,785 @@
+#include "texture_compression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+
+using namespace TextureCompression;
+
+constexpr uint32_t RGBA8_SIZE = 4;
+constexpr uint32_t BC4_PALETTE_SIZE = 8;
+constexpr uint32_t BC7_INDEX_COUNT = 16;
+constexpr uint32_t BC7_LEAST_SQUARES_PASSES = 2;
+
+// Interpolation weights out of 64 for the 4 bit indices of BC7
+constexpr std::array<uint32_t, BC7_INDEX_COUNT> BC7_WEIGHTS = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Reads and writes the bits of a block from the least significant bit of the first byte onwards, like the BC formats store them
+template <size_t N>
+class BlockBits
+{
+public:
+    explicit BlockBits(std::array<std::byte, N>& bytes)
+        : _bytes(bytes)
+    {
+    }
+
+    void Write(uint32_t value, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; ++i, ++_position)
+        {
+            if ((value >> i) & 1u)
+                _bytes[_position / 8] |= std::byte { static_cast<uint8_t>(1u << (_position % 8)) };
+        }
+    }
+
+    uint32_t Read(uint32_t count)
+    {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < count; ++i, ++_position)
+            value |= ((std::to_integer<uint32_t>(_bytes[_position / 8]) >> (_position % 8)) & 1u) << i;
+
+        return value;
+    }
+
+private:
+    std::array<std::byte, N>& _bytes;
+    uint32_t _position = 0;
+};
+
+std::array<uint8_t, BC4_PALETTE_SIZE> MakeBC4Palette(uint8_t red0, uint8_t red1)
+{
+    std::array<uint8_t, BC4_PALETTE_SIZE> palette { red0, red1 };
+
+    if (red0 > red1)
+    {
+        for (uint32_t i = 2; i < 8; ++i)
+            palette[i] = static_cast<uint8_t>(((8 - i) * red0 + (i - 1) * red1 + 3) / 7);
+    }
+    else
+    {
+        for (uint32_t i = 2; i < 6; ++i)
+            palette[i] = static_cast<uint8_t>(((6 - i) * red0 + (i - 1) * red1 + 2) / 5);
+
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    return palette;
+}
+
+uint8_t InterpolateBC7(uint8_t endpoint0, uint8_t endpoint1, uint32_t index)
+{
+    return static_cast<uint8_t>(((64 - BC7_WEIGHTS[index]) * endpoint0 + BC7_WEIGHTS[index] * endpoint1 + 32) >> 6);
+}
+
+// A mode 6 endpoint, 7 bits per channel with a shared lowest bit
+struct BC7Endpoint
+{
+    std::array<uint8_t, 4> channels {};
+    uint8_t pBit = 0;
+
+    uint8_t Expand(uint32_t channel) const
+    {
+        return static_cast<uint8_t>((channels[channel] << 1) | pBit);
+    }
+};
+
+BC7Endpoint QuantizeBC7Endpoint(const std::array<float, 4>& color, bool opaque)
+{
+    BC7Endpoint best {};
+    float bestError = std::numeric_limits<float>::max();
+
+    // Opaque blocks can only keep an alpha of 255 with the p-bit set
+    for (uint8_t pBit = opaque ? 1 : 0; pBit < 2; ++pBit)
+    {
+        BC7Endpoint endpoint { {}, pBit };
+        float error = 0.0f;
+
+        for (uint32_t channel = 0; channel < 4; ++channel)
+        {
+            const float quantized = std::round((std::clamp(color[channel], 0.0f, 255.0f) - pBit) / 2.0f);
+            endpoint.channels[channel] = static_cast<uint8_t>(std::clamp(quantized, 0.0f, 127.0f));
+
+            const float difference = endpoint.Expand(channel) - color[channel];
+            error += difference * difference;
+        }
+
+        if (opaque)
+            endpoint.channels[3] = 127;
+
+        if (error < bestError)
+        {
+            bestError = error;
+            best = endpoint;
+        }
+    }
+
+    return best;
+}
+
+uint32_t AssignBC7Indices(const PixelBlock& pixels, const BC7Endpoint& endpoint0, const BC7Endpoint& endpoint1, std::array<uint32_t, PIXELS_PER_BLOCK>& indices)
+{
+    std::array<std::array<uint8_t, 4>, BC7_INDEX_COUNT> palette {};
+    for (uint32_t index = 0; index < BC7_INDEX_COUNT; ++index)
+    {
+        for (uint32_t channel = 0; channel < 4; ++channel)
+            palette[index][channel] = InterpolateBC7(endpoint0.Expand(channel), endpoint1.Expand(channel), index);
+    }
+
+    uint32_t totalError = 0;
+    for (uint32_t pixel = 0; pixel < PIXELS_PER_BLOCK; ++pixel)
+    {
+        uint32_t bestError = std::numeric_limits<uint32_t>::max();
+
+        for (uint32_t index = 0; index < BC7_INDEX_COUNT; ++index)
+        {
+            uint32_t error = 0;
+            for (uint32_t channel = 0; channel < 4; ++channel)
+            {
+                const int32_t difference = static_cast<int32_t>(palette[index][channel]) - pixels[pixel][channel];
+                error += static_cast<uint32_t>(difference * difference);
+            }
+
+            if (error < bestError)
+            {
+                bestError = error;
+                indices[pixel] = index;
+            }
+        }
+
+        totalError += bestError;
+    }
+
+    return totalError;
+}
+
+// Principal axis of the block colors with a few power iterations, endpoints are placed at the extremes along it
+std::pair<std::array<float, 4>, std::array<float, 4>> FindBC7Endpoints(const PixelBlock& pixels)
+{
+    std::array<float, 4> mean {};
+    for (const auto& pixel : pixels)
+    {
+        for (uint32_t channel = 0; channel < 4; ++channel)
+            mean[channel] += pixel[channel] / static_cast<float>(PIXELS_PER_BLOCK);
+    }
+
+    std::array<std::array<float, 4>, 4> covariance {};
+    for (const auto& pixel : pixels)
+    {
+        for (uint32_t row = 0; row < 4; ++row)
+        {
+            for (uint32_t column = 0; column < 4; ++column)
+                covariance[row][column] += (pixel[row] - mean[row]) * (pixel[column] - mean[column]);
+        }
+    }
+
+    // Starting from the row of the channel that varies most, a fixed start can be orthogonal to the axis, like when red and green go opposite ways
+    uint32_t widest = 0;
+    for (uint32_t channel = 1; channel < 4; ++channel)
+    {
+        if (covariance[channel][channel] > covariance[widest][widest])
+            widest = channel;
+    }
+
+    std::array<float, 4> axis {};
+    for (uint32_t iteration = 0; iteration < 8; ++iteration)
+    {
+        std::array<float, 4> next = covariance[widest];
+        if (iteration > 0)
+        {
+            next = {};
+            for (uint32_t row = 0; row < 4; ++row)
+            {
+                for (uint32_t column = 0; column < 4; ++column)
+                    next[row] += covariance[row][column] * axis[column];
+            }
+        }
+
+        const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+        if (length < 1e-6f)
+            break;
+
+        for (uint32_t channel = 0; channel < 4; ++channel)
+            axis[channel] = next[channel] / length;
+    }
+
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    for (const auto& pixel : pixels)
+    {
+        float projection = 0.0f;
+        for (uint32_t channel = 0; channel < 4; ++channel)
+            projection += (pixel[channel] - mean[channel]) * axis[channel];
+
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+
+    std::array<float, 4> endpoint0 {};
+    std::array<float, 4> endpoint1 {};
+    for (uint32_t channel = 0; channel < 4; ++channel)
+    {
+        endpoint0[channel] = mean[channel] + axis[channel] * minProjection;
+        endpoint1[channel] = mean[channel] + axis[channel] * maxProjection;
+    }
+
+    return { endpoint0, endpoint1 };
+}
+
+// Moves the endpoints to the least squares fit for the chosen indices, returns false when the indices don't span a range
+bool RefitBC7Endpoints(const PixelBlock& pixels, const std::array<uint32_t, PIXELS_PER_BLOCK>& indices, std::array<float, 4>& endpoint0, std::array<float, 4>& endpoint1)
+{
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    std::array<float, 4> ax {};
+    std::array<float, 4> bx {};
+
+    for (uint32_t pixel = 0; pixel < PIXELS_PER_BLOCK; ++pixel)
+    {
+        const float weight = BC7_WEIGHTS[indices[pixel]] / 64.0f;
+        aa += (1.0f - weight) * (1.0f - weight);
+        ab += (1.0f - weight) * weight;
+        bb += weight * weight;
+
+        for (uint32_t channel = 0; channel < 4; ++channel)
+        {
+            ax[channel] += (1.0f - weight) * pixels[pixel][channel];
+            bx[channel] += weight * pixels[pixel][channel];
+        }
+    }
+
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f)
+        return false;
+
+    for (uint32_t channel = 0; channel < 4; ++channel)
+    {
+        endpoint0[channel] = (bb * ax[channel] - ab * bx[channel]) / determinant;
+        endpoint1[channel] = (aa * bx[channel] - ab * ax[channel]) / determinant;
+    }
+
+    return true;
+}
+
+void DecodeBC4Into(const HalfBlock& block, std::array<uint8_t, PIXELS_PER_BLOCK>& values)
+{
+    HalfBlock bytes = block;
+    BlockBits bits { bytes };
+
+    const auto red0 = static_cast<uint8_t>(bits.Read(8));
+    const auto red1 = static_cast<uint8_t>(bits.Read(8));
+    const std::array<uint8_t, BC4_PALETTE_SIZE> palette = MakeBC4Palette(red0, red1);
+
+    for (uint32_t pixel = 0; pixel < PIXELS_PER_BLOCK; ++pixel)
+        values[pixel] = palette[bits.Read(3)];
+}
+
+// Gathers a block from an RGBA8 level, blocks over the edge of the level repeat the last row and column
+PixelBlock GatherBlock(std::span<const std::byte> level, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY)
+{
+    PixelBlock pixels {};
+
+    for (uint32_t y = 0; y < BLOCK_DIMENSION; ++y)
+    {
+        for (uint32_t x = 0; x < BLOCK_DIMENSION; ++x)
+        {
+            const uint32_t sourceX = std::min(blockX * BLOCK_DIMENSION + x, width - 1);
+            const uint32_t sourceY = std::min(blockY * BLOCK_DIMENSION + y, height - 1);
+            std::memcpy(pixels[y * BLOCK_DIMENSION + x].data(), level.data() + (sourceY * width + sourceX) * RGBA8_SIZE, RGBA8_SIZE);
+        }
+    }
+
+    return pixels;
+}
+
+std::array<uint8_t, PIXELS_PER_BLOCK> GatherChannel(const PixelBlock& pixels, uint32_t channel)
+{
+    std::array<uint8_t, PIXELS_PER_BLOCK> values {};
+    for (uint32_t pixel = 0; pixel < PIXELS_PER_BLOCK; ++pixel)
+        values[pixel] = pixels[pixel][channel];
+
+    return values;
+}
+
+}
+
+vk::Format TextureCompression::GetVkFormat(BlockFormat format)
+{
+    switch (format)
+    {
+    case BlockFormat::eBC4:
+        return vk::Format::eBc4UnormBlock;
+    case BlockFormat::eBC5:
+        return vk::Format::eBc5UnormBlock;
+    case BlockFormat::eBC7:
+        return vk::Format::eBc7UnormBlock;
+    default:
+        throw std::runtime_error("Unsupported block format!");
+    }
+}
+
+uint32_t TextureCompression::GetBlockByteSize(vk::Format format)
+{
+    switch (format)
+    {
+    case vk::Format::eR8Unorm:
+        return 1;
+    case vk::Format::eR8G8B8A8Unorm:
+    case vk::Format::eR8G8B8A8Srgb:
+        return RGBA8_SIZE;
+    case vk::Format::eBc4UnormBlock:
+        return sizeof(HalfBlock);
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+        return sizeof(Block);
+    default:
+        return 0;
+    }
+}
+
+uint32_t TextureCompression::GetBlockDimension(vk::Format format)
+{
+    switch (format)
+    {
+    case vk::Format::eBc4UnormBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+        return BLOCK_DIMENSION;
+    default:
+        return 1;
+    }
+}
+
+size_t TextureCompression::GetMipSize(vk::Format format, uint32_t width, uint32_t height, uint32_t mip)
+{
+    const uint32_t dimension = GetBlockDimension(format);
+    const size_t blocksX = (std::max(width >> mip, 1u) + dimension - 1) / dimension;
+    const size_t blocksY = (std::max(height >> mip, 1u) + dimension - 1) / dimension;
+
+    return blocksX * blocksY * GetBlockByteSize(format);
+}
+
+size_t TextureCompression::GetMipChainSize(vk::Format format, uint32_t width, uint32_t height, uint32_t mipCount)
+{
+    size_t size = 0;
+    for (uint32_t mip = 0; mip < mipCount; ++mip)
+        size += GetMipSize(format, width, height, mip);
+
+    return size;
+}
+
+uint32_t TextureCompression::GetFullMipCount(uint32_t width, uint32_t height)
+{
+    uint32_t count = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+        ++count;
+
+    return count;
+}
+
+void TextureCompression::GenerateMipChain(CPUImage& image, bool isNormalMap)
+{
+    ZoneScoped;
+
+    const size_t baseSize = GetMipSize(image.format, image.width, image.height, 0);
+    if (GetBlockByteSize(image.format) != RGBA8_SIZE || image.initialData.size() < baseSize)
+        throw std::runtime_error("Mip chains can only be generated for RGBA8 images!");
+
+    const uint32_t mipCount = GetFullMipCount(image.width, image.height);
+
+    std::vector<std::byte> chain(GetMipChainSize(image.format, image.width, image.height, mipCount));
+    std::memcpy(chain.data(), image.initialData.data(), baseSize);
+
+    size_t sourceOffset = 0;
+    size_t destinationOffset = baseSize;
+
+    for (uint32_t mip = 1; mip < mipCount; ++mip)
+    {
+        const uint32_t sourceWidth = std::max(image.width >> (mip - 1), 1);
+        const uint32_t sourceHeight = std::max(image.height >> (mip - 1), 1);
+        const uint32_t width = std::max(image.width >> mip, 1);
+        const uint32_t height = std::max(image.height >> mip, 1);
+
+        const auto* source = reinterpret_cast<const uint8_t*>(chain.data() + sourceOffset);
+        auto* destination = reinterpret_cast<uint8_t*>(chain.data() + destinationOffset);
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                // Odd sizes repeat the last row and column of the larger level
+                const uint32_t x0 = std::min(x * 2, sourceWidth - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, sourceWidth - 1);
+                const uint32_t y0 = std::min(y * 2, sourceHeight - 1);
+                const uint32_t y1 = std::min(y * 2 + 1, sourceHeight - 1);
+
+                uint8_t* pixel = destination + (y * width + x) * RGBA8_SIZE;
+
+                for (uint32_t channel = 0; channel < RGBA8_SIZE; ++channel)
+                {
+                    const uint32_t sum = source[(y0 * sourceWidth + x0) * RGBA8_SIZE + channel]
+                        + source[(y0 * sourceWidth + x1) * RGBA8_SIZE + channel]
+                        + source[(y1 * sourceWidth + x0) * RGBA8_SIZE + channel]
+                        + source[(y1 * sourceWidth + x1) * RGBA8_SIZE + channel];
+
+                    pixel[channel] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+
+                if (isNormalMap)
+                {
+                    glm::vec3 normal = glm::vec3 { pixel[0], pixel[1], pixel[2] } / 255.0f * 2.0f - 1.0f;
+                    if (glm::length(normal) > 1e-4f)
+                        normal = glm::normalize(normal);
+
+                    for (uint32_t channel = 0; channel < 3; ++channel)
+                        pixel[channel] = static_cast<uint8_t>(std::round(std::clamp(normal[channel] * 0.5f + 0.5f, 0.0f, 1.0f) * 255.0f));
+                }
+            }
+        }
+
+        sourceOffset = destinationOffset;
+        destinationOffset += GetMipSize(image.format, image.width, image.height, mip);
+    }
+
+    image.initialData = std::move(chain);
+    image.mips = static_cast<uint8_t>(mipCount);
+}
+
+HalfBlock TextureCompression::EncodeBC4(const std::array<uint8_t, PIXELS_PER_BLOCK>& values)
+{
+    const auto [minimum, maximum] = std::minmax_element(values.begin(), values.end());
+
+    // With the largest value first all 8 entries of the palette are spread between the two, a flat block uses the first entry only
+    const std::array<uint8_t, BC4_PALETTE_SIZE> palette = MakeBC4Palette(*maximum, *minimum);
+
+    HalfBlock block {};
+    BlockBits bits { block };
+    bits.Write(*maximum, 8);
+    bits.Write(*minimum, 8);
+
+    for (uint8_t value : values)
+    {
+        uint32_t bestIndex = 0;
+        for (uint32_t index = 1; index < BC4_PALETTE_SIZE; ++index)
+        {
+            if (std::abs(palette[index] - value) < std::abs(palette[bestIndex] - value))
+                bestIndex = index;
+        }
+
+        bits.Write(bestIndex, 3);
+    }
+
+    return block;
+}
+
+Block TextureCompression::EncodeBC5(const std::array<uint8_t, PIXELS_PER_BLOCK>& red, const std::array<uint8_t, PIXELS_PER_BLOCK>& green)
+{
+    const HalfBlock redBlock = EncodeBC4(red);
+    const HalfBlock greenBlock = EncodeBC4(green);
+
+    Block block {};
+    std::memcpy(block.data(), redBlock.data(), redBlock.size());
+    std::memcpy(block.data() + redBlock.size(), greenBlock.data(), greenBlock.size());
+    return block;
+}
+
+Block TextureCompression::EncodeBC7(const PixelBlock& pixels)
+{
+    const bool opaque = std::all_of(pixels.begin(), pixels.end(), [](const auto& pixel)
+        { return pixel[3] == 255; });
+
+    auto [color0, color1] = FindBC7Endpoints(pixels);
+
+    BC7Endpoint endpoint0 = QuantizeBC7Endpoint(color0, opaque);
+    BC7Endpoint endpoint1 = QuantizeBC7Endpoint(color1, opaque);
+    std::array<uint32_t, PIXELS_PER_BLOCK> indices {};
+    uint32_t error = AssignBC7Indices(pixels, endpoint0, endpoint1, indices);
+
+    for (uint32_t pass = 0; pass < BC7_LEAST_SQUARES_PASSES && error > 0; ++pass)
+    {
+        if (!RefitBC7Endpoints(pixels, indices, color0, color1))
+            break;
+
+        const BC7Endpoint refit0 = QuantizeBC7Endpoint(color0, opaque);
+        const BC7Endpoint refit1 = QuantizeBC7Endpoint(color1, opaque);
+        std::array<uint32_t, PIXELS_PER_BLOCK> refitIndices {};
+        const uint32_t refitError = AssignBC7Indices(pixels, refit0, refit1, refitIndices);
+
+        if (refitError >= error)
+            break;
+
+        endpoint0 = refit0;
+        endpoint1 = refit1;
+        indices = refitIndices;
+        error = refitError;
+    }
+
+    // The highest bit of the first index is implied to be zero, flipping the endpoints flips the indices
+    if (indices[0] >= BC7_INDEX_COUNT / 2)
+    {
+        std::swap(endpoint0, endpoint1);
+        for (uint32_t& index : indices)
+            index = BC7_INDEX_COUNT - 1 - index;
+    }
+
+    Block block {};
+    BlockBits bits { block };
+    bits.Write(1u << 6, 7);
+
+    for (uint32_t channel = 0; channel < 4; ++channel)
+    {
+        bits.Write(endpoint0.channels[channel], 7);
+        bits.Write(endpoint1.channels[channel], 7);
+    }
+
+    bits.Write(endpoint0.pBit, 1);
+    bits.Write(endpoint1.pBit, 1);
+
+    bits.Write(indices[0], 3);
+    for (uint32_t pixel = 1; pixel < PIXELS_PER_BLOCK; ++pixel)
+        bits.Write(indices[pixel], 4);
+
+    return block;
+}
+
+std::array<uint8_t, PIXELS_PER_BLOCK> TextureCompression::DecodeBC4(const HalfBlock& block)
+{
+    std::array<uint8_t, PIXELS_PER_BLOCK> values {};
+    DecodeBC4Into(block, values);
+    return values;
+}
+
+PixelBlock TextureCompression::DecodeBC5(const Block& block)
+{
+    HalfBlock redBlock {};
+    HalfBlock greenBlock {};
+    std::memcpy(redBlock.data(), block.data(), redBlock.size());
+    std::memcpy(greenBlock.data(), block.data() + redBlock.size(), greenBlock.size());
+
+    const std::array<uint8_t, PIXELS_PER_BLOCK> red = DecodeBC4(redBlock);
+    const std::array<uint8_t, PIXELS_PER_BLOCK> green = DecodeBC4(greenBlock);
+
+    PixelBlock pixels {};
+    for (uint32_t pixel = 0; pixel < PIXELS_PER_BLOCK; ++pixel)
+        pixels[pixel] = { red[pixel], green[pixel], 0, 255 };
+
+    return pixels;
+}
+
+bool TextureCompression::DecodeBC7(const Block& block, PixelBlock& pixels)
+{
+    Block bytes = block;
+    BlockBits bits { bytes };
+
+    if (bits.Read(7) != 1u << 6)
+        return false;
+
+    BC7Endpoint endpoint0 {};
+    BC7Endpoint endpoint1 {};
+
+    for (uint32_t channel = 0; channel < 4; ++channel)
+    {
+        endpoint0.channels[channel] = static_cast<uint8_t>(bits.Read(7));
+        endpoint1.channels[channel] = static_cast<uint8_t>(bits.Read(7));
+    }
+
+    endpoint0.pBit = static_cast<uint8_t>(bits.Read(1));
+    endpoint1.pBit = static_cast<uint8_t>(bits.Read(1));
+
+    for (uint32_t pixel = 0; pixel < PIXELS_PER_BLOCK; ++pixel)
+    {
+        const uint32_t index = bits.Read(pixel == 0 ? 3 : 4);
+
+        for (uint32_t channel = 0; channel < 4; ++channel)
+            pixels[pixel][channel] = InterpolateBC7(endpoint0.Expand(channel), endpoint1.Expand(channel), index);
+    }
+
+    return true;
+}
+
+void TextureCompression::Compress(CPUImage& image, BlockFormat format, bool isNormalMap)
+{
+    ZoneScoped;
+
+    if (image.format != vk::Format::eR8G8B8A8Unorm)
+        throw std::runtime_error("Only RGBA8 images can be compressed!");
+
+    if (!image.HasMipChain() || image.mips < GetFullMipCount(image.width, image.height))
+        GenerateMipChain(image, isNormalMap);
+
+    const vk::Format compressedFormat = GetVkFormat(format);
+
+    std::vector<std::byte> compressed {};
+    compressed.reserve(GetMipChainSize(compressedFormat, image.width, image.height, image.mips));
+
+    size_t levelOffset = 0;
+
+    for (uint32_t mip = 0; mip < image.mips; ++mip)
+    {
+        const uint32_t width = std::max(image.width >> mip, 1);
+        const uint32_t height = std::max(image.height >> mip, 1);
+        const size_t levelSize = GetMipSize(image.format, image.width, image.height, mip);
+        const std::span<const std::byte> level { image.initialData.data() + levelOffset, levelSize };
+
+        for (uint32_t blockY = 0; blockY < (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION; ++blockY)
+        {
+            for (uint32_t blockX = 0; blockX < (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION; ++blockX)
+            {
+                const PixelBlock pixels = GatherBlock(level, width, height, blockX, blockY);
+
+                switch (format)
+                {
+                case BlockFormat::eBC4:
+                {
+                    const HalfBlock block = EncodeBC4(GatherChannel(pixels, 0));
+                    compressed.insert(compressed.end(), block.begin(), block.end());
+                    break;
+                }
+                case BlockFormat::eBC5:
+                {
+                    const Block block = EncodeBC5(GatherChannel(pixels, 0), GatherChannel(pixels, 1));
+                    compressed.insert(compressed.end(), block.begin(), block.end());
+                    break;
+                }
+                case BlockFormat::eBC7:
+                {
+                    const Block block = EncodeBC7(pixels);
+                    compressed.insert(compressed.end(), block.begin(), block.end());
+                    break;
+                }
+                }
+            }
+        }
+
+        levelOffset += levelSize;
+    }
+
+    image.initialData = std::move(compressed);
+    image.format = compressedFormat;
+}
+
+std::vector<std::byte> TextureCompression::Decompress(const CPUImage& image)
+{
+    if (GetBlockDimension(image.format) == 1)
+        return image.initialData;
+
+    if (!image.HasMipChain())
+        throw std::runtime_error("Compressed image does not have a complete mip chain!");
+
+    std::vector<std::byte> pixels(GetMipChainSize(vk::Format::eR8G8B8A8Unorm, image.width, image.height, image.mips));
+
+    size_t sourceOffset = 0;
+    size_t destinationOffset = 0;
+
+    for (uint32_t mip = 0; mip < image.mips; ++mip)
+    {
+        const uint32_t width = std::max(image.width >> mip, 1);
+        const uint32_t height = std::max(image.height >> mip, 1);
+
+        for (uint32_t blockY = 0; blockY < (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION; ++blockY)
+        {
+            for (uint32_t blockX = 0; blockX < (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION; ++blockX)
+            {
+                PixelBlock decoded {};
+
+                if (image.format == vk::Format::eBc4UnormBlock)
+                {
+                    HalfBlock block {};
+                    std::memcpy(block.data(), image.initialData.data() + sourceOffset, block.size());
+                    sourceOffset += block.size();
+
+                    const std::array<uint8_t, PIXELS_PER_BLOCK> red = DecodeBC4(block);
+                    for (uint32_t pixel = 0; pixel < PIXELS_PER_BLOCK; ++pixel)
+                        decoded[pixel] = { red[pixel], 0, 0, 255 };
+                }
+                else
+                {
+                    Block block {};
+                    std::memcpy(block.data(), image.initialData.data() + sourceOffset, block.size());
+                    sourceOffset += block.size();
+
+                    if (image.format == vk::Format::eBc5UnormBlock)
+                        decoded = DecodeBC5(block);
+                    else if (!DecodeBC7(block, decoded))
+                        throw std::runtime_error("Only BC7 blocks in mode 6 can be decoded!");
+                }
+
+                for (uint32_t y = 0; y < BLOCK_DIMENSION && blockY * BLOCK_DIMENSION + y < height; ++y)
+                {
+                    for (uint32_t x = 0; x < BLOCK_DIMENSION && blockX * BLOCK_DIMENSION + x < width; ++x)
+                    {
+                        const size_t offset = destinationOffset + ((blockY * BLOCK_DIMENSION + y) * width + blockX * BLOCK_DIMENSION + x) * RGBA8_SIZE;
+                        std::memcpy(pixels.data() + offset, decoded[y * BLOCK_DIMENSION + x].data(), RGBA8_SIZE);
+                    }
+                }
+            }
+        }
+
+        destinationOffset += static_cast<size_t>(width) * height * RGBA8_SIZE;
+    }
+
+    return pixels;
+}
+
+std::vector<BlockFormat> TextureCompression::ChooseFormats(const CPUModel& model)
+{
+    enum Usage : uint32_t
+    {
+        eColor = 1 << 0,
+        eNormal = 1 << 1,
+        eOcclusion = 1 << 2,
+    };
+
+    std::vector<uint32_t> usages(model.textures.size(), 0);
+
+    auto markUsage = [&usages](std::optional<CPUMaterial::TextureIndex> index, Usage usage)
+    {
+        if (index.has_value() && index.value() < usages.size())
+            usages[index.value()] |= usage;
+    };
+
+    for (const auto& material : model.materials)
+    {
+        markUsage(material.albedoMap, eColor);
+        markUsage(material.metallicRoughnessMap, eColor);
+        markUsage(material.emissiveMap, eColor);
+        markUsage(material.normalMap, eNormal);
+        markUsage(material.occlusionMap, eOcclusion);
+    }
+
+    std::vector<BlockFormat> formats(model.textures.size(), BlockFormat::eBC7);
+    for (size_t i = 0; i < usages.size(); ++i)
+    {
+        if (usages[i] == eNormal)
+            formats[i] = BlockFormat::eBC5;
+        else if (usages[i] == eOcclusion)
+            formats[i] = BlockFormat::eBC4;
+    }
+
+    return formats;
+}
+
+void TextureCompression::CompressModelTextures(CPUModel& model)
+{
+    ZoneScoped;
+
+    const std::vector<BlockFormat> formats = ChooseFormats(model);
+
+    for (size_t i = 0; i < model.textures.size(); ++i)
+    {
+        // Textures that are already compressed are left alone, so cooking twice does not compress twice
+        if (model.textures[i].format == vk::Format::eR8G8B8A8Unorm)
+            Compress(model.textures[i], formats[i], formats[i] == BlockFormat::eBC5);
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "common.hpp"
+#include "cpu_resources.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Binary form of a CPUModel as it comes out of the glTF loader: vertices and indices in their final layout with the normals
+// and tangents already generated, textures in KTX2 containers, materials, the hierarchy with its skeleton, the animations and the bounds.
+// Written next to the glTF by the ModelCooker tool, which block compresses the textures with their mips first, the model loader prefers it over parsing the glTF.
+// Colliders are not stored, they are restored from the shape cache when the model is loaded with collision.
+class CookedModel
+{
+public:
+    using Key = uint64_t;
+
+    // Bump this whenever the layout of the file or the processing done by the glTF loader changes, all files written with an older version are ignored
+    constexpr static uint32_t COOK_VERSION = 4;
+    constexpr static std::string_view EXTENSION = ".cmodel";
+
+    // Identifies the version of a source file by its size and last write time, returns nullopt when it doesn't exist.
+    // The path is left out, so it doesn't matter how the cooker and the loader spell it
+    NO_DISCARD static std::optional<Key> MakeSourceKey(std::string_view source);
+
+    // The cooked file is placed next to the source, with the extension replaced
+    NO_DISCARD static std::string GetCookedPath(std::string_view source);
+
+    // Without a source key the key stored in the file is not checked, which is what happens for sources that can't be found
+    NO_DISCARD static std::vector<std::byte> Serialize(const CPUModel& model, Key sourceKey);
+    NO_DISCARD static std::optional<CPUModel> Deserialize(std::span<const std::byte> bytes, std::optional<Key> sourceKey);
+
+    static bool Save(const CPUModel& model, const std::filesystem::path& path, Key sourceKey);
+
+    // Reads through the virtual filesystem with a single read, so cooked models also load from the game archive
+    NO_DISCARD static std::optional<CPUModel> Load(std::string_view path, std::optional<Key> sourceKey);
+
+private:
+    // Everything that is used to index another array is checked, so a corrupt file is rejected instead of reading out of bounds later
+    NO_DISCARD static bool IsValid(const CPUModel& model);
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// On disk cache for data that is expensive to derive from source assets, like generated tangents, cooked colliders or font atlases.
+// Blobs are keyed by the hash of their source content, the version of the processor that produced them and a hash of its parameters,
+// so changing any of them simply misses and the outdated blob ages out.
+// Writes go through a temporary file, so readers and other processes never see a half written blob, and the least recently used
+// blobs are evicted once the cache grows beyond its size limit. Safe to use from multiple threads.
+class DerivedDataCache
+{
+public:
+    using Hash = uint64_t;
+
+    constexpr static std::string_view DEFAULT_DIRECTORY = "cache/derived";
+    constexpr static uint64_t DEFAULT_MAX_SIZE = 1024ull * 1024ull * 1024ull;
+
+    struct Key
+    {
+        // Name of the processor, used as the directory its blobs are stored in, so it should be a valid file name
+        std::string processor {};
+        // Bump this whenever the output of the processor changes
+        uint32_t version = 0;
+        Hash source = 0;
+        Hash parameters = 0;
+    };
+
+    struct Stats
+    {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t corrupt = 0;
+        uint32_t writes = 0;
+        uint32_t evictions = 0;
+    };
+
+    explicit DerivedDataCache(const std::filesystem::path& directory = DEFAULT_DIRECTORY, uint64_t maxSize = DEFAULT_MAX_SIZE);
+
+    // Hashes the content of a source file through the virtual filesystem, returns nullopt when it can't be read
+    NO_DISCARD static std::optional<Hash> HashSourceFile(std::string_view path);
+
+    // Returns nullopt when the blob is not cached, corrupt blobs are deleted and count as a miss
+    NO_DISCARD std::optional<std::vector<std::byte>> Load(const Key& key);
+    bool Store(const Key& key, std::span<const std::byte> data);
+
+    // Returns the cached blob, or builds and stores it when it is not cached yet.
+    // Building happens outside of any lock, two threads missing on the same key both build it and the last write wins.
+    template <typename BuildFunction>
+    std::vector<std::byte> LoadOrBuild(const Key& key, BuildFunction&& build)
+    {
+        if (std::optional<std::vector<std::byte>> cached = Load(key))
+            return std::move(cached.value());
+
+        std::vector<std::byte> data = build();
+        Store(key, data);
+
+        return data;
+    }
+
+    NO_DISCARD std::filesystem::path GetFilePath(const Key& key) const;
+    NO_DISCARD uint64_t GetMaxSize() const { return _maxSize; }
+
+    NO_DISCARD Stats GetStats() const;
+    void ResetStats();
+
+private:
+    NO_DISCARD static Hash HashKey(const Key& key);
+
+    // Deletes the least recently used blobs until the cache fits its size limit again, the blob that was just written is kept.
+    // Expects the mutex to be held.
+    void Evict(const std::filesystem::path& keep);
+
+    std::filesystem::path _directory;
+    uint64_t _maxSize;
+
+    mutable std::mutex _mutex;
+    // Estimate of the size on disk, Evict() measures the directory again since other processes can write to it as well
+    std::optional<uint64_t> _size {};
+    Stats _stats {};
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "common.hpp"
+#include "resources/image.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Reads and writes KTX2 containers for the textures made by the asset pipeline: 2D images with one layer and no supercompression,
+// either RGBA8 or BC4, BC5 or BC7 with their mips. This is the subset of the format that TextureCompression produces, not a full reader.
+// A level count of zero means the file only holds the first level and the mips are generated when the image is uploaded.
+namespace KTX2
+{
+// Returns nullopt for images that can't be stored, like cube maps, HDR images or data that doesn't match the size and mips
+NO_DISCARD std::optional<std::vector<std::byte>> Serialize(const CPUImage& image);
+
+// Every offset and size in the file is checked against the data, so a corrupt file is rejected instead of read out of bounds
+NO_DISCARD std::optional<CPUImage> Deserialize(std::span<const std::byte> bytes);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "common.hpp"
+#include "cpu_resources.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Prepares meshes for the GPU after they are read from the glTF: exporters often write every corner of a triangle as its own vertex
+// and keep the triangles in an arbitrary order, which makes the vertex shader run more often than it needs to.
+namespace MeshOptimization
+{
+// Post transform caches on current GPUs behave roughly like a FIFO of this many vertices
+constexpr uint32_t DEFAULT_CACHE_SIZE = 16;
+
+struct VertexCacheStatistics
+{
+    uint32_t transformedVertices = 0;
+    float acmr = 0.0f; // Average cache miss ratio, transformed vertices per triangle, 0.5 is the best a large grid can do
+    float atvr = 0.0f; // Average transformed vertex ratio, transformed vertices per vertex, 1.0 is the best possible
+};
+
+// Simulates a FIFO cache over the index buffer
+NO_DISCARD VertexCacheStatistics AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+// Merges vertices with exactly the same bytes, the index buffer is updated to point at the remaining ones
+template <typename T>
+void DeduplicateVertices(CPUMesh<T>& mesh);
+
+// Reorders the triangles so vertices are reused while they are still in the cache, with Tom Forsyth's linear speed vertex cache optimization.
+// The winding of every triangle is kept.
+void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+// Reorders the vertices in the order the index buffer first uses them, so the vertex fetch reads memory mostly front to back.
+// Vertices no triangle uses are dropped.
+template <typename T>
+void OptimizeVertexFetch(CPUMesh<T>& mesh);
+
+// All of the above, in the order that gives the best result
+template <typename T>
+void Optimize(CPUMesh<T>& mesh);
+}
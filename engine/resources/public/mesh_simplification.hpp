@@ -0,0 +1,37 @@
+#pragma once
+
+#include "common.hpp"
+#include "cpu_resources.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Generates the LODs of a mesh when its model is cooked. Edges are collapsed in the order of their quadric error (Garland and Heckbert),
+// always onto one of their own vertices, so every LOD is just another index buffer over the vertices of the full detail mesh.
+// Vertices on the border of the mesh and on attribute seams, where vertices share a position but not the rest, are never moved.
+namespace MeshSimplification
+{
+// Simplified levels generated for a mesh, on top of the full detail one
+constexpr uint32_t MAX_LODS = 3;
+// Every level aims for this fraction of the triangles of the level before it
+constexpr float LOD_TRIANGLE_RATIO = 0.5f;
+// Levels stop once they would be further than this from the full detail surface, relative to the bounding radius of the mesh
+constexpr float MAX_LOD_ERROR = 0.05f;
+
+struct Result
+{
+    std::vector<uint32_t> indices;
+    // Upper bound of the distance between a moved vertex and the planes of the triangles it was collapsed over, in the space of the mesh
+    float error = 0.0f;
+};
+
+// Collapses edges until there are no more than targetIndexCount indices left or the next collapse would have a larger error than targetError
+template <typename T>
+NO_DISCARD Result Simplify(const CPUMesh<T>& mesh, size_t targetIndexCount, float targetError = std::numeric_limits<float>::max());
+
+// Fills the LODs of the mesh, each one simplified from the full detail mesh and ordered for the vertex cache.
+// Stops early when a level would barely remove any triangles or go over MAX_LOD_ERROR.
+template <typename T>
+void GenerateLODs(CPUMesh<T>& mesh);
+}
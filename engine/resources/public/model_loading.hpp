@@ -11,4 +11,11 @@ namespace ModelLoading
 // Loads a GLTF model from the given path to the file.
 NO_DISCARD CPUModel LoadGLTF(std::string_view path);
 NO_DISCARD CPUModel LoadGLTFFast(ThreadPool& scheduler, std::string_view path, bool genCollision);
+
+// Builds a collider for every static mesh, in the same order as the meshes, like LoadGLTFFast does when generating collision.
+void GenerateColliders(CPUModel& model);
+
+// Simplifies every mesh into its LODs, which is too slow to do on every load, so only the model cooker does it.
+// Models loaded straight from glTF only have their full detail mesh, cooked models come with the stored LODs.
+void GenerateLODs(ThreadPool& scheduler, CPUModel& model);
 }
@@ -6,6 +6,7 @@
 #include "resource_manager.hpp"
 #include "single_time_commands.hpp"
 #include "vertex.hpp"
+#include "vertex_quantization.hpp"
 #include "vulkan_context.hpp"
 
 #include <glm/glm.hpp>
@@ -58,11 +59,31 @@ private:
         gpuMesh.material = material;
         gpuMesh.count = cpuMesh.indices.empty() ? cpuMesh.vertices.size() : cpuMesh.indices.size();
 
-        gpuMesh.vertexOffset = batchBuffer.AppendVertices(cpuMesh.vertices, uploadCommands);
+        if constexpr (USE_PACKED_VERTICES)
+        {
+            const VertexQuantization::PositionBounds bounds = VertexQuantization::MakePositionBounds(cpuMesh.boundingBox);
+            gpuMesh.vertexOffset = batchBuffer.AppendVertices(VertexQuantization::Quantize(cpuMesh.vertices, bounds), uploadCommands);
+            gpuMesh.positionOffset = bounds.offset;
+            gpuMesh.positionScale = bounds.scale;
+        }
+        else
+        {
+            gpuMesh.vertexOffset = batchBuffer.AppendVertices(cpuMesh.vertices, uploadCommands);
+        }
+
         if (!cpuMesh.indices.empty())
         {
             gpuMesh.indexOffset = batchBuffer.AppendIndices(cpuMesh.indices, uploadCommands);
         }
+
+        for (const auto& lod : cpuMesh.lods)
+        {
+            gpuMesh.lods.emplace_back(GPUMeshLOD {
+                .count = static_cast<uint32_t>(lod.indices.size()),
+                .indexOffset = batchBuffer.AppendIndices(lod.indices, uploadCommands),
+                .error = lod.error,
+            });
+        }
         gpuMesh.boundingRadius = cpuMesh.boundingRadius;
         gpuMesh.boundingBox = cpuMesh.boundingBox;
 
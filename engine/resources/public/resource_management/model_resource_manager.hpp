@@ -19,6 +19,9 @@ public:
 
     ResourceHandle<GPUModel> Create(const CPUModel& data, BatchBuffer& staticBatchBuffer, BatchBuffer& skinnedBatchBuffer);
 
+    // A model owns the meshes, materials and textures it was created with, they are destroyed along with it
+    void Destroy(const ResourceHandle<GPUModel>& handle) override;
+
     ModelResourceManager() = default;
 
 private:
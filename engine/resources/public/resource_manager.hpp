@@ -1,17 +1,16 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <unordered_map>
 #include <vector>
 
 #include "common.hpp"
+#include "constants.hpp"
 #include "log.hpp"
 
-template <typename T>
-struct ResourceHandle;
-
 template <typename T>
 class ResourceManager;
 
@@ -19,49 +18,57 @@ template <typename T>
 struct ResourceSlot
 {
     std::optional<T> resource { std::nullopt };
-    uint8_t version { 0 };
-    uint32_t referenceCount { 0 };
+    uint32_t generation { 0 };
 };
 
-constexpr uint32_t RESOURCE_NULL_INDEX_VALUE = 0xFFFF;
+constexpr uint32_t RESOURCE_NULL_INDEX_VALUE = std::numeric_limits<uint32_t>::max();
 
+// Refers to a resource by the slot it lives in and the generation of that slot. Handles don't own their resource,
+// so copying one costs no more than copying two integers, resources live until they are destroyed through their manager,
+// by whoever created them.
+// Destroying a resource bumps the generation of its slot, handles that still refer to it are then rejected instead of
+// resolving to the next resource that reuses the slot.
 template <typename T>
 struct ResourceHandle final
 {
-    ResourceHandle();
-
-    ResourceHandle(std::weak_ptr<ResourceManager<T>> owner, uint32_t index, uint8_t version);
-
-    ~ResourceHandle();
-    ResourceHandle(const ResourceHandle<T>& other);
-    ResourceHandle<T>& operator=(const ResourceHandle<T>& other);
-    ResourceHandle(ResourceHandle<T>&& other) noexcept;
-    ResourceHandle<T>& operator=(ResourceHandle<T>&& other) noexcept;
-    ResourceHandle<T>& operator=(std::nullptr_t);
+    ResourceHandle() = default;
 
     static ResourceHandle<T> Null()
     {
         return ResourceHandle<T> {};
     }
 
+    ResourceHandle<T>& operator=(std::nullptr_t)
+    {
+        *this = Null();
+        return *this;
+    }
+
+    bool operator==(const ResourceHandle<T>& other) const = default;
+
     uint32_t Index() const { return index; }
+    uint32_t Generation() const { return generation; }
     bool IsNull() const { return index == RESOURCE_NULL_INDEX_VALUE; }
 
 private:
-    friend class VulkanContext;
     friend ResourceManager<T>;
 
-    std::weak_ptr<ResourceManager<T>> manager;
-    uint32_t index { 0 };
-    uint32_t version { 0 };
+    ResourceHandle(uint32_t index, uint32_t generation)
+        : index(index)
+        , generation(generation)
+    {
+    }
+
+    uint32_t index { RESOURCE_NULL_INDEX_VALUE };
+    uint32_t generation { 0 };
 };
 
 template <typename T>
-class ResourceManager : public std::enable_shared_from_this<ResourceManager<T>>
+class ResourceManager
 {
 public:
     ResourceManager() = default;
-    virtual ~ResourceManager();
+    virtual ~ResourceManager() = default;
 
     ResourceHandle<T> Create(T&& resource)
     {
@@ -80,21 +87,17 @@ public:
         ResourceSlot<T>& slot = _resources[index];
         slot.resource = std::move(resource);
 
-        auto self_ptr = ResourceManager<T>::shared_from_this();
-        ResourceHandle<T> handle(self_ptr, index, slot.version);
-
-        return handle;
+        return ResourceHandle<T> { index, slot.generation };
     }
 
     const T* Access(const ResourceHandle<T>& handle) const
     {
-        uint32_t index = handle.index;
         if (!IsValid(handle))
         {
             return nullptr;
         }
 
-        return &_resources[index].resource.value();
+        return &_resources[handle.index].resource.value();
     }
 
     const T* Access(uint32_t index) const
@@ -107,21 +110,21 @@ public:
         return &_resources[index].resource.value();
     }
 
-    void Destroy(const ResourceHandle<T>& handle)
+    virtual void Destroy(const ResourceHandle<T>& handle)
     {
         uint32_t index = handle.index;
         if (IsValid(handle))
         {
             _freeList.emplace_back(index);
             _resources[index].resource = std::nullopt;
-            ++_resources[index].version;
+            ++_resources[index].generation;
         }
     }
 
     bool IsValid(const ResourceHandle<T>& handle) const
     {
         uint32_t index = handle.index;
-        return index < _resources.size() && _resources[index].version == handle.version && _resources[index].resource.has_value();
+        return index < _resources.size() && _resources[index].generation == handle.generation && _resources[index].resource.has_value();
     }
 
     bool IsValid(uint32_t index) const
@@ -129,14 +132,35 @@ public:
         return index < _resources.size() && _resources[index].resource.has_value();
     }
 
+    // Destroys the resource after Clean has been called MAX_FRAMES_IN_FLIGHT times, for resources that frames which are still
+    // being rendered might use. The handle stays valid until then.
+    void DestroyDeferred(const ResourceHandle<T>& handle)
+    {
+        if (IsValid(handle))
+        {
+            _bin.emplace_back(DeferredDestroy { handle, MAX_FRAMES_IN_FLIGHT });
+        }
+    }
+
+    // Called once for every frame that is submitted, after waiting for the oldest frame in flight
     void Clean()
     {
-        for (const auto& handle : _bin)
+        std::vector<ResourceHandle<T>> expired {};
+
+        std::erase_if(_bin, [&expired](DeferredDestroy& entry)
+            {
+                if (--entry.framesLeft > 0)
+                    return false;
+
+                expired.emplace_back(entry.handle);
+                return true;
+            });
+
+        // Kept out of erase_if, an overridden Destroy could queue more deferred destroys
+        for (const auto& handle : expired)
         {
             Destroy(handle);
         }
-
-        _bin.clear();
     }
 
     const std::vector<ResourceSlot<T>>& Resources() const { return _resources; }
@@ -144,150 +168,13 @@ public:
 protected:
     std::vector<ResourceSlot<T>> _resources;
     std::vector<uint32_t> _freeList;
-    std::vector<ResourceHandle<T>> _bin;
 
 private:
-    friend struct ResourceHandle<T>;
-
-    void IncrementReferenceCount(const ResourceHandle<T>& handle);
-    void DecrementReferenceCount(const ResourceHandle<T>& handle);
-};
-
-template <typename T>
-ResourceManager<T>::~ResourceManager()
-{
-}
-
-template <typename T>
-void ResourceManager<T>::IncrementReferenceCount(const ResourceHandle<T>& handle)
-{
-    if (handle.IsNull() || _resources[handle.index].version != handle.version)
-    {
-        return;
-    }
-
-    ++_resources[handle.index].referenceCount;
-}
-
-template <typename T>
-void ResourceManager<T>::DecrementReferenceCount(const ResourceHandle<T>& handle)
-{
-    if (handle.IsNull() || _resources[handle.index].version != handle.version)
-    {
-        return;
-    }
-
-    assert(_resources[handle.index].referenceCount != 0 && "Reference count can never be 0 before a decrement!");
-
-    --_resources[handle.index].referenceCount;
-
-    if (_resources[handle.index].referenceCount == 0)
-    {
-        _bin.emplace_back(handle);
-    }
-}
-
-template <typename T>
-ResourceHandle<T>::ResourceHandle()
-    : ResourceHandle({}, RESOURCE_NULL_INDEX_VALUE, 0)
-{
-}
-
-template <typename T>
-ResourceHandle<T>::ResourceHandle(std::weak_ptr<ResourceManager<T>> owner, uint32_t index, uint8_t version)
-    : manager(owner)
-    , index(index)
-    , version(version)
-{
-    if (auto mgr = manager.lock())
-    {
-        mgr->IncrementReferenceCount(*this);
-    }
-}
-
-template <typename T>
-ResourceHandle<T>::~ResourceHandle()
-{
-    if (auto mgr = manager.lock())
-    {
-        mgr->DecrementReferenceCount(*this);
-    }
-}
-
-template <typename T>
-ResourceHandle<T>::ResourceHandle(const ResourceHandle<T>& other)
-    : manager(other.manager)
-    , index(other.index)
-    , version(other.version)
-{
-    if (auto mgr = manager.lock())
-    {
-        mgr->IncrementReferenceCount(*this);
-    }
-}
-
-template <typename T>
-ResourceHandle<T>& ResourceHandle<T>::operator=(const ResourceHandle<T>& other)
-{
-    if (this == &other)
-    {
-        return *this;
-    }
-
-    if (auto mgr = manager.lock())
-    {
-        mgr->DecrementReferenceCount(*this);
-    }
-
-    index = other.index;
-    version = other.version;
-    manager = other.manager;
-
-    if (auto mgr = manager.lock())
-    {
-        mgr->IncrementReferenceCount(*this);
-    }
-
-    return *this;
-}
-
-template <typename T>
-ResourceHandle<T>::ResourceHandle(ResourceHandle<T>&& other) noexcept
-    : manager(other.manager)
-    , index(other.index)
-    , version(other.version)
-{
-    other = nullptr;
-}
-
-template <typename T>
-ResourceHandle<T>& ResourceHandle<T>::operator=(ResourceHandle<T>&& other) noexcept
-{
-    if (this == &other)
+    struct DeferredDestroy
     {
-        return *this;
-    }
-
-    if (auto mgr = manager.lock())
-    {
-        mgr->DecrementReferenceCount(*this);
-    }
-
-    index = other.index;
-    version = other.version;
-    manager = other.manager;
+        ResourceHandle<T> handle;
+        uint32_t framesLeft;
+    };
 
-    other = nullptr;
-
-    return *this;
-}
-
-template <typename T>
-ResourceHandle<T>& ResourceHandle<T>::operator=(std::nullptr_t)
-{
-    manager = {};
-    index = RESOURCE_NULL_INDEX_VALUE;
-    version = 0;
-
-    return *this;
-}
+    std::vector<DeferredDestroy> _bin;
+};
@@ -44,6 +44,10 @@ struct CPUImage
     CPUImage& SetFormat(vk::Format format);
     CPUImage& SetName(std::string_view name);
     CPUImage& SetType(ImageType type);
+
+    // True when the data holds all mips, the largest first, so they can be uploaded as they are instead of being generated on the GPU.
+    // Only 2D images with a single layer are stored with their mips.
+    NO_DISCARD bool HasMipChain() const;
 };
 
 struct GPUImage
@@ -11,6 +11,13 @@ enum class MeshType : uint8_t
     eSKINNED,
 };
 
+// Simplified version of a mesh, the indices point into the vertices of the full detail mesh
+struct MeshLOD
+{
+    std::vector<uint32_t> indices;
+    float error { 0.0f }; // How far the simplified surface may be from the full detail one, in the space of the mesh
+};
+
 template <typename T>
 struct CPUMesh
 {
@@ -20,6 +27,16 @@ struct CPUMesh
 
     math::Vec3Range boundingBox;
     float boundingRadius;
+
+    // From more to less detailed, see MeshSimplification
+    std::vector<MeshLOD> lods {};
+};
+
+struct GPUMeshLOD
+{
+    uint32_t count { 0 };
+    uint32_t indexOffset { 0 };
+    float error { 0.0f };
 };
 
 struct GPUMesh
@@ -30,6 +47,13 @@ struct GPUMesh
     float boundingRadius;
     math::Vec3Range boundingBox;
 
+    // Packed vertices store their position relative to these, see VertexQuantization
+    glm::vec3 positionOffset { 0.0f };
+    glm::vec3 positionScale { 1.0f };
+
+    // Share the vertices of the full detail mesh, see LODSelection
+    std::vector<GPUMeshLOD> lods {};
+
     MeshType type;
     ResourceHandle<GPUMaterial> material;
 };
\ No newline at end of file
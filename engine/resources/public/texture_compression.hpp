@@ -0,0 +1,66 @@
+#pragma once
+
+#include "common.hpp"
+#include "cpu_resources.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Offline block compression for the asset pipeline, textures are compressed once by the ModelCooker with their full mip chain,
+// so at runtime the mips are copied straight into the image instead of being decoded to RGBA8 and blitted on the GPU.
+// BC7 is written in mode 6 only, a single subset with RGBA endpoints and 4 bit indices. It is not the best possible encoding,
+// but it is fast, deterministic and keeps fully opaque blocks at an alpha of exactly 255, which the alpha test in the shaders relies on.
+namespace TextureCompression
+{
+enum class BlockFormat
+{
+    eBC4, // Single channel, occlusion
+    eBC5, // Two channels, tangent space normals with z reconstructed in the shader
+    eBC7, // RGBA, everything else
+};
+
+constexpr uint32_t BLOCK_DIMENSION = 4;
+constexpr uint32_t PIXELS_PER_BLOCK = BLOCK_DIMENSION * BLOCK_DIMENSION;
+
+using Block = std::array<std::byte, 16>;
+using HalfBlock = std::array<std::byte, 8>;
+using PixelBlock = std::array<std::array<uint8_t, 4>, PIXELS_PER_BLOCK>;
+
+NO_DISCARD vk::Format GetVkFormat(BlockFormat format);
+
+// Uncompressed and block compressed formats that can be stored with a mip chain, other formats return 0
+NO_DISCARD uint32_t GetBlockByteSize(vk::Format format);
+NO_DISCARD uint32_t GetBlockDimension(vk::Format format);
+
+// Size in bytes of a single mip level, levels of compressed formats are rounded up to whole blocks
+NO_DISCARD size_t GetMipSize(vk::Format format, uint32_t width, uint32_t height, uint32_t mip);
+NO_DISCARD size_t GetMipChainSize(vk::Format format, uint32_t width, uint32_t height, uint32_t mipCount);
+NO_DISCARD uint32_t GetFullMipCount(uint32_t width, uint32_t height);
+
+// Box filters an RGBA8 image down to 1x1 and stores all levels after each other, the largest first.
+// Normal maps are renormalized after every level, so the mips don't get shorter normals.
+void GenerateMipChain(CPUImage& image, bool isNormalMap = false);
+
+NO_DISCARD HalfBlock EncodeBC4(const std::array<uint8_t, PIXELS_PER_BLOCK>& values);
+NO_DISCARD Block EncodeBC5(const std::array<uint8_t, PIXELS_PER_BLOCK>& red, const std::array<uint8_t, PIXELS_PER_BLOCK>& green);
+NO_DISCARD Block EncodeBC7(const PixelBlock& pixels);
+
+// Decoders are only used to check the encoders, the GPU does the decoding at runtime.
+// DecodeBC7 returns false for blocks that are not written in mode 6.
+NO_DISCARD std::array<uint8_t, PIXELS_PER_BLOCK> DecodeBC4(const HalfBlock& block);
+NO_DISCARD PixelBlock DecodeBC5(const Block& block);
+NO_DISCARD bool DecodeBC7(const Block& block, PixelBlock& pixels);
+
+// Compresses an RGBA8 image, generating the mip chain first when it doesn't have one yet.
+// BC4 keeps the red channel, BC5 red and green.
+void Compress(CPUImage& image, BlockFormat format, bool isNormalMap = false);
+
+// Decodes all mips of a compressed image back to RGBA8, channels that are not stored come back as 0, with an alpha of 255
+NO_DISCARD std::vector<std::byte> Decompress(const CPUImage& image);
+
+// Picks a format for every texture from how the materials use it, textures that are shared between different uses go to BC7
+NO_DISCARD std::vector<BlockFormat> ChooseFormats(const CPUModel& model);
+void CompressModelTextures(CPUModel& model);
+}
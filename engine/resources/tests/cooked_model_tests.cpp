@@ -0,0 +1,254 @@
+#include "cooked_model.hpp"
+#include "file_io.hpp"
+#include "model_loading.hpp"
+#include "model_test_helpers.hpp"
+#include "texture_compression.hpp"
+#include "thread_pool.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace
+{
+
+constexpr CookedModel::Key SOURCE_KEY = 0x1234;
+
+// The model loader reads through the virtual filesystem, which is mounted at the working directory
+const std::filesystem::path TEST_DIRECTORY = "cache/tests/cooked_model";
+
+CPUModel MakeTexturedModel()
+{
+    CPUModel model {};
+    model.name = "Textured";
+
+    CPUImage& texture = model.textures.emplace_back();
+    texture.SetSize(2, 2).SetFormat(vk::Format::eR8G8B8A8Unorm).SetFlags(vk::ImageUsageFlagBits::eSampled).SetName("Checker").SetMips(2);
+    texture.SetData(std::vector<std::byte>(16, std::byte { 0x7F }));
+
+    CPUMaterial& material = model.materials.emplace_back();
+    material.albedoMap = 0;
+    material.albedoFactor = glm::vec4 { 1.0f, 0.5f, 0.25f, 1.0f };
+    material.emissiveFactor = glm::vec3 { 2.0f };
+
+    CPUMesh<Vertex>& mesh = model.meshes.emplace_back();
+    mesh.vertices = { Vertex { glm::vec3 { 0.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f } },
+        Vertex { glm::vec3 { 1.0f, 0.0f, 0.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 1.0f, 0.0f } },
+        Vertex { glm::vec3 { 0.0f, 0.0f, 1.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f, 1.0f } } };
+    mesh.indices = { 0, 1, 2 };
+    mesh.boundingBox = { glm::vec3 { 0.0f }, glm::vec3 { 1.0f, 0.0f, 1.0f } };
+    mesh.boundingRadius = 1.0f;
+
+    Node& root = model.hierarchy.nodes.emplace_back();
+    root.name = "Root";
+    root.childrenIndices = { 1 };
+
+    Node& child = model.hierarchy.nodes.emplace_back();
+    child.name = "Floor";
+    child.transform = glm::translate(glm::mat4 { 1.0f }, glm::vec3 { 1.0f, 2.0f, 3.0f });
+    child.mesh = NodeMeshData { MeshType::eSTATIC, 0 };
+    child.light = NodeLightData { glm::vec3 { 1.0f }, NodeLightType::Spot, 4.0f, 10.0f };
+
+    return model;
+}
+
+}
+
+class CookedModelTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        fileIO::Init(true);
+        std::filesystem::remove_all(TEST_DIRECTORY);
+
+        _sourcePath = (TEST_DIRECTORY / "test_model.glb").generic_string();
+        TestGLBWriter::Write(_sourcePath, 8);
+
+        _threadPool.Start();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(TEST_DIRECTORY);
+        fileIO::Deinit();
+    }
+
+    ThreadPool _threadPool { std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+    std::string _sourcePath {};
+};
+
+TEST_F(CookedModelTests, RoundTripMatchesGLTF)
+{
+    // Arrange
+    CPUModel source = ModelLoading::LoadGLTFFast(_threadPool, _sourcePath, false);
+    ModelLoading::GenerateLODs(_threadPool, source);
+
+    // Act
+    std::optional<CPUModel> cooked = CookedModel::Deserialize(CookedModel::Serialize(source, SOURCE_KEY), SOURCE_KEY);
+
+    // Assert
+    ASSERT_TRUE(cooked.has_value());
+    ASSERT_EQ(source.meshes.size(), 1);
+    ASSERT_EQ(source.skinnedMeshes.size(), 1);
+    ASSERT_TRUE(source.hierarchy.skeletonRoot.has_value());
+    ASSERT_FALSE(source.animations.empty());
+
+    ExpectSameModel(source, cooked.value());
+}
+
+TEST_F(CookedModelTests, SavedModelLoadsThroughFileIO)
+{
+    // Arrange
+    CPUModel source = ModelLoading::LoadGLTFFast(_threadPool, _sourcePath, false);
+    std::optional<CookedModel::Key> key = CookedModel::MakeSourceKey(_sourcePath);
+    std::string cookedPath = CookedModel::GetCookedPath(_sourcePath);
+
+    ASSERT_TRUE(key.has_value());
+    ASSERT_TRUE(CookedModel::Save(source, cookedPath, key.value()));
+
+    // Act
+    std::optional<CPUModel> cooked = CookedModel::Load(cookedPath, key);
+
+    // Assert
+    ASSERT_TRUE(cooked.has_value());
+    ExpectSameModel(source, cooked.value());
+}
+
+TEST_F(CookedModelTests, RoundTripKeepsTexturesAndMaterials)
+{
+    // Arrange
+    CPUModel source = MakeTexturedModel();
+
+    // Act
+    std::optional<CPUModel> cooked = CookedModel::Deserialize(CookedModel::Serialize(source, SOURCE_KEY), SOURCE_KEY);
+
+    // Assert
+    ASSERT_TRUE(cooked.has_value());
+    ExpectSameModel(source, cooked.value());
+}
+
+TEST_F(CookedModelTests, RoundTripKeepsCompressedTextures)
+{
+    // Arrange
+    CPUModel source = MakeTexturedModel();
+    TextureCompression::CompressModelTextures(source);
+
+    // Act
+    std::optional<CPUModel> cooked = CookedModel::Deserialize(CookedModel::Serialize(source, SOURCE_KEY), SOURCE_KEY);
+
+    // Assert
+    ASSERT_TRUE(cooked.has_value());
+    EXPECT_EQ(cooked->textures[0].format, vk::Format::eBc7UnormBlock);
+    EXPECT_TRUE(cooked->textures[0].HasMipChain());
+    ExpectSameModel(source, cooked.value());
+}
+
+TEST_F(CookedModelTests, CookingIsDeterministic)
+{
+    // Arrange
+    CPUModel first = ModelLoading::LoadGLTFFast(_threadPool, _sourcePath, false);
+    CPUModel second = ModelLoading::LoadGLTFFast(_threadPool, _sourcePath, false);
+
+    // Act
+    std::vector<std::byte> firstBytes = CookedModel::Serialize(first, SOURCE_KEY);
+    std::vector<std::byte> secondBytes = CookedModel::Serialize(second, SOURCE_KEY);
+
+    // Assert
+    EXPECT_EQ(firstBytes, secondBytes);
+}
+
+TEST_F(CookedModelTests, RejectsOtherSourceKey)
+{
+    // Arrange
+    std::vector<std::byte> bytes = CookedModel::Serialize(MakeTexturedModel(), SOURCE_KEY);
+
+    // Act
+    std::optional<CPUModel> otherKey = CookedModel::Deserialize(bytes, SOURCE_KEY + 1);
+    std::optional<CPUModel> noKey = CookedModel::Deserialize(bytes, std::nullopt);
+
+    // Assert
+    EXPECT_FALSE(otherKey.has_value());
+    EXPECT_TRUE(noKey.has_value());
+}
+
+TEST_F(CookedModelTests, RejectsOtherVersion)
+{
+    // Arrange, the version directly follows the magic
+    std::vector<std::byte> bytes = CookedModel::Serialize(MakeTexturedModel(), SOURCE_KEY);
+    uint32_t version = CookedModel::COOK_VERSION + 1;
+    std::memcpy(bytes.data() + sizeof(uint32_t), &version, sizeof(version));
+
+    // Act
+    std::optional<CPUModel> cooked = CookedModel::Deserialize(bytes, SOURCE_KEY);
+
+    // Assert
+    EXPECT_FALSE(cooked.has_value());
+}
+
+TEST_F(CookedModelTests, RejectsTruncatedFile)
+{
+    // Arrange
+    std::vector<std::byte> bytes = CookedModel::Serialize(MakeTexturedModel(), SOURCE_KEY);
+
+    // Act & Assert
+    for (size_t size : { size_t { 0 }, size_t { 8 }, bytes.size() / 2, bytes.size() - 1 })
+        EXPECT_FALSE(CookedModel::Deserialize(std::span { bytes.data(), size }, SOURCE_KEY).has_value()) << "size " << size;
+}
+
+TEST_F(CookedModelTests, RejectsOutOfRangeIndices)
+{
+    // Arrange
+    CPUModel badMesh = MakeTexturedModel();
+    badMesh.hierarchy.nodes[1].mesh->index = 1;
+
+    CPUModel badChild = MakeTexturedModel();
+    badChild.hierarchy.nodes[0].childrenIndices.emplace_back(2);
+
+    CPUModel badTexture = MakeTexturedModel();
+    badTexture.materials[0].normalMap = 1;
+
+    CPUModel badMaterial = MakeTexturedModel();
+    badMaterial.meshes[0].materialIndex = 1;
+
+    CPUModel badIndex = MakeTexturedModel();
+    badIndex.meshes[0].indices[2] = 3;
+
+    // Act & Assert
+    for (const CPUModel* model : { &badMesh, &badChild, &badTexture, &badMaterial, &badIndex })
+        EXPECT_FALSE(CookedModel::Deserialize(CookedModel::Serialize(*model, SOURCE_KEY), SOURCE_KEY).has_value());
+}
+
+TEST_F(CookedModelTests, MissingFileDoesNotLoad)
+{
+    // Act
+    std::optional<CPUModel> cooked = CookedModel::Load((TEST_DIRECTORY / "missing.cmodel").generic_string(), std::nullopt);
+
+    // Assert
+    EXPECT_FALSE(cooked.has_value());
+}
+
+TEST_F(CookedModelTests, SourceKeyChangesWithSource)
+{
+    // Arrange
+    std::optional<CookedModel::Key> before = CookedModel::MakeSourceKey(_sourcePath);
+
+    // Act
+    TestGLBWriter::Write(_sourcePath, 9);
+    std::optional<CookedModel::Key> after = CookedModel::MakeSourceKey(_sourcePath);
+
+    // Assert
+    ASSERT_TRUE(before.has_value());
+    ASSERT_TRUE(after.has_value());
+    EXPECT_NE(before.value(), after.value());
+    EXPECT_FALSE(CookedModel::MakeSourceKey((TEST_DIRECTORY / "missing.glb").generic_string()).has_value());
+}
+
+TEST(CookedModelPathTests, ReplacesExtension)
+{
+    EXPECT_EQ(CookedModel::GetCookedPath("assets/models/Enemy.glb"), "assets/models/Enemy.cmodel");
+    EXPECT_EQ(CookedModel::GetCookedPath("assets/models/Enemy.gltf"), "assets/models/Enemy.cmodel");
+    EXPECT_EQ(CookedModel::GetCookedPath("assets/models.v2/Enemy"), "assets/models.v2/Enemy.cmodel");
+    EXPECT_EQ(CookedModel::GetCookedPath("Enemy"), "Enemy.cmodel");
+}
@@ -0,0 +1,211 @@
+#include "derived_data_cache.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace
+{
+
+std::vector<std::byte> MakeBlob(size_t size, uint8_t seed)
+{
+    std::vector<std::byte> blob(size);
+
+    for (size_t i = 0; i < size; ++i)
+        blob[i] = static_cast<std::byte>((i * 31 + seed) & 0xFF);
+
+    return blob;
+}
+
+DerivedDataCache::Key MakeKey(DerivedDataCache::Hash source)
+{
+    return DerivedDataCache::Key { .processor = "tests", .version = 1, .source = source, .parameters = 0x1234 };
+}
+
+}
+
+class DerivedDataCacheTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _directory = std::filesystem::temp_directory_path() / "bb_derived_data_cache_tests";
+        std::filesystem::remove_all(_directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(_directory);
+    }
+
+    std::filesystem::path _directory;
+};
+
+TEST_F(DerivedDataCacheTests, MissThenHit)
+{
+    // Arrange
+    DerivedDataCache cache { _directory };
+    const std::vector<std::byte> blob = MakeBlob(1000, 7);
+
+    // Act
+    auto missed = cache.Load(MakeKey(1));
+    const bool stored = cache.Store(MakeKey(1), blob);
+    auto hit = cache.Load(MakeKey(1));
+
+    // Assert
+    EXPECT_FALSE(missed.has_value());
+    EXPECT_TRUE(stored);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit.value(), blob);
+
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+    EXPECT_EQ(cache.GetStats().hits, 1u);
+    EXPECT_EQ(cache.GetStats().writes, 1u);
+}
+
+TEST_F(DerivedDataCacheTests, LoadOrBuildOnlyBuildsOnceAcrossRuns)
+{
+    // Arrange
+    uint32_t builds = 0;
+    auto build = [&builds]()
+    {
+        ++builds;
+        return MakeBlob(64, 3);
+    };
+
+    {
+        DerivedDataCache previousRun { _directory };
+        static_cast<void>(previousRun.LoadOrBuild(MakeKey(1), build));
+    }
+
+    // Act
+    DerivedDataCache cache { _directory };
+    const std::vector<std::byte> blob = cache.LoadOrBuild(MakeKey(1), build);
+
+    // Assert
+    EXPECT_EQ(builds, 1u);
+    EXPECT_EQ(blob, MakeBlob(64, 3));
+    EXPECT_EQ(cache.GetStats().hits, 1u);
+}
+
+TEST_F(DerivedDataCacheTests, AnyKeyChangeMisses)
+{
+    // Arrange
+    DerivedDataCache cache { _directory };
+    cache.Store(MakeKey(1), MakeBlob(100, 1));
+
+    DerivedDataCache::Key newVersion = MakeKey(1);
+    newVersion.version++;
+
+    DerivedDataCache::Key newParameters = MakeKey(1);
+    newParameters.parameters++;
+
+    DerivedDataCache::Key otherProcessor = MakeKey(1);
+    otherProcessor.processor = "other_tests";
+
+    // Act & Assert
+    EXPECT_FALSE(cache.Load(newVersion).has_value());
+    EXPECT_FALSE(cache.Load(newParameters).has_value());
+    EXPECT_FALSE(cache.Load(otherProcessor).has_value());
+    EXPECT_FALSE(cache.Load(MakeKey(2)).has_value());
+    EXPECT_TRUE(cache.Load(MakeKey(1)).has_value());
+}
+
+TEST_F(DerivedDataCacheTests, CorruptBlobsAreDiscarded)
+{
+    // Arrange
+    DerivedDataCache cache { _directory };
+    cache.Store(MakeKey(1), MakeBlob(1000, 1));
+    cache.Store(MakeKey(2), MakeBlob(1000, 2));
+
+    const std::filesystem::path truncatedPath = cache.GetFilePath(MakeKey(1));
+    std::filesystem::resize_file(truncatedPath, std::filesystem::file_size(truncatedPath) / 2);
+
+    const std::filesystem::path flippedPath = cache.GetFilePath(MakeKey(2));
+    {
+        std::fstream file { flippedPath, std::ios::in | std::ios::out | std::ios::binary };
+        file.seekp(-10, std::ios::end);
+        file.put('\x5A');
+    }
+
+    // Act
+    auto truncated = cache.Load(MakeKey(1));
+    auto flipped = cache.Load(MakeKey(2));
+
+    // Assert
+    EXPECT_FALSE(truncated.has_value());
+    EXPECT_FALSE(flipped.has_value());
+    EXPECT_FALSE(std::filesystem::exists(truncatedPath));
+    EXPECT_FALSE(std::filesystem::exists(flippedPath));
+    EXPECT_EQ(cache.GetStats().corrupt, 2u);
+
+    // The next build replaces the corrupt blob
+    cache.Store(MakeKey(1), MakeBlob(1000, 1));
+    EXPECT_EQ(cache.Load(MakeKey(1)), MakeBlob(1000, 1));
+}
+
+TEST_F(DerivedDataCacheTests, LeastRecentlyUsedIsEvicted)
+{
+    // Arrange, the limit fits three blobs with their headers
+    DerivedDataCache cache { _directory, 3 * 1100 };
+
+    for (DerivedDataCache::Hash source = 1; source <= 3; ++source)
+        cache.Store(MakeKey(source), MakeBlob(1000, static_cast<uint8_t>(source)));
+
+    // Age the blobs so their order doesn't depend on the resolution of the file clock
+    const auto now = std::filesystem::file_time_type::clock::now();
+    for (DerivedDataCache::Hash source = 1; source <= 3; ++source)
+        std::filesystem::last_write_time(cache.GetFilePath(MakeKey(source)), now - std::chrono::hours(4 - source));
+
+    // Act, using the oldest blob makes the second one the least recently used
+    static_cast<void>(cache.Load(MakeKey(1)));
+    cache.Store(MakeKey(4), MakeBlob(1000, 4));
+
+    // Assert
+    EXPECT_EQ(cache.GetStats().evictions, 1u);
+    EXPECT_TRUE(std::filesystem::exists(cache.GetFilePath(MakeKey(1))));
+    EXPECT_FALSE(std::filesystem::exists(cache.GetFilePath(MakeKey(2))));
+    EXPECT_TRUE(std::filesystem::exists(cache.GetFilePath(MakeKey(3))));
+    EXPECT_TRUE(std::filesystem::exists(cache.GetFilePath(MakeKey(4))));
+}
+
+TEST_F(DerivedDataCacheTests, ConcurrentWritersLeaveOneValidBlob)
+{
+    // Arrange, two caches on the same directory act like two processes
+    constexpr uint32_t THREAD_COUNT = 8;
+    constexpr uint32_t WRITES_PER_THREAD = 20;
+
+    DerivedDataCache first { _directory };
+    DerivedDataCache second { _directory };
+    std::vector<std::thread> threads {};
+
+    // Act
+    for (uint32_t i = 0; i < THREAD_COUNT; ++i)
+    {
+        threads.emplace_back([&first, &second, i]()
+            {
+                DerivedDataCache& cache = i % 2 == 0 ? first : second;
+
+                for (uint32_t write = 0; write < WRITES_PER_THREAD; ++write)
+                    cache.Store(MakeKey(1), MakeBlob(4096, static_cast<uint8_t>(i)));
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto blob = DerivedDataCache { _directory }.Load(MakeKey(1));
+
+    // Assert, the blob has to be one of the written ones as a whole, no temporary files are left behind
+    ASSERT_TRUE(blob.has_value());
+
+    bool matchesAWriter = false;
+    for (uint32_t i = 0; i < THREAD_COUNT; ++i)
+        matchesAWriter |= blob.value() == MakeBlob(4096, static_cast<uint8_t>(i));
+
+    EXPECT_TRUE(matchesAWriter);
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(_directory))
+        EXPECT_NE(entry.path().extension(), ".tmp") << entry.path();
+}
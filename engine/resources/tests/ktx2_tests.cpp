@@ -0,0 +1,169 @@
+#include "ktx2.hpp"
+#include "texture_compression.hpp"
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+// Offsets of the fields in the file, see the KTX2 specification
+constexpr size_t VK_FORMAT_OFFSET = 12;
+constexpr size_t LEVEL_COUNT_OFFSET = 40;
+constexpr size_t SUPERCOMPRESSION_OFFSET = 44;
+constexpr size_t DFD_OFFSET_OFFSET = 48;
+constexpr size_t LEVEL_INDEX_OFFSET = 80;
+constexpr size_t LEVEL_INDEX_SIZE = 24;
+
+CPUImage MakeImage(uint16_t width, uint16_t height)
+{
+    std::vector<std::byte> data(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = std::byte { static_cast<uint8_t>(i * 7 % 251) };
+
+    CPUImage image {};
+    image.SetSize(width, height).SetFormat(vk::Format::eR8G8B8A8Unorm).SetFlags(vk::ImageUsageFlagBits::eSampled).SetData(std::move(data));
+    return image;
+}
+
+CPUImage MakeCompressedImage(uint16_t width, uint16_t height)
+{
+    CPUImage image = MakeImage(width, height);
+    TextureCompression::Compress(image, TextureCompression::BlockFormat::eBC7);
+    return image;
+}
+
+template <typename T>
+T ReadAt(const std::vector<std::byte>& bytes, size_t offset)
+{
+    T value {};
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void WriteAt(std::vector<std::byte>& bytes, size_t offset, T value)
+{
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+}
+
+TEST(KTX2Tests, CompressedImageRoundTrips)
+{
+    // Arrange
+    const CPUImage image = MakeCompressedImage(40, 24);
+
+    // Act
+    const std::optional<std::vector<std::byte>> bytes = KTX2::Serialize(image);
+    ASSERT_TRUE(bytes.has_value());
+    const std::optional<CPUImage> read = KTX2::Deserialize(bytes.value());
+
+    // Assert
+    ASSERT_TRUE(read.has_value());
+    EXPECT_EQ(read->format, vk::Format::eBc7UnormBlock);
+    EXPECT_EQ(read->width, 40);
+    EXPECT_EQ(read->height, 24);
+    EXPECT_EQ(read->mips, 6);
+    EXPECT_EQ(read->initialData, image.initialData);
+    EXPECT_TRUE(read->HasMipChain());
+}
+
+TEST(KTX2Tests, LevelsAreStoredSmallestFirst)
+{
+    // Arrange
+    const CPUImage image = MakeCompressedImage(32, 32);
+
+    // Act
+    const std::vector<std::byte> bytes = KTX2::Serialize(image).value();
+
+    // Assert, the level index starts with the largest level, while the data starts with the smallest
+    EXPECT_EQ(std::to_integer<uint8_t>(bytes[0]), 0xAB);
+    EXPECT_EQ(std::memcmp(bytes.data() + 1, "KTX 20", 6), 0);
+    EXPECT_EQ(ReadAt<uint32_t>(bytes, VK_FORMAT_OFFSET), static_cast<uint32_t>(vk::Format::eBc7UnormBlock));
+    EXPECT_EQ(ReadAt<uint32_t>(bytes, LEVEL_COUNT_OFFSET), 6);
+    EXPECT_EQ(ReadAt<uint32_t>(bytes, DFD_OFFSET_OFFSET), LEVEL_INDEX_OFFSET + 6 * LEVEL_INDEX_SIZE);
+
+    uint64_t previousOffset = bytes.size();
+    for (uint32_t level = 0; level < 6; ++level)
+    {
+        const uint64_t offset = ReadAt<uint64_t>(bytes, LEVEL_INDEX_OFFSET + level * LEVEL_INDEX_SIZE);
+        const uint64_t length = ReadAt<uint64_t>(bytes, LEVEL_INDEX_OFFSET + level * LEVEL_INDEX_SIZE + 8);
+
+        EXPECT_EQ(length, TextureCompression::GetMipSize(vk::Format::eBc7UnormBlock, 32, 32, level));
+        EXPECT_EQ(offset % 16, 0);
+        EXPECT_LT(offset, previousOffset);
+        previousOffset = offset;
+    }
+}
+
+TEST(KTX2Tests, FirstLevelOnlyIsGeneratedOnUpload)
+{
+    // Arrange
+    CPUImage image = MakeImage(16, 8);
+    image.SetMips(3);
+
+    // Act
+    const std::optional<std::vector<std::byte>> bytes = KTX2::Serialize(image);
+    ASSERT_TRUE(bytes.has_value());
+    const std::optional<CPUImage> read = KTX2::Deserialize(bytes.value());
+
+    // Assert
+    EXPECT_EQ(ReadAt<uint32_t>(bytes.value(), LEVEL_COUNT_OFFSET), 0);
+    ASSERT_TRUE(read.has_value());
+    EXPECT_EQ(read->format, vk::Format::eR8G8B8A8Unorm);
+    EXPECT_EQ(read->mips, 5);
+    EXPECT_EQ(read->initialData, image.initialData);
+    EXPECT_FALSE(read->HasMipChain());
+}
+
+TEST(KTX2Tests, RejectsImagesItCannotStore)
+{
+    // Arrange
+    CPUImage cubeMap = MakeImage(4, 4);
+    cubeMap.SetType(ImageType::eCubeMap);
+
+    CPUImage hdr = MakeImage(4, 4);
+    hdr.isHDR = true;
+
+    CPUImage wrongSize = MakeImage(4, 4);
+    wrongSize.initialData.pop_back();
+
+    CPUImage otherFormat = MakeImage(4, 4);
+    otherFormat.SetFormat(vk::Format::eR8Unorm);
+
+    // Act & Assert
+    for (const CPUImage* image : { &cubeMap, &hdr, &wrongSize, &otherFormat })
+        EXPECT_FALSE(KTX2::Serialize(*image).has_value());
+}
+
+TEST(KTX2Tests, RejectsCorruptFiles)
+{
+    // Arrange
+    const std::vector<std::byte> bytes = KTX2::Serialize(MakeCompressedImage(16, 16)).value();
+
+    std::vector<std::byte> badIdentifier = bytes;
+    badIdentifier[1] = std::byte { 'X' };
+
+    std::vector<std::byte> badFormat = bytes;
+    WriteAt<uint32_t>(badFormat, VK_FORMAT_OFFSET, static_cast<uint32_t>(vk::Format::eR32G32B32A32Sfloat));
+
+    std::vector<std::byte> supercompressed = bytes;
+    WriteAt<uint32_t>(supercompressed, SUPERCOMPRESSION_OFFSET, 2);
+
+    std::vector<std::byte> tooManyLevels = bytes;
+    WriteAt<uint32_t>(tooManyLevels, LEVEL_COUNT_OFFSET, 6);
+
+    std::vector<std::byte> badLength = bytes;
+    WriteAt<uint64_t>(badLength, LEVEL_INDEX_OFFSET + 8, 15);
+
+    std::vector<std::byte> outOfBounds = bytes;
+    WriteAt<uint64_t>(outOfBounds, LEVEL_INDEX_OFFSET, bytes.size() - 8);
+
+    // Act & Assert
+    for (const std::vector<std::byte>* corrupt : { &badIdentifier, &badFormat, &supercompressed, &tooManyLevels, &badLength, &outOfBounds })
+        EXPECT_FALSE(KTX2::Deserialize(*corrupt).has_value());
+
+    for (size_t size : { size_t { 0 }, size_t { 12 }, LEVEL_INDEX_OFFSET + 8, bytes.size() - 1 })
+        EXPECT_FALSE(KTX2::Deserialize(std::span { bytes.data(), size }).has_value()) << "size " << size;
+}
@@ -0,0 +1,238 @@
+#include "mesh_optimization.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+namespace
+{
+
+using Triangle = std::array<std::array<std::byte, sizeof(Vertex)>, 3>;
+
+// A grid of quads like an exporter writes it without sharing, every corner is its own vertex and the triangles are shuffled
+CPUMesh<Vertex> MakeUnsharedGrid(uint32_t gridSize)
+{
+    CPUMesh<Vertex> mesh {};
+
+    auto corner = [gridSize](uint32_t x, uint32_t y)
+    {
+        const glm::vec2 uv = glm::vec2 { x, y } / static_cast<float>(gridSize);
+        return Vertex { glm::vec3 { uv.x, 0.0f, uv.y }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, uv };
+    };
+
+    std::vector<std::array<Vertex, 3>> triangles {};
+    for (uint32_t y = 0; y < gridSize; ++y)
+    {
+        for (uint32_t x = 0; x < gridSize; ++x)
+        {
+            triangles.push_back({ corner(x, y), corner(x, y + 1), corner(x + 1, y) });
+            triangles.push_back({ corner(x + 1, y), corner(x, y + 1), corner(x + 1, y + 1) });
+        }
+    }
+
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937 { 11 });
+
+    for (const auto& triangle : triangles)
+    {
+        for (const Vertex& vertex : triangle)
+        {
+            mesh.indices.emplace_back(static_cast<uint32_t>(mesh.vertices.size()));
+            mesh.vertices.emplace_back(vertex);
+        }
+    }
+
+    return mesh;
+}
+
+// Every triangle by the bytes of its vertices, rotated so the smallest corner is first, which keeps the winding
+std::vector<Triangle> CollectTriangles(const CPUMesh<Vertex>& mesh)
+{
+    std::vector<Triangle> triangles {};
+
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+        Triangle triangle {};
+        for (uint32_t corner = 0; corner < 3; ++corner)
+            std::memcpy(triangle[corner].data(), &mesh.vertices[mesh.indices[i + corner]], sizeof(Vertex));
+
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.emplace_back(triangle);
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}
+
+TEST(MeshOptimizationTests, DeduplicationMergesSharedCorners)
+{
+    // Arrange
+    CPUMesh<Vertex> mesh = MakeUnsharedGrid(8);
+    const std::vector<Triangle> before = CollectTriangles(mesh);
+
+    // Act
+    MeshOptimization::DeduplicateVertices(mesh);
+
+    // Assert
+    EXPECT_EQ(mesh.vertices.size(), 9 * 9);
+    EXPECT_EQ(mesh.indices.size(), 8 * 8 * 6);
+    EXPECT_EQ(CollectTriangles(mesh), before);
+}
+
+TEST(MeshOptimizationTests, DeduplicationKeepsVerticesThatDifferInAnyAttribute)
+{
+    // Arrange, a hard edge has the same position twice with different normals
+    CPUMesh<Vertex> mesh {};
+    mesh.vertices = { Vertex { glm::vec3 { 0.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f } },
+        Vertex { glm::vec3 { 0.0f }, glm::vec3 { 1.0f, 0.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f } },
+        Vertex { glm::vec3 { 0.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f, 1.0f } },
+        Vertex { glm::vec3 { 0.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f } } };
+    mesh.indices = { 0, 1, 2, 3, 1, 2 };
+
+    // Act
+    MeshOptimization::DeduplicateVertices(mesh);
+
+    // Assert
+    ASSERT_EQ(mesh.vertices.size(), 3);
+    EXPECT_EQ(mesh.indices, (std::vector<uint32_t> { 0, 1, 2, 0, 1, 2 }));
+}
+
+TEST(MeshOptimizationTests, SkinnedVerticesAreDeduplicated)
+{
+    // Arrange
+    CPUMesh<SkinnedVertex> mesh {};
+    const SkinnedVertex vertex { glm::vec3 { 1.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f },
+        glm::vec4 { 0.0f, 1.0f, 0.0f, 0.0f }, glm::vec4 { 0.5f, 0.5f, 0.0f, 0.0f } };
+    SkinnedVertex otherJoint = vertex;
+    otherJoint.joints.y = 2.0f;
+
+    mesh.vertices = { vertex, otherJoint, vertex };
+    mesh.indices = { 0, 1, 2 };
+
+    // Act
+    MeshOptimization::DeduplicateVertices(mesh);
+
+    // Assert
+    EXPECT_EQ(mesh.vertices.size(), 2);
+    EXPECT_EQ(mesh.indices, (std::vector<uint32_t> { 0, 1, 0 }));
+}
+
+TEST(MeshOptimizationTests, CacheStatisticsOfKnownOrders)
+{
+    // Arrange, a strip of triangles where each one reuses two vertices of the one before
+    std::vector<uint32_t> strip {};
+    for (uint32_t i = 0; i < 10; ++i)
+        strip.insert(strip.end(), { i, i + 1, i + 2 });
+
+    // Every triangle on its own vertices
+    std::vector<uint32_t> unshared(30);
+    std::iota(unshared.begin(), unshared.end(), 0);
+
+    // Act
+    const MeshOptimization::VertexCacheStatistics stripStatistics = MeshOptimization::AnalyzeVertexCache(strip, 12);
+    const MeshOptimization::VertexCacheStatistics unsharedStatistics = MeshOptimization::AnalyzeVertexCache(unshared, 30);
+
+    // Assert
+    EXPECT_EQ(stripStatistics.transformedVertices, 12);
+    EXPECT_FLOAT_EQ(stripStatistics.acmr, 1.2f);
+    EXPECT_FLOAT_EQ(stripStatistics.atvr, 1.0f);
+
+    EXPECT_FLOAT_EQ(unsharedStatistics.acmr, 3.0f);
+    EXPECT_FLOAT_EQ(unsharedStatistics.atvr, 1.0f);
+}
+
+TEST(MeshOptimizationTests, CacheStatisticsCountEvictedVertices)
+{
+    // Arrange, vertex 0 is used again after 4 others went through a cache of 4
+    const std::vector<uint32_t> indices { 0, 1, 2, 3, 4, 0 };
+
+    // Act
+    const MeshOptimization::VertexCacheStatistics statistics = MeshOptimization::AnalyzeVertexCache(indices, 5, 4);
+
+    // Assert
+    EXPECT_EQ(statistics.transformedVertices, 6);
+}
+
+TEST(MeshOptimizationTests, OptimizationImprovesCacheUse)
+{
+    // Arrange
+    CPUMesh<Vertex> mesh = MakeUnsharedGrid(32);
+    const std::vector<Triangle> before = CollectTriangles(mesh);
+
+    CPUMesh<Vertex> deduplicated = mesh;
+    MeshOptimization::DeduplicateVertices(deduplicated);
+    const MeshOptimization::VertexCacheStatistics shuffled = MeshOptimization::AnalyzeVertexCache(deduplicated.indices, static_cast<uint32_t>(deduplicated.vertices.size()));
+
+    // Act
+    MeshOptimization::Optimize(mesh);
+    const MeshOptimization::VertexCacheStatistics optimized = MeshOptimization::AnalyzeVertexCache(mesh.indices, static_cast<uint32_t>(mesh.vertices.size()));
+
+    // Assert
+    EXPECT_EQ(CollectTriangles(mesh), before);
+    EXPECT_EQ(mesh.vertices.size(), 33 * 33);
+
+    // A shuffled grid misses the cache for nearly every corner, a good order transforms each vertex little more than once
+    EXPECT_GT(shuffled.acmr, 2.0f);
+    EXPECT_LT(optimized.acmr, 0.8f);
+    EXPECT_LT(optimized.atvr, 1.5f);
+    EXPECT_LT(optimized.acmr, shuffled.acmr / 2.0f);
+}
+
+TEST(MeshOptimizationTests, FetchOrderFollowsFirstUse)
+{
+    // Arrange
+    CPUMesh<Vertex> mesh = MakeUnsharedGrid(4);
+    MeshOptimization::DeduplicateVertices(mesh);
+
+    // Act
+    MeshOptimization::OptimizeVertexFetch(mesh);
+
+    // Assert, every index is at most one higher than the highest one before it
+    uint32_t next = 0;
+    for (uint32_t index : mesh.indices)
+    {
+        ASSERT_LE(index, next);
+        next = std::max(next, index + 1);
+    }
+
+    EXPECT_EQ(next, mesh.vertices.size());
+}
+
+TEST(MeshOptimizationTests, FetchOptimizationDropsUnusedVertices)
+{
+    // Arrange
+    CPUMesh<Vertex> mesh {};
+    mesh.vertices.resize(5);
+    for (uint32_t i = 0; i < mesh.vertices.size(); ++i)
+        mesh.vertices[i].position = glm::vec3 { static_cast<float>(i) };
+    mesh.indices = { 4, 2, 0 };
+
+    // Act
+    MeshOptimization::OptimizeVertexFetch(mesh);
+
+    // Assert
+    ASSERT_EQ(mesh.vertices.size(), 3);
+    EXPECT_EQ(mesh.indices, (std::vector<uint32_t> { 0, 1, 2 }));
+    EXPECT_EQ(mesh.vertices[0].position, glm::vec3 { 4.0f });
+    EXPECT_EQ(mesh.vertices[2].position, glm::vec3 { 0.0f });
+}
+
+TEST(MeshOptimizationTests, OptimizingTwiceGivesTheSameMesh)
+{
+    // Arrange
+    CPUMesh<Vertex> first = MakeUnsharedGrid(16);
+    MeshOptimization::Optimize(first);
+    CPUMesh<Vertex> second = first;
+
+    // Act
+    MeshOptimization::Optimize(second);
+
+    // Assert, the order may change but the result is just as good
+    EXPECT_EQ(CollectTriangles(first), CollectTriangles(second));
+    EXPECT_LE(MeshOptimization::AnalyzeVertexCache(second.indices, static_cast<uint32_t>(second.vertices.size())).acmr,
+        MeshOptimization::AnalyzeVertexCache(first.indices, static_cast<uint32_t>(first.vertices.size())).acmr + 0.05f);
+}
@@ -0,0 +1,306 @@
+#include "mesh_simplification.hpp"
+
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+
+namespace
+{
+
+// A square of gridSize by gridSize quads on the XZ plane, the corners are shared between the quads
+CPUMesh<Vertex> MakeGrid(uint32_t gridSize)
+{
+    CPUMesh<Vertex> mesh {};
+
+    for (uint32_t y = 0; y <= gridSize; ++y)
+    {
+        for (uint32_t x = 0; x <= gridSize; ++x)
+        {
+            const glm::vec2 uv = glm::vec2 { x, y } / static_cast<float>(gridSize);
+            mesh.vertices.emplace_back(glm::vec3 { uv.x, 0.0f, uv.y }, glm::vec3 { 0.0f, 1.0f, 0.0f }, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, uv);
+        }
+    }
+
+    for (uint32_t y = 0; y < gridSize; ++y)
+    {
+        for (uint32_t x = 0; x < gridSize; ++x)
+        {
+            const uint32_t corner = y * (gridSize + 1) + x;
+            mesh.indices.insert(mesh.indices.end(), { corner, corner + gridSize + 1, corner + 1 });
+            mesh.indices.insert(mesh.indices.end(), { corner + 1, corner + gridSize + 1, corner + gridSize + 2 });
+        }
+    }
+
+    mesh.boundingRadius = glm::sqrt(2.0f);
+    return mesh;
+}
+
+// A sphere of radius one made by subdividing an icosahedron, every triangle faces outwards
+CPUMesh<Vertex> MakeSphere(uint32_t subdivisions)
+{
+    const float t = (1.0f + glm::sqrt(5.0f)) / 2.0f;
+
+    std::vector<glm::vec3> positions {
+        { -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 },
+        { 0, -1, t }, { 0, 1, t }, { 0, -1, -t }, { 0, 1, -t },
+        { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 }
+    };
+
+    std::vector<uint32_t> indices {
+        0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11,
+        1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+        3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9,
+        4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1
+    };
+
+    for (uint32_t i = 0; i < subdivisions; ++i)
+    {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints {};
+        auto midpoint = [&](uint32_t a, uint32_t b)
+        {
+            const auto [it, inserted] = midpoints.try_emplace({ std::min(a, b), std::max(a, b) }, static_cast<uint32_t>(positions.size()));
+            if (inserted)
+                positions.emplace_back((positions[a] + positions[b]) * 0.5f);
+
+            return it->second;
+        };
+
+        std::vector<uint32_t> subdivided {};
+        for (size_t triangle = 0; triangle < indices.size(); triangle += 3)
+        {
+            const uint32_t a = indices[triangle], b = indices[triangle + 1], c = indices[triangle + 2];
+            const uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+            subdivided.insert(subdivided.end(), { a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca });
+        }
+
+        indices = std::move(subdivided);
+    }
+
+    CPUMesh<Vertex> mesh {};
+    for (const glm::vec3& position : positions)
+    {
+        const glm::vec3 normal = glm::normalize(position);
+        mesh.vertices.emplace_back(normal, normal, glm::vec4 { 1.0f, 0.0f, 0.0f, 1.0f }, glm::vec2 { 0.0f });
+    }
+
+    mesh.indices = std::move(indices);
+    mesh.boundingRadius = 1.0f;
+    return mesh;
+}
+
+// Closest point on a triangle, from Real-Time Collision Detection by Christer Ericson
+glm::vec3 ClosestPointOnTriangle(glm::vec3 p, glm::vec3 a, glm::vec3 b, glm::vec3 c)
+{
+    const glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+    const float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+        return a;
+
+    const glm::vec3 bp = p - b;
+    const float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3)
+        return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return a + ab * (d1 / (d1 - d3));
+
+    const glm::vec3 cp = p - c;
+    const float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6)
+        return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return a + ac * (d2 / (d2 - d6));
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    const float denominator = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+// Furthest any vertex of the full detail mesh is from the simplified surface
+float LargestDistanceToSurface(const CPUMesh<Vertex>& mesh, const std::vector<uint32_t>& simplified)
+{
+    float largest = 0.0f;
+
+    for (const Vertex& vertex : mesh.vertices)
+    {
+        float closest = std::numeric_limits<float>::max();
+
+        for (size_t i = 0; i < simplified.size(); i += 3)
+        {
+            const glm::vec3 point = ClosestPointOnTriangle(vertex.position, mesh.vertices[simplified[i]].position,
+                mesh.vertices[simplified[i + 1]].position, mesh.vertices[simplified[i + 2]].position);
+            closest = std::min(closest, glm::distance(point, vertex.position));
+        }
+
+        largest = std::max(largest, closest);
+    }
+
+    return largest;
+}
+
+glm::vec3 TriangleNormal(const CPUMesh<Vertex>& mesh, const std::vector<uint32_t>& indices, size_t triangle)
+{
+    const glm::vec3 a = mesh.vertices[indices[triangle]].position;
+    const glm::vec3 b = mesh.vertices[indices[triangle + 1]].position;
+    const glm::vec3 c = mesh.vertices[indices[triangle + 2]].position;
+    return glm::cross(b - a, c - a);
+}
+
+}
+
+TEST(MeshSimplificationTests, FlatGridLosesNoShape)
+{
+    // Arrange
+    const CPUMesh<Vertex> mesh = MakeGrid(16);
+
+    // Act
+    const MeshSimplification::Result result = MeshSimplification::Simplify(mesh, 0, 1e-4f);
+
+    // Assert, every collapse inside a plane is free, only the border is left
+    EXPECT_LT(result.error, 1e-5f);
+    EXPECT_LT(result.indices.size(), mesh.indices.size() / 4);
+
+    // No triangle folded over, so the triangles that are left still cover the square exactly once
+    float area = 0.0f;
+    for (size_t i = 0; i < result.indices.size(); i += 3)
+    {
+        const glm::vec3 normal = TriangleNormal(mesh, result.indices, i);
+        EXPECT_GT(normal.y, 0.0f);
+        area += glm::length(normal) / 2.0f;
+    }
+
+    EXPECT_NEAR(area, 1.0f, 1e-4f);
+}
+
+TEST(MeshSimplificationTests, SphereErrorIsBounded)
+{
+    // Arrange
+    const CPUMesh<Vertex> mesh = MakeSphere(3);
+    const float targetError = 0.05f;
+
+    // Act
+    const MeshSimplification::Result result = MeshSimplification::Simplify(mesh, 0, targetError);
+
+    // Assert, the reported error is within the target and no vertex of the full mesh is further than that from the simplified one
+    EXPECT_LE(result.error, targetError);
+    EXPECT_GT(result.error, 0.0f);
+    EXPECT_LT(result.indices.size(), mesh.indices.size() / 2);
+    EXPECT_LE(LargestDistanceToSurface(mesh, result.indices), result.error);
+}
+
+TEST(MeshSimplificationTests, TargetIndexCountIsReached)
+{
+    // Arrange
+    const CPUMesh<Vertex> mesh = MakeSphere(3);
+    const size_t targetIndexCount = mesh.indices.size() / 8;
+
+    // Act
+    const MeshSimplification::Result result = MeshSimplification::Simplify(mesh, targetIndexCount);
+
+    // Assert
+    EXPECT_LE(result.indices.size(), targetIndexCount);
+    EXPECT_GT(result.indices.size(), targetIndexCount / 2);
+    EXPECT_EQ(result.indices.size() % 3, 0);
+
+    for (size_t i = 0; i < result.indices.size(); i += 3)
+    {
+        const glm::vec3 centroid = (mesh.vertices[result.indices[i]].position + mesh.vertices[result.indices[i + 1]].position
+                                       + mesh.vertices[result.indices[i + 2]].position)
+            / 3.0f;
+        EXPECT_GT(glm::dot(TriangleNormal(mesh, result.indices, i), centroid), 0.0f);
+    }
+}
+
+TEST(MeshSimplificationTests, SeamsAndBordersAreKept)
+{
+    // Arrange, the column of vertices in the middle is split in two with different texture coordinates, like a seam in a UV map
+    CPUMesh<Vertex> mesh = MakeGrid(8);
+    std::set<uint32_t> kept {};
+
+    for (uint32_t y = 0; y <= 8; ++y)
+    {
+        const uint32_t original = y * 9 + 4;
+        const uint32_t split = static_cast<uint32_t>(mesh.vertices.size());
+
+        Vertex vertex = mesh.vertices[original];
+        vertex.texCoord.x += 1.0f;
+        mesh.vertices.emplace_back(vertex);
+
+        // The triangles on the right of the column use the new vertex
+        for (size_t i = 0; i < mesh.indices.size(); i += 3)
+        {
+            const bool rightOfSeam = std::any_of(mesh.indices.begin() + i, mesh.indices.begin() + i + 3, [](uint32_t index)
+                { return index % 9 > 4; });
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                if (rightOfSeam && mesh.indices[i + corner] == original)
+                    mesh.indices[i + corner] = split;
+            }
+        }
+
+        kept.insert({ original, split });
+    }
+
+    for (uint32_t i = 0; i <= 8; ++i)
+        kept.insert({ i, 8 * 9 + i, i * 9, i * 9 + 8 });
+
+    // Act
+    const MeshSimplification::Result result = MeshSimplification::Simplify(mesh, 0);
+
+    // Assert
+    const std::set<uint32_t> used { result.indices.begin(), result.indices.end() };
+    for (uint32_t vertex : kept)
+        EXPECT_TRUE(used.contains(vertex)) << vertex;
+
+    EXPECT_LT(result.indices.size(), mesh.indices.size());
+}
+
+TEST(MeshSimplificationTests, LODsGetSimplerAndLessAccurate)
+{
+    // Arrange
+    CPUMesh<Vertex> mesh = MakeSphere(4);
+
+    // Act
+    MeshSimplification::GenerateLODs(mesh);
+
+    // Assert
+    ASSERT_GE(mesh.lods.size(), 2);
+    ASSERT_LE(mesh.lods.size(), MeshSimplification::MAX_LODS);
+
+    size_t previousIndexCount = mesh.indices.size();
+    float previousError = 0.0f;
+
+    for (const MeshLOD& lod : mesh.lods)
+    {
+        EXPECT_LT(lod.indices.size(), previousIndexCount);
+        EXPECT_GE(lod.error, previousError);
+        EXPECT_LE(lod.error, MeshSimplification::MAX_LOD_ERROR * mesh.boundingRadius);
+        EXPECT_TRUE(std::all_of(lod.indices.begin(), lod.indices.end(), [&mesh](uint32_t index)
+            { return index < mesh.vertices.size(); }));
+
+        previousIndexCount = lod.indices.size();
+        previousError = lod.error;
+    }
+}
+
+TEST(MeshSimplificationTests, MeshWithoutTrianglesHasNoLODs)
+{
+    // Arrange
+    CPUMesh<Vertex> mesh {};
+    mesh.boundingRadius = 1.0f;
+
+    // Act
+    MeshSimplification::GenerateLODs(mesh);
+
+    // Assert
+    EXPECT_TRUE(mesh.lods.empty());
+}
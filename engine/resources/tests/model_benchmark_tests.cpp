@@ -0,0 +1,199 @@
+#include "cooked_model.hpp"
+#include "file_io.hpp"
+#include "log.hpp"
+#include "model_loading.hpp"
+#include "model_test_helpers.hpp"
+#include "physics/shape_factory.hpp"
+#include "thread_pool.hpp"
+#include "timers.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <thread>
+
+// Cost of loading models: reading and processing the glTF, and loading its cooked form instead.
+// They are disabled so they don't slow down every test run, run only these with --gtest_also_run_disabled_tests --gtest_filter=ResourcesBenchmarks.*
+
+namespace
+{
+
+const std::filesystem::path BENCHMARK_DIRECTORY = "cache/tests/model_benchmarks";
+
+}
+
+TEST(ResourcesBenchmarks, DISABLED_CookedModelLoad)
+{
+    // 32 grids of 128 by 128 quads, about a million triangles without normals and tangents
+    constexpr uint32_t GRID_SIZE = 128;
+    constexpr uint32_t GRID_COUNT = 32;
+    constexpr uint32_t ITERATIONS = 3;
+
+    fileIO::Init(true);
+    std::filesystem::remove_all(BENCHMARK_DIRECTORY);
+
+    ThreadPool threadPool { std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+    threadPool.Start();
+
+    const std::string sourcePath = (BENCHMARK_DIRECTORY / "large_model.glb").generic_string();
+    TestGLBWriter::Write(sourcePath, GRID_SIZE, GRID_COUNT);
+
+    const std::string cookedPath = CookedModel::GetCookedPath(sourcePath);
+    const std::optional<CookedModel::Key> key = CookedModel::MakeSourceKey(sourcePath);
+    ASSERT_TRUE(key.has_value());
+
+    float gltfTime = 0.0f;
+    float cookedTime = 0.0f;
+    size_t triangleCount = 0;
+
+    {
+        CPUModel model = ModelLoading::LoadGLTFFast(threadPool, sourcePath, false);
+        ASSERT_TRUE(CookedModel::Save(model, cookedPath, key.value()));
+
+        for (const auto& mesh : model.meshes)
+            triangleCount += mesh.indices.size() / 3;
+    }
+
+    for (uint32_t i = 0; i < ITERATIONS; ++i)
+    {
+        Stopwatch gltfStopwatch {};
+        CPUModel gltfModel = ModelLoading::LoadGLTFFast(threadPool, sourcePath, false);
+        gltfTime += gltfStopwatch.GetElapsed().count() / static_cast<float>(ITERATIONS);
+
+        Stopwatch cookedStopwatch {};
+        std::optional<CPUModel> cookedModel = CookedModel::Load(cookedPath, key);
+        cookedTime += cookedStopwatch.GetElapsed().count() / static_cast<float>(ITERATIONS);
+
+        ASSERT_TRUE(cookedModel.has_value());
+        ASSERT_EQ(gltfModel.meshes.size(), cookedModel->meshes.size());
+    }
+
+    bblog::info("[ResourcesBenchmarks] {} triangles in {} meshes: glTF {:.2f}ms, cooked {:.2f}ms, {:.1f}x faster ({} bytes cooked)",
+        triangleCount, GRID_COUNT, gltfTime, cookedTime, gltfTime / cookedTime, std::filesystem::file_size(cookedPath));
+
+    RecordProperty("gltfLoadMs", std::to_string(gltfTime));
+    RecordProperty("cookedLoadMs", std::to_string(cookedTime));
+
+    EXPECT_LT(cookedTime, gltfTime);
+
+    std::filesystem::remove_all(BENCHMARK_DIRECTORY);
+    fileIO::Deinit();
+}
+
+TEST(ResourcesBenchmarks, DISABLED_ParallelPrimitiveProcessing)
+{
+    // A level sized file, 64 grids of 64 by 64 quads with colliders
+    constexpr uint32_t GRID_SIZE = 64;
+    constexpr uint32_t GRID_COUNT = 64;
+
+    EnsureJoltRegistered();
+    ShapeCache& shapeCache = ShapeFactory::GetCache();
+    shapeCache.SetDiskCacheEnabled(false);
+    shapeCache.ClearMemory();
+
+    fileIO::Init(true);
+    std::filesystem::remove_all(BENCHMARK_DIRECTORY);
+
+    const uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    ThreadPool threadPool { threadCount };
+    threadPool.Start();
+
+    const std::string sourcePath = (BENCHMARK_DIRECTORY / "level.glb").generic_string();
+    TestGLBWriter::Write(sourcePath, GRID_SIZE, GRID_COUNT);
+
+    // The serial loader processes the primitives on the calling thread, the colliders are cooked after it
+    Stopwatch serialStopwatch {};
+    CPUModel serial = ModelLoading::LoadGLTF(sourcePath);
+    ModelLoading::GenerateColliders(serial);
+    const float serialTime = serialStopwatch.GetElapsed().count();
+
+    shapeCache.ClearMemory();
+
+    Stopwatch parallelStopwatch {};
+    CPUModel parallel = ModelLoading::LoadGLTFFast(threadPool, sourcePath, true);
+    const float parallelTime = parallelStopwatch.GetElapsed().count();
+
+    bblog::info("[ResourcesBenchmarks] {} meshes with colliders: serial {:.2f}ms, parallel {:.2f}ms on {} threads, {:.1f}x faster",
+        parallel.meshes.size(), serialTime, parallelTime, threadCount, serialTime / parallelTime);
+
+    RecordProperty("serialPrimitivesMs", std::to_string(serialTime));
+    RecordProperty("parallelPrimitivesMs", std::to_string(parallelTime));
+
+    ASSERT_EQ(serial.meshes.size(), parallel.meshes.size());
+    ASSERT_EQ(parallel.colliders.size(), parallel.meshes.size());
+
+    if (threadCount > 1)
+        EXPECT_LT(parallelTime, serialTime);
+
+    shapeCache.ClearMemory();
+    shapeCache.SetDiskCacheEnabled(true);
+
+    std::filesystem::remove_all(BENCHMARK_DIRECTORY);
+    fileIO::Deinit();
+}
+
+TEST(ResourcesBenchmarks, DISABLED_GLTFFileAccess)
+{
+    // The game archive is a zip file, this one is stored without compression, so reading from data.bin costs more
+    constexpr uint32_t GRID_SIZE = 128;
+    constexpr uint32_t GRID_COUNT = 8;
+
+    fileIO::Init(true);
+    std::filesystem::remove_all(BENCHMARK_DIRECTORY);
+
+    ThreadPool threadPool { std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+    threadPool.Start();
+
+    const std::vector<char> glb = TestGLBWriter::Make(GRID_SIZE, GRID_COUNT);
+    TestGLBWriter::Write(BENCHMARK_DIRECTORY / "level.glb", GRID_SIZE, GRID_COUNT);
+    WriteStoredZip(BENCHMARK_DIRECTORY / "archive.zip", "level.glb", glb);
+
+    ASSERT_TRUE(PhysFS::mount((BENCHMARK_DIRECTORY / "archive.zip").generic_string(), "archive", true));
+
+    const std::pair<std::string, std::string> locations[] = {
+        { "native", (BENCHMARK_DIRECTORY / "level.glb").generic_string() },
+        { "archive", "archive/level.glb" },
+    };
+
+    for (const auto& [location, path] : locations)
+    {
+        // Reading through the buffered stream, like the parser did before for every request
+        uint64_t ioCalls = PhysFS::getIOCallCount();
+        Stopwatch streamStopwatch {};
+        {
+            auto stream = fileIO::OpenReadStream(path);
+            ASSERT_TRUE(stream.has_value());
+            ASSERT_EQ(fileIO::DumpStreamIntoBytes(stream.value()).size(), glb.size());
+        }
+        const float streamTime = streamStopwatch.GetElapsed().count();
+        const uint64_t streamCalls = PhysFS::getIOCallCount() - ioCalls;
+
+        ioCalls = PhysFS::getIOCallCount();
+        Stopwatch bulkStopwatch {};
+        ASSERT_TRUE(fileIO::ReadFileBytes(path).has_value());
+        const float bulkTime = bulkStopwatch.GetElapsed().count();
+        const uint64_t bulkCalls = PhysFS::getIOCallCount() - ioCalls;
+
+        ioCalls = PhysFS::getIOCallCount();
+        Stopwatch loadStopwatch {};
+        CPUModel model = ModelLoading::LoadGLTFFast(threadPool, path, false);
+        const float loadTime = loadStopwatch.GetElapsed().count();
+        const uint64_t loadCalls = PhysFS::getIOCallCount() - ioCalls;
+
+        bblog::info("[ResourcesBenchmarks] {} {} bytes: stream {:.2f}ms in {} I/O calls, bulk {:.2f}ms in {} I/O calls, model load {:.2f}ms in {} I/O calls",
+            location, glb.size(), streamTime, streamCalls, bulkTime, bulkCalls, loadTime, loadCalls);
+
+        RecordProperty(location + "StreamIOCalls", std::to_string(streamCalls));
+        RecordProperty(location + "LoadIOCalls", std::to_string(loadCalls));
+        RecordProperty(location + "LoadMs", std::to_string(loadTime));
+
+        ASSERT_EQ(model.meshes.size(), GRID_COUNT);
+        EXPECT_EQ(bulkCalls, 1);
+
+        // Files on disk are mapped instead of read when fastgltf supports it
+        EXPECT_LE(loadCalls, 1);
+    }
+
+    fileIO::Deinit();
+    std::filesystem::remove_all(BENCHMARK_DIRECTORY);
+}
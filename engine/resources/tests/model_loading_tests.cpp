@@ -0,0 +1,265 @@
+#include "file_io.hpp"
+#include "mesh_optimization.hpp"
+#include "mesh_simplification.hpp"
+#include "model_loading.hpp"
+#include "model_test_helpers.hpp"
+#include "physics/shape_factory.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+const std::filesystem::path TEST_DIRECTORY = "cache/tests/model_loading";
+
+}
+
+class ModelLoadingTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        EnsureJoltRegistered();
+        ShapeFactory::GetCache().SetDiskCacheEnabled(false);
+
+        fileIO::Init(true);
+        std::filesystem::remove_all(TEST_DIRECTORY);
+
+        _sourcePath = (TEST_DIRECTORY / "test_level.glb").generic_string();
+        TestGLBWriter::Write(_sourcePath, 16, 12);
+    }
+
+    void TearDown() override
+    {
+        fileIO::Deinit();
+        std::filesystem::remove_all(TEST_DIRECTORY);
+
+        ShapeFactory::GetCache().ClearMemory();
+        ShapeFactory::GetCache().SetDiskCacheEnabled(true);
+    }
+
+    std::string _sourcePath {};
+};
+
+TEST_F(ModelLoadingTests, ParallelMeshesMatchSerialLoader)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    // Act
+    CPUModel serial = ModelLoading::LoadGLTF(_sourcePath);
+    CPUModel parallel = ModelLoading::LoadGLTFFast(threadPool, _sourcePath, false);
+
+    // Assert
+    ASSERT_EQ(parallel.meshes.size(), 12);
+    ASSERT_EQ(serial.meshes.size(), parallel.meshes.size());
+    ASSERT_EQ(serial.skinnedMeshes.size(), parallel.skinnedMeshes.size());
+
+    for (size_t i = 0; i < serial.meshes.size(); ++i)
+        ExpectSameMesh(serial.meshes[i], parallel.meshes[i]);
+
+    for (size_t i = 0; i < serial.skinnedMeshes.size(); ++i)
+        ExpectSameMesh(serial.skinnedMeshes[i], parallel.skinnedMeshes[i]);
+}
+
+TEST_F(ModelLoadingTests, ThreadCountDoesNotChangeResult)
+{
+    // Arrange
+    ThreadPool singleThread { 1 };
+    singleThread.Start();
+
+    ThreadPool multiThread { 8 };
+    multiThread.Start();
+
+    // Act
+    CPUModel first = ModelLoading::LoadGLTFFast(singleThread, _sourcePath, false);
+    CPUModel second = ModelLoading::LoadGLTFFast(multiThread, _sourcePath, false);
+
+    // Assert
+    ExpectSameModel(first, second);
+}
+
+TEST_F(ModelLoadingTests, CollidersMatchTheirMeshes)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    // Act
+    CPUModel model = ModelLoading::LoadGLTFFast(threadPool, _sourcePath, true);
+
+    CPUModel serial = model;
+    ModelLoading::GenerateColliders(serial);
+
+    // Assert, the shape cache gives back the same shape for the same mesh, so a collider in the wrong place shows up as a different pointer
+    ASSERT_EQ(model.colliders.size(), model.meshes.size());
+    ASSERT_EQ(serial.colliders.size(), model.colliders.size());
+
+    for (size_t i = 0; i < model.colliders.size(); ++i)
+    {
+        ASSERT_NE(model.colliders[i], nullptr);
+        EXPECT_EQ(model.colliders[i], serial.colliders[i]);
+    }
+}
+
+TEST_F(ModelLoadingTests, MeshNodesPointAtTheirMeshes)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    // Act
+    CPUModel model = ModelLoading::LoadGLTFFast(threadPool, _sourcePath, false);
+
+    // Assert, every grid node has the grid mesh it was written with as its only child
+    for (uint32_t grid = 0; grid < 12; ++grid)
+    {
+        auto it = std::find_if(model.hierarchy.nodes.begin(), model.hierarchy.nodes.end(), [grid](const Node& node)
+            { return node.name == "Grid" + std::to_string(grid); });
+
+        ASSERT_NE(it, model.hierarchy.nodes.end());
+        ASSERT_EQ(it->childrenIndices.size(), 1);
+
+        const Node& meshNode = model.hierarchy.nodes[it->childrenIndices[0]];
+        ASSERT_TRUE(meshNode.mesh.has_value());
+        EXPECT_EQ(meshNode.mesh->type, MeshType::eSTATIC);
+        EXPECT_EQ(meshNode.mesh->index, grid);
+    }
+}
+
+TEST_F(ModelLoadingTests, MeshesAreOptimizedForTheVertexCache)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    // Act
+    CPUModel model = ModelLoading::LoadGLTFFast(threadPool, _sourcePath, false);
+
+    // Assert, the grids are written row by row, which misses the cache about once per triangle
+    ASSERT_EQ(model.meshes.size(), 12);
+
+    for (const CPUMesh<Vertex>& mesh : model.meshes)
+    {
+        const MeshOptimization::VertexCacheStatistics statistics = MeshOptimization::AnalyzeVertexCache(mesh.indices, static_cast<uint32_t>(mesh.vertices.size()));
+
+        EXPECT_EQ(mesh.vertices.size(), 17 * 17);
+        EXPECT_LT(statistics.acmr, 0.8f);
+    }
+}
+
+TEST_F(ModelLoadingTests, LoadingSkipsLODs)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    // Act
+    CPUModel model = ModelLoading::LoadGLTFFast(threadPool, _sourcePath, false);
+
+    // Assert
+    ASSERT_FALSE(model.meshes.empty());
+    EXPECT_TRUE(std::all_of(model.meshes.begin(), model.meshes.end(), [](const CPUMesh<Vertex>& mesh)
+        { return mesh.lods.empty(); }));
+}
+
+TEST_F(ModelLoadingTests, MeshesHaveSimplerLODs)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+    CPUModel model = ModelLoading::LoadGLTFFast(threadPool, _sourcePath, false);
+
+    // Act
+    ModelLoading::GenerateLODs(threadPool, model);
+
+    // Assert
+    ASSERT_EQ(model.meshes.size(), 12);
+
+    for (const CPUMesh<Vertex>& mesh : model.meshes)
+    {
+        ASSERT_FALSE(mesh.lods.empty());
+        ASSERT_LE(mesh.lods.size(), MeshSimplification::MAX_LODS);
+
+        size_t previousCount = mesh.indices.size();
+        for (const MeshLOD& lod : mesh.lods)
+        {
+            EXPECT_LT(lod.indices.size(), previousCount);
+            EXPECT_LE(lod.error, MeshSimplification::MAX_LOD_ERROR * mesh.boundingRadius);
+            EXPECT_TRUE(std::all_of(lod.indices.begin(), lod.indices.end(), [&mesh](uint32_t index)
+                { return index < mesh.vertices.size(); }));
+
+            previousCount = lod.indices.size();
+        }
+    }
+}
+
+TEST_F(ModelLoadingTests, ArchiveLoadsSameAsNative)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    WriteStoredZip(TEST_DIRECTORY / "archive.zip", "test_level.glb", TestGLBWriter::Make(16, 12));
+    ASSERT_TRUE(PhysFS::mount((TEST_DIRECTORY / "archive.zip").generic_string(), "archive", true));
+
+    // Act
+    CPUModel native = ModelLoading::LoadGLTFFast(threadPool, _sourcePath, false);
+    CPUModel archived = ModelLoading::LoadGLTFFast(threadPool, "archive/test_level.glb", false);
+
+    // Assert
+    EXPECT_TRUE(fileIO::GetNativePath(_sourcePath).has_value());
+    EXPECT_FALSE(fileIO::GetNativePath("archive/test_level.glb").has_value());
+
+    ExpectSameModel(native, archived);
+}
+
+TEST_F(ModelLoadingTests, ArchiveLoadsExternalBuffers)
+{
+    // Arrange
+    ThreadPool threadPool { 4 };
+    threadPool.Start();
+
+    auto [gltf, buffer] = TestGLBWriter::MakeGLTF(16, 12, "test_level.bin");
+    WriteStoredZip(TEST_DIRECTORY / "archive.zip", { { "models/test_level.gltf", gltf }, { "models/test_level.bin", buffer } });
+    ASSERT_TRUE(PhysFS::mount((TEST_DIRECTORY / "archive.zip").generic_string(), "archive", true));
+
+    // Act
+    CPUModel native = ModelLoading::LoadGLTFFast(threadPool, _sourcePath, false);
+    CPUModel archived = ModelLoading::LoadGLTFFast(threadPool, "archive/models/test_level.gltf", false);
+
+    // Assert
+    EXPECT_FALSE(fileIO::GetNativePath("archive/models/test_level.bin").has_value());
+
+    ExpectSameModel(native, archived);
+}
+
+TEST_F(ModelLoadingTests, MissingExternalBufferThrows)
+{
+    // Arrange
+    ThreadPool threadPool { 1 };
+    threadPool.Start();
+
+    auto [gltf, buffer] = TestGLBWriter::MakeGLTF(16, 12, "missing.bin");
+    WriteStoredZip(TEST_DIRECTORY / "archive.zip", "test_level.gltf", gltf);
+    ASSERT_TRUE(PhysFS::mount((TEST_DIRECTORY / "archive.zip").generic_string(), "archive", true));
+
+    // Act & Assert
+    EXPECT_THROW(static_cast<void>(ModelLoading::LoadGLTFFast(threadPool, "archive/test_level.gltf", false)), std::runtime_error);
+}
+
+TEST_F(ModelLoadingTests, MissingFileThrows)
+{
+    // Arrange
+    ThreadPool threadPool { 1 };
+    threadPool.Start();
+
+    // Act & Assert
+    EXPECT_THROW(static_cast<void>(ModelLoading::LoadGLTFFast(threadPool, (TEST_DIRECTORY / "missing.glb").generic_string(), false)), std::runtime_error);
+}
@@ -0,0 +1,497 @@
+#pragma once
+
+#include "cpu_resources.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Core/Factory.h>
+#include <Jolt/RegisterTypes.h>
+
+// Jolt needs its allocator, factory and types registered once before the loader can cook colliders
+inline void EnsureJoltRegistered()
+{
+    if (JPH::Factory::sInstance != nullptr)
+        return;
+
+    JPH::RegisterDefaultAllocator();
+    JPH::Factory::sInstance = new JPH::Factory();
+    JPH::RegisterTypes();
+}
+
+// Writes binary glTF files for the model loading tests, so they don't depend on the game assets.
+// Every model has gridMeshCount grids of gridSize by gridSize quads without normals or tangents, so the loader has to generate them,
+// and a skinned quad with a skeleton of two joints, an animation moving the second joint and a point light.
+class TestGLBWriter
+{
+public:
+    static std::vector<char> Make(uint32_t gridSize, uint32_t gridMeshCount = 1)
+    {
+        TestGLBWriter writer {};
+        writer.Build(gridSize, gridMeshCount);
+        return writer.TakeGLB();
+    }
+
+    // Makes the same model as a glTF, with its binary buffer stored in a separate file named bufferName
+    static std::pair<std::vector<char>, std::vector<char>> MakeGLTF(uint32_t gridSize, uint32_t gridMeshCount, const std::string& bufferName)
+    {
+        TestGLBWriter writer {};
+        writer.Build(gridSize, gridMeshCount);
+
+        const std::string json = writer.TakeJSON(",\"uri\":\"" + bufferName + "\"");
+        return { std::vector<char> { json.begin(), json.end() }, std::move(writer._buffer) };
+    }
+
+    static void Write(const std::filesystem::path& path, uint32_t gridSize, uint32_t gridMeshCount = 1)
+    {
+        const std::vector<char> bytes = Make(gridSize, gridMeshCount);
+
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file { path, std::ios::out | std::ios::trunc | std::ios::binary };
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+private:
+    std::vector<char> _buffer {};
+    std::vector<std::string> _bufferViews {};
+    std::vector<std::string> _accessors {};
+    std::vector<std::string> _meshes {};
+    std::vector<std::string> _nodes {};
+    std::vector<uint32_t> _sceneNodes {};
+    std::string _skin {};
+    std::string _animation {};
+
+    // Adds the values as a buffer view and an accessor over it, returns the index of the accessor
+    template <typename T>
+    uint32_t AddAccessor(const std::vector<T>& values, uint32_t componentType, std::string_view type, uint32_t count, std::string_view extra = "")
+    {
+        while (_buffer.size() % 4 != 0)
+            _buffer.push_back(0);
+
+        const size_t offset = _buffer.size();
+        const size_t size = values.size() * sizeof(T);
+        _buffer.resize(offset + size);
+        std::memcpy(_buffer.data() + offset, values.data(), size);
+
+        _bufferViews.emplace_back("{\"buffer\":0,\"byteOffset\":" + std::to_string(offset) + ",\"byteLength\":" + std::to_string(size) + "}");
+        _accessors.emplace_back("{\"bufferView\":" + std::to_string(_bufferViews.size() - 1) + ",\"componentType\":" + std::to_string(componentType)
+            + ",\"count\":" + std::to_string(count) + ",\"type\":\"" + std::string { type } + "\"" + std::string { extra } + "}");
+
+        return static_cast<uint32_t>(_accessors.size() - 1);
+    }
+
+    static std::string Vec3Json(const glm::vec3& value)
+    {
+        return "[" + std::to_string(value.x) + "," + std::to_string(value.y) + "," + std::to_string(value.z) + "]";
+    }
+
+    void AddGrid(uint32_t gridSize, uint32_t gridIndex)
+    {
+        std::vector<glm::vec3> positions {};
+        std::vector<glm::vec2> texCoords {};
+        std::vector<uint32_t> indices {};
+
+        glm::vec3 min { std::numeric_limits<float>::max() };
+        glm::vec3 max { std::numeric_limits<float>::lowest() };
+
+        for (uint32_t z = 0; z <= gridSize; ++z)
+        {
+            for (uint32_t x = 0; x <= gridSize; ++x)
+            {
+                const float height = std::sin(static_cast<float>(x + gridIndex) * 0.4f) * std::cos(static_cast<float>(z) * 0.3f);
+                positions.emplace_back(static_cast<float>(x), height, static_cast<float>(z));
+                texCoords.emplace_back(static_cast<float>(x) / static_cast<float>(gridSize), static_cast<float>(z) / static_cast<float>(gridSize));
+
+                min = glm::min(min, positions.back());
+                max = glm::max(max, positions.back());
+            }
+        }
+
+        for (uint32_t z = 0; z < gridSize; ++z)
+        {
+            for (uint32_t x = 0; x < gridSize; ++x)
+            {
+                const uint32_t i = z * (gridSize + 1) + x;
+                indices.insert(indices.end(), { i, i + gridSize + 1, i + 1, i + 1, i + gridSize + 1, i + gridSize + 2 });
+            }
+        }
+
+        const uint32_t count = static_cast<uint32_t>(positions.size());
+        const uint32_t position = AddAccessor(positions, 5126, "VEC3", count, ",\"min\":" + Vec3Json(min) + ",\"max\":" + Vec3Json(max));
+        const uint32_t texCoord = AddAccessor(texCoords, 5126, "VEC2", count);
+
+        // Small grids use 16 bit indices, like most exporters do
+        uint32_t index = 0;
+        if (count <= 0xFFFF)
+            index = AddAccessor(std::vector<uint16_t> { indices.begin(), indices.end() }, 5123, "SCALAR", static_cast<uint32_t>(indices.size()));
+        else
+            index = AddAccessor(indices, 5125, "SCALAR", static_cast<uint32_t>(indices.size()));
+
+        _meshes.emplace_back("{\"primitives\":[{\"attributes\":{\"POSITION\":" + std::to_string(position) + ",\"TEXCOORD_0\":" + std::to_string(texCoord)
+            + "},\"indices\":" + std::to_string(index) + ",\"material\":0}]}");
+
+        _sceneNodes.emplace_back(static_cast<uint32_t>(_nodes.size()));
+        _nodes.emplace_back("{\"name\":\"Grid" + std::to_string(gridIndex) + "\",\"mesh\":" + std::to_string(_meshes.size() - 1)
+            + ",\"translation\":[" + std::to_string(gridIndex * gridSize) + ",0,0]}");
+    }
+
+    void AddCharacter()
+    {
+        const std::vector<glm::vec3> positions { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 2.0f, 0.0f }, { 1.0f, 2.0f, 0.0f } };
+        const std::vector<glm::vec3> normals(4, glm::vec3 { 0.0f, 0.0f, 1.0f });
+        const std::vector<glm::vec2> texCoords { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } };
+        const std::vector<uint8_t> joints { 0, 1, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 };
+        const std::vector<glm::vec4> weights { { 0.75f, 0.25f, 0.0f, 0.0f }, { 0.75f, 0.25f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 0.0f } };
+        const std::vector<uint16_t> indices { 0, 1, 2, 2, 1, 3 };
+
+        const uint32_t position = AddAccessor(positions, 5126, "VEC3", 4, ",\"min\":[0,0,0],\"max\":[1,2,0]");
+        const uint32_t normal = AddAccessor(normals, 5126, "VEC3", 4);
+        const uint32_t texCoord = AddAccessor(texCoords, 5126, "VEC2", 4);
+        const uint32_t joint = AddAccessor(joints, 5121, "VEC4", 4);
+        const uint32_t weight = AddAccessor(weights, 5126, "VEC4", 4);
+        const uint32_t index = AddAccessor(indices, 5123, "SCALAR", 6);
+
+        _meshes.emplace_back("{\"primitives\":[{\"attributes\":{\"POSITION\":" + std::to_string(position) + ",\"NORMAL\":" + std::to_string(normal)
+            + ",\"TEXCOORD_0\":" + std::to_string(texCoord) + ",\"JOINTS_0\":" + std::to_string(joint) + ",\"WEIGHTS_0\":" + std::to_string(weight)
+            + "},\"indices\":" + std::to_string(index) + ",\"material\":0}]}");
+
+        const uint32_t characterNode = static_cast<uint32_t>(_nodes.size());
+        const uint32_t rootJoint = characterNode + 1;
+        const uint32_t childJoint = characterNode + 2;
+
+        _sceneNodes.insert(_sceneNodes.end(), { characterNode, rootJoint });
+        _nodes.emplace_back("{\"name\":\"Character\",\"mesh\":" + std::to_string(_meshes.size() - 1) + ",\"skin\":0}");
+        _nodes.emplace_back("{\"name\":\"Hips\",\"children\":[" + std::to_string(childJoint) + "]}");
+        _nodes.emplace_back("{\"name\":\"Hand\",\"translation\":[0,1,0]}");
+
+        std::vector<float> inverseBindMatrices {};
+        for (const glm::mat4& matrix : { glm::mat4 { 1.0f }, glm::translate(glm::mat4 { 1.0f }, glm::vec3 { 0.0f, -1.0f, 0.0f }) })
+            inverseBindMatrices.insert(inverseBindMatrices.end(), glm::value_ptr(matrix), glm::value_ptr(matrix) + 16);
+
+        const uint32_t inverseBind = AddAccessor(inverseBindMatrices, 5126, "MAT4", 2);
+        _skin = "{\"joints\":[" + std::to_string(rootJoint) + "," + std::to_string(childJoint) + "],\"inverseBindMatrices\":" + std::to_string(inverseBind) + "}";
+
+        const uint32_t times = AddAccessor(std::vector<float> { 0.0f, 0.5f, 1.0f }, 5126, "SCALAR", 3, ",\"min\":[0],\"max\":[1]");
+        const uint32_t translations = AddAccessor(std::vector<glm::vec3> { { 0.0f, 1.0f, 0.0f }, { 0.5f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } }, 5126, "VEC3", 3);
+
+        _animation = "{\"name\":\"Wave\",\"samplers\":[{\"input\":" + std::to_string(times) + ",\"output\":" + std::to_string(translations)
+            + ",\"interpolation\":\"LINEAR\"}],\"channels\":[{\"sampler\":0,\"target\":{\"node\":" + std::to_string(childJoint) + ",\"path\":\"translation\"}}]}";
+    }
+
+    void AddLight()
+    {
+        _sceneNodes.emplace_back(static_cast<uint32_t>(_nodes.size()));
+        _nodes.emplace_back("{\"name\":\"Lamp\",\"translation\":[2,3,4],\"extensions\":{\"KHR_lights_punctual\":{\"light\":0}}}");
+    }
+
+    void Build(uint32_t gridSize, uint32_t gridMeshCount)
+    {
+        for (uint32_t i = 0; i < gridMeshCount; ++i)
+            AddGrid(gridSize, i);
+
+        AddCharacter();
+        AddLight();
+    }
+
+    static std::string Join(const std::vector<std::string>& values)
+    {
+        std::string joined {};
+
+        for (size_t i = 0; i < values.size(); ++i)
+            joined += (i > 0 ? "," : "") + values[i];
+
+        return joined;
+    }
+
+    // Pads the buffer and returns the JSON describing the model, bufferExtra is appended to the description of the buffer
+    std::string TakeJSON(std::string_view bufferExtra = "")
+    {
+        std::vector<std::string> sceneNodes {};
+        for (uint32_t node : _sceneNodes)
+            sceneNodes.emplace_back(std::to_string(node));
+
+        while (_buffer.size() % 4 != 0)
+            _buffer.push_back(0);
+
+        std::string json = "{\"asset\":{\"version\":\"2.0\"},\"extensionsUsed\":[\"KHR_lights_punctual\"],"
+                           "\"extensions\":{\"KHR_lights_punctual\":{\"lights\":[{\"type\":\"point\",\"color\":[1,0.5,0.25],\"intensity\":20,\"range\":0.01}]}},"
+                           "\"scene\":0,\"scenes\":[{\"nodes\":["
+            + Join(sceneNodes) + "]}],"
+                                 "\"nodes\":["
+            + Join(_nodes) + "],\"meshes\":[" + Join(_meshes) + "],"
+            + "\"materials\":[{\"pbrMetallicRoughness\":{\"baseColorFactor\":[0.8,0.6,0.4,1],\"metallicFactor\":0.25,\"roughnessFactor\":0.75}}],"
+            + "\"skins\":[" + _skin + "],\"animations\":[" + _animation + "],"
+            + "\"accessors\":[" + Join(_accessors) + "],\"bufferViews\":[" + Join(_bufferViews) + "],"
+            + "\"buffers\":[{\"byteLength\":" + std::to_string(_buffer.size()) + std::string { bufferExtra } + "}]}";
+
+        return json;
+    }
+
+    std::vector<char> TakeGLB()
+    {
+        std::string json = TakeJSON();
+
+        while (json.size() % 4 != 0)
+            json.push_back(' ');
+
+        std::vector<char> glb {};
+        const auto append = [&glb](uint32_t value)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            glb.insert(glb.end(), bytes, bytes + sizeof(value));
+        };
+
+        append(0x46546C67); // "glTF"
+        append(2);
+        append(static_cast<uint32_t>(12 + 8 + json.size() + 8 + _buffer.size()));
+
+        append(static_cast<uint32_t>(json.size()));
+        append(0x4E4F534A); // "JSON"
+        glb.insert(glb.end(), json.begin(), json.end());
+
+        append(static_cast<uint32_t>(_buffer.size()));
+        append(0x004E4942); // "BIN"
+        glb.insert(glb.end(), _buffer.begin(), _buffer.end());
+
+        return glb;
+    }
+};
+
+// Writes a zip archive with uncompressed files, which PhysFS can mount like the game archive
+inline void WriteStoredZip(const std::filesystem::path& path, const std::vector<std::pair<std::string, std::vector<char>>>& files)
+{
+    std::vector<char> zip {};
+    std::vector<char> directory {};
+
+    const auto append = [](std::vector<char>& destination, auto value)
+    {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        destination.insert(destination.end(), bytes, bytes + sizeof(value));
+    };
+
+    for (const auto& [name, contents] : files)
+    {
+        uint32_t crc = 0xFFFFFFFF;
+        for (char c : contents)
+        {
+            crc ^= static_cast<uint8_t>(c);
+            for (uint32_t bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+        crc = ~crc;
+
+        const auto size = static_cast<uint32_t>(contents.size());
+        const auto nameSize = static_cast<uint16_t>(name.size());
+        const auto headerOffset = static_cast<uint32_t>(zip.size());
+
+        // Local file header, stored without compression
+        append(zip, uint32_t { 0x04034B50 });
+        append(zip, uint16_t { 20 });
+        append(zip, uint16_t { 0 });
+        append(zip, uint16_t { 0 });
+        append(zip, uint16_t { 0 });
+        append(zip, uint16_t { 0 });
+        append(zip, crc);
+        append(zip, size);
+        append(zip, size);
+        append(zip, nameSize);
+        append(zip, uint16_t { 0 });
+        zip.insert(zip.end(), name.begin(), name.end());
+        zip.insert(zip.end(), contents.begin(), contents.end());
+
+        // Central directory entry
+        append(directory, uint32_t { 0x02014B50 });
+        append(directory, uint16_t { 20 });
+        append(directory, uint16_t { 20 });
+        append(directory, uint16_t { 0 });
+        append(directory, uint16_t { 0 });
+        append(directory, uint16_t { 0 });
+        append(directory, uint16_t { 0 });
+        append(directory, crc);
+        append(directory, size);
+        append(directory, size);
+        append(directory, nameSize);
+        append(directory, uint16_t { 0 });
+        append(directory, uint16_t { 0 });
+        append(directory, uint16_t { 0 });
+        append(directory, uint16_t { 0 });
+        append(directory, uint32_t { 0 });
+        append(directory, headerOffset);
+        directory.insert(directory.end(), name.begin(), name.end());
+    }
+
+    const auto directoryOffset = static_cast<uint32_t>(zip.size());
+    const auto directorySize = static_cast<uint32_t>(directory.size());
+    const auto fileCount = static_cast<uint16_t>(files.size());
+    zip.insert(zip.end(), directory.begin(), directory.end());
+
+    // End of central directory
+    append(zip, uint32_t { 0x06054B50 });
+    append(zip, uint16_t { 0 });
+    append(zip, uint16_t { 0 });
+    append(zip, fileCount);
+    append(zip, fileCount);
+    append(zip, directorySize);
+    append(zip, directoryOffset);
+    append(zip, uint16_t { 0 });
+
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file { path, std::ios::out | std::ios::trunc | std::ios::binary };
+    file.write(zip.data(), static_cast<std::streamsize>(zip.size()));
+}
+
+inline void WriteStoredZip(const std::filesystem::path& path, const std::string& name, const std::vector<char>& contents)
+{
+    WriteStoredZip(path, { { name, contents } });
+}
+
+template <typename T>
+void ExpectSameMesh(const CPUMesh<T>& expected, const CPUMesh<T>& actual)
+{
+    ASSERT_EQ(expected.vertices.size(), actual.vertices.size());
+    EXPECT_EQ(std::memcmp(expected.vertices.data(), actual.vertices.data(), expected.vertices.size() * sizeof(T)), 0);
+    EXPECT_EQ(expected.indices, actual.indices);
+    EXPECT_EQ(expected.materialIndex, actual.materialIndex);
+    EXPECT_EQ(expected.boundingBox.min, actual.boundingBox.min);
+    EXPECT_EQ(expected.boundingBox.max, actual.boundingBox.max);
+    EXPECT_EQ(expected.boundingRadius, actual.boundingRadius);
+
+    ASSERT_EQ(expected.lods.size(), actual.lods.size());
+    for (size_t i = 0; i < expected.lods.size(); ++i)
+    {
+        EXPECT_EQ(expected.lods[i].indices, actual.lods[i].indices);
+        EXPECT_EQ(expected.lods[i].error, actual.lods[i].error);
+    }
+}
+
+template <typename T>
+void ExpectSameSpline(const std::optional<AnimationSpline<T>>& expected, const std::optional<AnimationSpline<T>>& actual)
+{
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+
+    if (expected.has_value())
+    {
+        EXPECT_EQ(expected->timestamps, actual->timestamps);
+        EXPECT_EQ(expected->values, actual->values);
+    }
+}
+
+// Compares everything the renderer and the ECS use from a model, the colliders are left out
+inline void ExpectSameModel(const CPUModel& expected, const CPUModel& actual)
+{
+    EXPECT_EQ(expected.name, actual.name);
+
+    ASSERT_EQ(expected.meshes.size(), actual.meshes.size());
+    for (size_t i = 0; i < expected.meshes.size(); ++i)
+        ExpectSameMesh(expected.meshes[i], actual.meshes[i]);
+
+    ASSERT_EQ(expected.skinnedMeshes.size(), actual.skinnedMeshes.size());
+    for (size_t i = 0; i < expected.skinnedMeshes.size(); ++i)
+        ExpectSameMesh(expected.skinnedMeshes[i], actual.skinnedMeshes[i]);
+
+    ASSERT_EQ(expected.textures.size(), actual.textures.size());
+    for (size_t i = 0; i < expected.textures.size(); ++i)
+    {
+        const CPUImage& a = expected.textures[i];
+        const CPUImage& b = actual.textures[i];
+
+        EXPECT_EQ(a.name, b.name);
+        EXPECT_EQ(a.initialData, b.initialData);
+        EXPECT_EQ(a.width, b.width);
+        EXPECT_EQ(a.height, b.height);
+        EXPECT_EQ(a.depth, b.depth);
+        EXPECT_EQ(a.layers, b.layers);
+        EXPECT_EQ(a.mips, b.mips);
+        EXPECT_EQ(a.flags, b.flags);
+        EXPECT_EQ(a.isHDR, b.isHDR);
+        EXPECT_EQ(a.format, b.format);
+        EXPECT_EQ(a.type, b.type);
+    }
+
+    ASSERT_EQ(expected.materials.size(), actual.materials.size());
+    for (size_t i = 0; i < expected.materials.size(); ++i)
+    {
+        const CPUMaterial& a = expected.materials[i];
+        const CPUMaterial& b = actual.materials[i];
+
+        EXPECT_EQ(a.albedoMap, b.albedoMap);
+        EXPECT_EQ(a.albedoFactor, b.albedoFactor);
+        EXPECT_EQ(a.metallicRoughnessMap, b.metallicRoughnessMap);
+        EXPECT_EQ(a.metallicFactor, b.metallicFactor);
+        EXPECT_EQ(a.roughnessFactor, b.roughnessFactor);
+        EXPECT_EQ(a.normalMap, b.normalMap);
+        EXPECT_EQ(a.normalScale, b.normalScale);
+        EXPECT_EQ(a.occlusionMap, b.occlusionMap);
+        EXPECT_EQ(a.occlusionStrength, b.occlusionStrength);
+        EXPECT_EQ(a.emissiveMap, b.emissiveMap);
+        EXPECT_EQ(a.emissiveFactor, b.emissiveFactor);
+    }
+
+    ASSERT_EQ(expected.animations.size(), actual.animations.size());
+    for (size_t i = 0; i < expected.animations.size(); ++i)
+    {
+        EXPECT_EQ(expected.animations[i].name, actual.animations[i].name);
+        EXPECT_EQ(expected.animations[i].duration, actual.animations[i].duration);
+        EXPECT_EQ(expected.animations[i].looping, actual.animations[i].looping);
+    }
+
+    EXPECT_EQ(expected.hierarchy.root, actual.hierarchy.root);
+    EXPECT_EQ(expected.hierarchy.skeletonRoot, actual.hierarchy.skeletonRoot);
+    ASSERT_EQ(expected.hierarchy.nodes.size(), actual.hierarchy.nodes.size());
+
+    for (size_t i = 0; i < expected.hierarchy.nodes.size(); ++i)
+    {
+        const Node& a = expected.hierarchy.nodes[i];
+        const Node& b = actual.hierarchy.nodes[i];
+
+        EXPECT_EQ(a.name, b.name);
+        EXPECT_EQ(a.transform, b.transform);
+        EXPECT_EQ(a.childrenIndices, b.childrenIndices);
+        EXPECT_EQ(a.skeletonNode, b.skeletonNode);
+
+        ASSERT_EQ(a.mesh.has_value(), b.mesh.has_value());
+        if (a.mesh.has_value())
+        {
+            EXPECT_EQ(a.mesh->type, b.mesh->type);
+            EXPECT_EQ(a.mesh->index, b.mesh->index);
+        }
+
+        ASSERT_EQ(a.light.has_value(), b.light.has_value());
+        if (a.light.has_value())
+        {
+            EXPECT_EQ(a.light->color, b.light->color);
+            EXPECT_EQ(a.light->type, b.light->type);
+            EXPECT_EQ(a.light->range, b.light->range);
+            EXPECT_EQ(a.light->intensity, b.light->intensity);
+        }
+
+        ASSERT_EQ(a.joint.has_value(), b.joint.has_value());
+        if (a.joint.has_value())
+        {
+            EXPECT_EQ(a.joint->index, b.joint->index);
+            EXPECT_EQ(a.joint->inverseBind, b.joint->inverseBind);
+        }
+
+        ASSERT_EQ(a.animationSplines.size(), b.animationSplines.size());
+        for (const auto& [animation, spline] : a.animationSplines)
+        {
+            ASSERT_TRUE(b.animationSplines.contains(animation));
+            ExpectSameSpline(spline.translation, b.animationSplines.at(animation).translation);
+            ExpectSameSpline(spline.rotation, b.animationSplines.at(animation).rotation);
+            ExpectSameSpline(spline.scaling, b.animationSplines.at(animation).scaling);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#include "log.hpp"
+#include "resource_manager.hpp"
+#include "timers.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+// Cost of copying handles and resolving them, like the renderer does for every draw.
+// They are disabled so they don't slow down every test run, run only these with --gtest_also_run_disabled_tests --gtest_filter=ResourcesBenchmarks.*
+
+namespace
+{
+
+struct BenchmarkResource
+{
+    uint32_t value;
+    uint32_t padding[15];
+};
+
+// The previous handle layout, resolving it meant locking the weak_ptr to its manager
+struct WeakPtrHandle
+{
+    uint32_t index;
+    uint8_t version;
+    std::weak_ptr<ResourceManager<BenchmarkResource>> manager;
+};
+
+}
+
+TEST(ResourcesBenchmarks, DISABLED_HandleAccess)
+{
+    constexpr uint32_t RESOURCE_COUNT = 1 << 16;
+    constexpr uint32_t ITERATIONS = 16;
+
+    auto manager = std::make_shared<ResourceManager<BenchmarkResource>>();
+    std::vector<ResourceHandle<BenchmarkResource>> handles {};
+    std::vector<WeakPtrHandle> weakPtrHandles {};
+
+    for (uint32_t i = 0; i < RESOURCE_COUNT; ++i)
+    {
+        handles.emplace_back(manager->Create(BenchmarkResource { i, {} }));
+        weakPtrHandles.emplace_back(WeakPtrHandle { handles.back().Index(), static_cast<uint8_t>(handles.back().Generation()), manager });
+    }
+
+    uint64_t handleSum = 0;
+    Stopwatch handleStopwatch {};
+
+    for (uint32_t iteration = 0; iteration < ITERATIONS; ++iteration)
+    {
+        std::vector<ResourceHandle<BenchmarkResource>> copies = handles;
+
+        for (const auto& handle : copies)
+            handleSum += manager->Access(handle)->value;
+    }
+
+    const float handleTime = handleStopwatch.GetElapsed().count();
+
+    uint64_t weakPtrSum = 0;
+    Stopwatch weakPtrStopwatch {};
+
+    for (uint32_t iteration = 0; iteration < ITERATIONS; ++iteration)
+    {
+        std::vector<WeakPtrHandle> copies = weakPtrHandles;
+
+        for (const auto& handle : copies)
+        {
+            if (auto locked = handle.manager.lock())
+                weakPtrSum += locked->Access(handle.index)->value;
+        }
+    }
+
+    const float weakPtrTime = weakPtrStopwatch.GetElapsed().count();
+
+    bblog::info("[ResourcesBenchmarks] {} handles copied and accessed {} times: generation handles {:.2f}ms, weak_ptr handles {:.2f}ms, {:.1f}x faster",
+        RESOURCE_COUNT, ITERATIONS, handleTime, weakPtrTime, weakPtrTime / handleTime);
+
+    RecordProperty("handleAccessMs", std::to_string(handleTime));
+    RecordProperty("weakPtrHandleAccessMs", std::to_string(weakPtrTime));
+
+    EXPECT_EQ(handleSum, weakPtrSum);
+    EXPECT_LT(handleTime, weakPtrTime);
+}
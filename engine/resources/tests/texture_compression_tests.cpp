@@ -0,0 +1,395 @@
+#include "texture_compression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+
+using namespace TextureCompression;
+
+CPUImage MakeImage(uint16_t width, uint16_t height, const std::function<std::array<uint8_t, 4>(uint32_t, uint32_t)>& pixel)
+{
+    std::vector<std::byte> data(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+            std::memcpy(data.data() + (y * width + x) * 4, pixel(x, y).data(), 4);
+    }
+
+    CPUImage image {};
+    image.SetSize(width, height).SetFormat(vk::Format::eR8G8B8A8Unorm).SetFlags(vk::ImageUsageFlagBits::eSampled).SetName("Test").SetData(std::move(data));
+    return image;
+}
+
+// Smooth blends between two colors like most albedo maps have, with some noise so the blocks are not perfect lines
+CPUImage MakeGradient(uint16_t width, uint16_t height, uint8_t alpha = 255)
+{
+    std::mt19937 random { 7 };
+    std::uniform_int_distribution<int32_t> noise { -3, 3 };
+
+    return MakeImage(width, height, [&](uint32_t x, uint32_t y)
+        {
+            const float blend = 0.5f + 0.5f * std::sin(x * 0.15f) * std::cos(y * 0.1f);
+            auto channel = [&](float from, float to)
+            { return static_cast<uint8_t>(std::clamp(static_cast<int32_t>(from + (to - from) * blend) + noise(random), 0, 255)); };
+
+            return std::array<uint8_t, 4> { channel(30.0f, 230.0f), channel(60.0f, 200.0f), channel(120.0f, 90.0f), alpha };
+        });
+}
+
+double PeakSignalToNoise(const std::vector<std::byte>& expected, const std::vector<std::byte>& actual, uint32_t channels = 4)
+{
+    double squaredError = 0.0;
+    size_t count = 0;
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        if (i % 4 >= channels)
+            continue;
+
+        const double difference = std::to_integer<int32_t>(expected[i]) - std::to_integer<int32_t>(actual[i]);
+        squaredError += difference * difference;
+        ++count;
+    }
+
+    if (squaredError == 0.0)
+        return std::numeric_limits<double>::infinity();
+
+    return 10.0 * std::log10(255.0 * 255.0 / (squaredError / count));
+}
+
+}
+
+TEST(TextureCompressionTests, MipSizesRoundUpToBlocks)
+{
+    EXPECT_EQ(GetMipSize(vk::Format::eR8G8B8A8Unorm, 13, 7, 0), 13 * 7 * 4);
+    EXPECT_EQ(GetMipSize(vk::Format::eR8G8B8A8Unorm, 13, 7, 1), 6 * 3 * 4);
+    EXPECT_EQ(GetMipSize(vk::Format::eBc7UnormBlock, 13, 7, 0), 4 * 2 * 16);
+    EXPECT_EQ(GetMipSize(vk::Format::eBc7UnormBlock, 13, 7, 3), 16);
+    EXPECT_EQ(GetMipSize(vk::Format::eBc4UnormBlock, 13, 7, 3), 8);
+    EXPECT_EQ(GetMipSize(vk::Format::eR32G32B32A32Sfloat, 4, 4, 0), 0);
+
+    EXPECT_EQ(GetFullMipCount(1, 1), 1);
+    EXPECT_EQ(GetFullMipCount(13, 7), 4);
+    EXPECT_EQ(GetFullMipCount(256, 16), 9);
+
+    EXPECT_EQ(GetMipChainSize(vk::Format::eBc5UnormBlock, 16, 16, 5), (16 + 4 + 1 + 1 + 1) * 16);
+}
+
+TEST(TextureCompressionTests, MipChainHasEveryLevelLargestFirst)
+{
+    // Arrange
+    CPUImage image = MakeGradient(13, 7);
+    const std::vector<std::byte> base = image.initialData;
+
+    // Act
+    GenerateMipChain(image);
+
+    // Assert
+    EXPECT_EQ(image.mips, 4);
+    EXPECT_TRUE(image.HasMipChain());
+    ASSERT_EQ(image.initialData.size(), (13 * 7 + 6 * 3 + 3 * 1 + 1 * 1) * 4);
+    EXPECT_TRUE(std::equal(base.begin(), base.end(), image.initialData.begin()));
+}
+
+TEST(TextureCompressionTests, MipsAverageTheLevelAbove)
+{
+    // Arrange
+    const std::array<uint8_t, 4> values = { 0, 100, 200, 40 };
+    CPUImage image = MakeImage(2, 2, [&](uint32_t x, uint32_t y)
+        { return std::array<uint8_t, 4> { values[y * 2 + x], 255, 0, 255 }; });
+
+    // Act
+    GenerateMipChain(image);
+
+    // Assert
+    ASSERT_EQ(image.mips, 2);
+    EXPECT_EQ(std::to_integer<uint8_t>(image.initialData[16]), 85);
+    EXPECT_EQ(std::to_integer<uint8_t>(image.initialData[17]), 255);
+    EXPECT_EQ(std::to_integer<uint8_t>(image.initialData[18]), 0);
+}
+
+TEST(TextureCompressionTests, NormalMapMipsStayNormalized)
+{
+    // Arrange, neighbouring normals lean away from each other, averaging them would make them shorter
+    CPUImage image = MakeImage(8, 8, [](uint32_t x, uint32_t y)
+        {
+            const glm::vec3 normal = glm::normalize(glm::vec3 { x % 2 == 0 ? -0.6f : 0.6f, y % 2 == 0 ? -0.3f : 0.3f, 0.7f });
+            return std::array<uint8_t, 4> { static_cast<uint8_t>(std::round((normal.x * 0.5f + 0.5f) * 255.0f)),
+                static_cast<uint8_t>(std::round((normal.y * 0.5f + 0.5f) * 255.0f)),
+                static_cast<uint8_t>(std::round((normal.z * 0.5f + 0.5f) * 255.0f)), 255 };
+        });
+
+    // Act
+    GenerateMipChain(image, true);
+
+    // Assert
+    for (size_t offset = 8 * 8 * 4; offset < image.initialData.size(); offset += 4)
+    {
+        const glm::vec3 normal = glm::vec3 { std::to_integer<uint8_t>(image.initialData[offset]),
+                                     std::to_integer<uint8_t>(image.initialData[offset + 1]),
+                                     std::to_integer<uint8_t>(image.initialData[offset + 2]) }
+                / 255.0f * 2.0f
+            - 1.0f;
+
+        EXPECT_NEAR(glm::length(normal), 1.0f, 0.02f);
+    }
+}
+
+TEST(TextureCompressionTests, BC4StaysWithinPaletteSpacing)
+{
+    // Arrange
+    std::array<uint8_t, PIXELS_PER_BLOCK> values {};
+    for (uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+        values[i] = static_cast<uint8_t>(40 + i * 11);
+
+    // Act
+    const std::array<uint8_t, PIXELS_PER_BLOCK> decoded = DecodeBC4(EncodeBC4(values));
+
+    // Assert, 8 entries between the smallest and the largest value are at most a 14th of the range away from any value
+    const int32_t maxError = (values.back() - values.front()) / 14 + 1;
+    for (uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+        EXPECT_LE(std::abs(decoded[i] - values[i]), maxError) << "pixel " << i;
+
+    EXPECT_EQ(decoded.front(), values.front());
+    EXPECT_EQ(decoded.back(), values.back());
+}
+
+TEST(TextureCompressionTests, BC4FlatBlockIsExact)
+{
+    // Arrange
+    std::array<uint8_t, PIXELS_PER_BLOCK> values {};
+    values.fill(173);
+
+    // Act
+    const std::array<uint8_t, PIXELS_PER_BLOCK> decoded = DecodeBC4(EncodeBC4(values));
+
+    // Assert
+    EXPECT_EQ(decoded, values);
+}
+
+TEST(TextureCompressionTests, BC5KeepsRedAndGreenApart)
+{
+    // Arrange
+    std::array<uint8_t, PIXELS_PER_BLOCK> red {};
+    std::array<uint8_t, PIXELS_PER_BLOCK> green {};
+    for (uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+    {
+        red[i] = static_cast<uint8_t>(i * 16);
+        green[i] = static_cast<uint8_t>(255 - i * 3);
+    }
+
+    // Act
+    const PixelBlock decoded = DecodeBC5(EncodeBC5(red, green));
+
+    // Assert
+    for (uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+    {
+        EXPECT_LE(std::abs(decoded[i][0] - red[i]), 240 / 14 + 1);
+        EXPECT_LE(std::abs(decoded[i][1] - green[i]), 45 / 14 + 1);
+        EXPECT_EQ(decoded[i][2], 0);
+        EXPECT_EQ(decoded[i][3], 255);
+    }
+}
+
+TEST(TextureCompressionTests, BC7SolidColorsAreWithinOne)
+{
+    for (const std::array<uint8_t, 4>& color : { std::array<uint8_t, 4> { 0, 0, 0, 255 }, std::array<uint8_t, 4> { 255, 255, 255, 255 },
+             std::array<uint8_t, 4> { 100, 201, 54, 255 }, std::array<uint8_t, 4> { 17, 88, 250, 128 }, std::array<uint8_t, 4> { 3, 2, 1, 0 } })
+    {
+        // Arrange
+        PixelBlock pixels {};
+        pixels.fill(color);
+
+        // Act
+        PixelBlock decoded {};
+        ASSERT_TRUE(DecodeBC7(EncodeBC7(pixels), decoded));
+
+        // Assert
+        for (uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+        {
+            for (uint32_t channel = 0; channel < 4; ++channel)
+                EXPECT_LE(std::abs(decoded[i][channel] - color[channel]), 1) << "channel " << channel;
+        }
+    }
+}
+
+TEST(TextureCompressionTests, BC7OpaqueBlocksKeepFullAlpha)
+{
+    // Arrange, the alpha test in the shaders discards everything below 1.0
+    std::mt19937 random { 3 };
+    std::uniform_int_distribution<uint32_t> distribution { 0, 255 };
+
+    for (uint32_t blockIndex = 0; blockIndex < 64; ++blockIndex)
+    {
+        PixelBlock pixels {};
+        for (auto& pixel : pixels)
+            pixel = { static_cast<uint8_t>(distribution(random)), static_cast<uint8_t>(distribution(random)), static_cast<uint8_t>(distribution(random)), 255 };
+
+        // Act
+        PixelBlock decoded {};
+        ASSERT_TRUE(DecodeBC7(EncodeBC7(pixels), decoded));
+
+        // Assert
+        for (const auto& pixel : decoded)
+            EXPECT_EQ(pixel[3], 255);
+    }
+}
+
+TEST(TextureCompressionTests, BC7FollowsGradients)
+{
+    // Arrange, colors and alpha along a line, which a single subset fits well
+    PixelBlock pixels {};
+    for (uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+        pixels[i] = { static_cast<uint8_t>(20 + i * 12), static_cast<uint8_t>(200 - i * 9), static_cast<uint8_t>(90 + i * 2), static_cast<uint8_t>(255 - i * 15) };
+
+    // Act
+    PixelBlock decoded {};
+    ASSERT_TRUE(DecodeBC7(EncodeBC7(pixels), decoded));
+
+    // Assert
+    for (uint32_t i = 0; i < PIXELS_PER_BLOCK; ++i)
+    {
+        for (uint32_t channel = 0; channel < 4; ++channel)
+            EXPECT_LE(std::abs(decoded[i][channel] - pixels[i][channel]), 6) << "pixel " << i << " channel " << channel;
+    }
+}
+
+TEST(TextureCompressionTests, DecodeBC7RejectsOtherModes)
+{
+    // Arrange, the first set bit is the mode, this block is written in mode 1
+    Block block {};
+    block[0] = std::byte { 0b10 };
+
+    // Act & Assert
+    PixelBlock decoded {};
+    EXPECT_FALSE(DecodeBC7(block, decoded));
+}
+
+TEST(TextureCompressionTests, CompressStoresEveryMip)
+{
+    // Arrange
+    CPUImage image = MakeGradient(64, 32);
+    CPUImage reference = image;
+    GenerateMipChain(reference);
+
+    // Act
+    Compress(image, BlockFormat::eBC7);
+
+    // Assert
+    EXPECT_EQ(image.format, vk::Format::eBc7UnormBlock);
+    EXPECT_EQ(image.mips, 7);
+    EXPECT_TRUE(image.HasMipChain());
+    EXPECT_EQ(image.initialData.size(), GetMipChainSize(vk::Format::eBc7UnormBlock, 64, 32, 7));
+
+    // A quarter of RGBA8 for the larger levels, the smallest levels are padded to whole blocks
+    EXPECT_LT(image.initialData.size(), reference.initialData.size() / 3);
+
+    const std::vector<std::byte> decoded = Decompress(image);
+    ASSERT_EQ(decoded.size(), reference.initialData.size());
+    EXPECT_GT(PeakSignalToNoise(reference.initialData, decoded), 38.0);
+}
+
+TEST(TextureCompressionTests, CompressKeepsPartialAlpha)
+{
+    // Arrange
+    CPUImage image = MakeGradient(16, 16, 100);
+    CPUImage reference = image;
+    GenerateMipChain(reference);
+
+    // Act
+    Compress(image, BlockFormat::eBC7);
+
+    // Assert
+    const std::vector<std::byte> decoded = Decompress(image);
+    ASSERT_EQ(decoded.size(), reference.initialData.size());
+    for (size_t i = 3; i < decoded.size(); i += 4)
+        EXPECT_NEAR(std::to_integer<int32_t>(decoded[i]), 100, 1);
+}
+
+TEST(TextureCompressionTests, CompressSingleChannelFormats)
+{
+    // Arrange
+    CPUImage occlusion = MakeGradient(32, 32);
+    CPUImage normals = MakeGradient(32, 32);
+    CPUImage reference = MakeGradient(32, 32);
+    GenerateMipChain(reference);
+
+    // Act
+    Compress(occlusion, BlockFormat::eBC4);
+    Compress(normals, BlockFormat::eBC5);
+
+    // Assert
+    EXPECT_EQ(occlusion.format, vk::Format::eBc4UnormBlock);
+    EXPECT_EQ(occlusion.initialData.size(), GetMipChainSize(vk::Format::eBc4UnormBlock, 32, 32, 6));
+    EXPECT_GT(PeakSignalToNoise(reference.initialData, Decompress(occlusion), 1), 38.0);
+
+    EXPECT_EQ(normals.format, vk::Format::eBc5UnormBlock);
+    EXPECT_EQ(normals.initialData.size(), GetMipChainSize(vk::Format::eBc5UnormBlock, 32, 32, 6));
+    EXPECT_GT(PeakSignalToNoise(reference.initialData, Decompress(normals), 2), 38.0);
+}
+
+TEST(TextureCompressionTests, CompressRejectsOtherFormats)
+{
+    // Arrange
+    CPUImage image {};
+    image.SetSize(4, 4).SetFormat(vk::Format::eR32G32B32A32Sfloat).SetData(std::vector<std::byte>(4 * 4 * 16));
+
+    // Act & Assert
+    EXPECT_THROW(Compress(image, BlockFormat::eBC7), std::runtime_error);
+}
+
+TEST(TextureCompressionTests, FormatsFollowMaterialUse)
+{
+    // Arrange
+    CPUModel model {};
+    for (uint32_t i = 0; i < 5; ++i)
+        model.textures.emplace_back(MakeGradient(8, 8));
+
+    CPUMaterial& first = model.materials.emplace_back();
+    first.albedoMap = 0;
+    first.normalMap = 1;
+    first.occlusionMap = 2;
+    first.metallicRoughnessMap = 3;
+
+    // The same texture as occlusion and metallic roughness, like ORM textures are
+    CPUMaterial& second = model.materials.emplace_back();
+    second.normalMap = 1;
+    second.occlusionMap = 3;
+
+    // Act
+    const std::vector<BlockFormat> formats = ChooseFormats(model);
+
+    // Assert
+    ASSERT_EQ(formats.size(), 5);
+    EXPECT_EQ(formats[0], BlockFormat::eBC7);
+    EXPECT_EQ(formats[1], BlockFormat::eBC5);
+    EXPECT_EQ(formats[2], BlockFormat::eBC4);
+    EXPECT_EQ(formats[3], BlockFormat::eBC7);
+    EXPECT_EQ(formats[4], BlockFormat::eBC7);
+}
+
+TEST(TextureCompressionTests, CompressingModelTwiceChangesNothing)
+{
+    // Arrange
+    CPUModel model {};
+    model.textures.emplace_back(MakeGradient(16, 8));
+    model.materials.emplace_back().normalMap = 0;
+
+    // Act
+    TextureCompression::CompressModelTextures(model);
+    const CPUImage first = model.textures[0];
+    TextureCompression::CompressModelTextures(model);
+
+    // Assert
+    EXPECT_EQ(first.format, vk::Format::eBc5UnormBlock);
+    EXPECT_EQ(first.initialData, model.textures[0].initialData);
+}
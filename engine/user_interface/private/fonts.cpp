@@ -85,7 +85,7 @@ std::shared_ptr<UIFont> LoadFromFile(const std::string& path, uint16_t character
         return nullptr;
     }
 
-    std::shared_ptr<UIFont> font = std::make_shared<UIFont>();
+    std::shared_ptr<UIFont> font = std::make_shared<UIFont>(context);
 
     FT_Set_Pixel_Sizes(fontFace, 0, characterHeight);
     font->metrics.resolutionY = characterHeight;
@@ -185,7 +185,7 @@ std::shared_ptr<UIFont> LoadFromFile(const std::string& path, uint16_t character
     samplerCreation.magFilter = vk::Filter::eNearest;
     static ResourceHandle<Sampler> sampler = context.Resources()->SamplerResourceManager().Create(samplerCreation);
 
-    font->fontAtlas = context.Resources()->ImageResourceManager().Create(image, sampler);
+    font->fontAtlas = font->resources.Own(context.Resources()->ImageResourceManager().Create(image, sampler));
     context.UpdateBindlessSet();
 
     FT_Done_Face(fontFace);
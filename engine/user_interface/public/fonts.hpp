@@ -1,6 +1,7 @@
 #pragma once
 
 #include "resource_manager.hpp"
+#include "resource_owner.hpp"
 #include <common.hpp>
 #include <glm/glm.hpp>
 #include <unordered_map>
@@ -10,6 +11,11 @@ struct GPUImage;
 
 struct UIFont
 {
+    explicit UIFont(GraphicsContext& context)
+        : resources(context)
+    {
+    }
+
     struct Character
     {
         glm::ivec2 size;
@@ -32,6 +38,9 @@ struct UIFont
     std::unordered_map<uint8_t, Character> characters;
     ResourceHandle<GPUImage> fontAtlas;
     FontMetrics metrics;
+
+    // Owns the atlas
+    ResourceOwner resources;
 };
 
 NO_DISCARD std::shared_ptr<UIFont> LoadFromFile(const std::string& path, uint16_t characterHeight, GraphicsContext& context);
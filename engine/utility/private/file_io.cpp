@@ -1,8 +1,36 @@
 #include "file_io.hpp"
+#include <atomic>
 #include <bit>
 #include <filesystem>
 #include <stb_image.h>
 
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+// Other processes writing the same file have another process ID, other threads of this process take another number from the counter
+std::filesystem::path MakeTemporaryPath(const std::filesystem::path& path)
+{
+    static std::atomic<uint32_t> counter = 0;
+
+#ifdef _WIN32
+    const int processID = _getpid();
+#else
+    const int processID = getpid();
+#endif
+
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += fmt::format(".{}.{}.tmp", processID, counter++);
+    return temporaryPath;
+}
+
+}
+
 std::optional<PhysFS::ifstream> fileIO::OpenReadStream(const std::string& path)
 {
     if (!PhysFS::exists(path))
@@ -44,6 +72,67 @@ bool fileIO::Exists(const std::string& path)
     return PhysFS::exists(path);
 }
 
+std::optional<std::filesystem::path> fileIO::GetNativePath(const std::string& path)
+{
+    if (!PhysFS::exists(path))
+    {
+        return std::nullopt;
+    }
+
+    // Archives are files on disk, only a directory means the file itself is on the native filesystem
+    std::filesystem::path realDirectory { PhysFS::getRealDir(path) };
+    std::error_code error {};
+
+    if (!std::filesystem::is_directory(realDirectory, error))
+    {
+        return std::nullopt;
+    }
+
+    // Paths are relative to where the directory is mounted, which is the root for the game directory
+    std::string relativePath = path;
+    const std::string mountPoint = PhysFS::getMountPoint(realDirectory.string());
+
+    if (mountPoint != "/" && relativePath.starts_with(mountPoint))
+    {
+        relativePath = relativePath.substr(mountPoint.size());
+    }
+
+    return realDirectory / relativePath;
+}
+
+std::optional<fileIO::FileInfo> fileIO::GetFileInfo(const std::string& path)
+{
+    if (const std::optional<std::filesystem::path> nativePath = GetNativePath(path))
+    {
+        std::error_code error {};
+        const uintmax_t size = std::filesystem::file_size(nativePath.value(), error);
+
+        if (error)
+        {
+            return std::nullopt;
+        }
+
+        const auto writeTime = std::filesystem::last_write_time(nativePath.value(), error);
+
+        if (error)
+        {
+            return std::nullopt;
+        }
+
+        return FileInfo { static_cast<uint64_t>(size), static_cast<int64_t>(writeTime.time_since_epoch().count()) };
+    }
+
+    // Not on the native filesystem, so inside an archive, which keeps the size and modification time of its files
+    PHYSFS_Stat stat {};
+
+    if (PHYSFS_stat(path.c_str(), &stat) == 0 || stat.filetype != PHYSFS_FILETYPE_REGULAR)
+    {
+        return std::nullopt;
+    }
+
+    return FileInfo { static_cast<uint64_t>(stat.filesize), stat.modtime };
+}
+
 bool fileIO::MakeDirectory(const std::string& path)
 {
     return PhysFS::mkdir(path);
@@ -59,6 +148,65 @@ std::vector<std::byte> fileIO::DumpStreamIntoBytes(std::istream& stream)
     return out;
 }
 
+std::optional<std::vector<std::byte>> fileIO::ReadFileBytes(const std::string& path, size_t padding)
+{
+    std::vector<std::byte> out {};
+
+    if (!PhysFS::readAll(path, out, padding))
+    {
+        return std::nullopt;
+    }
+
+    return out;
+}
+
+bool fileIO::WriteFileAtomically(const std::filesystem::path& path, std::span<const std::byte> bytes)
+{
+    std::error_code error {};
+
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        if (error)
+        {
+            bblog::warn("Failed creating directory for {}: {}", path.generic_string(), error.message());
+            return false;
+        }
+    }
+
+    const std::filesystem::path temporaryPath = MakeTemporaryPath(path);
+
+    {
+        std::ofstream file { temporaryPath, DEFAULT_WRITE_FLAGS };
+
+        if (!file)
+        {
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        if (!file)
+        {
+            file.close();
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+
+    if (error)
+    {
+        bblog::warn("Failed writing {}: {}", path.generic_string(), error.message());
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    return true;
+}
+
 std::string fileIO::DumpStreamIntoString(std::istream& stream)
 {
     stream.seekg(0, std::ios::end);
@@ -1,4 +1,5 @@
 #include "physfs.hpp"
+#include <atomic>
 #include <stdexcept>
 #include <streambuf>
 #include <string.h>
@@ -7,6 +8,8 @@
 namespace PhysFS
 {
 
+static std::atomic<uint64> ioCallCount { 0 };
+
 class fbuf : public std::streambuf
 {
 private:
@@ -19,6 +22,7 @@ private:
         {
             return traits_type::eof();
         }
+        ++ioCallCount;
         size_t bytesRead = PHYSFS_readBytes(file, buffer, bufferSize);
         if (bytesRead < 1)
         {
@@ -30,6 +34,7 @@ private:
 
     pos_type seekoff(off_type pos, std::ios_base::seekdir dir, std::ios_base::openmode mode)
     {
+        ++ioCallCount;
         switch (dir)
         {
         case std::ios_base::beg:
@@ -58,6 +63,7 @@ private:
 
     pos_type seekpos(pos_type pos, std::ios_base::openmode mode)
     {
+        ++ioCallCount;
         PHYSFS_seek(file, pos);
         if (mode & std::ios_base::in)
         {
@@ -355,6 +361,35 @@ string getMountPoint(const string& dir)
     return PHYSFS_getMountPoint(dir.c_str());
 }
 
+bool readAll(const string& filename, std::vector<std::byte>& bytes, std::size_t padding)
+{
+    PHYSFS_File* file = PHYSFS_openRead(filename.c_str());
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+    bool success = length >= 0;
+
+    if (success)
+    {
+        bytes.assign(static_cast<std::size_t>(length) + padding, std::byte { 0 });
+
+        ++ioCallCount;
+        success = PHYSFS_readBytes(file, bytes.data(), static_cast<PHYSFS_uint64>(length)) == length;
+    }
+
+    PHYSFS_close(file);
+    return success;
+}
+
+uint64 getIOCallCount()
+{
+    return ioCallCount.load();
+}
+
 sint16 Util::swapSLE16(sint16 value)
 {
     return PHYSFS_swapSLE16(value);
@@ -3,8 +3,11 @@
 #include "log.hpp"
 #include "physfs.hpp"
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <optional>
+#include <span>
 #include <stb_image.h>
 #include <string>
 #include <vector>
@@ -35,6 +38,11 @@ std::optional<PhysFS::ofstream> OpenWriteStream(const std::string& path);
 /// </summary>
 std::vector<std::byte> DumpStreamIntoBytes(std::istream& stream);
 
+/// <summary>
+/// Reads all bytes of a file with a single read, followed by padding zeroed bytes
+/// </summary>
+std::optional<std::vector<std::byte>> ReadFileBytes(const std::string& path, size_t padding = 0);
+
 /// <summary>
 /// Dumps stream into a string
 /// </summary>
@@ -45,6 +53,29 @@ std::string DumpStreamIntoString(std::istream& stream);
 /// </summary>
 bool Exists(const std::string& path);
 
+/// <summary>
+/// Path of the file on the native filesystem, returns nullopt when it is inside an archive or doesn't exist.
+/// </summary>
+std::optional<std::filesystem::path> GetNativePath(const std::string& path);
+
+struct FileInfo
+{
+    uint64_t size = 0;
+    int64_t lastWriteTime = 0;
+};
+
+/// <summary>
+/// Size and last write time of a file, also for files inside an archive, returns nullopt when it doesn't exist.
+/// Archives only store the time in seconds, if at all, native files use the precise time of the filesystem.
+/// </summary>
+std::optional<FileInfo> GetFileInfo(const std::string& path);
+
+/// <summary>
+/// Writes a file on the native filesystem through a temporary file that replaces it once complete, so a crash or another process
+/// writing the same file never leaves a half written one behind. Missing directories are created, returns false if this failed
+/// </summary>
+bool WriteFileAtomically(const std::filesystem::path& path, std::span<const std::byte> bytes);
+
 /// <summary>
 /// Creates a directory at the specified path, returns false if this failed
 /// </summary>
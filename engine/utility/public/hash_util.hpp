@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace hashing
+{
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+// 64 bit FNV-1a over a range of bytes.
+// Pass a previous result as the seed to hash multiple ranges into a single value.
+inline uint64_t FNV1a(const void* data, size_t size, uint64_t seed = FNV_OFFSET_BASIS)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+// Hashes the bytes of a single trivially copyable value.
+template <typename T>
+uint64_t FNV1aValue(const T& value, uint64_t seed = FNV_OFFSET_BASIS)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be hashed by their bytes");
+    return FNV1a(&value, sizeof(T), seed);
+}
+
+}
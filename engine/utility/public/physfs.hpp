@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <iostream>
 #include <physfs.h>
 #include <streambuf>
@@ -134,6 +135,13 @@ bool mount(string const& newDir, string const& mountPoint, bool appendToPath);
 
 string getMountPoint(string const& dir);
 
+// Reads the whole file with a single read, instead of the small buffered reads of ifstream.
+// The bytes are followed by padding zeroed bytes, for parsers that read past the end.
+bool readAll(string const& filename, std::vector<std::byte>& bytes, std::size_t padding = 0);
+
+// Number of reads and seeks done on files opened through this wrapper, to measure the I/O cost of loading
+uint64 getIOCallCount();
+
 namespace Util
 {
 
@@ -114,7 +114,9 @@ void main()
 
     if (material.useNormalMap)
     {
-        normal = normalSample.xyz * 2.0 - 1.0;
+        // Cooked normal maps are BC5 and only store x and y, z is rebuilt from them for every normal map
+        normal.xy = normalSample.xy * 2.0 - 1.0;
+        normal.z = sqrt(max(1.0 - dot(normal.xy, normal.xy), 0.0));
         normal = normalize(TBN * normal) * material.normalScale;
     }
 
@@ -1,6 +1,7 @@
 #version 460
 
 #include "scene.glsl"
+#include "packed_vertex.glsl"
 
 layout (std430, set = 1, binding = 0) buffer InstanceData
 {
@@ -24,9 +25,15 @@ layout (push_constant) uniform PushConstants
     uint directInstanceIndex;
 } pc;
 
+#ifdef PACKED_VERTICES
+layout (location = 0) in vec4 inPackedPosition;
+layout (location = 1) in vec2 inPackedNormal;
+layout (location = 2) in vec2 inPackedTangent;
+#else
 layout (location = 0) in vec3 inPosition;
 layout (location = 1) in vec3 inNormal;
 layout (location = 2) in vec4 inTangent;
+#endif
 layout (location = 3) in vec2 inTexCoord;
 
 layout (location = 0) out vec3 position;
@@ -46,18 +53,26 @@ mat3 Adjoint(in mat4 m)
 
 void main()
 {
-    mat4 modelTransform;
+    Instance instance;
 
     if (pc.isDirectCommand == 1)
     {
-        modelTransform = instances[pc.directInstanceIndex].model;
+        instance = instances[pc.directInstanceIndex];
     }
     else
     {
-        modelTransform = instances[redirect[gl_DrawID]].model;
+        instance = instances[redirect[gl_DrawID]];
         drawID = redirect[gl_DrawID];
     }
 
+    mat4 modelTransform = instance.model;
+
+#ifdef PACKED_VERTICES
+    const vec3 inPosition = DecodePosition(inPackedPosition, instance);
+    const vec3 inNormal = OctDecode(inPackedNormal);
+    const vec4 inTangent = DecodeTangent(inPackedTangent, inPackedPosition);
+#endif
+
     position = (modelTransform * vec4(inPosition, 1.0)).xyz;
 
     mat3 normalTransform = Adjoint(modelTransform);
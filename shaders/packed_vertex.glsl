@@ -0,0 +1,16 @@
+#include "octahedron.glsl"
+
+// Decodes the attributes of PackedVertex and PackedSkinnedVertex, used when the engine is built with PACKED_VERTICES.
+// Normals and tangents are octahedral encoded, texture coordinates and weights are read as floats by the vertex input directly.
+
+// Positions are unorm16 within the bounds of their mesh
+vec3 DecodePosition(vec4 packedPosition, Instance instance)
+{
+    return instance.positionOffset + packedPosition.xyz * instance.positionScale;
+}
+
+// The sign of the bitangent is stored in the w component of the position
+vec4 DecodeTangent(vec2 packedTangent, vec4 packedPosition)
+{
+    return vec4(OctDecode(packedTangent), packedPosition.w * 2.0 - 1.0);
+}
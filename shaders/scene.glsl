@@ -77,12 +77,14 @@ struct Scene
 struct Instance
 {
     mat4 model;
+    vec3 positionOffset;
     uint materialIndex;
+    vec3 positionScale;
     float boundingRadius;
     uint boneOffset;
     bool isStaticDraw;
     float transparency;
-    float padding[3];
+    float padding;
 };
 
 const vec2 poissonDisk[16] = vec2[](
@@ -1,6 +1,7 @@
 #version 460
 
 #include "scene.glsl"
+#include "packed_vertex.glsl"
 
 layout (std430, set = 0, binding = 0) buffer InstanceData
 {
@@ -18,9 +19,15 @@ layout (set = 2, binding = 0) buffer RedirectBuffer
     uint redirect[];
 };
 
+#ifdef PACKED_VERTICES
+layout (location = 0) in vec4 inPackedPosition;
+layout (location = 1) in vec2 inPackedNormal;
+layout (location = 2) in vec2 inPackedTangent;
+#else
 layout (location = 0) in vec3 inPosition;
 layout (location = 1) in vec3 inNormal;
 layout (location = 2) in vec4 inTangent;
+#endif
 layout (location = 3) in vec2 inTexCoord;
 
 layout (location = 0) out vec3 position;
@@ -28,6 +35,11 @@ layout (location = 0) out vec3 position;
 void main()
 {
     const Instance instance = instances[redirect[gl_DrawID]];
+
+#ifdef PACKED_VERTICES
+    const vec3 inPosition = DecodePosition(inPackedPosition, instance);
+#endif
+
     position = (instance.model * vec4(inPosition, 1.0)).xyz;
     gl_Position = scene.directionalLight.lightVP * vec4(position, 1.0);
 }
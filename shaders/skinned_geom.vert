@@ -2,6 +2,7 @@
 
 #include "scene.glsl"
 #include "skinning.glsl"
+#include "packed_vertex.glsl"
 
 layout (std430, set = 1, binding = 0) buffer InstanceData
 {
@@ -30,11 +31,21 @@ layout (push_constant) uniform PushConstants
     uint directInstanceIndex;
 } pc;
 
+#ifdef PACKED_VERTICES
+layout (location = 0) in vec4 inPackedPosition;
+layout (location = 1) in vec2 inPackedNormal;
+layout (location = 2) in vec2 inPackedTangent;
+#else
 layout (location = 0) in vec3 inPosition;
 layout (location = 1) in vec3 inNormal;
 layout (location = 2) in vec4 inTangent;
+#endif
 layout (location = 3) in vec2 inTexCoord;
+#ifdef PACKED_VERTICES
+layout (location = 4) in uvec4 inJoints;
+#else
 layout (location = 4) in vec4 inJoints; // Should be uvec4.
+#endif
 layout (location = 5) in vec4 inWeights;
 
 layout (location = 0) out vec3 position;
@@ -87,6 +98,12 @@ void main()
         drawID = redirect[gl_DrawID];
     }
 
+#ifdef PACKED_VERTICES
+    const vec3 inPosition = DecodePosition(inPackedPosition, instance);
+    const vec3 inNormal = OctDecode(inPackedNormal);
+    const vec4 inTangent = DecodeTangent(inPackedTangent, inPackedPosition);
+#endif
+
     mat2x4 bone = GetJointTransform(ivec4(inJoints), inWeights, instance.boneOffset);
     mat4 skinMatrix = instance.model * GetSkinMatrix(bone);
 
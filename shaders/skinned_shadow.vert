@@ -2,6 +2,7 @@
 
 #include "scene.glsl"
 #include "skinning.glsl"
+#include "packed_vertex.glsl"
 
 layout (std430, set = 0, binding = 0) buffer InstanceData
 {
@@ -24,11 +25,21 @@ layout (std430, set = 3, binding = 0) readonly buffer SkinningTransforms
     mat2x4 skinningTransforms[];
 };
 
+#ifdef PACKED_VERTICES
+layout (location = 0) in vec4 inPackedPosition;
+layout (location = 1) in vec2 inPackedNormal;
+layout (location = 2) in vec2 inPackedTangent;
+#else
 layout (location = 0) in vec3 inPosition;
 layout (location = 1) in vec3 inNormal;
 layout (location = 2) in vec4 inTangent;
+#endif
 layout (location = 3) in vec2 inTexCoord;
+#ifdef PACKED_VERTICES
+layout (location = 4) in uvec4 inJoints;
+#else
 layout (location = 4) in vec4 inJoints;
+#endif
 layout (location = 5) in vec4 inWeights;
 
 layout (location = 0) out vec3 position;
@@ -58,6 +69,11 @@ void main()
 {
     const Instance instance = instances[redirect[gl_DrawID]];
 
+#ifdef PACKED_VERTICES
+    const vec3 inPosition = DecodePosition(inPackedPosition, instance);
+#endif
+
+
     mat2x4 bone = GetJointTransform(ivec4(inJoints), inWeights, instance.boneOffset);
     mat4 skinMatrix = instance.model * GetSkinMatrix(bone);
 
@@ -6,7 +6,9 @@
 
 layout (push_constant) uniform PushConstants
 {
+    vec3 positionOffset;
     uint index;
+    vec3 positionScale;
 } pc;
 
 layout (set = 2, binding = 0) uniform BloomSettingsUBO
@@ -7,7 +7,19 @@ layout (set = 1, binding = 0) uniform CameraUBO
     Camera camera;
 };
 
+// Packed vertices are decoded with the bounds of the sphere, otherwise the offset is 0 and the scale 1
+layout (push_constant) uniform PushConstants
+{
+    vec3 positionOffset;
+    uint hdriIndex;
+    vec3 positionScale;
+} pc;
+
+#ifdef PACKED_VERTICES
+layout (location = 0) in vec4 inPosition;
+#else
 layout (location = 0) in vec3 inPosition;
+#endif
 layout (location = 1) in vec3 inNormal;
 layout (location = 2) in vec4 inTangent;
 layout (location = 3) in vec2 inTexCoord;
@@ -22,5 +34,5 @@ void main()
 
     transform = camera.proj * transform;
 
-    gl_Position = camera.skydomeMVP * vec4(inPosition, 1.0);
+    gl_Position = camera.skydomeMVP * vec4(pc.positionOffset + inPosition.xyz * pc.positionScale, 1.0);
 }
\ No newline at end of file
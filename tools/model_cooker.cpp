@@ -0,0 +1,167 @@
+#include "cooked_model.hpp"
+#include "file_io.hpp"
+#include "log.hpp"
+#include "model_loading.hpp"
+#include "texture_compression.hpp"
+#include "thread_pool.hpp"
+#include "timers.hpp"
+#include "vertex.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+// Cooks glTF models into the binary format the model loader prefers, see CookedModel.
+// Textures are block compressed with their full mip chain, see TextureCompression.
+// Run from the directory the game runs from: ModelCooker <model or directory>...
+// Directories are searched recursively for .glb and .gltf files, the cooked files are written next to them.
+
+namespace
+{
+
+// Bytes the vertices of the cooked models take on the GPU, with the full float and with the packed vertex formats
+struct VertexMemory
+{
+    size_t full = 0;
+    size_t packed = 0;
+
+    VertexMemory& operator+=(const VertexMemory& other)
+    {
+        full += other.full;
+        packed += other.packed;
+        return *this;
+    }
+};
+
+VertexMemory MeasureVertexMemory(const CPUModel& model)
+{
+    VertexMemory memory {};
+
+    for (const auto& mesh : model.meshes)
+    {
+        memory.full += mesh.vertices.size() * sizeof(Vertex);
+        memory.packed += mesh.vertices.size() * sizeof(PackedVertex);
+    }
+
+    for (const auto& mesh : model.skinnedMeshes)
+    {
+        memory.full += mesh.vertices.size() * sizeof(SkinnedVertex);
+        memory.packed += mesh.vertices.size() * sizeof(PackedSkinnedVertex);
+    }
+
+    return memory;
+}
+
+double ToKiB(size_t bytes)
+{
+    return static_cast<double>(bytes) / 1024.0;
+}
+
+bool IsModel(const std::filesystem::path& path)
+{
+    return path.extension() == ".glb" || path.extension() == ".gltf";
+}
+
+std::vector<std::filesystem::path> GatherSources(int argc, char* argv[])
+{
+    std::vector<std::filesystem::path> sources {};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::filesystem::path argument { argv[i] };
+
+        if (std::filesystem::is_directory(argument))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator { argument })
+            {
+                if (entry.is_regular_file() && IsModel(entry.path()))
+                    sources.emplace_back(entry.path());
+            }
+        }
+        else if (IsModel(argument))
+        {
+            sources.emplace_back(argument);
+        }
+        else
+        {
+            bblog::warn("[ModelCooker] Skipping {}, it is not a glTF model or a directory", argument.generic_string());
+        }
+    }
+
+    return sources;
+}
+
+bool Cook(ThreadPool& threadPool, const std::filesystem::path& source, VertexMemory& vertexMemory)
+{
+    const std::string sourcePath = source.lexically_normal().generic_string();
+    const std::optional<CookedModel::Key> sourceKey = CookedModel::MakeSourceKey(sourcePath);
+
+    if (!sourceKey.has_value())
+    {
+        bblog::error("[ModelCooker] Failed finding {}", sourcePath);
+        return false;
+    }
+
+    Stopwatch stopwatch {};
+
+    try
+    {
+        // Colliders are not cooked into the model, they are cached by the physics module when the model is loaded
+        CPUModel model = ModelLoading::LoadGLTFFast(threadPool, sourcePath, false);
+        ModelLoading::GenerateLODs(threadPool, model);
+        TextureCompression::CompressModelTextures(model);
+
+        const std::string cookedPath = CookedModel::GetCookedPath(sourcePath);
+
+        if (!CookedModel::Save(model, cookedPath, sourceKey.value()))
+        {
+            bblog::error("[ModelCooker] Failed writing {}", cookedPath);
+            return false;
+        }
+
+        const VertexMemory memory = MeasureVertexMemory(model);
+        vertexMemory += memory;
+
+        bblog::info("[ModelCooker] Cooked {} in {:.1f}ms, vertices take {:.1f} KiB or {:.1f} KiB packed",
+            sourcePath, stopwatch.GetElapsed().count(), ToKiB(memory.full), ToKiB(memory.packed));
+        return true;
+    }
+    catch (const std::exception& exception)
+    {
+        bblog::error("[ModelCooker] Failed loading {}: {}", sourcePath, exception.what());
+        return false;
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        bblog::error("Usage: ModelCooker <model or directory>...");
+        return 1;
+    }
+
+    const std::vector<std::filesystem::path> sources = GatherSources(argc, argv);
+
+    fileIO::Init(true);
+
+    uint32_t failedCount = 0;
+    VertexMemory vertexMemory {};
+
+    {
+        ThreadPool threadPool { std::max(std::thread::hardware_concurrency(), 1u) };
+        threadPool.Start();
+
+        for (const auto& source : sources)
+            failedCount += !Cook(threadPool, source, vertexMemory);
+    }
+
+    fileIO::Deinit();
+
+    bblog::info("[ModelCooker] Cooked {} of {} models", sources.size() - failedCount, sources.size());
+    bblog::info("[ModelCooker] Vertices take {:.1f} KiB in total or {:.1f} KiB packed", ToKiB(vertexMemory.full), ToKiB(vertexMemory.packed));
+    return failedCount == 0 ? 0 : 1;
+}